@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <Debug.h>
+#include <ImageFileLoader.h>
+#include <JobsManager.h>
+#include <VirtualTextureSliceBaker.h>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: BakeVirtualTextureSlices <albedo|normal|combined> <source image> <output folder> [--kaiser] [--high-quality] [--threads <count>]\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+    {
+        if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+            std::cerr << message << '\n';
+    });
+
+    Wolf::VirtualTextureSliceBaker::BakeInfo bakeInfo;
+    const std::string textureType = argv[1];
+    if (textureType == "albedo")
+        bakeInfo.textureType = Wolf::VirtualTextureSliceBaker::TextureType::ALBEDO;
+    else if (textureType == "normal")
+        bakeInfo.textureType = Wolf::VirtualTextureSliceBaker::TextureType::NORMAL;
+    else if (textureType == "combined")
+        bakeInfo.textureType = Wolf::VirtualTextureSliceBaker::TextureType::COMBINED_ROUGHNESS_METALNESS_AO;
+    else
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const std::string sourceFilepath = argv[2];
+    const std::string outputFolder = argv[3];
+
+    uint32_t threadCount = Wolf::JobsManager::AUTOMATIC_THREAD_COUNT;
+    for (int argIdx = 4; argIdx < argc; ++argIdx)
+    {
+        const std::string arg = argv[argIdx];
+        if (arg == "--kaiser")
+            bakeInfo.filter = Wolf::MipMapGenerator::Filter::KAISER;
+        else if (arg == "--high-quality")
+            bakeInfo.quality = Wolf::ImageCompression::Quality::HIGH;
+        else if (arg == "--threads" && argIdx + 1 < argc)
+            threadCount = static_cast<uint32_t>(std::stoul(argv[++argIdx]));
+        else
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Slices are baked by the before frame workers with the help of the main thread
+    Wolf::JobsManager jobsManager(threadCount == Wolf::JobsManager::AUTOMATIC_THREAD_COUNT ? threadCount : std::max(threadCount, 1u) - 1);
+
+    const Wolf::ImageFileLoader imageFileLoader(sourceFilepath);
+    if (!imageFileLoader.getPixels() || imageFileLoader.getFormat() != Wolf::Format::R8G8B8A8_UNORM)
+    {
+        std::cerr << "Source must be an 8 bit image (PNG, JPG, TGA...)\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    Wolf::VirtualTextureSliceBaker::BakeStats stats;
+    if (!Wolf::VirtualTextureSliceBaker::bake(imageFileLoader.getPixels(), { imageFileLoader.getWidth(), imageFileLoader.getHeight() }, outputFolder, bakeInfo, &stats))
+        return EXIT_FAILURE;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::cout << stats.sliceCount << " slices (" << stats.byteCount / 1024 << " KiB) written to " << outputFolder << " in " << seconds * 1000.0 << " ms, "
+        << static_cast<double>(stats.sliceCount) / seconds << " slices/s on " << jobsManager.getParallelThreadCount() << " threads\n";
+
+    return EXIT_SUCCESS;
+}
@@ -1,10 +1,10 @@
 #pragma once
 
-#include <fstream>
 #include <mutex>
 #include <vector>
 
 #include "Debug.h"
+#include "JSONWriter.h"
 
 namespace Wolf
 {
@@ -67,35 +67,32 @@ namespace Wolf
 	    {
 	    	ms_resourcesMutex.lock();
 
-	        std::ofstream file(outFilename);
-	        if (!file.is_open())
+	        JSONWriter writer(JSONWriter::FileWriteInfo{ outFilename });
+	        if (!writer.isValid())
 	        {
-	            Debug::sendError("Cannot open file for writing: " + outFilename);
+	        	ms_resourcesMutex.unlock();
 	            return;
 	        }
 
-	        file << "{\n";
-	    	file << "  \"type\":\"CPU\",\n";
-	        file << "  \"totalAllocated\": " << ms_totalMemoryAllocated << ",\n";
-	        file << "  \"resources\": [\n";
+	        writer.beginObject();
+	        writer.writeProperty("type", "CPU");
+	        writer.writeProperty("totalAllocated", ms_totalMemoryAllocated);
+	        writer.writePropertyName("resources");
+	        writer.beginArray();
 
-	        for (size_t i = 0; i < ms_resources.size(); ++i)
+	        for (const CPUMemoryAllocationInfo& res : ms_resources)
 	        {
-	            CPUMemoryAllocationInfo& res = ms_resources[i];
-	            bool isLast = (i == ms_resources.size() - 1);
-
-	            file << "    {\n";
-	            file << "      \"name\": \"" << escapeBackslashes(res.m_name) << "\",\n";
-	            file << "      \"allocatedBytes\": " << res.m_size << ",\n";
-	            file << "      \"isPoolOrAtlas\": " << "false" << ",\n";
-	            file << "      \"usagePercent\": " << "100" << "\n";
-	            file << "    }" << (isLast ? "" : ",") << "\n";
+	            writer.beginObject();
+	            writer.writeProperty("name", res.m_name);
+	            writer.writeProperty("allocatedBytes", res.m_size);
+	            writer.writeProperty("isPoolOrAtlas", false);
+	            writer.writeProperty("usagePercent", 100);
+	            writer.endObject();
 	        }
 
-	        file << "  ]\n";
-	        file << "}";
-
-	        file.close();
+	        writer.endArray();
+	        writer.endObject();
+	        writer.flush();
 
 	    	ms_resourcesMutex.unlock();
 	    }
@@ -103,26 +100,6 @@ namespace Wolf
 	    static uint64_t getTotalMemoryAllocated() { return ms_totalMemoryAllocated; }
 
 	private:
-	    static std::string escapeBackslashes(const std::string& input)
-	    {
-	        std::string result;
-	        result.reserve(input.size());
-
-	        for (const char c : input)
-	        {
-	            if (c == '\\')
-	            {
-	                result += "\\\\";
-	            }
-	            else
-	            {
-	                result += c;
-	            }
-	        }
-
-	        return result;
-	    }
-
 	    inline static uint64_t ms_totalMemoryAllocated = 0;
 		struct CPUMemoryAllocationInfo
 		{
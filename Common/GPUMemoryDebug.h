@@ -1,8 +1,12 @@
 #pragma once
 
-#include <fstream>
+#include <algorithm>
+#include <mutex>
+#include <vector>
 
+#include "Debug.h"
 #include "GPUMemoryAllocatorInterface.h"
+#include "JSONWriter.h"
 
 namespace Wolf
 {
@@ -46,38 +50,35 @@ namespace Wolf
 	    {
 	    	ms_resourcesMutex.lock();
 
-	        std::ofstream file(outFilename);
-	        if (!file.is_open())
+	        JSONWriter writer(JSONWriter::FileWriteInfo{ outFilename });
+	        if (!writer.isValid())
 	        {
-	            Debug::sendError("Cannot open file for writing: " + outFilename);
+	        	ms_resourcesMutex.unlock();
 	            return;
 	        }
 
-	        file << "{\n";
-	    	file << "  \"type\":\"GPU\",\n";
-	        file << "  \"totalAllocated\": " << ms_totalMemoryAllocated << ",\n";
-	        file << "  \"totalRequested\": " << ms_totalMemoryRequested << ",\n";
-	        file << "  \"resources\": [\n";
+	        writer.beginObject();
+	        writer.writeProperty("type", "GPU");
+	        writer.writeProperty("totalAllocated", ms_totalMemoryAllocated);
+	        writer.writeProperty("totalRequested", ms_totalMemoryRequested);
+	        writer.writePropertyName("resources");
+	        writer.beginArray();
 
-	        for (size_t i = 0; i < ms_resources.size(); ++i)
+	        for (const GPUMemoryAllocatorInterface* res : ms_resources)
 	        {
-	            auto* res = ms_resources[i];
-	            bool isLast = (i == ms_resources.size() - 1);
-
-	            file << "    {\n";
-	            file << "      \"name\": \"" << escapeBackslashes(res->getName()) << "\",\n";
-	            file << "      \"type\": \"" << (res->getType() == GPUMemoryAllocatorInterface::Type::BUFFER ? "Buffer" : "Image") << "\",\n";
-	            file << "      \"allocatedBytes\": " << res->getMemoryAllocatedSize() << ",\n";
-	            file << "      \"requestedBytes\": " << res->getMemoryRequestedSize() << ",\n";
-	            file << "      \"isPoolOrAtlas\": " << (res->isPoolOrAtlas() ? "true" : "false") << ",\n";
-	            file << "      \"usagePercent\": " << res->getUsagePercentage() << "\n";
-	            file << "    }" << (isLast ? "" : ",") << "\n";
+	            writer.beginObject();
+	            writer.writeProperty("name", res->getName());
+	            writer.writeProperty("type", res->getType() == GPUMemoryAllocatorInterface::Type::BUFFER ? "Buffer" : "Image");
+	            writer.writeProperty("allocatedBytes", res->getMemoryAllocatedSize());
+	            writer.writeProperty("requestedBytes", res->getMemoryRequestedSize());
+	            writer.writeProperty("isPoolOrAtlas", res->isPoolOrAtlas());
+	            writer.writeProperty("usagePercent", res->getUsagePercentage());
+	            writer.endObject();
 	        }
 
-	        file << "  ]\n";
-	        file << "}";
-
-	        file.close();
+	        writer.endArray();
+	        writer.endObject();
+	        writer.flush();
 
 	    	ms_resourcesMutex.unlock();
 	    }
@@ -86,26 +87,6 @@ namespace Wolf
 	    static uint64_t getTotalMemoryRequested() { return ms_totalMemoryRequested; }
 
 	private:
-	    static std::string escapeBackslashes(const std::string& input)
-	    {
-	        std::string result;
-	        result.reserve(input.size());
-
-	        for (const char c : input)
-	        {
-	            if (c == '\\')
-	            {
-	                result += "\\\\";
-	            }
-	            else
-	            {
-	                result += c;
-	            }
-	        }
-
-	        return result;
-	    }
-
 	    inline static uint64_t ms_totalMemoryAllocated = 0;
 	    inline static uint64_t ms_totalMemoryRequested = 0;
 	    inline static std::vector<GPUMemoryAllocatorInterface*> ms_resources;
@@ -0,0 +1,235 @@
+#include "JSONWriter.h"
+
+#include <cmath>
+
+#include "Debug.h"
+
+Wolf::JSONWriter::JSONWriter(const FileWriteInfo& fileWriteInfo) : m_writesToFile(true), m_prettyPrint(fileWriteInfo.prettyPrint)
+{
+	m_file.open(fileWriteInfo.filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open())
+	{
+		Debug::sendError("Cannot open file for writing: " + fileWriteInfo.filename);
+		return;
+	}
+
+	m_buffer.reserve(FLUSH_THRESHOLD + 4096);
+}
+
+Wolf::JSONWriter::JSONWriter(const StringWriteInfo& stringWriteInfo) : m_writesToFile(false), m_prettyPrint(stringWriteInfo.prettyPrint)
+{
+}
+
+Wolf::JSONWriter::~JSONWriter()
+{
+	if (!m_containers.empty())
+		Debug::sendError("JSON writer destroyed with " + std::to_string(m_containers.size()) + " unclosed objects or arrays");
+
+	if (m_writesToFile)
+		flush();
+}
+
+void Wolf::JSONWriter::beginObject()
+{
+	beginContainer('{', true);
+}
+
+void Wolf::JSONWriter::endObject()
+{
+	endContainer('}', true);
+}
+
+void Wolf::JSONWriter::beginArray()
+{
+	beginContainer('[', false);
+}
+
+void Wolf::JSONWriter::endArray()
+{
+	endContainer(']', false);
+}
+
+void Wolf::JSONWriter::writePropertyName(std::string_view name)
+{
+	if (m_containers.empty() || !m_containers.back().isObject || m_propertyNameWritten)
+	{
+		Debug::sendError("JSON property name \"" + std::string(name) + "\" is not written directly in an object");
+		return;
+	}
+
+	Container& container = m_containers.back();
+	if (!container.isEmpty)
+		m_buffer += ',';
+	container.isEmpty = false;
+	writeNewLine();
+
+	writeEscapedString(name);
+	m_buffer += m_prettyPrint ? ": " : ":";
+	m_propertyNameWritten = true;
+}
+
+void Wolf::JSONWriter::writeString(std::string_view value)
+{
+	beginValue();
+	writeEscapedString(value);
+	flushIfNeeded();
+}
+
+void Wolf::JSONWriter::writeNumber(float value)
+{
+	// JSON has no representation for infinity and NaN
+	if (!std::isfinite(value))
+	{
+		writeNull();
+		return;
+	}
+
+	beginValue();
+	char buffer[32];
+	const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+	m_buffer.append(buffer, result.ptr);
+	flushIfNeeded();
+}
+
+void Wolf::JSONWriter::writeNumber(double value)
+{
+	if (!std::isfinite(value))
+	{
+		writeNull();
+		return;
+	}
+
+	beginValue();
+	char buffer[32];
+	const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+	m_buffer.append(buffer, result.ptr);
+	flushIfNeeded();
+}
+
+void Wolf::JSONWriter::writeBool(bool value)
+{
+	beginValue();
+	m_buffer += value ? "true" : "false";
+	flushIfNeeded();
+}
+
+void Wolf::JSONWriter::writeNull()
+{
+	beginValue();
+	m_buffer += "null";
+	flushIfNeeded();
+}
+
+bool Wolf::JSONWriter::flush()
+{
+	if (!m_writesToFile || !m_file.is_open())
+		return false;
+
+	m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+	m_buffer.clear();
+	if (m_containers.empty())
+		m_file.flush();
+
+	if (!m_file)
+	{
+		Debug::sendError("Failed to write JSON file");
+		return false;
+	}
+	return true;
+}
+
+void Wolf::JSONWriter::beginValue()
+{
+	if (m_containers.empty())
+	{
+		if (m_rootWritten)
+			Debug::sendError("JSON document can only have one root value");
+		m_rootWritten = true;
+		return;
+	}
+
+	Container& container = m_containers.back();
+	if (container.isObject)
+	{
+		if (!m_propertyNameWritten)
+			Debug::sendError("JSON value written in an object without property name");
+		m_propertyNameWritten = false;
+		return;
+	}
+
+	if (!container.isEmpty)
+		m_buffer += ',';
+	container.isEmpty = false;
+	writeNewLine();
+}
+
+void Wolf::JSONWriter::beginContainer(char character, bool isObject)
+{
+	beginValue();
+	m_buffer += character;
+	m_containers.push_back({ isObject, true });
+}
+
+void Wolf::JSONWriter::endContainer(char character, bool isObject)
+{
+	if (m_containers.empty() || m_containers.back().isObject != isObject || m_propertyNameWritten)
+	{
+		Debug::sendError(std::string("Unexpected end of JSON ") + (isObject ? "object" : "array"));
+		return;
+	}
+
+	const bool isEmpty = m_containers.back().isEmpty;
+	m_containers.pop_back();
+	if (!isEmpty)
+		writeNewLine();
+	m_buffer += character;
+	flushIfNeeded();
+}
+
+void Wolf::JSONWriter::writeNewLine()
+{
+	if (!m_prettyPrint)
+		return;
+
+	m_buffer += '\n';
+	m_buffer.append(m_containers.size() * 2, ' ');
+}
+
+void Wolf::JSONWriter::writeEscapedString(std::string_view value)
+{
+	static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+	m_buffer += '"';
+
+	// Characters which don't need to be escaped are copied by runs
+	size_t runStart = 0;
+	for (size_t i = 0; i < value.size(); ++i)
+	{
+		const unsigned char character = static_cast<unsigned char>(value[i]);
+		if (character >= 0x20 && character != '"' && character != '\\')
+			continue;
+
+		m_buffer.append(value.data() + runStart, i - runStart);
+		runStart = i + 1;
+
+		m_buffer += '\\';
+		switch (character)
+		{
+			case '"': m_buffer += '"'; break;
+			case '\\': m_buffer += '\\'; break;
+			case '\b': m_buffer += 'b'; break;
+			case '\f': m_buffer += 'f'; break;
+			case '\n': m_buffer += 'n'; break;
+			case '\r': m_buffer += 'r'; break;
+			case '\t': m_buffer += 't'; break;
+			default:
+				m_buffer += "u00";
+				m_buffer += HEX_DIGITS[character >> 4];
+				m_buffer += HEX_DIGITS[character & 0xF];
+				break;
+		}
+	}
+	m_buffer.append(value.data() + runStart, value.size() - runStart);
+
+	m_buffer += '"';
+}
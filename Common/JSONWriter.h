@@ -0,0 +1,99 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Wolf
+{
+	// Streaming JSON writer, output is buffered and written to the file in large chunks.
+	// Commas are added automatically, floats use the shortest representation that reads back to the same value
+	class JSONWriter
+	{
+	public:
+		struct FileWriteInfo
+		{
+			std::string filename;
+			bool prettyPrint = true;
+		};
+		explicit JSONWriter(const FileWriteInfo& fileWriteInfo);
+
+		// Output is kept in memory, see getString()
+		struct StringWriteInfo
+		{
+			bool prettyPrint = false;
+		};
+		explicit JSONWriter(const StringWriteInfo& stringWriteInfo);
+		JSONWriter(const JSONWriter&) = delete;
+		~JSONWriter();
+
+		[[nodiscard]] bool isValid() const { return !m_writesToFile || m_file.is_open(); }
+
+		void beginObject();
+		void endObject();
+		void beginArray();
+		void endArray();
+
+		// Must be followed by a value, an object or an array
+		void writePropertyName(std::string_view name);
+
+		void writeString(std::string_view value);
+		void writeNumber(float value);
+		void writeNumber(double value);
+		template <std::integral T> void writeNumber(T value) { writeInteger(value); }
+		void writeBool(bool value);
+		void writeNull();
+
+		template <typename T> void writeProperty(std::string_view name, const T& value)
+		{
+			writePropertyName(name);
+			if constexpr (std::is_same_v<T, bool>)
+				writeBool(value);
+			else if constexpr (std::is_arithmetic_v<T>)
+				writeNumber(value);
+			else
+				writeString(value);
+		}
+
+		// Writes buffered output to the file, returns false if the file can't be written
+		bool flush();
+		// Content written so far when writing to a string
+		[[nodiscard]] const std::string& getString() const { return m_buffer; }
+
+	private:
+		static constexpr size_t FLUSH_THRESHOLD = 256 * 1024;
+
+		template <typename T> void writeInteger(T value)
+		{
+			beginValue();
+			char buffer[24];
+			const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			m_buffer.append(buffer, result.ptr);
+			flushIfNeeded();
+		}
+		void beginValue();
+		void beginContainer(char character, bool isObject);
+		void endContainer(char character, bool isObject);
+		void writeNewLine();
+		void writeEscapedString(std::string_view value);
+		void flushIfNeeded() { if (m_writesToFile && m_buffer.size() >= FLUSH_THRESHOLD) flush(); }
+
+		bool m_writesToFile;
+		bool m_prettyPrint;
+		std::ofstream m_file;
+		std::string m_buffer;
+
+		struct Container
+		{
+			bool isObject;
+			bool isEmpty;
+		};
+		std::vector<Container> m_containers;
+		bool m_propertyNameWritten = false;
+		bool m_rootWritten = false;
+	};
+}
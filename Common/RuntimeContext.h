@@ -13,13 +13,30 @@ namespace Wolf
 		void incrementCPUFrameNumber() { m_currentCPUFrameNumber++; }
 		//void incrementGPUFrameNumber() { m_currentGPUFrameNumber++; }
 
-		uint32_t getCurrentCPUFrameNumber() const { return  m_currentCPUFrameNumber; }
+		uint32_t getCurrentCPUFrameNumber() const { return s_cpuFrameNumberOverride != NO_CPU_FRAME_NUMBER_OVERRIDE ? s_cpuFrameNumberOverride : m_currentCPUFrameNumber; }
 		//uint64_t getCurrentGPUFrameNumber() const { return  m_currentGPUFrameNumber; }
 
+		// Code executed ahead for another frame (like pipelined before frame jobs) sees this frame number on the current thread while the scope is alive
+		static constexpr uint32_t NO_CPU_FRAME_NUMBER_OVERRIDE = static_cast<uint32_t>(-1);
+		class CPUFrameNumberOverrideScope
+		{
+		public:
+			explicit CPUFrameNumberOverrideScope(uint32_t cpuFrameNumber) : m_previousOverride(s_cpuFrameNumberOverride) { s_cpuFrameNumberOverride = cpuFrameNumber; }
+			~CPUFrameNumberOverrideScope() { s_cpuFrameNumberOverride = m_previousOverride; }
+
+			CPUFrameNumberOverrideScope(const CPUFrameNumberOverrideScope&) = delete;
+			CPUFrameNumberOverrideScope& operator=(const CPUFrameNumberOverrideScope&) = delete;
+
+		private:
+			uint32_t m_previousOverride;
+		};
+		static uint32_t getCPUFrameNumberOverride() { return s_cpuFrameNumberOverride; }
+
 	private:
 		static constexpr uint32_t FRAME_NUMBER_DEFAULT_VALUE = 0;
 
 		uint32_t m_currentCPUFrameNumber = FRAME_NUMBER_DEFAULT_VALUE;
+		static inline thread_local uint32_t s_cpuFrameNumberOverride = NO_CPU_FRAME_NUMBER_OVERRIDE;
 		//uint64_t m_currentGPUFrameNumber = 0;
 	};
 
@@ -16,6 +16,8 @@ namespace Wolf
 				return VK_FORMAT_R8_UNORM;
 			case Format::R32_UINT:
 				return VK_FORMAT_R32_UINT;
+			case Format::R8G8_UNORM:
+				return VK_FORMAT_R8G8_UNORM;
 			case Format::R8G8B8A8_UNORM:
 				return VK_FORMAT_R8G8B8A8_UNORM;
 			case Format::R8G8B8A8_SRGB:
@@ -44,12 +46,24 @@ namespace Wolf
 				return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
 			case Format::BC1_RGBA_UNORM_BLOCK:
 				return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+			case Format::BC2_SRGB_BLOCK:
+				return VK_FORMAT_BC2_SRGB_BLOCK;
+			case Format::BC2_UNORM_BLOCK:
+				return VK_FORMAT_BC2_UNORM_BLOCK;
 			case Format::BC3_SRGB_BLOCK:
 				return VK_FORMAT_BC3_SRGB_BLOCK;
 			case Format::BC3_UNORM_BLOCK:
 				return VK_FORMAT_BC3_UNORM_BLOCK;
+			case Format::BC4_UNORM_BLOCK:
+				return VK_FORMAT_BC4_UNORM_BLOCK;
 			case Format::BC5_UNORM_BLOCK:
 				return VK_FORMAT_BC5_UNORM_BLOCK;
+			case Format::BC6H_UFLOAT_BLOCK:
+				return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+			case Format::BC7_SRGB_BLOCK:
+				return VK_FORMAT_BC7_SRGB_BLOCK;
+			case Format::BC7_UNORM_BLOCK:
+				return VK_FORMAT_BC7_UNORM_BLOCK;
 			case Format::D32_SFLOAT:
 				return VK_FORMAT_D32_SFLOAT;
 			case Format::D16_UNORM:
@@ -119,7 +119,7 @@ Wolf::ImageVulkan::ImageVulkan(VkImage image, Format format, ImageAspectFlags as
 
 Wolf::ImageVulkan::~ImageVulkan()
 {
-	for (const std::pair<uint32_t, VkImageView> imageView : m_imageViews)
+	for (const std::pair<uint64_t, VkImageView> imageView : m_imageViews)
 		vkDestroyImageView(g_vulkanInstance->getDevice(), imageView.second, nullptr);
 
 	if (m_imageMemory == VK_NULL_HANDLE)
@@ -339,12 +339,12 @@ void Wolf::ImageVulkan::setImageLayout(const TransitionLayoutInfo& transitionLay
 	fence.waitForFence();
 }
 
-uint32_t computeImageViewHash(VkFormat format)
+uint64_t computeImageViewHash(VkFormat format, uint32_t baseMipLevel)
 {
-	return (uint32_t)format;
+	return static_cast<uint64_t>(format) | (static_cast<uint64_t>(baseMipLevel) << 32);
 }
 
-void Wolf::ImageVulkan::createImageView(VkFormat format)
+void Wolf::ImageVulkan::createImageView(VkFormat format, uint32_t baseMipLevel)
 {
 	VkImageViewCreateInfo viewInfo = {};
 	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -352,8 +352,8 @@ void Wolf::ImageVulkan::createImageView(VkFormat format)
 	viewInfo.viewType = m_arrayLayerCount == 6 ? VK_IMAGE_VIEW_TYPE_CUBE : (m_extent.depth != 1 ? VK_IMAGE_VIEW_TYPE_3D : VK_IMAGE_VIEW_TYPE_2D);
 	viewInfo.format = format;
 	viewInfo.subresourceRange.aspectMask = wolfImageAspectFlagsToVkImageAspectFlags(m_aspectFlags);
-	viewInfo.subresourceRange.baseMipLevel = 0;
-	viewInfo.subresourceRange.levelCount = m_mipLevelCount;
+	viewInfo.subresourceRange.baseMipLevel = baseMipLevel;
+	viewInfo.subresourceRange.levelCount = m_mipLevelCount - baseMipLevel;
 	viewInfo.subresourceRange.baseArrayLayer = 0;
 	viewInfo.subresourceRange.layerCount = m_arrayLayerCount;
 
@@ -361,7 +361,7 @@ void Wolf::ImageVulkan::createImageView(VkFormat format)
 	if (vkCreateImageView(g_vulkanInstance->getDevice(), &viewInfo, nullptr, &imageView) != VK_SUCCESS)
 		Debug::sendError("Error : create image view");
 
-	const uint32_t hash = computeImageViewHash(m_vkImageFormat);
+	const uint64_t hash = computeImageViewHash(format, baseMipLevel);
 	m_imageViews[hash] = imageView;
 }
 
@@ -484,12 +484,18 @@ VkMemoryPropertyFlags Wolf::ImageVulkan::wolfImageMemoryPropertyFlagsToVkMemoryP
 	return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 }
 
-Wolf::ImageView Wolf::ImageVulkan::getImageView(Format format)
+Wolf::ImageView Wolf::ImageVulkan::getImageView(Format format, uint32_t baseMipLevel)
 {
-	const uint32_t hash = computeImageViewHash(wolfFormatToVkFormat(format));
+	if (baseMipLevel >= m_mipLevelCount)
+	{
+		Debug::sendError("Base mip level of the image view is out of the image");
+		baseMipLevel = m_mipLevelCount - 1;
+	}
+
+	const uint64_t hash = computeImageViewHash(wolfFormatToVkFormat(format), baseMipLevel);
 	if (m_imageViews.find(hash) == m_imageViews.end())
 	{
-		createImageView(wolfFormatToVkFormat(format));
+		createImageView(wolfFormatToVkFormat(format), baseMipLevel);
 	}
 
 	return m_imageViews[hash];
@@ -11,6 +11,7 @@ namespace Wolf
 		R8_UINT,
 		R8_UNORM,
 		R32_UINT,
+		R8G8_UNORM,
 		R8G8B8A8_UNORM,
 		R8G8B8A8_SRGB,
 		B8G8R8A8_UNORM,
@@ -27,9 +28,15 @@ namespace Wolf
 
 		BC1_RGB_SRGB_BLOCK,
 		BC1_RGBA_UNORM_BLOCK,
+		BC2_SRGB_BLOCK,
+		BC2_UNORM_BLOCK,
 		BC3_SRGB_BLOCK,
 		BC3_UNORM_BLOCK,
+		BC4_UNORM_BLOCK,
 		BC5_UNORM_BLOCK,
+		BC6H_UFLOAT_BLOCK,
+		BC7_SRGB_BLOCK,
+		BC7_UNORM_BLOCK,
 
 		D16_UNORM,
 		D32_SFLOAT,
@@ -46,6 +53,7 @@ namespace Wolf
 			case Format::R8_UINT:               return "R8_UINT";
 			case Format::R8_UNORM:              return "R8_UNORM";
 			case Format::R32_UINT:              return "R32_UINT";
+			case Format::R8G8_UNORM:            return "R8G8_UNORM";
 			case Format::R8G8B8A8_UNORM:        return "R8G8B8A8_UNORM";
 			case Format::R8G8B8A8_SRGB:         return "R8G8B8A8_SRGB";
 			case Format::B8G8R8A8_UNORM:        return "B8G8R8A8_UNORM";
@@ -62,9 +70,15 @@ namespace Wolf
 
 			case Format::BC1_RGB_SRGB_BLOCK:    return "BC1_RGB_SRGB_BLOCK";
 			case Format::BC1_RGBA_UNORM_BLOCK:  return "BC1_RGBA_UNORM_BLOCK";
+			case Format::BC2_SRGB_BLOCK:        return "BC2_SRGB_BLOCK";
+			case Format::BC2_UNORM_BLOCK:       return "BC2_UNORM_BLOCK";
 			case Format::BC3_SRGB_BLOCK:        return "BC3_SRGB_BLOCK";
 			case Format::BC3_UNORM_BLOCK:       return "BC3_UNORM_BLOCK";
+			case Format::BC4_UNORM_BLOCK:       return "BC4_UNORM_BLOCK";
 			case Format::BC5_UNORM_BLOCK:       return "BC5_UNORM_BLOCK";
+			case Format::BC6H_UFLOAT_BLOCK:     return "BC6H_UFLOAT_BLOCK";
+			case Format::BC7_SRGB_BLOCK:        return "BC7_SRGB_BLOCK";
+			case Format::BC7_UNORM_BLOCK:       return "BC7_UNORM_BLOCK";
 
 			case Format::D16_UNORM:             return "D16_UNORM";
 			case Format::D32_SFLOAT:            return "D32_SFLOAT";
@@ -81,13 +95,16 @@ namespace Wolf
 		{
 			case Format::R8G8B8A8_SRGB:
 			case Format::BC1_RGB_SRGB_BLOCK:
+			case Format::BC2_SRGB_BLOCK:
 			case Format::BC3_SRGB_BLOCK:
+			case Format::BC7_SRGB_BLOCK:
 				return true;
 
 			case Format::UNDEFINED:
 			case Format::R8_UINT:
 			case Format::R8_UNORM:
 			case Format::R32_UINT:
+			case Format::R8G8_UNORM:
 			case Format::R8G8B8A8_UNORM:
 			case Format::B8G8R8A8_UNORM:
 			case Format::R16_SFLOAT:
@@ -98,8 +115,12 @@ namespace Wolf
 			case Format::R32G32B32_SFLOAT:
 			case Format::R32G32B32A32_SFLOAT:
 			case Format::BC1_RGBA_UNORM_BLOCK:
+			case Format::BC2_UNORM_BLOCK:
 			case Format::BC3_UNORM_BLOCK:
+			case Format::BC4_UNORM_BLOCK:
 			case Format::BC5_UNORM_BLOCK:
+			case Format::BC6H_UFLOAT_BLOCK:
+			case Format::BC7_UNORM_BLOCK:
 			case Format::D16_UNORM:
 			case Format::D32_SFLOAT:
 			case Format::D32_SFLOAT_S8_UINT:
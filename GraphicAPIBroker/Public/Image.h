@@ -82,16 +82,23 @@ namespace Wolf
 				case Format::R16G16_SFLOAT:
 					return 4.0f;
 				case Format::R16_SFLOAT:
+				case Format::R8G8_UNORM:
 				case Format::D16_UNORM:
 					return 2.0f;
+				case Format::BC2_UNORM_BLOCK:
+				case Format::BC2_SRGB_BLOCK:
 				case Format::BC3_UNORM_BLOCK:
 				case Format::BC3_SRGB_BLOCK:
 				case Format::BC5_UNORM_BLOCK:
+				case Format::BC6H_UFLOAT_BLOCK:
+				case Format::BC7_SRGB_BLOCK:
+				case Format::BC7_UNORM_BLOCK:
 				case Format::R8_UINT:
 				case Format::R8_UNORM:
 					return 1.0f;
 				case Format::BC1_RGBA_UNORM_BLOCK:
 				case Format::BC1_RGB_SRGB_BLOCK:
+				case Format::BC4_UNORM_BLOCK:
 					return 0.5f;
 				default:
 					Debug::sendError("Unsupported image format");
@@ -149,7 +156,8 @@ namespace Wolf
 
 		float getBPP() const { return m_bpp; }
 
-		virtual ImageView getImageView(Format format) = 0;
+		// View of the mip levels from baseMipLevel to the last one, used to sample an image before its largest mips are loaded
+		virtual ImageView getImageView(Format format, uint32_t baseMipLevel = 0) = 0;
 		virtual ImageView getDefaultImageView() = 0;
 
 		[[nodiscard]] virtual Format getFormat() const = 0;
@@ -0,0 +1,231 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AsyncTask.h"
+#include "JobsManager.h"
+#include "JobsTestHelpers.h"
+#include "TestFramework.h"
+
+namespace
+{
+	// Counts the coroutine frames alive, passed by value so it's copied into the frame
+	class FrameTracker
+	{
+	public:
+		explicit FrameTracker(std::atomic<int32_t>& liveCount) : m_liveCount(&liveCount) { (*m_liveCount)++; }
+		FrameTracker(const FrameTracker& other) : m_liveCount(other.m_liveCount) { (*m_liveCount)++; }
+		~FrameTracker() { (*m_liveCount)--; }
+
+	private:
+		std::atomic<int32_t>* m_liveCount;
+	};
+
+	// Frames of detached tasks are destroyed on the streaming threads once completed, returns false after 10 seconds
+	bool waitForNoLiveFrame(const std::atomic<int32_t>& liveFrameCount)
+	{
+		const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (liveFrameCount != 0)
+		{
+			if (std::chrono::steady_clock::now() > timeout)
+				return false;
+			std::this_thread::yield();
+		}
+		return true;
+	}
+
+	std::vector<uint8_t> writeTestFile(const std::string& filepath, uint32_t size)
+	{
+		std::vector<uint8_t> content(size);
+		for (uint32_t i = 0; i < size; ++i)
+			content[i] = static_cast<uint8_t>(i % 251);
+
+		std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+		return content;
+	}
+
+	Wolf::AsyncTask readFile(std::string path, uint64_t offset, uint64_t size, Wolf::AsyncFileReader::ReadResult& outResult, std::atomic<uint32_t>& completedCount,
+		[[maybe_unused]] FrameTracker frameTracker)
+	{
+		outResult = co_await Wolf::g_jobsManager->readFileAsync(path, offset, size);
+		completedCount++;
+	}
+
+	Wolf::AsyncTask waitForEvent(Wolf::AsyncEvent& event, std::atomic<uint32_t>& startedCount, std::atomic<uint32_t>& resumedCount, std::atomic<uint32_t>& resumedOnCallerCount,
+		std::thread::id callerThreadId)
+	{
+		startedCount++;
+		co_await event;
+		if (std::this_thread::get_id() == callerThreadId)
+			resumedOnCallerCount++;
+		resumedCount++;
+	}
+
+	Wolf::AsyncTask countStart(std::atomic<uint32_t>& startedCount, [[maybe_unused]] FrameTracker frameTracker)
+	{
+		startedCount++;
+		co_return;
+	}
+
+	// Awaiting a task runs it to completion before continuing
+	Wolf::AsyncTask readFileTwice(std::string path, Wolf::AsyncFileReader::ReadResult& outFirstResult, Wolf::AsyncFileReader::ReadResult& outSecondResult,
+		std::atomic<uint32_t>& completedCount, std::atomic<int32_t>& liveFrameCount)
+	{
+		std::atomic<uint32_t> childCompletedCount = 0;
+		co_await readFile(path, 0, 10, outFirstResult, childCompletedCount, FrameTracker(liveFrameCount));
+		co_await readFile(path, 10, 10, outSecondResult, childCompletedCount, FrameTracker(liveFrameCount));
+		if (childCompletedCount == 2)
+			completedCount++;
+	}
+}
+
+WOLF_TEST(ReadFileAsync)
+{
+	Wolf::JobsManager jobsManager(1, 1);
+
+	const std::string filepath = "AsyncTaskTests_read.bin";
+	const std::vector<uint8_t> content = writeTestFile(filepath, 1000);
+
+	std::atomic<int32_t> liveFrameCount = 0;
+	std::atomic<uint32_t> completedCount = 0;
+	constexpr uint32_t READ_COUNT = 7;
+	Wolf::AsyncFileReader::ReadResult results[READ_COUNT];
+	const uint64_t offsets[READ_COUNT] = { 0, 100, 1000, 0, 1001, 990, 0 };
+	const uint64_t sizes[READ_COUNT] = { Wolf::AsyncFileReader::WHOLE_FILE, 50, 0, Wolf::AsyncFileReader::WHOLE_FILE, 0, 20, 1000 };
+	for (uint32_t readIdx = 0; readIdx < READ_COUNT; ++readIdx)
+	{
+		// Fourth read is a miss
+		const std::string readFilepath = readIdx == 3 ? "AsyncTaskTests_missing.bin" : filepath;
+		WOLF_CHECK(jobsManager.addStreamingAsyncTask(readFile(readFilepath, offsets[readIdx], sizes[readIdx], results[readIdx], completedCount, FrameTracker(liveFrameCount)))
+			== Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	}
+	WOLF_CHECK(Wolf::Tests::waitForCount(completedCount, READ_COUNT));
+
+	WOLF_CHECK(results[0].m_success);
+	WOLF_CHECK(results[0].m_data == content);
+	WOLF_CHECK(results[1].m_success);
+	WOLF_CHECK(results[1].m_data == std::vector<uint8_t>(content.begin() + 100, content.begin() + 150));
+	WOLF_CHECK(results[2].m_success);
+	WOLF_CHECK(results[2].m_data.empty());
+	WOLF_CHECK(!results[3].m_success);
+	WOLF_CHECK(!results[4].m_success);
+	WOLF_CHECK(!results[5].m_success);
+	WOLF_CHECK(results[6].m_success);
+	WOLF_CHECK(results[6].m_data == content);
+
+	// Nested tasks
+	Wolf::AsyncFileReader::ReadResult firstResult, secondResult;
+	std::atomic<uint32_t> nestedCompletedCount = 0;
+	WOLF_CHECK(jobsManager.addStreamingAsyncTask(readFileTwice(filepath, firstResult, secondResult, nestedCompletedCount, liveFrameCount)) == Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	WOLF_CHECK(Wolf::Tests::waitForCount(nestedCompletedCount, 1));
+	WOLF_CHECK(firstResult.m_data == std::vector<uint8_t>(content.begin(), content.begin() + 10));
+	WOLF_CHECK(secondResult.m_data == std::vector<uint8_t>(content.begin() + 10, content.begin() + 20));
+
+	WOLF_CHECK(waitForNoLiveFrame(liveFrameCount));
+}
+
+WOLF_TEST(AsyncEventWakesAwaitingTasks)
+{
+	Wolf::JobsManager jobsManager(1, 2);
+	Wolf::AsyncEvent event;
+
+	constexpr uint32_t TASK_COUNT = 4;
+	std::atomic<uint32_t> startedCount = 0, resumedCount = 0, resumedOnCallerCount = 0;
+	const std::thread::id callerThreadId = std::this_thread::get_id();
+	for (uint32_t taskIdx = 0; taskIdx < TASK_COUNT; ++taskIdx)
+		jobsManager.addStreamingAsyncTask(waitForEvent(event, startedCount, resumedCount, resumedOnCallerCount, callerThreadId));
+	WOLF_CHECK(Wolf::Tests::waitForCount(startedCount, TASK_COUNT));
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	WOLF_CHECK(!event.isSet());
+	WOLF_CHECK_EQUAL(resumedCount.load(), 0u);
+
+	// Set from another thread, tasks are resumed on the streaming threads
+	std::thread([&event]() { event.set(); }).join();
+	WOLF_CHECK(event.isSet());
+	WOLF_CHECK(Wolf::Tests::waitForCount(resumedCount, TASK_COUNT));
+	WOLF_CHECK_EQUAL(resumedOnCallerCount.load(), 0u);
+
+	// Already set, started tasks don't suspend
+	waitForEvent(event, startedCount, resumedCount, resumedOnCallerCount, callerThreadId).start();
+	WOLF_CHECK_EQUAL(resumedCount.load(), TASK_COUNT + 1);
+	WOLF_CHECK_EQUAL(resumedOnCallerCount.load(), 1u);
+}
+
+WOLF_TEST(CancelAsyncTaskBeforeStart)
+{
+	Wolf::JobsManager jobsManager(1, 1);
+
+	std::atomic<int32_t> liveFrameCount = 0;
+	std::atomic<uint32_t> startedCount = 0;
+	Wolf::Tests::StreamingThreadBlocker blocker(jobsManager);
+
+	Wolf::JobsManager::StreamingJobToken cancelledToken, keptToken;
+	WOLF_CHECK(jobsManager.addStreamingAsyncTask(countStart(startedCount, FrameTracker(liveFrameCount)), 0, &cancelledToken) == Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	WOLF_CHECK(jobsManager.addStreamingAsyncTask(countStart(startedCount, FrameTracker(liveFrameCount)), 0, &keptToken) == Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	WOLF_CHECK_EQUAL(liveFrameCount.load(), 2);
+
+	// The task is destroyed with its job, without running
+	WOLF_CHECK(jobsManager.cancelStreamingJob(cancelledToken));
+	WOLF_CHECK_EQUAL(liveFrameCount.load(), 1);
+	WOLF_CHECK(!jobsManager.cancelStreamingJob(cancelledToken));
+
+	blocker.release();
+	WOLF_CHECK(Wolf::Tests::waitForCount(startedCount, 1));
+
+	WOLF_CHECK(waitForNoLiveFrame(liveFrameCount));
+	WOLF_CHECK_EQUAL(startedCount.load(), 1u);
+	WOLF_CHECK(!jobsManager.cancelStreamingJob(keptToken));
+}
+
+WOLF_TEST(DestroyWithSuspendedTasks)
+{
+	const std::string filepath = "AsyncTaskTests_destroy.bin";
+	writeTestFile(filepath, 100'000);
+
+	std::unique_ptr<Wolf::JobsManager> jobsManager(new Wolf::JobsManager(1, 1));
+
+	// Tasks started from the streaming thread which is then held, they can only be resumed by the destructor
+	constexpr uint32_t TASK_COUNT = 8;
+	std::atomic<int32_t> liveFrameCount = 0;
+	std::atomic<uint32_t> completedCount = 0, notStartedCount = 0;
+	std::atomic<bool> tasksStarted = false, released = false;
+	Wolf::AsyncFileReader::ReadResult results[TASK_COUNT];
+	jobsManager->addStreamingJob([&]()
+	{
+		for (uint32_t taskIdx = 0; taskIdx < TASK_COUNT; ++taskIdx)
+			readFile(filepath, 0, Wolf::AsyncFileReader::WHOLE_FILE, results[taskIdx], completedCount, FrameTracker(liveFrameCount)).start();
+		tasksStarted = true;
+		while (!released)
+			std::this_thread::yield();
+	});
+	while (!tasksStarted)
+		std::this_thread::yield();
+
+	// Never started, destroyed with their jobs
+	for (uint32_t taskIdx = 0; taskIdx < 4; ++taskIdx)
+		jobsManager->addStreamingAsyncTask(countStart(notStartedCount, FrameTracker(liveFrameCount)));
+
+	WOLF_CHECK_EQUAL(completedCount.load(), 0u);
+	WOLF_CHECK_EQUAL(liveFrameCount.load(), static_cast<int32_t>(TASK_COUNT + 4));
+
+	// Released once the destructor has asked the streaming thread to stop
+	std::thread releaser([&released]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		released = true;
+	});
+	jobsManager.reset();
+	releaser.join();
+
+	WOLF_CHECK_EQUAL(completedCount.load(), TASK_COUNT);
+	WOLF_CHECK_EQUAL(notStartedCount.load(), 0u);
+	WOLF_CHECK_EQUAL(liveFrameCount.load(), 0);
+	WOLF_CHECK(Wolf::g_jobsManager == nullptr);
+}
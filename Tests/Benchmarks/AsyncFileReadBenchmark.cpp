@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Debug.h>
+
+#include "AsyncTask.h"
+#include "JobsManager.h"
+
+// Many file reads issued from a single streaming thread: one blocking read per streaming job against async tasks awaiting readFileAsync,
+// which keep all the reads in flight on the I/O threads. Also reports how long the streaming thread was busy (telemetry execution time).
+// Files are read from the OS cache after the first repeat, real disk latency favors async reads more.
+// Usage: AsyncFileReadBenchmark [fileCount] [fileSizeKB] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	void waitForCount(const std::atomic<uint32_t>& count, uint32_t expectedCount)
+	{
+		while (count.load() < expectedCount)
+			std::this_thread::yield();
+	}
+
+	Wolf::AsyncTask readFile(std::string path, std::atomic<uint64_t>& readByteCount, std::atomic<uint32_t>& completedCount)
+	{
+		const Wolf::AsyncFileReader::ReadResult result = co_await Wolf::g_jobsManager->readFileAsync(path);
+		if (!result.m_success)
+			Wolf::Debug::sendError("Can't read " + path);
+		readByteCount += result.m_data.size();
+		completedCount++;
+	}
+
+	template <typename RunFunction>
+	double measure(const char* name, uint32_t repeatCount, double referenceMs, Wolf::JobsManager& jobsManager, RunFunction&& runFunction)
+	{
+		double bestMs = 1e30, bestBusyMs = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			jobsManager.getTelemetry()->reset();
+			const Clock::time_point start = Clock::now();
+			runFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+			bestBusyMs = std::min(bestBusyMs, static_cast<double>(jobsManager.getTelemetry()->getSnapshot().m_streamingExecutionLatency.m_totalNs) / 1e6);
+		}
+		std::printf("  %-16s %8.2f ms  streaming thread busy %8.2f ms  x%.2f\n", name, bestMs, bestBusyMs, referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t fileCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 512;
+	const uint32_t fileSize = (argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 256) * 1024;
+	const uint32_t repeatCount = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 5;
+	std::printf("%u files of %u KB, best of %u, %u CPUs\n", fileCount, fileSize / 1024, repeatCount, std::thread::hardware_concurrency());
+
+	const std::filesystem::path directory = "AsyncFileReadBenchmarkFiles";
+	std::filesystem::create_directories(directory);
+	std::vector<std::string> paths;
+	std::vector<char> content(fileSize);
+	for (uint32_t fileIdx = 0; fileIdx < fileCount; ++fileIdx)
+	{
+		for (uint32_t i = 0; i < fileSize; ++i)
+			content[i] = static_cast<char>((i + fileIdx) % 251);
+		paths.push_back((directory / ("file" + std::to_string(fileIdx) + ".bin")).string());
+		std::ofstream(paths.back(), std::ios::binary | std::ios::trunc).write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	// A single streaming thread, as many jobs as files
+	Wolf::JobsManager jobsManager(1, 1, fileCount);
+	jobsManager.getTelemetry()->setEnabled(true);
+	const uint64_t expectedByteCount = static_cast<uint64_t>(fileCount) * fileSize;
+
+	std::atomic<uint64_t> readByteCount = 0;
+	std::atomic<uint32_t> completedCount = 0;
+	const double referenceMs = measure("blocking reads", repeatCount, 0.0, jobsManager, [&]()
+	{
+		readByteCount = 0;
+		completedCount = 0;
+		for (const std::string& path : paths)
+		{
+			jobsManager.addStreamingJob([&, path]()
+			{
+				Wolf::AsyncFileReader::ReadResult result;
+				Wolf::AsyncFileReader::readFile(path, 0, Wolf::AsyncFileReader::WHOLE_FILE, result);
+				readByteCount += result.m_data.size();
+				completedCount++;
+			});
+		}
+		waitForCount(completedCount, fileCount);
+	});
+	if (readByteCount != expectedByteCount)
+		std::printf("Unexpected read size\n");
+
+	measure("async reads", repeatCount, referenceMs, jobsManager, [&]()
+	{
+		readByteCount = 0;
+		completedCount = 0;
+		for (const std::string& path : paths)
+			jobsManager.addStreamingAsyncTask(readFile(path, readByteCount, completedCount));
+		waitForCount(completedCount, fileCount);
+	});
+	if (readByteCount != expectedByteCount)
+		std::printf("Unexpected read size\n");
+
+	std::filesystem::remove_all(directory);
+
+	return 0;
+}
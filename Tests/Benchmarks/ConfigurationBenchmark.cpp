@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Debug.h>
+
+#include "ConfigurationDocument.h"
+#include "ConfigurationHelper.h"
+
+// Repeated ConfigurationHelper::readInfoFromFile lookups on a "key = value" file with thousands of keys: the first version reading the file
+// until the key for each lookup, against the cached ConfigurationDocument (file modification time and size checked on each lookup).
+// Usage: ConfigurationBenchmark [keyCount] [lookupCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// First ConfigurationHelper::readInfoFromFile
+	void removeSpaces(std::string& line)
+	{
+		std::erase_if(line, isspace);
+	}
+
+	std::string readFirstInfoFromFile(const std::string& filepath, const std::string& token)
+	{
+		std::ifstream inConfigFile(filepath);
+		std::string line;
+		while (std::getline(inConfigFile, line))
+		{
+			if (const size_t pos = line.find('='); pos != std::string::npos)
+			{
+				std::string lineToken = line.substr(0, pos);
+				line.erase(0, pos + 1);
+
+				removeSpaces(lineToken);
+				removeSpaces(line);
+
+				if (lineToken == token)
+					return line;
+			}
+		}
+
+		return "";
+	}
+
+	// Keys are looked up in a fixed pseudo-random order, returns microseconds per lookup
+	template <typename LookupFunction>
+	double measureLookups(const char* name, const std::vector<std::string>& keys, uint32_t lookupCount, double referenceUs, LookupFunction&& lookupFunction)
+	{
+		uint64_t valueSize = 0;
+		const Clock::time_point start = Clock::now();
+		for (uint32_t lookupIdx = 0; lookupIdx < lookupCount; ++lookupIdx)
+			valueSize += lookupFunction(keys[(lookupIdx * 7919ull) % keys.size()]).size();
+		const double lookupUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / lookupCount;
+
+		std::printf("  %-28s %10.3f us per lookup  x%.1f\n", name, lookupUs, referenceUs > 0.0 ? referenceUs / lookupUs : 1.0);
+		if (valueSize == 0)
+			std::printf("Values were not found\n");
+		return lookupUs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t keyCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 5000;
+	const uint32_t lookupCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 100'000;
+
+	const std::string filepath = "ConfigurationBenchmark.ini";
+	std::vector<std::string> keys;
+	{
+		std::ofstream file(filepath, std::ios::trunc);
+		file << "// Generated settings\n";
+		for (uint32_t keyIdx = 0; keyIdx < keyCount; ++keyIdx)
+		{
+			keys.push_back("setting" + std::to_string(keyIdx));
+			file << keys.back() << " = value_" << keyIdx * 31 << "\n";
+		}
+	}
+	std::printf("%u keys, %u lookups\n", keyCount, lookupCount);
+
+	// The first version reads the whole file for each lookup, fewer lookups are enough
+	const double referenceUs = measureLookups("first readInfoFromFile", keys, std::max(lookupCount / 100, 1u), 0.0,
+		[&](const std::string& key) { return readFirstInfoFromFile(filepath, key); });
+
+	Wolf::ConfigurationHelper::clearCache();
+	const Clock::time_point parseStart = Clock::now();
+	if (Wolf::ConfigurationHelper::readInfoFromFile(filepath, keys[0]).empty())
+		std::printf("Value was not found\n");
+	std::printf("  %-28s %10.3f us\n", "first cached lookup (parse)", std::chrono::duration<double, std::micro>(Clock::now() - parseStart).count());
+
+	measureLookups("cached readInfoFromFile", keys, lookupCount, referenceUs, [&](const std::string& key) { return Wolf::ConfigurationHelper::readInfoFromFile(filepath, key); });
+
+	const Wolf::ConfigurationDocument document(filepath);
+	measureLookups("ConfigurationDocument", keys, lookupCount, referenceUs, [&](const std::string& key) { return document.getString(key); });
+
+	for (uint32_t keyIdx = 0; keyIdx < keyCount; keyIdx += 97)
+	{
+		const std::string firstValue = readFirstInfoFromFile(filepath, keys[keyIdx]);
+		if (firstValue.empty() || Wolf::ConfigurationHelper::readInfoFromFile(filepath, keys[keyIdx]) != firstValue || document.getString(keys[keyIdx]) != firstValue)
+			std::printf("Different values for %s\n", keys[keyIdx].c_str());
+	}
+
+	return 0;
+}
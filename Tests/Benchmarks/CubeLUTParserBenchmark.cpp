@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Debug.h>
+#include <glm/gtc/packing.hpp>
+
+#include "CubeLUTParser.h"
+#include "ImageFileLoader.h"
+#include "JobsManager.h"
+
+// Load time of a .cube color grading LUT.
+// The getline and stof parser ImageFileLoader used before is compared to CubeLUTParser, on the calling thread and with engine workers,
+// then to loading the binary half float cache written next to the file.
+// Usage: CubeLUTParserBenchmark [lutSize] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	bool isFloat(const std::string& str)
+	{
+		std::istringstream stream(str);
+		float value;
+		stream >> std::noskipws >> value;
+		return stream.eof() && !stream.fail();
+	}
+
+	// Loop of the first parser
+	std::vector<uint16_t> loadWithFirstParser(const std::string& filepath)
+	{
+		std::vector<uint16_t> data;
+		std::ifstream file(filepath);
+		std::string line;
+		uint32_t dataIdx = 0;
+		bool dataStarted = false;
+		while (std::getline(file, line))
+		{
+			if (const size_t pos = line.find("LUT_3D_SIZE"); pos != std::string::npos)
+			{
+				line.erase(0, pos + 12);
+				const uint32_t lutSize = std::stoi(line);
+				data.resize(static_cast<size_t>(lutSize) * lutSize * lutSize * 4);
+				continue;
+			}
+			if (data.empty())
+				continue;
+			if (!dataStarted)
+			{
+				const size_t firstSpace = line.find(' ');
+				if (firstSpace == std::string::npos || !isFloat(line.substr(0, firstSpace)))
+					continue;
+				dataStarted = true;
+			}
+
+			const size_t firstSpace = line.find(' ');
+			data[dataIdx++] = glm::packHalf1x16(std::stof(line.substr(0, firstSpace)));
+			line.erase(0, firstSpace + 1);
+			const size_t secondSpace = line.find(' ');
+			data[dataIdx++] = glm::packHalf1x16(std::stof(line.substr(0, secondSpace)));
+			line.erase(0, secondSpace + 1);
+			data[dataIdx++] = glm::packHalf1x16(std::stof(line));
+			data[dataIdx++] = glm::packHalf1x16(0.0f);
+		}
+		return data;
+	}
+
+	void writeLUT(const std::string& filepath, uint32_t lutSize)
+	{
+		std::mt19937 randomEngine(7);
+		std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+		std::ofstream file(filepath, std::ios::trunc);
+		file << "TITLE \"CubeLUTParserBenchmark\"\nLUT_3D_SIZE " << lutSize << "\nDOMAIN_MIN 0.0 0.0 0.0\nDOMAIN_MAX 1.0 1.0 1.0\n";
+		char line[64];
+		for (uint64_t lineIdx = 0; lineIdx < static_cast<uint64_t>(lutSize) * lutSize * lutSize; ++lineIdx)
+		{
+			std::snprintf(line, sizeof(line), "%.6f %.6f %.6f\n", distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+			file << line;
+		}
+	}
+
+	template <typename LoadFunction>
+	double measure(const char* name, uint32_t repeatCount, double referenceMs, LoadFunction&& loadFunction)
+	{
+		double bestMs = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			loadFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		std::printf("%-24s %8.2f ms  x%.2f\n", name, bestMs, referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t lutSize = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 64;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 5;
+
+	const std::string filepath = "CubeLUTParserBenchmark.cube";
+	writeLUT(filepath, lutSize);
+	std::filesystem::remove(filepath + ".cache");
+	std::printf("%u^3 LUT, %llu bytes, best of %u\n", lutSize, static_cast<unsigned long long>(std::filesystem::file_size(filepath)), repeatCount);
+
+	const double referenceMs = measure("first parser", repeatCount, 0.0, [&]() { loadWithFirstParser(filepath); });
+	measure("parser", repeatCount, referenceMs, [&]() { Wolf::ImageFileLoader loader(filepath); });
+	{
+		Wolf::JobsManager jobsManager(3);
+		measure("parser, 3 workers", repeatCount, referenceMs, [&]() { Wolf::ImageFileLoader loader(filepath); });
+	}
+
+	// The first load writes the cache
+	Wolf::ImageFileLoader cacheWriter(filepath, false, true);
+	measure("binary cache", repeatCount, referenceMs, [&]() { Wolf::ImageFileLoader loader(filepath, false, true); });
+
+	return 0;
+}
@@ -0,0 +1,631 @@
+#pragma once
+
+#include <codecvt>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <locale>
+#include <stack>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Debug.h>
+
+// First JSONReader of the engine, kept as the reference of the JSON benchmarks.
+// Reads the file line by line as wide strings, each property value is a separate allocation stored in an std::unordered_map.
+
+namespace Wolf::Benchmarks
+{
+	inline std::string ws2s(const std::wstring& wstr)
+	{
+		if (wstr.empty())
+			return "";
+
+		size_t sizeNeeded = std::wcstombs(nullptr, wstr.c_str(), 0);
+		if (sizeNeeded == static_cast<size_t>(-1))
+		{
+			Wolf::Debug::sendError("Conversion failed: invalid multibyte sequence");
+			return "";
+		}
+
+		std::vector<char> str(sizeNeeded + 1);
+		std::wcstombs(str.data(), wstr.c_str(), str.size());
+
+		return { str.data() };
+	}
+
+	class FirstJSONReader
+	{
+	public:
+		struct FileReadInfo
+		{
+			std::string filename;
+		};
+		FirstJSONReader(const FileReadInfo& fileReadInfo);
+
+		struct StringReadInfo
+		{
+			std::string jsonData;
+		};
+		FirstJSONReader(const StringReadInfo& stringReadInfo);
+		~FirstJSONReader();
+
+		class JSONObjectInterface
+		{
+		public:
+			virtual bool hasProperty(const std::string& propertyName) = 0;
+
+			virtual float getPropertyFloat(const std::string& propertyName) = 0;
+			virtual const std::vector<float>& getPropertyFloatArray(const std::string& propertyName) = 0;
+			virtual const std::string& getPropertyString(const std::string& propertyName) = 0;
+			virtual const std::string& getPropertyString(uint32_t propertyIdx) = 0;
+			virtual const std::vector<std::string>& getPropertyStringArray(const std::string& propertyName) = 0;
+			virtual bool getPropertyBool(const std::string& propertyName) = 0;
+			virtual JSONObjectInterface* getPropertyObject(const std::string& propertyName) = 0;
+			virtual JSONObjectInterface* getArrayObjectItem(const std::string& propertyName, uint32_t idx) = 0;
+
+			virtual uint32_t getArraySize(const std::string& propertyName) = 0;
+			virtual uint32_t getPropertyCount() = 0;
+
+			void setVisited() { m_visited = true; }
+			bool hasBeenVisited() const { return m_visited; }
+
+		private:
+			bool m_visited = false;
+		};
+		JSONObjectInterface* getRoot() { return m_rootObject; }
+
+	private:
+		class Lines
+		{
+		public:
+			void addLine(const std::wstring& line) { m_lines.push_back(line); }
+
+			bool getNextLine(std::wstring& outLine) const
+			{
+				if (m_currentLine == m_lines.size())
+					return false;
+
+				outLine = m_lines[m_currentLine++];
+				return true;
+			}
+
+			bool isCRLFReadAsLF() const
+			{
+				return !m_lines.empty() && m_lines[0][m_lines[0].size() - 1] == '\r';
+			}
+
+		private:
+			std::vector<std::wstring> m_lines;
+			mutable uint32_t m_currentLine = 0;
+		};
+
+		void readFromLines(const Lines& lines);
+
+		class JSONObject;
+
+		enum class JSONPropertyType { String, Object, Float, UnknownArray, ObjectArray, FloatArray, StringArray, Bool, Unknown, Null };
+		struct JSONPropertyValue
+		{
+			JSONPropertyType type;
+
+			// Possible values
+			float floatValue = 0;
+			std::string stringValue;
+			bool boolValue = false;
+			JSONObject* objectValue = nullptr;
+			std::vector<JSONObject*> objectArrayValue;
+			std::vector<float> floatArrayValue;
+			std::vector<std::string> stringArrayValue;
+
+			JSONPropertyValue() : type(JSONPropertyType::Unknown) {};
+		};
+
+		class JSONObject final : public JSONObjectInterface
+		{
+		public:
+			std::unordered_map<std::string, JSONPropertyValue*> properties;
+
+			bool hasProperty(const std::string& propertyName) override;
+
+			float getPropertyFloat(const std::string& propertyName) override;
+			const std::vector<float>& getPropertyFloatArray(const std::string& propertyName) override;
+			const std::string& getPropertyString(const std::string& propertyName) override;
+			const std::string& getPropertyString(uint32_t propertyIdx) override;
+			const std::vector<std::string>& getPropertyStringArray(const std::string& propertyName) override;
+			bool getPropertyBool(const std::string& propertyName) override;
+			JSONObjectInterface* getPropertyObject(const std::string& propertyName) override;
+			JSONObjectInterface* getArrayObjectItem(const std::string& propertyName, uint32_t idx) override;
+
+			uint32_t getArraySize(const std::string& propertyName) override;
+			uint32_t getPropertyCount() override;
+		};
+
+		JSONObject* m_rootObject;
+	};
+}
+
+inline Wolf::Benchmarks::FirstJSONReader::FirstJSONReader(const FileReadInfo& fileReadInfo)
+{
+	std::wifstream inputFile(fileReadInfo.filename);
+
+	Lines lines;
+
+	std::wstring line;
+	while (std::getline(inputFile, line))
+	{
+		lines.addLine(line);
+	}
+
+	if (lines.isCRLFReadAsLF())
+	{
+		Debug::sendError("CRLF is not supported");
+	}
+
+	readFromLines(lines);
+}
+
+inline Wolf::Benchmarks::FirstJSONReader::FirstJSONReader(const StringReadInfo& stringReadInfo)
+{
+	Lines lines;
+
+	std::wstring line(stringReadInfo.jsonData.begin(), stringReadInfo.jsonData.end());
+	lines.addLine(line);
+
+	readFromLines(lines);
+}
+
+inline Wolf::Benchmarks::FirstJSONReader::~FirstJSONReader()
+{
+	std::function<void(JSONObject* object)> deleteDataInsideObject;
+	deleteDataInsideObject = [&deleteDataInsideObject](JSONObject* object)
+	{
+		for (auto it = object->properties.begin(); it != object->properties.end(); ++it)
+		{
+			const JSONPropertyValue* propertyValue = it->second;
+			if (propertyValue->type == JSONPropertyType::Object)
+				deleteDataInsideObject(propertyValue->objectValue);
+			else if(propertyValue->type == JSONPropertyType::ObjectArray)
+			{
+				for(JSONObject* object : propertyValue->objectArrayValue)
+				{
+					deleteDataInsideObject(object);
+				}
+			}
+		}
+
+		delete object;
+	};
+
+	deleteDataInsideObject(m_rootObject);
+}
+
+inline void Wolf::Benchmarks::FirstJSONReader::readFromLines(const Lines& lines)
+{
+	m_rootObject = new JSONObject;
+
+	// JSON current state
+	bool jsonStarted = false; // true inside main { }
+	std::stack<JSONObject*>	currentObjectStack;
+	currentObjectStack.push(m_rootObject);
+	std::stack<JSONPropertyValue*> currentPropertyStack;
+
+	enum class LookingFor { NextProperty, Colon, PropertyValue, Comma, NewArrayValue };
+	LookingFor currentLookingFor = LookingFor::NextProperty;
+
+	// helpers
+	auto removeComments = [](std::wstring& line)
+		{
+			if (const size_t commentPos = line.find(L"//"); commentPos != std::wstring::npos)
+			{
+				// Check if it's not in a string
+				bool isInString = false;
+				size_t beginQuotePos = line.find('"');
+				size_t endQuotePosMin = beginQuotePos + 1;
+				while (beginQuotePos != std::wstring::npos)
+				{
+					if (const size_t endQuotePos = line.find('"', endQuotePosMin); endQuotePos != std::wstring::npos)
+					{
+						if (line[endQuotePos - 1] == '\\')
+						{
+							endQuotePosMin = endQuotePos + 1;
+							continue;
+						}
+
+						if (beginQuotePos < commentPos && endQuotePos > commentPos)
+						{
+							isInString = true;
+							break;
+						}
+
+						beginQuotePos = line.find('"', endQuotePos + 1);
+						endQuotePosMin = beginQuotePos + 1;
+					}
+					else
+					{
+						Debug::sendCriticalError("Incorrect line");
+					}
+				}
+					
+
+				if (!isInString)
+				{
+					line = line.substr(0, commentPos);
+				}
+			}
+		};
+	auto removeSpaces = [](std::wstring& line)
+		{
+			std::erase_if(line, isspace);
+		};
+
+	auto lookForAFloat = [&removeSpaces](const std::wstring& line, float& outputFloat, size_t& outputLastCharacterPosition)
+		{
+			if (!line.empty())
+			{
+				std::wstring stringToTry;
+
+				const size_t commaPos = line.find(',');
+				const size_t endArray = line.find(']');
+				const size_t endObject = line.find('}');
+
+				const size_t minEndingPos = std::min(commaPos, std::min(endArray, endObject));
+
+				if (minEndingPos != std::wstring::npos)
+					stringToTry = line.substr(0, minEndingPos);
+				else
+					stringToTry = line;
+
+				try
+				{
+					std::wstring stringWithoutSpaces = stringToTry; removeSpaces(stringWithoutSpaces);
+					outputFloat = std::stof(stringWithoutSpaces);
+					outputLastCharacterPosition = minEndingPos != std::wstring::npos ? minEndingPos : stringToTry.size();
+					return true;
+				}
+				catch (std::invalid_argument const&)
+				{
+				}
+
+				return false;
+			}
+
+			return false;
+		};
+
+	std::wstring line;
+	int32_t currentLineNumber = -1;
+	auto getLine = [&]()
+		{
+			if (line.empty() || line == L"\r")
+			{
+				currentLineNumber++;
+				return lines.getNextLine(line);
+			}
+			return true;
+		};
+
+	while (getLine())
+	{
+		removeComments(line);
+
+		if (!jsonStarted)
+		{
+			if (const size_t jsonStartingPos = line.find('{'); jsonStartingPos != std::string::npos)
+			{
+				line = line.substr(jsonStartingPos + 1);
+				jsonStarted = true;
+			}
+			continue;
+		}
+
+		// Get next property
+		if (currentLookingFor == LookingFor::NextProperty)
+		{
+			const size_t quotePos = line.find('"');
+			const size_t endObjectPos = line.find('}');
+
+			if (quotePos < endObjectPos)
+			{
+				line = line.substr(quotePos + 1);
+				if (const size_t propertyNameEnding = line.find('"'); propertyNameEnding != std::string::npos)
+				{
+					std::wstring propertyName = line.substr(0, propertyNameEnding);
+
+					if (currentObjectStack.top()->properties.contains(ws2s(propertyName)))
+						Debug::sendError("JSON property " + ws2s(propertyName) + " is defined twice");
+
+					currentObjectStack.top()->properties.insert({ ws2s(propertyName), new JSONPropertyValue() });
+					currentPropertyStack.push(currentObjectStack.top()->properties[ws2s(propertyName)]);
+
+					line = line.substr(propertyNameEnding + 1);
+					currentLookingFor = LookingFor::Colon;
+				}
+				else
+					Debug::sendCriticalError("JSON seems wrong: property doesn't end");
+			}
+			else if (endObjectPos != std::string::npos)
+			{
+				currentObjectStack.pop();
+
+				if (currentObjectStack.empty())
+					break;
+
+				currentLookingFor = LookingFor::Comma;
+				line = line.substr(endObjectPos + 1);
+			}
+		}
+		else if (currentLookingFor == LookingFor::Colon)
+		{
+			if (const size_t colonPos = line.find(':'); colonPos != std::string::npos)
+			{
+				line = line.substr(colonPos + 1);
+				currentLookingFor = LookingFor::PropertyValue;
+			}
+		}
+		else if (currentLookingFor == LookingFor::Comma)
+		{
+			const size_t endArrayPos = line.find(']');
+			const size_t commaPos = line.find(',');
+			const size_t endObjectPos = line.find('}');
+
+			if (commaPos < endArrayPos && commaPos < endObjectPos)
+			{
+				line = line.substr(commaPos + 1);
+
+				bool isLookingForNextObjectArrayItem = !currentPropertyStack.empty() && currentPropertyStack.top()->type == JSONPropertyType::ObjectArray && currentObjectStack.top() != currentPropertyStack.top()->objectArrayValue.back();
+				if (!currentPropertyStack.empty() && (currentPropertyStack.top()->type == JSONPropertyType::FloatArray || currentPropertyStack.top()->type == JSONPropertyType::StringArray || isLookingForNextObjectArrayItem))
+				{
+					currentLookingFor = LookingFor::NewArrayValue;
+				}
+				else
+				{
+					currentLookingFor = LookingFor::NextProperty;
+				}
+			}
+			else if (endArrayPos != std::string::npos && endArrayPos < endObjectPos)
+			{
+				if (currentPropertyStack.empty() ||
+					(currentPropertyStack.top()->type != JSONPropertyType::FloatArray && currentPropertyStack.top()->type != JSONPropertyType::StringArray && currentPropertyStack.top()->type != JSONPropertyType::UnknownArray && 
+						currentPropertyStack.top()->type != JSONPropertyType::ObjectArray))
+					Debug::sendError("JSON unexpected ']' when property is not array");
+
+				currentPropertyStack.pop();
+				line = line.substr(endArrayPos + 1);
+				currentLookingFor = LookingFor::Comma;
+			}
+			else if (endObjectPos != std::string::npos)
+			{
+				JSONObject* removedObject = currentObjectStack.top();
+				currentObjectStack.pop();
+
+				if (currentObjectStack.empty())
+					break;
+
+				// If the object is a property, we need to remove it
+				JSONPropertyValue* topProperty = currentPropertyStack.top();
+				if (topProperty->objectValue == removedObject)
+				{
+					currentPropertyStack.pop();
+				}
+
+				currentLookingFor = LookingFor::Comma;
+				line = line.substr(endObjectPos + 1);
+			}
+		}
+		else if (currentLookingFor == LookingFor::PropertyValue)
+		{
+			const size_t bracePos = line.find('{');
+			const size_t quotePos = line.find('"');
+			const size_t bracketPos = line.find('[');
+
+			std::wstring duplicatedLine = line;
+			removeSpaces(duplicatedLine);
+			char nextCharacter = static_cast<char>(toupper(duplicatedLine[0]));
+
+			if (nextCharacter == 'F' || nextCharacter == 'T')
+			{
+				currentPropertyStack.top()->type = JSONPropertyType::Bool;
+				if (nextCharacter == 'F')
+				{
+					currentPropertyStack.top()->boolValue = false;
+				}
+				else
+				{
+					currentPropertyStack.top()->boolValue = true;
+				}
+				const size_t propertyValueEnding = std::min(line.find('e'), line.find('E'));
+				line = line.substr(propertyValueEnding + 1);
+				currentPropertyStack.pop();
+				currentLookingFor = LookingFor::Comma;
+			}
+			else if (isdigit(nextCharacter) || nextCharacter == '-')
+			{
+				float floatValue;
+				size_t lastCharacterPos;
+				if (lookForAFloat(line, floatValue, lastCharacterPos))
+				{
+					currentPropertyStack.top()->type = JSONPropertyType::Float;
+					currentPropertyStack.top()->floatValue = floatValue;
+					line = line.substr(lastCharacterPos);
+
+					currentPropertyStack.pop();
+					currentLookingFor = LookingFor::Comma;
+				}
+			}
+			else if (nextCharacter == 'N')
+			{
+				currentPropertyStack.top()->type = JSONPropertyType::Null;
+				const size_t propertyValueEnding = line.find('l') + 1;
+				line = line.substr(propertyValueEnding + 1);
+				currentPropertyStack.pop();
+				currentLookingFor = LookingFor::Comma;
+			}
+			else if (bracePos < quotePos && bracePos < bracketPos)
+			{
+				currentPropertyStack.top()->type = JSONPropertyType::Object;
+				currentPropertyStack.top()->objectValue = new JSONObject;
+
+				currentObjectStack.push(currentPropertyStack.top()->objectValue);
+				line = line.substr(line.find('{') + 1);
+				currentLookingFor = LookingFor::NextProperty;
+			}
+			else if (quotePos < bracePos && quotePos < bracketPos)
+			{
+				currentPropertyStack.top()->type = JSONPropertyType::String;
+				line = line.substr(quotePos + 1);
+				size_t propertyStringEnding = line.find('"');
+
+				while (propertyStringEnding != std::string::npos)
+				{
+					if (propertyStringEnding > 0 && line[propertyStringEnding - 1] == '\\')
+					{
+						line.erase(propertyStringEnding - 1, 1);
+						propertyStringEnding = line.find('"', propertyStringEnding);
+						continue;
+					}
+					break;
+				}
+
+				if (propertyStringEnding != std::string::npos)
+				{
+					std::wstring propertyValue = line.substr(0, propertyStringEnding);
+
+					currentPropertyStack.top()->stringValue = ws2s(propertyValue);
+
+					line = line.substr(propertyStringEnding + 1);
+					currentPropertyStack.pop();
+					currentLookingFor = LookingFor::Comma;
+				}
+				else
+					Debug::sendError("JSON seems wrong: property string value doesn't end");
+			}
+			else if (bracketPos < bracePos && bracketPos < quotePos)
+			{
+				currentPropertyStack.top()->type = JSONPropertyType::UnknownArray;
+
+				line = line.substr(bracketPos + 1);
+				currentLookingFor = LookingFor::NewArrayValue;
+			}
+		}
+		else if (currentLookingFor == LookingFor::NewArrayValue)
+		{
+			std::wstring lineWithoutSpace = line;
+			removeSpaces(lineWithoutSpace);
+
+			const size_t bracePos = lineWithoutSpace.find('{');
+			const size_t quotePos = lineWithoutSpace.find('"');
+			const size_t endOfArrayPos = lineWithoutSpace.find(']');
+
+			if (bracePos == 0)
+			{
+				currentPropertyStack.top()->type = JSONPropertyType::ObjectArray;
+				currentPropertyStack.top()->objectArrayValue.push_back(new JSONObject);
+
+				currentObjectStack.push(currentPropertyStack.top()->objectArrayValue.back());
+				line = line.substr(line.find('{') + 1);
+				currentLookingFor = LookingFor::NextProperty;
+			}
+			else if (quotePos == 0)
+			{
+				currentPropertyStack.top()->type = JSONPropertyType::StringArray;
+				line = line.substr(line.find('"') + 1);
+				if (const size_t propertyStringEnding = line.find('"'); propertyStringEnding != std::string::npos)
+				{
+					std::wstring propertyValue = line.substr(0, propertyStringEnding);
+
+					currentPropertyStack.top()->stringArrayValue.push_back(ws2s(propertyValue));
+
+					line = line.substr(propertyStringEnding + 1);
+					currentLookingFor = LookingFor::Comma;
+				}
+				else
+					Debug::sendError("JSON seems wrong: property string value doesn't end");
+			}
+			else if (endOfArrayPos == 0)
+			{
+				currentPropertyStack.top()->type = JSONPropertyType::UnknownArray;
+				currentLookingFor = LookingFor::Comma;
+			}
+			else
+			{
+				float floatValue;
+				size_t lastCharacterPos;
+				if (lookForAFloat(line, floatValue, lastCharacterPos))
+				{
+					currentPropertyStack.top()->type = JSONPropertyType::FloatArray;
+					currentPropertyStack.top()->floatArrayValue.push_back(floatValue);
+					line = line.substr(lastCharacterPos);
+					currentLookingFor = LookingFor::Comma;
+				}
+			}
+		}
+	}
+}
+
+inline bool Wolf::Benchmarks::FirstJSONReader::JSONObject::hasProperty(const std::string& propertyName)
+{
+	return properties.contains(propertyName);
+}
+
+inline float Wolf::Benchmarks::FirstJSONReader::JSONObject::getPropertyFloat(const std::string& propertyName)
+{
+	return properties[propertyName]->floatValue;
+}
+
+inline const std::vector<float>& Wolf::Benchmarks::FirstJSONReader::JSONObject::getPropertyFloatArray(const std::string& propertyName)
+{
+	return properties[propertyName]->floatArrayValue;
+}
+
+inline const std::string& Wolf::Benchmarks::FirstJSONReader::JSONObject::getPropertyString(const std::string& propertyName)
+{
+	return properties[propertyName]->stringValue;
+}
+
+inline const std::string& Wolf::Benchmarks::FirstJSONReader::JSONObject::getPropertyString(uint32_t propertyIdx)
+{
+	auto it = properties.begin();
+	std::advance(it, propertyIdx);
+	return it->first;
+}
+
+inline const std::vector<std::string>& Wolf::Benchmarks::FirstJSONReader::JSONObject::getPropertyStringArray(const std::string& propertyName)
+{
+	return properties[propertyName]->stringArrayValue;
+}
+
+inline bool Wolf::Benchmarks::FirstJSONReader::JSONObject::getPropertyBool(const std::string& propertyName)
+{
+	if (properties[propertyName]->type != JSONPropertyType::Bool)
+		Debug::sendError("Property is not a bool");
+	return properties[propertyName]->boolValue;
+}
+
+inline Wolf::Benchmarks::FirstJSONReader::JSONObjectInterface* Wolf::Benchmarks::FirstJSONReader::JSONObject::getPropertyObject(const std::string& propertyName)
+{
+	if (!properties.contains(propertyName))
+		return nullptr;
+
+	if (properties[propertyName]->type != JSONPropertyType::Object)
+		Debug::sendError("Property is not an object");
+	return properties[propertyName]->objectValue;
+}
+
+inline Wolf::Benchmarks::FirstJSONReader::JSONObjectInterface* Wolf::Benchmarks::FirstJSONReader::JSONObject::getArrayObjectItem(const std::string& propertyName, uint32_t idx)
+{
+	return properties[propertyName]->objectArrayValue[idx];
+}
+
+inline uint32_t Wolf::Benchmarks::FirstJSONReader::JSONObject::getArraySize(const std::string& propertyName)
+{
+	if (!properties.contains(propertyName))
+		return 0;
+	return static_cast<uint32_t>(properties[propertyName]->objectArrayValue.size());
+}
+
+inline uint32_t Wolf::Benchmarks::FirstJSONReader::JSONObject::getPropertyCount()
+{
+	return static_cast<uint32_t>(properties.size());
+}
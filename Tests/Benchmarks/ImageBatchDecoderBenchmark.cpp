@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <Debug.h>
+
+#include "ImageBatchDecoder.h"
+
+// Decode time of a corpus of PNG, JPEG and HDR files, loaded one after the other by the calling thread as before,
+// then by an ImageBatchDecoder with several streaming thread counts, without a limit and with a 16 MB in flight cap.
+// Usage: ImageBatchDecoderBenchmark [imageCount] [size] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	std::vector<Wolf::ImageBatchDecoder::Request> writeCorpus(uint32_t imageCount, uint32_t size)
+	{
+		std::vector<Wolf::ImageBatchDecoder::Request> requests;
+		std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 3);
+		std::vector<float> hdrPixels(pixels.size());
+		for (uint32_t imageIdx = 0; imageIdx < imageCount; ++imageIdx)
+		{
+			for (uint32_t y = 0; y < size; ++y)
+			{
+				for (uint32_t x = 0; x < size; ++x)
+				{
+					uint8_t* pixel = &pixels[(x + static_cast<size_t>(y) * size) * 3];
+					pixel[0] = static_cast<uint8_t>(x ^ y);
+					pixel[1] = static_cast<uint8_t>((x * y) >> 6);
+					pixel[2] = static_cast<uint8_t>(imageIdx * 17 + (x >> 3));
+				}
+			}
+
+			const std::string filepath = "ImageBatchDecoderBenchmark_" + std::to_string(imageIdx);
+			switch (imageIdx % 3)
+			{
+				case 0:
+					stbi_write_png((filepath + ".png").c_str(), static_cast<int>(size), static_cast<int>(size), 3, pixels.data(), static_cast<int>(size) * 3);
+					requests.push_back({ filepath + ".png" });
+					break;
+				case 1:
+					stbi_write_jpg((filepath + ".jpg").c_str(), static_cast<int>(size), static_cast<int>(size), 3, pixels.data(), 90);
+					requests.push_back({ filepath + ".jpg" });
+					break;
+				default:
+					for (size_t valueIdx = 0; valueIdx < pixels.size(); ++valueIdx)
+						hdrPixels[valueIdx] = std::exp2(static_cast<float>(pixels[valueIdx]) / 32.0f);
+					stbi_write_hdr((filepath + ".hdr").c_str(), static_cast<int>(size), static_cast<int>(size), 3, hdrPixels.data());
+					requests.push_back({ filepath + ".hdr" });
+					break;
+			}
+		}
+		return requests;
+	}
+
+	template <typename DecodeFunction>
+	void measure(const char* name, uint32_t repeatCount, DecodeFunction&& decodeFunction)
+	{
+		double bestMs = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			decodeFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		std::printf("%-32s %8.1f ms\n", name, bestMs);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t imageCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 24;
+	const uint32_t size = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 1024;
+	const uint32_t repeatCount = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 3;
+
+	const std::vector<Wolf::ImageBatchDecoder::Request> corpus = writeCorpus(imageCount, size);
+	std::printf("%u images of %ux%u, best of %u, %u hardware threads\n", imageCount, size, size, repeatCount, std::thread::hardware_concurrency());
+
+	measure("sequential", repeatCount, [&]()
+	{
+		for (const Wolf::ImageBatchDecoder::Request& request : corpus)
+			const Wolf::ImageFileLoader loader(request.m_path, request.m_loadFloat, request.m_useBinaryCache);
+	});
+
+	for (const uint32_t streamingThreadCount : { 1u, 2u, 4u, 8u })
+	{
+		Wolf::JobsManager jobsManager(0, streamingThreadCount);
+		Wolf::ImageBatchDecoder decoder{ Wolf::ResourceNonOwner<Wolf::JobsManager>(&jobsManager) };
+		const auto decodeCorpus = [&]()
+		{
+			decoder.decode(corpus, [](uint32_t, Wolf::ImageBatchDecoder::DecodedImage&&) {});
+			decoder.waitIdle();
+		};
+
+		const std::string name = "batch, " + std::to_string(streamingThreadCount) + " streaming threads";
+		measure(name.c_str(), repeatCount, decodeCorpus);
+		decoder.setMaxInFlightByteCount(16 * 1024 * 1024);
+		measure("  with a 16 MB cap", repeatCount, decodeCorpus);
+	}
+
+	return 0;
+}
@@ -0,0 +1,242 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <Debug.h>
+#include <glm/gtc/packing.hpp>
+
+#include "ImageCompression.h"
+#include "JobsManager.h"
+
+// Single thread compression speed on synthetic images, with the PSNR of the pixels decoded from the blocks.
+// BC1 and BC3 are measured with each instruction set, the one selected at startup is restored at the end.
+// BC6H is measured on an HDR sky, its error is in stops.
+// Tiled compression of the noisy photo is then measured with several engine worker counts, the blocks must not change.
+// Usage: ImageCompressionBenchmark [size] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+	using RGBA8 = Wolf::ImageCompression::RGBA8;
+
+	struct Image
+	{
+		const char* name;
+		std::vector<RGBA8> pixels;
+	};
+
+	std::vector<Image> createImages(uint32_t size)
+	{
+		std::mt19937 randomEngine(3);
+		std::uniform_int_distribution<int32_t> noise(-12, 12);
+		auto clampToByte = [](int32_t value) { return static_cast<uint8_t>(std::min(std::max(value, 0), 255)); };
+
+		std::vector<Image> images = { { "gradient", {} }, { "noisy photo", {} }, { "normal map", {} } };
+		for (Image& image : images)
+			image.pixels.resize(static_cast<size_t>(size) * size);
+
+		for (uint32_t y = 0; y < size; ++y)
+		{
+			for (uint32_t x = 0; x < size; ++x)
+			{
+				const size_t pixelIdx = x + static_cast<size_t>(y) * size;
+				const int32_t r = static_cast<int32_t>(x * 255 / size), g = static_cast<int32_t>(y * 255 / size), b = static_cast<int32_t>((x + y) * 127 / size);
+				images[0].pixels[pixelIdx] = RGBA8(clampToByte(r), clampToByte(g), clampToByte(b), clampToByte(255 - r));
+
+				// Smooth shapes with grain, like a photo
+				const int32_t shape = static_cast<int32_t>(64.0f * std::sin(static_cast<float>(x) * 0.05f) * std::cos(static_cast<float>(y) * 0.07f));
+				images[1].pixels[pixelIdx] = RGBA8(clampToByte(128 + shape + noise(randomEngine)), clampToByte(96 + shape / 2 + noise(randomEngine)), clampToByte(160 - shape + noise(randomEngine)),
+					clampToByte(200 + noise(randomEngine)));
+
+				const float dx = std::sin(static_cast<float>(x) * 0.3f) * 0.5f;
+				const float dy = std::cos(static_cast<float>(y) * 0.2f) * 0.5f;
+				const float length = std::sqrt(dx * dx + dy * dy + 1.0f);
+				images[2].pixels[pixelIdx] = RGBA8(static_cast<uint8_t>((dx / length * 0.5f + 0.5f) * 255.0f), static_cast<uint8_t>((dy / length * 0.5f + 0.5f) * 255.0f),
+					static_cast<uint8_t>((1.0f / length * 0.5f + 0.5f) * 255.0f), 255);
+			}
+		}
+		return images;
+	}
+
+	double computePSNR(const std::vector<RGBA8>& reference, const std::vector<RGBA8>& pixels, uint32_t channelCount)
+	{
+		double squaredErrorSum = 0.0;
+		for (size_t pixelIdx = 0; pixelIdx < reference.size(); ++pixelIdx)
+		{
+			for (uint32_t channelIdx = 0; channelIdx < channelCount; ++channelIdx)
+			{
+				const double error = static_cast<double>(reference[pixelIdx][channelIdx]) - static_cast<double>(pixels[pixelIdx][channelIdx]);
+				squaredErrorSum += error * error;
+			}
+		}
+		const double meanSquaredError = squaredErrorSum / (static_cast<double>(reference.size()) * channelCount);
+		return meanSquaredError == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+	}
+
+	// Best time of the repeats, in megapixels per second
+	template <typename PixelType, typename BlockType>
+	double measureSpeed(const std::vector<PixelType>& pixels, uint32_t size, Wolf::ImageCompression::Quality quality, uint32_t repeatCount, std::vector<BlockType>& outBlocks)
+	{
+		double bestSeconds = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			Wolf::ImageCompression::compress(Wolf::Extent3D{ size, size, 1 }, pixels, outBlocks, quality);
+			bestSeconds = std::min(bestSeconds, std::chrono::duration<double>(Clock::now() - start).count());
+		}
+		return static_cast<double>(size) * size / 1e6 / bestSeconds;
+	}
+
+	template <typename BlockType>
+	void runBenchmark(const char* formatName, Wolf::ImageCompression::Compression compression, const std::vector<Image>& images, uint32_t size, uint32_t repeatCount)
+	{
+		const Wolf::ImageCompression::InstructionSet instructionSets[] = { Wolf::ImageCompression::InstructionSet::BASELINE, Wolf::ImageCompression::InstructionSet::AVX2 };
+		const char* instructionSetNames[] = { "baseline", "AVX2" };
+
+		for (const Image& image : images)
+		{
+			for (const Wolf::ImageCompression::Quality quality : { Wolf::ImageCompression::Quality::FAST, Wolf::ImageCompression::Quality::HIGH })
+			{
+				for (uint32_t instructionSetIdx = 0; instructionSetIdx < 2; ++instructionSetIdx)
+				{
+					if (!Wolf::ImageCompression::setInstructionSet(instructionSets[instructionSetIdx]))
+						continue;
+
+					std::vector<BlockType> blocks;
+					const double megapixelsPerSecond = measureSpeed(image.pixels, size, quality, repeatCount, blocks);
+
+					std::vector<RGBA8> decodedPixels;
+					Wolf::ImageCompression::uncompressImage(compression, reinterpret_cast<const unsigned char*>(blocks.data()), Wolf::Extent2D{ size, size }, decodedPixels);
+
+					std::printf("%s %-4s %-11s %-8s %8.2f MP/s  PSNR %.2f dB\n", formatName, quality == Wolf::ImageCompression::Quality::FAST ? "fast" : "high", image.name,
+						instructionSetNames[instructionSetIdx], megapixelsPerSecond, computePSNR(image.pixels, decodedPixels, 3));
+				}
+			}
+		}
+	}
+
+	// Single channel and BPTC formats have a single implementation, PSNR is measured on the channels they store
+	template <typename BlockType>
+	void runFormatBenchmark(const char* formatName, Wolf::ImageCompression::Compression compression, uint32_t channelCount, const std::vector<Image>& images, uint32_t size, uint32_t repeatCount)
+	{
+		for (const Image& image : images)
+		{
+			for (const Wolf::ImageCompression::Quality quality : { Wolf::ImageCompression::Quality::FAST, Wolf::ImageCompression::Quality::HIGH })
+			{
+				std::vector<BlockType> blocks;
+				const double megapixelsPerSecond = measureSpeed(image.pixels, size, quality, repeatCount, blocks);
+
+				std::vector<RGBA8> decodedPixels;
+				Wolf::ImageCompression::uncompressImage(compression, reinterpret_cast<const unsigned char*>(blocks.data()), Wolf::Extent2D{ size, size }, decodedPixels);
+
+				std::printf("%s %-4s %-11s %8.2f MP/s  PSNR %.2f dB\n", formatName, quality == Wolf::ImageCompression::Quality::FAST ? "fast" : "high", image.name, megapixelsPerSecond,
+					computePSNR(image.pixels, decodedPixels, channelCount));
+			}
+		}
+	}
+
+	void runBC6HBenchmark(uint32_t size, uint32_t repeatCount)
+	{
+		// Sky with a sun several orders of magnitude brighter
+		std::mt19937 randomEngine(5);
+		std::uniform_real_distribution<float> noise(0.9f, 1.1f);
+		std::vector<Wolf::ImageCompression::RGBA32F> pixels(static_cast<size_t>(size) * size);
+		for (uint32_t y = 0; y < size; ++y)
+		{
+			for (uint32_t x = 0; x < size; ++x)
+			{
+				const float sky = 0.3f + 2.0f * static_cast<float>(y) / static_cast<float>(size);
+				const float dx = static_cast<float>(x) - 0.7f * static_cast<float>(size), dy = static_cast<float>(y) - 0.2f * static_cast<float>(size);
+				const float sun = 2000.0f * std::exp(-(dx * dx + dy * dy) / (0.002f * static_cast<float>(size) * static_cast<float>(size)));
+				pixels[x + static_cast<size_t>(y) * size] = Wolf::ImageCompression::RGBA32F((sky * 0.6f + sun) * noise(randomEngine), (sky * 0.8f + sun * 0.9f) * noise(randomEngine),
+					(sky + sun * 0.7f) * noise(randomEngine), 1.0f);
+			}
+		}
+
+		for (const Wolf::ImageCompression::Quality quality : { Wolf::ImageCompression::Quality::FAST, Wolf::ImageCompression::Quality::HIGH })
+		{
+			std::vector<Wolf::ImageCompression::BC6H> blocks;
+			const double megapixelsPerSecond = measureSpeed(pixels, size, quality, repeatCount, blocks);
+
+			std::vector<Wolf::ImageCompression::RGBA16F> decodedPixels;
+			Wolf::ImageCompression::uncompressImage(Wolf::ImageCompression::Compression::BC6H, reinterpret_cast<const unsigned char*>(blocks.data()), Wolf::Extent2D{ size, size }, decodedPixels);
+
+			double squaredErrorSum = 0.0;
+			for (size_t pixelIdx = 0; pixelIdx < pixels.size(); ++pixelIdx)
+			{
+				const float reference[3] = { pixels[pixelIdx].r, pixels[pixelIdx].g, pixels[pixelIdx].b };
+				const uint16_t decoded[3] = { decodedPixels[pixelIdx].r, decodedPixels[pixelIdx].g, decodedPixels[pixelIdx].b };
+				for (uint32_t channelIdx = 0; channelIdx < 3; ++channelIdx)
+				{
+					const double error = std::log2(glm::unpackHalf1x16(decoded[channelIdx]) + 1e-3) - std::log2(reference[channelIdx] + 1e-3);
+					squaredErrorSum += error * error;
+				}
+			}
+
+			std::printf("BC6H %-4s HDR sky     %8.2f MP/s  RMSE %.4f stops\n", quality == Wolf::ImageCompression::Quality::FAST ? "fast" : "high", megapixelsPerSecond,
+				std::sqrt(squaredErrorSum / (static_cast<double>(pixels.size()) * 3)));
+		}
+	}
+	template <typename BlockType>
+	void runTiledBenchmark(const char* formatName, const std::vector<RGBA8>& pixels, uint32_t size, Wolf::ImageCompression::Quality quality, uint32_t repeatCount)
+	{
+		std::vector<BlockType> referenceBlocks;
+		Wolf::ImageCompression::compress(Wolf::Extent3D{ size, size, 1 }, pixels, referenceBlocks, quality);
+
+		double singleThreadMegapixelsPerSecond = 0.0;
+		for (const uint32_t workerCount : { 0u, 1u, 3u, 7u })
+		{
+			// Without a JobsManager every tile is compressed by the calling thread
+			std::unique_ptr<Wolf::JobsManager> jobsManager(workerCount > 0 ? new Wolf::JobsManager(workerCount) : nullptr);
+			Wolf::ImageCompression::TiledCompressionInfo info;
+			info.quality = quality;
+
+			std::vector<BlockType> blocks;
+			double bestSeconds = 1e30;
+			for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+			{
+				const Clock::time_point start = Clock::now();
+				Wolf::ImageCompression::compressTiled(Wolf::Extent3D{ size, size, 1 }, pixels, blocks, info);
+				bestSeconds = std::min(bestSeconds, std::chrono::duration<double>(Clock::now() - start).count());
+			}
+
+			const double megapixelsPerSecond = static_cast<double>(size) * size / 1e6 / bestSeconds;
+			if (workerCount == 0)
+				singleThreadMegapixelsPerSecond = megapixelsPerSecond;
+			std::printf("%s %-4s tiled, %u workers %8.2f MP/s  x%.2f  %s\n", formatName, quality == Wolf::ImageCompression::Quality::FAST ? "fast" : "high", workerCount, megapixelsPerSecond,
+				megapixelsPerSecond / singleThreadMegapixelsPerSecond, std::memcmp(blocks.data(), referenceBlocks.data(), blocks.size() * sizeof(BlockType)) == 0 ? "same blocks" : "DIFFERENT BLOCKS");
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) & ~3u : 1024;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 5;
+
+	const Wolf::ImageCompression::InstructionSet startupInstructionSet = Wolf::ImageCompression::getInstructionSet();
+	std::printf("%ux%u images, best of %u, startup instruction set: %s\n", size, size, repeatCount, startupInstructionSet == Wolf::ImageCompression::InstructionSet::AVX2 ? "AVX2" : "baseline");
+
+	const std::vector<Image> images = createImages(size);
+	runBenchmark<Wolf::ImageCompression::BC1>("BC1", Wolf::ImageCompression::Compression::BC1, images, size, repeatCount);
+	runBenchmark<Wolf::ImageCompression::BC3>("BC3", Wolf::ImageCompression::Compression::BC3, images, size, repeatCount);
+	runFormatBenchmark<Wolf::ImageCompression::BC4>("BC4", Wolf::ImageCompression::Compression::BC4, 1, images, size, repeatCount);
+	runFormatBenchmark<Wolf::ImageCompression::BC7>("BC7", Wolf::ImageCompression::Compression::BC7, 4, images, size, repeatCount);
+	runBC6HBenchmark(size, repeatCount);
+	runTiledBenchmark<Wolf::ImageCompression::BC1>("BC1", images[1].pixels, size, Wolf::ImageCompression::Quality::HIGH, repeatCount);
+	runTiledBenchmark<Wolf::ImageCompression::BC7>("BC7", images[1].pixels, size, Wolf::ImageCompression::Quality::FAST, repeatCount);
+
+	Wolf::ImageCompression::setInstructionSet(startupInstructionSet);
+	return 0;
+}
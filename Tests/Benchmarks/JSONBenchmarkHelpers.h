@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace Wolf::Benchmarks
+{
+	// Scene file with entityCount entities, each with a material and LODs (about 550 bytes per entity).
+	// Only uses what the first JSONReader can read: one value per line, no escaped characters and no empty or nested arrays
+	inline std::string generateSceneJSON(uint32_t entityCount)
+	{
+		std::string json = "{\n\t\"name\": \"Benchmark scene\",\n\t\"version\": 3,\n\t\"entities\": [\n";
+		char buffer[1024];
+		for (uint32_t entityIdx = 0; entityIdx < entityCount; ++entityIdx)
+		{
+			const float x = static_cast<float>(entityIdx % 100) * 1.5f;
+			const float z = -static_cast<float>(entityIdx / 100) * 0.25f;
+			std::snprintf(buffer, sizeof(buffer),
+				"\t\t{\n"
+				"\t\t\t\"name\": \"Entity %u\",\n"
+				"\t\t\t\"type\": \"StaticMesh\",\n"
+				"\t\t\t\"visible\": %s,\n"
+				"\t\t\t\"position\": [%.3f, 2.5, %.3f],\n"
+				"\t\t\t\"rotation\": [0.0, 0.7071, 0.0, 0.7071],\n"
+				"\t\t\t\"scale\": [1.0, 1.0, 1.0],\n"
+				"\t\t\t\"material\": {\n"
+				"\t\t\t\t\"albedo\": \"Textures/albedo_%u.png\",\n"
+				"\t\t\t\t\"normal\": \"Textures/normal_%u.png\",\n"
+				"\t\t\t\t\"roughness\": %.2f,\n"
+				"\t\t\t\t\"metalness\": 0.1,\n"
+				"\t\t\t\t\"tags\": [\"opaque\", \"shadowCaster\"]\n"
+				"\t\t\t},\n"
+				"\t\t\t\"lods\": [\n"
+				"\t\t\t\t{\n"
+				"\t\t\t\t\t\"distance\": 10.0,\n"
+				"\t\t\t\t\t\"mesh\": \"Meshes/mesh_%u_lod0.obj\"\n"
+				"\t\t\t\t},\n"
+				"\t\t\t\t{\n"
+				"\t\t\t\t\t\"distance\": 50.0,\n"
+				"\t\t\t\t\t\"mesh\": \"Meshes/mesh_%u_lod1.obj\"\n"
+				"\t\t\t\t}\n"
+				"\t\t\t]\n"
+				"\t\t}%s\n",
+				entityIdx, entityIdx % 3 == 0 ? "false" : "true", x, z, entityIdx % 64, entityIdx % 64, static_cast<float>(entityIdx % 10) * 0.1f, entityIdx % 500, entityIdx % 500,
+				entityIdx + 1 < entityCount ? "," : "");
+			json += buffer;
+		}
+		json += "\t]\n}\n";
+		return json;
+	}
+
+	inline void writeTextFile(const std::string& filename, const std::string& content)
+	{
+		std::ofstream(filename, std::ios::binary | std::ios::trunc).write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	// Reads every value of a generated scene, so both readers can be checked against each other.
+	// Works with any reader exposing the JSONReader object interface
+	template <typename JSONObjectInterface>
+	double computeSceneChecksum(JSONObjectInterface* root)
+	{
+		double checksum = root->getPropertyFloat("version");
+		const uint32_t entityCount = root->getArraySize("entities");
+		for (uint32_t entityIdx = 0; entityIdx < entityCount; ++entityIdx)
+		{
+			JSONObjectInterface* entity = root->getArrayObjectItem("entities", entityIdx);
+			checksum += static_cast<double>(entity->getPropertyString("name").size() + entity->getPropertyString("type").size());
+			checksum += entity->getPropertyBool("visible") ? 1.0 : 0.0;
+			for (const char* arrayName : { "position", "rotation", "scale" })
+			{
+				for (const float value : entity->getPropertyFloatArray(arrayName))
+					checksum += value;
+			}
+
+			JSONObjectInterface* material = entity->getPropertyObject("material");
+			checksum += static_cast<double>(material->getPropertyString("albedo").size() + material->getPropertyString("normal").size());
+			checksum += material->getPropertyFloat("roughness") + material->getPropertyFloat("metalness");
+			checksum += static_cast<double>(material->getPropertyStringArray("tags").size());
+
+			const uint32_t lodCount = entity->getArraySize("lods");
+			for (uint32_t lodIdx = 0; lodIdx < lodCount; ++lodIdx)
+			{
+				JSONObjectInterface* lod = entity->getArrayObjectItem("lods", lodIdx);
+				checksum += lod->getPropertyFloat("distance") + static_cast<double>(lod->getPropertyString("mesh").size());
+			}
+		}
+		return checksum;
+	}
+}
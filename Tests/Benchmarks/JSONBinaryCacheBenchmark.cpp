@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <Debug.h>
+
+#include "JSONBenchmarkHelpers.h"
+#include "JSONReader.h"
+
+// JSONReader binary cache on a generated multi-MB scene file: parse without cache, first parse writing the cache (cold) and load from the cache (warm hit).
+// The source is hashed in every case with the cache enabled, this is included in the cold and warm timings.
+// Usage: JSONBinaryCacheBenchmark [entityCount] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// prepareFunction is not timed
+	template <typename PrepareFunction, typename RunFunction>
+	double measure(const char* name, uint32_t repeatCount, double megabyteCount, double referenceMs, PrepareFunction&& prepareFunction, RunFunction&& runFunction)
+	{
+		double bestMs = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			prepareFunction();
+			const Clock::time_point start = Clock::now();
+			runFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		std::printf("  %-22s %8.2f ms %8.1f MB/s  x%.2f\n", name, bestMs, megabyteCount * 1000.0 / bestMs, referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t entityCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 20'000;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 5;
+
+	const std::string filename = "JSONBinaryCacheBenchmark.json";
+	const std::string cacheFilename = filename + ".cache";
+	const std::string json = Wolf::Benchmarks::generateSceneJSON(entityCount);
+	Wolf::Benchmarks::writeTextFile(filename, json);
+	const double megabyteCount = static_cast<double>(json.size()) / (1024.0 * 1024.0);
+	std::printf("%u entities, %.2f MB, best of %u\n", entityCount, megabyteCount, repeatCount);
+
+	// Readers are destroyed out of the timings, trees are checked afterwards
+	std::unique_ptr<Wolf::JSONReader> jsonReader;
+	const double referenceMs = measure("parse without cache", repeatCount, megabyteCount, 0.0, [&]() { jsonReader.reset(); }, [&]()
+	{
+		jsonReader.reset(new Wolf::JSONReader(Wolf::JSONReader::FileReadInfo{ filename }));
+	});
+	const double referenceChecksum = Wolf::Benchmarks::computeSceneChecksum(jsonReader->getRoot());
+
+	measure("cold (parse and write)", repeatCount, megabyteCount, referenceMs, [&]()
+	{
+		jsonReader.reset();
+		std::filesystem::remove(cacheFilename);
+	}, [&]()
+	{
+		jsonReader.reset(new Wolf::JSONReader(Wolf::JSONReader::FileReadInfo{ filename, true }));
+	});
+	const double coldChecksum = Wolf::Benchmarks::computeSceneChecksum(jsonReader->getRoot());
+	if (!std::filesystem::exists(cacheFilename))
+		std::printf("Cache was not written\n");
+	else
+		std::printf("  cache file %.2f MB\n", static_cast<double>(std::filesystem::file_size(cacheFilename)) / (1024.0 * 1024.0));
+
+	measure("warm hit", repeatCount, megabyteCount, referenceMs, [&]() { jsonReader.reset(); }, [&]()
+	{
+		jsonReader.reset(new Wolf::JSONReader(Wolf::JSONReader::FileReadInfo{ filename, true }));
+	});
+	const double warmChecksum = Wolf::Benchmarks::computeSceneChecksum(jsonReader->getRoot());
+
+	if (coldChecksum != referenceChecksum || warmChecksum != referenceChecksum)
+		std::printf("Different trees: %f %f %f\n", referenceChecksum, coldChecksum, warmChecksum);
+
+	std::filesystem::remove(cacheFilename);
+
+	return 0;
+}
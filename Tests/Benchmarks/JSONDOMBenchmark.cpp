@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <Debug.h>
+
+#include "FirstJSONReader.h"
+#include "JSONBenchmarkHelpers.h"
+#include "JSONPullReader.h"
+#include "JSONReader.h"
+
+// Memory of the compact JSONReader DOM (property vectors, interned keys, values stored by the reader) against the first JSONReader
+// (std::unordered_map of allocated values per object), per document and per node. Heap bytes are counted by replacing the global operator new.
+// Then property lookups (getPropertyFloat, getPropertyObject) in objects below and above the 16 properties index threshold.
+// Usage: JSONDOMBenchmark [entityCount] [lookupCount]
+
+namespace
+{
+	// Size is stored before each allocation so frees can be counted
+	constexpr size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+	size_t g_heapByteCount = 0;
+	size_t g_peakHeapByteCount = 0;
+	uint64_t g_allocationCount = 0;
+}
+
+void* operator new(size_t size)
+{
+	char* pointer = static_cast<char*>(std::malloc(size + ALLOCATION_HEADER_SIZE));
+	if (!pointer)
+		throw std::bad_alloc();
+	*reinterpret_cast<size_t*>(pointer) = size;
+	g_heapByteCount += size;
+	g_peakHeapByteCount = std::max(g_peakHeapByteCount, g_heapByteCount);
+	g_allocationCount++;
+	return pointer + ALLOCATION_HEADER_SIZE;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	if (!pointer)
+		return;
+	char* allocation = static_cast<char*>(pointer) - ALLOCATION_HEADER_SIZE;
+	g_heapByteCount -= *reinterpret_cast<size_t*>(allocation);
+	std::free(allocation);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	operator delete(pointer);
+}
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Every value is a node: objects, arrays and their items
+	uint64_t countNodes(const std::string& filename)
+	{
+		Wolf::JSONPullReader pullReader(Wolf::JSONPullReader::FileReadInfo{ filename });
+		uint64_t nodeCount = 0;
+		for (;;)
+		{
+			switch (pullReader.next())
+			{
+				case Wolf::JSONPullReader::Event::BEGIN_OBJECT:
+				case Wolf::JSONPullReader::Event::BEGIN_ARRAY:
+				case Wolf::JSONPullReader::Event::STRING:
+				case Wolf::JSONPullReader::Event::NUMBER:
+				case Wolf::JSONPullReader::Event::BOOL:
+				case Wolf::JSONPullReader::Event::NULL_VALUE:
+					nodeCount++;
+					break;
+				case Wolf::JSONPullReader::Event::END_OF_DOCUMENT:
+				case Wolf::JSONPullReader::Event::ERROR:
+					return nodeCount;
+				default:
+					break;
+			}
+		}
+	}
+
+	// Heap kept by the tree once read, peak while reading and allocation count
+	template <typename Reader>
+	void measureMemory(const char* name, const std::string& filename, uint64_t nodeCount)
+	{
+		const size_t heapByteCountBefore = g_heapByteCount;
+		g_peakHeapByteCount = g_heapByteCount;
+		const uint64_t allocationCountBefore = g_allocationCount;
+
+		std::unique_ptr<Reader> reader(new Reader(typename Reader::FileReadInfo{ filename }));
+		const double retainedByteCount = static_cast<double>(g_heapByteCount - heapByteCountBefore);
+		const double peakByteCount = static_cast<double>(g_peakHeapByteCount - heapByteCountBefore);
+		const uint64_t allocationCount = g_allocationCount - allocationCountBefore;
+		if (Wolf::Benchmarks::computeSceneChecksum(reader->getRoot()) == 0.0)
+			std::printf("Unexpected checksum\n");
+
+		std::printf("  %-18s %9.2f MB per document %7.1f bytes per node  peak %9.2f MB  %9llu allocations\n", name, retainedByteCount / (1024.0 * 1024.0),
+			retainedByteCount / static_cast<double>(nodeCount), peakByteCount / (1024.0 * 1024.0), static_cast<unsigned long long>(allocationCount));
+	}
+
+	// Object with propertyCount properties: floats k0, k1... and an object as last property
+	std::string generateObjectJSON(uint32_t propertyCount)
+	{
+		std::string json = "{ \"object\": {";
+		for (uint32_t i = 0; i + 1 < propertyCount; ++i)
+			json += " \"k" + std::to_string(i) + "\": " + std::to_string(i) + ",";
+		json += " \"child\": { \"x\": 1 } } }";
+		return json;
+	}
+
+	// Nanoseconds per lookup, float properties are looked up in turn
+	template <typename JSONObjectInterface>
+	void measureLookups(const char* name, JSONObjectInterface* object, uint32_t propertyCount, uint32_t lookupCount)
+	{
+		std::vector<std::string> propertyNames;
+		for (uint32_t i = 0; i + 1 < propertyCount; ++i)
+			propertyNames.push_back("k" + std::to_string(i));
+
+		float sum = 0.0f;
+		Clock::time_point start = Clock::now();
+		for (uint32_t lookupIdx = 0; lookupIdx < lookupCount; ++lookupIdx)
+			sum += object->getPropertyFloat(propertyNames[lookupIdx % propertyNames.size()]);
+		const double floatNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / lookupCount;
+
+		const std::string childName = "child";
+		uint32_t foundCount = 0;
+		start = Clock::now();
+		for (uint32_t lookupIdx = 0; lookupIdx < lookupCount; ++lookupIdx)
+			foundCount += object->getPropertyObject(childName) != nullptr ? 1 : 0;
+		const double objectNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / lookupCount;
+
+		if (foundCount != lookupCount || sum < 0.0f)
+			std::printf("Unexpected lookup results\n");
+		std::printf("    %-18s getPropertyFloat %6.1f ns  getPropertyObject (last property) %6.1f ns\n", name, floatNs, objectNs);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t entityCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 10'000;
+	const uint32_t lookupCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 2'000'000;
+
+	const std::string filename = "JSONDOMBenchmark.json";
+	double megabyteCount;
+	{
+		const std::string json = Wolf::Benchmarks::generateSceneJSON(entityCount);
+		Wolf::Benchmarks::writeTextFile(filename, json);
+		megabyteCount = static_cast<double>(json.size()) / (1024.0 * 1024.0);
+	}
+	const uint64_t nodeCount = countNodes(filename);
+	std::printf("%u entities, %.2f MB, %llu nodes\n", entityCount, megabyteCount, static_cast<unsigned long long>(nodeCount));
+
+	measureMemory<Wolf::Benchmarks::FirstJSONReader>("first JSONReader", filename, nodeCount);
+	measureMemory<Wolf::JSONReader>("JSONReader", filename, nodeCount);
+
+	std::printf("Lookups, %u per measure\n", lookupCount);
+	for (const uint32_t propertyCount : { 4u, 8u, 15u, 16u, 32u, 64u })
+	{
+		std::printf("  %u properties\n", propertyCount);
+		const std::string json = generateObjectJSON(propertyCount);
+
+		Wolf::Benchmarks::FirstJSONReader firstReader(Wolf::Benchmarks::FirstJSONReader::StringReadInfo{ json });
+		measureLookups("first JSONReader", firstReader.getRoot()->getPropertyObject("object"), propertyCount, lookupCount);
+
+		Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ json });
+		measureLookups("JSONReader", reader.getRoot()->getPropertyObject("object"), propertyCount, lookupCount);
+	}
+
+	return 0;
+}
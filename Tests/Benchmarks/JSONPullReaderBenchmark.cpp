@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <Debug.h>
+
+#include "JSONBenchmarkHelpers.h"
+#include "JSONPullReader.h"
+#include "JSONReader.h"
+
+// Reading a generated multi-MB scene file with JSONPullReader against building the JSONReader DOM, full reads and a read of entity positions only.
+// Peak heap usage is measured by replacing the global operator new, the memory mapped file is not counted.
+// Usage: JSONPullReaderBenchmark [entityCount] [repeatCount]
+
+namespace
+{
+	// Size is stored before each allocation so frees can be counted
+	constexpr size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+	size_t g_heapByteCount = 0;
+	size_t g_peakHeapByteCount = 0;
+}
+
+void* operator new(size_t size)
+{
+	char* pointer = static_cast<char*>(std::malloc(size + ALLOCATION_HEADER_SIZE));
+	if (!pointer)
+		throw std::bad_alloc();
+	*reinterpret_cast<size_t*>(pointer) = size;
+	g_heapByteCount += size;
+	g_peakHeapByteCount = std::max(g_peakHeapByteCount, g_heapByteCount);
+	return pointer + ALLOCATION_HEADER_SIZE;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	if (!pointer)
+		return;
+	char* allocation = static_cast<char*>(pointer) - ALLOCATION_HEADER_SIZE;
+	g_heapByteCount -= *reinterpret_cast<size_t*>(allocation);
+	std::free(allocation);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	operator delete(pointer);
+}
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	template <typename RunFunction>
+	double measure(const char* name, uint32_t repeatCount, double megabyteCount, double referenceMs, RunFunction&& runFunction)
+	{
+		double bestMs = 1e30;
+		size_t peakHeapByteCount = 0;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const size_t heapByteCountBefore = g_heapByteCount;
+			g_peakHeapByteCount = g_heapByteCount;
+			const Clock::time_point start = Clock::now();
+			runFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+			peakHeapByteCount = std::max(peakHeapByteCount, g_peakHeapByteCount - heapByteCountBefore);
+		}
+		std::printf("  %-22s %8.2f ms %8.1f MB/s  peak heap %10.1f KB  x%.2f\n", name, bestMs, megabyteCount * 1000.0 / bestMs, static_cast<double>(peakHeapByteCount) / 1024.0,
+			referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+
+	// Same value as computeSceneChecksum, computed from the events: every number, string sizes except the scene name, true bools and one per tag
+	double computeSceneChecksum(Wolf::JSONPullReader& pullReader)
+	{
+		double checksum = 0.0;
+		bool isTagsProperty = false, isInTagsArray = false;
+		for (;;)
+		{
+			switch (pullReader.next())
+			{
+				case Wolf::JSONPullReader::Event::PROPERTY_NAME:
+					isTagsProperty = pullReader.getString() == "tags";
+					break;
+				case Wolf::JSONPullReader::Event::BEGIN_ARRAY:
+					isInTagsArray = isTagsProperty;
+					break;
+				case Wolf::JSONPullReader::Event::END_ARRAY:
+					isInTagsArray = false;
+					break;
+				case Wolf::JSONPullReader::Event::STRING:
+					if (isInTagsArray)
+						checksum += 1.0;
+					else if (pullReader.getDepth() > 1)
+						checksum += static_cast<double>(pullReader.getString().size());
+					break;
+				case Wolf::JSONPullReader::Event::NUMBER:
+					checksum += pullReader.getNumber();
+					break;
+				case Wolf::JSONPullReader::Event::BOOL:
+					checksum += pullReader.getBool() ? 1.0 : 0.0;
+					break;
+				case Wolf::JSONPullReader::Event::END_OF_DOCUMENT:
+				case Wolf::JSONPullReader::Event::ERROR:
+					return checksum;
+				default:
+					break;
+			}
+		}
+	}
+
+	// Only the entity positions are decoded, every other value is skipped
+	double sumPositions(Wolf::JSONPullReader& pullReader)
+	{
+		double sum = 0.0;
+		for (;;)
+		{
+			const Wolf::JSONPullReader::Event event = pullReader.next();
+			if (event == Wolf::JSONPullReader::Event::END_OF_DOCUMENT || event == Wolf::JSONPullReader::Event::ERROR)
+				return sum;
+			if (event != Wolf::JSONPullReader::Event::PROPERTY_NAME)
+				continue;
+
+			const uint32_t depth = pullReader.getDepth();
+			const std::string_view propertyName = pullReader.getString();
+			if (depth == 3 && propertyName == "position")
+			{
+				pullReader.next();
+				while (pullReader.next() == Wolf::JSONPullReader::Event::NUMBER)
+					sum += pullReader.getNumber();
+			}
+			else if (depth > 1)
+			{
+				pullReader.skipValue();
+			}
+		}
+	}
+
+	double sumPositions(Wolf::JSONReader::JSONObjectInterface* root)
+	{
+		double sum = 0.0;
+		const uint32_t entityCount = root->getArraySize("entities");
+		for (uint32_t entityIdx = 0; entityIdx < entityCount; ++entityIdx)
+		{
+			for (const float value : root->getArrayObjectItem("entities", entityIdx)->getPropertyFloatArray("position"))
+				sum += value;
+		}
+		return sum;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t entityCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 20'000;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 5;
+
+	// Generated content is freed before measuring heap usage
+	const std::string filename = "JSONPullReaderBenchmark.json";
+	double megabyteCount;
+	{
+		const std::string json = Wolf::Benchmarks::generateSceneJSON(entityCount);
+		Wolf::Benchmarks::writeTextFile(filename, json);
+		megabyteCount = static_cast<double>(json.size()) / (1024.0 * 1024.0);
+	}
+	std::printf("%u entities, %.2f MB, best of %u\n", entityCount, megabyteCount, repeatCount);
+
+	std::printf("Whole scene\n");
+	double domChecksum = 0.0, pullChecksum = 0.0;
+	const double domMs = measure("JSONReader DOM", repeatCount, megabyteCount, 0.0, [&]()
+	{
+		Wolf::JSONReader jsonReader(Wolf::JSONReader::FileReadInfo{ filename });
+		domChecksum = Wolf::Benchmarks::computeSceneChecksum(jsonReader.getRoot());
+	});
+	measure("JSONPullReader", repeatCount, megabyteCount, domMs, [&]()
+	{
+		Wolf::JSONPullReader pullReader(Wolf::JSONPullReader::FileReadInfo{ filename });
+		pullChecksum = computeSceneChecksum(pullReader);
+	});
+	// Values are summed in another order
+	if (std::abs(domChecksum - pullChecksum) > 1e-9 * std::abs(domChecksum))
+		std::printf("Different checksums: %f %f\n", domChecksum, pullChecksum);
+
+	std::printf("Entity positions only\n");
+	double domSum = 0.0, pullSum = 0.0;
+	const double domPositionsMs = measure("JSONReader DOM", repeatCount, megabyteCount, 0.0, [&]()
+	{
+		Wolf::JSONReader jsonReader(Wolf::JSONReader::FileReadInfo{ filename });
+		domSum = sumPositions(jsonReader.getRoot());
+	});
+	measure("JSONPullReader skipping", repeatCount, megabyteCount, domPositionsMs, [&]()
+	{
+		Wolf::JSONPullReader pullReader(Wolf::JSONPullReader::FileReadInfo{ filename });
+		pullSum = sumPositions(pullReader);
+	});
+	if (domSum != pullSum)
+		std::printf("Different position sums: %f %f\n", domSum, pullSum);
+
+	return 0;
+}
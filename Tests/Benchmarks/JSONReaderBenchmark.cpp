@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <Debug.h>
+
+#include "FirstJSONReader.h"
+#include "JSONBenchmarkHelpers.h"
+#include "JSONReader.h"
+
+// Parsing of a generated multi-MB scene file by the first line-based JSONReader and by the current one (single pass over JSONPullReader events).
+// Both trees are checked to hold the same values. The binary cache is not used.
+// Usage: JSONReaderBenchmark [entityCount] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	template <typename RunFunction>
+	double measure(const char* name, uint32_t repeatCount, double megabyteCount, double referenceMs, RunFunction&& runFunction)
+	{
+		double bestMs = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			runFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		std::printf("  %-20s %9.2f ms %8.1f MB/s  x%.2f\n", name, bestMs, megabyteCount * 1000.0 / bestMs, referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t entityCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 10'000;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 3;
+
+	const std::string filename = "JSONReaderBenchmark.json";
+	const std::string json = Wolf::Benchmarks::generateSceneJSON(entityCount);
+	Wolf::Benchmarks::writeTextFile(filename, json);
+	const double megabyteCount = static_cast<double>(json.size()) / (1024.0 * 1024.0);
+	std::printf("%u entities, %.2f MB, best of %u\n", entityCount, megabyteCount, repeatCount);
+
+	double firstChecksum = 0.0;
+	const double referenceMs = measure("first JSONReader", repeatCount, megabyteCount, 0.0, [&]()
+	{
+		Wolf::Benchmarks::FirstJSONReader jsonReader(Wolf::Benchmarks::FirstJSONReader::FileReadInfo{ filename });
+		firstChecksum = Wolf::Benchmarks::computeSceneChecksum(jsonReader.getRoot());
+	});
+
+	double checksum = 0.0;
+	measure("JSONReader", repeatCount, megabyteCount, referenceMs, [&]()
+	{
+		Wolf::JSONReader jsonReader(Wolf::JSONReader::FileReadInfo{ filename });
+		checksum = Wolf::Benchmarks::computeSceneChecksum(jsonReader.getRoot());
+	});
+
+	if (checksum != firstChecksum)
+		std::printf("Trees are different: %f %f\n", checksum, firstChecksum);
+
+	return 0;
+}
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Debug.h>
+
+#include "JSONReader.h"
+#include "JSONWriter.h"
+
+// Memory dump of many resources (name, type, sizes, flag and usage percentage per object) written with JSONWriter and with the first
+// GPUMemoryDebug dump code (std::ofstream operator<< with only backslashes escaped). Both files are read back to check the resource count.
+// Usage: JSONWriterBenchmark [resourceCount] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Resource
+	{
+		std::string m_name;
+		bool m_isBuffer;
+		uint64_t m_allocatedBytes;
+		uint64_t m_requestedBytes;
+		bool m_isPoolOrAtlas;
+		float m_usagePercent;
+	};
+
+	// First GPUMemoryDebug::exportJSON
+	std::string escapeBackslashes(const std::string& input)
+	{
+		std::string result;
+		result.reserve(input.size());
+
+		for (const char c : input)
+		{
+			if (c == '\\')
+			{
+				result += "\\\\";
+			}
+			else
+			{
+				result += c;
+			}
+		}
+
+		return result;
+	}
+
+	void writeFirstMemoryDump(const std::string& filename, const std::vector<Resource>& resources, uint64_t totalAllocated, uint64_t totalRequested)
+	{
+		std::ofstream file(filename);
+		if (!file.is_open())
+		{
+			Wolf::Debug::sendError("Cannot open file for writing: " + filename);
+			return;
+		}
+
+		file << "{\n";
+		file << "  \"type\":\"GPU\",\n";
+		file << "  \"totalAllocated\": " << totalAllocated << ",\n";
+		file << "  \"totalRequested\": " << totalRequested << ",\n";
+		file << "  \"resources\": [\n";
+
+		for (size_t i = 0; i < resources.size(); ++i)
+		{
+			const Resource& res = resources[i];
+			bool isLast = (i == resources.size() - 1);
+
+			file << "    {\n";
+			file << "      \"name\": \"" << escapeBackslashes(res.m_name) << "\",\n";
+			file << "      \"type\": \"" << (res.m_isBuffer ? "Buffer" : "Image") << "\",\n";
+			file << "      \"allocatedBytes\": " << res.m_allocatedBytes << ",\n";
+			file << "      \"requestedBytes\": " << res.m_requestedBytes << ",\n";
+			file << "      \"isPoolOrAtlas\": " << (res.m_isPoolOrAtlas ? "true" : "false") << ",\n";
+			file << "      \"usagePercent\": " << res.m_usagePercent << "\n";
+			file << "    }" << (isLast ? "" : ",") << "\n";
+		}
+
+		file << "  ]\n";
+		file << "}";
+
+		file.close();
+	}
+
+	// Same as the current GPUMemoryDebug::exportJSON
+	void writeMemoryDump(const std::string& filename, const std::vector<Resource>& resources, uint64_t totalAllocated, uint64_t totalRequested)
+	{
+		Wolf::JSONWriter writer(Wolf::JSONWriter::FileWriteInfo{ filename });
+		if (!writer.isValid())
+			return;
+
+		writer.beginObject();
+		writer.writeProperty("type", "GPU");
+		writer.writeProperty("totalAllocated", totalAllocated);
+		writer.writeProperty("totalRequested", totalRequested);
+		writer.writePropertyName("resources");
+		writer.beginArray();
+
+		for (const Resource& res : resources)
+		{
+			writer.beginObject();
+			writer.writeProperty("name", res.m_name);
+			writer.writeProperty("type", res.m_isBuffer ? "Buffer" : "Image");
+			writer.writeProperty("allocatedBytes", res.m_allocatedBytes);
+			writer.writeProperty("requestedBytes", res.m_requestedBytes);
+			writer.writeProperty("isPoolOrAtlas", res.m_isPoolOrAtlas);
+			writer.writeProperty("usagePercent", res.m_usagePercent);
+			writer.endObject();
+		}
+
+		writer.endArray();
+		writer.endObject();
+		writer.flush();
+	}
+
+	template <typename RunFunction>
+	double measure(const char* name, uint32_t repeatCount, const std::string& filename, double referenceMs, RunFunction&& runFunction)
+	{
+		double bestMs = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			runFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+
+		const double megabyteCount = static_cast<double>(std::filesystem::file_size(filename)) / (1024.0 * 1024.0);
+		std::printf("  %-18s %8.2f ms %7.2f MB %8.1f MB/s  x%.2f\n", name, bestMs, megabyteCount, megabyteCount * 1000.0 / bestMs, referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+
+	uint32_t readResourceCount(const std::string& filename)
+	{
+		Wolf::JSONReader jsonReader(Wolf::JSONReader::FileReadInfo{ filename });
+		return jsonReader.getRoot()->getArraySize("resources");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t resourceCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100'000;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 5;
+	std::printf("%u resources, best of %u\n", resourceCount, repeatCount);
+
+	std::vector<Resource> resources(resourceCount);
+	uint64_t totalAllocated = 0, totalRequested = 0;
+	for (uint32_t resourceIdx = 0; resourceIdx < resourceCount; ++resourceIdx)
+	{
+		Resource& resource = resources[resourceIdx];
+		resource.m_name = "Textures\\Materials\\material_" + std::to_string(resourceIdx) + "_albedo.dds";
+		resource.m_isBuffer = resourceIdx % 4 == 0;
+		resource.m_requestedBytes = 4096ull * (1 + resourceIdx % 1000);
+		resource.m_allocatedBytes = resource.m_requestedBytes + 256 * (resourceIdx % 7);
+		resource.m_isPoolOrAtlas = resourceIdx % 50 == 0;
+		resource.m_usagePercent = 100.0f * static_cast<float>(resource.m_requestedBytes) / static_cast<float>(resource.m_allocatedBytes);
+		totalAllocated += resource.m_allocatedBytes;
+		totalRequested += resource.m_requestedBytes;
+	}
+
+	const std::string firstFilename = "JSONWriterBenchmark_first.json";
+	const std::string filename = "JSONWriterBenchmark.json";
+	const double referenceMs = measure("ofstream dump", repeatCount, firstFilename, 0.0, [&]() { writeFirstMemoryDump(firstFilename, resources, totalAllocated, totalRequested); });
+	measure("JSONWriter", repeatCount, filename, referenceMs, [&]() { writeMemoryDump(filename, resources, totalAllocated, totalRequested); });
+
+	if (readResourceCount(firstFilename) != resourceCount || readResourceCount(filename) != resourceCount)
+		std::printf("Unexpected resource count read back\n");
+
+	return 0;
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <queue>
+#include <vector>
+
+#include <Debug.h>
+
+#include "Job.h"
+
+// Jobs pushed to a queue then popped and executed, with captures of increasing size.
+// The first jobs path (std::queue of std::function) is compared to Wolf::Job in a vector (added jobs) and in a JobArena (spawned jobs).
+// Allocations are counted by replacing the global operator new.
+// Usage: JobBenchmark [jobCount] [repeatCount]
+
+namespace
+{
+	uint64_t g_allocationCount = 0;
+}
+
+void* operator new(size_t size)
+{
+	g_allocationCount++;
+	if (void* pointer = std::malloc(size ? size : 1))
+		return pointer;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	template <typename RunFunction>
+	double measure(const char* name, uint32_t repeatCount, uint32_t jobCount, double referenceMs, RunFunction&& runFunction)
+	{
+		// Warm-up, containers and arenas keep their memory between repeats
+		runFunction();
+
+		double bestMs = 1e30;
+		const uint64_t allocationCountBefore = g_allocationCount;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			runFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		const double allocationsPerJob = static_cast<double>(g_allocationCount - allocationCountBefore) / (static_cast<double>(repeatCount) * jobCount);
+
+		std::printf("  %-20s %7.1f ns per job %6.2f allocations per job  x%.2f\n", name, bestMs * 1e6 / jobCount, allocationsPerJob, referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+
+	template <size_t CAPTURE_SIZE>
+	void runWithCaptureSize(uint32_t jobCount, uint32_t repeatCount)
+	{
+		std::array<uint8_t, CAPTURE_SIZE> capture{};
+		capture[0] = 1;
+		uint64_t sum = 0;
+		auto createJobFunction = [&sum, capture](uint32_t jobIdx) { return [&sum, capture, jobIdx]() { sum += capture[0] + jobIdx; }; };
+
+		using JobFunction = decltype(createJobFunction(0));
+		std::printf("%zu bytes captured (%s)\n", sizeof(JobFunction), Wolf::Job::IS_STORED_INLINE<JobFunction> ? "inline" : "heap");
+
+		std::queue<std::function<void()>> firstJobs;
+		const double referenceMs = measure("std::function queue", repeatCount, jobCount, 0.0, [&]()
+		{
+			for (uint32_t jobIdx = 0; jobIdx < jobCount; ++jobIdx)
+				firstJobs.emplace(createJobFunction(jobIdx));
+			while (!firstJobs.empty())
+			{
+				std::function<void()> job = std::move(firstJobs.front());
+				firstJobs.pop();
+				job();
+			}
+		});
+
+		std::vector<Wolf::Job> jobs;
+		measure("Job vector", repeatCount, jobCount, referenceMs, [&]()
+		{
+			for (uint32_t jobIdx = 0; jobIdx < jobCount; ++jobIdx)
+				jobs.emplace_back(createJobFunction(jobIdx));
+			for (Wolf::Job& job : jobs)
+				job();
+			jobs.clear();
+		});
+
+		Wolf::JobArena jobArena;
+		std::vector<Wolf::Job*> arenaJobs;
+		measure("JobArena", repeatCount, jobCount, referenceMs, [&]()
+		{
+			for (uint32_t jobIdx = 0; jobIdx < jobCount; ++jobIdx)
+				arenaJobs.push_back(jobArena.allocate(createJobFunction(jobIdx)));
+			for (Wolf::Job* job : arenaJobs)
+				(*job)();
+			arenaJobs.clear();
+			jobArena.reset();
+		});
+
+		if (sum == 0)
+			std::printf("Unexpected sum\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t jobCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100'000;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 10;
+	std::printf("%u jobs, best of %u\n", jobCount, repeatCount);
+
+	// From the usual pointer and index captures to more than the inline storage
+	runWithCaptureSize<4>(jobCount, repeatCount);
+	runWithCaptureSize<24>(jobCount, repeatCount);
+	runWithCaptureSize<64>(jobCount, repeatCount);
+	runWithCaptureSize<96>(jobCount, repeatCount);
+	runWithCaptureSize<160>(jobCount, repeatCount);
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <Debug.h>
+
+#include "JobsManager.h"
+
+// Before frame work made of chains of dependent jobs with uneven durations, like the virtual texture update followed by the slices request.
+// With the flat job list every stage was a wave of its own (the next one ran in the next execution or after all MT jobs), the graph
+// starts each job as soon as the previous one of its chain is done.
+// Usage: JobGraphBenchmark [frameCount] [chainCount] [stageCount] [jobUs] [workerCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Work is a fixed amount of computation, a thread waiting for a CPU doesn't progress
+	volatile uint64_t g_workResult = 0;
+	void computeWork(uint64_t iterationCount)
+	{
+		uint64_t value = g_workResult;
+		for (uint64_t i = 0; i < iterationCount; ++i)
+			value = value * 6364136223846793005ull + 1442695040888963407ull;
+		g_workResult = value;
+	}
+
+	uint64_t computeIterationCount(float durationUs)
+	{
+		static const double iterationsPerUs = []()
+		{
+			constexpr uint64_t CALIBRATION_ITERATION_COUNT = 50'000'000;
+			const Clock::time_point start = Clock::now();
+			computeWork(CALIBRATION_ITERATION_COUNT);
+			return CALIBRATION_ITERATION_COUNT / std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+		}();
+		return static_cast<uint64_t>(iterationsPerUs * durationUs);
+	}
+
+	struct Settings
+	{
+		uint32_t m_frameCount = 200;
+		uint32_t m_chainCount = 8;
+		uint32_t m_stageCount = 4;
+		float m_jobUs = 100.0f;
+		uint32_t m_workerCount = 3;
+	};
+
+	// Between 1 and 5 times the job duration, the longest job of a stage isn't always in the same chain
+	uint64_t getJobIterationCount(const Settings& settings, uint32_t chainIdx, uint32_t stageIdx)
+	{
+		return computeIterationCount(settings.m_jobUs * static_cast<float>(1 + (chainIdx * 7 + stageIdx * 3) % 5));
+	}
+
+	template <typename FrameFunction>
+	double measureFrames(const char* name, const Settings& settings, double referenceMs, FrameFunction&& frameFunction)
+	{
+		const Clock::time_point start = Clock::now();
+		for (uint32_t frameIdx = 0; frameIdx < settings.m_frameCount; ++frameIdx)
+			frameFunction();
+		const double frameMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / settings.m_frameCount;
+
+		std::printf("%-12s %8.3f ms per frame  x%.2f\n", name, frameMs, referenceMs > 0.0 ? referenceMs / frameMs : 1.0);
+		return frameMs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	Settings settings;
+	if (argc > 1) settings.m_frameCount = static_cast<uint32_t>(std::atoi(argv[1]));
+	if (argc > 2) settings.m_chainCount = static_cast<uint32_t>(std::atoi(argv[2]));
+	if (argc > 3) settings.m_stageCount = static_cast<uint32_t>(std::atoi(argv[3]));
+	if (argc > 4) settings.m_jobUs = static_cast<float>(std::atof(argv[4]));
+	if (argc > 5) settings.m_workerCount = static_cast<uint32_t>(std::atoi(argv[5]));
+
+	std::printf("%u frames, %u chains of %u jobs of %.0f to %.0f us, %u workers, %u CPUs\n", settings.m_frameCount, settings.m_chainCount, settings.m_stageCount, settings.m_jobUs,
+		settings.m_jobUs * 5.0f, settings.m_workerCount, std::thread::hardware_concurrency());
+
+	std::vector<uint64_t> iterationCounts(static_cast<size_t>(settings.m_chainCount) * settings.m_stageCount);
+	for (uint32_t stageIdx = 0; stageIdx < settings.m_stageCount; ++stageIdx)
+	{
+		for (uint32_t chainIdx = 0; chainIdx < settings.m_chainCount; ++chainIdx)
+			iterationCounts[stageIdx * settings.m_chainCount + chainIdx] = getJobIterationCount(settings, chainIdx, stageIdx);
+	}
+
+	Wolf::JobsManager jobsManager(settings.m_workerCount);
+
+	const double flatFrameMs = measureFrames("flat list", settings, 0.0, [&]()
+	{
+		for (uint32_t stageIdx = 0; stageIdx < settings.m_stageCount; ++stageIdx)
+		{
+			for (uint32_t chainIdx = 0; chainIdx < settings.m_chainCount; ++chainIdx)
+			{
+				const uint64_t iterationCount = iterationCounts[stageIdx * settings.m_chainCount + chainIdx];
+				jobsManager.addJobBeforeFrame([iterationCount]() { computeWork(iterationCount); });
+			}
+			jobsManager.executeJobsBeforeFrame();
+		}
+	});
+
+	measureFrames("graph", settings, flatFrameMs, [&]()
+	{
+		std::vector<Wolf::JobsManager::JobHandle> previousJobs(settings.m_chainCount);
+		for (uint32_t stageIdx = 0; stageIdx < settings.m_stageCount; ++stageIdx)
+		{
+			for (uint32_t chainIdx = 0; chainIdx < settings.m_chainCount; ++chainIdx)
+			{
+				const uint64_t iterationCount = iterationCounts[stageIdx * settings.m_chainCount + chainIdx];
+				previousJobs[chainIdx] = jobsManager.addContinuationBeforeFrame(previousJobs[chainIdx], [iterationCount]() { computeWork(iterationCount); });
+			}
+		}
+		jobsManager.executeJobsBeforeFrame();
+	});
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <Debug.h>
+
+#include "MultiThreadTaskManager.h"
+
+// Thousands of tiny jobs per frame pushed to a thread group, executed and waited for.
+// The first jobs pool (one locked queue of std::function shared by every thread) is compared to the work-stealing MultiThreadTaskManager.
+// Usage: JobsPoolContentionBenchmark [jobCountPerFrame] [frameCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Thread group of the first MultiThreadTaskManager
+	class FirstThreadGroup
+	{
+	public:
+		using Job = std::function<void()>;
+
+		explicit FirstThreadGroup(uint32_t threadCount)
+		{
+			for (uint32_t threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+			{
+				PerThread& perThread = *m_threads.emplace_back(new PerThread);
+				perThread.m_thread = std::thread(&FirstThreadGroup::execution, this, std::ref(perThread));
+			}
+		}
+
+		~FirstThreadGroup()
+		{
+			for (std::unique_ptr<PerThread>& perThread : m_threads)
+			{
+				{
+					std::lock_guard<std::mutex> lock(perThread->m_mutex);
+					perThread->m_stopThreadRequested = true;
+				}
+				perThread->m_runCondition.notify_all();
+				perThread->m_thread.join();
+			}
+		}
+
+		void addJob(const Job& job) { m_nextJobs.emplace(job); }
+
+		void executeJobs()
+		{
+			m_currentJobs.swap(m_nextJobs);
+
+			Job jobToExecute;
+			if (!getNextJob(jobToExecute))
+				return;
+
+			for (std::unique_ptr<PerThread>& perThread : m_threads)
+				perThread->m_runCondition.notify_all();
+
+			do
+			{
+				jobToExecute();
+			} while (getNextJob(jobToExecute));
+		}
+
+		void waitJobsCompleted()
+		{
+			for (std::unique_ptr<PerThread>& perThread : m_threads)
+			{
+				perThread->m_mutex.lock();
+				perThread->m_mutex.unlock();
+			}
+		}
+
+	private:
+		struct PerThread
+		{
+			std::thread m_thread;
+			std::mutex m_mutex;
+			std::condition_variable m_runCondition;
+			bool m_stopThreadRequested = false;
+		};
+
+		void execution(PerThread& perThread)
+		{
+			for (;;)
+			{
+				std::unique_lock<std::mutex> lock(perThread.m_mutex);
+				Job jobToExecute;
+				perThread.m_runCondition.wait(lock, [&] { return getNextJob(jobToExecute) || perThread.m_stopThreadRequested; });
+
+				if (perThread.m_stopThreadRequested)
+					break;
+
+				do
+				{
+					jobToExecute();
+				} while (getNextJob(jobToExecute));
+			}
+		}
+
+		bool getNextJob(Job& outJob)
+		{
+			std::lock_guard<std::mutex> lock(m_currentJobsMutex);
+			if (m_currentJobs.empty())
+				return false;
+
+			outJob = std::move(m_currentJobs.front());
+			m_currentJobs.pop();
+			return true;
+		}
+
+		std::queue<Job> m_nextJobs;
+		std::mutex m_currentJobsMutex;
+		std::queue<Job> m_currentJobs;
+		std::vector<std::unique_ptr<PerThread>> m_threads;
+	};
+
+	template <typename FrameFunction>
+	double measureFrames(const char* name, uint32_t frameCount, uint32_t jobCountPerFrame, double referenceMs, FrameFunction&& frameFunction)
+	{
+		const Clock::time_point start = Clock::now();
+		for (uint32_t frameIdx = 0; frameIdx < frameCount; ++frameIdx)
+			frameFunction();
+		const double frameMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frameCount;
+
+		std::printf("  %-20s %8.3f ms per frame %7.1f ns per job  x%.2f\n", name, frameMs, frameMs * 1e6 / jobCountPerFrame, referenceMs > 0.0 ? referenceMs / frameMs : 1.0);
+		return frameMs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t jobCountPerFrame = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 4096;
+	const uint32_t frameCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 200;
+	std::printf("%u jobs per frame, %u frames, %u CPUs\n", jobCountPerFrame, frameCount, std::thread::hardware_concurrency());
+
+	// Each job only updates its own value
+	std::vector<uint64_t> values(jobCountPerFrame);
+	uint64_t* valuesData = values.data();
+
+	for (const uint32_t workerCount : { 1u, 3u, 7u })
+	{
+		std::printf("%u workers\n", workerCount);
+
+		double referenceMs;
+		{
+			FirstThreadGroup firstThreadGroup(workerCount);
+			referenceMs = measureFrames("first jobs pool", frameCount, jobCountPerFrame, 0.0, [&]()
+			{
+				for (uint32_t jobIdx = 0; jobIdx < jobCountPerFrame; ++jobIdx)
+					firstThreadGroup.addJob([valuesData, jobIdx]() { valuesData[jobIdx] = valuesData[jobIdx] * 3 + 1; });
+				firstThreadGroup.executeJobs();
+				firstThreadGroup.waitJobsCompleted();
+			});
+		}
+
+		Wolf::MultiThreadTaskManager multiThreadTaskManager;
+		const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(workerCount, "Benchmark");
+		measureFrames("work stealing", frameCount, jobCountPerFrame, referenceMs, [&]()
+		{
+			for (uint32_t jobIdx = 0; jobIdx < jobCountPerFrame; ++jobIdx)
+				multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [valuesData, jobIdx]() { valuesData[jobIdx] = valuesData[jobIdx] * 3 + 1; });
+			multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+			multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+		});
+	}
+
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <Debug.h>
+
+#include "JobsManager.h"
+#include "MipMapGenerator.h"
+
+// Time to build the mip chain of a noisy RGBA8 image.
+// The first generator, which walked the rows column by column, is compared to the legacy box filter giving the same output,
+// then to the sRGB correct box and Kaiser filters, on the calling thread and with engine workers.
+// Usage: MipMapGeneratorBenchmark [size] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Loop of the first generator
+	void createFirstGeneratorMipChain(const Wolf::ImageCompression::RGBA8* firstMip, uint32_t size, uint32_t mipCount, std::vector<std::vector<Wolf::ImageCompression::RGBA8>>& outMips)
+	{
+		outMips.resize(mipCount - 1);
+		const Wolf::ImageCompression::RGBA8* previousMip = firstMip;
+		for (uint32_t mipLevel = 1; mipLevel < mipCount; ++mipLevel)
+		{
+			const uint32_t width = size >> (mipLevel - 1), height = size >> (mipLevel - 1);
+			std::vector<Wolf::ImageCompression::RGBA8>& currentMip = outMips[mipLevel - 1];
+			currentMip.resize(static_cast<size_t>(width / 2) * (height / 2));
+			for (uint32_t x = 0; x < width; x += 2)
+			{
+				for (uint32_t y = 0; y < height; y += 2)
+				{
+					currentMip[x / 2 + (y / 2) * (width / 2)] = Wolf::ImageCompression::RGBA8::mergeBlock(previousMip[x + y * width], previousMip[x + (y + 1) * width],
+						previousMip[(x + 1) + y * width], previousMip[(x + 1) + (y + 1) * width]);
+				}
+			}
+			previousMip = currentMip.data();
+		}
+	}
+
+	template <typename GenerateFunction>
+	double measure(const char* name, uint32_t repeatCount, double referenceMs, GenerateFunction&& generateFunction)
+	{
+		double bestMs = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			generateFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		std::printf("%-28s %8.2f ms  x%.2f\n", name, bestMs, referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 4096;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 3;
+
+	std::mt19937 randomEngine(1);
+	std::vector<Wolf::ImageCompression::RGBA8> pixels(static_cast<size_t>(size) * size);
+	for (Wolf::ImageCompression::RGBA8& pixel : pixels)
+		pixel = Wolf::ImageCompression::RGBA8(static_cast<uint8_t>(randomEngine()), static_cast<uint8_t>(randomEngine()), static_cast<uint8_t>(randomEngine()), static_cast<uint8_t>(randomEngine()));
+	const unsigned char* firstMipPixels = reinterpret_cast<const unsigned char*>(pixels.data());
+	const uint32_t mipCount = Wolf::MipMapGenerator::computeMipCount({ size, size });
+	std::printf("%ux%u RGBA8 with %u mips, best of %u\n", size, size, mipCount, repeatCount);
+
+	std::vector<std::vector<Wolf::ImageCompression::RGBA8>> firstGeneratorMips;
+	const double referenceMs = measure("first generator", repeatCount, 0.0, [&]() { createFirstGeneratorMipChain(pixels.data(), size, mipCount, firstGeneratorMips); });
+
+	for (const uint32_t workerCount : { 0u, 3u })
+	{
+		// Without a JobsManager every row is filtered by the calling thread
+		std::unique_ptr<Wolf::JobsManager> jobsManager(workerCount > 0 ? new Wolf::JobsManager(workerCount) : nullptr);
+		std::printf("%u workers\n", workerCount);
+
+		Wolf::MipMapGenerator::GenerationInfo generationInfo;
+		generationInfo.filter = Wolf::MipMapGenerator::Filter::BOX_LEGACY;
+		measure("  legacy box", repeatCount, referenceMs, [&]() { Wolf::MipMapGenerator mipMapGenerator(firstMipPixels, { size, size }, Wolf::Format::R8G8B8A8_SRGB, -1, generationInfo); });
+
+		generationInfo.filter = Wolf::MipMapGenerator::Filter::BOX;
+		measure("  box UNORM", repeatCount, referenceMs, [&]() { Wolf::MipMapGenerator mipMapGenerator(firstMipPixels, { size, size }, Wolf::Format::R8G8B8A8_UNORM, -1, generationInfo); });
+		measure("  box sRGB", repeatCount, referenceMs, [&]() { Wolf::MipMapGenerator mipMapGenerator(firstMipPixels, { size, size }, Wolf::Format::R8G8B8A8_SRGB, -1, generationInfo); });
+
+		generationInfo.filter = Wolf::MipMapGenerator::Filter::KAISER;
+		measure("  Kaiser sRGB", repeatCount, referenceMs, [&]() { Wolf::MipMapGenerator mipMapGenerator(firstMipPixels, { size, size }, Wolf::Format::R8G8B8A8_SRGB, -1, generationInfo); });
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <Debug.h>
+
+#include "JobsManager.h"
+#include "ParallelFor.h"
+
+// Scaling of parallelFor and parallelReduce with the number of threads, from the calling thread alone to one thread per CPU
+// (the calling thread and the before frame workers).
+// Usage: ParallelForBenchmark [count] [repeatCount] [maxThreadCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	template <typename RunFunction>
+	double measure(const char* name, uint32_t repeatCount, double referenceMs, RunFunction&& runFunction)
+	{
+		double bestMs = 1e30;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			runFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		std::printf("  %-16s %8.2f ms  x%.2f\n", name, bestMs, referenceMs > 0.0 ? referenceMs / bestMs : 1.0);
+		return bestMs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t count = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1 << 22;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 5;
+	const uint32_t maxThreadCount = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : std::max(std::thread::hardware_concurrency(), 1u);
+	std::printf("%u elements, best of %u, %u CPUs\n", count, repeatCount, std::thread::hardware_concurrency());
+
+	std::vector<float> inputs(count), outputs(count);
+	for (uint32_t i = 0; i < count; ++i)
+		inputs[i] = static_cast<float>(i % 1000) * 0.01f;
+
+	double parallelForReferenceMs = 0.0, parallelReduceReferenceMs = 0.0;
+	for (uint32_t threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+	{
+		// The calling thread takes part, a single thread has no JobsManager and runs the serial fallback
+		std::unique_ptr<Wolf::JobsManager> jobsManager(threadCount > 1 ? new Wolf::JobsManager(threadCount - 1) : nullptr);
+		std::printf("%u threads\n", threadCount);
+
+		const double parallelForMs = measure("parallelFor", repeatCount, parallelForReferenceMs, [&]()
+		{
+			Wolf::parallelFor(count, 1024, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; ++i)
+					outputs[i] = std::sin(inputs[i]) * std::sqrt(inputs[i] + 1.0f);
+			});
+		});
+
+		const double parallelReduceMs = measure("parallelReduce", repeatCount, parallelReduceReferenceMs, [&]()
+		{
+			const double sum = Wolf::parallelReduce(count, 1024, 0.0, [&](uint32_t begin, uint32_t end, double rangeSum)
+			{
+				for (uint32_t i = begin; i < end; ++i)
+					rangeSum += std::cos(inputs[i]);
+				return rangeSum;
+			}, [](double left, double right) { return left + right; });
+			outputs[0] = static_cast<float>(sum);
+		});
+
+		if (threadCount == 1)
+		{
+			parallelForReferenceMs = parallelForMs;
+			parallelReduceReferenceMs = parallelReduceMs;
+		}
+	}
+
+	return 0;
+}
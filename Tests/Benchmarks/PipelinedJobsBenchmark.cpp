@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include <Debug.h>
+#include <RuntimeContext.h>
+
+#include "JobsManager.h"
+
+// Headless frame loop following WolfEngine::updateBeforeFrame() and WolfEngine::frame(): before frame jobs, recording by the main thread,
+// a simulated GPU frame and the CPU/GPU synchronisation. Measures the frame time with the before frame jobs executed before the recording
+// and pipelined with it.
+// Usage: PipelinedJobsBenchmark [frameCount] [jobsMs] [recordMs] [gpuMs] [workerCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Work is a fixed amount of computation, a thread waiting for a CPU doesn't progress
+	volatile uint64_t g_workResult = 0;
+	void computeWork(uint64_t iterationCount)
+	{
+		uint64_t value = g_workResult;
+		for (uint64_t i = 0; i < iterationCount; ++i)
+			value = value * 6364136223846793005ull + 1442695040888963407ull;
+		g_workResult = value;
+	}
+
+	uint64_t computeIterationCount(float durationMs)
+	{
+		static const double iterationsPerMs = []()
+		{
+			constexpr uint64_t CALIBRATION_ITERATION_COUNT = 50'000'000;
+			const Clock::time_point start = Clock::now();
+			computeWork(CALIBRATION_ITERATION_COUNT);
+			return CALIBRATION_ITERATION_COUNT / std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		}();
+		return static_cast<uint64_t>(iterationsPerMs * durationMs);
+	}
+
+	struct Settings
+	{
+		uint32_t m_frameCount = 300;
+		float m_jobsMs = 4.0f;
+		float m_recordMs = 4.0f;
+		float m_gpuMs = 6.0f;
+		uint32_t m_workerCount = 3;
+
+		static constexpr uint32_t JOB_COUNT = 16;
+		static constexpr uint32_t MAX_CACHED_FRAMES = 2;
+	};
+
+	// Frames end in submission order, each one after the GPU time
+	class SimulatedGPU
+	{
+	public:
+		explicit SimulatedGPU(std::chrono::microseconds frameDuration) : m_frameDuration(frameDuration) {}
+
+		void submit(uint32_t frameIdx)
+		{
+			const Clock::time_point start = std::max(Clock::now(), m_lastFrameEnd);
+			m_lastFrameEnd = start + m_frameDuration;
+			m_frameEnds[frameIdx % Settings::MAX_CACHED_FRAMES] = m_lastFrameEnd;
+		}
+
+		void synchroniseCPUFromGPU(uint32_t frameIdx) const
+		{
+			std::this_thread::sleep_until(m_frameEnds[frameIdx % Settings::MAX_CACHED_FRAMES]);
+		}
+
+	private:
+		std::chrono::microseconds m_frameDuration;
+		Clock::time_point m_lastFrameEnd;
+		Clock::time_point m_frameEnds[Settings::MAX_CACHED_FRAMES];
+	};
+
+	double runFrames(const Settings& settings, bool pipelineJobsBeforeFrame)
+	{
+		Wolf::g_runtimeContext->reset();
+		Wolf::JobsManager jobsManager(settings.m_workerCount);
+		SimulatedGPU gpu(std::chrono::microseconds(static_cast<int64_t>(settings.m_gpuMs * 1000.0f)));
+
+		const uint64_t jobIterationCount = computeIterationCount(settings.m_jobsMs / Settings::JOB_COUNT);
+		const uint64_t recordIterationCount = computeIterationCount(settings.m_recordMs);
+
+		bool jobsExecutedDuringPreviousFrame = false;
+		Wolf::JobsManager::JobHandle previousGPUFrameSynchronisedJob;
+
+		const Clock::time_point start = Clock::now();
+		for (uint32_t frameIdx = 0; frameIdx < settings.m_frameCount; ++frameIdx)
+		{
+			// Update before frame
+			if (jobsExecutedDuringPreviousFrame)
+			{
+				jobsExecutedDuringPreviousFrame = false;
+			}
+			else
+			{
+				jobsManager.completeExternalJob(previousGPUFrameSynchronisedJob);
+				previousGPUFrameSynchronisedJob = {};
+				jobsManager.executeJobsBeforeFrame();
+			}
+
+			// Game jobs, then the feedback readback depending on the previous GPU frame like the virtual texture jobs
+			for (uint32_t jobIdx = 0; jobIdx + 1 < Settings::JOB_COUNT; ++jobIdx)
+				jobsManager.addJobBeforeFrame([jobIterationCount]() { computeWork(jobIterationCount); });
+			if (pipelineJobsBeforeFrame)
+				previousGPUFrameSynchronisedJob = jobsManager.addExternalJobBeforeFrame("Previous GPU frame synchronised");
+			jobsManager.addJobBeforeFrame([jobIterationCount]() { computeWork(jobIterationCount); }, { &previousGPUFrameSynchronisedJob, 1 });
+
+			// Frame
+			if (pipelineJobsBeforeFrame)
+				jobsManager.startJobsBeforeFrame(frameIdx + 1);
+
+			computeWork(recordIterationCount);
+			gpu.submit(frameIdx);
+
+			if (frameIdx >= Settings::MAX_CACHED_FRAMES - 1)
+				gpu.synchroniseCPUFromGPU(frameIdx + Settings::MAX_CACHED_FRAMES - 1);
+			jobsManager.completeExternalJob(previousGPUFrameSynchronisedJob);
+			previousGPUFrameSynchronisedJob = {};
+
+			if (pipelineJobsBeforeFrame)
+			{
+				jobsManager.waitJobsBeforeFrame();
+				jobsExecutedDuringPreviousFrame = true;
+			}
+			Wolf::g_runtimeContext->incrementCPUFrameNumber();
+		}
+		const std::chrono::duration<double, std::milli> totalDuration = Clock::now() - start;
+
+		return totalDuration.count() / settings.m_frameCount;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	Wolf::RuntimeContext runtimeContext;
+
+	Settings settings;
+	if (argc > 1) settings.m_frameCount = static_cast<uint32_t>(std::atoi(argv[1]));
+	if (argc > 2) settings.m_jobsMs = static_cast<float>(std::atof(argv[2]));
+	if (argc > 3) settings.m_recordMs = static_cast<float>(std::atof(argv[3]));
+	if (argc > 4) settings.m_gpuMs = static_cast<float>(std::atof(argv[4]));
+	if (argc > 5) settings.m_workerCount = static_cast<uint32_t>(std::atoi(argv[5]));
+
+	std::printf("%u frames, jobs %.2f ms (%u jobs), record %.2f ms, GPU %.2f ms, %u workers, %u CPUs\n", settings.m_frameCount, settings.m_jobsMs, Settings::JOB_COUNT,
+		settings.m_recordMs, settings.m_gpuMs, settings.m_workerCount, std::thread::hardware_concurrency());
+
+	const double serialFrameMs = runFrames(settings, false);
+	const double pipelinedFrameMs = runFrames(settings, true);
+	std::printf("Jobs before recording: %.3f ms per frame\n", serialFrameMs);
+	std::printf("Jobs pipelined:        %.3f ms per frame (%.1f%% of the serial frame time)\n", pipelinedFrameMs, 100.0 * pipelinedFrameMs / serialFrameMs);
+
+	return 0;
+}
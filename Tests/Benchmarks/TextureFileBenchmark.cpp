@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Debug.h>
+
+#include "AsyncFileReader.h"
+#include "DDSFile.h"
+#include "KTX2File.h"
+
+// Load time of a BC7 texture with its full mip chain, each byte of every mip is read like an upload would.
+// The mapped DDSFile and KTX2File are compared to reading each mip into its own buffer, as ImageFileLoader did before.
+// Streaming a single level of the KTX2 file through its level index is compared to reading the whole file.
+// Mapped pages are counted in the RSS but belong to the page cache, the anonymous RSS (Linux only) is the memory the load allocates.
+// Usage: TextureFileBenchmark [size] [repeatCount]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr uint32_t BLOCK_SIZE = 16;
+
+	uint32_t computeMipLevelCount(uint32_t size)
+	{
+		uint32_t mipLevelCount = 1;
+		while ((size >> mipLevelCount) > 0)
+			++mipLevelCount;
+		return mipLevelCount;
+	}
+
+	size_t computeMipSize(uint32_t size, uint32_t mipLevel)
+	{
+		const uint32_t mipSize = std::max(size >> mipLevel, 1u);
+		return static_cast<size_t>((mipSize + 3) / 4) * ((mipSize + 3) / 4) * BLOCK_SIZE;
+	}
+
+	// Payload repeats every 64 KB in each mip, so the DDS file can be written by chunks
+	constexpr size_t PAYLOAD_PERIOD = 1 << 16;
+	uint8_t getPayloadByte(size_t byteIdxInMip)
+	{
+		return static_cast<uint8_t>((byteIdxInMip % PAYLOAD_PERIOD) * 2654435761u >> 24);
+	}
+
+	// DX10 header with DXGI_FORMAT_BC7_UNORM
+	void writeDDS(const std::string& filepath, uint32_t size)
+	{
+		uint32_t header[37] = {};
+		header[0] = 0x20534444; // "DDS "
+		header[1] = 124;
+		header[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;
+		header[3] = size;
+		header[4] = size;
+		header[7] = computeMipLevelCount(size);
+		header[19] = 32;
+		header[20] = 0x4;
+		header[21] = 0x30315844; // "DX10"
+		header[27] = 0x1000;
+		header[32] = 98;
+		header[33] = 3;
+		header[35] = 1;
+
+		std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+		// Written by chunks to keep the peak RSS of the process low
+		std::vector<char> chunk(PAYLOAD_PERIOD);
+		for (size_t byteIdx = 0; byteIdx < chunk.size(); ++byteIdx)
+			chunk[byteIdx] = static_cast<char>(getPayloadByte(byteIdx));
+		for (uint32_t mipLevel = 0; mipLevel < header[7]; ++mipLevel)
+		{
+			for (size_t remainingSize = computeMipSize(size, mipLevel); remainingSize > 0; remainingSize -= std::min(remainingSize, chunk.size()))
+				file.write(chunk.data(), static_cast<std::streamsize>(std::min(remainingSize, chunk.size())));
+		}
+	}
+
+	void writeKTX2(const std::string& filepath, uint32_t size)
+	{
+		std::vector<std::vector<uint8_t>> levels(computeMipLevelCount(size));
+		Wolf::KTX2File::WriteInfo writeInfo;
+		writeInfo.format = Wolf::Format::BC7_UNORM_BLOCK;
+		writeInfo.extent = { size, size, 1 };
+		for (uint32_t mipLevel = 0; mipLevel < levels.size(); ++mipLevel)
+		{
+			levels[mipLevel].resize(computeMipSize(size, mipLevel));
+			for (size_t byteIdx = 0; byteIdx < levels[mipLevel].size(); ++byteIdx)
+				levels[mipLevel][byteIdx] = getPayloadByte(byteIdx);
+			writeInfo.addLevel(levels[mipLevel]);
+		}
+		Wolf::KTX2File::write(filepath, writeInfo);
+	}
+
+	uint64_t sumBytes(std::span<const uint8_t> bytes)
+	{
+		uint64_t sum = 0;
+		for (const uint8_t byte : bytes)
+			sum += byte;
+		return sum;
+	}
+
+	// Resident memory not backed by a file, in /proc/self/status
+	long getAnonymousRSSInMB()
+	{
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line))
+		{
+			if (line.rfind("RssAnon:", 0) == 0)
+			{
+				std::istringstream lineStream(line.substr(8));
+				long sizeInKB = 0;
+				lineStream >> sizeInKB;
+				return sizeInKB / 1024;
+			}
+		}
+		return 0;
+	}
+
+	// Highest anonymous RSS seen while the loaded data is alive
+	long g_loadedAnonymousRSSInMB = 0;
+
+	uint64_t loadMapped(const std::string& filepath)
+	{
+		const Wolf::DDSFile file(filepath);
+		uint64_t sum = 0;
+		for (uint32_t mipLevel = 0; mipLevel < file.getMipLevelCount(); ++mipLevel)
+			sum += sumBytes(file.getSurface(mipLevel));
+		g_loadedAnonymousRSSInMB = std::max(g_loadedAnonymousRSSInMB, getAnonymousRSSInMB());
+		return sum;
+	}
+
+	uint64_t loadMappedKTX2(const std::string& filepath)
+	{
+		const Wolf::KTX2File file(filepath);
+		uint64_t sum = 0;
+		for (uint32_t mipLevel = 0; mipLevel < file.getMipLevelCount(); ++mipLevel)
+			sum += sumBytes(file.getSurface(mipLevel));
+		g_loadedAnonymousRSSInMB = std::max(g_loadedAnonymousRSSInMB, getAnonymousRSSInMB());
+		return sum;
+	}
+
+	uint64_t readKTX2Level(const std::string& filepath, uint32_t mipLevel)
+	{
+		const Wolf::KTX2File file(filepath);
+		const Wolf::KTX2File::LevelByteRange levelByteRange = file.getLevelByteRange(mipLevel);
+
+		Wolf::AsyncFileReader::ReadResult readResult;
+		Wolf::AsyncFileReader::readFile(filepath, levelByteRange.m_offset, levelByteRange.m_size, readResult);
+		const uint64_t sum = sumBytes(readResult.m_data);
+		g_loadedAnonymousRSSInMB = std::max(g_loadedAnonymousRSSInMB, getAnonymousRSSInMB());
+		return sum;
+	}
+
+	uint64_t readWholeFile(const std::string& filepath)
+	{
+		Wolf::AsyncFileReader::ReadResult readResult;
+		Wolf::AsyncFileReader::readFile(filepath, 0, Wolf::AsyncFileReader::WHOLE_FILE, readResult);
+		const uint64_t sum = sumBytes(readResult.m_data);
+		g_loadedAnonymousRSSInMB = std::max(g_loadedAnonymousRSSInMB, getAnonymousRSSInMB());
+		return sum;
+	}
+
+	uint64_t loadCopied(const std::string& filepath, uint32_t size)
+	{
+		std::ifstream file(filepath, std::ios::binary);
+		file.seekg(148);
+
+		std::vector<std::vector<uint8_t>> mips(computeMipLevelCount(size));
+		for (uint32_t mipLevel = 0; mipLevel < mips.size(); ++mipLevel)
+		{
+			mips[mipLevel].resize(computeMipSize(size, mipLevel));
+			file.read(reinterpret_cast<char*>(mips[mipLevel].data()), static_cast<std::streamsize>(mips[mipLevel].size()));
+		}
+
+		uint64_t sum = 0;
+		for (const std::vector<uint8_t>& mip : mips)
+			sum += sumBytes(mip);
+		g_loadedAnonymousRSSInMB = std::max(g_loadedAnonymousRSSInMB, getAnonymousRSSInMB());
+		return sum;
+	}
+
+	template <typename LoadFunction>
+	void measure(const char* name, uint32_t repeatCount, LoadFunction&& loadFunction)
+	{
+		double bestMs = 1e30;
+		uint64_t sum = 0;
+		g_loadedAnonymousRSSInMB = 0;
+		for (uint32_t repeatIdx = 0; repeatIdx < repeatCount; ++repeatIdx)
+		{
+			const Clock::time_point start = Clock::now();
+			sum = loadFunction();
+			bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		std::printf("%-16s %8.2f ms  anonymous RSS %4ld MB  (checksum %llu)\n", name, bestMs, g_loadedAnonymousRSSInMB, static_cast<unsigned long long>(sum));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity == Wolf::Debug::Severity::ERROR || severity == Wolf::Debug::Severity::WARNING)
+			std::printf("%s\n", message.c_str());
+	});
+
+	const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 4096;
+	const uint32_t repeatCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 5;
+
+	const std::string ddsFilepath = "TextureFileBenchmark.dds";
+	writeDDS(ddsFilepath, size);
+	const std::string ktx2Filepath = "TextureFileBenchmark.ktx2";
+	writeKTX2(ktx2Filepath, size);
+	std::printf("%ux%u BC7 with %u mips, best of %u, anonymous RSS before loading %ld MB\n", size, size, computeMipLevelCount(size), repeatCount, getAnonymousRSSInMB());
+
+	measure("mapped DDS", repeatCount, [&]() { return loadMapped(ddsFilepath); });
+	measure("mapped KTX2", repeatCount, [&]() { return loadMappedKTX2(ktx2Filepath); });
+
+	// Freed buffers may stay in the process, paths allocating the most are measured last
+	const uint32_t streamedMipLevel = std::min(4u, computeMipLevelCount(size) - 1);
+	measure("KTX2 level read", repeatCount, [&]() { return readKTX2Level(ktx2Filepath, streamedMipLevel); });
+	measure("copied", repeatCount, [&]() { return loadCopied(ddsFilepath, size); });
+	measure("KTX2 file read", repeatCount, [&]() { return readWholeFile(ktx2Filepath); });
+
+	return 0;
+}
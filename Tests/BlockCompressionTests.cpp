@@ -0,0 +1,296 @@
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/packing.hpp>
+
+#include "BPTCCodec.h"
+#include "ImageCompression.h"
+#include "TestFramework.h"
+
+// BC4, BC6H and BC7 round trips through the encoders and the CPU decoders
+
+using RGBA8 = Wolf::ImageCompression::RGBA8;
+using RGBA32F = Wolf::ImageCompression::RGBA32F;
+
+namespace
+{
+	std::vector<RGBA8> createImage(uint32_t width, uint32_t height, uint32_t noiseAmplitude)
+	{
+		std::mt19937 randomEngine(11);
+		std::uniform_int_distribution<int32_t> noise(-static_cast<int32_t>(noiseAmplitude), static_cast<int32_t>(noiseAmplitude));
+		auto clampToByte = [](int32_t value) { return static_cast<uint8_t>(std::min(std::max(value, 0), 255)); };
+
+		std::vector<RGBA8> pixels(static_cast<size_t>(width) * height);
+		for (uint32_t y = 0; y < height; ++y)
+		{
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				const int32_t shape = static_cast<int32_t>(100.0f * std::sin(static_cast<float>(x) * 0.05f) * std::cos(static_cast<float>(y) * 0.04f));
+				pixels[x + static_cast<size_t>(y) * width] = RGBA8(clampToByte(128 + shape + noise(randomEngine)), clampToByte(static_cast<int32_t>(y * 255 / height) + noise(randomEngine)),
+					clampToByte(200 - shape + noise(randomEngine)), clampToByte(static_cast<int32_t>(x * 255 / width) + noise(randomEngine)));
+			}
+		}
+		return pixels;
+	}
+
+	double computePSNR(const std::vector<RGBA8>& reference, const std::vector<RGBA8>& pixels, uint32_t channelCount)
+	{
+		double squaredErrorSum = 0.0;
+		for (size_t pixelIdx = 0; pixelIdx < reference.size(); ++pixelIdx)
+		{
+			for (uint32_t channelIdx = 0; channelIdx < channelCount; ++channelIdx)
+			{
+				const double error = static_cast<double>(reference[pixelIdx][channelIdx]) - static_cast<double>(pixels[pixelIdx][channelIdx]);
+				squaredErrorSum += error * error;
+			}
+		}
+
+		const double meanSquaredError = squaredErrorSum / (static_cast<double>(reference.size()) * channelCount);
+		return meanSquaredError == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+	}
+
+	template <typename BlockType>
+	std::vector<RGBA8> decode(Wolf::ImageCompression::Compression compression, const std::vector<BlockType>& blocks, uint32_t width, uint32_t height)
+	{
+		std::vector<RGBA8> pixels;
+		Wolf::ImageCompression::uncompressImage(compression, reinterpret_cast<const unsigned char*>(blocks.data()), Wolf::Extent2D{ width, height }, pixels);
+		return pixels;
+	}
+
+	// Bits are written from the lowest bit of the first byte, as BPTC blocks are read
+	class BlockBitWriter
+	{
+	public:
+		void write(uint32_t value, uint32_t bitCount)
+		{
+			for (uint32_t bitIdx = 0; bitIdx < bitCount; ++bitIdx, ++m_bitOffset)
+				m_bytes[m_bitOffset / 8] |= static_cast<uint8_t>(((value >> bitIdx) & 1) << (m_bitOffset % 8));
+		}
+
+		template <typename BlockType>
+		BlockType getBlock() const
+		{
+			BlockType block;
+			static_assert(sizeof(BlockType) == sizeof(m_bytes));
+			std::memcpy(&block, m_bytes, sizeof(m_bytes));
+			return block;
+		}
+
+	private:
+		uint8_t m_bytes[16] = {};
+		uint32_t m_bitOffset = 0;
+	};
+}
+
+WOLF_TEST(BC4RoundTrip)
+{
+	constexpr uint32_t WIDTH = 128, HEIGHT = 64;
+	const std::vector<RGBA8> pixels = createImage(WIDTH, HEIGHT, 8);
+
+	double fastPSNR = 0.0;
+	for (const Wolf::ImageCompression::Quality quality : { Wolf::ImageCompression::Quality::FAST, Wolf::ImageCompression::Quality::HIGH })
+	{
+		std::vector<Wolf::ImageCompression::BC4> blocks;
+		Wolf::ImageCompression::compressBC4(Wolf::Extent3D{ WIDTH, HEIGHT, 1 }, pixels, blocks, quality);
+		WOLF_CHECK_EQUAL(blocks.size(), static_cast<size_t>(WIDTH / 4) * (HEIGHT / 4));
+
+		const std::vector<RGBA8> decodedPixels = decode(Wolf::ImageCompression::Compression::BC4, blocks, WIDTH, HEIGHT);
+		const double psnr = computePSNR(pixels, decodedPixels, 1);
+		WOLF_CHECK(psnr >= 48.0);
+		if (quality == Wolf::ImageCompression::Quality::FAST)
+			fastPSNR = psnr;
+		else
+			WOLF_CHECK(psnr >= fastPSNR);
+
+		// Sampled as (red, 0, 0, 1)
+		WOLF_CHECK(decodedPixels[5].g == 0 && decodedPixels[5].b == 0 && decodedPixels[5].a == 255);
+	}
+
+	// Flat red channels are exact
+	const std::vector<RGBA8> flatPixels(static_cast<size_t>(16) * 16, RGBA8(173, 20, 30, 40));
+	std::vector<Wolf::ImageCompression::BC4> blocks;
+	Wolf::ImageCompression::compressBC4(Wolf::Extent3D{ 16, 16, 1 }, flatPixels, blocks);
+	WOLF_CHECK_EQUAL(computePSNR(flatPixels, decode(Wolf::ImageCompression::Compression::BC4, blocks, 16, 16), 1), 100.0);
+}
+
+WOLF_TEST(BC7RoundTrip)
+{
+	constexpr uint32_t WIDTH = 128, HEIGHT = 64;
+
+	for (const uint32_t noiseAmplitude : { 0u, 20u })
+	{
+		const std::vector<RGBA8> pixels = createImage(WIDTH, HEIGHT, noiseAmplitude);
+
+		double fastPSNR = 0.0;
+		for (const Wolf::ImageCompression::Quality quality : { Wolf::ImageCompression::Quality::FAST, Wolf::ImageCompression::Quality::HIGH })
+		{
+			std::vector<Wolf::ImageCompression::BC7> blocks;
+			Wolf::ImageCompression::compressBC7(Wolf::Extent3D{ WIDTH, HEIGHT, 1 }, pixels, blocks, quality);
+
+			const double psnr = computePSNR(pixels, decode(Wolf::ImageCompression::Compression::BC7, blocks, WIDTH, HEIGHT), 4);
+			WOLF_CHECK(psnr >= (noiseAmplitude == 0 ? 43.0 : 29.0));
+			if (quality == Wolf::ImageCompression::Quality::FAST)
+				fastPSNR = psnr;
+			else
+				WOLF_CHECK(psnr >= fastPSNR);
+		}
+	}
+}
+
+WOLF_TEST(BC7SingleColorBlocks)
+{
+	std::mt19937 randomEngine(13);
+	std::uniform_int_distribution<uint32_t> distribution(0, 255);
+	for (uint32_t colorIdx = 0; colorIdx < 256; ++colorIdx)
+	{
+		const RGBA8 color(static_cast<uint8_t>(colorIdx), static_cast<uint8_t>(distribution(randomEngine)), static_cast<uint8_t>(distribution(randomEngine)), static_cast<uint8_t>(255 - colorIdx));
+		const std::vector<RGBA8> pixels(16, color);
+
+		Wolf::ImageCompression::BC7 block;
+		Wolf::encodeBC7Block(pixels.data(), 4, Wolf::ImageCompression::Quality::FAST, block);
+
+		RGBA8 texels[16];
+		Wolf::decodeBC7Block(block, texels);
+		for (const RGBA8& texel : texels)
+		{
+			for (uint32_t channelIdx = 0; channelIdx < 4; ++channelIdx)
+				WOLF_CHECK(std::abs(static_cast<int32_t>(texel[channelIdx]) - static_cast<int32_t>(color[channelIdx])) <= 1);
+		}
+	}
+}
+
+WOLF_TEST(BC7DecodesWrittenBlocks)
+{
+	// Mode 6: with the p-bits, red goes from 0 to 255 along the indices and other channels from 254 to 255
+	BlockBitWriter writer;
+	writer.write(1 << 6, 7);
+	const uint32_t endpoints[4][2] = { { 0, 127 }, { 127, 127 }, { 127, 127 }, { 127, 127 } };
+	for (const auto& channelEndpoints : endpoints)
+	{
+		writer.write(channelEndpoints[0], 7);
+		writer.write(channelEndpoints[1], 7);
+	}
+	writer.write(0, 1);
+	writer.write(1, 1);
+	for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+		writer.write(texelIdx, texelIdx == 0 ? 3 : 4);
+
+	RGBA8 texels[16];
+	Wolf::decodeBC7Block(writer.getBlock<Wolf::ImageCompression::BC7>(), texels);
+
+	constexpr uint32_t WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+	for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+	{
+		const uint32_t weight = WEIGHTS[texelIdx];
+		WOLF_CHECK_EQUAL(static_cast<uint32_t>(texels[texelIdx].r), (weight * 255 + 32) >> 6);
+		for (uint32_t channelIdx = 1; channelIdx < 4; ++channelIdx)
+			WOLF_CHECK_EQUAL(static_cast<uint32_t>(texels[texelIdx][channelIdx]), ((64 - weight) * 254 + weight * 255 + 32) >> 6);
+	}
+
+	// Reserved mode gives transparent black
+	Wolf::ImageCompression::BC7 reservedBlock;
+	std::memset(&reservedBlock, 0, sizeof(reservedBlock));
+	Wolf::decodeBC7Block(reservedBlock, texels);
+	for (const RGBA8& texel : texels)
+		WOLF_CHECK(texel.r == 0 && texel.g == 0 && texel.b == 0 && texel.a == 0);
+}
+
+WOLF_TEST(BC6HRoundTrip)
+{
+	constexpr uint32_t WIDTH = 64, HEIGHT = 64;
+
+	// Sky with a sun several orders of magnitude brighter, and negative values which are clamped
+	std::mt19937 randomEngine(5);
+	std::uniform_real_distribution<float> noise(0.9f, 1.1f);
+	std::vector<RGBA32F> pixels(static_cast<size_t>(WIDTH) * HEIGHT);
+	for (uint32_t y = 0; y < HEIGHT; ++y)
+	{
+		for (uint32_t x = 0; x < WIDTH; ++x)
+		{
+			const float sky = 0.3f + 2.0f * static_cast<float>(y) / HEIGHT;
+			const float dx = static_cast<float>(x) - 40.0f, dy = static_cast<float>(y) - 20.0f;
+			const float sun = 2000.0f * std::exp(-(dx * dx + dy * dy) / 50.0f);
+			pixels[x + static_cast<size_t>(y) * WIDTH] = RGBA32F((sky * 0.6f + sun) * noise(randomEngine), (sky * 0.8f + sun * 0.9f) * noise(randomEngine), (sky + sun * 0.7f) * noise(randomEngine), 1.0f);
+		}
+	}
+	pixels[0] = RGBA32F(-4.0f, -4.0f, -4.0f, 1.0f);
+
+	double fastError = 0.0;
+	for (const Wolf::ImageCompression::Quality quality : { Wolf::ImageCompression::Quality::FAST, Wolf::ImageCompression::Quality::HIGH })
+	{
+		std::vector<Wolf::ImageCompression::BC6H> blocks;
+		Wolf::ImageCompression::compressBC6H(Wolf::Extent3D{ WIDTH, HEIGHT, 1 }, pixels, blocks, quality);
+
+		std::vector<Wolf::ImageCompression::RGBA16F> decodedPixels;
+		Wolf::ImageCompression::uncompressImage(Wolf::ImageCompression::Compression::BC6H, reinterpret_cast<const unsigned char*>(blocks.data()), Wolf::Extent2D{ WIDTH, HEIGHT }, decodedPixels);
+		WOLF_CHECK_EQUAL(decodedPixels.size(), pixels.size());
+
+		// Error in stops, HDR values are compared on a log scale
+		double squaredErrorSum = 0.0;
+		for (size_t pixelIdx = 1; pixelIdx < pixels.size(); ++pixelIdx)
+		{
+			const float reference[3] = { pixels[pixelIdx].r, pixels[pixelIdx].g, pixels[pixelIdx].b };
+			const uint16_t decoded[3] = { decodedPixels[pixelIdx].r, decodedPixels[pixelIdx].g, decodedPixels[pixelIdx].b };
+			for (uint32_t channelIdx = 0; channelIdx < 3; ++channelIdx)
+			{
+				const double error = std::log2(glm::unpackHalf1x16(decoded[channelIdx]) + 1e-3) - std::log2(reference[channelIdx] + 1e-3);
+				squaredErrorSum += error * error;
+			}
+			WOLF_CHECK_EQUAL(glm::unpackHalf1x16(decodedPixels[pixelIdx].a), 1.0f);
+		}
+		const double rootMeanSquaredError = std::sqrt(squaredErrorSum / (static_cast<double>(pixels.size() - 1) * 3));
+		WOLF_CHECK(rootMeanSquaredError < 0.08);
+		if (quality == Wolf::ImageCompression::Quality::FAST)
+			fastError = rootMeanSquaredError;
+		else
+			WOLF_CHECK(rootMeanSquaredError <= fastError);
+
+		WOLF_CHECK(glm::unpackHalf1x16(decodedPixels[0].r) >= 0.0f);
+	}
+}
+
+WOLF_TEST(BC6HTwoRegionsModes)
+{
+	struct ReferenceBlock
+	{
+		Wolf::ImageCompression::BC6H block;
+		uint16_t texels[16][3];
+	};
+
+	// Blocks written bit by bit from the format specification, expected half floats computed with the specification decoding
+	const ReferenceBlock referenceBlocks[] =
+	{
+		// Mode 1, partition 17 (anchor of the second region is texel 2). Base endpoint (100, 200, 300), x, y and z are 5 bits deltas with negative values
+		{ { { 0x88, 0x0c, 0x64, 0x58, 0x7a, 0x0b, 0xce, 0xd1, 0xfe, 0x33, 0x7e, 0x8b, 0x68, 0xac, 0x0f, 0xd1 } },
+			{ { 0x0cef, 0x1776, 0x248a }, { 0x0d04, 0x176e, 0x2634 }, { 0x0c52, 0x1879, 0x2407 }, { 0x0cbe, 0x17d7, 0x255a }, { 0x0c2b, 0x1847, 0x2463 }, { 0x0c6c, 0x1801, 0x2470 },
+			  { 0x0cae, 0x17bc, 0x247d }, { 0x0c75, 0x1845, 0x2474 }, { 0x0d38, 0x1728, 0x2499 }, { 0x0d79, 0x16e3, 0x24a6 }, { 0x0dbb, 0x169d, 0x24b3 }, { 0x0dfc, 0x1657, 0x24c0 },
+			  { 0x0c2b, 0x1847, 0x2463 }, { 0x0cae, 0x17bc, 0x247d }, { 0x0d38, 0x1728, 0x2499 }, { 0x0dbb, 0x169d, 0x24b3 } } },
+		// Mode 10, partition 0, four 6 bits endpoints (0, 63, 10), (63, 0, 50), (32, 1, 62) and (5, 40, 63) which are not deltas
+		{ { { 0x1e, 0xf0, 0xdf, 0x94, 0xff, 0x03, 0x40, 0xd9, 0xc1, 0x02, 0xf0, 0x58, 0x1d, 0x77, 0xc4, 0xea } },
+			{ { 0x0000, 0x7bff, 0x1458 }, { 0x7bff, 0x0000, 0x61d8 }, { 0x379c, 0x0d88, 0x7980 }, { 0x1203, 0x43d7, 0x7b96 }, { 0x22e0, 0x591f, 0x2a24 }, { 0x591f, 0x22e0, 0x4c0c },
+			  { 0x28e6, 0x22c8, 0x7a51 }, { 0x20b9, 0x2e97, 0x7ac5 }, { 0x3450, 0x47af, 0x350a }, { 0x7bff, 0x0000, 0x61d8 }, { 0x3ef8, 0x02e8, 0x7918 }, { 0x379c, 0x0d88, 0x7980 },
+			  { 0x6a8f, 0x1170, 0x56f2 }, { 0x22e0, 0x591f, 0x2a24 }, { 0x195e, 0x3937, 0x7b2e }, { 0x28e6, 0x22c8, 0x7a51 } } }
+	};
+
+	for (const ReferenceBlock& referenceBlock : referenceBlocks)
+	{
+		Wolf::ImageCompression::RGBA16F texels[16];
+		Wolf::decodeBC6HBlock(referenceBlock.block, texels);
+		for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+		{
+			WOLF_CHECK_EQUAL(texels[texelIdx].r, referenceBlock.texels[texelIdx][0]);
+			WOLF_CHECK_EQUAL(texels[texelIdx].g, referenceBlock.texels[texelIdx][1]);
+			WOLF_CHECK_EQUAL(texels[texelIdx].b, referenceBlock.texels[texelIdx][2]);
+			WOLF_CHECK_EQUAL(glm::unpackHalf1x16(texels[texelIdx].a), 1.0f);
+		}
+	}
+
+	// Same through the image decoder, which doesn't report black blocks anymore
+	std::vector<Wolf::ImageCompression::RGBA16F> decodedPixels;
+	Wolf::ImageCompression::uncompressImage(Wolf::ImageCompression::Compression::BC6H, referenceBlocks[0].block.data, Wolf::Extent2D{ 4, 4 }, decodedPixels);
+	WOLF_CHECK_EQUAL(decodedPixels.size(), 16u);
+	for (uint32_t texelIdx = 0; texelIdx < decodedPixels.size(); ++texelIdx)
+		WOLF_CHECK_EQUAL(decodedPixels[texelIdx].r, referenceBlocks[0].texels[texelIdx][0]);
+}
@@ -0,0 +1,149 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "ConfigurationDocument.h"
+#include "ConfigurationHelper.h"
+#include "TestFramework.h"
+
+namespace
+{
+	void writeFile(const std::string& filepath, const std::string& content)
+	{
+		std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+		file << content;
+	}
+
+	std::string readFile(const std::string& filepath)
+	{
+		std::ifstream file(filepath, std::ios::binary);
+		std::stringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+}
+
+WOLF_TEST(ReadValues)
+{
+	const std::string filepath = "ConfigurationTests_read.txt";
+	writeFile(filepath, "# comment\nwidth = 1024\n  height=512 \r\nname = a b\nwidth = 7\nflag = true\nf = 1.5\nbig = 123456789012\nbad = 12x\nlast=1");
+
+	const Wolf::ConfigurationDocument document(filepath);
+	WOLF_CHECK_EQUAL(document.getKeyCount(), 8u);
+	WOLF_CHECK_EQUAL(document.getUInt32("width"), 1024u);
+	WOLF_CHECK_EQUAL(document.getUInt32("height"), 512u);
+	WOLF_CHECK_EQUAL(document.getString("name"), std::string("ab"));
+	WOLF_CHECK(document.getBool("flag"));
+	WOLF_CHECK_EQUAL(document.getFloat("f"), 1.5f);
+	WOLF_CHECK_EQUAL(document.getUInt64("big"), 123456789012ull);
+	WOLF_CHECK_EQUAL(document.getString("last"), std::string("1"));
+
+	WOLF_CHECK(!document.hasKey("missing"));
+	WOLF_CHECK(document.getString("missing").empty());
+	WOLF_CHECK_EQUAL(document.getUInt32("missing", 5), 5u);
+	WOLF_CHECK(document.getBool("missing", true));
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	WOLF_CHECK_EQUAL(document.getUInt32("bad", 3), 3u);
+}
+
+WOLF_TEST(MissingFileIsCreatedByFlush)
+{
+	const std::string filepath = "ConfigurationTests_created.txt";
+	std::filesystem::remove(filepath);
+
+	Wolf::ConfigurationDocument document(filepath);
+	WOLF_CHECK_EQUAL(document.getKeyCount(), 0u);
+	WOLF_CHECK(!document.hasChanges());
+	WOLF_CHECK(document.flush());
+	WOLF_CHECK(!std::filesystem::exists(filepath));
+
+	document.setValue("a", true);
+	document.setValue("b", 42u);
+	WOLF_CHECK(document.hasChanges());
+	WOLF_CHECK(document.flush());
+	WOLF_CHECK(!document.hasChanges());
+	WOLF_CHECK_EQUAL(readFile(filepath), std::string("a = true\nb = 42\n"));
+	WOLF_CHECK(!std::filesystem::exists(filepath + ".tmp"));
+}
+
+WOLF_TEST(WritesKeepOtherLines)
+{
+	const std::string filepath = "ConfigurationTests_write.txt";
+	writeFile(filepath, "# comment\nwidth = 1024\nheight = 512\nwidth = 7\n");
+
+	Wolf::ConfigurationDocument document(filepath);
+	document.setValue("height", 600u);
+	document.setValue("width", "1024");
+	document.setValue("newKey", std::string("x"));
+	WOLF_CHECK(document.flush());
+
+	// First line of a duplicated key is the one used and updated
+	WOLF_CHECK_EQUAL(readFile(filepath), std::string("# comment\nwidth = 1024\nheight = 600\nwidth = 7\nnewKey = x\n"));
+
+	// Same value doesn't change the document
+	document.setValue("height", 600u);
+	WOLF_CHECK(!document.hasChanges());
+}
+
+WOLF_TEST(HelperCacheFollowsFileChanges)
+{
+	const std::string filepath = "ConfigurationTests_helper.txt";
+	writeFile(filepath, "width = 1024\n");
+	Wolf::ConfigurationHelper::clearCache();
+
+	WOLF_CHECK_EQUAL(Wolf::ConfigurationHelper::readInfoFromFile(filepath, "width"), std::string("1024"));
+
+	Wolf::ConfigurationHelper::writeInfoToFile(filepath, "height", 600u);
+	Wolf::ConfigurationHelper::writeInfoToFile(filepath, "fullscreen", false);
+	WOLF_CHECK_EQUAL(Wolf::ConfigurationHelper::readInfoFromFile(filepath, "height"), std::string("600"));
+	WOLF_CHECK_EQUAL(readFile(filepath), std::string("width = 1024\nheight = 600\nfullscreen = false\n"));
+
+	// Modified by something else, the size differs even if the modification time has the same value
+	writeFile(filepath, "width = 2048\n\n");
+	WOLF_CHECK_EQUAL(Wolf::ConfigurationHelper::readInfoFromFile(filepath, "width"), std::string("2048"));
+	WOLF_CHECK(Wolf::ConfigurationHelper::readInfoFromFile(filepath, "height").empty());
+
+	WOLF_CHECK(Wolf::ConfigurationHelper::readInfoFromFile("ConfigurationTests_missing.txt", "a").empty());
+}
+
+WOLF_TEST(ThousandsOfKeys)
+{
+	constexpr uint32_t KEY_COUNT = 5000;
+
+	const std::string filepath = "ConfigurationTests_many.txt";
+	std::string content;
+	for (uint32_t keyIdx = 0; keyIdx < KEY_COUNT; ++keyIdx)
+		content += "key" + std::to_string(keyIdx) + " = " + std::to_string(keyIdx * 3) + "\n";
+	writeFile(filepath, content);
+
+	{
+		Wolf::ConfigurationDocument document(filepath);
+		WOLF_CHECK_EQUAL(document.getKeyCount(), KEY_COUNT);
+		for (uint32_t keyIdx = 0; keyIdx < KEY_COUNT; ++keyIdx)
+			WOLF_CHECK_EQUAL(document.getUInt32("key" + std::to_string(keyIdx)), keyIdx * 3);
+
+		// Batched writes, a single file write
+		for (uint32_t keyIdx = 0; keyIdx < KEY_COUNT; keyIdx += 2)
+			document.setValue("key" + std::to_string(keyIdx), keyIdx + 1);
+		WOLF_CHECK(document.flush());
+	}
+
+	Wolf::ConfigurationHelper::clearCache();
+	for (uint32_t keyIdx = 0; keyIdx < KEY_COUNT; ++keyIdx)
+	{
+		const uint32_t expectedValue = keyIdx % 2 == 0 ? keyIdx + 1 : keyIdx * 3;
+		WOLF_CHECK_EQUAL(Wolf::ConfigurationHelper::readInfoFromFile(filepath, "key" + std::to_string(keyIdx)), std::to_string(expectedValue));
+	}
+
+	// Each helper write updates the cached document and the file
+	for (uint32_t keyIdx = 0; keyIdx < 500; ++keyIdx)
+		Wolf::ConfigurationHelper::writeInfoToFile(filepath, "key" + std::to_string(keyIdx), std::to_string(keyIdx));
+
+	const Wolf::ConfigurationDocument document(filepath);
+	WOLF_CHECK_EQUAL(document.getKeyCount(), KEY_COUNT);
+	for (uint32_t keyIdx = 0; keyIdx < 500; ++keyIdx)
+		WOLF_CHECK_EQUAL(document.getUInt32("key" + std::to_string(keyIdx)), keyIdx);
+	WOLF_CHECK_EQUAL(document.getUInt32("key4999"), 4999u * 3);
+}
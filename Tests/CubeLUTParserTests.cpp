@@ -0,0 +1,227 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glm/gtc/packing.hpp>
+
+#include "CubeLUTParser.h"
+#include "ImageFileLoader.h"
+#include "JobsManager.h"
+#include "TestFramework.h"
+
+namespace
+{
+	bool isFloat(const std::string& str)
+	{
+		std::istringstream stream(str);
+		float value;
+		stream >> std::noskipws >> value;
+		return stream.eof() && !stream.fail();
+	}
+
+	// getline and stof parser that ImageFileLoader used before CubeLUTParser, kept as the reference of the half floats
+	std::vector<uint16_t> parseWithFirstParser(const std::string& text, uint32_t& outLUTSize)
+	{
+		std::vector<uint16_t> data;
+		std::istringstream stream(text);
+		std::string line;
+		uint32_t dataIdx = 0;
+		bool dataStarted = false;
+		while (std::getline(stream, line))
+		{
+			if (const size_t pos = line.find("LUT_3D_SIZE"); pos != std::string::npos)
+			{
+				line.erase(0, pos + 12);
+				outLUTSize = std::stoi(line);
+				data.resize(static_cast<size_t>(outLUTSize) * outLUTSize * outLUTSize * 4);
+				continue;
+			}
+			if (data.empty())
+				continue;
+			if (!dataStarted)
+			{
+				const size_t firstSpace = line.find(' ');
+				if (firstSpace == std::string::npos || !isFloat(line.substr(0, firstSpace)))
+					continue;
+				dataStarted = true;
+			}
+
+			const size_t firstSpace = line.find(' ');
+			data[dataIdx++] = glm::packHalf1x16(std::stof(line.substr(0, firstSpace)));
+			line.erase(0, firstSpace + 1);
+			const size_t secondSpace = line.find(' ');
+			data[dataIdx++] = glm::packHalf1x16(std::stof(line.substr(0, secondSpace)));
+			line.erase(0, secondSpace + 1);
+			data[dataIdx++] = glm::packHalf1x16(std::stof(line));
+			data[dataIdx++] = glm::packHalf1x16(0.0f);
+		}
+		return data;
+	}
+
+	enum class NumberStyle
+	{
+		FIXED,
+		SHORTEST,
+		EXPONENT,
+		SIGNED_HDR // negative and above the half float range
+	};
+
+	std::string createLUT(uint32_t lutSize, NumberStyle numberStyle, bool useCRLF, bool endWithNewline)
+	{
+		std::mt19937 randomEngine(7);
+		std::uniform_real_distribution<double> distribution(numberStyle == NumberStyle::SIGNED_HDR ? -2.0 : 0.0, numberStyle == NumberStyle::SIGNED_HDR ? 70000.0 : 1.0);
+		const std::string newline = useCRLF ? "\r\n" : "\n";
+
+		std::string text = "# Created by CubeLUTParserTests" + newline + "TITLE \"test lut\"" + newline + newline + "# comment line" + newline;
+		text += "LUT_3D_SIZE " + std::to_string(lutSize) + newline + "DOMAIN_MIN 0.0 0.0 0.0" + newline + "DOMAIN_MAX 1.0 1.0 1.0" + newline;
+
+		const uint64_t lineCount = static_cast<uint64_t>(lutSize) * lutSize * lutSize;
+		char line[128];
+		for (uint64_t lineIdx = 0; lineIdx < lineCount; ++lineIdx)
+		{
+			const double r = distribution(randomEngine), g = distribution(randomEngine), b = distribution(randomEngine);
+			switch (numberStyle)
+			{
+				case NumberStyle::FIXED:
+					std::snprintf(line, sizeof(line), "%.6f %.6f %.6f", r, g, b);
+					break;
+				case NumberStyle::SHORTEST:
+					std::snprintf(line, sizeof(line), "%.17g %.9g %.3g", r, g, b);
+					break;
+				case NumberStyle::EXPONENT:
+					std::snprintf(line, sizeof(line), "%g %e %.10f", r * 1e-3, g, b);
+					break;
+				case NumberStyle::SIGNED_HDR:
+					std::snprintf(line, sizeof(line), "%.4f %.2f +%.5f", r, g, std::abs(b));
+					break;
+			}
+			text += line;
+			if (lineIdx + 1 < lineCount || endWithNewline)
+				text += newline;
+		}
+		return text;
+	}
+
+	bool isSameAsFirstParser(const std::string& text)
+	{
+		uint32_t lutSize = 0;
+		const std::vector<uint16_t> reference = parseWithFirstParser(text, lutSize);
+
+		const Wolf::CubeLUTParser parser(text);
+		std::vector<uint16_t> texels(reference.size());
+		return parser.isValid() && parser.getLUTSize() == lutSize && parser.parse(texels.data()) && texels == reference;
+	}
+
+	bool isRejected(const std::string& text)
+	{
+		const Wolf::CubeLUTParser parser(text);
+		if (!parser.isValid())
+			return true;
+
+		std::vector<uint16_t> texels(parser.getTexelCount() * 4);
+		return !parser.parse(texels.data());
+	}
+
+	uint64_t getFileSize(const std::string& filepath)
+	{
+		std::error_code errorCode;
+		const uint64_t fileSize = std::filesystem::file_size(filepath, errorCode);
+		return errorCode ? 0 : fileSize;
+	}
+
+	void writeFile(const std::string& filepath, const std::string& content)
+	{
+		std::ofstream(filepath, std::ios::binary | std::ios::trunc) << content;
+	}
+}
+
+WOLF_TEST(MatchesFirstParser)
+{
+	for (const NumberStyle numberStyle : { NumberStyle::FIXED, NumberStyle::SHORTEST, NumberStyle::EXPONENT, NumberStyle::SIGNED_HDR })
+	{
+		for (const bool useCRLF : { false, true })
+		{
+			const uint32_t lutSize = numberStyle == NumberStyle::SHORTEST ? 33 : 17;
+			WOLF_CHECK(isSameAsFirstParser(createLUT(lutSize, numberStyle, useCRLF, !useCRLF)));
+		}
+	}
+}
+
+WOLF_TEST(RangesParsedByWorkersMatchFirstParser)
+{
+	// Several MB of text, split in ranges
+	const std::string text = createLUT(64, NumberStyle::SHORTEST, false, true);
+	WOLF_CHECK(isSameAsFirstParser(text));
+
+	Wolf::JobsManager jobsManager(3);
+	WOLF_CHECK(isSameAsFirstParser(text));
+}
+
+WOLF_TEST(BlankLinesAndCommentsInDataAreSkipped)
+{
+	const std::string text = createLUT(4, NumberStyle::FIXED, false, true);
+	std::string textWithBlankLines = text;
+	const size_t secondDataLineStart = textWithBlankLines.find('\n', textWithBlankLines.find("DOMAIN_MAX") + 40) + 1;
+	textWithBlankLines.insert(secondDataLineStart, "\n# comment between data lines\n   \n");
+
+	const Wolf::CubeLUTParser parser(text);
+	const Wolf::CubeLUTParser parserWithBlankLines(textWithBlankLines);
+	std::vector<uint16_t> texels(parser.getTexelCount() * 4), texelsWithBlankLines(texels.size());
+	WOLF_CHECK(parser.parse(texels.data()));
+	WOLF_CHECK(parserWithBlankLines.parse(texelsWithBlankLines.data()));
+	WOLF_CHECK(texels == texelsWithBlankLines);
+}
+
+WOLF_TEST(RejectsMalformedLUTs)
+{
+	const std::string text = createLUT(4, NumberStyle::FIXED, false, true);
+	std::string garbageValue = text;
+	garbageValue.replace(garbageValue.find("0.", garbageValue.find("DOMAIN_MAX") + 30), 2, "x.");
+
+	WOLF_CHECK(isRejected(text + "0.1 0.2 0.3\n"));
+	WOLF_CHECK(isRejected(text.substr(0, text.rfind('\n', text.size() - 2) + 1)));
+	WOLF_CHECK(isRejected("LUT_3D_SIZE 4\n0.1 0.2\n"));
+	WOLF_CHECK(isRejected("TITLE \"no size\"\n0 0 0\n"));
+	WOLF_CHECK(isRejected("LUT_3D_SIZE 1000\n0 0 0\n"));
+	WOLF_CHECK(isRejected(garbageValue));
+
+	writeFile("CubeLUTParserTests_garbage.cube", garbageValue);
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	const Wolf::ImageFileLoader loader("CubeLUTParserTests_garbage.cube");
+	WOLF_CHECK(loader.getPixels() == nullptr);
+}
+
+WOLF_TEST(BinaryCacheIsRebuiltWhenSourceChanges)
+{
+	constexpr uint32_t LUT_SIZE = 16;
+	constexpr size_t TEXELS_BYTE_COUNT = LUT_SIZE * LUT_SIZE * LUT_SIZE * 4 * sizeof(uint16_t);
+	const std::string filepath = "CubeLUTParserTests.cube", cacheFilepath = filepath + ".cache";
+	writeFile(filepath, createLUT(LUT_SIZE, NumberStyle::SHORTEST, false, true));
+	std::filesystem::remove(cacheFilepath);
+
+	const Wolf::ImageFileLoader firstLoader(filepath, false, true);
+	WOLF_CHECK(firstLoader.getPixels() != nullptr);
+	WOLF_CHECK(getFileSize(cacheFilepath) > TEXELS_BYTE_COUNT);
+
+	const Wolf::ImageFileLoader cachedLoader(filepath, false, true);
+	WOLF_CHECK(cachedLoader.getPixels() && std::memcmp(cachedLoader.getPixels(), firstLoader.getPixels(), TEXELS_BYTE_COUNT) == 0);
+
+	// The cache of the previous content is stale
+	const std::string changedText = createLUT(LUT_SIZE, NumberStyle::FIXED, false, true);
+	writeFile(filepath, changedText);
+	uint32_t lutSize = 0;
+	const std::vector<uint16_t> reference = parseWithFirstParser(changedText, lutSize);
+	const Wolf::ImageFileLoader staleCacheLoader(filepath, false, true);
+	WOLF_CHECK(staleCacheLoader.getPixels() && std::memcmp(staleCacheLoader.getPixels(), reference.data(), TEXELS_BYTE_COUNT) == 0);
+
+	std::error_code errorCode;
+	std::filesystem::resize_file(cacheFilepath, 1000, errorCode);
+	const Wolf::ImageFileLoader truncatedCacheLoader(filepath, false, true);
+	WOLF_CHECK(truncatedCacheLoader.getPixels() && std::memcmp(truncatedCacheLoader.getPixels(), reference.data(), TEXELS_BYTE_COUNT) == 0);
+	WOLF_CHECK(getFileSize(cacheFilepath) > TEXELS_BYTE_COUNT);
+}
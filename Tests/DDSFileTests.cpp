@@ -0,0 +1,265 @@
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "DDSFile.h"
+#include "TestFramework.h"
+
+namespace
+{
+	constexpr uint32_t DDPF_FOURCC = 0x4;
+	constexpr uint32_t DDPF_RGB_ALPHA = 0x41;
+	constexpr uint32_t DDSD_REQUIRED = 0x1007;
+	constexpr uint32_t DDSD_DEPTH = 0x800000;
+	constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+	constexpr uint32_t DDSCAPS2_CUBEMAP_POSITIVEX = 0x400;
+	constexpr uint32_t DDSCAPS2_CUBEMAP_ALL_FACES = 0xFC00;
+	constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+	constexpr uint32_t D3D11_RESOURCE_MISC_TEXTURECUBE = 0x4;
+	constexpr uint32_t D3D11_RESOURCE_DIMENSION_TEXTURE2D = 3;
+
+	constexpr uint32_t DXGI_FORMAT_R32G32B32A32_FLOAT = 2;
+	constexpr uint32_t DXGI_FORMAT_R10G10B10A2_UNORM = 24;
+	constexpr uint32_t DXGI_FORMAT_BC1_UNORM = 71;
+	constexpr uint32_t DXGI_FORMAT_BC2_UNORM_SRGB = 75;
+	constexpr uint32_t DXGI_FORMAT_BC6H_UF16 = 95;
+	constexpr uint32_t DXGI_FORMAT_BC7_UNORM = 98;
+	constexpr uint32_t D3DFMT_A16B16G16R16F = 113;
+
+	uint32_t makeFourCC(const char* fourCC)
+	{
+		uint32_t value;
+		std::memcpy(&value, fourCC, sizeof(value));
+		return value;
+	}
+
+	void appendUInt32(std::vector<uint8_t>& bytes, uint32_t value)
+	{
+		const uint8_t* valueBytes = reinterpret_cast<const uint8_t*>(&value);
+		bytes.insert(bytes.end(), valueBytes, valueBytes + sizeof(value));
+	}
+
+	struct PixelFormat
+	{
+		uint32_t flags = DDPF_FOURCC;
+		uint32_t fourCC = 0;
+		uint32_t masks[4] = {}; // R, G, B, A for 32 bits RGB formats
+	};
+
+	PixelFormat fourCCFormat(const char* fourCC) { return { DDPF_FOURCC, makeFourCC(fourCC) }; }
+	PixelFormat fourCCFormat(uint32_t fourCC) { return { DDPF_FOURCC, fourCC }; }
+	PixelFormat rgbaFormat(uint32_t redMask, uint32_t blueMask) { return { DDPF_RGB_ALPHA, 0, { redMask, 0x0000ff00, blueMask, 0xff000000 } }; }
+
+	struct Header
+	{
+		uint32_t width;
+		uint32_t height;
+		uint32_t mipMapCount;
+		PixelFormat pixelFormat;
+		uint32_t caps2 = 0;
+		uint32_t depth = 0;
+		uint32_t flags = DDSD_REQUIRED;
+		uint32_t size = 124;
+	};
+
+	std::vector<uint8_t> createHeader(const Header& header)
+	{
+		std::vector<uint8_t> bytes = { 'D', 'D', 'S', ' ' };
+		for (const uint32_t value : { header.size, header.flags, header.height, header.width, 0u, header.depth, header.mipMapCount })
+			appendUInt32(bytes, value);
+		bytes.resize(bytes.size() + 11 * sizeof(uint32_t));
+
+		const PixelFormat& pixelFormat = header.pixelFormat;
+		const uint32_t bitCount = pixelFormat.flags & DDPF_FOURCC ? 0 : 32;
+		for (const uint32_t value : { 32u, pixelFormat.flags, pixelFormat.fourCC, bitCount, pixelFormat.masks[0], pixelFormat.masks[1], pixelFormat.masks[2], pixelFormat.masks[3] })
+			appendUInt32(bytes, value);
+
+		for (const uint32_t value : { 0x1000u, header.caps2, 0u, 0u, 0u })
+			appendUInt32(bytes, value);
+		return bytes;
+	}
+
+	std::vector<uint8_t> createDX10Header(const Header& header, uint32_t dxgiFormat, uint32_t arraySize = 1, uint32_t miscFlag = 0)
+	{
+		Header dx10Header = header;
+		dx10Header.pixelFormat = fourCCFormat("DX10");
+		std::vector<uint8_t> bytes = createHeader(dx10Header);
+		for (const uint32_t value : { dxgiFormat, D3D11_RESOURCE_DIMENSION_TEXTURE2D, miscFlag, arraySize, 0u })
+			appendUInt32(bytes, value);
+		return bytes;
+	}
+
+	size_t computeSurfaceSize(uint32_t width, uint32_t height, uint32_t depth, uint32_t texelOrBlockSize, bool isCompressed)
+	{
+		if (isCompressed)
+			return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * depth * texelOrBlockSize;
+		return static_cast<size_t>(width) * height * depth * texelOrBlockSize;
+	}
+
+	// Each byte tells the face and mip level it belongs to and its position, faces of all layers are counted together
+	uint8_t getExpectedByte(uint32_t faceIdx, uint32_t mipLevel, size_t byteIdx)
+	{
+		return static_cast<uint8_t>((faceIdx * 31 + mipLevel * 7 + byteIdx) & 0xff);
+	}
+
+	std::vector<uint8_t> createPayload(uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevelCount, uint32_t texelOrBlockSize, bool isCompressed, uint32_t faceCount = 1)
+	{
+		std::vector<uint8_t> bytes;
+		for (uint32_t faceIdx = 0; faceIdx < faceCount; ++faceIdx)
+		{
+			for (uint32_t mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel)
+			{
+				const size_t surfaceSize = computeSurfaceSize(std::max(width >> mipLevel, 1u), std::max(height >> mipLevel, 1u), std::max(depth >> mipLevel, 1u), texelOrBlockSize, isCompressed);
+				for (size_t byteIdx = 0; byteIdx < surfaceSize; ++byteIdx)
+					bytes.push_back(getExpectedByte(faceIdx, mipLevel, byteIdx));
+			}
+		}
+		return bytes;
+	}
+
+	std::vector<uint8_t> concatenate(std::vector<uint8_t> first, const std::vector<uint8_t>& second)
+	{
+		first.insert(first.end(), second.begin(), second.end());
+		return first;
+	}
+
+	std::string writeFile(const std::string& name, const std::vector<uint8_t>& bytes)
+	{
+		const std::string filepath = "DDSFileTests_" + name + ".dds";
+		std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		return filepath;
+	}
+}
+
+WOLF_TEST(ReadsFormatsAndLayouts)
+{
+	struct Expectation
+	{
+		const char* name;
+		std::vector<uint8_t> bytes;
+		Wolf::Format format;
+		Wolf::Extent3D extent;
+		uint32_t mipLevelCount;
+		uint32_t arrayLayerCount;
+		uint32_t faceCount;
+		uint32_t texelOrBlockSize;
+		bool isCompressed;
+	};
+
+	const Expectation expectations[] =
+	{
+		{ "dxt1", concatenate(createHeader({ 64, 64, 7, fourCCFormat("DXT1") }), createPayload(64, 64, 1, 7, 8, true)), Wolf::Format::BC1_RGB_SRGB_BLOCK, { 64, 64, 1 }, 7, 1, 1, 8, true },
+		{ "dxt3_npot", concatenate(createHeader({ 5, 3, 3, fourCCFormat("DXT3") }), createPayload(5, 3, 1, 3, 16, true)), Wolf::Format::BC2_SRGB_BLOCK, { 5, 3, 1 }, 3, 1, 1, 16, true },
+		{ "dxt5", concatenate(createHeader({ 32, 16, 6, fourCCFormat("DXT5") }), createPayload(32, 16, 1, 6, 16, true)), Wolf::Format::BC3_SRGB_BLOCK, { 32, 16, 1 }, 6, 1, 1, 16, true },
+		{ "ati2", concatenate(createHeader({ 16, 16, 1, fourCCFormat("ATI2") }), createPayload(16, 16, 1, 1, 16, true)), Wolf::Format::BC5_UNORM_BLOCK, { 16, 16, 1 }, 1, 1, 1, 16, true },
+		{ "rgba8", concatenate(createHeader({ 7, 9, 4, rgbaFormat(0x000000ff, 0x00ff0000) }), createPayload(7, 9, 1, 4, 4, false)), Wolf::Format::R8G8B8A8_UNORM, { 7, 9, 1 }, 4, 1, 1, 4, false },
+		// No mip count means a single level
+		{ "bgra8", concatenate(createHeader({ 8, 8, 0, rgbaFormat(0x00ff0000, 0x000000ff) }), createPayload(8, 8, 1, 1, 4, false)), Wolf::Format::B8G8R8A8_UNORM, { 8, 8, 1 }, 1, 1, 1, 4, false },
+		{ "rgba16f", concatenate(createHeader({ 4, 4, 3, fourCCFormat(D3DFMT_A16B16G16R16F) }), createPayload(4, 4, 1, 3, 8, false)), Wolf::Format::R16G16B16A16_SFLOAT, { 4, 4, 1 }, 3, 1, 1, 8, false },
+		{ "cube", concatenate(createHeader({ 16, 16, 5, fourCCFormat("DXT1"), DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_ALL_FACES }), createPayload(16, 16, 1, 5, 8, true, 6)),
+			Wolf::Format::BC1_RGB_SRGB_BLOCK, { 16, 16, 1 }, 5, 1, 6, 8, true },
+		{ "volume", concatenate(createHeader({ 8, 8, 4, rgbaFormat(0x000000ff, 0x00ff0000), DDSCAPS2_VOLUME, 4, DDSD_REQUIRED | DDSD_DEPTH }), createPayload(8, 8, 4, 4, 4, false)),
+			Wolf::Format::R8G8B8A8_UNORM, { 8, 8, 4 }, 4, 1, 1, 4, false },
+		{ "dx10_bc7_array", concatenate(createDX10Header({ 32, 32, 6 }, DXGI_FORMAT_BC7_UNORM, 3), createPayload(32, 32, 1, 6, 16, true, 3)), Wolf::Format::BC7_UNORM_BLOCK, { 32, 32, 1 }, 6, 3, 1, 16, true },
+		{ "dx10_bc2_srgb", concatenate(createDX10Header({ 8, 8, 4 }, DXGI_FORMAT_BC2_UNORM_SRGB), createPayload(8, 8, 1, 4, 16, true)), Wolf::Format::BC2_SRGB_BLOCK, { 8, 8, 1 }, 4, 1, 1, 16, true },
+		{ "dx10_bc6h_cube_array", concatenate(createDX10Header({ 8, 8, 4 }, DXGI_FORMAT_BC6H_UF16, 2, D3D11_RESOURCE_MISC_TEXTURECUBE), createPayload(8, 8, 1, 4, 16, true, 12)),
+			Wolf::Format::BC6H_UFLOAT_BLOCK, { 8, 8, 1 }, 4, 2, 6, 16, true },
+		{ "dx10_rgba32f_npot", concatenate(createDX10Header({ 3, 5, 3 }, DXGI_FORMAT_R32G32B32A32_FLOAT), createPayload(3, 5, 1, 3, 16, false)), Wolf::Format::R32G32B32A32_SFLOAT, { 3, 5, 1 }, 3, 1, 1, 16, false },
+	};
+
+	for (const Expectation& expectation : expectations)
+	{
+		const Wolf::DDSFile file(writeFile(expectation.name, expectation.bytes));
+		WOLF_CHECK(file.isValid());
+		if (!file.isValid())
+			continue;
+
+		WOLF_CHECK_EQUAL(Wolf::formatToString(file.getFormat()), Wolf::formatToString(expectation.format));
+		WOLF_CHECK_EQUAL(file.getExtent().width, expectation.extent.width);
+		WOLF_CHECK_EQUAL(file.getExtent().height, expectation.extent.height);
+		WOLF_CHECK_EQUAL(file.getExtent().depth, expectation.extent.depth);
+		WOLF_CHECK_EQUAL(file.getMipLevelCount(), expectation.mipLevelCount);
+		WOLF_CHECK_EQUAL(file.getArrayLayerCount(), expectation.arrayLayerCount);
+		WOLF_CHECK_EQUAL(file.getFaceCount(), expectation.faceCount);
+		WOLF_CHECK_EQUAL(file.getCompression() != Wolf::ImageCompression::Compression::NO_COMPRESSION, expectation.isCompressed);
+
+		// Surfaces are contiguous views on the payload, which goes to the end of the file
+		const size_t headerSize = std::memcmp(expectation.bytes.data() + 84, "DX10", 4) == 0 ? 148 : 128;
+		const uint8_t* expectedSurfaceStart = file.getSurface(0).data();
+		for (uint32_t arrayLayer = 0; arrayLayer < expectation.arrayLayerCount; ++arrayLayer)
+		{
+			for (uint32_t face = 0; face < expectation.faceCount; ++face)
+			{
+				for (uint32_t mipLevel = 0; mipLevel < expectation.mipLevelCount; ++mipLevel)
+				{
+					const Wolf::Extent3D mipExtent = file.getMipExtent(mipLevel);
+					const std::span<const uint8_t> surface = file.getSurface(mipLevel, arrayLayer, face);
+					WOLF_CHECK(surface.data() == expectedSurfaceStart);
+					WOLF_CHECK_EQUAL(surface.size(), computeSurfaceSize(mipExtent.width, mipExtent.height, mipExtent.depth, expectation.texelOrBlockSize, expectation.isCompressed));
+
+					const uint32_t faceIdx = arrayLayer * expectation.faceCount + face;
+					bool hasExpectedBytes = true;
+					for (size_t byteIdx = 0; byteIdx < surface.size(); ++byteIdx)
+						hasExpectedBytes &= surface[byteIdx] == getExpectedByte(faceIdx, mipLevel, byteIdx);
+					WOLF_CHECK(hasExpectedBytes);
+					expectedSurfaceStart = surface.data() + surface.size();
+				}
+			}
+		}
+		WOLF_CHECK_EQUAL(static_cast<size_t>(expectedSurfaceStart - file.getSurface(0).data()), expectation.bytes.size() - headerSize);
+	}
+}
+
+WOLF_TEST(RejectsMalformedFiles)
+{
+	const std::vector<uint8_t> dxt1 = concatenate(createHeader({ 64, 64, 7, fourCCFormat("DXT1") }), createPayload(64, 64, 1, 7, 8, true));
+	std::vector<uint8_t> badMagic = dxt1;
+	badMagic[0] = 'X';
+
+	struct MalformedFile
+	{
+		const char* name;
+		std::vector<uint8_t> bytes;
+	};
+	const MalformedFile malformedFiles[] =
+	{
+		{ "empty", {} },
+		{ "bad_magic", badMagic },
+		{ "truncated_header", std::vector<uint8_t>(dxt1.begin(), dxt1.begin() + 60) },
+		{ "truncated", std::vector<uint8_t>(dxt1.begin(), dxt1.end() - 1) },
+		{ "bad_header_size", concatenate(createHeader({ 4, 4, 1, fourCCFormat("DXT1"), 0, 0, DDSD_REQUIRED, 100 }), createPayload(4, 4, 1, 1, 8, true)) },
+		{ "too_many_mips", concatenate(createHeader({ 4, 4, 5, fourCCFormat("DXT1") }), createPayload(4, 4, 1, 3, 8, true)) },
+		{ "unsupported_fourcc", concatenate(createHeader({ 4, 4, 1, fourCCFormat("ZZZZ") }), createPayload(4, 4, 1, 1, 8, true)) },
+		{ "unsupported_dx10_format", concatenate(createDX10Header({ 4, 4, 1 }, DXGI_FORMAT_R10G10B10A2_UNORM), createPayload(4, 4, 1, 1, 4, false)) },
+		{ "partial_cube", concatenate(createHeader({ 16, 16, 1, fourCCFormat("DXT1"), DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEX }), createPayload(16, 16, 1, 1, 8, true)) },
+		{ "zero_width", createHeader({ 0, 4, 1, fourCCFormat("DXT1") }) },
+		{ "huge_width", concatenate(createHeader({ 1u << 20, 4, 1, fourCCFormat("DXT1") }), createPayload(4, 4, 1, 1, 8, true)) },
+		{ "huge_array", concatenate(createDX10Header({ 4, 4, 1 }, DXGI_FORMAT_BC1_UNORM, 0xffffffff), createPayload(4, 4, 1, 1, 8, true)) },
+		{ "zero_array", concatenate(createDX10Header({ 4, 4, 1 }, DXGI_FORMAT_BC1_UNORM, 0), createPayload(4, 4, 1, 1, 8, true)) },
+	};
+
+	for (const MalformedFile& malformedFile : malformedFiles)
+	{
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		const Wolf::DDSFile file(writeFile(malformedFile.name, malformedFile.bytes));
+		WOLF_CHECK(!file.isValid());
+	}
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	const Wolf::DDSFile file("DDSFileTests_missing.dds");
+	WOLF_CHECK(!file.isValid());
+}
+
+WOLF_TEST(MissingSurfacesAreEmpty)
+{
+	const Wolf::DDSFile file(writeFile("surfaces", concatenate(createHeader({ 8, 8, 4, fourCCFormat("DXT5") }), createPayload(8, 8, 1, 4, 16, true))));
+	WOLF_CHECK(file.isValid());
+	WOLF_CHECK_EQUAL(file.getSurface(3).size(), 16u);
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(3);
+	WOLF_CHECK(file.getSurface(4).empty());
+	WOLF_CHECK(file.getSurface(0, 1).empty());
+	WOLF_CHECK(file.getSurface(0, 0, 1).empty());
+}
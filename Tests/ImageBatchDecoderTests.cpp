@@ -0,0 +1,295 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include "ImageBatchDecoder.h"
+#include "KTX2File.h"
+#include "TestFramework.h"
+
+namespace
+{
+	constexpr uint64_t KB = 1024;
+	constexpr uint64_t MB = 1024 * KB;
+
+	void writeDDS(const std::string& filepath, uint32_t size, uint32_t mipLevelCount)
+	{
+		// DX10 header with DXGI_FORMAT_BC7_UNORM
+		uint32_t header[37] = {};
+		header[0] = 0x20534444;
+		header[1] = 124;
+		header[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;
+		header[3] = size;
+		header[4] = size;
+		header[7] = mipLevelCount;
+		header[19] = 32;
+		header[20] = 0x4;
+		header[21] = 0x30315844;
+		header[27] = 0x1000;
+		header[32] = 98;
+		header[33] = 3;
+		header[35] = 1;
+
+		std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		for (uint32_t mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel)
+		{
+			const uint32_t blockCount = std::max((size >> mipLevel) / 4, 1u);
+			const std::vector<char> blocks(static_cast<size_t>(blockCount) * blockCount * 16, static_cast<char>(mipLevel));
+			file.write(blocks.data(), static_cast<std::streamsize>(blocks.size()));
+		}
+	}
+
+	// PNG, JPEG and HDR files of several sizes, 8 bits files loaded as float too, mapped DDS and KTX2 files and a .cube LUT
+	const std::vector<Wolf::ImageBatchDecoder::Request>& getCorpus()
+	{
+		static const std::vector<Wolf::ImageBatchDecoder::Request> corpus = []()
+		{
+			std::vector<Wolf::ImageBatchDecoder::Request> requests;
+			for (uint32_t imageIdx = 0; imageIdx < 12; ++imageIdx)
+			{
+				const uint32_t width = 128 + 64 * (imageIdx % 4), height = 96 + 32 * (imageIdx % 3);
+				std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+				for (uint32_t y = 0; y < height; ++y)
+				{
+					for (uint32_t x = 0; x < width; ++x)
+					{
+						uint8_t* pixel = &pixels[(x + static_cast<size_t>(y) * width) * 3];
+						pixel[0] = static_cast<uint8_t>(x ^ y);
+						pixel[1] = static_cast<uint8_t>((x * y) >> 4);
+						pixel[2] = static_cast<uint8_t>(imageIdx * 20);
+					}
+				}
+
+				const std::string filepath = "ImageBatchDecoderTests_" + std::to_string(imageIdx) + (imageIdx % 2 ? ".png" : ".jpg");
+				if (imageIdx % 2)
+					stbi_write_png(filepath.c_str(), static_cast<int>(width), static_cast<int>(height), 3, pixels.data(), static_cast<int>(width) * 3);
+				else
+					stbi_write_jpg(filepath.c_str(), static_cast<int>(width), static_cast<int>(height), 3, pixels.data(), 90);
+				requests.push_back({ filepath });
+				if (imageIdx % 4 == 0)
+					requests.push_back({ filepath, true });
+			}
+
+			for (uint32_t imageIdx = 0; imageIdx < 2; ++imageIdx)
+			{
+				constexpr uint32_t WIDTH = 256, HEIGHT = 128;
+				std::vector<float> pixels(static_cast<size_t>(WIDTH) * HEIGHT * 3);
+				for (size_t valueIdx = 0; valueIdx < pixels.size(); ++valueIdx)
+					pixels[valueIdx] = std::sin(static_cast<float>(valueIdx) * 0.001f) * 10.0f + 10.0f + static_cast<float>(imageIdx);
+
+				const std::string filepath = "ImageBatchDecoderTests_env" + std::to_string(imageIdx) + ".hdr";
+				stbi_write_hdr(filepath.c_str(), WIDTH, HEIGHT, 3, pixels.data());
+				requests.push_back({ filepath });
+			}
+
+			writeDDS("ImageBatchDecoderTests.dds", 512, 10);
+			requests.push_back({ "ImageBatchDecoderTests.dds" });
+
+			std::vector<std::vector<uint8_t>> levels;
+			Wolf::KTX2File::WriteInfo writeInfo;
+			writeInfo.format = Wolf::Format::BC1_RGB_SRGB_BLOCK;
+			writeInfo.extent = { 256, 256, 1 };
+			for (uint32_t mipLevel = 0; mipLevel < 9; ++mipLevel)
+			{
+				const uint32_t blockCount = std::max((256u >> mipLevel) / 4, 1u);
+				levels.emplace_back(static_cast<size_t>(blockCount) * blockCount * 8, static_cast<uint8_t>(mipLevel));
+				writeInfo.addLevel(levels.back());
+			}
+			Wolf::KTX2File::write("ImageBatchDecoderTests.ktx2", writeInfo);
+			requests.push_back({ "ImageBatchDecoderTests.ktx2" });
+
+			std::ofstream lutFile("ImageBatchDecoderTests.cube", std::ios::trunc);
+			lutFile << "TITLE \"test\"\nLUT_3D_SIZE 8\n";
+			for (uint32_t b = 0; b < 8; ++b)
+				for (uint32_t g = 0; g < 8; ++g)
+					for (uint32_t r = 0; r < 8; ++r)
+						lutFile << r / 7.0f << " " << g / 7.0f << " " << b / 7.0f << "\n";
+			lutFile.close();
+			requests.push_back({ "ImageBatchDecoderTests.cube", false, true });
+
+			return requests;
+		}();
+		return corpus;
+	}
+
+	// Decoded bytes of an image loaded by the calling thread, mapped files are compared through their first level
+	bool isSameAsSequentialLoading(const Wolf::ImageBatchDecoder::Request& request, const Wolf::ImageBatchDecoder::DecodedImage& image)
+	{
+		const Wolf::ImageFileLoader reference(request.m_path, request.m_loadFloat, request.m_useBinaryCache);
+		if (!image.isValid() || !reference.getPixels())
+			return image.isValid() == (reference.getPixels() != nullptr);
+
+		const Wolf::ImageFileLoader& loader = image.getLoader();
+		if (loader.getWidth() != reference.getWidth() || loader.getHeight() != reference.getHeight() || loader.getDepth() != reference.getDepth() || loader.getFormat() != reference.getFormat())
+			return false;
+
+		if (reference.getDDSFile() || reference.getKTX2File())
+		{
+			const std::span<const uint8_t> referenceLevel = reference.getMipPixels(0);
+			return loader.getMipPixels(0).size() == referenceLevel.size() && std::memcmp(loader.getMipPixels(0).data(), referenceLevel.data(), referenceLevel.size()) == 0;
+		}
+		return std::memcmp(loader.getPixels(), reference.getPixels(), image.getByteCount()) == 0;
+	}
+
+	class MaxValue
+	{
+	public:
+		void update(uint64_t value)
+		{
+			uint64_t maxValue = m_maxValue.load();
+			while (value > maxValue && !m_maxValue.compare_exchange_weak(maxValue, value)) {}
+		}
+		[[nodiscard]] uint64_t get() const { return m_maxValue.load(); }
+
+	private:
+		std::atomic<uint64_t> m_maxValue = 0;
+	};
+}
+
+WOLF_TEST(EstimatesMatchDecodedSizes)
+{
+	for (const Wolf::ImageBatchDecoder::Request& request : getCorpus())
+	{
+		const Wolf::ImageFileLoader loader(request.m_path, request.m_loadFloat, request.m_useBinaryCache);
+		WOLF_CHECK(loader.getPixels() != nullptr);
+
+		const uint64_t estimatedByteCount = Wolf::ImageFileLoader::estimateByteCount(request.m_path, request.m_loadFloat);
+		if (loader.getDDSFile() || loader.getKTX2File() || request.m_path.ends_with(".cube"))
+		{
+			WOLF_CHECK_EQUAL(estimatedByteCount, static_cast<uint64_t>(std::filesystem::file_size(request.m_path)));
+			continue;
+		}
+
+		const uint64_t texelSize = request.m_loadFloat || request.m_path.ends_with(".hdr") ? 16 : 4;
+		WOLF_CHECK_EQUAL(estimatedByteCount, static_cast<uint64_t>(loader.getWidth()) * loader.getHeight() * texelSize);
+	}
+}
+
+WOLF_TEST(CallbacksMatchSequentialLoading)
+{
+	const std::vector<Wolf::ImageBatchDecoder::Request>& corpus = getCorpus();
+	for (const uint32_t streamingThreadCount : { 1u, 4u })
+	{
+		Wolf::JobsManager jobsManager(0, streamingThreadCount);
+
+		// Below the largest image, a few images and no limit
+		for (const uint64_t maxInFlightByteCount : { 256 * KB, 2 * MB, 1024 * MB })
+		{
+			Wolf::ImageBatchDecoder decoder(Wolf::ResourceNonOwner<Wolf::JobsManager>(&jobsManager), maxInFlightByteCount);
+
+			MaxValue maxInFlightByteCountSeen;
+			std::atomic<uint32_t> overCapCount = 0;
+			std::vector<uint8_t> deliveryCounts(corpus.size());
+			std::vector<uint8_t> isSame(corpus.size());
+			decoder.decode(corpus, [&](uint32_t requestIdx, Wolf::ImageBatchDecoder::DecodedImage&& image)
+			{
+				// Only an image larger than the cap can be in flight above it, and then alone
+				const uint64_t inFlightByteCount = decoder.getInFlightByteCount();
+				maxInFlightByteCountSeen.update(inFlightByteCount);
+				if (inFlightByteCount > maxInFlightByteCount && inFlightByteCount != image.getByteCount())
+					++overCapCount;
+
+				deliveryCounts[requestIdx]++;
+				isSame[requestIdx] = isSameAsSequentialLoading(corpus[requestIdx], image);
+			});
+			decoder.waitIdle();
+
+			WOLF_CHECK_EQUAL(overCapCount.load(), 0u);
+			WOLF_CHECK(maxInFlightByteCountSeen.get() > 0);
+			WOLF_CHECK_EQUAL(decoder.getInFlightByteCount(), 0u);
+			WOLF_CHECK_EQUAL(decoder.getPendingRequestCount(), 0u);
+			for (size_t requestIdx = 0; requestIdx < corpus.size(); ++requestIdx)
+			{
+				WOLF_CHECK_EQUAL(deliveryCounts[requestIdx], 1u);
+				WOLF_CHECK(isSame[requestIdx]);
+			}
+		}
+	}
+}
+
+WOLF_TEST(FuturesMatchSequentialLoading)
+{
+	const std::vector<Wolf::ImageBatchDecoder::Request>& corpus = getCorpus();
+	Wolf::JobsManager jobsManager(0, 4);
+	Wolf::ImageBatchDecoder decoder(Wolf::ResourceNonOwner<Wolf::JobsManager>(&jobsManager), 2 * MB);
+
+	// Images are released in order by the consumer, waiting requests start meanwhile
+	std::vector<std::future<Wolf::ImageBatchDecoder::DecodedImage>> futures = decoder.decode(corpus);
+	WOLF_CHECK_EQUAL(futures.size(), corpus.size());
+	for (size_t requestIdx = 0; requestIdx < futures.size(); ++requestIdx)
+	{
+		Wolf::ImageBatchDecoder::DecodedImage image = futures[requestIdx].get();
+		WOLF_CHECK(image.isValid());
+		WOLF_CHECK(image.getByteCount() <= decoder.getInFlightByteCount());
+		WOLF_CHECK(isSameAsSequentialLoading(corpus[requestIdx], image));
+	}
+
+	decoder.waitIdle();
+	WOLF_CHECK_EQUAL(decoder.getInFlightByteCount(), 0u);
+}
+
+WOLF_TEST(HeldImagesBlockNextRequests)
+{
+	const std::vector<Wolf::ImageBatchDecoder::Request>& corpus = getCorpus();
+	Wolf::JobsManager jobsManager(0, 2);
+	Wolf::ImageBatchDecoder decoder(Wolf::ResourceNonOwner<Wolf::JobsManager>(&jobsManager), 1);
+
+	const Wolf::ImageBatchDecoder::Request requests[] = { corpus[0], corpus[1] };
+	std::vector<std::future<Wolf::ImageBatchDecoder::DecodedImage>> futures = decoder.decode(requests);
+	Wolf::ImageBatchDecoder::DecodedImage firstImage = futures[0].get();
+	WOLF_CHECK_EQUAL(decoder.getInFlightByteCount(), firstImage.getByteCount());
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	WOLF_CHECK(futures[1].wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+	WOLF_CHECK_EQUAL(decoder.getPendingRequestCount(), 1u);
+
+	firstImage.release();
+	WOLF_CHECK(futures[1].get().isValid());
+	decoder.waitIdle();
+	WOLF_CHECK_EQUAL(decoder.getInFlightByteCount(), 0u);
+}
+
+WOLF_TEST(FullStreamingQueueDecodesOnCallingThread)
+{
+	const std::vector<Wolf::ImageBatchDecoder::Request>& corpus = getCorpus();
+	Wolf::JobsManager jobsManager(0, 1, 1);
+	Wolf::ImageBatchDecoder decoder(Wolf::ResourceNonOwner<Wolf::JobsManager>(&jobsManager), 1024 * MB);
+
+	std::atomic<uint32_t> callingThreadDecodeCount = 0;
+	const std::thread::id callingThreadId = std::this_thread::get_id();
+	std::vector<uint8_t> isSame(corpus.size());
+	decoder.decode(corpus, [&](uint32_t requestIdx, Wolf::ImageBatchDecoder::DecodedImage&& image)
+	{
+		if (std::this_thread::get_id() == callingThreadId)
+			++callingThreadDecodeCount;
+		isSame[requestIdx] = isSameAsSequentialLoading(corpus[requestIdx], image);
+	});
+	decoder.waitIdle();
+
+	WOLF_CHECK(callingThreadDecodeCount > 0);
+	for (const uint8_t isRequestSame : isSame)
+		WOLF_CHECK(isRequestSame);
+}
+
+WOLF_TEST(MissingFilesAreDeliveredInvalid)
+{
+	Wolf::JobsManager jobsManager(0, 2);
+	Wolf::ImageBatchDecoder decoder{ Wolf::ResourceNonOwner<Wolf::JobsManager>(&jobsManager) };
+
+	const Wolf::ImageBatchDecoder::Request requests[] = { { "ImageBatchDecoderTests_missing.png" }, getCorpus()[0] };
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	std::vector<std::future<Wolf::ImageBatchDecoder::DecodedImage>> futures = decoder.decode(requests);
+	WOLF_CHECK(!futures[0].get().isValid());
+	WOLF_CHECK(futures[1].get().isValid());
+	decoder.waitIdle();
+	WOLF_CHECK_EQUAL(decoder.getInFlightByteCount(), 0u);
+}
@@ -0,0 +1,296 @@
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "ImageCompression.h"
+#include "JobsManager.h"
+#include "TestFramework.h"
+
+using RGBA8 = Wolf::ImageCompression::RGBA8;
+
+namespace
+{
+	enum class SyntheticImage
+	{
+		GRADIENT,
+		NOISE,
+		NORMAL_MAP
+	};
+
+	std::vector<RGBA8> createImage(SyntheticImage type, uint32_t width, uint32_t height)
+	{
+		std::mt19937 randomEngine(3);
+		std::uniform_int_distribution<uint32_t> distribution(0, 255);
+
+		std::vector<RGBA8> pixels(static_cast<size_t>(width) * height);
+		for (uint32_t y = 0; y < height; ++y)
+		{
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				RGBA8& pixel = pixels[x + static_cast<size_t>(y) * width];
+				switch (type)
+				{
+					case SyntheticImage::GRADIENT:
+						pixel = RGBA8(static_cast<uint8_t>(x * 255 / (width - 1)), static_cast<uint8_t>(y * 255 / (height - 1)), static_cast<uint8_t>((x + y) * 127 / (width + height)),
+							static_cast<uint8_t>(255 - x * 255 / (width - 1)));
+						break;
+					case SyntheticImage::NOISE:
+						pixel = RGBA8(static_cast<uint8_t>(distribution(randomEngine)), static_cast<uint8_t>(distribution(randomEngine)), static_cast<uint8_t>(distribution(randomEngine)),
+							static_cast<uint8_t>(distribution(randomEngine)));
+						break;
+					case SyntheticImage::NORMAL_MAP:
+					{
+						// Bumps of a tangent space normal map, blue stays close to 255
+						const float dx = std::sin(static_cast<float>(x) * 0.3f) * 0.5f;
+						const float dy = std::cos(static_cast<float>(y) * 0.2f) * 0.5f;
+						const float length = std::sqrt(dx * dx + dy * dy + 1.0f);
+						pixel = RGBA8(static_cast<uint8_t>((dx / length * 0.5f + 0.5f) * 255.0f), static_cast<uint8_t>((dy / length * 0.5f + 0.5f) * 255.0f),
+							static_cast<uint8_t>((1.0f / length * 0.5f + 0.5f) * 255.0f), 255);
+						break;
+					}
+				}
+			}
+		}
+		return pixels;
+	}
+
+	double computePSNR(const std::vector<RGBA8>& reference, const std::vector<RGBA8>& pixels, bool includeAlpha)
+	{
+		const uint32_t channelCount = includeAlpha ? 4 : 3;
+		double squaredErrorSum = 0.0;
+		for (size_t pixelIdx = 0; pixelIdx < reference.size(); ++pixelIdx)
+		{
+			for (uint32_t channelIdx = 0; channelIdx < channelCount; ++channelIdx)
+			{
+				const double error = static_cast<double>(reference[pixelIdx][channelIdx]) - static_cast<double>(pixels[pixelIdx][channelIdx]);
+				squaredErrorSum += error * error;
+			}
+		}
+
+		const double meanSquaredError = squaredErrorSum / (static_cast<double>(reference.size()) * channelCount);
+		return meanSquaredError == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+	}
+
+	template <typename BlockType>
+	std::vector<RGBA8> compressAndDecode(const std::vector<RGBA8>& pixels, uint32_t width, uint32_t height, Wolf::ImageCompression::Quality quality, std::vector<BlockType>& outBlocks)
+	{
+		Wolf::ImageCompression::compress(Wolf::Extent3D{ width, height, 1 }, pixels, outBlocks, quality);
+
+		std::vector<RGBA8> decodedPixels;
+		const Wolf::ImageCompression::Compression compression = std::is_same_v<BlockType, Wolf::ImageCompression::BC1> ? Wolf::ImageCompression::Compression::BC1 : Wolf::ImageCompression::Compression::BC3;
+		Wolf::ImageCompression::uncompressImage(compression, reinterpret_cast<const unsigned char*>(outBlocks.data()), Wolf::Extent2D{ width, height }, decodedPixels);
+		return decodedPixels;
+	}
+
+	// Restores the instruction set selected at startup
+	class InstructionSetScope
+	{
+	public:
+		InstructionSetScope() : m_instructionSet(Wolf::ImageCompression::getInstructionSet()) {}
+		~InstructionSetScope() { Wolf::ImageCompression::setInstructionSet(m_instructionSet); }
+
+	private:
+		Wolf::ImageCompression::InstructionSet m_instructionSet;
+	};
+}
+
+WOLF_TEST(InstructionSetsGiveSameBlocks)
+{
+	InstructionSetScope instructionSetScope;
+	if (!Wolf::ImageCompression::setInstructionSet(Wolf::ImageCompression::InstructionSet::AVX2))
+		return;
+
+	// 37 blocks per row: pairs and a last single block, the 2x2 checker puts single color blocks next to the others
+	constexpr uint32_t WIDTH = 148, HEIGHT = 64;
+	for (const SyntheticImage type : { SyntheticImage::GRADIENT, SyntheticImage::NOISE, SyntheticImage::NORMAL_MAP })
+	{
+		std::vector<RGBA8> pixels = createImage(type, WIDTH, HEIGHT);
+		for (uint32_t y = 0; y < HEIGHT; ++y)
+			for (uint32_t x = 0; x < WIDTH; ++x)
+				if ((x / 8 + y / 8) % 2 == 0 && x % 8 < 4)
+					pixels[x + y * WIDTH] = RGBA8(10, 200, 30, static_cast<uint8_t>(x));
+
+		for (const Wolf::ImageCompression::Quality quality : { Wolf::ImageCompression::Quality::FAST, Wolf::ImageCompression::Quality::HIGH })
+		{
+			std::vector<Wolf::ImageCompression::BC1> bc1Blocks[2];
+			std::vector<Wolf::ImageCompression::BC3> bc3Blocks[2];
+			for (const Wolf::ImageCompression::InstructionSet instructionSet : { Wolf::ImageCompression::InstructionSet::BASELINE, Wolf::ImageCompression::InstructionSet::AVX2 })
+			{
+				const uint32_t resultIdx = instructionSet == Wolf::ImageCompression::InstructionSet::AVX2 ? 1 : 0;
+				WOLF_CHECK(Wolf::ImageCompression::setInstructionSet(instructionSet));
+				Wolf::ImageCompression::compress(Wolf::Extent3D{ WIDTH, HEIGHT, 1 }, pixels, bc1Blocks[resultIdx], quality);
+				Wolf::ImageCompression::compress(Wolf::Extent3D{ WIDTH, HEIGHT, 1 }, pixels, bc3Blocks[resultIdx], quality);
+			}
+
+			WOLF_CHECK(std::memcmp(bc1Blocks[0].data(), bc1Blocks[1].data(), bc1Blocks[0].size() * sizeof(Wolf::ImageCompression::BC1)) == 0);
+			WOLF_CHECK(std::memcmp(bc3Blocks[0].data(), bc3Blocks[1].data(), bc3Blocks[0].size() * sizeof(Wolf::ImageCompression::BC3)) == 0);
+		}
+	}
+}
+
+WOLF_TEST(QualityOnSyntheticImages)
+{
+	constexpr uint32_t WIDTH = 128, HEIGHT = 128;
+
+	struct Expectation
+	{
+		SyntheticImage type;
+		double minFastPSNR;
+		double minHighPSNR;
+	};
+	const Expectation expectations[] = { { SyntheticImage::GRADIENT, 41.0, 41.5 }, { SyntheticImage::NOISE, 12.0, 13.0 }, { SyntheticImage::NORMAL_MAP, 31.5, 33.5 } };
+
+	for (const Expectation& expectation : expectations)
+	{
+		const std::vector<RGBA8> pixels = createImage(expectation.type, WIDTH, HEIGHT);
+
+		std::vector<Wolf::ImageCompression::BC1> bc1Blocks;
+		const double fastPSNR = computePSNR(pixels, compressAndDecode(pixels, WIDTH, HEIGHT, Wolf::ImageCompression::Quality::FAST, bc1Blocks), false);
+		const double highPSNR = computePSNR(pixels, compressAndDecode(pixels, WIDTH, HEIGHT, Wolf::ImageCompression::Quality::HIGH, bc1Blocks), false);
+		WOLF_CHECK(fastPSNR >= expectation.minFastPSNR);
+		WOLF_CHECK(highPSNR >= expectation.minHighPSNR);
+		WOLF_CHECK(highPSNR >= fastPSNR);
+
+		// BC3 colors are the BC1 ones, alpha is interpolated on 8 steps
+		std::vector<Wolf::ImageCompression::BC3> bc3Blocks;
+		const std::vector<RGBA8> bc3Pixels = compressAndDecode(pixels, WIDTH, HEIGHT, Wolf::ImageCompression::Quality::FAST, bc3Blocks);
+		WOLF_CHECK_EQUAL(computePSNR(pixels, bc3Pixels, false), fastPSNR);
+		WOLF_CHECK(computePSNR(pixels, bc3Pixels, true) >= expectation.minFastPSNR);
+	}
+}
+
+WOLF_TEST(SingleColorBlocks)
+{
+	constexpr uint32_t WIDTH = 16, HEIGHT = 16;
+
+	std::mt19937 randomEngine(5);
+	std::uniform_int_distribution<uint32_t> distribution(0, 255);
+	for (uint32_t colorIdx = 0; colorIdx < 256; ++colorIdx)
+	{
+		const RGBA8 color(static_cast<uint8_t>(colorIdx), static_cast<uint8_t>(distribution(randomEngine)), static_cast<uint8_t>(255 - colorIdx), 255);
+		const std::vector<RGBA8> pixels(static_cast<size_t>(WIDTH) * HEIGHT, color);
+
+		std::vector<Wolf::ImageCompression::BC1> blocks;
+		const std::vector<RGBA8> decodedPixels = compressAndDecode(pixels, WIDTH, HEIGHT, Wolf::ImageCompression::Quality::FAST, blocks);
+
+		// Interpolated color of the closest endpoints, the decoder truncates it so it can be 2 values away
+		for (const RGBA8& decodedPixel : decodedPixels)
+		{
+			for (uint32_t channelIdx = 0; channelIdx < 3; ++channelIdx)
+				WOLF_CHECK(std::abs(static_cast<int32_t>(decodedPixel[channelIdx]) - static_cast<int32_t>(color[channelIdx])) <= 2);
+		}
+	}
+
+	// Colors of the 565 grid are exact
+	const std::vector<RGBA8> pixels(static_cast<size_t>(WIDTH) * HEIGHT, RGBA8(255, 0, 255, 255));
+	std::vector<Wolf::ImageCompression::BC1> blocks;
+	WOLF_CHECK_EQUAL(computePSNR(pixels, compressAndDecode(pixels, WIDTH, HEIGHT, Wolf::ImageCompression::Quality::HIGH, blocks), true), 100.0);
+}
+
+WOLF_TEST(ColorBlocksUseTheFourColorsMode)
+{
+	constexpr uint32_t WIDTH = 36, HEIGHT = 20;
+
+	for (const Wolf::ImageCompression::Quality quality : { Wolf::ImageCompression::Quality::FAST, Wolf::ImageCompression::Quality::HIGH })
+	{
+		std::vector<Wolf::ImageCompression::BC1> blocks;
+		compressAndDecode(createImage(SyntheticImage::NOISE, WIDTH, HEIGHT), WIDTH, HEIGHT, quality, blocks);
+
+		WOLF_CHECK_EQUAL(blocks.size(), static_cast<size_t>(WIDTH / 4) * (HEIGHT / 4));
+		for (const Wolf::ImageCompression::BC1& block : blocks)
+			WOLF_CHECK(block.rgb[0] > block.rgb[1] || block.bitmap == 0);
+	}
+}
+
+WOLF_TEST(TiledCompressionIsDeterministic)
+{
+	// 33 block rows so the last tile is partial whatever the tile size
+	constexpr uint32_t WIDTH = 96, HEIGHT = 132;
+	const Wolf::Extent3D extent{ WIDTH, HEIGHT, 1 };
+	const std::vector<RGBA8> pixels = createImage(SyntheticImage::NOISE, WIDTH, HEIGHT);
+	std::vector<Wolf::ImageCompression::RG32F> normals(pixels.size());
+	for (size_t pixelIdx = 0; pixelIdx < pixels.size(); ++pixelIdx)
+		normals[pixelIdx] = Wolf::ImageCompression::RG32F(static_cast<float>(pixels[pixelIdx].r) / 127.5f - 1.0f, static_cast<float>(pixels[pixelIdx].g) / 127.5f - 1.0f);
+
+	// References are compressed by the calling thread alone
+	std::vector<Wolf::ImageCompression::BC1> bc1Reference;
+	std::vector<Wolf::ImageCompression::BC3> bc3Reference;
+	std::vector<Wolf::ImageCompression::BC5> bc5Reference;
+	std::vector<Wolf::ImageCompression::BC7> bc7Reference;
+	Wolf::ImageCompression::compress(extent, pixels, bc1Reference);
+	Wolf::ImageCompression::compress(extent, pixels, bc3Reference);
+	Wolf::ImageCompression::compressBC5(extent, normals, bc5Reference);
+	Wolf::ImageCompression::compress(extent, pixels, bc7Reference);
+
+	for (const uint32_t workerCount : { 1u, 3u })
+	{
+		Wolf::JobsManager jobsManager(workerCount);
+		for (const uint32_t blockRowCountPerTile : { 1u, 4u, 64u })
+		{
+			Wolf::ImageCompression::TiledCompressionInfo info;
+			info.blockRowCountPerTile = blockRowCountPerTile;
+
+			std::vector<Wolf::ImageCompression::BC1> bc1Blocks;
+			std::vector<Wolf::ImageCompression::BC3> bc3Blocks;
+			std::vector<Wolf::ImageCompression::BC5> bc5Blocks;
+			std::vector<Wolf::ImageCompression::BC7> bc7Blocks;
+			WOLF_CHECK(Wolf::ImageCompression::compressTiled(extent, pixels, bc1Blocks, info));
+			WOLF_CHECK(Wolf::ImageCompression::compressTiled(extent, pixels, bc3Blocks, info));
+			WOLF_CHECK(Wolf::ImageCompression::compressTiled(extent, normals, bc5Blocks, info));
+			WOLF_CHECK(Wolf::ImageCompression::compressTiled(extent, pixels, bc7Blocks, info));
+
+			WOLF_CHECK(bc1Blocks.size() == bc1Reference.size() && std::memcmp(bc1Blocks.data(), bc1Reference.data(), bc1Reference.size() * sizeof(Wolf::ImageCompression::BC1)) == 0);
+			WOLF_CHECK(bc3Blocks.size() == bc3Reference.size() && std::memcmp(bc3Blocks.data(), bc3Reference.data(), bc3Reference.size() * sizeof(Wolf::ImageCompression::BC3)) == 0);
+			WOLF_CHECK(bc5Blocks.size() == bc5Reference.size() && std::memcmp(bc5Blocks.data(), bc5Reference.data(), bc5Reference.size() * sizeof(Wolf::ImageCompression::BC5)) == 0);
+			WOLF_CHECK(bc7Blocks.size() == bc7Reference.size() && std::memcmp(bc7Blocks.data(), bc7Reference.data(), bc7Reference.size() * sizeof(Wolf::ImageCompression::BC7)) == 0);
+		}
+	}
+}
+
+WOLF_TEST(TiledCompressionProgressAndCancellation)
+{
+	constexpr uint32_t WIDTH = 64, HEIGHT = 256, BLOCK_ROW_COUNT = HEIGHT / 4;
+	const Wolf::Extent3D extent{ WIDTH, HEIGHT, 1 };
+	const std::vector<RGBA8> pixels = createImage(SyntheticImage::GRADIENT, WIDTH, HEIGHT);
+	Wolf::JobsManager jobsManager(3);
+
+	std::atomic<bool> cancelRequested = false;
+	uint32_t lastCompressedBlockRowCount = 0, callCount = 0;
+	bool isIncreasing = true;
+	Wolf::ImageCompression::TiledCompressionInfo info;
+	info.blockRowCountPerTile = 2;
+	info.cancelRequested = &cancelRequested;
+	info.progressCallback = [&](uint32_t compressedBlockRowCount, uint32_t blockRowCount)
+	{
+		isIncreasing &= compressedBlockRowCount > lastCompressedBlockRowCount && blockRowCount == BLOCK_ROW_COUNT;
+		lastCompressedBlockRowCount = compressedBlockRowCount;
+		++callCount;
+	};
+
+	std::vector<Wolf::ImageCompression::BC7> blocks;
+	WOLF_CHECK(Wolf::ImageCompression::compressTiled(extent, pixels, blocks, info));
+	WOLF_CHECK(isIncreasing);
+	WOLF_CHECK_EQUAL(lastCompressedBlockRowCount, BLOCK_ROW_COUNT);
+	WOLF_CHECK_EQUAL(callCount, BLOCK_ROW_COUNT / 2);
+
+	// Requested from the progress callback, tiles already started are completed but no other one starts
+	lastCompressedBlockRowCount = 0;
+	callCount = 0;
+	info.progressCallback = [&](uint32_t compressedBlockRowCount, uint32_t)
+	{
+		lastCompressedBlockRowCount = compressedBlockRowCount;
+		++callCount;
+		if (compressedBlockRowCount >= BLOCK_ROW_COUNT / 4)
+			cancelRequested = true;
+	};
+	WOLF_CHECK(!Wolf::ImageCompression::compressTiled(extent, pixels, blocks, info));
+	WOLF_CHECK(lastCompressedBlockRowCount >= BLOCK_ROW_COUNT / 4);
+	WOLF_CHECK(lastCompressedBlockRowCount <= BLOCK_ROW_COUNT / 4 + 2 * jobsManager.getParallelThreadCount());
+
+	// Cancelled before the first tile
+	callCount = 0;
+	WOLF_CHECK(!Wolf::ImageCompression::compressTiled(extent, pixels, blocks, info));
+	WOLF_CHECK_EQUAL(callCount, 0u);
+}
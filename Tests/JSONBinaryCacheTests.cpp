@@ -0,0 +1,181 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "JSONReader.h"
+#include "TestFramework.h"
+
+namespace
+{
+	void writeDocument(const std::string& filename, float value)
+	{
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+		file << "{ \"s\": \"h\\u00e9\", \"o\": { \"x\": " << value << " }, \"fa\": [1.5, -2], \"sa\": [\"a\", \"b\"], \"oa\": [{ \"k\": true }, { \"k\": false }], \"t\": true, \"e\": [] }";
+	}
+
+	void checkDocument(Wolf::JSONReader& reader, float expectedValue)
+	{
+		Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+		WOLF_CHECK_EQUAL(root->getPropertyCount(), 7u);
+		WOLF_CHECK_EQUAL(root->getPropertyString(0u), std::string("s"));
+		WOLF_CHECK_EQUAL(root->getPropertyString("s"), std::string("h\xC3\xA9"));
+		WOLF_CHECK_EQUAL(root->getPropertyObject("o")->getPropertyFloat("x"), expectedValue);
+		WOLF_CHECK(root->getPropertyFloatArray("fa") == std::vector<float>({ 1.5f, -2.0f }));
+		WOLF_CHECK(root->getPropertyStringArray("sa") == std::vector<std::string>({ "a", "b" }));
+		WOLF_CHECK_EQUAL(root->getArraySize("oa"), 2u);
+		WOLF_CHECK(!root->getArrayObjectItem("oa", 1)->getPropertyBool("k"));
+		WOLF_CHECK(root->getPropertyBool("t"));
+		WOLF_CHECK(root->getPropertyFloatArray("e").empty());
+	}
+}
+
+WOLF_TEST(CacheIsCreatedThenUsed)
+{
+	const std::string filename = "JSONBinaryCacheTests_used.json";
+	const std::string cacheFilename = filename + ".cache";
+	std::filesystem::remove(cacheFilename);
+	writeDocument(filename, 1.0f);
+
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+		checkDocument(reader, 1.0f);
+	}
+	WOLF_CHECK(std::filesystem::exists(cacheFilename));
+
+	// Cache is read, not written again
+	const std::filesystem::file_time_type cacheWriteTime = std::filesystem::last_write_time(cacheFilename);
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+		checkDocument(reader, 1.0f);
+	}
+	WOLF_CHECK(std::filesystem::last_write_time(cacheFilename) == cacheWriteTime);
+}
+
+WOLF_TEST(StaleCacheIsRebuilt)
+{
+	const std::string filename = "JSONBinaryCacheTests_stale.json";
+	std::filesystem::remove(filename + ".cache");
+	writeDocument(filename, 1.0f);
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+		checkDocument(reader, 1.0f);
+	}
+
+	// Same size, different content
+	writeDocument(filename, 7.0f);
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+		checkDocument(reader, 7.0f);
+	}
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+		checkDocument(reader, 7.0f);
+	}
+}
+
+WOLF_TEST(CorruptedCacheIsRebuilt)
+{
+	const std::string filename = "JSONBinaryCacheTests_corrupted.json";
+	const std::string cacheFilename = filename + ".cache";
+	writeDocument(filename, 3.0f);
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+		checkDocument(reader, 3.0f);
+	}
+	const uintmax_t cacheSize = std::filesystem::file_size(cacheFilename);
+
+	std::filesystem::resize_file(cacheFilename, 40);
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+		checkDocument(reader, 3.0f);
+	}
+	WOLF_CHECK_EQUAL(std::filesystem::file_size(cacheFilename), cacheSize);
+
+	// Garbage past the valid header
+	{
+		std::fstream cacheFile(cacheFilename, std::ios::binary | std::ios::in | std::ios::out);
+		cacheFile.seekp(static_cast<std::streamoff>(cacheSize / 2));
+		const std::string garbage(16, '\xFF');
+		cacheFile.write(garbage.data(), static_cast<std::streamsize>(garbage.size()));
+	}
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+		checkDocument(reader, 3.0f);
+	}
+}
+
+WOLF_TEST(CacheFolder)
+{
+	const std::string filename = "JSONBinaryCacheTests_folder.json";
+	const std::string cacheFolder = "JSONBinaryCacheTests_cache";
+	std::filesystem::remove_all(cacheFolder);
+	std::filesystem::create_directories(cacheFolder);
+	writeDocument(filename, 5.0f);
+
+	for (uint32_t loadIdx = 0; loadIdx < 2; ++loadIdx)
+	{
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true, cacheFolder });
+		checkDocument(reader, 5.0f);
+	}
+
+	uint32_t cacheFileCount = 0;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(cacheFolder))
+	{
+		WOLF_CHECK(entry.path().filename().string().starts_with(filename));
+		cacheFileCount++;
+	}
+	WOLF_CHECK_EQUAL(cacheFileCount, 1u);
+}
+
+WOLF_TEST(InvalidFileIsNotCached)
+{
+	const std::string filename = "JSONBinaryCacheTests_invalid.json";
+	const std::string cacheFilename = filename + ".cache";
+	std::filesystem::remove(cacheFilename);
+	{
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+		file << "{ \"a\": [1, \"x\"] }";
+	}
+
+	// Errors are reported on each load
+	for (uint32_t loadIdx = 0; loadIdx < 2; ++loadIdx)
+	{
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename, true });
+	}
+	WOLF_CHECK(!std::filesystem::exists(cacheFilename));
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ "JSONBinaryCacheTests_missing.json", true });
+	WOLF_CHECK_EQUAL(reader.getRoot()->getPropertyCount(), 0u);
+}
+
+WOLF_TEST(LargeDocumentMatchesTextParsing)
+{
+	const std::string filename = "JSONBinaryCacheTests_large.json";
+	std::filesystem::remove(filename + ".cache");
+	{
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+		file << "{ \"materials\": [\n";
+		for (uint32_t i = 0; i < 10000; ++i)
+			file << "{ \"name\": \"material_" << i << "\", \"albedo\": [0.5, 0.25, " << i << "], \"texture\": \"textures/albedo_" << i << ".png\" }" << (i + 1 < 10000 ? ",\n" : "\n");
+		file << "] }\n";
+	}
+
+	Wolf::JSONReader textReader(Wolf::JSONReader::FileReadInfo{ filename });
+	{
+		Wolf::JSONReader coldReader(Wolf::JSONReader::FileReadInfo{ filename, true });
+	}
+	Wolf::JSONReader cachedReader(Wolf::JSONReader::FileReadInfo{ filename, true });
+
+	WOLF_CHECK_EQUAL(cachedReader.getRoot()->getArraySize("materials"), 10000u);
+	for (uint32_t i = 0; i < 10000; i += 7)
+	{
+		Wolf::JSONReader::JSONObjectInterface* cachedMaterial = cachedReader.getRoot()->getArrayObjectItem("materials", i);
+		Wolf::JSONReader::JSONObjectInterface* textMaterial = textReader.getRoot()->getArrayObjectItem("materials", i);
+		WOLF_CHECK_EQUAL(cachedMaterial->getPropertyString("name"), textMaterial->getPropertyString("name"));
+		WOLF_CHECK_EQUAL(cachedMaterial->getPropertyString("texture"), textMaterial->getPropertyString("texture"));
+		WOLF_CHECK(cachedMaterial->getPropertyFloatArray("albedo") == textMaterial->getPropertyFloatArray("albedo"));
+	}
+}
@@ -0,0 +1,225 @@
+#include <fstream>
+#include <string>
+
+#include "JSONPullReader.h"
+#include "TestFramework.h"
+
+using Event = Wolf::JSONPullReader::Event;
+
+WOLF_TEST(EventSequence)
+{
+	Wolf::JSONPullReader reader(std::string_view("{ \"a\": [1, \"s\", true, null, {}], \"o\": { \"x\": false }, \"e\": [] }"));
+
+	WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+	WOLF_CHECK_EQUAL(reader.getDepth(), 1u);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.getString() == "a");
+	WOLF_CHECK(reader.next() == Event::BEGIN_ARRAY);
+	WOLF_CHECK_EQUAL(reader.getDepth(), 2u);
+	WOLF_CHECK(reader.next() == Event::NUMBER);
+	WOLF_CHECK_EQUAL(reader.getNumber(), 1.0f);
+	WOLF_CHECK(reader.next() == Event::STRING);
+	WOLF_CHECK(reader.getString() == "s");
+	WOLF_CHECK(reader.next() == Event::BOOL);
+	WOLF_CHECK(reader.getBool());
+	WOLF_CHECK(reader.next() == Event::NULL_VALUE);
+	WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+	WOLF_CHECK(reader.next() == Event::END_OBJECT);
+	WOLF_CHECK(reader.next() == Event::END_ARRAY);
+	WOLF_CHECK_EQUAL(reader.getDepth(), 1u);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.getString() == "o");
+	WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.next() == Event::BOOL);
+	WOLF_CHECK(!reader.getBool());
+	WOLF_CHECK(reader.next() == Event::END_OBJECT);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.next() == Event::BEGIN_ARRAY);
+	WOLF_CHECK(reader.next() == Event::END_ARRAY);
+	WOLF_CHECK(reader.next() == Event::END_OBJECT);
+	WOLF_CHECK_EQUAL(reader.getDepth(), 0u);
+	WOLF_CHECK(reader.next() == Event::END_OF_DOCUMENT);
+	WOLF_CHECK(reader.next() == Event::END_OF_DOCUMENT);
+	WOLF_CHECK(!reader.hasError());
+}
+
+WOLF_TEST(SkipValuesAndContainers)
+{
+	// Skipped content contains brackets and quotes inside strings and comments
+	Wolf::JSONPullReader reader(std::string_view("{\"a\": [1, {\"x\": \"}]\\\"\", /* ] */ \"y\": [[]]}, 3], \"b\": {\"c\": 1, \"d\": [1,2]}, \"s\": \"k\\n\", \"e\": 2}"));
+
+	WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.next() == Event::BEGIN_ARRAY);
+	WOLF_CHECK(reader.next() == Event::NUMBER);
+	WOLF_CHECK(reader.skipValue());
+	WOLF_CHECK(reader.next() == Event::NUMBER);
+	WOLF_CHECK_EQUAL(reader.getNumber(), 3.0f);
+	WOLF_CHECK(reader.next() == Event::END_ARRAY);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.getString() == "b");
+	WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.getString() == "c");
+	WOLF_CHECK(reader.skipContainer());
+	WOLF_CHECK_EQUAL(reader.getDepth(), 1u);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.getString() == "s");
+	WOLF_CHECK(reader.next() == Event::STRING);
+	WOLF_CHECK(reader.getString() == "k\n");
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.getString() == "e");
+	WOLF_CHECK(reader.skipValue());
+	WOLF_CHECK(reader.next() == Event::END_OBJECT);
+	WOLF_CHECK(reader.next() == Event::END_OF_DOCUMENT);
+	WOLF_CHECK(!reader.hasError());
+}
+
+WOLF_TEST(NothingToSkip)
+{
+	{
+		Wolf::JSONPullReader reader(std::string_view("{\"a\": []}"));
+		WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+		WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+		WOLF_CHECK(reader.next() == Event::BEGIN_ARRAY);
+
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		WOLF_CHECK(!reader.skipValue());
+		WOLF_CHECK(reader.hasError());
+	}
+	{
+		Wolf::JSONPullReader reader(std::string_view("{}"));
+		WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+		WOLF_CHECK(reader.next() == Event::END_OBJECT);
+
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		WOLF_CHECK(!reader.skipContainer());
+	}
+	{
+		Wolf::JSONPullReader reader(std::string_view("{\"a\": [1, 2"));
+		WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		WOLF_CHECK(!reader.skipContainer());
+	}
+}
+
+WOLF_TEST(ErrorStopsReading)
+{
+	Wolf::JSONPullReader reader(std::string_view("{\"a\": 1 \"b\": 2}"));
+	WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.next() == Event::NUMBER);
+
+	// Only the first error is reported
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	WOLF_CHECK(reader.next() == Event::ERROR);
+	WOLF_CHECK(reader.hasError());
+	WOLF_CHECK(reader.next() == Event::ERROR);
+	WOLF_CHECK(!reader.skipValue());
+	reader.sendError("Error detected by the caller");
+}
+
+WOLF_TEST(CallerError)
+{
+	Wolf::JSONPullReader reader(std::string_view("{\"version\": 3}"));
+	WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.next() == Event::NUMBER);
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	reader.sendError("Unsupported version");
+	WOLF_CHECK(reader.hasError());
+	WOLF_CHECK(reader.next() == Event::ERROR);
+}
+
+WOLF_TEST(NestingDepthLimit)
+{
+	constexpr uint32_t MAX_DEPTH = 256;
+
+	const auto readNestedArrays = [](uint32_t depth)
+	{
+		const std::string json = std::string(depth, '[') + std::string(depth, ']');
+		Wolf::JSONPullReader reader(json);
+		Event event;
+		while ((event = reader.next()) != Event::END_OF_DOCUMENT && event != Event::ERROR) {}
+		return event;
+	};
+
+	WOLF_CHECK(readNestedArrays(MAX_DEPTH) == Event::END_OF_DOCUMENT);
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	WOLF_CHECK(readNestedArrays(MAX_DEPTH + 1) == Event::ERROR);
+}
+
+WOLF_TEST(ReadFromFile)
+{
+	{
+		std::ofstream file("JSONPullReaderTests.json", std::ios::binary);
+		file << "\xEF\xBB\xBF{\r\n\t\"name\": \"scene\", // comment\r\n\t\"values\": [0.5, -2,],\r\n}\r\n";
+	}
+
+	Wolf::JSONPullReader reader(Wolf::JSONPullReader::FileReadInfo{ "JSONPullReaderTests.json" });
+	WOLF_CHECK(reader.next() == Event::BEGIN_OBJECT);
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.next() == Event::STRING);
+	WOLF_CHECK(reader.getString() == "scene");
+	WOLF_CHECK(reader.next() == Event::PROPERTY_NAME);
+	WOLF_CHECK(reader.next() == Event::BEGIN_ARRAY);
+	WOLF_CHECK(reader.next() == Event::NUMBER);
+	WOLF_CHECK_EQUAL(reader.getNumber(), 0.5f);
+	WOLF_CHECK(reader.next() == Event::NUMBER);
+	WOLF_CHECK_EQUAL(reader.getNumber(), -2.0f);
+	WOLF_CHECK(reader.next() == Event::END_ARRAY);
+	WOLF_CHECK(reader.next() == Event::END_OBJECT);
+	WOLF_CHECK(reader.next() == Event::END_OF_DOCUMENT);
+}
+
+WOLF_TEST(MissingFile)
+{
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	Wolf::JSONPullReader reader(Wolf::JSONPullReader::FileReadInfo{ "JSONPullReaderTests_missing.json" });
+	WOLF_CHECK(reader.hasError());
+	WOLF_CHECK(reader.next() == Event::ERROR);
+}
+
+WOLF_TEST(LargeDocumentWithSkippedValues)
+{
+	constexpr uint32_t MATERIAL_COUNT = 20000;
+
+	std::string json = "{ \"materials\": [\n";
+	for (uint32_t i = 0; i < MATERIAL_COUNT; ++i)
+	{
+		json += "{ \"name\": \"material_" + std::to_string(i) + "\", \"albedo\": [0.5, 0.25, 0.125], \"roughness\": " + std::to_string(i % 10) +
+			", \"texture\": { \"path\": \"textures/albedo.png\", \"mips\": [1, 2] } }" + (i + 1 < MATERIAL_COUNT ? ",\n" : "\n");
+	}
+	json += "] }";
+
+	Wolf::JSONPullReader reader(json);
+	uint32_t nameCount = 0;
+	float roughnessSum = 0.0f;
+	Event event;
+	while ((event = reader.next()) != Event::END_OF_DOCUMENT && event != Event::ERROR)
+	{
+		if (event != Event::PROPERTY_NAME)
+			continue;
+
+		if (reader.getString() == "albedo" || reader.getString() == "texture")
+		{
+			WOLF_CHECK(reader.skipValue());
+			continue;
+		}
+
+		const std::string key(reader.getString());
+		reader.next();
+		if (key == "name")
+			nameCount++;
+		else if (key == "roughness")
+			roughnessSum += reader.getNumber();
+	}
+
+	WOLF_CHECK(event == Event::END_OF_DOCUMENT);
+	WOLF_CHECK_EQUAL(nameCount, MATERIAL_COUNT);
+	WOLF_CHECK_EQUAL(roughnessSum, 4.5f * MATERIAL_COUNT);
+}
@@ -0,0 +1,219 @@
+#include <string>
+#include <vector>
+
+#include "JSONReader.h"
+#include "TestFramework.h"
+
+WOLF_TEST(ValuesOfEveryType)
+{
+	Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ "{ \"f\": 1.5e2, \"neg\": -0.25, \"int\": 42, \"s\": \"text\", \"t\": true, \"b\": false, \"n\": null,"
+		"\"o\": { \"x\": -3, \"inner\": { \"y\": 7 } }, \"fa\": [1, 2.5, -3e-1], \"sa\": [\"p\", \"q\"], \"oa\": [{ \"k\": 1 }, { \"k\": 2 }], \"e\": [] }" });
+	Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+
+	WOLF_CHECK_EQUAL(root->getPropertyFloat("f"), 150.0f);
+	WOLF_CHECK_EQUAL(root->getPropertyFloat("neg"), -0.25f);
+	WOLF_CHECK_EQUAL(root->getPropertyFloat("int"), 42.0f);
+	WOLF_CHECK_EQUAL(root->getPropertyString("s"), std::string("text"));
+	WOLF_CHECK(root->getPropertyBool("t"));
+	WOLF_CHECK(!root->getPropertyBool("b"));
+	WOLF_CHECK(root->hasProperty("n"));
+	WOLF_CHECK_EQUAL(root->getPropertyObject("o")->getPropertyFloat("x"), -3.0f);
+	WOLF_CHECK_EQUAL(root->getPropertyObject("o")->getPropertyObject("inner")->getPropertyFloat("y"), 7.0f);
+	WOLF_CHECK(root->getPropertyFloatArray("fa") == std::vector<float>({ 1.0f, 2.5f, -0.3f }));
+	WOLF_CHECK(root->getPropertyStringArray("sa") == std::vector<std::string>({ "p", "q" }));
+	WOLF_CHECK_EQUAL(root->getArraySize("oa"), 2u);
+	WOLF_CHECK_EQUAL(root->getArrayObjectItem("oa", 1)->getPropertyFloat("k"), 2.0f);
+	WOLF_CHECK(root->getPropertyFloatArray("e").empty());
+	WOLF_CHECK_EQUAL(root->getArraySize("e"), 0u);
+	WOLF_CHECK(!root->hasProperty("missing"));
+	WOLF_CHECK(root->getPropertyObject("missing") == nullptr);
+}
+
+WOLF_TEST(StringEscapesAndUnicode)
+{
+	Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ "{ \"s\": \"x\\\"y\\\\\\/\\b\\f\\n\\r\\t\\u00e9\\ud83d\\ude00//z\", \"raw\": \"\xC3\xA9t\xC3\xA9\" }" });
+	Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+
+	WOLF_CHECK_EQUAL(root->getPropertyString("s"), std::string("x\"y\\/\b\f\n\r\t\xC3\xA9\xF0\x9F\x98\x80//z"));
+	WOLF_CHECK_EQUAL(root->getPropertyString("raw"), std::string("\xC3\xA9t\xC3\xA9"));
+}
+
+WOLF_TEST(CommentsLineEndingsAndTrailingCommas)
+{
+	Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ "\xEF\xBB\xBF{ // line comment\r\n \"a\": 1, /* block { comment } */\r\n"
+		"\"fa\": [1, 2, 3,], \"o\": { \"x\": 1, },\r\n}" });
+	Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+
+	WOLF_CHECK_EQUAL(root->getPropertyCount(), 3u);
+	WOLF_CHECK_EQUAL(root->getPropertyFloat("a"), 1.0f);
+	WOLF_CHECK_EQUAL(root->getPropertyFloatArray("fa").size(), 3u);
+	WOLF_CHECK_EQUAL(root->getPropertyObject("o")->getPropertyFloat("x"), 1.0f);
+}
+
+WOLF_TEST(PropertiesByIndexInFileOrder)
+{
+	// Objects with many properties are indexed, a few are searched linearly
+	for (const uint32_t propertyCount : { 4u, 100u })
+	{
+		std::string json = "{";
+		for (uint32_t i = 0; i < propertyCount; ++i)
+			json += "\"k" + std::to_string(i) + "\": " + std::to_string(i) + ",";
+		json += "}";
+
+		Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ json });
+		Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+
+		WOLF_CHECK_EQUAL(root->getPropertyCount(), propertyCount);
+		for (uint32_t i = 0; i < propertyCount; ++i)
+		{
+			WOLF_CHECK_EQUAL(root->getPropertyString(i), "k" + std::to_string(i));
+			WOLF_CHECK_EQUAL(root->getPropertyFloat("k" + std::to_string(i)), static_cast<float>(i));
+		}
+
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		WOLF_CHECK(root->getPropertyString(propertyCount).empty());
+	}
+}
+
+WOLF_TEST(MissingPropertiesAreReported)
+{
+	Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ "{ \"o\": { \"x\": 1 }, \"oa\": [{ \"k\": 1 }], \"s\": \"text\" }" });
+	Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(6);
+	WOLF_CHECK_EQUAL(root->getPropertyFloat("missing"), 0.0f);
+	WOLF_CHECK(root->getPropertyString("missing").empty());
+	WOLF_CHECK(root->getPropertyFloatArray("missing").empty());
+	WOLF_CHECK(!root->getPropertyBool("s"));
+	WOLF_CHECK(root->getPropertyObject("s") == nullptr);
+	WOLF_CHECK(root->getArrayObjectItem("oa", 1) == nullptr);
+}
+
+WOLF_TEST(InvalidDocumentsAreRejected)
+{
+	const char* invalidDocuments[] =
+	{
+		"{\"a\": 1",
+		"{\"a\": [1, \"x\"]}",
+		"{\"a\": inf}",
+		"{\"a\": -}",
+		"{\"a\": \"\\q\"}",
+		"[1]",
+		"{\"a\" 1}",
+		"{\"a\": 1e99}",
+		"{\"a\": \"\\ud800\"}",
+		"{\"a\": [1}",
+		"{,}",
+		"{\"a\": [1,,2]}",
+		"{\"a\": tru}",
+		"{\"a\": \"unterminated}",
+		"{\"a\": [true]}",
+		"",
+	};
+
+	for (const char* invalidDocument : invalidDocuments)
+	{
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ invalidDocument });
+		WOLF_CHECK(reader.getRoot() != nullptr);
+	}
+}
+
+WOLF_TEST(ContentAfterRootIsIgnored)
+{
+	Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ "{\"a\": 1} {\"b\": 2}" });
+	WOLF_CHECK_EQUAL(reader.getRoot()->getPropertyCount(), 1u);
+	WOLF_CHECK_EQUAL(reader.getRoot()->getPropertyFloat("a"), 1.0f);
+}
+
+WOLF_TEST(DuplicatedPropertyKeepsFirstValue)
+{
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ "{\"a\": 1, \"a\": 2}" });
+	WOLF_CHECK_EQUAL(reader.getRoot()->getPropertyFloat("a"), 1.0f);
+}
+
+WOLF_TEST(LargeDocument)
+{
+	constexpr uint32_t MATERIAL_COUNT = 20000;
+
+	std::string json = "{\n\t\"materials\": [\n";
+	for (uint32_t i = 0; i < MATERIAL_COUNT; ++i)
+	{
+		json += "\t\t{ \"name\": \"material_" + std::to_string(i) + "\", \"albedo\": [0.5, 0.25, 0.125], \"roughness\": " + std::to_string(i % 10) +
+			", \"flag\": true }" + (i + 1 < MATERIAL_COUNT ? ",\n" : "\n");
+	}
+	json += "\t]\n}\n";
+
+	Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ json });
+	Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+
+	WOLF_CHECK_EQUAL(root->getArraySize("materials"), MATERIAL_COUNT);
+	for (uint32_t i = 0; i < MATERIAL_COUNT; i += 997)
+	{
+		Wolf::JSONReader::JSONObjectInterface* material = root->getArrayObjectItem("materials", i);
+		WOLF_CHECK_EQUAL(material->getPropertyString("name"), "material_" + std::to_string(i));
+		WOLF_CHECK_EQUAL(material->getPropertyFloat("roughness"), static_cast<float>(i % 10));
+		WOLF_CHECK(material->getPropertyFloatArray("albedo") == std::vector<float>({ 0.5f, 0.25f, 0.125f }));
+		WOLF_CHECK(material->getPropertyBool("flag"));
+	}
+}
+
+WOLF_TEST(KeysAreSharedAcrossObjects)
+{
+	Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ "{ \"name\": \"root\", \"items\": [{ \"name\": \"a\", \"value\": 1 }, { \"value\": 2, \"name\": \"b\" }], "
+		"\"child\": { \"name\": \"c\" } }" });
+	Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+	Wolf::JSONReader::JSONObjectInterface* firstItem = root->getArrayObjectItem("items", 0);
+	Wolf::JSONReader::JSONObjectInterface* secondItem = root->getArrayObjectItem("items", 1);
+	Wolf::JSONReader::JSONObjectInterface* child = root->getPropertyObject("child");
+
+	// Same key string in every object, whatever the property order
+	const std::string& rootNameKey = root->getPropertyString(0u);
+	WOLF_CHECK_EQUAL(rootNameKey, "name");
+	WOLF_CHECK(&firstItem->getPropertyString(0u) == &rootNameKey);
+	WOLF_CHECK(&secondItem->getPropertyString(1u) == &rootNameKey);
+	WOLF_CHECK(&child->getPropertyString(0u) == &rootNameKey);
+	WOLF_CHECK(&firstItem->getPropertyString(1u) == &secondItem->getPropertyString(0u));
+
+	WOLF_CHECK_EQUAL(firstItem->getPropertyString("name"), "a");
+	WOLF_CHECK_EQUAL(secondItem->getPropertyString("name"), "b");
+	WOLF_CHECK_EQUAL(child->getPropertyString("name"), "c");
+
+	// A key of another object isn't a property
+	WOLF_CHECK(!child->hasProperty("value"));
+	WOLF_CHECK(!root->hasProperty("value"));
+}
+
+WOLF_TEST(LookupsAroundIndexThreshold)
+{
+	// Objects are indexed from 16 properties
+	for (const uint32_t propertyCount : { 14u, 15u, 16u, 17u, 40u })
+	{
+		// Last property is an object, "other" is a key of the child only. The duplicated k0 is rejected
+		std::string json = "{";
+		for (uint32_t i = 0; i + 1 < propertyCount; ++i)
+			json += "\"k" + std::to_string(i) + "\": " + std::to_string(i) + ", ";
+		json += "\"child\": { \"other\": 1 }, \"k0\": 100 }";
+
+		Wolf::Tests::ExpectedErrorsScope duplicatedPropertyError(1);
+		Wolf::JSONReader reader(Wolf::JSONReader::StringReadInfo{ json });
+		Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+
+		WOLF_CHECK_EQUAL(root->getPropertyCount(), propertyCount);
+		uint32_t wrongValueCount = 0;
+		for (uint32_t i = 0; i + 1 < propertyCount; ++i)
+		{
+			if (!root->hasProperty("k" + std::to_string(i)) || root->getPropertyFloat("k" + std::to_string(i)) != static_cast<float>(i))
+				wrongValueCount++;
+		}
+		WOLF_CHECK_EQUAL(wrongValueCount, 0u);
+
+		Wolf::JSONReader::JSONObjectInterface* child = root->getPropertyObject("child");
+		WOLF_CHECK(child != nullptr);
+		WOLF_CHECK_EQUAL(child->getPropertyFloat("other"), 1.0f);
+		WOLF_CHECK(!root->hasProperty("other"));
+		WOLF_CHECK(!root->hasProperty("missing"));
+		WOLF_CHECK(root->getPropertyObject("other") == nullptr);
+	}
+}
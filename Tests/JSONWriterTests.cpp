@@ -0,0 +1,163 @@
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "JSONReader.h"
+#include "JSONWriter.h"
+#include "TestFramework.h"
+
+namespace
+{
+	std::string readFile(const std::string& filename)
+	{
+		std::ifstream file(filename, std::ios::binary);
+		std::stringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+
+	void writeScene(Wolf::JSONWriter& writer, uint32_t entityCount)
+	{
+		std::mt19937 randomEngine(7);
+		std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+
+		writer.beginObject();
+		writer.writeProperty("name", "scene \"main\"\\path\n");
+		writer.writePropertyName("entities");
+		writer.beginArray();
+		for (uint32_t entityIdx = 0; entityIdx < entityCount; ++entityIdx)
+		{
+			writer.beginObject();
+			writer.writeProperty("name", "entity_" + std::to_string(entityIdx));
+			writer.writeProperty("visible", (entityIdx & 1) == 0);
+			writer.writePropertyName("position");
+			writer.beginArray();
+			for (uint32_t i = 0; i < 3; ++i)
+				writer.writeNumber(distribution(randomEngine));
+			writer.endArray();
+			writer.writeProperty("scale", distribution(randomEngine) / 1000.0f);
+			writer.writePropertyName("tags");
+			writer.beginArray();
+			writer.writeString("a");
+			writer.writeString("\x01tab\tq\"\xC3\xA9");
+			writer.endArray();
+			writer.writePropertyName("empty");
+			writer.beginArray();
+			writer.endArray();
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.endObject();
+	}
+}
+
+WOLF_TEST(FloatsReadBackToSameValue)
+{
+	std::mt19937 randomEngine(1);
+	uint32_t mismatchCount = 0;
+	for (uint32_t i = 0; i < 200000; ++i)
+	{
+		const float value = std::bit_cast<float>(static_cast<uint32_t>(randomEngine()));
+		if (!std::isfinite(value))
+			continue;
+
+		Wolf::JSONWriter writer(Wolf::JSONWriter::StringWriteInfo{});
+		writer.beginArray();
+		writer.writeNumber(value);
+		writer.endArray();
+
+		const std::string& output = writer.getString();
+		float readValue;
+		const std::from_chars_result result = std::from_chars(output.data() + 1, output.data() + output.size() - 1, readValue);
+		if (result.ec != std::errc() || std::bit_cast<uint32_t>(readValue) != std::bit_cast<uint32_t>(value))
+			mismatchCount++;
+	}
+	WOLF_CHECK_EQUAL(mismatchCount, 0u);
+}
+
+WOLF_TEST(CompactOutputAndEscapes)
+{
+	Wolf::JSONWriter writer(Wolf::JSONWriter::StringWriteInfo{});
+	writer.beginObject();
+	writer.writeProperty("a\"b", "x\x1f\n");
+	writer.writeProperty("n", -12);
+	writer.writeProperty("f", 0.1f);
+	writer.writePropertyName("e");
+	writer.beginObject();
+	writer.endObject();
+	writer.writePropertyName("z");
+	writer.writeNull();
+	writer.writeProperty("inf", INFINITY);
+	writer.endObject();
+
+	WOLF_CHECK_EQUAL(writer.getString(), std::string("{\"a\\\"b\":\"x\\u001f\\n\",\"n\":-12,\"f\":0.1,\"e\":{},\"z\":null,\"inf\":null}"));
+}
+
+WOLF_TEST(PrettyPrint)
+{
+	Wolf::JSONWriter writer(Wolf::JSONWriter::StringWriteInfo{ true });
+	writer.beginObject();
+	writer.writeProperty("a", 1);
+	writer.writePropertyName("b");
+	writer.beginArray();
+	writer.writeNumber(1.5f);
+	writer.writeNumber(2u);
+	writer.endArray();
+	writer.writePropertyName("c");
+	writer.beginArray();
+	writer.endArray();
+	writer.endObject();
+
+	WOLF_CHECK_EQUAL(writer.getString(), std::string("{\n  \"a\": 1,\n  \"b\": [\n    1.5,\n    2\n  ],\n  \"c\": []\n}"));
+}
+
+WOLF_TEST(FileRoundTripThroughReader)
+{
+	for (const bool prettyPrint : { false, true })
+	{
+		const std::string filename = prettyPrint ? "JSONWriterTests_pretty.json" : "JSONWriterTests_compact.json";
+		const std::string rewrittenFilename = "JSONWriterTests_rewritten.json";
+		{
+			Wolf::JSONWriter writer(Wolf::JSONWriter::FileWriteInfo{ filename, prettyPrint });
+			WOLF_CHECK(writer.isValid());
+			writeScene(writer, 5000);
+		}
+
+		Wolf::JSONReader reader(Wolf::JSONReader::FileReadInfo{ filename });
+		Wolf::JSONReader::JSONObjectInterface* root = reader.getRoot();
+		WOLF_CHECK_EQUAL(root->getArraySize("entities"), 5000u);
+		WOLF_CHECK_EQUAL(root->getPropertyString("name"), std::string("scene \"main\"\\path\n"));
+
+		Wolf::JSONReader::JSONObjectInterface* entity = root->getArrayObjectItem("entities", 5);
+		WOLF_CHECK_EQUAL(entity->getPropertyString("name"), std::string("entity_5"));
+		WOLF_CHECK(!entity->getPropertyBool("visible"));
+		WOLF_CHECK_EQUAL(entity->getPropertyStringArray("tags")[1], std::string("\x01tab\tq\"\xC3\xA9"));
+
+		// Writing the DOM gives back the same file
+		{
+			Wolf::JSONWriter writer(Wolf::JSONWriter::FileWriteInfo{ rewrittenFilename, prettyPrint });
+			root->write(writer);
+		}
+		WOLF_CHECK(readFile(filename) == readFile(rewrittenFilename));
+	}
+}
+
+WOLF_TEST(FileCantBeOpened)
+{
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	Wolf::JSONWriter writer(Wolf::JSONWriter::FileWriteInfo{ "JSONWriterTests_missing_folder/file.json" });
+	WOLF_CHECK(!writer.isValid());
+}
+
+WOLF_TEST(UnclosedContainersAreReported)
+{
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	Wolf::JSONWriter writer(Wolf::JSONWriter::StringWriteInfo{});
+	writer.beginObject();
+	writer.writePropertyName("a");
+	writer.beginArray();
+}
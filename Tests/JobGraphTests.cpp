@@ -0,0 +1,226 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "JobsManager.h"
+#include "JobsTestHelpers.h"
+#include "TestFramework.h"
+
+WOLF_TEST(ContinuationChainRunsInOrder)
+{
+	Wolf::JobsManager jobsManager(4);
+	Wolf::Tests::ExecutionOrder executionOrder;
+
+	for (uint32_t chainIdx = 0; chainIdx < 16; ++chainIdx)
+	{
+		Wolf::JobsManager::JobHandle handle = jobsManager.addJobBeforeFrame([&executionOrder, chainIdx]() { executionOrder.add(chainIdx * 10); });
+		for (uint32_t linkIdx = 1; linkIdx < 5; ++linkIdx)
+		{
+			handle = jobsManager.addContinuationBeforeFrame(handle, [&executionOrder, chainIdx, linkIdx]() { executionOrder.add(chainIdx * 10 + linkIdx); });
+		}
+	}
+	jobsManager.executeJobsBeforeFrame();
+
+	WOLF_CHECK_EQUAL(executionOrder.getCount(), 16u * 5u);
+	for (uint32_t chainIdx = 0; chainIdx < 16; ++chainIdx)
+	{
+		for (uint32_t linkIdx = 1; linkIdx < 5; ++linkIdx)
+		{
+			WOLF_CHECK(executionOrder.getPosition(chainIdx * 10 + linkIdx - 1) < executionOrder.getPosition(chainIdx * 10 + linkIdx));
+		}
+	}
+}
+
+WOLF_TEST(JobWaitsForAllDependencies)
+{
+	Wolf::JobsManager jobsManager(4);
+
+	for (uint32_t executionIdx = 0; executionIdx < 200; ++executionIdx)
+	{
+		Wolf::Tests::ExecutionOrder executionOrder;
+
+		// Diamond: 0 -> (1, 2) -> 3, with 4 independent
+		const Wolf::JobsManager::JobHandle top = jobsManager.addJobBeforeFrame([&]() { executionOrder.add(0); });
+		const Wolf::JobsManager::JobHandle left = jobsManager.addContinuationBeforeFrame(top, [&]() { executionOrder.add(1); });
+		const Wolf::JobsManager::JobHandle right = jobsManager.addContinuationBeforeFrame(top, [&]() { executionOrder.add(2); });
+		const std::array dependencies = { left, right };
+		jobsManager.addJobBeforeFrame([&]() { executionOrder.add(3); }, dependencies);
+		jobsManager.addJobBeforeFrame([&]() { executionOrder.add(4); });
+		jobsManager.executeJobsBeforeFrame();
+
+		WOLF_CHECK_EQUAL(executionOrder.getCount(), 5u);
+		WOLF_CHECK(executionOrder.getPosition(0) < executionOrder.getPosition(1));
+		WOLF_CHECK(executionOrder.getPosition(0) < executionOrder.getPosition(2));
+		WOLF_CHECK(executionOrder.getPosition(1) < executionOrder.getPosition(3));
+		WOLF_CHECK(executionOrder.getPosition(2) < executionOrder.getPosition(3));
+	}
+}
+
+WOLF_TEST(DependencyOnPreviousExecutionIsCompleted)
+{
+	Wolf::JobsManager jobsManager(2);
+
+	const Wolf::JobsManager::JobHandle previousHandle = jobsManager.addJobBeforeFrame([]() {});
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK(jobsManager.isJobCompleted(previousHandle));
+
+	bool executed = false;
+	jobsManager.addContinuationBeforeFrame(previousHandle, [&]() { executed = true; });
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK(executed);
+
+	// Handles of older executions stay completed
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK(jobsManager.isJobCompleted(previousHandle));
+}
+
+WOLF_TEST(InvalidDependencyIsIgnored)
+{
+	Wolf::JobsManager jobsManager(2);
+
+	bool executed = false;
+	const Wolf::JobsManager::JobHandle futureHandle = { 1000, 0 };
+	{
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		jobsManager.addJobBeforeFrame([&]() { executed = true; }, { &futureHandle, 1 });
+	}
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK(executed);
+
+	// Default handle is invalid and always completed
+	const Wolf::JobsManager::JobHandle invalidHandle;
+	WOLF_CHECK(jobsManager.isJobCompleted(invalidHandle));
+	executed = false;
+	jobsManager.addContinuationBeforeFrame(invalidHandle, [&]() { executed = true; });
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK(executed);
+}
+
+WOLF_TEST(WaitForJobFromJob)
+{
+	Wolf::JobsManager jobsManager(3);
+
+	for (uint32_t executionIdx = 0; executionIdx < 100; ++executionIdx)
+	{
+		std::atomic<uint32_t> producedValue = 0;
+		std::atomic<bool> waitedValueValid = true;
+
+		const Wolf::JobsManager::JobHandle producer = jobsManager.addJobBeforeFrame([&]() { producedValue = 42; });
+		for (uint32_t i = 0; i < 8; ++i)
+		{
+			jobsManager.addJobBeforeFrame([&, producer]()
+			{
+				jobsManager.waitForJob(producer);
+				if (producedValue.load() != 42)
+					waitedValueValid = false;
+			});
+		}
+		jobsManager.executeJobsBeforeFrame();
+
+		WOLF_CHECK(waitedValueValid.load());
+		WOLF_CHECK(jobsManager.isJobCompleted(producer));
+	}
+}
+
+WOLF_TEST(JobsAddedDuringExecutionRunNextExecution)
+{
+	Wolf::JobsManager jobsManager(2);
+
+	uint32_t secondJobExecutionCount = 0;
+	jobsManager.addJobBeforeFrame([&]()
+	{
+		jobsManager.addJobBeforeFrame([&]() { secondJobExecutionCount++; });
+	});
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK_EQUAL(secondJobExecutionCount, 0u);
+
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK_EQUAL(secondJobExecutionCount, 1u);
+}
+
+WOLF_TEST(ManyExecutionsWithMoveOnlyCaptures)
+{
+	Wolf::JobsManager jobsManager(4);
+
+	for (uint32_t executionIdx = 0; executionIdx < 500; ++executionIdx)
+	{
+		std::atomic<uint64_t> sum = 0;
+		uint64_t expectedSum = 0;
+		for (uint32_t i = 0; i < 50; ++i)
+		{
+			std::unique_ptr<uint32_t> value = std::make_unique<uint32_t>(i);
+			const Wolf::JobsManager::JobHandle handle = jobsManager.addJobBeforeFrame([value = std::move(value), &sum]() { sum += *value; });
+			jobsManager.addContinuationBeforeFrame(handle, [&sum]() { sum += 1000; });
+			expectedSum += i + 1000;
+		}
+		jobsManager.executeJobsBeforeFrame();
+
+		WOLF_CHECK_EQUAL(sum.load(), expectedSum);
+	}
+}
+
+WOLF_TEST(IsJobCompletedWhileExecutionsStart)
+{
+	constexpr uint32_t JOB_COUNT = 16;
+	Wolf::JobsManager jobsManager(2);
+
+	// Polled from another thread while executions clear the nodes of the previous ones
+	std::atomic<uint64_t> completedExecutionIdx = 0;
+	std::atomic<bool> stopPolling = false;
+	std::atomic<bool> completedJobSeenPending = false;
+	std::thread pollingThread([&]()
+	{
+		while (!stopPolling)
+		{
+			const Wolf::JobsManager::JobHandle lastJob = { completedExecutionIdx.load(), JOB_COUNT - 1 };
+			if (lastJob.m_executionIdx > 0 && !jobsManager.isJobCompleted(lastJob))
+				completedJobSeenPending = true;
+		}
+	});
+
+	for (uint32_t executionIdx = 0; executionIdx < 1000; ++executionIdx)
+	{
+		Wolf::JobsManager::JobHandle lastJob;
+		for (uint32_t i = 0; i < JOB_COUNT; ++i)
+			lastJob = jobsManager.addJobBeforeFrame([]() {});
+		jobsManager.executeJobsBeforeFrame();
+
+		completedExecutionIdx = lastJob.m_executionIdx;
+	}
+	stopPolling = true;
+	pollingThread.join();
+
+	WOLF_CHECK(!completedJobSeenPending.load());
+}
+
+WOLF_TEST(WaitForJobFromMainThreadWhileStarted)
+{
+	Wolf::JobsManager jobsManager(2);
+
+	for (uint32_t executionIdx = 0; executionIdx < 50; ++executionIdx)
+	{
+		std::atomic<bool> sleptJobDone = false;
+		const Wolf::JobsManager::JobHandle sleptJob = jobsManager.addJobBeforeFrame([&]()
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+			sleptJobDone = true;
+		});
+		const Wolf::JobsManager::JobHandle continuation = jobsManager.addContinuationBeforeFrame(sleptJob, []() {});
+
+		// Handles can be waited for as soon as the execution is started. The main thread doesn't belong to the before frame workers,
+		// it sleeps once there is nothing left to help with
+		jobsManager.startJobsBeforeFrame(executionIdx);
+		std::atomic<uint32_t> jobAddedWhileStartedCount = 0;
+		jobsManager.addJobBeforeFrame([&]() { jobAddedWhileStartedCount++; });
+		jobsManager.waitForJob(continuation);
+		WOLF_CHECK(sleptJobDone.load());
+		WOLF_CHECK(jobsManager.isJobCompleted(continuation));
+		jobsManager.waitJobsBeforeFrame();
+		WOLF_CHECK_EQUAL(jobAddedWhileStartedCount.load(), 0u);
+		jobsManager.executeJobsBeforeFrame();
+		WOLF_CHECK_EQUAL(jobAddedWhileStartedCount.load(), 1u);
+	}
+}
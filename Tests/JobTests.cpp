@@ -0,0 +1,220 @@
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "Job.h"
+#include "MultiThreadTaskManager.h"
+#include "TestFramework.h"
+
+// Counts the allocations of the test thread
+namespace
+{
+	thread_local uint32_t g_allocationCount = 0;
+}
+
+void* operator new(size_t size)
+{
+	g_allocationCount++;
+	if (void* pointer = std::malloc(size ? size : 1))
+		return pointer;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+namespace
+{
+	// Counts the live copies of a capture
+	class Tracker
+	{
+	public:
+		explicit Tracker(std::atomic<int32_t>& liveCount) : m_liveCount(&liveCount) { (*m_liveCount)++; }
+		Tracker(const Tracker& other) : m_liveCount(other.m_liveCount) { (*m_liveCount)++; }
+		Tracker(Tracker&& other) noexcept : m_liveCount(other.m_liveCount) { (*m_liveCount)++; }
+		~Tracker() { (*m_liveCount)--; }
+
+	private:
+		std::atomic<int32_t>* m_liveCount;
+	};
+
+	struct ThrowingMove
+	{
+		ThrowingMove() = default;
+		ThrowingMove(ThrowingMove&&) noexcept(false) {}
+		void operator()() const {}
+	};
+
+	// Job storing a tracker inline or on the heap, incrementing callCount when invoked
+	Wolf::Job createTrackedJob(std::atomic<int32_t>& liveCount, uint32_t& callCount, bool storedOnHeap)
+	{
+		if (storedOnHeap)
+		{
+			std::array<uint8_t, Wolf::Job::INLINE_STORAGE_SIZE> padding{};
+			return Wolf::Job([tracker = Tracker(liveCount), &callCount, padding]() { callCount += 1 + padding[0]; });
+		}
+		return Wolf::Job([tracker = Tracker(liveCount), &callCount]() { callCount++; });
+	}
+}
+
+WOLF_TEST(InlineStorageOrHeapFallback)
+{
+	uint32_t callCount = 0;
+	auto smallFunction = [&callCount]() { callCount++; };
+	std::array<uint8_t, Wolf::Job::INLINE_STORAGE_SIZE> padding{};
+	auto bigFunction = [&callCount, padding]() { callCount += 1 + padding[0]; };
+	static_assert(Wolf::Job::IS_STORED_INLINE<decltype(smallFunction)>);
+	static_assert(!Wolf::Job::IS_STORED_INLINE<decltype(bigFunction)>);
+	static_assert(!Wolf::Job::IS_STORED_INLINE<ThrowingMove>);
+
+	const uint32_t allocationCountBeforeInline = g_allocationCount;
+	{
+		Wolf::Job job(smallFunction);
+		job();
+	}
+	WOLF_CHECK_EQUAL(g_allocationCount - allocationCountBeforeInline, 0u);
+
+	const uint32_t allocationCountBeforeHeap = g_allocationCount;
+	{
+		Wolf::Job job(bigFunction);
+		job();
+		Wolf::Job throwingMoveJob = ThrowingMove();
+		throwingMoveJob();
+	}
+	WOLF_CHECK_EQUAL(g_allocationCount - allocationCountBeforeHeap, 2u);
+	WOLF_CHECK_EQUAL(callCount, 2u);
+
+	Wolf::Job emptyJob;
+	WOLF_CHECK(!emptyJob);
+}
+
+WOLF_TEST(MoveKeepsOneCapture)
+{
+	for (const bool storedOnHeap : { false, true })
+	{
+		std::atomic<int32_t> liveCount = 0;
+		uint32_t callCount = 0;
+		{
+			Wolf::Job job = createTrackedJob(liveCount, callCount, storedOnHeap);
+			WOLF_CHECK_EQUAL(liveCount.load(), 1);
+
+			// Heap captures are moved by pointer, without allocating
+			const uint32_t allocationCountBeforeMoves = g_allocationCount;
+			Wolf::Job movedJob(std::move(job));
+			WOLF_CHECK(!job);
+			WOLF_CHECK(static_cast<bool>(movedJob));
+			WOLF_CHECK_EQUAL(liveCount.load(), 1);
+
+			Wolf::Job assignedJob;
+			assignedJob = std::move(movedJob);
+			WOLF_CHECK(!movedJob);
+			WOLF_CHECK_EQUAL(liveCount.load(), 1);
+			WOLF_CHECK_EQUAL(g_allocationCount - allocationCountBeforeMoves, 0u);
+
+			Wolf::Job& selfAssignedJob = assignedJob;
+			assignedJob = std::move(selfAssignedJob);
+			WOLF_CHECK(static_cast<bool>(assignedJob));
+			assignedJob();
+			WOLF_CHECK_EQUAL(callCount, 1u);
+			WOLF_CHECK_EQUAL(liveCount.load(), 1);
+		}
+		WOLF_CHECK_EQUAL(liveCount.load(), 0);
+	}
+}
+
+WOLF_TEST(CapturesAreDestroyed)
+{
+	for (const bool storedOnHeap : { false, true })
+	{
+		std::atomic<int32_t> liveCount = 0;
+		uint32_t callCount = 0;
+
+		Wolf::Job job = createTrackedJob(liveCount, callCount, storedOnHeap);
+		job.reset();
+		WOLF_CHECK(!job);
+		WOLF_CHECK_EQUAL(liveCount.load(), 0);
+
+		// Assigning over a job destroys its capture
+		Wolf::Job firstJob = createTrackedJob(liveCount, callCount, storedOnHeap);
+		firstJob = createTrackedJob(liveCount, callCount, !storedOnHeap);
+		WOLF_CHECK_EQUAL(liveCount.load(), 1);
+		firstJob();
+		WOLF_CHECK_EQUAL(callCount, 1u);
+
+		{
+			const Wolf::Job scopedJob = createTrackedJob(liveCount, callCount, storedOnHeap);
+			WOLF_CHECK_EQUAL(liveCount.load(), 2);
+		}
+		WOLF_CHECK_EQUAL(liveCount.load(), 1);
+		firstJob.reset();
+		WOLF_CHECK_EQUAL(liveCount.load(), 0);
+	}
+}
+
+WOLF_TEST(ArenaKeepsAddressesAndMemory)
+{
+	std::atomic<int32_t> liveCount = 0;
+	uint32_t callCount = 0;
+	Wolf::JobArena jobArena;
+
+	// Several blocks, earlier jobs stay valid while the arena grows
+	constexpr uint32_t JOB_COUNT = 200;
+	std::vector<Wolf::Job*> jobs;
+	for (uint32_t jobIdx = 0; jobIdx < JOB_COUNT; ++jobIdx)
+		jobs.push_back(jobArena.allocate(createTrackedJob(liveCount, callCount, jobIdx % 10 == 0)));
+	WOLF_CHECK_EQUAL(liveCount.load(), static_cast<int32_t>(JOB_COUNT));
+	for (Wolf::Job* job : jobs)
+		(*job)();
+	WOLF_CHECK_EQUAL(callCount, JOB_COUNT);
+
+	jobArena.reset();
+	WOLF_CHECK_EQUAL(liveCount.load(), 0);
+
+	// Warmed up, inline jobs don't allocate and reuse the same addresses
+	const uint32_t allocationCountBefore = g_allocationCount;
+	uint32_t sameAddressCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < JOB_COUNT; ++jobIdx)
+	{
+		if (jobArena.allocate(createTrackedJob(liveCount, callCount, false)) == jobs[jobIdx])
+			sameAddressCount++;
+	}
+	WOLF_CHECK_EQUAL(g_allocationCount - allocationCountBefore, 0u);
+	WOLF_CHECK_EQUAL(sameAddressCount, JOB_COUNT);
+	jobArena.reset();
+	WOLF_CHECK_EQUAL(liveCount.load(), 0);
+}
+
+WOLF_TEST(ArenaResetWhenMovingToNextFrame)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(2, "Test");
+
+	std::atomic<int32_t> liveCount = 0;
+	std::atomic<uint32_t> spawnedCallCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < 16; ++jobIdx)
+	{
+		multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&, tracker = Tracker(liveCount)]()
+		{
+			for (uint32_t spawnIdx = 0; spawnIdx < 10; ++spawnIdx)
+				multiThreadTaskManager.spawnJobInThreadGroup(threadGroupId, [&spawnedCallCount, tracker = Tracker(liveCount)]() { spawnedCallCount++; });
+		});
+	}
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(spawnedCallCount.load(), 160u);
+
+	// Executed jobs and the slot arenas are cleared when the next frame starts
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(liveCount.load(), 0);
+}
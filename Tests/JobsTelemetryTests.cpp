@@ -0,0 +1,253 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "JobsManager.h"
+#include "JobsTelemetry.h"
+#include "JobsTestHelpers.h"
+#include "TestFramework.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	uint64_t getStateTimeNs(const Wolf::JobsTelemetry::Snapshot& snapshot, const std::string& threadNamePrefix, Wolf::JobsTelemetry::ThreadState state)
+	{
+		uint64_t timeNs = 0;
+		for (const Wolf::JobsTelemetry::ThreadStats& threadStats : snapshot.m_threads)
+		{
+			if (threadStats.m_name.starts_with(threadNamePrefix))
+				timeNs += threadStats.m_timesNs[static_cast<size_t>(state)];
+		}
+		return timeNs;
+	}
+
+	uint64_t getExecutedJobCount(const Wolf::JobsTelemetry::Snapshot& snapshot)
+	{
+		uint64_t executedJobCount = 0;
+		for (const Wolf::JobsTelemetry::ThreadStats& threadStats : snapshot.m_threads)
+			executedJobCount += threadStats.m_executedJobCount;
+		return executedJobCount;
+	}
+
+	uint64_t toNs(Clock::duration duration)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	}
+}
+
+WOLF_TEST(WaitingJobIsNotCountedBusy)
+{
+	Wolf::JobsManager jobsManager(1);
+	Wolf::ResourceNonOwner<Wolf::JobsTelemetry> telemetry = jobsManager.getTelemetry();
+	telemetry->setEnabled(true);
+
+	for (uint32_t executionIdx = 0; executionIdx < 3; ++executionIdx)
+	{
+		telemetry->reset();
+
+		// Whichever thread runs the waiting job, only the slept job is busy time
+		std::atomic<uint64_t> sleptJobDurationNs = 0;
+		const Wolf::JobsManager::JobHandle sleptJob = jobsManager.addJobBeforeFrame([&]()
+		{
+			const Clock::time_point start = Clock::now();
+			std::this_thread::sleep_for(std::chrono::milliseconds(30));
+			sleptJobDurationNs = toNs(Clock::now() - start);
+		});
+		jobsManager.addJobBeforeFrame([&jobsManager, sleptJob]() { jobsManager.waitForJob(sleptJob); });
+		jobsManager.executeJobsBeforeFrame();
+
+		const Wolf::JobsTelemetry::Snapshot snapshot = telemetry->getSnapshot();
+		const uint64_t busyTimeNs = getStateTimeNs(snapshot, "Main", Wolf::JobsTelemetry::ThreadState::BUSY) + getStateTimeNs(snapshot, "BeforeFrame", Wolf::JobsTelemetry::ThreadState::BUSY);
+		WOLF_CHECK(busyTimeNs >= sleptJobDurationNs.load());
+		WOLF_CHECK(busyTimeNs < sleptJobDurationNs.load() * 3 / 2);
+	}
+}
+
+WOLF_TEST(StreamingThreadBusyAndIdleTimes)
+{
+	Wolf::JobsManager jobsManager(1, 1);
+	Wolf::ResourceNonOwner<Wolf::JobsTelemetry> telemetry = jobsManager.getTelemetry();
+	telemetry->setEnabled(true);
+
+	// The streaming thread starts an idle scope with telemetry enabled once it has executed a job
+	std::atomic<uint32_t> executedCount = 0;
+	jobsManager.addStreamingJob([&]() { executedCount++; });
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, 1));
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+	jobsManager.addStreamingJob([&]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		executedCount++;
+	});
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, 2));
+	std::this_thread::sleep_for(std::chrono::milliseconds(5)); // busy scope ends after the counter is incremented
+
+	const Wolf::JobsTelemetry::Snapshot snapshot = telemetry->getSnapshot();
+	WOLF_CHECK(getStateTimeNs(snapshot, "Streaming", Wolf::JobsTelemetry::ThreadState::IDLE) >= 20'000'000u);
+	WOLF_CHECK(getStateTimeNs(snapshot, "Streaming", Wolf::JobsTelemetry::ThreadState::BUSY) >= 20'000'000u);
+	WOLF_CHECK_EQUAL(getStateTimeNs(snapshot, "Streaming", Wolf::JobsTelemetry::ThreadState::WAIT), 0u);
+}
+
+WOLF_TEST(QueueDepthHighWaterMarks)
+{
+	Wolf::JobsManager jobsManager(2, 1);
+	Wolf::ResourceNonOwner<Wolf::JobsTelemetry> telemetry = jobsManager.getTelemetry();
+	telemetry->setEnabled(true);
+
+	for (const uint32_t jobCount : { 10u, 4u })
+	{
+		for (uint32_t jobIdx = 0; jobIdx < jobCount; ++jobIdx)
+			jobsManager.addJobBeforeFrame([]() {});
+		jobsManager.executeJobsBeforeFrame();
+	}
+
+	std::atomic<uint32_t> executedCount = 0;
+	Wolf::Tests::StreamingThreadBlocker blocker(jobsManager);
+	for (uint32_t jobIdx = 0; jobIdx < 5; ++jobIdx)
+		jobsManager.addStreamingJob([&]() { executedCount++; });
+	blocker.release();
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, 5));
+
+	const Wolf::JobsTelemetry::Snapshot snapshot = telemetry->getSnapshot();
+	WOLF_CHECK_EQUAL(snapshot.m_queueDepthHighWaterMarks[static_cast<size_t>(Wolf::JobsTelemetry::QueueType::BEFORE_FRAME)], 10u);
+	WOLF_CHECK_EQUAL(snapshot.m_queueDepthHighWaterMarks[static_cast<size_t>(Wolf::JobsTelemetry::QueueType::STREAMING)], 5u);
+
+	telemetry->reset();
+	WOLF_CHECK_EQUAL(telemetry->getSnapshot().m_queueDepthHighWaterMarks[static_cast<size_t>(Wolf::JobsTelemetry::QueueType::BEFORE_FRAME)], 0u);
+}
+
+WOLF_TEST(JobsPerFrame)
+{
+	Wolf::JobsManager jobsManager(2);
+	Wolf::ResourceNonOwner<Wolf::JobsTelemetry> telemetry = jobsManager.getTelemetry();
+	telemetry->setEnabled(true);
+
+	for (const uint32_t jobCount : { 3u, 7u, 5u })
+	{
+		Wolf::JobsManager::JobHandle previousJob;
+		for (uint32_t jobIdx = 0; jobIdx < jobCount; ++jobIdx)
+		{
+			// Continuations spawned by workers are counted in the same frame
+			previousJob = jobIdx % 2 ? jobsManager.addContinuationBeforeFrame(previousJob, []() {}) : jobsManager.addJobBeforeFrame([]() {});
+		}
+		jobsManager.executeJobsBeforeFrame();
+	}
+
+	const Wolf::JobsTelemetry::Snapshot snapshot = telemetry->getSnapshot();
+	WOLF_CHECK_EQUAL(snapshot.m_frameCount, 3u);
+	WOLF_CHECK_EQUAL(snapshot.m_lastFrameExecutedJobCount, 5u);
+	WOLF_CHECK_EQUAL(snapshot.m_maxFrameExecutedJobCount, 7u);
+	WOLF_CHECK_EQUAL(getExecutedJobCount(snapshot), 15u);
+}
+
+WOLF_TEST(StreamingJobLatencies)
+{
+	Wolf::JobsManager jobsManager(1, 1);
+	Wolf::ResourceNonOwner<Wolf::JobsTelemetry> telemetry = jobsManager.getTelemetry();
+
+	// Added before telemetry is enabled, not measured
+	Wolf::Tests::StreamingThreadBlocker blocker(jobsManager);
+	telemetry->setEnabled(true);
+
+	std::atomic<uint32_t> executedCount = 0;
+	const Clock::time_point addTime = Clock::now();
+	jobsManager.addStreamingJob([&]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		executedCount++;
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	blocker.release();
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, 1));
+	const uint64_t addToEndNs = toNs(Clock::now() - addTime);
+
+	const Wolf::JobsTelemetry::Snapshot snapshot = telemetry->getSnapshot();
+	WOLF_CHECK_EQUAL(snapshot.m_streamingQueueLatency.m_count, 1u);
+	WOLF_CHECK_EQUAL(snapshot.m_streamingExecutionLatency.m_count, 1u);
+	WOLF_CHECK(snapshot.m_streamingQueueLatency.m_maxNs >= 30'000'000u);
+	WOLF_CHECK(snapshot.m_streamingExecutionLatency.m_maxNs >= 10'000'000u);
+	WOLF_CHECK(snapshot.m_streamingQueueLatency.m_totalNs + snapshot.m_streamingExecutionLatency.m_totalNs <= addToEndNs);
+}
+
+WOLF_TEST(TagHistograms)
+{
+	WOLF_CHECK_EQUAL(Wolf::JobsTelemetry::computeHistogramBucketIdx(std::chrono::microseconds(0)), 0u);
+	WOLF_CHECK_EQUAL(Wolf::JobsTelemetry::computeHistogramBucketIdx(std::chrono::microseconds(1)), 0u);
+	WOLF_CHECK_EQUAL(Wolf::JobsTelemetry::computeHistogramBucketIdx(std::chrono::microseconds(3)), 1u);
+	WOLF_CHECK_EQUAL(Wolf::JobsTelemetry::computeHistogramBucketIdx(std::chrono::microseconds(4)), 2u);
+	WOLF_CHECK_EQUAL(Wolf::JobsTelemetry::computeHistogramBucketIdx(std::chrono::microseconds(1023)), 9u);
+	WOLF_CHECK_EQUAL(Wolf::JobsTelemetry::computeHistogramBucketIdx(std::chrono::microseconds(1024)), 10u);
+	WOLF_CHECK_EQUAL(Wolf::JobsTelemetry::computeHistogramBucketIdx(std::chrono::hours(1)), Wolf::JobsTelemetry::HISTOGRAM_BUCKET_COUNT - 1);
+
+	Wolf::JobsManager jobsManager(2, 1);
+	Wolf::ResourceNonOwner<Wolf::JobsTelemetry> telemetry = jobsManager.getTelemetry();
+	telemetry->setEnabled(true);
+
+	// Same tag from another string, merged in the snapshot
+	static const char sameTagOtherString[] = "Sleep";
+	for (uint32_t jobIdx = 0; jobIdx < 4; ++jobIdx)
+		jobsManager.addJobBeforeFrame([]() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }, {}, jobIdx % 2 ? "Sleep" : sameTagOtherString);
+	jobsManager.addJobBeforeFrame([]() {}, {}, "Empty");
+	jobsManager.addJobBeforeFrame([]() {});
+	jobsManager.executeJobsBeforeFrame();
+
+	std::atomic<uint32_t> executedCount = 0;
+	jobsManager.addStreamingJob([&]() { executedCount++; }, 0, nullptr, "Empty");
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, 1));
+	std::this_thread::sleep_for(std::chrono::milliseconds(5)); // tag is recorded after the job returns
+
+	const Wolf::JobsTelemetry::Snapshot snapshot = telemetry->getSnapshot();
+	WOLF_CHECK_EQUAL(snapshot.m_tags.size(), 2u);
+
+	const Wolf::JobsTelemetry::TagStats& sleepStats = snapshot.m_tags.at("Sleep");
+	WOLF_CHECK_EQUAL(sleepStats.m_duration.m_count, 4u);
+	WOLF_CHECK(sleepStats.m_duration.m_totalNs >= 4 * 2'000'000u);
+	uint64_t sleepHistogramCount = 0;
+	for (uint32_t bucketIdx = 0; bucketIdx < Wolf::JobsTelemetry::HISTOGRAM_BUCKET_COUNT; ++bucketIdx)
+	{
+		// 2 ms are in [2^10, 2^11) us
+		WOLF_CHECK(bucketIdx >= 10 || sleepStats.m_histogram[bucketIdx] == 0);
+		sleepHistogramCount += sleepStats.m_histogram[bucketIdx];
+	}
+	WOLF_CHECK_EQUAL(sleepHistogramCount, 4u);
+
+	const Wolf::JobsTelemetry::TagStats& emptyStats = snapshot.m_tags.at("Empty");
+	WOLF_CHECK_EQUAL(emptyStats.m_duration.m_count, 2u);
+}
+
+WOLF_TEST(DisabledTelemetryRecordsNothing)
+{
+	Wolf::JobsManager jobsManager(2, 1);
+	Wolf::ResourceNonOwner<Wolf::JobsTelemetry> telemetry = jobsManager.getTelemetry();
+	WOLF_CHECK(!telemetry->isEnabled());
+
+	for (uint32_t executionIdx = 0; executionIdx < 3; ++executionIdx)
+	{
+		const Wolf::JobsManager::JobHandle job = jobsManager.addJobBeforeFrame([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }, {}, "Tagged");
+		jobsManager.addJobBeforeFrame([&jobsManager, job]() { jobsManager.waitForJob(job); });
+		jobsManager.executeJobsBeforeFrame();
+	}
+	std::atomic<uint32_t> executedCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < 3; ++jobIdx)
+		jobsManager.addStreamingJob([&]() { executedCount++; }, 0, nullptr, "Tagged");
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, 3));
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+	const Wolf::JobsTelemetry::Snapshot snapshot = telemetry->getSnapshot();
+	for (const Wolf::JobsTelemetry::ThreadStats& threadStats : snapshot.m_threads)
+	{
+		for (const uint64_t timeNs : threadStats.m_timesNs)
+			WOLF_CHECK_EQUAL(timeNs, 0u);
+		WOLF_CHECK_EQUAL(threadStats.m_executedJobCount, 0u);
+	}
+	for (const uint32_t highWaterMark : snapshot.m_queueDepthHighWaterMarks)
+		WOLF_CHECK_EQUAL(highWaterMark, 0u);
+	WOLF_CHECK_EQUAL(snapshot.m_frameCount, 0u);
+	WOLF_CHECK_EQUAL(snapshot.m_maxFrameExecutedJobCount, 0u);
+	WOLF_CHECK_EQUAL(snapshot.m_streamingQueueLatency.m_count, 0u);
+	WOLF_CHECK_EQUAL(snapshot.m_streamingExecutionLatency.m_count, 0u);
+	WOLF_CHECK(snapshot.m_tags.empty());
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "JobsManager.h"
+
+namespace Wolf::Tests
+{
+	// Waits up to 10 seconds for a counter incremented by jobs, returns false on timeout
+	inline bool waitForCount(const std::atomic<uint32_t>& count, uint32_t expectedCount)
+	{
+		const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (count.load() < expectedCount)
+		{
+			if (std::chrono::steady_clock::now() > timeout)
+				return false;
+			std::this_thread::yield();
+		}
+		return true;
+	}
+
+	// Holds the only streaming thread so the following jobs stay pending
+	class StreamingThreadBlocker
+	{
+	public:
+		explicit StreamingThreadBlocker(JobsManager& jobsManager)
+		{
+			jobsManager.addStreamingJob([this]()
+			{
+				m_started = true;
+				while (!m_released)
+					std::this_thread::yield();
+			}, UINT32_MAX - 1);
+
+			while (!m_started)
+				std::this_thread::yield();
+		}
+
+		void release() { m_released = true; }
+
+	private:
+		std::atomic<bool> m_started = false;
+		std::atomic<bool> m_released = false;
+	};
+
+	// Ids of the jobs in the order they ran, filled from any thread
+	class ExecutionOrder
+	{
+	public:
+		void add(uint32_t jobId)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_order.push_back(jobId);
+			m_count++;
+		}
+
+		// Index in the execution order, -1 if the job hasn't been executed
+		int32_t getPosition(uint32_t jobId) const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (uint32_t i = 0; i < m_order.size(); ++i)
+			{
+				if (m_order[i] == jobId)
+					return static_cast<int32_t>(i);
+			}
+			return -1;
+		}
+
+		std::vector<uint32_t> getOrder() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_order;
+		}
+
+		uint32_t getCount() const { return m_count.load(); }
+		bool waitForCount(uint32_t expectedCount) const { return Tests::waitForCount(m_count, expectedCount); }
+
+	private:
+		mutable std::mutex m_mutex;
+		std::vector<uint32_t> m_order;
+		std::atomic<uint32_t> m_count = 0;
+	};
+}
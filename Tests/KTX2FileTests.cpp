@@ -0,0 +1,281 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AsyncFileReader.h"
+#include "ImageCompression.h"
+#include "KTX2File.h"
+#include "TestFramework.h"
+
+namespace
+{
+	struct Layout
+	{
+		const char* name;
+		Wolf::Format format;
+		Wolf::Extent3D extent;
+		uint32_t arrayLayerCount;
+		uint32_t faceCount;
+		uint32_t mipLevelCount;
+		uint32_t texelOrBlockSize;
+		bool isCompressed;
+	};
+
+	std::string getFilepath(const std::string& name)
+	{
+		return "KTX2FileTests_" + name + ".ktx2";
+	}
+
+	// One vector per mip level with the surfaces of all layers and faces, filled with random bytes
+	std::vector<std::vector<uint8_t>> createLevels(const Layout& layout, std::mt19937& randomEngine)
+	{
+		std::vector<std::vector<uint8_t>> levels(layout.mipLevelCount);
+		for (uint32_t mipLevel = 0; mipLevel < layout.mipLevelCount; ++mipLevel)
+		{
+			const uint32_t width = std::max(layout.extent.width >> mipLevel, 1u), height = std::max(layout.extent.height >> mipLevel, 1u), depth = std::max(layout.extent.depth >> mipLevel, 1u);
+			const size_t surfaceSize = layout.isCompressed ? static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * depth * layout.texelOrBlockSize :
+				static_cast<size_t>(width) * height * depth * layout.texelOrBlockSize;
+
+			levels[mipLevel].resize(surfaceSize * layout.arrayLayerCount * layout.faceCount);
+			for (uint8_t& byte : levels[mipLevel])
+				byte = static_cast<uint8_t>(randomEngine());
+		}
+		return levels;
+	}
+
+	std::vector<uint8_t> readFile(const std::string& filepath)
+	{
+		std::ifstream file(filepath, std::ios::binary);
+		return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	}
+
+	void writeFile(const std::string& filepath, const std::vector<uint8_t>& bytes)
+	{
+		std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+}
+
+WOLF_TEST(RoundTripLayouts)
+{
+	const Layout layouts[] =
+	{
+		{ "rgba8_mips", Wolf::Format::R8G8B8A8_SRGB, { 300, 200, 1 }, 1, 1, 9, 4, false },
+		{ "r8_npot", Wolf::Format::R8_UNORM, { 33, 7, 1 }, 1, 1, 6, 1, false },
+		{ "bc1", Wolf::Format::BC1_RGB_SRGB_BLOCK, { 256, 128, 1 }, 1, 1, 9, 8, true },
+		{ "bc7_array", Wolf::Format::BC7_UNORM_BLOCK, { 64, 64, 1 }, 3, 1, 7, 16, true },
+		{ "rgba16f_cube", Wolf::Format::R16G16B16A16_SFLOAT, { 32, 32, 1 }, 1, 6, 6, 8, false },
+		{ "bc6h_cube_array", Wolf::Format::BC6H_UFLOAT_BLOCK, { 16, 16, 1 }, 2, 6, 5, 16, true },
+		{ "r32f_volume", Wolf::Format::R32_SFLOAT, { 16, 8, 4 }, 1, 1, 5, 4, false },
+		{ "bc5_1d", Wolf::Format::BC5_UNORM_BLOCK, { 64, 1, 1 }, 1, 1, 7, 16, true },
+	};
+
+	std::mt19937 randomEngine(5);
+	for (const Layout& layout : layouts)
+	{
+		const std::vector<std::vector<uint8_t>> levels = createLevels(layout, randomEngine);
+
+		Wolf::KTX2File::WriteInfo writeInfo;
+		writeInfo.format = layout.format;
+		writeInfo.extent = layout.extent;
+		writeInfo.arrayLayerCount = layout.arrayLayerCount;
+		writeInfo.faceCount = layout.faceCount;
+		for (const std::vector<uint8_t>& level : levels)
+			writeInfo.addLevel(level);
+
+		const std::string filepath = getFilepath(layout.name);
+		WOLF_CHECK(Wolf::KTX2File::write(filepath, writeInfo));
+
+		const Wolf::KTX2File file(filepath);
+		WOLF_CHECK(file.isValid());
+		if (!file.isValid())
+			continue;
+
+		WOLF_CHECK_EQUAL(Wolf::formatToString(file.getFormat()), Wolf::formatToString(layout.format));
+		WOLF_CHECK_EQUAL(file.getCompression() != Wolf::ImageCompression::Compression::NO_COMPRESSION, layout.isCompressed);
+		WOLF_CHECK_EQUAL(file.getExtent().width, layout.extent.width);
+		WOLF_CHECK_EQUAL(file.getExtent().height, layout.extent.height);
+		WOLF_CHECK_EQUAL(file.getExtent().depth, layout.extent.depth);
+		WOLF_CHECK_EQUAL(file.getMipLevelCount(), layout.mipLevelCount);
+		WOLF_CHECK_EQUAL(file.getArrayLayerCount(), layout.arrayLayerCount);
+		WOLF_CHECK_EQUAL(file.getFaceCount(), layout.faceCount);
+
+		for (uint32_t mipLevel = 0; mipLevel < layout.mipLevelCount; ++mipLevel)
+		{
+			const size_t surfaceSize = levels[mipLevel].size() / (static_cast<size_t>(layout.arrayLayerCount) * layout.faceCount);
+			for (uint32_t arrayLayer = 0; arrayLayer < layout.arrayLayerCount; ++arrayLayer)
+			{
+				for (uint32_t face = 0; face < layout.faceCount; ++face)
+				{
+					const size_t offsetInLevel = (static_cast<size_t>(arrayLayer) * layout.faceCount + face) * surfaceSize;
+					const std::span<const uint8_t> surface = file.getSurface(mipLevel, arrayLayer, face);
+					WOLF_CHECK_EQUAL(surface.size(), surfaceSize);
+					WOLF_CHECK(std::memcmp(surface.data(), levels[mipLevel].data() + offsetInLevel, surfaceSize) == 0);
+					WOLF_CHECK_EQUAL(file.getSurfaceOffsetInLevel(mipLevel, arrayLayer, face), offsetInLevel);
+				}
+			}
+
+			// A single level is read from the index without the mapping
+			const Wolf::KTX2File::LevelByteRange levelByteRange = file.getLevelByteRange(mipLevel);
+			WOLF_CHECK_EQUAL(levelByteRange.m_offset % 4, 0u);
+			WOLF_CHECK_EQUAL(levelByteRange.m_offset % layout.texelOrBlockSize, 0u);
+
+			Wolf::AsyncFileReader::ReadResult readResult;
+			Wolf::AsyncFileReader::readFile(filepath, levelByteRange.m_offset, levelByteRange.m_size, readResult);
+			WOLF_CHECK(readResult.m_success);
+			WOLF_CHECK(readResult.m_data == levels[mipLevel]);
+		}
+
+		// Smallest levels are first in the file so they can be streamed before the others
+		WOLF_CHECK(file.getLevelByteRange(layout.mipLevelCount - 1).m_offset < file.getLevelByteRange(0).m_offset);
+	}
+}
+
+WOLF_TEST(ExportsCompressedMips)
+{
+	constexpr uint32_t SIZE = 128;
+	constexpr uint32_t MIP_LEVEL_COUNT = 6;
+
+	// Each mip is a box filtered version of the previous one
+	std::vector<std::vector<Wolf::ImageCompression::RGBA8>> mips(MIP_LEVEL_COUNT);
+	mips[0].resize(SIZE * SIZE);
+	for (uint32_t y = 0; y < SIZE; ++y)
+		for (uint32_t x = 0; x < SIZE; ++x)
+			mips[0][x + y * SIZE] = Wolf::ImageCompression::RGBA8(static_cast<uint8_t>(x * 2), static_cast<uint8_t>(y * 2), static_cast<uint8_t>((x ^ y) * 2), 255);
+	for (uint32_t mipLevel = 1; mipLevel < MIP_LEVEL_COUNT; ++mipLevel)
+	{
+		const uint32_t mipSize = SIZE >> mipLevel;
+		mips[mipLevel].resize(static_cast<size_t>(mipSize) * mipSize);
+		for (uint32_t y = 0; y < mipSize; ++y)
+		{
+			for (uint32_t x = 0; x < mipSize; ++x)
+			{
+				for (uint32_t channelIdx = 0; channelIdx < 4; ++channelIdx)
+				{
+					const std::vector<Wolf::ImageCompression::RGBA8>& previousMip = mips[mipLevel - 1];
+					const uint32_t sum = previousMip[2 * x + 2 * y * 2 * mipSize][channelIdx] + previousMip[2 * x + 1 + 2 * y * 2 * mipSize][channelIdx] +
+						previousMip[2 * x + (2 * y + 1) * 2 * mipSize][channelIdx] + previousMip[2 * x + 1 + (2 * y + 1) * 2 * mipSize][channelIdx];
+					mips[mipLevel][x + y * mipSize][channelIdx] = static_cast<uint8_t>((sum + 2) / 4);
+				}
+			}
+		}
+	}
+
+	std::vector<std::vector<Wolf::ImageCompression::BC3>> blocks(MIP_LEVEL_COUNT);
+	Wolf::KTX2File::WriteInfo writeInfo;
+	writeInfo.format = Wolf::Format::BC3_SRGB_BLOCK;
+	writeInfo.extent = { SIZE, SIZE, 1 };
+	for (uint32_t mipLevel = 0; mipLevel < MIP_LEVEL_COUNT; ++mipLevel)
+	{
+		Wolf::ImageCompression::compress(Wolf::Extent3D{ SIZE >> mipLevel, SIZE >> mipLevel, 1 }, mips[mipLevel], blocks[mipLevel], Wolf::ImageCompression::Quality::FAST);
+		writeInfo.addLevel(blocks[mipLevel]);
+	}
+
+	const std::string filepath = getFilepath("export");
+	WOLF_CHECK(Wolf::KTX2File::write(filepath, writeInfo));
+
+	const Wolf::KTX2File file(filepath);
+	WOLF_CHECK(file.isValid());
+	WOLF_CHECK(file.getCompression() == Wolf::ImageCompression::Compression::BC3);
+	WOLF_CHECK_EQUAL(file.getMipLevelCount(), MIP_LEVEL_COUNT);
+	for (uint32_t mipLevel = 0; mipLevel < file.getMipLevelCount(); ++mipLevel)
+	{
+		const std::span<const uint8_t> surface = file.getSurface(mipLevel);
+		WOLF_CHECK_EQUAL(surface.size(), blocks[mipLevel].size() * sizeof(Wolf::ImageCompression::BC3));
+		WOLF_CHECK(std::memcmp(surface.data(), blocks[mipLevel].data(), surface.size()) == 0);
+	}
+}
+
+WOLF_TEST(RejectsMalformedFiles)
+{
+	// Level 0 of the source file is its last 300x200 RGBA8 surface
+	std::mt19937 randomEngine(7);
+	const Layout layout = { "source", Wolf::Format::R8G8B8A8_UNORM, { 300, 200, 1 }, 1, 1, 9, 4, false };
+	const std::vector<std::vector<uint8_t>> levels = createLevels(layout, randomEngine);
+	Wolf::KTX2File::WriteInfo writeInfo;
+	writeInfo.format = layout.format;
+	writeInfo.extent = layout.extent;
+	for (const std::vector<uint8_t>& level : levels)
+		writeInfo.addLevel(level);
+	WOLF_CHECK(Wolf::KTX2File::write(getFilepath(layout.name), writeInfo));
+	const std::vector<uint8_t> sourceBytes = readFile(getFilepath(layout.name));
+
+	struct Corruption
+	{
+		const char* name;
+		size_t offset;
+		std::vector<uint8_t> bytes;
+		size_t truncatedSize = 0;
+	};
+	const Corruption corruptions[] =
+	{
+		{ "bad_identifier", 1, { 'X' } },
+		{ "truncated_header", 0, {}, 60 },
+		{ "truncated_level_index", 0, {}, 100 },
+		{ "truncated", 0, {}, sourceBytes.size() - 1 },
+		{ "bad_format", 12, { 0xff, 0xff, 0, 0 } },
+		{ "zero_width", 20, { 0, 0, 0, 0 } },
+		{ "huge_width", 20, { 0, 0, 0x10, 0 } },
+		{ "bad_face_count", 36, { 3, 0, 0, 0 } },
+		{ "too_many_levels", 40, { 20, 0, 0, 0 } },
+		{ "supercompressed", 44, { 2, 0, 0, 0 } },
+		{ "huge_level_offset", 80, { 0, 0, 0, 0, 0, 0, 0, 0x80 } },
+		{ "bad_level_length", 88, { 1, 0, 0, 0 } },
+	};
+
+	for (const Corruption& corruption : corruptions)
+	{
+		std::vector<uint8_t> bytes = sourceBytes;
+		if (corruption.truncatedSize != 0)
+			bytes.resize(corruption.truncatedSize);
+		else
+			std::memcpy(bytes.data() + corruption.offset, corruption.bytes.data(), corruption.bytes.size());
+		writeFile(getFilepath(corruption.name), bytes);
+
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+		const Wolf::KTX2File file(getFilepath(corruption.name));
+		WOLF_CHECK(!file.isValid());
+	}
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(4);
+	WOLF_CHECK(!Wolf::KTX2File(getFilepath("missing")).isValid());
+
+	const Wolf::KTX2File file(getFilepath(layout.name));
+	WOLF_CHECK(file.getSurface(9).empty());
+	WOLF_CHECK(file.getLevelByteRange(9).m_size == 0);
+	WOLF_CHECK(file.getSurface(0, 1).empty());
+}
+
+WOLF_TEST(RejectsInvalidWrites)
+{
+	const std::vector<uint8_t> data(64);
+
+	Wolf::KTX2File::WriteInfo depthFormat;
+	depthFormat.format = Wolf::Format::D32_SFLOAT;
+	depthFormat.extent = { 4, 4, 1 };
+	depthFormat.addLevel(data);
+
+	Wolf::KTX2File::WriteInfo wrongSize;
+	wrongSize.format = Wolf::Format::R8_UNORM;
+	wrongSize.extent = { 4, 4, 1 };
+	wrongSize.levels.emplace_back(data.data(), 15);
+
+	Wolf::KTX2File::WriteInfo tooManyLevels;
+	tooManyLevels.format = Wolf::Format::R8_UNORM;
+	tooManyLevels.extent = { 1, 1, 1 };
+	tooManyLevels.levels.emplace_back(data.data(), 1);
+	tooManyLevels.levels.emplace_back(data.data(), 1);
+
+	Wolf::KTX2File::WriteInfo nonSquareCube;
+	nonSquareCube.format = Wolf::Format::R8_UNORM;
+	nonSquareCube.extent = { 4, 2, 1 };
+	nonSquareCube.faceCount = 6;
+	nonSquareCube.levels.emplace_back(data.data(), 48);
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(4);
+	for (const Wolf::KTX2File::WriteInfo* writeInfo : { &depthFormat, &wrongSize, &tooManyLevels, &nonSquareCube })
+		WOLF_CHECK(!Wolf::KTX2File::write(getFilepath("invalid_write"), *writeInfo));
+}
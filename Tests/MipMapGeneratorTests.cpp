@@ -0,0 +1,270 @@
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include "JobsManager.h"
+#include "MipMapGenerator.h"
+#include "TestFramework.h"
+
+namespace
+{
+	// Column by column 2x2 average of the first generator, kept as the reference of the legacy box filter
+	void createReferenceMipLevel(const Wolf::ImageCompression::RGBA8* previousMip, Wolf::ImageCompression::RGBA8* currentMip, uint32_t width, uint32_t height)
+	{
+		for (uint32_t x = 0; x < width; x += 2)
+		{
+			for (uint32_t y = 0; y < height; y += 2)
+			{
+				currentMip[x / 2 + (y / 2) * (width / 2)] = Wolf::ImageCompression::RGBA8::mergeBlock(previousMip[x + y * width], previousMip[x + (y + 1) * width],
+					previousMip[(x + 1) + y * width], previousMip[(x + 1) + (y + 1) * width]);
+			}
+		}
+	}
+
+	void createReferenceMipLevel(const Wolf::ImageCompression::RG32F* previousMip, Wolf::ImageCompression::RG32F* currentMip, uint32_t width, uint32_t height)
+	{
+		for (uint32_t x = 0; x < width; x += 2)
+		{
+			for (uint32_t y = 0; y < height; y += 2)
+			{
+				const Wolf::ImageCompression::RG32F mergedPixel = Wolf::ImageCompression::RG32F::mergeBlock(previousMip[x + y * width], previousMip[x + (y + 1) * width],
+					previousMip[(x + 1) + y * width], previousMip[(x + 1) + (y + 1) * width]);
+				const glm::vec3 normal = glm::normalize(glm::vec3(mergedPixel.r, mergedPixel.g, glm::sqrt(1.0f - mergedPixel.r * mergedPixel.r - mergedPixel.g * mergedPixel.g)));
+				currentMip[x / 2 + (y / 2) * (width / 2)] = Wolf::ImageCompression::RG32F(normal.x, normal.y);
+			}
+		}
+	}
+
+	template <typename PixelType>
+	bool isSameAsReference(const std::vector<PixelType>& pixels, uint32_t width, uint32_t height, Wolf::Format format, bool parallel)
+	{
+		Wolf::MipMapGenerator::GenerationInfo generationInfo;
+		generationInfo.filter = Wolf::MipMapGenerator::Filter::BOX_LEGACY;
+		generationInfo.parallel = parallel;
+		const Wolf::MipMapGenerator mipMapGenerator(reinterpret_cast<const unsigned char*>(pixels.data()), { width, height }, format, -1, generationInfo);
+		if (mipMapGenerator.getMipLevelCount() != Wolf::MipMapGenerator::computeMipCount({ width, height }))
+			return false;
+
+		std::vector<PixelType> previousMip = pixels;
+		for (uint32_t mipLevel = 1; mipLevel < mipMapGenerator.getMipLevelCount(); ++mipLevel)
+		{
+			std::vector<PixelType> currentMip(previousMip.size() / 4);
+			createReferenceMipLevel(previousMip.data(), currentMip.data(), width >> (mipLevel - 1), height >> (mipLevel - 1));
+
+			const std::vector<unsigned char>& mip = mipMapGenerator.getMipLevel(mipLevel);
+			if (mip.size() != currentMip.size() * sizeof(PixelType) || std::memcmp(mip.data(), currentMip.data(), mip.size()) != 0)
+				return false;
+			previousMip = std::move(currentMip);
+		}
+		return true;
+	}
+
+	uint32_t getTexelSize(Wolf::Format format)
+	{
+		switch (format)
+		{
+			case Wolf::Format::R8G8_UNORM:
+				return 2;
+			case Wolf::Format::R8G8B8A8_UNORM:
+			case Wolf::Format::R8G8B8A8_SRGB:
+				return 4;
+			case Wolf::Format::R16G16B16A16_SFLOAT:
+			case Wolf::Format::R32G32_SFLOAT:
+				return 8;
+			default:
+				return 16;
+		}
+	}
+
+	std::vector<uint8_t> createNoise(uint32_t width, uint32_t height, Wolf::Format format)
+	{
+		std::mt19937 randomEngine(7);
+		std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+		std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * getTexelSize(format));
+		if (format == Wolf::Format::R32G32_SFLOAT || format == Wolf::Format::R32G32B32A32_SFLOAT)
+		{
+			for (size_t valueIdx = 0; valueIdx < pixels.size() / sizeof(float); ++valueIdx)
+				reinterpret_cast<float*>(pixels.data())[valueIdx] = distribution(randomEngine) * 1.2f - 0.6f;
+		}
+		else if (format == Wolf::Format::R16G16B16A16_SFLOAT)
+		{
+			for (size_t valueIdx = 0; valueIdx < pixels.size() / sizeof(uint16_t); ++valueIdx)
+				reinterpret_cast<uint16_t*>(pixels.data())[valueIdx] = glm::packHalf1x16(distribution(randomEngine) * 4.0f);
+		}
+		else
+		{
+			for (uint8_t& value : pixels)
+				value = static_cast<uint8_t>(distribution(randomEngine) * 255.0f);
+		}
+		return pixels;
+	}
+
+	constexpr Wolf::Format ALL_FORMATS[] = { Wolf::Format::R8G8B8A8_UNORM, Wolf::Format::R8G8B8A8_SRGB, Wolf::Format::R8G8_UNORM, Wolf::Format::R16G16B16A16_SFLOAT,
+		Wolf::Format::R32G32_SFLOAT, Wolf::Format::R32G32B32A32_SFLOAT };
+}
+
+WOLF_TEST(LegacyBoxMatchesFirstGenerator)
+{
+	std::mt19937 randomEngine(1);
+	std::uniform_real_distribution<float> distribution(-0.7f, 0.7f);
+
+	Wolf::JobsManager jobsManager(3);
+	for (const Wolf::Extent2D extent : { Wolf::Extent2D{ 8, 8 }, Wolf::Extent2D{ 64, 64 }, Wolf::Extent2D{ 256, 128 }, Wolf::Extent2D{ 128, 256 } })
+	{
+		std::vector<Wolf::ImageCompression::RGBA8> colors(static_cast<size_t>(extent.width) * extent.height);
+		for (Wolf::ImageCompression::RGBA8& color : colors)
+			color = Wolf::ImageCompression::RGBA8(static_cast<uint8_t>(randomEngine()), static_cast<uint8_t>(randomEngine()), static_cast<uint8_t>(randomEngine()), static_cast<uint8_t>(randomEngine()));
+		std::vector<Wolf::ImageCompression::RG32F> normals(colors.size());
+		for (Wolf::ImageCompression::RG32F& normal : normals)
+			normal = Wolf::ImageCompression::RG32F(distribution(randomEngine), distribution(randomEngine));
+
+		for (const bool parallel : { false, true })
+		{
+			WOLF_CHECK(isSameAsReference(colors, extent.width, extent.height, Wolf::Format::R8G8B8A8_UNORM, parallel));
+			WOLF_CHECK(isSameAsReference(colors, extent.width, extent.height, Wolf::Format::R8G8B8A8_SRGB, parallel));
+			WOLF_CHECK(isSameAsReference(normals, extent.width, extent.height, Wolf::Format::R32G32_SFLOAT, parallel));
+		}
+	}
+}
+
+WOLF_TEST(ConstantImagesStayConstant)
+{
+	constexpr uint32_t WIDTH = 333, HEIGHT = 97;
+	for (const Wolf::Format format : ALL_FORMATS)
+	{
+		const uint32_t texelSize = getTexelSize(format);
+		std::vector<uint8_t> texel(texelSize);
+		if (format == Wolf::Format::R32G32_SFLOAT || format == Wolf::Format::R32G32B32A32_SFLOAT)
+		{
+			const float values[] = { 0.3f, -0.5f, 2.0f, 1.0f };
+			std::memcpy(texel.data(), values, texelSize);
+		}
+		else if (format == Wolf::Format::R16G16B16A16_SFLOAT)
+		{
+			const uint16_t values[] = { glm::packHalf1x16(0.25f), glm::packHalf1x16(0.5f), glm::packHalf1x16(2.0f), glm::packHalf1x16(1.0f) };
+			std::memcpy(texel.data(), values, texelSize);
+		}
+		else
+		{
+			for (uint32_t channelIdx = 0; channelIdx < texelSize; ++channelIdx)
+				texel[channelIdx] = static_cast<uint8_t>(37 + 50 * channelIdx);
+		}
+
+		std::vector<uint8_t> pixels(static_cast<size_t>(WIDTH) * HEIGHT * texelSize);
+		for (size_t offset = 0; offset < pixels.size(); offset += texelSize)
+			std::memcpy(&pixels[offset], texel.data(), texelSize);
+
+		for (const Wolf::MipMapGenerator::Filter filter : { Wolf::MipMapGenerator::Filter::BOX, Wolf::MipMapGenerator::Filter::KAISER })
+		{
+			Wolf::MipMapGenerator::GenerationInfo generationInfo;
+			generationInfo.filter = filter;
+			const Wolf::MipMapGenerator mipMapGenerator(pixels.data(), { WIDTH, HEIGHT }, format, -1, generationInfo);
+			WOLF_CHECK_EQUAL(mipMapGenerator.getMipLevelCount(), 7u);
+
+			// Kernel weights sum to one, float formats may only differ by rounding
+			bool isConstant = true;
+			for (uint32_t mipLevel = 1; mipLevel < mipMapGenerator.getMipLevelCount(); ++mipLevel)
+			{
+				const Wolf::Extent2D mipExtent = Wolf::MipMapGenerator::computeMipExtent({ WIDTH, HEIGHT }, mipLevel);
+				const std::vector<unsigned char>& mip = mipMapGenerator.getMipLevel(mipLevel);
+				WOLF_CHECK_EQUAL(mip.size(), static_cast<size_t>(mipExtent.width) * mipExtent.height * texelSize);
+
+				for (size_t offset = 0; offset + texelSize <= mip.size(); offset += texelSize)
+				{
+					if (format == Wolf::Format::R32G32_SFLOAT || format == Wolf::Format::R32G32B32A32_SFLOAT)
+					{
+						for (uint32_t channelIdx = 0; channelIdx < texelSize / sizeof(float); ++channelIdx)
+							isConstant &= std::abs(reinterpret_cast<const float*>(&mip[offset])[channelIdx] - reinterpret_cast<const float*>(texel.data())[channelIdx]) < 1e-5f;
+					}
+					else
+					{
+						isConstant &= std::memcmp(&mip[offset], texel.data(), texelSize) == 0;
+					}
+				}
+			}
+			WOLF_CHECK(isConstant);
+		}
+	}
+}
+
+WOLF_TEST(SRGBIsAveragedInLinearSpace)
+{
+	// Black and white columns, the linear average of 0 and 1 is 0.5, stored as 188 in sRGB
+	constexpr uint32_t WIDTH = 8, HEIGHT = 8;
+	std::vector<Wolf::ImageCompression::RGBA8> pixels(WIDTH * HEIGHT);
+	for (uint32_t pixelIdx = 0; pixelIdx < pixels.size(); ++pixelIdx)
+	{
+		const uint8_t value = pixelIdx % 2 ? 255 : 0;
+		pixels[pixelIdx] = Wolf::ImageCompression::RGBA8(value, value, value, value);
+	}
+
+	const Wolf::MipMapGenerator srgbGenerator(reinterpret_cast<const unsigned char*>(pixels.data()), { WIDTH, HEIGHT }, Wolf::Format::R8G8B8A8_SRGB);
+	const Wolf::ImageCompression::RGBA8 srgbTexel = reinterpret_cast<const Wolf::ImageCompression::RGBA8*>(srgbGenerator.getMipLevel(1).data())[0];
+	WOLF_CHECK_EQUAL(static_cast<uint32_t>(srgbTexel.r), 188u);
+	WOLF_CHECK_EQUAL(static_cast<uint32_t>(srgbTexel.b), 188u);
+	WOLF_CHECK_EQUAL(static_cast<uint32_t>(srgbTexel.a), 128u); // alpha is linear
+
+	const Wolf::MipMapGenerator unormGenerator(reinterpret_cast<const unsigned char*>(pixels.data()), { WIDTH, HEIGHT }, Wolf::Format::R8G8B8A8_UNORM);
+	WOLF_CHECK_EQUAL(static_cast<uint32_t>(reinterpret_cast<const Wolf::ImageCompression::RGBA8*>(unormGenerator.getMipLevel(1).data())[0].r), 128u);
+}
+
+WOLF_TEST(ParallelLevelsMatchSerialLevels)
+{
+	constexpr uint32_t WIDTH = 301, HEIGHT = 211;
+	Wolf::JobsManager jobsManager(3);
+	for (const Wolf::Format format : ALL_FORMATS)
+	{
+		const std::vector<uint8_t> pixels = createNoise(WIDTH, HEIGHT, format);
+		for (const Wolf::MipMapGenerator::Filter filter : { Wolf::MipMapGenerator::Filter::BOX, Wolf::MipMapGenerator::Filter::KAISER })
+		{
+			Wolf::MipMapGenerator::GenerationInfo generationInfo;
+			generationInfo.filter = filter;
+			generationInfo.isNormalMap = format == Wolf::Format::R8G8_UNORM;
+			generationInfo.parallel = false;
+			const Wolf::MipMapGenerator serialGenerator(pixels.data(), { WIDTH, HEIGHT }, format, -1, generationInfo);
+			generationInfo.parallel = true;
+			const Wolf::MipMapGenerator parallelGenerator(pixels.data(), { WIDTH, HEIGHT }, format, -1, generationInfo);
+
+			WOLF_CHECK_EQUAL(parallelGenerator.getMipLevelCount(), serialGenerator.getMipLevelCount());
+			for (uint32_t mipLevel = 1; mipLevel < serialGenerator.getMipLevelCount(); ++mipLevel)
+				WOLF_CHECK(parallelGenerator.getMipLevel(mipLevel) == serialGenerator.getMipLevel(mipLevel));
+		}
+	}
+}
+
+WOLF_TEST(NormalMapsStayNormalized)
+{
+	constexpr uint32_t WIDTH = 64, HEIGHT = 48;
+	const std::vector<uint8_t> pixels = createNoise(WIDTH, HEIGHT, Wolf::Format::R32G32_SFLOAT);
+	for (const Wolf::MipMapGenerator::Filter filter : { Wolf::MipMapGenerator::Filter::BOX, Wolf::MipMapGenerator::Filter::KAISER })
+	{
+		Wolf::MipMapGenerator::GenerationInfo generationInfo;
+		generationInfo.filter = filter;
+		generationInfo.isNormalMap = true;
+		const Wolf::MipMapGenerator mipMapGenerator(pixels.data(), { WIDTH, HEIGHT }, Wolf::Format::R32G32_SFLOAT, -1, generationInfo);
+
+		// Averaging shortens the vectors, renormalized XY are longer than the average
+		bool isNormalized = true;
+		for (uint32_t mipLevel = 1; mipLevel < mipMapGenerator.getMipLevelCount(); ++mipLevel)
+		{
+			const std::vector<unsigned char>& mip = mipMapGenerator.getMipLevel(mipLevel);
+			const Wolf::ImageCompression::RG32F* normals = reinterpret_cast<const Wolf::ImageCompression::RG32F*>(mip.data());
+			for (size_t normalIdx = 0; normalIdx < mip.size() / sizeof(Wolf::ImageCompression::RG32F); ++normalIdx)
+				isNormalized &= normals[normalIdx].r * normals[normalIdx].r + normals[normalIdx].g * normals[normalIdx].g <= 1.0f + 1e-5f;
+		}
+		WOLF_CHECK(isNormalized);
+	}
+}
+
+WOLF_TEST(UnsupportedFormatsHaveNoMips)
+{
+	const std::vector<uint8_t> pixels(64 * 64 * 4);
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	const Wolf::MipMapGenerator mipMapGenerator(pixels.data(), { 64, 64 }, Wolf::Format::R32_SFLOAT);
+	WOLF_CHECK_EQUAL(mipMapGenerator.getMipLevelCount(), 1u);
+}
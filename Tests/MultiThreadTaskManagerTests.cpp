@@ -0,0 +1,207 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "MultiThreadTaskManager.h"
+#include "TestFramework.h"
+
+WOLF_TEST(EveryAddedJobRunsOnce)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(3, "Test");
+
+	// More jobs than the slots deques can hold
+	constexpr uint32_t JOB_COUNT = 10'000;
+	std::unique_ptr<std::atomic<uint32_t>[]> executionCounts(new std::atomic<uint32_t>[JOB_COUNT]);
+	for (uint32_t frameIdx = 0; frameIdx < 20; ++frameIdx)
+	{
+		for (uint32_t jobIdx = 0; jobIdx < JOB_COUNT; ++jobIdx)
+			executionCounts[jobIdx] = 0;
+
+		for (uint32_t jobIdx = 0; jobIdx < JOB_COUNT; ++jobIdx)
+			multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&executionCounts, jobIdx]() { executionCounts[jobIdx]++; });
+		multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+		multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+
+		uint32_t wrongCount = 0;
+		for (uint32_t jobIdx = 0; jobIdx < JOB_COUNT; ++jobIdx)
+		{
+			if (executionCounts[jobIdx] != 1)
+				wrongCount++;
+		}
+		WOLF_CHECK_EQUAL(wrongCount, 0u);
+	}
+}
+
+WOLF_TEST(JobsAddedDuringExecutionRunOnNextFrame)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(2, "Test");
+
+	std::atomic<uint32_t> firstFrameJobCount = 0, nextFrameJobCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < 8; ++jobIdx)
+	{
+		multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&]()
+		{
+			firstFrameJobCount++;
+			multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&]() { nextFrameJobCount++; });
+		});
+	}
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(firstFrameJobCount.load(), 8u);
+	WOLF_CHECK_EQUAL(nextFrameJobCount.load(), 0u);
+
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(firstFrameJobCount.load(), 8u);
+	WOLF_CHECK_EQUAL(nextFrameJobCount.load(), 8u);
+
+	// Nothing left for the following frame
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(nextFrameJobCount.load(), 8u);
+}
+
+WOLF_TEST(JobsAddedBetweenExecuteAndWaitRunOnNextFrame)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(2, "Test");
+
+	std::atomic<uint32_t> executedCount = 0;
+	multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&]() { executedCount++; });
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&]() { executedCount += 10; });
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(executedCount.load(), 1u);
+
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(executedCount.load(), 11u);
+}
+
+WOLF_TEST(ExecuteWithoutJobs)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(2, "Test");
+
+	for (uint32_t frameIdx = 0; frameIdx < 100; ++frameIdx)
+	{
+		multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+		multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	}
+
+	std::atomic<uint32_t> executedCount = 0;
+	multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&]() { executedCount++; });
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(executedCount.load(), 1u);
+}
+
+WOLF_TEST(WaitReturnsOnceWorkerJobsAreDone)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(3, "Test");
+
+	// Sleeping jobs let the workers take some of them even with a single CPU
+	std::mutex threadIdsMutex;
+	std::set<std::thread::id> threadIds;
+	std::atomic<uint32_t> completedCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < 16; ++jobIdx)
+	{
+		multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			{
+				std::lock_guard<std::mutex> lock(threadIdsMutex);
+				threadIds.insert(std::this_thread::get_id());
+			}
+			completedCount++;
+		});
+	}
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+
+	WOLF_CHECK_EQUAL(completedCount.load(), 16u);
+	WOLF_CHECK(threadIds.size() > 1);
+}
+
+WOLF_TEST(ThreadGroupsAreIndependent)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId firstThreadGroupId = multiThreadTaskManager.createThreadGroup(2, "First");
+	const Wolf::MultiThreadTaskManager::ThreadGroupId secondThreadGroupId = multiThreadTaskManager.createThreadGroup(1, "Second");
+	WOLF_CHECK(firstThreadGroupId != secondThreadGroupId);
+	WOLF_CHECK_EQUAL(multiThreadTaskManager.getThreadCountInThreadGroup(firstThreadGroupId), 2u);
+	WOLF_CHECK_EQUAL(multiThreadTaskManager.getThreadCountInThreadGroup(secondThreadGroupId), 1u);
+
+	std::atomic<uint32_t> firstGroupCount = 0, secondGroupCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < 100; ++jobIdx)
+	{
+		multiThreadTaskManager.addJobToThreadGroup(firstThreadGroupId, [&]() { firstGroupCount++; });
+		multiThreadTaskManager.addJobToThreadGroup(secondThreadGroupId, [&]() { secondGroupCount++; });
+	}
+
+	multiThreadTaskManager.executeJobsForThreadGroup(secondThreadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(secondThreadGroupId);
+	WOLF_CHECK_EQUAL(firstGroupCount.load(), 0u);
+	WOLF_CHECK_EQUAL(secondGroupCount.load(), 100u);
+
+	multiThreadTaskManager.executeJobsForThreadGroup(firstThreadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(firstThreadGroupId);
+	WOLF_CHECK_EQUAL(firstGroupCount.load(), 100u);
+	WOLF_CHECK_EQUAL(secondGroupCount.load(), 100u);
+}
+
+WOLF_TEST(GroupWithoutThreadRunsOnCaller)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(0, "Test");
+
+	const std::thread::id callerThreadId = std::this_thread::get_id();
+	uint32_t executedOnCallerCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < 200; ++jobIdx)
+	{
+		multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&]()
+		{
+			if (std::this_thread::get_id() == callerThreadId)
+				executedOnCallerCount++;
+		});
+	}
+	multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+	multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+	WOLF_CHECK_EQUAL(executedOnCallerCount, 200u);
+}
+
+WOLF_TEST(SpawnedJobsRunInCurrentFrame)
+{
+	Wolf::MultiThreadTaskManager multiThreadTaskManager;
+	const Wolf::MultiThreadTaskManager::ThreadGroupId threadGroupId = multiThreadTaskManager.createThreadGroup(3, "Test");
+
+	for (uint32_t frameIdx = 0; frameIdx < 200; ++frameIdx)
+	{
+		// Spawned jobs are stored in the slot arenas reset each frame, they must all complete before the wait returns
+		std::atomic<uint32_t> spawnedCount = 0;
+		for (uint32_t jobIdx = 0; jobIdx < 32; ++jobIdx)
+		{
+			multiThreadTaskManager.addJobToThreadGroup(threadGroupId, [&]()
+			{
+				for (uint32_t spawnIdx = 0; spawnIdx < 100; ++spawnIdx)
+					multiThreadTaskManager.spawnJobInThreadGroup(threadGroupId, [&spawnedCount]() { spawnedCount++; });
+			});
+		}
+		multiThreadTaskManager.executeJobsForThreadGroup(threadGroupId);
+		multiThreadTaskManager.waitForThreadGroup(threadGroupId);
+		WOLF_CHECK_EQUAL(spawnedCount.load(), 3200u);
+	}
+
+	// Not taking part in an execution, the job runs right away
+	bool executedImmediately = false;
+	multiThreadTaskManager.spawnJobInThreadGroup(threadGroupId, [&]() { executedImmediately = true; });
+	WOLF_CHECK(executedImmediately);
+	WOLF_CHECK(!multiThreadTaskManager.helpThreadGroup(threadGroupId));
+}
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "JobsManager.h"
+#include "ParallelFor.h"
+#include "TestFramework.h"
+
+namespace
+{
+	// Number of times each index is visited by parallelFor
+	bool visitsEveryIndexOnce(uint32_t count, uint32_t grainSize)
+	{
+		std::unique_ptr<std::atomic<uint32_t>[]> visitCounts(new std::atomic<uint32_t>[count]);
+		for (uint32_t i = 0; i < count; ++i)
+			visitCounts[i] = 0;
+
+		Wolf::parallelFor(count, grainSize, [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+				visitCounts[i]++;
+		});
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (visitCounts[i] != 1)
+				return false;
+		}
+		return true;
+	}
+
+	// Ranges given to parallelFor, sorted by begin
+	std::vector<std::pair<uint32_t, uint32_t>> collectRanges(uint32_t count, uint32_t grainSize)
+	{
+		std::mutex rangesMutex;
+		std::vector<std::pair<uint32_t, uint32_t>> ranges;
+		Wolf::parallelFor(count, grainSize, [&](uint32_t begin, uint32_t end)
+		{
+			std::lock_guard<std::mutex> lock(rangesMutex);
+			ranges.emplace_back(begin, end);
+		});
+		std::sort(ranges.begin(), ranges.end());
+		return ranges;
+	}
+
+	bool areRangesCovering(const std::vector<std::pair<uint32_t, uint32_t>>& ranges, uint32_t count, uint32_t grainSize)
+	{
+		uint32_t nextBegin = 0;
+		for (uint32_t rangeIdx = 0; rangeIdx < ranges.size(); ++rangeIdx)
+		{
+			const auto [begin, end] = ranges[rangeIdx];
+			if (begin != nextBegin || end <= begin)
+				return false;
+			// Only the last range can be smaller than the grain
+			if (rangeIdx + 1 < ranges.size() && end - begin < grainSize)
+				return false;
+			nextBegin = end;
+		}
+		return nextBegin == count;
+	}
+
+	uint64_t reduceSum(uint32_t count, uint32_t grainSize)
+	{
+		return Wolf::parallelReduce(count, grainSize, uint64_t(0), [](uint32_t begin, uint32_t end, uint64_t sum)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+				sum += static_cast<uint64_t>(i) * i;
+			return sum;
+		}, [](uint64_t left, uint64_t right) { return left + right; });
+	}
+
+	// Not commutative, range results must be combined in order
+	std::vector<uint32_t> reduceIndices(uint32_t count, uint32_t grainSize)
+	{
+		return Wolf::parallelReduce(count, grainSize, std::vector<uint32_t>(), [](uint32_t begin, uint32_t end, std::vector<uint32_t> indices)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+				indices.push_back(i);
+			return indices;
+		}, [](std::vector<uint32_t> left, const std::vector<uint32_t>& right)
+		{
+			left.insert(left.end(), right.begin(), right.end());
+			return left;
+		});
+	}
+}
+
+WOLF_TEST(EveryIndexVisitedOnce)
+{
+	for (const uint32_t workerCount : { 0u, 1u, 3u })
+	{
+		// Without a JobsManager first
+		std::unique_ptr<Wolf::JobsManager> jobsManager(workerCount > 0 ? new Wolf::JobsManager(workerCount) : nullptr);
+		for (const uint32_t count : { 1u, 2u, 7u, 1000u, 100'003u })
+		{
+			for (const uint32_t grainSize : { 0u, 1u, 16u, 5000u })
+			{
+				WOLF_CHECK(visitsEveryIndexOnce(count, grainSize));
+				WOLF_CHECK(areRangesCovering(collectRanges(count, grainSize), count, std::max(grainSize, 1u)));
+			}
+		}
+	}
+}
+
+WOLF_TEST(ReduceMatchesSerialFold)
+{
+	for (const uint32_t workerCount : { 0u, 3u })
+	{
+		std::unique_ptr<Wolf::JobsManager> jobsManager(workerCount > 0 ? new Wolf::JobsManager(workerCount) : nullptr);
+		for (const uint32_t count : { 0u, 1u, 5u, 1000u, 65'537u })
+		{
+			uint64_t serialSum = 0;
+			for (uint32_t i = 0; i < count; ++i)
+				serialSum += static_cast<uint64_t>(i) * i;
+			std::vector<uint32_t> serialIndices(count);
+			std::iota(serialIndices.begin(), serialIndices.end(), 0u);
+
+			for (const uint32_t grainSize : { 1u, 64u })
+			{
+				WOLF_CHECK_EQUAL(reduceSum(count, grainSize), serialSum);
+				WOLF_CHECK(reduceIndices(count, grainSize) == serialIndices);
+			}
+		}
+	}
+}
+
+WOLF_TEST(RangeSizeEdgeCases)
+{
+	// One range when there's no JobsManager, at least the grain
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(0, 0), 1u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(1, 0), 1u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(10, 3), 10u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(10, 20), 20u);
+
+	// 3 workers and the calling thread, 4 ranges per thread
+	Wolf::JobsManager jobsManager(3);
+	WOLF_CHECK_EQUAL(jobsManager.getParallelThreadCount(), 4u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(0, 1), 1u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(1, 1), 1u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(3, 1), 1u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(16, 1), 1u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(17, 1), 2u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(1000, 0), 63u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeSize(1000, 100), 100u);
+
+	// Fewer items than threads, one range per item
+	const std::vector<std::pair<uint32_t, uint32_t>> ranges = collectRanges(3, 1);
+	WOLF_CHECK_EQUAL(ranges.size(), 3u);
+	WOLF_CHECK(areRangesCovering(ranges, 3, 1));
+
+	// Range arithmetic doesn't wrap close to the 32 bits limit
+	const uint32_t hugeCount = UINT32_MAX;
+	const uint32_t hugeRangeSize = Wolf::computeParallelRangeSize(hugeCount, 1);
+	WOLF_CHECK_EQUAL(hugeRangeSize, static_cast<uint32_t>((static_cast<uint64_t>(hugeCount) + 15) / 16));
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeCount(hugeCount, hugeRangeSize), 16u);
+	WOLF_CHECK_EQUAL(Wolf::computeParallelRangeCount(hugeCount, 1), hugeCount);
+	WOLF_CHECK(areRangesCovering(collectRanges(hugeCount, 1), hugeCount, 1));
+	WOLF_CHECK(areRangesCovering(collectRanges(hugeCount, hugeCount - 1), hugeCount, hugeCount - 1));
+}
+
+WOLF_TEST(NestedCallsFromJobs)
+{
+	Wolf::JobsManager jobsManager(3);
+
+	constexpr uint32_t OUTER_COUNT = 8;
+	constexpr uint32_t INNER_COUNT = 1000;
+	std::unique_ptr<std::atomic<uint32_t>[]> visitCounts(new std::atomic<uint32_t>[OUTER_COUNT * INNER_COUNT]);
+	for (uint32_t i = 0; i < OUTER_COUNT * INNER_COUNT; ++i)
+		visitCounts[i] = 0;
+
+	// parallelFor from before frame jobs, each range running another parallelFor
+	std::atomic<uint32_t> sumErrorCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < 4; ++jobIdx)
+	{
+		jobsManager.addJobBeforeFrame([&, jobIdx]()
+		{
+			Wolf::parallelFor(OUTER_COUNT / 4, 1, [&](uint32_t outerBegin, uint32_t outerEnd)
+			{
+				for (uint32_t outerIdx = jobIdx * (OUTER_COUNT / 4) + outerBegin; outerIdx < jobIdx * (OUTER_COUNT / 4) + outerEnd; ++outerIdx)
+				{
+					Wolf::parallelFor(INNER_COUNT, 16, [&](uint32_t begin, uint32_t end)
+					{
+						for (uint32_t innerIdx = begin; innerIdx < end; ++innerIdx)
+							visitCounts[outerIdx * INNER_COUNT + innerIdx]++;
+					});
+				}
+			});
+
+			if (reduceSum(INNER_COUNT, 8) != reduceSum(INNER_COUNT, INNER_COUNT))
+				sumErrorCount++;
+		});
+	}
+	jobsManager.executeJobsBeforeFrame();
+
+	uint32_t wrongVisitCount = 0;
+	for (uint32_t i = 0; i < OUTER_COUNT * INNER_COUNT; ++i)
+	{
+		if (visitCounts[i] != 1)
+			wrongVisitCount++;
+	}
+	WOLF_CHECK_EQUAL(wrongVisitCount, 0u);
+	WOLF_CHECK_EQUAL(sumErrorCount.load(), 0u);
+}
+
+WOLF_TEST(SerialFallbackWithoutJobsManager)
+{
+	WOLF_CHECK(Wolf::g_jobsManager == nullptr);
+
+	// A single range covering everything, executed by the calling thread
+	const std::thread::id callerThreadId = std::this_thread::get_id();
+	std::vector<std::pair<uint32_t, uint32_t>> ranges;
+	bool executedOnCaller = true;
+	Wolf::parallelFor(1000, 10, [&](uint32_t begin, uint32_t end)
+	{
+		ranges.emplace_back(begin, end);
+		executedOnCaller = executedOnCaller && std::this_thread::get_id() == callerThreadId;
+	});
+	WOLF_CHECK_EQUAL(ranges.size(), 1u);
+	WOLF_CHECK(ranges[0] == std::make_pair(0u, 1000u));
+	WOLF_CHECK(executedOnCaller);
+
+	uint32_t rangeCount = 0;
+	Wolf::parallelFor(0, 1, [&](uint32_t, uint32_t) { rangeCount++; });
+	WOLF_CHECK_EQUAL(rangeCount, 0u);
+
+	std::vector<uint32_t> rangeIndices;
+	Wolf::parallelForRanges(5, [&](uint32_t rangeIdx) { rangeIndices.push_back(rangeIdx); });
+	WOLF_CHECK(rangeIndices == std::vector<uint32_t>({ 0, 1, 2, 3, 4 }));
+}
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <RuntimeContext.h>
+
+#include "JobsManager.h"
+#include "ParallelFor.h"
+#include "TestFramework.h"
+
+WOLF_TEST(PipelinedJobsSeeNextFrameNumber)
+{
+	Wolf::RuntimeContext runtimeContext;
+	Wolf::JobsManager jobsManager(3);
+
+	for (uint32_t frameIdx = 0; frameIdx < 200; ++frameIdx)
+	{
+		std::atomic<uint32_t> wrongFrameNumberCount = 0;
+		for (uint32_t jobIdx = 0; jobIdx < 8; ++jobIdx)
+		{
+			jobsManager.addJobBeforeFrame([&, frameIdx]()
+			{
+				if (Wolf::g_runtimeContext->getCurrentCPUFrameNumber() != frameIdx + 1)
+					wrongFrameNumberCount++;
+
+				// Helpers of a parallel for run by a job see the same frame number
+				Wolf::parallelFor(64, 1, [&](uint32_t begin, uint32_t end)
+				{
+					for (uint32_t i = begin; i < end; ++i)
+					{
+						if (Wolf::g_runtimeContext->getCurrentCPUFrameNumber() != frameIdx + 1)
+							wrongFrameNumberCount++;
+					}
+				});
+			});
+		}
+		jobsManager.startJobsBeforeFrame(frameIdx + 1);
+
+		// Recording thread keeps the current frame number
+		std::atomic<uint32_t> wrongRecordFrameNumberCount = 0;
+		jobsManager.parallelFor(32, [&](uint32_t)
+		{
+			if (Wolf::g_runtimeContext->getCurrentCPUFrameNumber() != frameIdx)
+				wrongRecordFrameNumberCount++;
+		});
+
+		jobsManager.waitJobsBeforeFrame();
+		WOLF_CHECK_EQUAL(wrongFrameNumberCount.load(), 0u);
+		WOLF_CHECK_EQUAL(wrongRecordFrameNumberCount.load(), 0u);
+		runtimeContext.incrementCPUFrameNumber();
+	}
+
+	// Synchronous executions see the current frame number
+	uint32_t seenFrameNumber = 0;
+	jobsManager.addJobBeforeFrame([&]() { seenFrameNumber = Wolf::g_runtimeContext->getCurrentCPUFrameNumber(); });
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK_EQUAL(seenFrameNumber, 200u);
+}
+
+WOLF_TEST(ExternalJobGatesSuccessors)
+{
+	Wolf::JobsManager jobsManager(3);
+
+	for (uint32_t frameIdx = 0; frameIdx < 200; ++frameIdx)
+	{
+		std::atomic<bool> externalJobCompleted = false;
+		std::atomic<uint32_t> gatedJobCount = 0;
+		std::atomic<uint32_t> earlyJobCount = 0;
+		std::atomic<uint32_t> freeJobCount = 0;
+
+		const Wolf::JobsManager::JobHandle externalJob = jobsManager.addExternalJobBeforeFrame("External");
+		const Wolf::JobsManager::JobHandle gatedJob = jobsManager.addJobBeforeFrame([&]()
+		{
+			if (!externalJobCompleted)
+				earlyJobCount++;
+			gatedJobCount++;
+		}, { &externalJob, 1 });
+		jobsManager.addContinuationBeforeFrame(gatedJob, [&]() { gatedJobCount++; });
+		for (uint32_t jobIdx = 0; jobIdx < 8; ++jobIdx)
+			jobsManager.addJobBeforeFrame([&]() { freeJobCount++; });
+
+		// Completed before or during the execution
+		const bool completeBeforeStart = frameIdx % 3 == 0;
+		if (completeBeforeStart)
+		{
+			externalJobCompleted = true;
+			jobsManager.completeExternalJob(externalJob);
+		}
+		jobsManager.startJobsBeforeFrame(frameIdx + 1);
+		if (!completeBeforeStart)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+			WOLF_CHECK(!jobsManager.isJobCompleted(gatedJob));
+			externalJobCompleted = true;
+			jobsManager.completeExternalJob(externalJob);
+		}
+		jobsManager.waitJobsBeforeFrame();
+
+		WOLF_CHECK_EQUAL(earlyJobCount.load(), 0u);
+		WOLF_CHECK_EQUAL(gatedJobCount.load(), 2u);
+		WOLF_CHECK_EQUAL(freeJobCount.load(), 8u);
+		WOLF_CHECK(jobsManager.isJobCompleted(externalJob));
+	}
+
+	// Synchronous execution, completed beforehand
+	bool gatedJobExecuted = false;
+	const Wolf::JobsManager::JobHandle externalJob = jobsManager.addExternalJobBeforeFrame();
+	jobsManager.addJobBeforeFrame([&]() { gatedJobExecuted = true; }, { &externalJob, 1 });
+	jobsManager.completeExternalJob(externalJob);
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK(gatedJobExecuted);
+
+	// Completing twice or completing a job which isn't external
+	const Wolf::JobsManager::JobHandle job = jobsManager.addJobBeforeFrame([]() {});
+	{
+		Wolf::Tests::ExpectedErrorsScope expectedErrors(2);
+		jobsManager.completeExternalJob(externalJob);
+		jobsManager.completeExternalJob(job);
+	}
+	jobsManager.executeJobsBeforeFrame();
+}
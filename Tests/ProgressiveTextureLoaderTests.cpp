@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ProgressiveTextureLoader.h"
+#include "TestFramework.h"
+
+namespace
+{
+	// Records the pushed mips instead of copying them to the GPU
+	class MockGPUDataTransfersManager : public Wolf::GPUDataTransfersManagerInterface
+	{
+	public:
+		struct ImagePush
+		{
+			const Wolf::Image* m_image;
+			uint32_t m_mipLevel;
+			const unsigned char* m_pixels;
+			uint32_t m_layoutMipLevel;
+		};
+
+		void pushDataToGPUBuffer(const void*, uint32_t, const Wolf::ResourceNonOwner<Wolf::Buffer>&, uint32_t) override {}
+		void fillGPUBuffer(uint32_t, uint32_t, const Wolf::ResourceNonOwner<Wolf::Buffer>&, uint32_t) override {}
+		void pushDataToGPUImage(const PushDataToGPUImageInfo& pushDataToGPUImageInfo) override
+		{
+			m_imagePushes.push_back({ &*pushDataToGPUImageInfo.m_outputImage, pushDataToGPUImageInfo.m_mipLevel, pushDataToGPUImageInfo.m_pixels,
+				pushDataToGPUImageInfo.m_finalLayout.baseMipLevel });
+		}
+		void requestGPUBufferReadbackRecord(const Wolf::ResourceNonOwner<Wolf::Buffer>&, uint32_t, const Wolf::ResourceNonOwner<Wolf::ReadableBuffer>&, uint32_t) override {}
+
+		std::vector<ImagePush> m_imagePushes;
+	};
+
+	// Square RGBA8 texture with its full mip chain. The loader never dereferences the image, its address only identifies the texture
+	class TestTexture
+	{
+	public:
+		TestTexture(uint32_t size, uint32_t bindlessOffset) : m_bindlessOffset(bindlessOffset)
+		{
+			for (uint32_t mipSize = size; mipSize > 0; mipSize /= 2)
+				m_mips.emplace_back(static_cast<size_t>(mipSize) * mipSize * 4);
+		}
+
+		Wolf::Image* getImage() { return reinterpret_cast<Wolf::Image*>(&m_imageTag); }
+		[[nodiscard]] uint32_t getMipLevelCount() const { return static_cast<uint32_t>(m_mips.size()); }
+		[[nodiscard]] uint64_t getMipByteSize(uint32_t mipLevel) const { return m_mips[mipLevel].size(); }
+		[[nodiscard]] const unsigned char* getMipPixels(uint32_t mipLevel) const { return m_mips[mipLevel].data(); }
+
+		Wolf::ProgressiveTextureLoader::TextureInfo createTextureInfo()
+		{
+			Wolf::ProgressiveTextureLoader::TextureInfo textureInfo;
+			textureInfo.m_image = Wolf::ResourceNonOwner<Wolf::Image>(getImage());
+			for (const std::vector<uint8_t>& mip : m_mips)
+				textureInfo.m_mipPixels.emplace_back(mip);
+			textureInfo.m_bindlessOffset = m_bindlessOffset;
+			return textureInfo;
+		}
+
+	private:
+		uint64_t m_imageTag = 0;
+		uint32_t m_bindlessOffset;
+		std::vector<std::vector<uint8_t>> m_mips;
+	};
+
+	struct ExpectedPush
+	{
+		TestTexture* m_texture;
+		uint32_t m_mipLevel;
+	};
+
+	void checkPushes(const MockGPUDataTransfersManager& mock, const std::vector<ExpectedPush>& expectedPushes)
+	{
+		WOLF_CHECK_EQUAL(mock.m_imagePushes.size(), expectedPushes.size());
+		for (size_t pushIdx = 0; pushIdx < std::min(mock.m_imagePushes.size(), expectedPushes.size()); ++pushIdx)
+		{
+			const MockGPUDataTransfersManager::ImagePush& push = mock.m_imagePushes[pushIdx];
+			const ExpectedPush& expectedPush = expectedPushes[pushIdx];
+			WOLF_CHECK(push.m_image == expectedPush.m_texture->getImage());
+			WOLF_CHECK_EQUAL(push.m_mipLevel, expectedPush.m_mipLevel);
+			WOLF_CHECK_EQUAL(push.m_layoutMipLevel, expectedPush.m_mipLevel);
+			WOLF_CHECK(push.m_pixels == expectedPush.m_texture->getMipPixels(expectedPush.m_mipLevel));
+		}
+	}
+
+	size_t findTextureIdx(std::vector<TestTexture>& textures, const Wolf::Image* image)
+	{
+		return std::ranges::find_if(textures, [image](TestTexture& texture) { return texture.getImage() == image; }) - textures.begin();
+	}
+
+	// Mips from the tail limit to the last one
+	void addMipTail(std::vector<ExpectedPush>& pushes, TestTexture& texture)
+	{
+		for (uint32_t mipLevel = texture.getMipLevelCount(); mipLevel-- > 0 && texture.getMipByteSize(mipLevel) <= Wolf::ProgressiveTextureLoader::MIP_TAIL_MAX_BYTE_SIZE;)
+			pushes.push_back({ &texture, mipLevel });
+	}
+}
+
+WOLF_TEST(MipTailFirstThenSmallestMipsWithinBudget)
+{
+	constexpr uint64_t BUDGET = 1024 * 1024;
+
+	MockGPUDataTransfersManager mock;
+	Wolf::ProgressiveTextureLoader loader(Wolf::ResourceNonOwner<Wolf::GPUDataTransfersManagerInterface>(&mock), BUDGET);
+
+	// Mip 0 of the large texture is 4 MB, above the budget
+	TestTexture largeTexture(1024, 10);
+	TestTexture smallTexture(256, 11);
+	loader.addTexture(largeTexture.createTextureInfo());
+	loader.addTexture(smallTexture.createTextureInfo());
+	WOLF_CHECK_EQUAL(loader.getPendingTextureCount(), 2u);
+
+	uint64_t pendingByteCount = 0;
+	for (TestTexture* texture : { &largeTexture, &smallTexture })
+		for (uint32_t mipLevel = 0; mipLevel < texture->getMipLevelCount(); ++mipLevel)
+			pendingByteCount += texture->getMipByteSize(mipLevel);
+	WOLF_CHECK_EQUAL(loader.getPendingByteCount(), pendingByteCount);
+
+	// Both tails down to the 64 KB mips, then the 256 KB mips while the budget allows it, ties go to the first added texture
+	std::vector<ExpectedPush> expectedPushes;
+	addMipTail(expectedPushes, largeTexture);
+	addMipTail(expectedPushes, smallTexture);
+	expectedPushes.push_back({ &largeTexture, 2 });
+	expectedPushes.push_back({ &smallTexture, 0 });
+
+	std::vector<Wolf::ProgressiveTextureLoader::ResidentMipsChange> changes;
+	loader.update(changes);
+	checkPushes(mock, expectedPushes);
+	WOLF_CHECK_EQUAL(changes.size(), 2u);
+	if (changes.size() == 2)
+	{
+		WOLF_CHECK_EQUAL(changes[0].m_bindlessOffset, 10u);
+		WOLF_CHECK_EQUAL(changes[0].m_firstResidentMipLevel, 2u);
+		WOLF_CHECK_EQUAL(changes[1].m_bindlessOffset, 11u);
+		WOLF_CHECK_EQUAL(changes[1].m_firstResidentMipLevel, 0u);
+	}
+	WOLF_CHECK_EQUAL(loader.getPendingTextureCount(), 1u);
+	WOLF_CHECK_EQUAL(loader.getPendingByteCount(), largeTexture.getMipByteSize(0) + largeTexture.getMipByteSize(1));
+
+	// 1 MB mip fills the whole budget
+	mock.m_imagePushes.clear();
+	changes.clear();
+	loader.update(changes);
+	checkPushes(mock, { { &largeTexture, 1 } });
+	WOLF_CHECK_EQUAL(changes.size(), 1u);
+	WOLF_CHECK(changes.size() == 1 && changes[0].m_firstResidentMipLevel == 1);
+
+	// A mip larger than the budget is sent alone
+	mock.m_imagePushes.clear();
+	changes.clear();
+	loader.update(changes);
+	checkPushes(mock, { { &largeTexture, 0 } });
+	WOLF_CHECK(changes.size() == 1 && changes[0].m_firstResidentMipLevel == 0);
+	WOLF_CHECK_EQUAL(loader.getPendingTextureCount(), 0u);
+	WOLF_CHECK_EQUAL(loader.getPendingByteCount(), 0u);
+
+	// Nothing left to send
+	mock.m_imagePushes.clear();
+	changes.clear();
+	loader.update(changes);
+	WOLF_CHECK(mock.m_imagePushes.empty());
+	WOLF_CHECK(changes.empty());
+}
+
+WOLF_TEST(BudgetIsRespectedEachFrame)
+{
+	constexpr uint64_t BUDGET = 300 * 1024;
+	constexpr uint32_t TEXTURE_COUNT = 6;
+
+	MockGPUDataTransfersManager mock;
+	Wolf::ProgressiveTextureLoader loader(Wolf::ResourceNonOwner<Wolf::GPUDataTransfersManagerInterface>(&mock), BUDGET);
+
+	std::vector<TestTexture> textures;
+	textures.reserve(TEXTURE_COUNT);
+	for (uint32_t textureIdx = 0; textureIdx < TEXTURE_COUNT; ++textureIdx)
+	{
+		textures.emplace_back(64u << (textureIdx % 4), textureIdx);
+		loader.addTexture(textures.back().createTextureInfo());
+	}
+
+	// First update sends the mip tail of every texture
+	std::vector<Wolf::ProgressiveTextureLoader::ResidentMipsChange> changes;
+	loader.update(changes);
+	WOLF_CHECK_EQUAL(changes.size(), static_cast<size_t>(TEXTURE_COUNT));
+
+	std::vector<uint32_t> pushCounts(TEXTURE_COUNT);
+	for (const MockGPUDataTransfersManager::ImagePush& push : mock.m_imagePushes)
+		pushCounts[findTextureIdx(textures, push.m_image)]++;
+
+	uint64_t previousMipByteSize = 0;
+	uint32_t frameCount = 1;
+	while (loader.getPendingTextureCount() > 0 && frameCount < 100)
+	{
+		mock.m_imagePushes.clear();
+		changes.clear();
+		const uint64_t pendingByteCount = loader.getPendingByteCount();
+		loader.update(changes);
+		++frameCount;
+
+		const uint64_t sentByteCount = pendingByteCount - loader.getPendingByteCount();
+		WOLF_CHECK(!mock.m_imagePushes.empty());
+		WOLF_CHECK(sentByteCount <= BUDGET || mock.m_imagePushes.size() == 1);
+		WOLF_CHECK(changes.size() <= mock.m_imagePushes.size());
+
+		// Smallest mips of all textures first
+		for (const MockGPUDataTransfersManager::ImagePush& push : mock.m_imagePushes)
+		{
+			const size_t textureIdx = findTextureIdx(textures, push.m_image);
+			WOLF_CHECK(textures[textureIdx].getMipByteSize(push.m_mipLevel) >= previousMipByteSize);
+			previousMipByteSize = textures[textureIdx].getMipByteSize(push.m_mipLevel);
+			pushCounts[textureIdx]++;
+		}
+	}
+
+	// Each mip is sent once
+	WOLF_CHECK_EQUAL(loader.getPendingTextureCount(), 0u);
+	for (uint32_t textureIdx = 0; textureIdx < TEXTURE_COUNT; ++textureIdx)
+		WOLF_CHECK_EQUAL(pushCounts[textureIdx], textures[textureIdx].getMipLevelCount());
+}
+
+WOLF_TEST(NewTexturesGetTheirMipTailAboveTheBudget)
+{
+	MockGPUDataTransfersManager mock;
+	Wolf::ProgressiveTextureLoader loader(Wolf::ResourceNonOwner<Wolf::GPUDataTransfersManagerInterface>(&mock), 1);
+
+	TestTexture texture(256, 0);
+	loader.addTexture(texture.createTextureInfo());
+
+	std::vector<ExpectedPush> expectedPushes;
+	addMipTail(expectedPushes, texture);
+	std::vector<Wolf::ProgressiveTextureLoader::ResidentMipsChange> changes;
+	loader.update(changes);
+	checkPushes(mock, expectedPushes);
+	WOLF_CHECK(changes.size() == 1 && changes[0].m_firstResidentMipLevel == 1);
+
+	// Then a single mip per frame
+	mock.m_imagePushes.clear();
+	loader.update(changes);
+	checkPushes(mock, { { &texture, 0 } });
+	WOLF_CHECK_EQUAL(loader.getPendingTextureCount(), 0u);
+
+	// Budget can change between updates
+	TestTexture otherTexture(512, 1);
+	loader.setByteBudgetPerFrame(2 * 1024 * 1024);
+	loader.addTexture(otherTexture.createTextureInfo());
+	mock.m_imagePushes.clear();
+	loader.update(changes);
+	WOLF_CHECK_EQUAL(mock.m_imagePushes.size(), static_cast<size_t>(otherTexture.getMipLevelCount()));
+	WOLF_CHECK_EQUAL(loader.getPendingTextureCount(), 0u);
+}
+
+WOLF_TEST(TexturesAddedFromOtherThreads)
+{
+	constexpr uint32_t THREAD_COUNT = 4;
+	constexpr uint32_t TEXTURE_COUNT_PER_THREAD = 16;
+
+	MockGPUDataTransfersManager mock;
+	Wolf::ProgressiveTextureLoader loader(Wolf::ResourceNonOwner<Wolf::GPUDataTransfersManagerInterface>(&mock), 256 * 1024);
+
+	std::vector<TestTexture> textures;
+	textures.reserve(THREAD_COUNT * TEXTURE_COUNT_PER_THREAD);
+	for (uint32_t textureIdx = 0; textureIdx < THREAD_COUNT * TEXTURE_COUNT_PER_THREAD; ++textureIdx)
+		textures.emplace_back(32u << (textureIdx % 4), textureIdx);
+
+	std::atomic<uint32_t> finishedThreadCount = 0;
+	std::vector<std::thread> threads;
+	for (uint32_t threadIdx = 0; threadIdx < THREAD_COUNT; ++threadIdx)
+	{
+		threads.emplace_back([&, threadIdx]()
+		{
+			for (uint32_t textureIdx = 0; textureIdx < TEXTURE_COUNT_PER_THREAD; ++textureIdx)
+			{
+				loader.addTexture(textures[threadIdx * TEXTURE_COUNT_PER_THREAD + textureIdx].createTextureInfo());
+				std::this_thread::yield();
+			}
+			++finishedThreadCount;
+		});
+	}
+
+	// Updates run while textures are added, like frames
+	std::vector<Wolf::ProgressiveTextureLoader::ResidentMipsChange> changes;
+	while (finishedThreadCount < THREAD_COUNT || loader.getPendingTextureCount() > 0)
+		loader.update(changes);
+	for (std::thread& thread : threads)
+		thread.join();
+
+	std::vector<uint32_t> pushCounts(textures.size());
+	for (const MockGPUDataTransfersManager::ImagePush& push : mock.m_imagePushes)
+		pushCounts[findTextureIdx(textures, push.m_image)]++;
+	for (size_t textureIdx = 0; textureIdx < textures.size(); ++textureIdx)
+		WOLF_CHECK_EQUAL(pushCounts[textureIdx], textures[textureIdx].getMipLevelCount());
+
+	// Last change of each texture has all its mips
+	std::vector<uint32_t> firstResidentMipLevels(textures.size(), UINT32_MAX);
+	for (const Wolf::ProgressiveTextureLoader::ResidentMipsChange& change : changes)
+		firstResidentMipLevels[change.m_bindlessOffset] = change.m_firstResidentMipLevel;
+	WOLF_CHECK(std::ranges::all_of(firstResidentMipLevels, [](uint32_t firstResidentMipLevel) { return firstResidentMipLevel == 0; }));
+}
+
+WOLF_TEST(RejectsTexturesWithoutMips)
+{
+	MockGPUDataTransfersManager mock;
+	Wolf::ProgressiveTextureLoader loader{ Wolf::ResourceNonOwner<Wolf::GPUDataTransfersManagerInterface>(&mock) };
+
+	TestTexture texture(16, 0);
+	Wolf::ProgressiveTextureLoader::TextureInfo textureWithEmptyMip = texture.createTextureInfo();
+	textureWithEmptyMip.m_mipPixels[2] = {};
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(2);
+	loader.addTexture({});
+	loader.addTexture(std::move(textureWithEmptyMip));
+	WOLF_CHECK_EQUAL(loader.getPendingTextureCount(), 0u);
+
+	std::vector<Wolf::ProgressiveTextureLoader::ResidentMipsChange> changes;
+	loader.update(changes);
+	WOLF_CHECK(mock.m_imagePushes.empty());
+}
@@ -0,0 +1,175 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "AsyncTask.h"
+#include "JobsManager.h"
+#include "JobsTestHelpers.h"
+#include "TestFramework.h"
+
+namespace
+{
+	Wolf::AsyncTask waitForEvent(Wolf::AsyncEvent& event, std::atomic<uint32_t>& startedCount, std::atomic<uint32_t>& resumedCount)
+	{
+		startedCount++;
+		co_await event;
+		resumedCount++;
+	}
+}
+
+WOLF_TEST(HighestPriorityFirstThenAddOrder)
+{
+	Wolf::JobsManager jobsManager(1, 1);
+	Wolf::Tests::ExecutionOrder executionOrder;
+
+	Wolf::Tests::StreamingThreadBlocker blocker(jobsManager);
+	const std::vector<uint32_t> priorities = { 0, 5, 1, 5, 0, 9, 1 };
+	for (uint32_t jobIdx = 0; jobIdx < priorities.size(); ++jobIdx)
+	{
+		WOLF_CHECK(jobsManager.addStreamingJob([&executionOrder, jobIdx]() { executionOrder.add(jobIdx); }, priorities[jobIdx]) == Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	}
+	blocker.release();
+
+	WOLF_CHECK(executionOrder.waitForCount(static_cast<uint32_t>(priorities.size())));
+	WOLF_CHECK(executionOrder.getOrder() == std::vector<uint32_t>({ 5, 1, 3, 2, 6, 0, 4 }));
+}
+
+WOLF_TEST(CancelPendingJob)
+{
+	Wolf::JobsManager jobsManager(1, 1);
+	Wolf::Tests::ExecutionOrder executionOrder;
+
+	Wolf::Tests::StreamingThreadBlocker blocker(jobsManager);
+	std::vector<Wolf::JobsManager::StreamingJobToken> tokens(4);
+	for (uint32_t jobIdx = 0; jobIdx < tokens.size(); ++jobIdx)
+	{
+		jobsManager.addStreamingJob([&executionOrder, jobIdx]() { executionOrder.add(jobIdx); }, 0, &tokens[jobIdx]);
+		WOLF_CHECK(tokens[jobIdx] != Wolf::JobsManager::INVALID_STREAMING_JOB_TOKEN);
+	}
+
+	WOLF_CHECK(jobsManager.cancelStreamingJob(tokens[1]));
+	WOLF_CHECK(!jobsManager.cancelStreamingJob(tokens[1]));
+	WOLF_CHECK(!jobsManager.cancelStreamingJob(Wolf::JobsManager::INVALID_STREAMING_JOB_TOKEN));
+	blocker.release();
+
+	WOLF_CHECK(executionOrder.waitForCount(3));
+	WOLF_CHECK(executionOrder.getOrder() == std::vector<uint32_t>({ 0, 2, 3 }));
+
+	// Started or executed jobs can't be cancelled anymore
+	WOLF_CHECK(!jobsManager.cancelStreamingJob(tokens[0]));
+}
+
+WOLF_TEST(ChangePriorityOfPendingJob)
+{
+	Wolf::JobsManager jobsManager(1, 1);
+	Wolf::Tests::ExecutionOrder executionOrder;
+
+	Wolf::Tests::StreamingThreadBlocker blocker(jobsManager);
+	std::vector<Wolf::JobsManager::StreamingJobToken> tokens(3);
+	for (uint32_t jobIdx = 0; jobIdx < tokens.size(); ++jobIdx)
+	{
+		jobsManager.addStreamingJob([&executionOrder, jobIdx]() { executionOrder.add(jobIdx); }, 1, &tokens[jobIdx]);
+	}
+
+	WOLF_CHECK(jobsManager.changeStreamingJobPriority(tokens[2], 10));
+	WOLF_CHECK(jobsManager.changeStreamingJobPriority(tokens[0], 0));
+	blocker.release();
+
+	WOLF_CHECK(executionOrder.waitForCount(3));
+	WOLF_CHECK(executionOrder.getOrder() == std::vector<uint32_t>({ 2, 1, 0 }));
+	WOLF_CHECK(!jobsManager.changeStreamingJobPriority(tokens[1], 5));
+}
+
+WOLF_TEST(JobsRejectedOverPendingLimit)
+{
+	constexpr uint32_t MAX_PENDING_JOB_COUNT = 8;
+	Wolf::JobsManager jobsManager(1, 1, MAX_PENDING_JOB_COUNT);
+	std::atomic<uint32_t> executedCount = 0;
+
+	Wolf::Tests::StreamingThreadBlocker blocker(jobsManager);
+	for (uint32_t jobIdx = 0; jobIdx < MAX_PENDING_JOB_COUNT; ++jobIdx)
+	{
+		WOLF_CHECK(jobsManager.addStreamingJob([&]() { executedCount++; }) == Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	}
+
+	Wolf::JobsManager::StreamingJobToken rejectedToken = 1234;
+	WOLF_CHECK(jobsManager.addStreamingJob([&]() { executedCount++; }, 0, &rejectedToken) == Wolf::JobsManager::AddedJobStatus::REJECTED);
+	WOLF_CHECK_EQUAL(rejectedToken, Wolf::JobsManager::INVALID_STREAMING_JOB_TOKEN);
+	blocker.release();
+
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, MAX_PENDING_JOB_COUNT));
+	WOLF_CHECK(jobsManager.addStreamingJob([&]() { executedCount++; }) == Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, MAX_PENDING_JOB_COUNT + 1));
+}
+
+WOLF_TEST(ManyWorkersExecuteEveryJob)
+{
+	std::atomic<uint32_t> executedCount = 0;
+	{
+		Wolf::JobsManager jobsManager(1, 4);
+		for (uint32_t jobIdx = 0; jobIdx < 1000; ++jobIdx)
+		{
+			while (jobsManager.addStreamingJob([&]() { executedCount++; }, jobIdx % 7) == Wolf::JobsManager::AddedJobStatus::REJECTED)
+				std::this_thread::yield();
+		}
+		WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, 1000));
+	}
+	WOLF_CHECK_EQUAL(executedCount.load(), 1000u);
+}
+
+WOLF_TEST(ResumedAsyncTasksDontCountInPendingLimit)
+{
+	constexpr uint32_t MAX_PENDING_JOB_COUNT = 2;
+	Wolf::JobsManager jobsManager(1, 1, MAX_PENDING_JOB_COUNT);
+	Wolf::AsyncEvent event;
+	std::atomic<uint32_t> startedTaskCount = 0, resumedTaskCount = 0, executedCount = 0;
+
+	for (uint32_t taskIdx = 0; taskIdx < MAX_PENDING_JOB_COUNT; ++taskIdx)
+	{
+		WOLF_CHECK(jobsManager.addStreamingAsyncTask(waitForEvent(event, startedTaskCount, resumedTaskCount)) == Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	}
+	WOLF_CHECK(Wolf::Tests::waitForCount(startedTaskCount, MAX_PENDING_JOB_COUNT));
+
+	// Tasks are suspended once the streaming thread runs the blocker, their resumes stay pending
+	Wolf::Tests::StreamingThreadBlocker blocker(jobsManager);
+	event.set();
+
+	for (uint32_t jobIdx = 0; jobIdx < MAX_PENDING_JOB_COUNT; ++jobIdx)
+	{
+		WOLF_CHECK(jobsManager.addStreamingJob([&]() { executedCount++; }) == Wolf::JobsManager::AddedJobStatus::SUCCESS);
+	}
+	WOLF_CHECK(jobsManager.addStreamingJob([&]() { executedCount++; }) == Wolf::JobsManager::AddedJobStatus::REJECTED);
+	blocker.release();
+
+	WOLF_CHECK(Wolf::Tests::waitForCount(resumedTaskCount, MAX_PENDING_JOB_COUNT));
+	WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, MAX_PENDING_JOB_COUNT));
+}
+
+WOLF_TEST(SleepingJobsOverlapOnEveryStreamingThread)
+{
+	// Jobs waiting for I/O don't use a CPU, each streaming thread runs one of them at the same time even with fewer CPUs
+	for (uint32_t streamingThreadCount = 1; streamingThreadCount <= 4; ++streamingThreadCount)
+	{
+		constexpr uint32_t JOB_COUNT = 16;
+		std::atomic<uint32_t> runningCount = 0, maxRunningCount = 0, executedCount = 0;
+		{
+			Wolf::JobsManager jobsManager(1, streamingThreadCount);
+			for (uint32_t jobIdx = 0; jobIdx < JOB_COUNT; ++jobIdx)
+			{
+				jobsManager.addStreamingJob([&]()
+				{
+					const uint32_t currentRunningCount = ++runningCount;
+					uint32_t previousMax = maxRunningCount.load();
+					while (previousMax < currentRunningCount && !maxRunningCount.compare_exchange_weak(previousMax, currentRunningCount)) {}
+
+					std::this_thread::sleep_for(std::chrono::milliseconds(20));
+					runningCount--;
+					executedCount++;
+				});
+			}
+			WOLF_CHECK(Wolf::Tests::waitForCount(executedCount, JOB_COUNT));
+		}
+		WOLF_CHECK_EQUAL(maxRunningCount.load(), streamingThreadCount);
+	}
+}
@@ -0,0 +1,87 @@
+#include "TestFramework.h"
+
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+#include <Debug.h>
+
+namespace
+{
+	struct RegisteredTest
+	{
+		const char* m_name;
+		Wolf::Tests::TestRegistration::TestFunction m_function;
+	};
+
+	std::vector<RegisteredTest>& getRegisteredTests()
+	{
+		static std::vector<RegisteredTest> registeredTests;
+		return registeredTests;
+	}
+
+	const char* g_currentTestName = nullptr;
+	std::atomic<uint32_t> g_failureCount = 0;
+	std::atomic<uint32_t> g_errorCount = 0;
+	std::atomic<uint32_t> g_expectedErrorsScopeCount = 0;
+}
+
+Wolf::Tests::TestRegistration::TestRegistration(const char* name, TestFunction function)
+{
+	getRegisteredTests().push_back({ name, function });
+}
+
+void Wolf::Tests::reportFailure(const char* file, int line, const std::string& message)
+{
+	std::printf("  %s(%d): %s failed: %s\n", file, line, g_currentTestName, message.c_str());
+	g_failureCount++;
+}
+
+Wolf::Tests::ExpectedErrorsScope::ExpectedErrorsScope(uint32_t expectedErrorCount, const std::source_location& location)
+	: m_expectedErrorCount(expectedErrorCount), m_errorCountAtStart(g_errorCount.load()), m_location(location)
+{
+	g_expectedErrorsScopeCount++;
+}
+
+Wolf::Tests::ExpectedErrorsScope::~ExpectedErrorsScope()
+{
+	const uint32_t errorCount = g_errorCount.load() - m_errorCountAtStart;
+	g_expectedErrorsScopeCount--;
+	if (errorCount != m_expectedErrorCount)
+	{
+		reportFailure(m_location.file_name(), static_cast<int>(m_location.line()), std::to_string(m_expectedErrorCount) + " errors expected, got " + std::to_string(errorCount));
+	}
+}
+
+int main()
+{
+	Wolf::Debug::setCallback([](Wolf::Debug::Severity severity, Wolf::Debug::Type, const std::string& message)
+	{
+		if (severity != Wolf::Debug::Severity::ERROR)
+			return;
+
+		g_errorCount++;
+		if (g_expectedErrorsScopeCount.load() == 0)
+		{
+			std::printf("  %s: unexpected error: %s\n", g_currentTestName, message.c_str());
+			g_failureCount++;
+		}
+	});
+
+	uint32_t failedTestCount = 0;
+	for (const RegisteredTest& test : getRegisteredTests())
+	{
+		g_currentTestName = test.m_name;
+		const uint32_t failureCountBefore = g_failureCount.load();
+
+		test.m_function();
+
+		const bool failed = g_failureCount.load() != failureCountBefore;
+		std::printf("[%s] %s\n", failed ? "FAILED" : "  OK  ", test.m_name);
+		if (failed)
+			failedTestCount++;
+	}
+
+	std::printf("%zu tests, %u failed\n", getRegisteredTests().size(), failedTestCount);
+	return failedTestCount == 0 ? 0 : 1;
+}
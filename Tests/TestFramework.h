@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace Wolf::Tests
+{
+	// Tests are registered during static initialization and all executed by the main of TestFramework.cpp.
+	// A failed check is reported and the test continues
+	class TestRegistration
+	{
+	public:
+		using TestFunction = void (*)();
+		TestRegistration(const char* name, TestFunction function);
+	};
+
+	void reportFailure(const char* file, int line, const std::string& message);
+
+	// Errors sent through Debug fail the running test, except the count expected while this scope is alive
+	class ExpectedErrorsScope
+	{
+	public:
+		explicit ExpectedErrorsScope(uint32_t expectedErrorCount, const std::source_location& location = std::source_location::current());
+		~ExpectedErrorsScope();
+
+		ExpectedErrorsScope(const ExpectedErrorsScope&) = delete;
+		ExpectedErrorsScope& operator=(const ExpectedErrorsScope&) = delete;
+
+	private:
+		uint32_t m_expectedErrorCount;
+		uint32_t m_errorCountAtStart;
+		std::source_location m_location;
+	};
+
+	template <typename T>
+	std::string toTestString(const T& value)
+	{
+		std::ostringstream stream;
+		if constexpr (std::is_same_v<T, uint8_t> || std::is_same_v<T, int8_t>)
+			stream << static_cast<int>(value);
+		else
+			stream << value;
+		return stream.str();
+	}
+}
+
+#define WOLF_TEST(name) \
+	static void name(); \
+	static const Wolf::Tests::TestRegistration name##Registration(#name, &name); \
+	static void name()
+
+#define WOLF_CHECK(condition) \
+	do { if (!(condition)) Wolf::Tests::reportFailure(__FILE__, __LINE__, #condition); } while (false)
+
+#define WOLF_CHECK_EQUAL(actual, expected) \
+	do { const auto& wolfActual = (actual); const auto& wolfExpected = (expected); \
+		if (!(wolfActual == wolfExpected)) Wolf::Tests::reportFailure(__FILE__, __LINE__, std::string(#actual " == " #expected ", got ") + \
+			Wolf::Tests::toTestString(wolfActual) + " instead of " + Wolf::Tests::toTestString(wolfExpected)); } while (false)
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+#include "JobsManager.h"
+#include "TestFramework.h"
+#include "ThreadTopology.h"
+
+WOLF_TEST(ParseCGroupV2CPUQuota)
+{
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("max 100000\n"), 0u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("200000 100000\n"), 2u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("250000 100000"), 3u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("50000 100000"), 1u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("1600000 100000 \n"), 16u);
+
+	// Invalid content means no limit
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota(""), 0u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("max"), 0u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("garbage"), 0u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("abc 100000"), 0u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("100000 abc"), 0u);
+	WOLF_CHECK_EQUAL(Wolf::parseCGroupV2CPUQuota("100000 0"), 0u);
+}
+
+WOLF_TEST(ComputeCGroupV1CPUQuota)
+{
+	WOLF_CHECK_EQUAL(Wolf::computeCGroupV1CPUQuota(-1, 100000), 0u);
+	WOLF_CHECK_EQUAL(Wolf::computeCGroupV1CPUQuota(0, 100000), 0u);
+	WOLF_CHECK_EQUAL(Wolf::computeCGroupV1CPUQuota(400000, 100000), 4u);
+	WOLF_CHECK_EQUAL(Wolf::computeCGroupV1CPUQuota(150000, 100000), 2u);
+	WOLF_CHECK_EQUAL(Wolf::computeCGroupV1CPUQuota(10000, 100000), 1u);
+	WOLF_CHECK_EQUAL(Wolf::computeCGroupV1CPUQuota(100000, -1), 0u);
+}
+
+WOLF_TEST(ComputeThreadLayout)
+{
+	struct ExpectedLayout
+	{
+		uint32_t m_availableCPUCount;
+		uint32_t m_beforeFrameAndRecordThreadCount;
+		uint32_t m_streamingThreadCount;
+	};
+	constexpr ExpectedLayout expectedLayouts[] =
+	{
+		{ 1, 0, 1 },
+		{ 2, 1, 1 },
+		{ 4, 2, 1 },
+		{ 8, 6, 1 },
+		{ 16, 13, 2 },
+		{ 32, 27, 4 },
+		{ 64, 59, 4 },
+	};
+
+	for (const ExpectedLayout& expectedLayout : expectedLayouts)
+	{
+		const Wolf::ThreadLayout threadLayout = Wolf::computeThreadLayout(expectedLayout.m_availableCPUCount);
+		WOLF_CHECK_EQUAL(threadLayout.m_beforeFrameAndRecordThreadCount, expectedLayout.m_beforeFrameAndRecordThreadCount);
+		WOLF_CHECK_EQUAL(threadLayout.m_streamingThreadCount, expectedLayout.m_streamingThreadCount);
+
+		// The main thread always keeps a CPU when there's more than one
+		if (expectedLayout.m_availableCPUCount > 2)
+			WOLF_CHECK(threadLayout.m_beforeFrameAndRecordThreadCount + threadLayout.m_streamingThreadCount + 1 <= expectedLayout.m_availableCPUCount);
+	}
+}
+
+WOLF_TEST(AvailableCPUCount)
+{
+	const uint32_t availableCPUCount = Wolf::getAvailableCPUCount();
+	WOLF_CHECK(availableCPUCount >= 1);
+	WOLF_CHECK(availableCPUCount <= std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+WOLF_TEST(AutomaticThreadCountsAndNames)
+{
+	Wolf::JobsManager jobsManager(Wolf::JobsManager::AUTOMATIC_THREAD_COUNT, Wolf::JobsManager::AUTOMATIC_THREAD_COUNT);
+	WOLF_CHECK_EQUAL(jobsManager.getParallelThreadCount(), Wolf::computeThreadLayout(Wolf::getAvailableCPUCount()).m_beforeFrameAndRecordThreadCount + 1);
+
+#ifdef __linux__
+	const std::thread::id mainThreadId = std::this_thread::get_id();
+	std::atomic<uint32_t> wronglyNamedThreadCount = 0;
+	for (uint32_t jobIdx = 0; jobIdx < 64; ++jobIdx)
+	{
+		jobsManager.addJobBeforeFrame([&]()
+		{
+			char threadName[16];
+			pthread_getname_np(pthread_self(), threadName, sizeof(threadName));
+
+			// The calling thread takes part in the execution
+			if (std::string(threadName).rfind("BeforeFrame", 0) != 0 && std::this_thread::get_id() != mainThreadId)
+				wronglyNamedThreadCount++;
+		});
+	}
+	jobsManager.executeJobsBeforeFrame();
+	WOLF_CHECK_EQUAL(wronglyNamedThreadCount.load(), 0u);
+#endif
+}
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "ConfigurationHelper.h"
+#include "ContentHash.h"
+#include "JobsManager.h"
+#include "TestFramework.h"
+#include "VirtualTextureManager.h"
+#include "VirtualTextureSliceBaker.h"
+
+// Slices are read back the way MaterialsGPUManager loads them: info.txt through ConfigurationHelper, slice files checked as uploadVirtualTextureSlice does
+
+namespace
+{
+	constexpr uint32_t VIRTUAL_PAGE_SIZE = Wolf::VirtualTextureManager::VIRTUAL_PAGE_SIZE;
+	constexpr uint32_t BORDER_SIZE = Wolf::VirtualTextureManager::BORDER_SIZE;
+	constexpr uint32_t TEXTURE_SIZE = 512;
+
+	std::vector<unsigned char> createTexture(uint32_t size)
+	{
+		std::vector<unsigned char> pixels(static_cast<size_t>(size) * size * 4);
+		for (uint32_t y = 0; y < size; ++y)
+		{
+			for (uint32_t x = 0; x < size; ++x)
+			{
+				unsigned char* pixel = &pixels[(x + static_cast<size_t>(y) * size) * 4];
+				pixel[0] = static_cast<unsigned char>(x ^ y);
+				pixel[1] = static_cast<unsigned char>((x * 3 + y) >> 2);
+				pixel[2] = static_cast<unsigned char>(y);
+				pixel[3] = 255;
+			}
+		}
+		return pixels;
+	}
+
+	std::vector<uint8_t> readFile(const std::filesystem::path& filepath)
+	{
+		std::ifstream file(filepath, std::ios::binary);
+		return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	// Slice filename with its mip level, for every page of every mip level
+	std::map<std::string, uint32_t> computeExpectedSlices(uint32_t size)
+	{
+		std::map<std::string, uint32_t> slices;
+		for (uint32_t mipLevel = 0; (size >> mipLevel) >= 4; ++mipLevel)
+		{
+			const uint32_t sliceCount = std::max((size >> mipLevel) / VIRTUAL_PAGE_SIZE, 1u);
+			for (uint32_t sliceY = 0; sliceY < sliceCount; ++sliceY)
+			{
+				for (uint32_t sliceX = 0; sliceX < sliceCount; ++sliceX)
+					slices["mip" + std::to_string(mipLevel) + "_sliceX" + std::to_string(sliceX) + "_sliceY" + std::to_string(sliceY) + ".bin"] = mipLevel;
+			}
+		}
+		return slices;
+	}
+
+	// Same checks as uploadVirtualTextureSlice, with the hash that it doesn't check yet. Returns the file size
+	uint64_t checkSliceFile(const std::filesystem::path& filepath, uint32_t mipLevel, float pixelSizeInBytes)
+	{
+		const std::vector<uint8_t> content = readFile(filepath);
+		const std::span<const uint8_t> sliceFileContent(content);
+
+		constexpr size_t HEADER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+		WOLF_CHECK(sliceFileContent.size() >= HEADER_SIZE);
+		if (sliceFileContent.size() < HEADER_SIZE)
+			return sliceFileContent.size();
+
+		uint64_t hash = 0;
+		uint32_t dataBytesCount = 0;
+		std::memcpy(&hash, sliceFileContent.data(), sizeof(hash));
+		std::memcpy(&dataBytesCount, sliceFileContent.data() + sizeof(uint64_t), sizeof(dataBytesCount));
+		WOLF_CHECK_EQUAL(sliceFileContent.size() - HEADER_SIZE, static_cast<size_t>(dataBytesCount));
+		if (sliceFileContent.size() - HEADER_SIZE < dataBytesCount)
+			return sliceFileContent.size();
+
+		const std::span<const uint8_t> data = sliceFileContent.subspan(HEADER_SIZE, dataBytesCount);
+		WOLF_CHECK_EQUAL(hash, Wolf::computeContentHash({ reinterpret_cast<const char*>(data.data()), data.size() }));
+
+		const uint32_t sliceSide = std::min(TEXTURE_SIZE >> mipLevel, VIRTUAL_PAGE_SIZE) + 2 * BORDER_SIZE;
+		WOLF_CHECK_EQUAL(static_cast<float>(sliceSide) * static_cast<float>(sliceSide) * pixelSizeInBytes, static_cast<float>(dataBytesCount));
+
+		return sliceFileContent.size();
+	}
+
+	std::set<std::string> listFiles(const std::string& folder)
+	{
+		std::set<std::string> filenames;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(folder))
+			filenames.insert(entry.path().filename().string());
+		return filenames;
+	}
+}
+
+WOLF_TEST(BakeEveryTextureType)
+{
+	struct TextureTypeInfo
+	{
+		Wolf::VirtualTextureSliceBaker::TextureType textureType;
+		const char* name;
+		float pixelSizeInBytes; // same as MaterialsGPUManager::computeVirtualTexturePixelSizeInBytes
+	};
+	const TextureTypeInfo textureTypeInfos[] =
+	{
+		{ Wolf::VirtualTextureSliceBaker::TextureType::ALBEDO, "albedo", 0.5f },
+		{ Wolf::VirtualTextureSliceBaker::TextureType::NORMAL, "normal", 1.0f },
+		{ Wolf::VirtualTextureSliceBaker::TextureType::COMBINED_ROUGHNESS_METALNESS_AO, "combined", 1.0f }
+	};
+
+	const std::vector<unsigned char> pixels = createTexture(TEXTURE_SIZE);
+	const std::map<std::string, uint32_t> expectedSlices = computeExpectedSlices(TEXTURE_SIZE);
+	WOLF_CHECK_EQUAL(static_cast<uint32_t>(expectedSlices.size()), Wolf::VirtualTextureSliceBaker::computeSliceCount(Wolf::Extent2D{ TEXTURE_SIZE, TEXTURE_SIZE }));
+
+	for (const TextureTypeInfo& textureTypeInfo : textureTypeInfos)
+	{
+		// Same folder format as the runtime, which appends filenames to it
+		const std::string folder = std::string("VirtualTextureSliceBakerTests_") + textureTypeInfo.name + "/";
+		std::filesystem::remove_all(folder);
+
+		Wolf::VirtualTextureSliceBaker::BakeInfo bakeInfo;
+		bakeInfo.textureType = textureTypeInfo.textureType;
+		Wolf::VirtualTextureSliceBaker::BakeStats stats;
+		WOLF_CHECK(Wolf::VirtualTextureSliceBaker::bake(pixels.data(), Wolf::Extent2D{ TEXTURE_SIZE, TEXTURE_SIZE }, folder, bakeInfo, &stats));
+
+		std::set<std::string> expectedFilenames = { "info.txt" };
+		for (const auto& [filename, mipLevel] : expectedSlices)
+			expectedFilenames.insert(filename);
+		WOLF_CHECK(listFiles(folder) == expectedFilenames);
+
+		WOLF_CHECK_EQUAL(std::stoi(Wolf::ConfigurationHelper::readInfoFromFile(folder + "info.txt", "width")), static_cast<int>(TEXTURE_SIZE));
+		WOLF_CHECK_EQUAL(std::stoi(Wolf::ConfigurationHelper::readInfoFromFile(folder + "info.txt", "height")), static_cast<int>(TEXTURE_SIZE));
+
+		uint64_t byteCount = 0;
+		for (const auto& [filename, mipLevel] : expectedSlices)
+			byteCount += checkSliceFile(folder + filename, mipLevel, textureTypeInfo.pixelSizeInBytes);
+		WOLF_CHECK_EQUAL(stats.sliceCount, static_cast<uint32_t>(expectedSlices.size()));
+		WOLF_CHECK_EQUAL(stats.byteCount, byteCount);
+	}
+}
+
+WOLF_TEST(SameSlicesWithOneAndSeveralThreads)
+{
+	const std::vector<unsigned char> pixels = createTexture(TEXTURE_SIZE);
+
+	// Without a JobsManager everything is baked by this thread
+	std::vector<std::string> folders;
+	for (const uint32_t workerCount : { 0u, 3u })
+	{
+		std::unique_ptr<Wolf::JobsManager> jobsManager(workerCount > 0 ? new Wolf::JobsManager(workerCount) : nullptr);
+
+		const std::string folder = "VirtualTextureSliceBakerTests_threads" + std::to_string(workerCount) + "/";
+		std::filesystem::remove_all(folder);
+		Wolf::VirtualTextureSliceBaker::BakeInfo bakeInfo;
+		bakeInfo.textureType = Wolf::VirtualTextureSliceBaker::TextureType::COMBINED_ROUGHNESS_METALNESS_AO;
+		WOLF_CHECK(Wolf::VirtualTextureSliceBaker::bake(pixels.data(), Wolf::Extent2D{ TEXTURE_SIZE, TEXTURE_SIZE }, folder, bakeInfo));
+		folders.push_back(folder);
+	}
+
+	const std::set<std::string> filenames = listFiles(folders[0]);
+	WOLF_CHECK(filenames == listFiles(folders[1]));
+	WOLF_CHECK_EQUAL(filenames.size(), computeExpectedSlices(TEXTURE_SIZE).size() + 1);
+	for (const std::string& filename : filenames)
+		WOLF_CHECK(readFile(folders[0] + filename) == readFile(folders[1] + filename));
+}
+
+WOLF_TEST(RejectNonSquareTextures)
+{
+	const std::vector<unsigned char> pixels(static_cast<size_t>(TEXTURE_SIZE) * (TEXTURE_SIZE / 2) * 4, 0);
+	const std::string folder = "VirtualTextureSliceBakerTests_nonSquare/";
+	std::filesystem::remove_all(folder);
+
+	Wolf::Tests::ExpectedErrorsScope expectedErrors(1);
+	WOLF_CHECK(!Wolf::VirtualTextureSliceBaker::bake(pixels.data(), Wolf::Extent2D{ TEXTURE_SIZE, TEXTURE_SIZE / 2 }, folder, Wolf::VirtualTextureSliceBaker::BakeInfo()));
+	WOLF_CHECK(!std::filesystem::exists(folder));
+}
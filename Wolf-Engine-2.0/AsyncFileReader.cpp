@@ -0,0 +1,128 @@
+#include "AsyncFileReader.h"
+
+#include <fstream>
+
+#include "ProfilerCommon.h"
+#include "ThreadTopology.h"
+
+Wolf::AsyncFileReader::AsyncFileReader(uint32_t threadCount, const ResumeFunction& resumeFunction) : m_resumeFunction(resumeFunction)
+{
+	for (uint32_t threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+	{
+		m_threads.emplace_back(&AsyncFileReader::execution, this, threadIdx);
+	}
+}
+
+Wolf::AsyncFileReader::~AsyncFileReader()
+{
+	stop();
+}
+
+void Wolf::AsyncFileReader::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopThreadsRequested = true;
+	}
+	m_runCondition.notify_all();
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+	m_threads.clear();
+
+	std::deque<Request> remainingRequests;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		remainingRequests.swap(m_requests);
+	}
+
+	// Results are left failed, resumed tasks can complete and free their frames
+	for (const Request& request : remainingRequests)
+	{
+		m_resumeFunction(request.m_handle);
+	}
+}
+
+bool Wolf::AsyncFileReader::ReadAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+	// Not suspended when the reader is stopped, the task continues with a failed result
+	return m_reader.submit({ this, handle });
+}
+
+Wolf::AsyncFileReader::ReadAwaiter Wolf::AsyncFileReader::read(const std::string& path, uint64_t offset, uint64_t size)
+{
+	return { *this, path, offset, size };
+}
+
+void Wolf::AsyncFileReader::readFile(const std::string& path, uint64_t offset, uint64_t size, ReadResult& outResult)
+{
+	outResult.m_success = false;
+	outResult.m_data.clear();
+
+	std::ifstream input(path, std::ios::in | std::ios::binary | std::ios::ate);
+	if (!input.is_open())
+		return;
+
+	const uint64_t fileSize = static_cast<uint64_t>(input.tellg());
+	if (offset > fileSize)
+		return;
+	if (size == WHOLE_FILE)
+		size = fileSize - offset;
+	if (offset + size > fileSize)
+		return;
+
+	outResult.m_data.resize(size);
+	input.seekg(static_cast<std::streamoff>(offset));
+	input.read(reinterpret_cast<char*>(outResult.m_data.data()), static_cast<std::streamsize>(size));
+	outResult.m_success = static_cast<uint64_t>(input.gcount()) == size;
+}
+
+void Wolf::AsyncFileReader::execution(uint32_t threadIdx)
+{
+	setCurrentThreadName("FileRead " + std::to_string(threadIdx));
+
+	for (;;)
+	{
+		Request request;
+		{
+			PROFILE_SCOPED("File read thread wait")
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_runCondition.wait(lock, [&]
+			{
+				return !m_requests.empty() || m_stopThreadsRequested;
+			});
+
+			if (m_stopThreadsRequested)
+			{
+				break;
+			}
+
+			request = m_requests.front();
+			m_requests.pop_front();
+		}
+
+		{
+			PROFILE_SCOPED("File read")
+
+			ReadAwaiter& awaiter = *request.m_awaiter;
+			readFile(awaiter.m_path, awaiter.m_offset, awaiter.m_size, awaiter.m_result);
+		}
+
+		m_resumeFunction(request.m_handle);
+	}
+}
+
+bool Wolf::AsyncFileReader::submit(const Request& request)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_stopThreadsRequested)
+			return false;
+		m_requests.push_back(request);
+	}
+	m_runCondition.notify_one();
+
+	return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Wolf
+{
+	// Blocking reads are done by a small pool of I/O threads so awaiting tasks don't hold a streaming thread.
+	// Portable thread pool backend, there's no io_uring dependency.
+	class AsyncFileReader
+	{
+	public:
+		// Called from an I/O thread with the task to resume once its read is done, or from stop() for reads not done
+		using ResumeFunction = std::function<void(std::coroutine_handle<>)>;
+		AsyncFileReader(uint32_t threadCount, const ResumeFunction& resumeFunction);
+		~AsyncFileReader();
+
+		// Joins the I/O threads. Reads not done yet fail and their tasks are resumed, later reads fail without suspending
+		void stop();
+
+		struct ReadResult
+		{
+			bool m_success = false;
+			std::vector<uint8_t> m_data;
+		};
+
+		static constexpr uint64_t WHOLE_FILE = static_cast<uint64_t>(-1);
+		class ReadAwaiter
+		{
+		public:
+			ReadAwaiter(AsyncFileReader& reader, std::string path, uint64_t offset, uint64_t size) : m_reader(reader), m_path(std::move(path)), m_offset(offset), m_size(size) {}
+
+			bool await_ready() const noexcept { return false; }
+			bool await_suspend(std::coroutine_handle<> handle);
+			ReadResult await_resume() { return std::move(m_result); }
+
+		private:
+			friend AsyncFileReader;
+
+			AsyncFileReader& m_reader;
+			std::string m_path;
+			uint64_t m_offset;
+			uint64_t m_size;
+			ReadResult m_result;
+		};
+		ReadAwaiter read(const std::string& path, uint64_t offset = 0, uint64_t size = WHOLE_FILE);
+
+		// Synchronous version, used by I/O threads
+		static void readFile(const std::string& path, uint64_t offset, uint64_t size, ReadResult& outResult);
+
+	private:
+		void execution(uint32_t threadIdx);
+
+		struct Request
+		{
+			ReadAwaiter* m_awaiter;
+			std::coroutine_handle<> m_handle;
+		};
+		bool submit(const Request& request); // false once stopped
+
+		ResumeFunction m_resumeFunction;
+
+		std::vector<std::thread> m_threads;
+		std::mutex m_mutex;
+		std::condition_variable m_runCondition;
+		std::deque<Request> m_requests;
+		bool m_stopThreadsRequested = false;
+	};
+}
@@ -0,0 +1,94 @@
+#include "AsyncTask.h"
+
+#include <utility>
+
+#include <Debug.h>
+
+#include "JobsManager.h"
+
+std::coroutine_handle<> Wolf::AsyncTask::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+{
+	promise_type& promise = handle.promise();
+	if (promise.m_continuation)
+		return promise.m_continuation; // frame is destroyed by the awaited AsyncTask
+
+	if (promise.m_detached)
+		handle.destroy();
+	return std::noop_coroutine();
+}
+
+void Wolf::AsyncTask::promise_type::unhandled_exception()
+{
+	Debug::sendCriticalError("Unhandled exception in async task");
+}
+
+Wolf::AsyncTask::AsyncTask(AsyncTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr))
+{
+}
+
+Wolf::AsyncTask& Wolf::AsyncTask::operator=(AsyncTask&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (m_handle)
+			m_handle.destroy();
+		m_handle = std::exchange(other.m_handle, nullptr);
+	}
+	return *this;
+}
+
+Wolf::AsyncTask::~AsyncTask()
+{
+	if (m_handle)
+		m_handle.destroy();
+}
+
+void Wolf::AsyncTask::start()
+{
+	if (!m_handle)
+	{
+		Debug::sendError("Starting an empty async task");
+		return;
+	}
+
+	std::coroutine_handle<promise_type> handle = std::exchange(m_handle, nullptr);
+	handle.promise().m_detached = true;
+	handle.resume();
+}
+
+std::coroutine_handle<> Wolf::AsyncTask::await_suspend(std::coroutine_handle<> awaitingHandle) noexcept
+{
+	m_handle.promise().m_continuation = awaitingHandle;
+	return m_handle;
+}
+
+void Wolf::AsyncEvent::set()
+{
+	std::vector<std::coroutine_handle<>> waitingHandles;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isSet = true;
+		waitingHandles.swap(m_waitingHandles);
+	}
+
+	for (std::coroutine_handle<> waitingHandle : waitingHandles)
+	{
+		g_jobsManager->resumeAsyncTask(waitingHandle);
+	}
+}
+
+bool Wolf::AsyncEvent::isSet() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_isSet;
+}
+
+bool Wolf::AsyncEvent::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+	std::lock_guard<std::mutex> lock(m_event.m_mutex);
+	if (m_event.m_isSet)
+		return false;
+
+	m_event.m_waitingHandles.push_back(handle);
+	return true;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <coroutine>
+#include <mutex>
+#include <vector>
+
+namespace Wolf
+{
+	// Coroutine executed on streaming threads, see JobsManager::addStreamingAsyncTask.
+	// The task is created suspended and only runs once started or awaited by another task.
+	class AsyncTask
+	{
+	public:
+		struct promise_type
+		{
+			std::coroutine_handle<> m_continuation;
+			bool m_detached = false;
+
+			AsyncTask get_return_object() { return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+			std::suspend_always initial_suspend() noexcept { return {}; }
+
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept { return false; }
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+				void await_resume() const noexcept {}
+			};
+			FinalAwaiter final_suspend() noexcept { return {}; }
+
+			void return_void() {}
+			void unhandled_exception();
+		};
+
+		AsyncTask() = default;
+		AsyncTask(AsyncTask&& other) noexcept;
+		AsyncTask& operator=(AsyncTask&& other) noexcept;
+		AsyncTask(const AsyncTask&) = delete;
+		AsyncTask& operator=(const AsyncTask&) = delete;
+		~AsyncTask();
+
+		// Runs the task on the calling thread until it first suspends. The task then owns itself and is destroyed once completed
+		void start();
+
+		// Awaiting a task runs it, the awaiting coroutine is resumed once it's completed
+		bool await_ready() const noexcept { return !m_handle; }
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaitingHandle) noexcept;
+		void await_resume() const noexcept {}
+
+	private:
+		explicit AsyncTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+		std::coroutine_handle<promise_type> m_handle;
+	};
+
+	// Awaiting tasks are resumed on a streaming thread once the event is set. Can be set from any thread (ex: when a GPU transfer is completed)
+	class AsyncEvent
+	{
+	public:
+		AsyncEvent() = default;
+		AsyncEvent(const AsyncEvent&) = delete;
+
+		void set();
+		[[nodiscard]] bool isSet() const;
+
+		struct Awaiter
+		{
+			AsyncEvent& m_event;
+
+			bool await_ready() const { return m_event.isSet(); }
+			bool await_suspend(std::coroutine_handle<> handle);
+			void await_resume() const noexcept {}
+		};
+		Awaiter operator co_await() { return { *this }; }
+
+	private:
+		mutable std::mutex m_mutex;
+		bool m_isSet = false;
+		std::vector<std::coroutine_handle<>> m_waitingHandles;
+	};
+}
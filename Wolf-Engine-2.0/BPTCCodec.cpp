@@ -0,0 +1,922 @@
+#include "BPTCCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/gtc/packing.hpp>
+#include <limits>
+
+namespace
+{
+    using RGBA8 = Wolf::ImageCompression::RGBA8;
+
+    // Blocks are 128 bits little endian streams
+    class BitReader
+    {
+    public:
+        explicit BitReader(const uint8_t* data) { memcpy(m_words, data, sizeof(m_words)); }
+
+        uint32_t read(uint32_t bitCount)
+        {
+            const uint32_t wordIdx = m_position >> 6;
+            const uint32_t bitIdx = m_position & 63;
+
+            uint64_t value = m_words[wordIdx] >> bitIdx;
+            if (bitIdx + bitCount > 64 && wordIdx == 0)
+                value |= m_words[1] << (64 - bitIdx);
+
+            m_position += bitCount;
+            return static_cast<uint32_t>(value & ((1ull << bitCount) - 1));
+        }
+
+    private:
+        uint64_t m_words[2];
+        uint32_t m_position = 0;
+    };
+
+    class BitWriter
+    {
+    public:
+        void write(uint32_t value, uint32_t bitCount)
+        {
+            const uint32_t wordIdx = m_position >> 6;
+            const uint32_t bitIdx = m_position & 63;
+
+            m_words[wordIdx] |= static_cast<uint64_t>(value) << bitIdx;
+            if (bitIdx + bitCount > 64 && wordIdx == 0)
+                m_words[1] |= static_cast<uint64_t>(value) >> (64 - bitIdx);
+
+            m_position += bitCount;
+        }
+
+        void copyTo(uint8_t* data) const { memcpy(data, m_words, sizeof(m_words)); }
+
+    private:
+        uint64_t m_words[2] = { 0, 0 };
+        uint32_t m_position = 0;
+    };
+
+    // Interpolation weights out of 64, by index bit count
+    constexpr uint8_t WEIGHTS_2[4] = { 0, 21, 43, 64 };
+    constexpr uint8_t WEIGHTS_3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+    constexpr uint8_t WEIGHTS_4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    const uint8_t* getWeights(uint32_t indexBitCount)
+    {
+        return indexBitCount == 2 ? WEIGHTS_2 : (indexBitCount == 3 ? WEIGHTS_3 : WEIGHTS_4);
+    }
+
+    int32_t interpolate(int32_t value0, int32_t value1, uint32_t weight)
+    {
+        return (value0 * (64 - static_cast<int32_t>(weight)) + value1 * static_cast<int32_t>(weight) + 32) >> 6;
+    }
+
+    // Subset of each texel, 1 bit per texel for 2 subsets and 2 bits per texel for 3 subsets
+    constexpr uint16_t BC7_PARTITIONS_2[64] =
+    {
+        0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80, 0xc800, 0xffec, 0xfe80, 0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000,
+        0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310, 0x3100, 0x8cce, 0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c,
+        0xaaaa, 0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a, 0x73ce, 0x13c8, 0x324c, 0x3bdc, 0x6996, 0xc33c, 0x9966, 0x0660,
+        0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6, 0x639c, 0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22
+    };
+    constexpr uint32_t BC7_PARTITIONS_3[64] =
+    {
+        0xaa685050, 0x6a5a5040, 0x5a5a4200, 0x5450a0a8, 0xa5a50000, 0xa0a05050, 0x5555a0a0, 0x5a5a5050,
+        0xaa550000, 0xaa555500, 0xaaaa5500, 0x90909090, 0x94949494, 0xa4a4a4a4, 0xa9a59450, 0x2a0a4250,
+        0xa5945040, 0x0a425054, 0xa5a5a500, 0x55a0a0a0, 0xa8a85454, 0x6a6a4040, 0xa4a45000, 0x1a1a0500,
+        0x0050a4a4, 0xaaa59090, 0x14696914, 0x69691400, 0xa08585a0, 0xaa821414, 0x50a4a450, 0x6a5a0200,
+        0xa9a58000, 0x5090a0a8, 0xa8a09050, 0x24242424, 0x00aa5500, 0x24924924, 0x24499224, 0x50a50a50,
+        0x500aa550, 0xaaaa4444, 0x66660000, 0xa5a0a5a0, 0x50a050a0, 0x69286928, 0x44aaaa44, 0x66666600,
+        0xaa444444, 0x54a854a8, 0x95809580, 0x96969600, 0xa85454a8, 0x80959580, 0xaa141414, 0x96960000,
+        0xaaaa1414, 0xa05050a0, 0xa0a5a5a0, 0x96000000, 0x40804080, 0xa9a8a9a8, 0xaaaaaa44, 0x2a4a5254
+    };
+
+    // Anchor texels store their index with one bit less, the anchor of the first subset is always texel 0
+    constexpr uint8_t BC7_ANCHORS_2[64] =
+    {
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+        15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+         6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15
+    };
+    constexpr uint8_t BC7_ANCHORS_3_SECOND[64] =
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3
+    };
+    constexpr uint8_t BC7_ANCHORS_3_THIRD[64] =
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8
+    };
+
+    struct BC7ModeInfo
+    {
+        uint32_t subsetCount;
+        uint32_t partitionBitCount;
+        uint32_t rotationBitCount;
+        uint32_t indexSelectionBitCount;
+        uint32_t colorBitCount;
+        uint32_t alphaBitCount;
+        bool hasEndpointPBits; // one p-bit per endpoint
+        bool hasSharedPBits; // one p-bit per subset
+        uint32_t indexBitCount;
+        uint32_t secondaryIndexBitCount;
+    };
+    constexpr BC7ModeInfo BC7_MODES[8] =
+    {
+        { 3, 4, 0, 0, 4, 0, true, false, 3, 0 },
+        { 2, 6, 0, 0, 6, 0, false, true, 3, 0 },
+        { 3, 6, 0, 0, 5, 0, false, false, 2, 0 },
+        { 2, 6, 0, 0, 7, 0, true, false, 2, 0 },
+        { 1, 0, 2, 1, 5, 6, false, false, 2, 3 },
+        { 1, 0, 2, 0, 7, 8, false, false, 2, 2 },
+        { 1, 0, 0, 0, 7, 7, true, false, 4, 0 },
+        { 2, 6, 0, 0, 5, 5, true, false, 2, 0 }
+    };
+
+    uint32_t getBC7Subset(const BC7ModeInfo& modeInfo, uint32_t partition, uint32_t texelIdx)
+    {
+        if (modeInfo.subsetCount == 2)
+            return (BC7_PARTITIONS_2[partition] >> texelIdx) & 1;
+        if (modeInfo.subsetCount == 3)
+            return (BC7_PARTITIONS_3[partition] >> (texelIdx * 2)) & 3;
+        return 0;
+    }
+
+    bool isBC7Anchor(const BC7ModeInfo& modeInfo, uint32_t partition, uint32_t texelIdx)
+    {
+        if (texelIdx == 0)
+            return true;
+        if (modeInfo.subsetCount == 2)
+            return texelIdx == BC7_ANCHORS_2[partition];
+        if (modeInfo.subsetCount == 3)
+            return texelIdx == BC7_ANCHORS_3_SECOND[partition] || texelIdx == BC7_ANCHORS_3_THIRD[partition];
+        return false;
+    }
+
+    // Endpoints are expanded to 8 bits by replicating their high bits
+    uint8_t expandBits(uint32_t value, uint32_t bitCount)
+    {
+        value <<= 8 - bitCount;
+        return static_cast<uint8_t>(value | (value >> bitCount));
+    }
+
+    // Endpoints are found along the principal axis of the texels, which is computed by power iteration on their covariance matrix
+    template <uint32_t ChannelCount>
+    void computeRangeFitEndpoints(const float (&texels)[16][ChannelCount], float (&outEndpoints)[2][ChannelCount])
+    {
+        float mean[ChannelCount] = {};
+        for (const float (&texel)[ChannelCount] : texels)
+        {
+            for (uint32_t c = 0; c < ChannelCount; ++c)
+                mean[c] += texel[c];
+        }
+        for (float& value : mean)
+            value *= 1.0f / 16.0f;
+
+        float covariance[ChannelCount][ChannelCount] = {};
+        for (const float (&texel)[ChannelCount] : texels)
+        {
+            for (uint32_t i = 0; i < ChannelCount; ++i)
+            {
+                for (uint32_t j = i; j < ChannelCount; ++j)
+                    covariance[i][j] += (texel[i] - mean[i]) * (texel[j] - mean[j]);
+            }
+        }
+
+        // Starts from the channel with the highest variance
+        uint32_t startChannel = 0;
+        for (uint32_t i = 0; i < ChannelCount; ++i)
+        {
+            for (uint32_t j = 0; j < i; ++j)
+                covariance[i][j] = covariance[j][i];
+            if (covariance[i][i] > covariance[startChannel][startChannel])
+                startChannel = i;
+        }
+
+        float axis[ChannelCount];
+        for (uint32_t c = 0; c < ChannelCount; ++c)
+            axis[c] = covariance[startChannel][c];
+
+        for (uint32_t iteration = 0; iteration < 8; ++iteration)
+        {
+            float nextAxis[ChannelCount] = {};
+            float maxComponent = 0.0f;
+            for (uint32_t i = 0; i < ChannelCount; ++i)
+            {
+                for (uint32_t j = 0; j < ChannelCount; ++j)
+                    nextAxis[i] += covariance[i][j] * axis[j];
+                maxComponent = std::max(maxComponent, std::abs(nextAxis[i]));
+            }
+
+            if (maxComponent == 0.0f)
+                break;
+            for (uint32_t c = 0; c < ChannelCount; ++c)
+                axis[c] = nextAxis[c] / maxComponent;
+        }
+
+        float lengthSquared = 0.0f;
+        for (const float value : axis)
+            lengthSquared += value * value;
+
+        float minProjection = 0.0f, maxProjection = 0.0f;
+        if (lengthSquared > 0.0f)
+        {
+            minProjection = std::numeric_limits<float>::max();
+            maxProjection = -std::numeric_limits<float>::max();
+            for (const float (&texel)[ChannelCount] : texels)
+            {
+                float projection = 0.0f;
+                for (uint32_t c = 0; c < ChannelCount; ++c)
+                    projection += (texel[c] - mean[c]) * axis[c];
+                minProjection = std::min(minProjection, projection);
+                maxProjection = std::max(maxProjection, projection);
+            }
+            minProjection /= lengthSquared;
+            maxProjection /= lengthSquared;
+        }
+
+        for (uint32_t c = 0; c < ChannelCount; ++c)
+        {
+            outEndpoints[0][c] = mean[c] + axis[c] * minProjection;
+            outEndpoints[1][c] = mean[c] + axis[c] * maxProjection;
+        }
+    }
+
+    // Least squares endpoints for the given interpolation weights, returns false when all weights are the same
+    template <uint32_t ChannelCount>
+    bool computeLeastSquaresEndpoints(const float (&texels)[16][ChannelCount], const uint8_t (&indices)[16], const uint8_t* weights, float (&outEndpoints)[2][ChannelCount])
+    {
+        float a00 = 0.0f, a01 = 0.0f, a11 = 0.0f;
+        float b0[ChannelCount] = {}, b1[ChannelCount] = {};
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        {
+            const float weight1 = static_cast<float>(weights[indices[texelIdx]]) / 64.0f;
+            const float weight0 = 1.0f - weight1;
+
+            a00 += weight0 * weight0;
+            a01 += weight0 * weight1;
+            a11 += weight1 * weight1;
+            for (uint32_t c = 0; c < ChannelCount; ++c)
+            {
+                b0[c] += weight0 * texels[texelIdx][c];
+                b1[c] += weight1 * texels[texelIdx][c];
+            }
+        }
+
+        const float determinant = a00 * a11 - a01 * a01;
+        if (std::abs(determinant) < 1e-6f)
+            return false;
+
+        const float inverseDeterminant = 1.0f / determinant;
+        for (uint32_t c = 0; c < ChannelCount; ++c)
+        {
+            outEndpoints[0][c] = (a11 * b0[c] - a01 * b1[c]) * inverseDeterminant;
+            outEndpoints[1][c] = (a00 * b1[c] - a01 * b0[c]) * inverseDeterminant;
+        }
+        return true;
+    }
+
+    // BC7 mode 6
+    struct BC7Mode6Endpoints
+    {
+        uint8_t values[2][4]; // 7 bits
+        uint8_t pBits[2];
+
+        int32_t get(uint32_t endpointIdx, uint32_t channelIdx) const { return (values[endpointIdx][channelIdx] << 1) | pBits[endpointIdx]; }
+    };
+
+    void quantizeBC7Endpoint(const float (&endpoint)[4], uint8_t pBit, uint8_t (&outValues)[4], float& outError)
+    {
+        outError = 0.0f;
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            const float value = std::clamp(endpoint[c], 0.0f, 255.0f);
+            const int32_t quantized = std::clamp(static_cast<int32_t>(std::lround((value - pBit) * 0.5f)), 0, 127);
+            outValues[c] = static_cast<uint8_t>(quantized);
+
+            const float difference = static_cast<float>((quantized << 1) | pBit) - value;
+            outError += difference * difference;
+        }
+    }
+
+    // Each endpoint gets the p-bit which quantizes it best
+    BC7Mode6Endpoints quantizeBC7Endpoints(const float (&endpoints)[2][4])
+    {
+        BC7Mode6Endpoints quantized{};
+        for (uint32_t endpointIdx = 0; endpointIdx < 2; ++endpointIdx)
+        {
+            uint8_t values[2][4];
+            float errors[2];
+            quantizeBC7Endpoint(endpoints[endpointIdx], 0, values[0], errors[0]);
+            quantizeBC7Endpoint(endpoints[endpointIdx], 1, values[1], errors[1]);
+
+            const uint8_t pBit = errors[1] < errors[0] ? 1 : 0;
+            memcpy(quantized.values[endpointIdx], values[pBit], 4);
+            quantized.pBits[endpointIdx] = pBit;
+        }
+        return quantized;
+    }
+
+    BC7Mode6Endpoints quantizeBC7Endpoints(const float (&endpoints)[2][4], uint8_t pBit0, uint8_t pBit1)
+    {
+        BC7Mode6Endpoints quantized{};
+        float error;
+        quantizeBC7Endpoint(endpoints[0], pBit0, quantized.values[0], error);
+        quantizeBC7Endpoint(endpoints[1], pBit1, quantized.values[1], error);
+        quantized.pBits[0] = pBit0;
+        quantized.pBits[1] = pBit1;
+        return quantized;
+    }
+
+    // Endpoints giving each 8 bits value with the weight of BC7_SINGLE_COLOR_INDEX, for each p-bits combination
+    constexpr uint8_t BC7_SINGLE_COLOR_INDEX = 5;
+    struct BC7SingleColorTable
+    {
+        uint8_t endpoints[4][256][2];
+        uint8_t errors[4][256];
+
+        BC7SingleColorTable()
+        {
+            for (uint32_t pBits = 0; pBits < 4; ++pBits)
+            {
+                bool isExact[256] = {};
+                for (int32_t start = 0; start < 128; ++start)
+                {
+                    for (int32_t end = 0; end < 128; ++end)
+                    {
+                        const int32_t value = interpolate((start << 1) | (pBits & 1), (end << 1) | (pBits >> 1), WEIGHTS_4[BC7_SINGLE_COLOR_INDEX]);
+                        isExact[value] = true;
+                        endpoints[pBits][value][0] = static_cast<uint8_t>(start);
+                        endpoints[pBits][value][1] = static_cast<uint8_t>(end);
+                    }
+                }
+
+                // Values which can't be reached exactly take the endpoints of the closest one
+                for (int32_t value = 0; value < 256; ++value)
+                {
+                    int32_t closestValue = value;
+                    for (int32_t distance = 0; !isExact[closestValue]; ++distance)
+                        closestValue = value - distance >= 0 && isExact[value - distance] ? value - distance : std::min(value + distance, 255);
+
+                    endpoints[pBits][value][0] = endpoints[pBits][closestValue][0];
+                    endpoints[pBits][value][1] = endpoints[pBits][closestValue][1];
+                    errors[pBits][value] = static_cast<uint8_t>(std::abs(closestValue - value));
+                }
+            }
+        }
+    };
+
+    uint32_t computeBC7Indices(const int32_t (&texels)[16][4], const BC7Mode6Endpoints& endpoints, uint8_t (&outIndices)[16])
+    {
+        int32_t palette[16][4];
+        for (uint32_t paletteIdx = 0; paletteIdx < 16; ++paletteIdx)
+        {
+            for (uint32_t c = 0; c < 4; ++c)
+                palette[paletteIdx][c] = interpolate(endpoints.get(0, c), endpoints.get(1, c), WEIGHTS_4[paletteIdx]);
+        }
+
+        uint32_t error = 0;
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        {
+            int32_t minDistance = std::numeric_limits<int32_t>::max();
+            uint32_t minPaletteIdx = 0;
+            for (uint32_t paletteIdx = 0; paletteIdx < 16; ++paletteIdx)
+            {
+                int32_t distance = 0;
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    const int32_t difference = palette[paletteIdx][c] - texels[texelIdx][c];
+                    distance += difference * difference;
+                }
+
+                const bool isCloser = distance < minDistance;
+                minDistance = isCloser ? distance : minDistance;
+                minPaletteIdx = isCloser ? paletteIdx : minPaletteIdx;
+            }
+            outIndices[texelIdx] = static_cast<uint8_t>(minPaletteIdx);
+            error += static_cast<uint32_t>(minDistance);
+        }
+        return error;
+    }
+
+    // BC6H unsigned, endpoints are fitted on half float bit patterns scaled to the 16 bits range used by interpolation
+    constexpr float BC6H_HALF_TO_INTERPOLATION_SCALE = 64.0f / 31.0f;
+
+    int32_t unquantizeBC6HUnsigned(int32_t value, uint32_t bitCount)
+    {
+        if (bitCount >= 15)
+            return value;
+        if (value == 0)
+            return 0;
+        if (value == (1 << bitCount) - 1)
+            return 0xffff;
+        return ((value << 16) + 0x8000) >> bitCount;
+    }
+
+    // Interpolated values are scaled back to half float bit patterns
+    uint16_t finishBC6HUnsigned(int32_t value)
+    {
+        return static_cast<uint16_t>((value * 31) >> 6);
+    }
+
+    void quantizeBC6HEndpoints(const float (&endpoints)[2][3], int32_t (&outEndpoints)[2][3])
+    {
+        for (uint32_t endpointIdx = 0; endpointIdx < 2; ++endpointIdx)
+        {
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                const float value = std::clamp(endpoints[endpointIdx][c], 0.0f, 65535.0f);
+                outEndpoints[endpointIdx][c] = std::clamp(static_cast<int32_t>(std::lround((value - 32.0f) / 64.0f)), 0, 1023);
+            }
+        }
+    }
+
+    uint64_t computeBC6HIndices(const int32_t (&halfTexels)[16][3], const int32_t (&endpoints)[2][3], uint8_t (&outIndices)[16])
+    {
+        int32_t palette[16][3];
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            const int32_t value0 = unquantizeBC6HUnsigned(endpoints[0][c], 10);
+            const int32_t value1 = unquantizeBC6HUnsigned(endpoints[1][c], 10);
+            for (uint32_t paletteIdx = 0; paletteIdx < 16; ++paletteIdx)
+                palette[paletteIdx][c] = finishBC6HUnsigned(interpolate(value0, value1, WEIGHTS_4[paletteIdx]));
+        }
+
+        uint64_t error = 0;
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        {
+            int64_t minDistance = std::numeric_limits<int64_t>::max();
+            uint32_t minPaletteIdx = 0;
+            for (uint32_t paletteIdx = 0; paletteIdx < 16; ++paletteIdx)
+            {
+                int64_t distance = 0;
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    const int64_t difference = palette[paletteIdx][c] - halfTexels[texelIdx][c];
+                    distance += difference * difference;
+                }
+
+                const bool isCloser = distance < minDistance;
+                minDistance = isCloser ? distance : minDistance;
+                minPaletteIdx = isCloser ? paletteIdx : minPaletteIdx;
+            }
+            outIndices[texelIdx] = static_cast<uint8_t>(minPaletteIdx);
+            error += static_cast<uint64_t>(minDistance);
+        }
+        return error;
+    }
+
+    int32_t signExtend(uint32_t value, uint32_t bitCount)
+    {
+        const uint32_t signBit = 1u << (bitCount - 1);
+        return static_cast<int32_t>((value ^ signBit)) - static_cast<int32_t>(signBit);
+    }
+
+    // BC6H two regions modes (1 to 10), endpoints w and x belong to the first region, y and z to the second one.
+    // Endpoint bits are scattered in the block, each field gives bitCount bits of an endpoint channel starting at firstBit
+    enum BC6HEndpointChannel : uint8_t { RW, GW, BW, RX, GX, BX, RY, GY, BY, RZ, GZ, BZ };
+    struct BC6HField
+    {
+        uint8_t endpointChannel;
+        uint8_t firstBit;
+        uint8_t bitCount;
+    };
+    struct BC6HTwoRegionsModeInfo
+    {
+        uint32_t mode;
+        uint32_t endpointBitCount;
+        uint32_t deltaBitCounts[3]; // 0 when x, y and z are not stored as deltas from w
+        uint32_t fieldCount;
+        BC6HField fields[22];
+    };
+    constexpr BC6HTwoRegionsModeInfo BC6H_TWO_REGIONS_MODES[10] =
+    {
+        { 0x00, 10, { 5, 5, 5 }, 19, { { GY, 4, 1 }, { BY, 4, 1 }, { BZ, 4, 1 }, { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 },
+            { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 } } },
+        { 0x01, 7, { 6, 6, 6 }, 21, { { GY, 5, 1 }, { GZ, 4, 2 }, { RW, 0, 7 }, { BZ, 0, 2 }, { BY, 4, 1 }, { GW, 0, 7 }, { BY, 5, 1 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 7 },
+            { BZ, 3, 1 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 6 }, { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 } } },
+        { 0x02, 11, { 5, 4, 4 }, 18, { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 5 }, { RW, 10, 1 }, { GY, 0, 4 }, { GX, 0, 4 }, { GW, 10, 1 }, { BZ, 0, 1 }, { GZ, 0, 4 },
+            { BX, 0, 4 }, { BW, 10, 1 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 } } },
+        { 0x06, 11, { 4, 5, 4 }, 20, { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 10, 1 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 }, { GW, 10, 1 }, { GZ, 0, 4 },
+            { BX, 0, 4 }, { BW, 10, 1 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 4 }, { BZ, 0, 1 }, { BZ, 2, 1 }, { RZ, 0, 4 }, { GY, 4, 1 }, { BZ, 3, 1 } } },
+        { 0x0a, 11, { 4, 4, 5 }, 19, { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 10, 1 }, { BY, 4, 1 }, { GY, 0, 4 }, { GX, 0, 4 }, { GW, 10, 1 }, { BZ, 0, 1 },
+            { GZ, 0, 4 }, { BX, 0, 5 }, { BW, 10, 1 }, { BY, 0, 4 }, { RY, 0, 4 }, { BZ, 1, 2 }, { RZ, 0, 4 }, { BZ, 4, 1 }, { BZ, 3, 1 } } },
+        { 0x0e, 9, { 5, 5, 5 }, 19, { { RW, 0, 9 }, { BY, 4, 1 }, { GW, 0, 9 }, { GY, 4, 1 }, { BW, 0, 9 }, { BZ, 4, 1 }, { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 },
+            { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 } } },
+        { 0x12, 8, { 6, 5, 5 }, 18, { { RW, 0, 8 }, { GZ, 4, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 8 }, { BZ, 3, 2 }, { RX, 0, 6 }, { GY, 0, 4 },
+            { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 } } },
+        { 0x16, 8, { 5, 6, 5 }, 21, { { RW, 0, 8 }, { BZ, 0, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { GY, 5, 1 }, { GY, 4, 1 }, { BW, 0, 8 }, { GZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 5 },
+            { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 6 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 } } },
+        { 0x1a, 8, { 5, 5, 6 }, 21, { { RW, 0, 8 }, { BZ, 1, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { BY, 5, 1 }, { GY, 4, 1 }, { BW, 0, 8 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 5 },
+            { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 } } },
+        { 0x1e, 6, { 0, 0, 0 }, 22, { { RW, 0, 6 }, { GZ, 4, 1 }, { BZ, 0, 2 }, { BY, 4, 1 }, { GW, 0, 6 }, { GY, 5, 1 }, { BY, 5, 1 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 6 },
+            { GZ, 5, 1 }, { BZ, 3, 1 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 6 }, { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 } } }
+    };
+
+    // Mode and endpoints take 77 bits, followed by the 5 bits partition and the 46 bits of indices.
+    // Modes are looked up by index, 3 to 10 from the 3 high mode bits
+    constexpr bool isBC6HTwoRegionsModeTableValid()
+    {
+        for (uint32_t modeIdx = 0; modeIdx < 10; ++modeIdx)
+        {
+            if (BC6H_TWO_REGIONS_MODES[modeIdx].mode != (modeIdx < 2 ? modeIdx : ((modeIdx - 2) << 2) | 0x02))
+                return false;
+
+            uint32_t bitCount = modeIdx < 2 ? 2 : 5;
+            for (uint32_t fieldIdx = 0; fieldIdx < BC6H_TWO_REGIONS_MODES[modeIdx].fieldCount; ++fieldIdx)
+                bitCount += BC6H_TWO_REGIONS_MODES[modeIdx].fields[fieldIdx].bitCount;
+            if (bitCount != 77)
+                return false;
+        }
+        return true;
+    }
+    static_assert(isBC6HTwoRegionsModeTableValid(), "BC6H two regions modes are not in order or their fields don't fill 77 bits");
+
+    // Reader is positioned after the mode bits. Regions use the first 32 BC7 two subsets partitions
+    void decodeBC6HTwoRegionsBlock(BitReader& reader, const BC6HTwoRegionsModeInfo& modeInfo, Wolf::ImageCompression::RGBA16F outTexels[16])
+    {
+        static constexpr uint16_t HALF_ONE = 0x3c00;
+
+        uint32_t endpoints[4][3] = {};
+        for (uint32_t fieldIdx = 0; fieldIdx < modeInfo.fieldCount; ++fieldIdx)
+        {
+            const BC6HField& field = modeInfo.fields[fieldIdx];
+            endpoints[field.endpointChannel / 3][field.endpointChannel % 3] |= reader.read(field.bitCount) << field.firstBit;
+        }
+        const uint32_t partition = reader.read(5);
+
+        int32_t values[4][3];
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            for (uint32_t endpointIdx = 0; endpointIdx < 4; ++endpointIdx)
+            {
+                if (endpointIdx > 0 && modeInfo.deltaBitCounts[c] > 0)
+                    endpoints[endpointIdx][c] = static_cast<uint32_t>(static_cast<int32_t>(endpoints[0][c]) + signExtend(endpoints[endpointIdx][c], modeInfo.deltaBitCounts[c])) &
+                        ((1u << modeInfo.endpointBitCount) - 1);
+                values[endpointIdx][c] = unquantizeBC6HUnsigned(static_cast<int32_t>(endpoints[endpointIdx][c]), modeInfo.endpointBitCount);
+            }
+        }
+
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        {
+            const bool isAnchor = texelIdx == 0 || texelIdx == BC7_ANCHORS_2[partition];
+            const uint32_t weight = WEIGHTS_3[reader.read(isAnchor ? 2 : 3)];
+            const int32_t (&value0)[3] = values[((BC7_PARTITIONS_2[partition] >> texelIdx) & 1) * 2];
+            const int32_t (&value1)[3] = values[((BC7_PARTITIONS_2[partition] >> texelIdx) & 1) * 2 + 1];
+            outTexels[texelIdx] = Wolf::ImageCompression::RGBA16F(finishBC6HUnsigned(interpolate(value0[0], value1[0], weight)),
+                finishBC6HUnsigned(interpolate(value0[1], value1[1], weight)), finishBC6HUnsigned(interpolate(value0[2], value1[2], weight)), HALF_ONE);
+        }
+    }
+}
+
+void Wolf::encodeBC7Block(const ImageCompression::RGBA8* firstTexel, uint32_t rowPitch, ImageCompression::Quality quality, ImageCompression::BC7& outBlock)
+{
+    float texels[16][4];
+    int32_t integerTexels[16][4];
+    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+    {
+        const RGBA8& texel = firstTexel[texelIdx % 4 + (texelIdx / 4) * rowPitch];
+        const int32_t values[4] = { texel.r, texel.g, texel.b, texel.a };
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            integerTexels[texelIdx][c] = values[c];
+            texels[texelIdx][c] = static_cast<float>(values[c]);
+        }
+    }
+
+    bool isSingleColor = true;
+    for (uint32_t texelIdx = 1; texelIdx < 16; ++texelIdx)
+        isSingleColor &= memcmp(integerTexels[texelIdx], integerTexels[0], sizeof(integerTexels[0])) == 0;
+
+    BC7Mode6Endpoints quantizedEndpoints;
+    uint8_t indices[16];
+    uint32_t error;
+    float endpoints[2][4];
+    if (isSingleColor)
+    {
+        // Rounding endpoints alone can't give values with a different parity on each channel
+        static const BC7SingleColorTable table;
+
+        uint32_t bestPBits = 0;
+        uint32_t bestError = std::numeric_limits<uint32_t>::max();
+        for (uint32_t pBits = 0; pBits < 4; ++pBits)
+        {
+            uint32_t pBitsError = 0;
+            for (uint32_t c = 0; c < 4; ++c)
+                pBitsError += table.errors[pBits][integerTexels[0][c]];
+            if (pBitsError < bestError)
+            {
+                bestError = pBitsError;
+                bestPBits = pBits;
+            }
+        }
+
+        quantizedEndpoints.pBits[0] = bestPBits & 1;
+        quantizedEndpoints.pBits[1] = static_cast<uint8_t>(bestPBits >> 1);
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            quantizedEndpoints.values[0][c] = table.endpoints[bestPBits][integerTexels[0][c]][0];
+            quantizedEndpoints.values[1][c] = table.endpoints[bestPBits][integerTexels[0][c]][1];
+        }
+        memset(indices, BC7_SINGLE_COLOR_INDEX, sizeof(indices));
+        error = 0;
+    }
+    else
+    {
+        computeRangeFitEndpoints(texels, endpoints);
+        quantizedEndpoints = quantizeBC7Endpoints(endpoints);
+        error = computeBC7Indices(integerTexels, quantizedEndpoints, indices);
+    }
+
+    // Endpoints are refined from the indices, all p-bits combinations are tried as the best ones are often not the closest ones
+    if (quality == ImageCompression::Quality::HIGH && !isSingleColor)
+    {
+        for (uint32_t iteration = 0; iteration < 2 && error > 0; ++iteration)
+        {
+            if (!computeLeastSquaresEndpoints(texels, indices, WEIGHTS_4, endpoints))
+                break;
+
+            bool improved = false;
+            for (uint8_t pBits = 0; pBits < 4; ++pBits)
+            {
+                const BC7Mode6Endpoints candidateEndpoints = quantizeBC7Endpoints(endpoints, pBits & 1, pBits >> 1);
+                uint8_t candidateIndices[16];
+                const uint32_t candidateError = computeBC7Indices(integerTexels, candidateEndpoints, candidateIndices);
+                if (candidateError < error)
+                {
+                    error = candidateError;
+                    quantizedEndpoints = candidateEndpoints;
+                    memcpy(indices, candidateIndices, sizeof(indices));
+                    improved = true;
+                }
+            }
+
+            if (!improved)
+                break;
+        }
+    }
+
+    // Index of texel 0 is stored without its high bit
+    uint32_t first = 0, second = 1;
+    if (indices[0] & 8)
+    {
+        std::swap(first, second);
+        for (uint8_t& index : indices)
+            index = 15 - index;
+    }
+
+    BitWriter writer;
+    writer.write(1 << 6, 7);
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        writer.write(quantizedEndpoints.values[first][c], 7);
+        writer.write(quantizedEndpoints.values[second][c], 7);
+    }
+    writer.write(quantizedEndpoints.pBits[first], 1);
+    writer.write(quantizedEndpoints.pBits[second], 1);
+    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        writer.write(indices[texelIdx], texelIdx == 0 ? 3 : 4);
+
+    writer.copyTo(outBlock.data);
+}
+
+void Wolf::decodeBC7Block(const ImageCompression::BC7& block, ImageCompression::RGBA8 outTexels[16])
+{
+    BitReader reader(block.data);
+
+    uint32_t mode = 0;
+    while (mode < 8 && reader.read(1) == 0)
+        mode++;
+
+    if (mode == 8)
+    {
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+            outTexels[texelIdx] = RGBA8(0, 0, 0, 0);
+        return;
+    }
+
+    const BC7ModeInfo& modeInfo = BC7_MODES[mode];
+    const uint32_t partition = reader.read(modeInfo.partitionBitCount);
+    const uint32_t rotation = reader.read(modeInfo.rotationBitCount);
+    const uint32_t indexSelection = reader.read(modeInfo.indexSelectionBitCount);
+
+    // Subset, endpoint, channel
+    uint32_t endpoints[3][2][4];
+    const uint32_t channelCount = modeInfo.alphaBitCount > 0 ? 4 : 3;
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+        for (uint32_t subsetIdx = 0; subsetIdx < modeInfo.subsetCount; ++subsetIdx)
+        {
+            for (uint32_t endpointIdx = 0; endpointIdx < 2; ++endpointIdx)
+                endpoints[subsetIdx][endpointIdx][c] = reader.read(c == 3 ? modeInfo.alphaBitCount : modeInfo.colorBitCount);
+        }
+    }
+
+    uint32_t colorBitCount = modeInfo.colorBitCount;
+    uint32_t alphaBitCount = modeInfo.alphaBitCount;
+    if (modeInfo.hasEndpointPBits || modeInfo.hasSharedPBits)
+    {
+        for (uint32_t subsetIdx = 0; subsetIdx < modeInfo.subsetCount; ++subsetIdx)
+        {
+            const uint32_t sharedPBit = modeInfo.hasSharedPBits ? reader.read(1) : 0;
+            for (uint32_t endpointIdx = 0; endpointIdx < 2; ++endpointIdx)
+            {
+                const uint32_t pBit = modeInfo.hasEndpointPBits ? reader.read(1) : sharedPBit;
+                for (uint32_t c = 0; c < channelCount; ++c)
+                    endpoints[subsetIdx][endpointIdx][c] = (endpoints[subsetIdx][endpointIdx][c] << 1) | pBit;
+            }
+        }
+        colorBitCount++;
+        if (alphaBitCount > 0)
+            alphaBitCount++;
+    }
+
+    for (uint32_t subsetIdx = 0; subsetIdx < modeInfo.subsetCount; ++subsetIdx)
+    {
+        for (uint32_t endpointIdx = 0; endpointIdx < 2; ++endpointIdx)
+        {
+            uint32_t (&endpoint)[4] = endpoints[subsetIdx][endpointIdx];
+            for (uint32_t c = 0; c < 3; ++c)
+                endpoint[c] = expandBits(endpoint[c], colorBitCount);
+            endpoint[3] = alphaBitCount > 0 ? expandBits(endpoint[3], alphaBitCount) : 255;
+        }
+    }
+
+    uint32_t indices[16];
+    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        indices[texelIdx] = reader.read(modeInfo.indexBitCount - (isBC7Anchor(modeInfo, partition, texelIdx) ? 1 : 0));
+
+    uint32_t secondaryIndices[16];
+    for (uint32_t texelIdx = 0; texelIdx < 16 && modeInfo.secondaryIndexBitCount > 0; ++texelIdx)
+        secondaryIndices[texelIdx] = reader.read(modeInfo.secondaryIndexBitCount - (texelIdx == 0 ? 1 : 0));
+
+    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+    {
+        const uint32_t (&endpoint0)[4] = endpoints[getBC7Subset(modeInfo, partition, texelIdx)][0];
+        const uint32_t (&endpoint1)[4] = endpoints[getBC7Subset(modeInfo, partition, texelIdx)][1];
+
+        // Modes 4 and 5 have separate color and alpha indices, mode 4 can swap them with the index selection bit
+        uint32_t colorWeight = getWeights(modeInfo.indexBitCount)[indices[texelIdx]];
+        uint32_t alphaWeight = colorWeight;
+        if (modeInfo.secondaryIndexBitCount > 0)
+        {
+            const uint32_t secondaryWeight = getWeights(modeInfo.secondaryIndexBitCount)[secondaryIndices[texelIdx]];
+            if (indexSelection)
+                colorWeight = secondaryWeight;
+            else
+                alphaWeight = secondaryWeight;
+        }
+
+        uint8_t channels[4];
+        for (uint32_t c = 0; c < 4; ++c)
+            channels[c] = static_cast<uint8_t>(interpolate(static_cast<int32_t>(endpoint0[c]), static_cast<int32_t>(endpoint1[c]), c == 3 ? alphaWeight : colorWeight));
+
+        if (rotation > 0)
+            std::swap(channels[3], channels[rotation - 1]);
+
+        outTexels[texelIdx] = RGBA8(channels[0], channels[1], channels[2], channels[3]);
+    }
+}
+
+void Wolf::encodeBC6HBlock(const ImageCompression::RGBA32F* firstTexel, uint32_t rowPitch, ImageCompression::Quality quality, ImageCompression::BC6H& outBlock)
+{
+    float texels[16][3];
+    int32_t halfTexels[16][3];
+    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+    {
+        const ImageCompression::RGBA32F& texel = firstTexel[texelIdx % 4 + (texelIdx / 4) * rowPitch];
+        const float values[3] = { texel.r, texel.g, texel.b };
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            // NaN is also replaced by 0
+            const float value = values[c] > 0.0f ? std::min(values[c], 65504.0f) : 0.0f;
+            halfTexels[texelIdx][c] = glm::packHalf1x16(value);
+            texels[texelIdx][c] = static_cast<float>(halfTexels[texelIdx][c]) * BC6H_HALF_TO_INTERPOLATION_SCALE;
+        }
+    }
+
+    float endpoints[2][3];
+    computeRangeFitEndpoints(texels, endpoints);
+
+    int32_t quantizedEndpoints[2][3];
+    quantizeBC6HEndpoints(endpoints, quantizedEndpoints);
+    uint8_t indices[16];
+    uint64_t error = computeBC6HIndices(halfTexels, quantizedEndpoints, indices);
+
+    if (quality == ImageCompression::Quality::HIGH)
+    {
+        for (uint32_t iteration = 0; iteration < 2 && error > 0; ++iteration)
+        {
+            if (!computeLeastSquaresEndpoints(texels, indices, WEIGHTS_4, endpoints))
+                break;
+
+            int32_t candidateEndpoints[2][3];
+            quantizeBC6HEndpoints(endpoints, candidateEndpoints);
+            uint8_t candidateIndices[16];
+            const uint64_t candidateError = computeBC6HIndices(halfTexels, candidateEndpoints, candidateIndices);
+            if (candidateError >= error)
+                break;
+
+            error = candidateError;
+            memcpy(quantizedEndpoints, candidateEndpoints, sizeof(quantizedEndpoints));
+            memcpy(indices, candidateIndices, sizeof(indices));
+        }
+    }
+
+    // Index of texel 0 is stored without its high bit
+    uint32_t first = 0, second = 1;
+    if (indices[0] & 8)
+    {
+        std::swap(first, second);
+        for (uint8_t& index : indices)
+            index = 15 - index;
+    }
+
+    BitWriter writer;
+    writer.write(0x03, 5); // mode 11
+    for (uint32_t c = 0; c < 3; ++c)
+        writer.write(quantizedEndpoints[first][c], 10);
+    for (uint32_t c = 0; c < 3; ++c)
+        writer.write(quantizedEndpoints[second][c], 10);
+    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        writer.write(indices[texelIdx], texelIdx == 0 ? 3 : 4);
+
+    writer.copyTo(outBlock.data);
+}
+
+void Wolf::decodeBC6HBlock(const ImageCompression::BC6H& block, ImageCompression::RGBA16F outTexels[16])
+{
+    static constexpr uint16_t HALF_ONE = 0x3c00;
+    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        outTexels[texelIdx] = ImageCompression::RGBA16F(0, 0, 0, HALF_ONE);
+
+    BitReader reader(block.data);
+    uint32_t mode = reader.read(2);
+    if (mode < 2)
+    {
+        // Modes 1 and 2 only have 2 mode bits
+        decodeBC6HTwoRegionsBlock(reader, BC6H_TWO_REGIONS_MODES[mode], outTexels);
+        return;
+    }
+    mode |= reader.read(3) << 2;
+
+    uint32_t endpointBitCount;
+    uint32_t deltaBitCount;
+    switch (mode)
+    {
+        case 0x03: endpointBitCount = 10; deltaBitCount = 0; break;
+        case 0x07: endpointBitCount = 11; deltaBitCount = 9; break;
+        case 0x0b: endpointBitCount = 12; deltaBitCount = 8; break;
+        case 0x0f: endpointBitCount = 16; deltaBitCount = 4; break;
+        case 0x13:
+        case 0x17:
+        case 0x1b:
+        case 0x1f:
+            return; // reserved modes are decoded as black
+        default:
+            // Modes 3 to 10 have two regions, mode bits always end with 10
+            decodeBC6HTwoRegionsBlock(reader, BC6H_TWO_REGIONS_MODES[2 + (mode >> 2)], outTexels);
+            return;
+    }
+
+    uint32_t endpoints[2][3];
+    for (uint32_t c = 0; c < 3; ++c)
+        endpoints[0][c] = reader.read(10);
+
+    // Modes 12 to 14 store the second endpoint as a delta followed by the high bits of the first endpoint, from the highest bit
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        if (deltaBitCount == 0)
+        {
+            endpoints[1][c] = reader.read(10);
+            continue;
+        }
+
+        endpoints[1][c] = reader.read(deltaBitCount);
+        for (uint32_t bitIdx = endpointBitCount - 1; bitIdx >= 10; --bitIdx)
+            endpoints[0][c] |= reader.read(1) << bitIdx;
+    }
+
+    int32_t values[2][3];
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        if (deltaBitCount > 0)
+            endpoints[1][c] = static_cast<uint32_t>(static_cast<int32_t>(endpoints[0][c]) + signExtend(endpoints[1][c], deltaBitCount)) & ((1u << endpointBitCount) - 1);
+
+        values[0][c] = unquantizeBC6HUnsigned(static_cast<int32_t>(endpoints[0][c]), endpointBitCount);
+        values[1][c] = unquantizeBC6HUnsigned(static_cast<int32_t>(endpoints[1][c]), endpointBitCount);
+    }
+
+    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+    {
+        const uint32_t weight = WEIGHTS_4[reader.read(texelIdx == 0 ? 3 : 4)];
+        outTexels[texelIdx] = ImageCompression::RGBA16F(finishBC6HUnsigned(interpolate(values[0][0], values[1][0], weight)),
+            finishBC6HUnsigned(interpolate(values[0][1], values[1][1], weight)), finishBC6HUnsigned(interpolate(values[0][2], values[1][2], weight)), HALF_ONE);
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "ImageCompression.h"
+
+namespace Wolf
+{
+    // BC6H and BC7 (BPTC) single block encoders and decoders used by ImageCompression.
+    // Texels are read row by row from firstTexel, rowPitch is the image width in texels
+
+    // Encodes with mode 6 (one subset, 7 bits RGBA endpoints with a p-bit each, 4 bits indices)
+    void encodeBC7Block(const ImageCompression::RGBA8* firstTexel, uint32_t rowPitch, ImageCompression::Quality quality, ImageCompression::BC7& outBlock);
+    // All 8 modes are decoded, reserved mode gives transparent black as hardware does
+    void decodeBC7Block(const ImageCompression::BC7& block, ImageCompression::RGBA8 outTexels[16]);
+
+    // Unsigned format (BC6H_UF16), encodes with mode 11 (one region, 10 bits endpoints, 4 bits indices). Negative values are clamped to 0
+    void encodeBC6HBlock(const ImageCompression::RGBA32F* firstTexel, uint32_t rowPitch, ImageCompression::Quality quality, ImageCompression::BC6H& outBlock);
+    // All 14 modes are decoded, reserved modes give black as hardware does. Output is half floats with alpha set to 1
+    void decodeBC6HBlock(const ImageCompression::BC6H& block, ImageCompression::RGBA16F outTexels[16]);
+}
@@ -0,0 +1,191 @@
+#include "ConfigurationDocument.h"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+
+#include "Debug.h"
+#include "MappedFile.h"
+
+namespace
+{
+	const std::string EMPTY_STRING;
+
+	std::string removeSpaces(std::string_view text)
+	{
+		std::string result;
+		result.reserve(text.size());
+		for (const char character : text)
+		{
+			if (character != ' ' && (character < '\t' || character > '\r'))
+				result += character;
+		}
+		return result;
+	}
+}
+
+Wolf::ConfigurationDocument::ConfigurationDocument(const std::string& filepath) : m_filepath(filepath)
+{
+	std::error_code errorCode;
+	if (!std::filesystem::exists(filepath, errorCode))
+		return;
+
+	const MappedFile file(filepath);
+	if (!file.isValid())
+	{
+		Debug::sendError("Can't read configuration file " + filepath);
+		return;
+	}
+
+	std::string_view text = file.getText();
+	while (!text.empty())
+	{
+		const size_t lineEnd = text.find('\n');
+		const std::string_view line = text.substr(0, lineEnd);
+		text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+
+		const uint32_t lineIdx = static_cast<uint32_t>(m_lines.size());
+		m_lines.emplace_back(line);
+
+		if (const size_t pos = line.find('='); pos != std::string_view::npos)
+			m_entries.try_emplace(removeSpaces(line.substr(0, pos)), Entry{ removeSpaces(line.substr(pos + 1)), lineIdx });
+	}
+}
+
+const std::string& Wolf::ConfigurationDocument::getString(std::string_view key) const
+{
+	const Entry* entry = findEntry(key);
+	return entry ? entry->value : EMPTY_STRING;
+}
+
+bool Wolf::ConfigurationDocument::getBool(std::string_view key, bool defaultValue) const
+{
+	const Entry* entry = findEntry(key);
+	if (!entry)
+		return defaultValue;
+
+	if (entry->value == "true")
+		return true;
+	if (entry->value == "false")
+		return false;
+
+	Debug::sendError("Configuration value " + std::string(key) + " in " + m_filepath + " is not a boolean");
+	return defaultValue;
+}
+
+uint32_t Wolf::ConfigurationDocument::getUInt32(std::string_view key, uint32_t defaultValue) const
+{
+	return getNumber(key, defaultValue);
+}
+
+uint64_t Wolf::ConfigurationDocument::getUInt64(std::string_view key, uint64_t defaultValue) const
+{
+	return getNumber(key, defaultValue);
+}
+
+float Wolf::ConfigurationDocument::getFloat(std::string_view key, float defaultValue) const
+{
+	return getNumber(key, defaultValue);
+}
+
+template <typename T>
+T Wolf::ConfigurationDocument::getNumber(std::string_view key, T defaultValue) const
+{
+	const Entry* entry = findEntry(key);
+	if (!entry)
+		return defaultValue;
+
+	T value;
+	const char* end = entry->value.data() + entry->value.size();
+	const std::from_chars_result result = std::from_chars(entry->value.data(), end, value);
+	if (result.ec != std::errc() || result.ptr != end)
+	{
+		Debug::sendError("Configuration value " + std::string(key) + " in " + m_filepath + " is not a valid number");
+		return defaultValue;
+	}
+	return value;
+}
+
+void Wolf::ConfigurationDocument::setValue(std::string_view key, const std::string& value)
+{
+	const std::string line = std::string(key) + " = " + value;
+
+	if (const auto it = m_entries.find(key); it != m_entries.end())
+	{
+		if (it->second.value == value)
+			return;
+
+		it->second.value = value;
+		m_lines[it->second.lineIdx] = line;
+	}
+	else
+	{
+		m_entries.try_emplace(std::string(key), Entry{ value, static_cast<uint32_t>(m_lines.size()) });
+		m_lines.push_back(line);
+	}
+
+	m_hasChanges = true;
+}
+
+void Wolf::ConfigurationDocument::setValue(std::string_view key, bool value)
+{
+	setValue(key, std::string(value ? "true" : "false"));
+}
+
+void Wolf::ConfigurationDocument::setValue(std::string_view key, uint32_t value)
+{
+	setValue(key, std::to_string(value));
+}
+
+void Wolf::ConfigurationDocument::setValue(std::string_view key, uint64_t value)
+{
+	setValue(key, std::to_string(value));
+}
+
+bool Wolf::ConfigurationDocument::flush()
+{
+	if (!m_hasChanges)
+		return true;
+
+	size_t fileSize = 0;
+	for (const std::string& line : m_lines)
+		fileSize += line.size() + 1;
+
+	std::string fileContent;
+	fileContent.reserve(fileSize);
+	for (const std::string& line : m_lines)
+	{
+		fileContent += line;
+		fileContent += '\n';
+	}
+
+	// Readers see either the previous or the new file, never a partially written one
+	const std::string temporaryFilepath = m_filepath + ".tmp";
+	{
+		std::ofstream outFile(temporaryFilepath, std::ios::out | std::ios::binary | std::ios::trunc);
+		outFile.write(fileContent.data(), static_cast<std::streamsize>(fileContent.size()));
+		if (!outFile)
+		{
+			Debug::sendError("Can't write configuration file " + temporaryFilepath);
+			return false;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryFilepath, m_filepath, errorCode);
+	if (errorCode)
+	{
+		Debug::sendError("Can't write configuration file " + m_filepath + ": " + errorCode.message());
+		std::filesystem::remove(temporaryFilepath, errorCode);
+		return false;
+	}
+
+	m_hasChanges = false;
+	return true;
+}
+
+const Wolf::ConfigurationDocument::Entry* Wolf::ConfigurationDocument::findEntry(std::string_view key) const
+{
+	const auto it = m_entries.find(key);
+	return it != m_entries.end() ? &it->second : nullptr;
+}
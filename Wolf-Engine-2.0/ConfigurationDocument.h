@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Wolf
+{
+	// "key = value" file parsed once, lookups are served from a hash index and changes are written by flush().
+	// Spaces are ignored in keys and values, lines without '=' are kept as they are
+	class ConfigurationDocument
+	{
+	public:
+		// A missing file gives an empty document, it is created by the first flush
+		explicit ConfigurationDocument(const std::string& filepath);
+
+		[[nodiscard]] bool hasKey(std::string_view key) const { return findEntry(key) != nullptr; }
+		// Missing keys give an empty string or the default value, unreadable values also send an error
+		[[nodiscard]] const std::string& getString(std::string_view key) const;
+		[[nodiscard]] bool getBool(std::string_view key, bool defaultValue = false) const;
+		[[nodiscard]] uint32_t getUInt32(std::string_view key, uint32_t defaultValue = 0) const;
+		[[nodiscard]] uint64_t getUInt64(std::string_view key, uint64_t defaultValue = 0) const;
+		[[nodiscard]] float getFloat(std::string_view key, float defaultValue = 0.0f) const;
+		[[nodiscard]] uint32_t getKeyCount() const { return static_cast<uint32_t>(m_entries.size()); }
+
+		void setValue(std::string_view key, const std::string& value);
+		void setValue(std::string_view key, const char* value) { setValue(key, std::string(value)); }
+		void setValue(std::string_view key, bool value);
+		void setValue(std::string_view key, uint32_t value);
+		void setValue(std::string_view key, uint64_t value);
+
+		// Writes all changes at once to a temporary file which then replaces the file, does nothing when unchanged
+		bool flush();
+		[[nodiscard]] bool hasChanges() const { return m_hasChanges; }
+		[[nodiscard]] const std::string& getFilepath() const { return m_filepath; }
+
+	private:
+		struct Entry
+		{
+			std::string value;
+			uint32_t lineIdx; // first line with this key, later duplicates are kept but ignored
+		};
+		[[nodiscard]] const Entry* findEntry(std::string_view key) const;
+		template <typename T> T getNumber(std::string_view key, T defaultValue) const;
+
+		// Allows lookups with a string_view without building a std::string
+		struct KeyHash
+		{
+			using is_transparent = void;
+			size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+		};
+
+		std::string m_filepath;
+		std::vector<std::string> m_lines;
+		std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>> m_entries;
+		bool m_hasChanges = false;
+	};
+}
@@ -1,84 +1,79 @@
 #include "ConfigurationHelper.h"
 
-#include <fstream>
+#include "ConfigurationDocument.h"
 
-void removeSpaces(std::string& line)
-{
-	std::erase_if(line, isspace);
-};
+std::unordered_map<std::string, Wolf::ConfigurationHelper::CachedDocument> Wolf::ConfigurationHelper::s_cache;
+std::mutex Wolf::ConfigurationHelper::s_cacheMutex;
 
 std::string Wolf::ConfigurationHelper::readInfoFromFile(const std::string& filepath, const std::string& token)
 {
-	std::ifstream inConfigFile(filepath);
-	std::string line;
-	while (std::getline(inConfigFile, line))
-	{
-		if (const size_t pos = line.find('='); pos != std::string::npos)
-		{
-			std::string lineToken = line.substr(0, pos);
-			line.erase(0, pos + 1);
-
-			removeSpaces(lineToken);
-			removeSpaces(line);
+	std::lock_guard lock(s_cacheMutex);
+	return getCachedDocument(filepath).getString(token);
+}
 
-			if (lineToken == token)
-				return line;
-		}
-	}
+void Wolf::ConfigurationHelper::writeInfoToFile(const std::string& filepath, const std::string& token, const std::string& value)
+{
+	writeInfoToFileImpl(filepath, token, value);
+}
 
-	return "";
+void Wolf::ConfigurationHelper::writeInfoToFile(const std::string& filepath, const std::string& token, bool value)
+{
+	writeInfoToFileImpl(filepath, token, value);
 }
 
-void Wolf::ConfigurationHelper::writeInfoToFile(const std::string& filepath, const std::string& token, const std::string& value)
+void Wolf::ConfigurationHelper::writeInfoToFile(const std::string& filepath, const std::string& token, uint32_t value)
 {
-	std::ifstream inConfigFile(filepath);
-	std::string line;
-	std::string fullFile;
-	bool tokenFound = false;
-	while (std::getline(inConfigFile, line))
-	{
-		if (const size_t pos = line.find('='); pos != std::string::npos)
-		{
-			std::string lineToken = line.substr(0, pos);
-			removeSpaces(lineToken);
+	writeInfoToFileImpl(filepath, token, value);
+}
 
-			if (lineToken == token)
-			{
-				line = token + " = " + value;
-				tokenFound = true;
-			}
-		}
+void Wolf::ConfigurationHelper::writeInfoToFile(const std::string& filepath, const std::string& token, uint64_t value)
+{
+	writeInfoToFileImpl(filepath, token, value);
+}
 
-		fullFile += line + '\n';
-	}
+void Wolf::ConfigurationHelper::clearCache()
+{
+	std::lock_guard lock(s_cacheMutex);
+	s_cache.clear();
+}
 
-	inConfigFile.close();
+template <typename T>
+void Wolf::ConfigurationHelper::writeInfoToFileImpl(const std::string& filepath, const std::string& token, const T& value)
+{
+	std::lock_guard lock(s_cacheMutex);
 
-	if (!tokenFound)
+	ConfigurationDocument& document = getCachedDocument(filepath);
+	document.setValue(token, value);
+	if (document.hasChanges())
 	{
-		if (!fullFile.empty() && fullFile.back() != '\n')
-		{
-			fullFile += '\n';
-		}
-		fullFile += token + " = " + value + '\n';
+		if (document.flush())
+			updateCachedFileInfo(filepath);
+		else
+			s_cache.erase(filepath);
 	}
-
-	std::ofstream outConfigFile(filepath);
-	outConfigFile << fullFile;
-	outConfigFile.close();
 }
 
-void Wolf::ConfigurationHelper::writeInfoToFile(const std::string& filepath, const std::string& token, bool value)
+Wolf::ConfigurationDocument& Wolf::ConfigurationHelper::getCachedDocument(const std::string& filepath)
 {
-	writeInfoToFile(filepath, token, static_cast<const std::string&>(value ? "true" : "false"));
-}
+	std::error_code errorCode;
+	const std::filesystem::file_time_type modificationTime = std::filesystem::last_write_time(filepath, errorCode);
+	const uintmax_t fileSize = errorCode ? 0 : std::filesystem::file_size(filepath, errorCode);
 
-void Wolf::ConfigurationHelper::writeInfoToFile(const std::string& filepath, const std::string& token, uint32_t value)
-{
-	writeInfoToFile(filepath, token, std::to_string(value));
+	CachedDocument& cachedDocument = s_cache[filepath];
+	if (!cachedDocument.document || cachedDocument.modificationTime != modificationTime || cachedDocument.fileSize != fileSize)
+	{
+		cachedDocument.document = std::make_unique<ConfigurationDocument>(filepath);
+		cachedDocument.modificationTime = modificationTime;
+		cachedDocument.fileSize = fileSize;
+	}
+
+	return *cachedDocument.document;
 }
 
-void Wolf::ConfigurationHelper::writeInfoToFile(const std::string& filepath, const std::string& token, uint64_t value)
+void Wolf::ConfigurationHelper::updateCachedFileInfo(const std::string& filepath)
 {
-	writeInfoToFile(filepath, token, std::to_string(value));
+	std::error_code errorCode;
+	CachedDocument& cachedDocument = s_cache[filepath];
+	cachedDocument.modificationTime = std::filesystem::last_write_time(filepath, errorCode);
+	cachedDocument.fileSize = errorCode ? 0 : std::filesystem::file_size(filepath, errorCode);
 }
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace Wolf
 {
+	class ConfigurationDocument;
+
+	// Files are parsed once and kept in a process-wide cache, a cached file is parsed again when its modification time or size changes
 	class ConfigurationHelper
 	{
 	public:
@@ -14,5 +21,22 @@ namespace Wolf
 		static void writeInfoToFile(const std::string& filepath, const std::string& token, bool value);
 		static void writeInfoToFile(const std::string& filepath, const std::string& token, uint32_t value);
 		static void writeInfoToFile(const std::string& filepath, const std::string& token, uint64_t value);
+
+		static void clearCache();
+
+	private:
+		template <typename T> static void writeInfoToFileImpl(const std::string& filepath, const std::string& token, const T& value);
+		// Cache mutex must be locked
+		static ConfigurationDocument& getCachedDocument(const std::string& filepath);
+		static void updateCachedFileInfo(const std::string& filepath);
+
+		struct CachedDocument
+		{
+			std::unique_ptr<ConfigurationDocument> document;
+			std::filesystem::file_time_type modificationTime;
+			uintmax_t fileSize = 0;
+		};
+		static std::unordered_map<std::string, CachedDocument> s_cache;
+		static std::mutex s_cacheMutex;
 	};
 }
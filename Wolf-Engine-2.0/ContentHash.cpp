@@ -0,0 +1,18 @@
+#include "ContentHash.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <xxh64.hpp>
+
+uint64_t Wolf::computeContentHash(std::string_view data)
+{
+	constexpr size_t CHUNK_SIZE = 16 * 1024;
+
+	std::vector<uint64_t> chunkHashes;
+	chunkHashes.reserve(data.size() / CHUNK_SIZE + 1);
+	for (size_t offset = 0; offset < data.size(); offset += CHUNK_SIZE)
+		chunkHashes.push_back(xxh64::hash(data.data() + offset, std::min(CHUNK_SIZE, data.size() - offset), 0));
+
+	return xxh64::hash(reinterpret_cast<const char*>(chunkHashes.data()), chunkHashes.size() * sizeof(uint64_t), 0);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Wolf
+{
+	// Hash of file contents used to validate binary caches. xxh64::hash recurses every 32 bytes, which overflows the stack on large
+	// inputs in unoptimized builds: 16 KiB chunks are hashed separately then their hashes are combined
+	uint64_t computeContentHash(std::string_view data);
+}
@@ -0,0 +1,189 @@
+#include "CubeLUTParser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <vector>
+
+#include <glm/gtc/packing.hpp>
+
+#include "ParallelFor.h"
+#include "ProfilerCommon.h"
+
+namespace
+{
+	bool isBlank(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	const char* skipBlanks(const char* cursor, const char* end)
+	{
+		while (cursor != end && isBlank(*cursor))
+			++cursor;
+		return cursor;
+	}
+
+	const char* findLineEnd(const char* cursor, const char* end)
+	{
+		return std::find(cursor, end, '\n');
+	}
+
+	// from_chars doesn't take the leading '+' accepted by std::stof
+	bool parseFloat(const char*& cursor, const char* end, float& outValue)
+	{
+		if (cursor != end && *cursor == '+')
+			++cursor;
+
+		const std::from_chars_result result = std::from_chars(cursor, end, outValue);
+		if (result.ec != std::errc())
+			return false;
+
+		cursor = result.ptr;
+		return true;
+	}
+
+	// Data lines start with a number, other lines before the data are keywords (TITLE, DOMAIN_MIN...)
+	bool isDataLine(std::string_view line)
+	{
+		const char* cursor = skipBlanks(line.data(), line.data() + line.size());
+		const char* tokenEnd = std::find_if(cursor, line.data() + line.size(), isBlank);
+		if (cursor == tokenEnd || tokenEnd == line.data() + line.size())
+			return false;
+		if (*cursor != '+' && *cursor != '-' && *cursor != '.' && (*cursor < '0' || *cursor > '9'))
+			return false;
+
+		float value;
+		return parseFloat(cursor, tokenEnd, value) && cursor == tokenEnd;
+	}
+
+	// Lines which aren't blank or comments
+	uint64_t countDataLines(const char* cursor, const char* end)
+	{
+		uint64_t lineCount = 0;
+		while (cursor != end)
+		{
+			cursor = skipBlanks(cursor, end);
+			if (cursor != end && *cursor != '\n' && *cursor != '#')
+				lineCount++;
+			cursor = findLineEnd(cursor, end);
+			if (cursor != end)
+				++cursor;
+		}
+		return lineCount;
+	}
+
+	bool parseDataLines(const char* cursor, const char* end, uint16_t* outRGBA16F, uint64_t maxTexelCount, uint64_t& outTexelCount)
+	{
+		uint64_t texelIdx = 0;
+		while (cursor != end)
+		{
+			cursor = skipBlanks(cursor, end);
+			if (cursor != end && *cursor != '\n' && *cursor != '#')
+			{
+				if (texelIdx == maxTexelCount)
+					return false;
+
+				uint16_t* texel = outRGBA16F + texelIdx * 4;
+				for (uint32_t channel = 0; channel < 3; ++channel)
+				{
+					float value;
+					if (!parseFloat(cursor, end, value) || (cursor != end && !isBlank(*cursor) && *cursor != '\n'))
+						return false;
+					texel[channel] = glm::packHalf1x16(value);
+					cursor = skipBlanks(cursor, end);
+				}
+				texel[3] = glm::packHalf1x16(0.0f);
+
+				texelIdx++;
+			}
+
+			cursor = findLineEnd(cursor, end);
+			if (cursor != end)
+				++cursor;
+		}
+
+		outTexelCount = texelIdx;
+		return true;
+	}
+}
+
+Wolf::CubeLUTParser::CubeLUTParser(std::string_view text)
+{
+	size_t lineBegin = 0;
+	while (lineBegin < text.size())
+	{
+		size_t lineEnd = text.find('\n', lineBegin);
+		if (lineEnd == std::string_view::npos)
+			lineEnd = text.size();
+		const std::string_view line = text.substr(lineBegin, lineEnd - lineBegin);
+
+		if (m_lutSize == 0)
+		{
+			if (const size_t pos = line.find("LUT_3D_SIZE"); pos != std::string_view::npos)
+			{
+				const char* cursor = skipBlanks(line.data() + pos + 11, line.data() + line.size());
+				uint32_t lutSize = 0;
+				std::from_chars(cursor, line.data() + line.size(), lutSize);
+				if (lutSize < 2 || lutSize > MAX_LUT_SIZE)
+					return;
+				m_lutSize = lutSize;
+			}
+		}
+		else if (isDataLine(line))
+		{
+			m_data = text.substr(lineBegin);
+			return;
+		}
+
+		lineBegin = lineEnd + 1;
+	}
+}
+
+bool Wolf::CubeLUTParser::parse(uint16_t* outRGBA16F) const
+{
+	PROFILE_FUNCTION
+
+	if (!isValid())
+		return false;
+
+	const uint64_t texelCount = getTexelCount();
+	const char* data = m_data.data();
+	const size_t dataSize = m_data.size();
+
+	// Ranges start on line beginnings
+	const uint32_t rangeCount = static_cast<uint32_t>(std::clamp<size_t>(dataSize / MIN_BYTE_COUNT_PER_RANGE, 1, 256));
+	std::vector<size_t> rangeBegins(rangeCount + 1, dataSize);
+	rangeBegins[0] = 0;
+	for (uint32_t rangeIdx = 1; rangeIdx < rangeCount; ++rangeIdx)
+	{
+		const size_t lineEnd = m_data.find('\n', std::max(rangeBegins[rangeIdx - 1], rangeIdx * (dataSize / rangeCount)));
+		rangeBegins[rangeIdx] = lineEnd == std::string_view::npos ? dataSize : lineEnd + 1;
+	}
+
+	// Texel index of each range is known once lines of the previous ones are counted, a single range is checked after parsing
+	std::vector<uint64_t> firstTexels(rangeCount + 1, texelCount);
+	firstTexels[0] = 0;
+	if (rangeCount > 1)
+	{
+		parallelForRanges(rangeCount, [&](uint32_t rangeIdx)
+		{
+			firstTexels[rangeIdx + 1] = countDataLines(data + rangeBegins[rangeIdx], data + rangeBegins[rangeIdx + 1]);
+		});
+
+		for (uint32_t rangeIdx = 0; rangeIdx < rangeCount; ++rangeIdx)
+			firstTexels[rangeIdx + 1] += firstTexels[rangeIdx];
+		if (firstTexels[rangeCount] != texelCount)
+			return false;
+	}
+
+	std::vector<uint8_t> rangeSucceeded(rangeCount, 0);
+	parallelForRanges(rangeCount, [&](uint32_t rangeIdx)
+	{
+		const uint64_t rangeTexelCount = firstTexels[rangeIdx + 1] - firstTexels[rangeIdx];
+		uint64_t parsedTexelCount = 0;
+		rangeSucceeded[rangeIdx] = parseDataLines(data + rangeBegins[rangeIdx], data + rangeBegins[rangeIdx + 1], outRGBA16F + firstTexels[rangeIdx] * 4, rangeTexelCount, parsedTexelCount)
+			&& parsedTexelCount == rangeTexelCount;
+	});
+
+	return std::all_of(rangeSucceeded.begin(), rangeSucceeded.end(), [](uint8_t succeeded) { return succeeded != 0; });
+}
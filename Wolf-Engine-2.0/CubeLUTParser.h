@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Wolf
+{
+	// Parses the 3D LUT of a .cube color grading file in place, without allocating per line.
+	// Texels are written as RGBA half floats with alpha set to 0, red varies fastest as in the file
+	class CubeLUTParser
+	{
+	public:
+		static constexpr uint32_t MAX_LUT_SIZE = 256;
+
+		// Text must outlive the parser
+		explicit CubeLUTParser(std::string_view text);
+
+		[[nodiscard]] bool isValid() const { return m_lutSize != 0; }
+		[[nodiscard]] uint32_t getLUTSize() const { return m_lutSize; }
+		[[nodiscard]] uint64_t getTexelCount() const { return static_cast<uint64_t>(m_lutSize) * m_lutSize * m_lutSize; }
+
+		// Ranges of lines are parsed by the engine workers. Returns false when a data line is invalid or the line count doesn't match the LUT size
+		bool parse(uint16_t* outRGBA16F) const;
+
+	private:
+		static constexpr size_t MIN_BYTE_COUNT_PER_RANGE = 256 * 1024;
+
+		std::string_view m_data; // from the first data line
+		uint32_t m_lutSize = 0;
+	};
+}
@@ -0,0 +1,432 @@
+#include "DDSFile.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <Debug.h>
+
+typedef unsigned int uint32;
+typedef uint32 DWORD;
+
+struct DDS_PIXELFORMAT
+{
+    DWORD dwSize;
+    DWORD dwFlags;
+    DWORD dwFourCC;
+    DWORD dwRGBBitCount;
+    DWORD dwRBitMask;
+    DWORD dwGBitMask;
+    DWORD dwBBitMask;
+    DWORD dwABitMask;
+};
+
+struct DDS_HEADER
+{
+    uint32          size;
+    uint32          flags;
+    uint32          height;
+    uint32          width;
+    uint32          pitchOrLinearSize;
+    uint32          depth; // only if DDS_HEADER_FLAGS_VOLUME is set in flags
+    uint32          mipMapCount;
+    uint32          reserved1[11];
+    DDS_PIXELFORMAT ddspf;
+    uint32          caps;
+    uint32          caps2;
+    uint32          caps3;
+    uint32          caps4;
+    uint32          reserved2;
+};
+
+enum DXGI_FORMAT {
+    DXGI_FORMAT_UNKNOWN = 0,
+    DXGI_FORMAT_R32G32B32A32_TYPELESS = 1,
+    DXGI_FORMAT_R32G32B32A32_FLOAT = 2,
+    DXGI_FORMAT_R32G32B32A32_UINT = 3,
+    DXGI_FORMAT_R32G32B32A32_SINT = 4,
+    DXGI_FORMAT_R32G32B32_TYPELESS = 5,
+    DXGI_FORMAT_R32G32B32_FLOAT = 6,
+    DXGI_FORMAT_R32G32B32_UINT = 7,
+    DXGI_FORMAT_R32G32B32_SINT = 8,
+    DXGI_FORMAT_R16G16B16A16_TYPELESS = 9,
+    DXGI_FORMAT_R16G16B16A16_FLOAT = 10,
+    DXGI_FORMAT_R16G16B16A16_UNORM = 11,
+    DXGI_FORMAT_R16G16B16A16_UINT = 12,
+    DXGI_FORMAT_R16G16B16A16_SNORM = 13,
+    DXGI_FORMAT_R16G16B16A16_SINT = 14,
+    DXGI_FORMAT_R32G32_TYPELESS = 15,
+    DXGI_FORMAT_R32G32_FLOAT = 16,
+    DXGI_FORMAT_R32G32_UINT = 17,
+    DXGI_FORMAT_R32G32_SINT = 18,
+    DXGI_FORMAT_R32G8X24_TYPELESS = 19,
+    DXGI_FORMAT_D32_FLOAT_S8X24_UINT = 20,
+    DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS = 21,
+    DXGI_FORMAT_X32_TYPELESS_G8X24_UINT = 22,
+    DXGI_FORMAT_R10G10B10A2_TYPELESS = 23,
+    DXGI_FORMAT_R10G10B10A2_UNORM = 24,
+    DXGI_FORMAT_R10G10B10A2_UINT = 25,
+    DXGI_FORMAT_R11G11B10_FLOAT = 26,
+    DXGI_FORMAT_R8G8B8A8_TYPELESS = 27,
+    DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+    DXGI_FORMAT_R8G8B8A8_UNORM_SRGB = 29,
+    DXGI_FORMAT_R8G8B8A8_UINT = 30,
+    DXGI_FORMAT_R8G8B8A8_SNORM = 31,
+    DXGI_FORMAT_R8G8B8A8_SINT = 32,
+    DXGI_FORMAT_R16G16_TYPELESS = 33,
+    DXGI_FORMAT_R16G16_FLOAT = 34,
+    DXGI_FORMAT_R16G16_UNORM = 35,
+    DXGI_FORMAT_R16G16_UINT = 36,
+    DXGI_FORMAT_R16G16_SNORM = 37,
+    DXGI_FORMAT_R16G16_SINT = 38,
+    DXGI_FORMAT_R32_TYPELESS = 39,
+    DXGI_FORMAT_D32_FLOAT = 40,
+    DXGI_FORMAT_R32_FLOAT = 41,
+    DXGI_FORMAT_R32_UINT = 42,
+    DXGI_FORMAT_R32_SINT = 43,
+    DXGI_FORMAT_R24G8_TYPELESS = 44,
+    DXGI_FORMAT_D24_UNORM_S8_UINT = 45,
+    DXGI_FORMAT_R24_UNORM_X8_TYPELESS = 46,
+    DXGI_FORMAT_X24_TYPELESS_G8_UINT = 47,
+    DXGI_FORMAT_R8G8_TYPELESS = 48,
+    DXGI_FORMAT_R8G8_UNORM = 49,
+    DXGI_FORMAT_R8G8_UINT = 50,
+    DXGI_FORMAT_R8G8_SNORM = 51,
+    DXGI_FORMAT_R8G8_SINT = 52,
+    DXGI_FORMAT_R16_TYPELESS = 53,
+    DXGI_FORMAT_R16_FLOAT = 54,
+    DXGI_FORMAT_D16_UNORM = 55,
+    DXGI_FORMAT_R16_UNORM = 56,
+    DXGI_FORMAT_R16_UINT = 57,
+    DXGI_FORMAT_R16_SNORM = 58,
+    DXGI_FORMAT_R16_SINT = 59,
+    DXGI_FORMAT_R8_TYPELESS = 60,
+    DXGI_FORMAT_R8_UNORM = 61,
+    DXGI_FORMAT_R8_UINT = 62,
+    DXGI_FORMAT_R8_SNORM = 63,
+    DXGI_FORMAT_R8_SINT = 64,
+    DXGI_FORMAT_A8_UNORM = 65,
+    DXGI_FORMAT_R1_UNORM = 66,
+    DXGI_FORMAT_R9G9B9E5_SHAREDEXP = 67,
+    DXGI_FORMAT_R8G8_B8G8_UNORM = 68,
+    DXGI_FORMAT_G8R8_G8B8_UNORM = 69,
+    DXGI_FORMAT_BC1_TYPELESS = 70,
+    DXGI_FORMAT_BC1_UNORM = 71,
+    DXGI_FORMAT_BC1_UNORM_SRGB = 72,
+    DXGI_FORMAT_BC2_TYPELESS = 73,
+    DXGI_FORMAT_BC2_UNORM = 74,
+    DXGI_FORMAT_BC2_UNORM_SRGB = 75,
+    DXGI_FORMAT_BC3_TYPELESS = 76,
+    DXGI_FORMAT_BC3_UNORM = 77,
+    DXGI_FORMAT_BC3_UNORM_SRGB = 78,
+    DXGI_FORMAT_BC4_TYPELESS = 79,
+    DXGI_FORMAT_BC4_UNORM = 80,
+    DXGI_FORMAT_BC4_SNORM = 81,
+    DXGI_FORMAT_BC5_TYPELESS = 82,
+    DXGI_FORMAT_BC5_UNORM = 83,
+    DXGI_FORMAT_BC5_SNORM = 84,
+    DXGI_FORMAT_B5G6R5_UNORM = 85,
+    DXGI_FORMAT_B5G5R5A1_UNORM = 86,
+    DXGI_FORMAT_B8G8R8A8_UNORM = 87,
+    DXGI_FORMAT_B8G8R8X8_UNORM = 88,
+    DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM = 89,
+    DXGI_FORMAT_B8G8R8A8_TYPELESS = 90,
+    DXGI_FORMAT_B8G8R8A8_UNORM_SRGB = 91,
+    DXGI_FORMAT_B8G8R8X8_TYPELESS = 92,
+    DXGI_FORMAT_B8G8R8X8_UNORM_SRGB = 93,
+    DXGI_FORMAT_BC6H_TYPELESS = 94,
+    DXGI_FORMAT_BC6H_UF16 = 95,
+    DXGI_FORMAT_BC6H_SF16 = 96,
+    DXGI_FORMAT_BC7_TYPELESS = 97,
+    DXGI_FORMAT_BC7_UNORM = 98,
+    DXGI_FORMAT_BC7_UNORM_SRGB = 99,
+    DXGI_FORMAT_AYUV = 100,
+    DXGI_FORMAT_Y410 = 101,
+    DXGI_FORMAT_Y416 = 102,
+    DXGI_FORMAT_NV12 = 103,
+    DXGI_FORMAT_P010 = 104,
+    DXGI_FORMAT_P016 = 105,
+    DXGI_FORMAT_420_OPAQUE = 106,
+    DXGI_FORMAT_YUY2 = 107,
+    DXGI_FORMAT_Y210 = 108,
+    DXGI_FORMAT_Y216 = 109,
+    DXGI_FORMAT_NV11 = 110,
+    DXGI_FORMAT_AI44 = 111,
+    DXGI_FORMAT_IA44 = 112,
+    DXGI_FORMAT_P8 = 113,
+    DXGI_FORMAT_A8P8 = 114,
+    DXGI_FORMAT_B4G4R4A4_UNORM = 115,
+    DXGI_FORMAT_P208 = 130,
+    DXGI_FORMAT_V208 = 131,
+    DXGI_FORMAT_V408 = 132,
+    DXGI_FORMAT_SAMPLER_FEEDBACK_MIN_MIP_OPAQUE,
+    DXGI_FORMAT_SAMPLER_FEEDBACK_MIP_REGION_USED_OPAQUE,
+    DXGI_FORMAT_FORCE_UINT = 0xffffffff
+};
+
+struct DDS_HEADER_DXT10
+{
+    DXGI_FORMAT     dxgiFormat;
+    uint32_t        resourceDimension;
+    uint32_t        miscFlag; // see D3D11_RESOURCE_MISC_FLAG
+    uint32_t        arraySize;
+    uint32_t        miscFlags2; // see DDS_MISC_FLAGS2
+};
+
+#define MAKEFOURCC(ch0, ch1, ch2, ch3) \
+	(static_cast<uint32_t>(static_cast<uint8_t>(ch0)) \
+    | (static_cast<uint32_t>(static_cast<uint8_t>(ch1)) << 8) \
+    | (static_cast<uint32_t>(static_cast<uint8_t>(ch2)) << 16) \
+	| (static_cast<uint32_t>(static_cast<uint8_t>(ch3)) << 24))
+
+const DWORD D3DFMT_DXT1 = MAKEFOURCC('D', 'X', 'T', '1');
+const DWORD D3DFMT_DXT2 = MAKEFOURCC('D', 'X', 'T', '2');
+const DWORD D3DFMT_DXT3 = MAKEFOURCC('D', 'X', 'T', '3');
+const DWORD D3DFMT_DXT4 = MAKEFOURCC('D', 'X', 'T', '4');
+const DWORD D3DFMT_DXT5 = MAKEFOURCC('D', 'X', 'T', '5');
+const DWORD BC4U = MAKEFOURCC('B', 'C', '4', 'U');
+const DWORD ATI1 = MAKEFOURCC('A', 'T', 'I', '1');
+const DWORD BC5U = MAKEFOURCC('B', 'C', '5', 'U');
+const DWORD BC5S = MAKEFOURCC('B', 'C', '5', 'S');
+const DWORD ATI2 = MAKEFOURCC('A', 'T', 'I', '2');
+const DWORD DX10 = MAKEFOURCC('D', 'X', '1', '0');
+
+const DWORD D3DFMT_R16F = 111;
+const DWORD D3DFMT_G16R16F = 112;
+const DWORD D3DFMT_A16B16G16R16F = 113;
+const DWORD D3DFMT_R32F = 114;
+const DWORD D3DFMT_G32R32F = 115;
+const DWORD D3DFMT_A32B32G32R32F = 116;
+
+namespace
+{
+	constexpr uint32_t DDS_MAGIC = MAKEFOURCC('D', 'D', 'S', ' ');
+
+	constexpr uint32_t DDPF_FOURCC = 0x4;
+	constexpr uint32_t DDPF_RGB = 0x40;
+	constexpr uint32_t DDSD_DEPTH = 0x800000;
+	constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+	constexpr uint32_t DDSCAPS2_CUBEMAP_ALL_FACES = 0xFC00;
+	constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+	constexpr uint32_t D3D11_RESOURCE_MISC_TEXTURECUBE = 0x4;
+	constexpr uint32_t D3D11_RESOURCE_DIMENSION_TEXTURE3D = 4;
+
+	// D3D11 limit is 16384, this also keeps size computations far from overflows
+	constexpr uint32_t MAX_SIZE = 65536;
+
+	using Compression = Wolf::ImageCompression::Compression;
+
+	struct DDSFormat
+	{
+		Wolf::Format format = Wolf::Format::UNDEFINED;
+		Compression compression = Compression::NO_COMPRESSION;
+		uint32_t texelSize = 0; // unused when compressed
+	};
+
+	DDSFormat findDX10Format(DXGI_FORMAT dxgiFormat)
+	{
+		using Wolf::Format;
+		switch (dxgiFormat)
+		{
+			case DXGI_FORMAT_R8_UNORM:              return { Format::R8_UNORM, Compression::NO_COMPRESSION, 1 };
+			case DXGI_FORMAT_R8G8_UNORM:            return { Format::R8G8_UNORM, Compression::NO_COMPRESSION, 2 };
+			case DXGI_FORMAT_R8G8B8A8_UNORM:        return { Format::R8G8B8A8_UNORM, Compression::NO_COMPRESSION, 4 };
+			case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:   return { Format::R8G8B8A8_SRGB, Compression::NO_COMPRESSION, 4 };
+			case DXGI_FORMAT_B8G8R8A8_UNORM:        return { Format::B8G8R8A8_UNORM, Compression::NO_COMPRESSION, 4 };
+			case DXGI_FORMAT_R16_FLOAT:             return { Format::R16_SFLOAT, Compression::NO_COMPRESSION, 2 };
+			case DXGI_FORMAT_R16G16_FLOAT:          return { Format::R16G16_SFLOAT, Compression::NO_COMPRESSION, 4 };
+			case DXGI_FORMAT_R16G16B16A16_FLOAT:    return { Format::R16G16B16A16_SFLOAT, Compression::NO_COMPRESSION, 8 };
+			case DXGI_FORMAT_R32_FLOAT:             return { Format::R32_SFLOAT, Compression::NO_COMPRESSION, 4 };
+			case DXGI_FORMAT_R32G32_FLOAT:          return { Format::R32G32_SFLOAT, Compression::NO_COMPRESSION, 8 };
+			case DXGI_FORMAT_R32G32B32A32_FLOAT:    return { Format::R32G32B32A32_SFLOAT, Compression::NO_COMPRESSION, 16 };
+			case DXGI_FORMAT_BC1_UNORM:             return { Format::BC1_RGBA_UNORM_BLOCK, Compression::BC1 };
+			case DXGI_FORMAT_BC1_UNORM_SRGB:        return { Format::BC1_RGB_SRGB_BLOCK, Compression::BC1 };
+			case DXGI_FORMAT_BC2_UNORM:             return { Format::BC2_UNORM_BLOCK, Compression::BC2 };
+			case DXGI_FORMAT_BC2_UNORM_SRGB:        return { Format::BC2_SRGB_BLOCK, Compression::BC2 };
+			case DXGI_FORMAT_BC3_UNORM:             return { Format::BC3_UNORM_BLOCK, Compression::BC3 };
+			case DXGI_FORMAT_BC3_UNORM_SRGB:        return { Format::BC3_SRGB_BLOCK, Compression::BC3 };
+			case DXGI_FORMAT_BC4_UNORM:             return { Format::BC4_UNORM_BLOCK, Compression::BC4 };
+			case DXGI_FORMAT_BC5_UNORM:             return { Format::BC5_UNORM_BLOCK, Compression::BC5 };
+			case DXGI_FORMAT_BC6H_UF16:             return { Format::BC6H_UFLOAT_BLOCK, Compression::BC6H };
+			case DXGI_FORMAT_BC7_UNORM:             return { Format::BC7_UNORM_BLOCK, Compression::BC7 };
+			case DXGI_FORMAT_BC7_UNORM_SRGB:        return { Format::BC7_SRGB_BLOCK, Compression::BC7 };
+			default:                                return {};
+		}
+	}
+
+	// Legacy headers don't tell the color space, color formats are sRGB as DXT1 always was in the engine
+	DDSFormat findLegacyFormat(const DDS_PIXELFORMAT& pixelFormat)
+	{
+		using Wolf::Format;
+		if (pixelFormat.dwFlags & DDPF_FOURCC)
+		{
+			switch (pixelFormat.dwFourCC)
+			{
+				case D3DFMT_DXT1:           return { Format::BC1_RGB_SRGB_BLOCK, Compression::BC1 };
+				case D3DFMT_DXT2:
+				case D3DFMT_DXT3:           return { Format::BC2_SRGB_BLOCK, Compression::BC2 };
+				case D3DFMT_DXT4:
+				case D3DFMT_DXT5:           return { Format::BC3_SRGB_BLOCK, Compression::BC3 };
+				case BC4U:
+				case ATI1:                  return { Format::BC4_UNORM_BLOCK, Compression::BC4 };
+				case BC5U:
+				case ATI2:                  return { Format::BC5_UNORM_BLOCK, Compression::BC5 };
+				case D3DFMT_R16F:           return { Format::R16_SFLOAT, Compression::NO_COMPRESSION, 2 };
+				case D3DFMT_G16R16F:        return { Format::R16G16_SFLOAT, Compression::NO_COMPRESSION, 4 };
+				case D3DFMT_A16B16G16R16F:  return { Format::R16G16B16A16_SFLOAT, Compression::NO_COMPRESSION, 8 };
+				case D3DFMT_R32F:           return { Format::R32_SFLOAT, Compression::NO_COMPRESSION, 4 };
+				case D3DFMT_G32R32F:        return { Format::R32G32_SFLOAT, Compression::NO_COMPRESSION, 8 };
+				case D3DFMT_A32B32G32R32F:  return { Format::R32G32B32A32_SFLOAT, Compression::NO_COMPRESSION, 16 };
+				default:                    return {};
+			}
+		}
+
+		if ((pixelFormat.dwFlags & DDPF_RGB) && pixelFormat.dwRGBBitCount == 32 && pixelFormat.dwGBitMask == 0x0000ff00)
+		{
+			if (pixelFormat.dwRBitMask == 0x000000ff && pixelFormat.dwBBitMask == 0x00ff0000)
+				return { Format::R8G8B8A8_UNORM, Compression::NO_COMPRESSION, 4 };
+			if (pixelFormat.dwRBitMask == 0x00ff0000 && pixelFormat.dwBBitMask == 0x000000ff)
+				return { Format::B8G8R8A8_UNORM, Compression::NO_COMPRESSION, 4 };
+		}
+
+		return {};
+	}
+}
+
+Wolf::DDSFile::DDSFile(const std::string& filename) : m_file(filename)
+{
+	m_isValid = readHeaders(filename);
+}
+
+Wolf::Extent3D Wolf::DDSFile::getMipExtent(uint32_t mipLevel) const
+{
+	return { std::max(m_extent.width >> mipLevel, 1u), std::max(m_extent.height >> mipLevel, 1u), std::max(m_extent.depth >> mipLevel, 1u) };
+}
+
+std::span<const uint8_t> Wolf::DDSFile::getSurface(uint32_t mipLevel, uint32_t arrayLayer, uint32_t face) const
+{
+	if (!m_isValid || mipLevel >= m_mipLevelCount || arrayLayer >= m_arrayLayerCount || face >= m_faceCount)
+	{
+		Debug::sendError("Requested DDS surface doesn't exist");
+		return {};
+	}
+
+	const size_t faceOffset = m_dataOffset + (static_cast<size_t>(arrayLayer) * m_faceCount + face) * m_faceSize;
+	return m_file.getData().subspan(faceOffset + m_mipOffsets[mipLevel], m_mipOffsets[mipLevel + 1] - m_mipOffsets[mipLevel]);
+}
+
+bool Wolf::DDSFile::readHeaders(const std::string& filename)
+{
+	if (!m_file.isValid())
+	{
+		Debug::sendError("Error : loading image " + filename);
+		return false;
+	}
+
+	const std::span<const uint8_t> data = m_file.getData();
+	uint32_t magic = 0;
+	if (data.size() >= sizeof(magic))
+		std::memcpy(&magic, data.data(), sizeof(magic));
+	if (magic != DDS_MAGIC || data.size() < sizeof(magic) + sizeof(DDS_HEADER))
+	{
+		Debug::sendError("Not a DDS file: " + filename);
+		return false;
+	}
+
+	DDS_HEADER header;
+	std::memcpy(&header, data.data() + sizeof(magic), sizeof(header));
+	if (header.size != sizeof(DDS_HEADER) || header.ddspf.dwSize != sizeof(DDS_PIXELFORMAT))
+	{
+		Debug::sendError("Invalid DDS header in " + filename);
+		return false;
+	}
+	m_dataOffset = sizeof(magic) + sizeof(DDS_HEADER);
+
+	m_extent = { header.width, header.height, 1 };
+	m_mipLevelCount = std::max(header.mipMapCount, 1u);
+	m_arrayLayerCount = 1;
+	m_faceCount = 1;
+
+	DDSFormat ddsFormat;
+	if ((header.ddspf.dwFlags & DDPF_FOURCC) && header.ddspf.dwFourCC == DX10)
+	{
+		DDS_HEADER_DXT10 dxt10Header;
+		if (data.size() < m_dataOffset + sizeof(dxt10Header))
+		{
+			Debug::sendError("Invalid DDS header in " + filename);
+			return false;
+		}
+		std::memcpy(&dxt10Header, data.data() + m_dataOffset, sizeof(dxt10Header));
+		m_dataOffset += sizeof(dxt10Header);
+
+		ddsFormat = findDX10Format(dxt10Header.dxgiFormat);
+		m_arrayLayerCount = dxt10Header.arraySize;
+		if (dxt10Header.miscFlag & D3D11_RESOURCE_MISC_TEXTURECUBE)
+			m_faceCount = 6;
+		if (dxt10Header.resourceDimension == D3D11_RESOURCE_DIMENSION_TEXTURE3D)
+			m_extent.depth = header.depth;
+	}
+	else
+	{
+		ddsFormat = findLegacyFormat(header.ddspf);
+		if (header.caps2 & DDSCAPS2_CUBEMAP)
+		{
+			if ((header.caps2 & DDSCAPS2_CUBEMAP_ALL_FACES) != DDSCAPS2_CUBEMAP_ALL_FACES)
+			{
+				Debug::sendError("Cubemaps without all faces are not supported: " + filename);
+				return false;
+			}
+			m_faceCount = 6;
+		}
+		if ((header.flags & DDSD_DEPTH) && (header.caps2 & DDSCAPS2_VOLUME))
+			m_extent.depth = header.depth;
+	}
+
+	if (ddsFormat.format == Format::UNDEFINED)
+	{
+		Debug::sendError("Unsupported format for DDS " + filename);
+		return false;
+	}
+	m_format = ddsFormat.format;
+	m_compression = ddsFormat.compression;
+	m_texelOrBlockSize = m_compression == Compression::NO_COMPRESSION ? ddsFormat.texelSize : ImageCompression::getBlockSize(m_compression);
+
+	if (m_extent.width == 0 || m_extent.height == 0 || m_extent.depth == 0 || m_extent.width > MAX_SIZE || m_extent.height > MAX_SIZE || m_extent.depth > MAX_SIZE)
+	{
+		Debug::sendError("Invalid size for DDS " + filename);
+		return false;
+	}
+	if (m_arrayLayerCount == 0 || m_arrayLayerCount > MAX_SIZE || (m_extent.depth > 1 && m_arrayLayerCount * m_faceCount > 1))
+	{
+		Debug::sendError("Invalid layer count for DDS " + filename);
+		return false;
+	}
+	if (m_mipLevelCount > static_cast<uint32_t>(std::bit_width(std::max({ m_extent.width, m_extent.height, m_extent.depth }))))
+	{
+		Debug::sendError("Too many mip levels for DDS " + filename);
+		return false;
+	}
+
+	m_mipOffsets.resize(m_mipLevelCount + 1);
+	m_faceSize = 0;
+	for (uint32_t mipLevel = 0; mipLevel < m_mipLevelCount; ++mipLevel)
+	{
+		m_mipOffsets[mipLevel] = m_faceSize;
+
+		const Extent3D mipExtent = getMipExtent(mipLevel);
+		if (m_compression == Compression::NO_COMPRESSION)
+			m_faceSize += static_cast<size_t>(mipExtent.width) * mipExtent.height * mipExtent.depth * m_texelOrBlockSize;
+		else
+			m_faceSize += static_cast<size_t>((mipExtent.width + 3) / 4) * ((mipExtent.height + 3) / 4) * mipExtent.depth * m_texelOrBlockSize;
+	}
+	m_mipOffsets[m_mipLevelCount] = m_faceSize;
+
+	const size_t faceCount = static_cast<size_t>(m_arrayLayerCount) * m_faceCount;
+	if (faceCount > (data.size() - m_dataOffset) / m_faceSize)
+	{
+		Debug::sendError("DDS file is truncated: " + filename);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Extents.h>
+#include <Formats.h>
+
+#include "ImageCompression.h"
+#include "MappedFile.h"
+
+namespace Wolf
+{
+	// DDS file mapped in memory. Headers and sizes are validated by the constructor, surfaces are views into the mapping
+	// and stay valid as long as this object
+	class DDSFile
+	{
+	public:
+		explicit DDSFile(const std::string& filename);
+		DDSFile(const DDSFile&) = delete;
+
+		[[nodiscard]] bool isValid() const { return m_isValid; }
+		[[nodiscard]] Format getFormat() const { return m_format; }
+		[[nodiscard]] ImageCompression::Compression getCompression() const { return m_compression; }
+		[[nodiscard]] Extent3D getExtent() const { return m_extent; }
+		[[nodiscard]] Extent3D getMipExtent(uint32_t mipLevel) const;
+		[[nodiscard]] uint32_t getMipLevelCount() const { return m_mipLevelCount; }
+		[[nodiscard]] uint32_t getArrayLayerCount() const { return m_arrayLayerCount; }
+		[[nodiscard]] uint32_t getFaceCount() const { return m_faceCount; }
+		[[nodiscard]] bool isCubemap() const { return m_faceCount == 6; }
+
+		// Face must be 0 when the file isn't a cubemap, layers of cubemap arrays are whole cubes. Volume textures give all slices of the mip level
+		[[nodiscard]] std::span<const uint8_t> getSurface(uint32_t mipLevel, uint32_t arrayLayer = 0, uint32_t face = 0) const;
+
+	private:
+		bool readHeaders(const std::string& filename);
+
+		MappedFile m_file;
+		bool m_isValid = false;
+
+		Format m_format = Format::UNDEFINED;
+		ImageCompression::Compression m_compression = ImageCompression::Compression::NO_COMPRESSION;
+		Extent3D m_extent = { 0, 0, 0 };
+		uint32_t m_mipLevelCount = 0;
+		uint32_t m_arrayLayerCount = 0;
+		uint32_t m_faceCount = 0;
+
+		// Surfaces are stored layer by layer, each face of a layer then has all its mip levels
+		uint32_t m_texelOrBlockSize = 0;
+		size_t m_dataOffset = 0;
+		size_t m_faceSize = 0;
+		std::vector<size_t> m_mipOffsets; // in a face, the extra last one is the face size
+	};
+}
@@ -0,0 +1,206 @@
+#include "ImageBatchDecoder.h"
+
+#include <Debug.h>
+
+#include "ProfilerCommon.h"
+
+namespace
+{
+	uint64_t computeLoadedByteCount(const Wolf::ImageFileLoader& loader, uint64_t estimatedByteCount)
+	{
+		if (!loader.getPixels())
+			return 0;
+
+		// Mapped files
+		if (loader.getDDSFile() || loader.getKTX2File())
+			return estimatedByteCount;
+
+		uint64_t bytesPerTexel;
+		switch (loader.getFormat())
+		{
+			case Wolf::Format::R16G16B16A16_SFLOAT:
+				bytesPerTexel = 4 * sizeof(uint16_t);
+				break;
+			case Wolf::Format::R32G32B32A32_SFLOAT:
+				bytesPerTexel = 4 * sizeof(float);
+				break;
+			default:
+				bytesPerTexel = 4;
+				break;
+		}
+		return static_cast<uint64_t>(loader.getWidth()) * loader.getHeight() * loader.getDepth() * bytesPerTexel;
+	}
+}
+
+Wolf::ImageBatchDecoder::ImageBatchDecoder(const ResourceNonOwner<JobsManager>& jobsManager, uint64_t maxInFlightByteCount)
+	: m_jobsManager(jobsManager), m_maxInFlightByteCount(maxInFlightByteCount)
+{
+}
+
+Wolf::ImageBatchDecoder::~ImageBatchDecoder()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_pendingRequests.clear();
+	m_idleCondition.wait(lock, [this]() { return m_runningRequestCount == 0; });
+
+	if (m_inFlightByteCount != 0)
+		Debug::sendCriticalError("Image batch decoder destroyed while decoded images are still alive");
+}
+
+Wolf::ImageBatchDecoder::DecodedImage::DecodedImage(DecodedImage&& other) noexcept
+	: m_decoder(other.m_decoder), m_loader(std::move(other.m_loader)), m_byteCount(other.m_byteCount)
+{
+	other.m_decoder = nullptr;
+	other.m_byteCount = 0;
+}
+
+Wolf::ImageBatchDecoder::DecodedImage& Wolf::ImageBatchDecoder::DecodedImage::operator=(DecodedImage&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		m_decoder = other.m_decoder;
+		m_loader = std::move(other.m_loader);
+		m_byteCount = other.m_byteCount;
+		other.m_decoder = nullptr;
+		other.m_byteCount = 0;
+	}
+	return *this;
+}
+
+void Wolf::ImageBatchDecoder::DecodedImage::release()
+{
+	m_loader.reset();
+	if (m_decoder)
+	{
+		m_decoder->releaseBytes(m_byteCount);
+		m_decoder = nullptr;
+	}
+	m_byteCount = 0;
+}
+
+void Wolf::ImageBatchDecoder::decode(std::span<const Request> requests, const Callback& callback)
+{
+	PROFILE_FUNCTION
+
+	for (uint32_t requestIdx = 0; requestIdx < requests.size(); ++requestIdx)
+	{
+		addRequest(requests[requestIdx], [callback, requestIdx](DecodedImage&& image) { callback(requestIdx, std::move(image)); });
+	}
+	startPendingRequests();
+}
+
+std::vector<std::future<Wolf::ImageBatchDecoder::DecodedImage>> Wolf::ImageBatchDecoder::decode(std::span<const Request> requests)
+{
+	PROFILE_FUNCTION
+
+	std::vector<std::future<DecodedImage>> futures;
+	futures.reserve(requests.size());
+	for (const Request& request : requests)
+	{
+		// std::function must be copyable
+		std::shared_ptr<std::promise<DecodedImage>> promise = std::make_shared<std::promise<DecodedImage>>();
+		futures.push_back(promise->get_future());
+		addRequest(request, [promise](DecodedImage&& image) { promise->set_value(std::move(image)); });
+	}
+	startPendingRequests();
+
+	return futures;
+}
+
+void Wolf::ImageBatchDecoder::waitIdle()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idleCondition.wait(lock, [this]() { return m_pendingRequests.empty() && m_runningRequestCount == 0; });
+}
+
+void Wolf::ImageBatchDecoder::setMaxInFlightByteCount(uint64_t maxInFlightByteCount)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_maxInFlightByteCount = maxInFlightByteCount;
+	}
+	startPendingRequests();
+}
+
+uint64_t Wolf::ImageBatchDecoder::getInFlightByteCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_inFlightByteCount;
+}
+
+uint32_t Wolf::ImageBatchDecoder::getPendingRequestCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return static_cast<uint32_t>(m_pendingRequests.size());
+}
+
+void Wolf::ImageBatchDecoder::addRequest(const Request& request, std::function<void(DecodedImage&&)>&& deliver)
+{
+	// Header is read outside of the lock
+	const uint64_t estimatedByteCount = ImageFileLoader::estimateByteCount(request.m_path, request.m_loadFloat);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pendingRequests.push_back({ request, estimatedByteCount, std::move(deliver) });
+}
+
+void Wolf::ImageBatchDecoder::startPendingRequests()
+{
+	std::vector<MultiThreadTaskManager::Job> jobs;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		while (!m_pendingRequests.empty())
+		{
+			// Requests start in order so large images aren't delayed forever by smaller ones
+			const uint64_t estimatedByteCount = m_pendingRequests.front().m_estimatedByteCount;
+			if (m_inFlightByteCount != 0 && m_inFlightByteCount + estimatedByteCount > m_maxInFlightByteCount)
+				break;
+
+			m_inFlightByteCount += estimatedByteCount;
+			m_runningRequestCount++;
+			jobs.emplace_back([this, request = std::move(m_pendingRequests.front())]() mutable { decodeRequest(request); });
+			m_pendingRequests.pop_front();
+		}
+	}
+
+	for (MultiThreadTaskManager::Job& job : jobs)
+	{
+		// Job is left untouched when rejected, the calling thread decodes it instead
+		if (m_jobsManager->addStreamingJob(std::move(job), 0, nullptr, "Image batch decode") == JobsManager::AddedJobStatus::REJECTED)
+		{
+			job();
+		}
+	}
+}
+
+void Wolf::ImageBatchDecoder::decodeRequest(PendingRequest& request)
+{
+	PROFILE_FUNCTION
+
+	std::unique_ptr<ImageFileLoader> loader = std::make_unique<ImageFileLoader>(request.m_request.m_path, request.m_request.m_loadFloat, request.m_request.m_useBinaryCache);
+
+	// Estimate is replaced by the real size
+	const uint64_t byteCount = computeLoadedByteCount(*loader, request.m_estimatedByteCount);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_inFlightByteCount = m_inFlightByteCount - request.m_estimatedByteCount + byteCount;
+	}
+	if (byteCount < request.m_estimatedByteCount)
+		startPendingRequests();
+
+	request.m_deliver(DecodedImage(this, std::move(loader), byteCount));
+
+	// Notified under the lock, the decoder can be destroyed as soon as the count reaches 0
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_runningRequestCount--;
+	m_idleCondition.notify_all();
+}
+
+void Wolf::ImageBatchDecoder::releaseBytes(uint64_t byteCount)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_inFlightByteCount -= byteCount;
+	}
+	startPendingRequests();
+}
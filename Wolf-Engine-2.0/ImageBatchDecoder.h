@@ -0,0 +1,100 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <ResourceNonOwner.h>
+
+#include "ImageFileLoader.h"
+#include "JobsManager.h"
+
+namespace Wolf
+{
+	// Decodes batches of image files on the streaming threads, as many at once as there are streaming threads.
+	// Decoded bytes stay in flight until the decoded image is released, requests wait in add order while the cap is reached.
+	// A request larger than the cap is decoded alone. DDS and KTX2 files are mapped, they count for their file size
+	class ImageBatchDecoder
+	{
+	public:
+		static constexpr uint64_t DEFAULT_MAX_IN_FLIGHT_BYTE_COUNT = 256 * 1024 * 1024;
+
+		explicit ImageBatchDecoder(const ResourceNonOwner<JobsManager>& jobsManager, uint64_t maxInFlightByteCount = DEFAULT_MAX_IN_FLIGHT_BYTE_COUNT);
+		ImageBatchDecoder(const ImageBatchDecoder&) = delete;
+		// Requests not started are dropped, decoded images must be released before
+		~ImageBatchDecoder();
+
+		struct Request
+		{
+			std::string m_path;
+			bool m_loadFloat = false;
+			bool m_useBinaryCache = false; // .cube only
+		};
+
+		// Counts in the in flight bytes until destroyed or released
+		class DecodedImage
+		{
+		public:
+			DecodedImage() = default;
+			DecodedImage(DecodedImage&& other) noexcept;
+			DecodedImage& operator=(DecodedImage&& other) noexcept;
+			DecodedImage(const DecodedImage&) = delete;
+			~DecodedImage() { release(); }
+
+			// False when the file couldn't be loaded, the error has been sent by ImageFileLoader
+			[[nodiscard]] bool isValid() const { return m_loader && m_loader->getPixels(); }
+			[[nodiscard]] const ImageFileLoader& getLoader() const { return *m_loader; }
+			[[nodiscard]] uint64_t getByteCount() const { return m_byteCount; }
+
+			void release();
+
+		private:
+			friend ImageBatchDecoder;
+			DecodedImage(ImageBatchDecoder* decoder, std::unique_ptr<ImageFileLoader>&& loader, uint64_t byteCount) : m_decoder(decoder), m_loader(std::move(loader)), m_byteCount(byteCount) {}
+
+			ImageBatchDecoder* m_decoder = nullptr;
+			std::unique_ptr<ImageFileLoader> m_loader;
+			uint64_t m_byteCount = 0;
+		};
+
+		// Called from a streaming thread with the index of the request in the batch. The image is released when the callback returns unless it's moved
+		using Callback = std::function<void(uint32_t requestIdx, DecodedImage&& image)>;
+		void decode(std::span<const Request> requests, const Callback& callback);
+		// One future per request, an image counts in the in flight bytes until the future and the image got from it are destroyed
+		[[nodiscard]] std::vector<std::future<DecodedImage>> decode(std::span<const Request> requests);
+
+		// Returns once all requests are delivered. Delivered images must be released meanwhile for requests waiting for the cap
+		void waitIdle();
+
+		void setMaxInFlightByteCount(uint64_t maxInFlightByteCount);
+		[[nodiscard]] uint64_t getInFlightByteCount() const;
+		[[nodiscard]] uint32_t getPendingRequestCount() const;
+
+	private:
+		struct PendingRequest
+		{
+			Request m_request;
+			uint64_t m_estimatedByteCount;
+			std::function<void(DecodedImage&&)> m_deliver;
+		};
+		void addRequest(const Request& request, std::function<void(DecodedImage&&)>&& deliver);
+		void startPendingRequests();
+		void decodeRequest(PendingRequest& request);
+		void releaseBytes(uint64_t byteCount);
+
+		ResourceNonOwner<JobsManager> m_jobsManager;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_idleCondition;
+		std::deque<PendingRequest> m_pendingRequests;
+		uint64_t m_maxInFlightByteCount;
+		uint64_t m_inFlightByteCount = 0; // being decoded (estimated) and decoded but not released
+		uint32_t m_runningRequestCount = 0;
+	};
+}
@@ -1,78 +1,1158 @@
 #include "ImageCompression.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cstring>
 #include <glm/glm.hpp>
+#include <limits>
+#include <mutex>
+
+// SSE2 is always available on x64, NEON on ARM64. Other targets use the scalar path.
+// AVX2 is only used by the functions built for it, after checking the CPU at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#include <immintrin.h>
+#define IMAGE_COMPRESSION_SSE2
+#define IMAGE_COMPRESSION_AVX2
+// Functions giving 256 bits values are inlined, GCC can clear the upper half of a returned value with vzeroupper
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define AVX2_FUNCTION
+#define AVX2_INLINE_FUNCTION __forceinline
+#else
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#define AVX2_INLINE_FUNCTION __attribute__((target("avx2"), always_inline)) inline
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define IMAGE_COMPRESSION_NEON
+#endif
 
 #include <Debug.h>
 
-uint64_t Wolf::ImageCompression::BC5::BC5Channel::toUInt64() const
-{
-    return bitmap;
-}
+#include "BPTCCodec.h"
+#include "ParallelFor.h"
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::RGBA8>(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<Wolf::ImageCompression::RGBA8>& outBlocks)
+namespace
 {
-    // Nothing to do
-}
+    using RGBA8 = Wolf::ImageCompression::RGBA8;
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC1>(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<Wolf::ImageCompression::BC1>& outBlocks)
-{
-    compressBC1(extent, pixels, outBlocks);
-}
+    // 4 floats processed together. Colors use xyz, w holds a weight or is kept at 0
+    class Vec4
+    {
+    public:
+#if defined(IMAGE_COMPRESSION_SSE2)
+        Vec4() : m_value(_mm_setzero_ps()) {}
+        explicit Vec4(float value) : m_value(_mm_set1_ps(value)) {}
+        Vec4(float x, float y, float z, float w) : m_value(_mm_setr_ps(x, y, z, w)) {}
+        static Vec4 load(const float* values) { return Vec4(_mm_loadu_ps(values)); }
+        // Channels of 4 consecutive RGBA8 texels, scaled to [0, 1]
+        static void loadRGB(const RGBA8* texels, Vec4& outR, Vec4& outG, Vec4& outB)
+        {
+            const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels));
+            const __m128i mask = _mm_set1_epi32(0xff);
+            const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+            outR = Vec4(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(values, mask)), scale));
+            outG = Vec4(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(values, 8), mask)), scale));
+            outB = Vec4(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(values, 16), mask)), scale));
+        }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC1>(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<Wolf::ImageCompression::BC1>& outBlocks)
-{
-    Debug::sendCriticalError("Can't compress to BC1 with RG32F pixels");
+        Vec4 operator+(const Vec4& other) const { return Vec4(_mm_add_ps(m_value, other.m_value)); }
+        Vec4 operator-(const Vec4& other) const { return Vec4(_mm_sub_ps(m_value, other.m_value)); }
+        Vec4 operator*(const Vec4& other) const { return Vec4(_mm_mul_ps(m_value, other.m_value)); }
+        Vec4& operator+=(const Vec4& other) { m_value = _mm_add_ps(m_value, other.m_value); return *this; }
+
+        template <int Lane> [[nodiscard]] Vec4 splat() const { return Vec4(_mm_shuffle_ps(m_value, m_value, _MM_SHUFFLE(Lane, Lane, Lane, Lane))); }
+        [[nodiscard]] float getX() const { return _mm_cvtss_f32(m_value); }
+        void store(float* out) const { _mm_storeu_ps(out, m_value); }
+
+        // a * b + c
+        static Vec4 multiplyAdd(const Vec4& a, const Vec4& b, const Vec4& c) { return Vec4(_mm_add_ps(_mm_mul_ps(a.m_value, b.m_value), c.m_value)); }
+        // c - a * b
+        static Vec4 negativeMultiplySubtract(const Vec4& a, const Vec4& b, const Vec4& c) { return Vec4(_mm_sub_ps(c.m_value, _mm_mul_ps(a.m_value, b.m_value))); }
+        // Estimate refined by one Newton-Raphson step
+        static Vec4 reciprocal(const Vec4& a)
+        {
+            const __m128 estimate = _mm_rcp_ps(a.m_value);
+            return Vec4(_mm_add_ps(estimate, _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(a.m_value, estimate)))));
+        }
+        static Vec4 min(const Vec4& a, const Vec4& b) { return Vec4(_mm_min_ps(a.m_value, b.m_value)); }
+        static Vec4 max(const Vec4& a, const Vec4& b) { return Vec4(_mm_max_ps(a.m_value, b.m_value)); }
+        static Vec4 truncate(const Vec4& a) { return Vec4(_mm_cvtepi32_ps(_mm_cvttps_epi32(a.m_value))); }
+        static bool compareAnyLessThan(const Vec4& a, const Vec4& b) { return _mm_movemask_ps(_mm_cmplt_ps(a.m_value, b.m_value)) != 0; }
+        // Lanes of ifTrue where a < b, lanes of ifFalse elsewhere
+        static Vec4 selectLessThan(const Vec4& a, const Vec4& b, const Vec4& ifTrue, const Vec4& ifFalse)
+        {
+            const __m128 mask = _mm_cmplt_ps(a.m_value, b.m_value);
+            return Vec4(_mm_or_ps(_mm_and_ps(mask, ifTrue.m_value), _mm_andnot_ps(mask, ifFalse.m_value)));
+        }
+
+    private:
+        explicit Vec4(__m128 value) : m_value(value) {}
+        __m128 m_value;
+#elif defined(IMAGE_COMPRESSION_NEON)
+        Vec4() : m_value(vdupq_n_f32(0.0f)) {}
+        explicit Vec4(float value) : m_value(vdupq_n_f32(value)) {}
+        Vec4(float x, float y, float z, float w) { const float values[4] = { x, y, z, w }; m_value = vld1q_f32(values); }
+        static Vec4 load(const float* values) { return Vec4(vld1q_f32(values)); }
+        static void loadRGB(const RGBA8* texels, Vec4& outR, Vec4& outG, Vec4& outB)
+        {
+            const uint32x4_t values = vld1q_u32(reinterpret_cast<const uint32_t*>(texels));
+            const uint32x4_t mask = vdupq_n_u32(0xff);
+            const float32x4_t scale = vdupq_n_f32(1.0f / 255.0f);
+            outR = Vec4(vmulq_f32(vcvtq_f32_u32(vandq_u32(values, mask)), scale));
+            outG = Vec4(vmulq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(values, 8), mask)), scale));
+            outB = Vec4(vmulq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(values, 16), mask)), scale));
+        }
+
+        Vec4 operator+(const Vec4& other) const { return Vec4(vaddq_f32(m_value, other.m_value)); }
+        Vec4 operator-(const Vec4& other) const { return Vec4(vsubq_f32(m_value, other.m_value)); }
+        Vec4 operator*(const Vec4& other) const { return Vec4(vmulq_f32(m_value, other.m_value)); }
+        Vec4& operator+=(const Vec4& other) { m_value = vaddq_f32(m_value, other.m_value); return *this; }
+
+        template <int Lane> [[nodiscard]] Vec4 splat() const { return Vec4(vdupq_laneq_f32(m_value, Lane)); }
+        [[nodiscard]] float getX() const { return vgetq_lane_f32(m_value, 0); }
+        void store(float* out) const { vst1q_f32(out, m_value); }
+
+        static Vec4 multiplyAdd(const Vec4& a, const Vec4& b, const Vec4& c) { return Vec4(vmlaq_f32(c.m_value, a.m_value, b.m_value)); }
+        static Vec4 negativeMultiplySubtract(const Vec4& a, const Vec4& b, const Vec4& c) { return Vec4(vmlsq_f32(c.m_value, a.m_value, b.m_value)); }
+        static Vec4 reciprocal(const Vec4& a)
+        {
+            const float32x4_t estimate = vrecpeq_f32(a.m_value);
+            return Vec4(vmulq_f32(vrecpsq_f32(a.m_value, estimate), estimate));
+        }
+        static Vec4 min(const Vec4& a, const Vec4& b) { return Vec4(vminq_f32(a.m_value, b.m_value)); }
+        static Vec4 max(const Vec4& a, const Vec4& b) { return Vec4(vmaxq_f32(a.m_value, b.m_value)); }
+        static Vec4 truncate(const Vec4& a) { return Vec4(vcvtq_f32_s32(vcvtq_s32_f32(a.m_value))); }
+        static bool compareAnyLessThan(const Vec4& a, const Vec4& b) { return vmaxvq_u32(vcltq_f32(a.m_value, b.m_value)) != 0; }
+        static Vec4 selectLessThan(const Vec4& a, const Vec4& b, const Vec4& ifTrue, const Vec4& ifFalse) { return Vec4(vbslq_f32(vcltq_f32(a.m_value, b.m_value), ifTrue.m_value, ifFalse.m_value)); }
+
+    private:
+        explicit Vec4(float32x4_t value) : m_value(value) {}
+        float32x4_t m_value;
+#else
+        Vec4() : Vec4(0.0f) {}
+        explicit Vec4(float value) : m_value{ value, value, value, value } {}
+        Vec4(float x, float y, float z, float w) : m_value{ x, y, z, w } {}
+        static Vec4 load(const float* values) { return { values[0], values[1], values[2], values[3] }; }
+        static void loadRGB(const RGBA8* texels, Vec4& outR, Vec4& outG, Vec4& outB)
+        {
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                outR.m_value[i] = texels[i].r * (1.0f / 255.0f);
+                outG.m_value[i] = texels[i].g * (1.0f / 255.0f);
+                outB.m_value[i] = texels[i].b * (1.0f / 255.0f);
+            }
+        }
+
+        Vec4 operator+(const Vec4& other) const { return apply(other, [](float a, float b) { return a + b; }); }
+        Vec4 operator-(const Vec4& other) const { return apply(other, [](float a, float b) { return a - b; }); }
+        Vec4 operator*(const Vec4& other) const { return apply(other, [](float a, float b) { return a * b; }); }
+        Vec4& operator+=(const Vec4& other) { *this = *this + other; return *this; }
+
+        template <int Lane> [[nodiscard]] Vec4 splat() const { return Vec4(m_value[Lane]); }
+        [[nodiscard]] float getX() const { return m_value[0]; }
+        void store(float* out) const { std::memcpy(out, m_value, sizeof(m_value)); }
+
+        static Vec4 multiplyAdd(const Vec4& a, const Vec4& b, const Vec4& c) { return a * b + c; }
+        static Vec4 negativeMultiplySubtract(const Vec4& a, const Vec4& b, const Vec4& c) { return c - a * b; }
+        static Vec4 reciprocal(const Vec4& a) { return Vec4(1.0f).apply(a, [](float a, float b) { return a / b; }); }
+        static Vec4 min(const Vec4& a, const Vec4& b) { return a.apply(b, [](float a, float b) { return std::min(a, b); }); }
+        static Vec4 max(const Vec4& a, const Vec4& b) { return a.apply(b, [](float a, float b) { return std::max(a, b); }); }
+        static Vec4 truncate(const Vec4& a) { return a.apply(a, [](float a, float) { return static_cast<float>(static_cast<int32_t>(a)); }); }
+        static bool compareAnyLessThan(const Vec4& a, const Vec4& b)
+        {
+            return a.m_value[0] < b.m_value[0] || a.m_value[1] < b.m_value[1] || a.m_value[2] < b.m_value[2] || a.m_value[3] < b.m_value[3];
+        }
+        static Vec4 selectLessThan(const Vec4& a, const Vec4& b, const Vec4& ifTrue, const Vec4& ifFalse)
+        {
+            Vec4 result;
+            for (uint32_t i = 0; i < 4; ++i)
+                result.m_value[i] = a.m_value[i] < b.m_value[i] ? ifTrue.m_value[i] : ifFalse.m_value[i];
+            return result;
+        }
+
+    private:
+        template <typename F> Vec4 apply(const Vec4& other, F function) const
+        {
+            return { function(m_value[0], other.m_value[0]), function(m_value[1], other.m_value[1]), function(m_value[2], other.m_value[2]), function(m_value[3], other.m_value[3]) };
+        }
+        float m_value[4];
+#endif
+    };
+
+    float dot3(const Vec4& a, const Vec4& b)
+    {
+        const Vec4 product = a * b;
+        return (product.splat<0>() + product.splat<1>() + product.splat<2>()).getX();
+    }
+
+    float horizontalSum4(const Vec4& value)
+    {
+        return (value.splat<0>() + value.splat<1>() + value.splat<2>() + value.splat<3>()).getX();
+    }
+
+    // 565 endpoints are chosen on this grid, colors are in [0, 1]
+    const Vec4 GRID(31.0f, 63.0f, 31.0f, 0.0f);
+    const Vec4 GRID_RECIPROCAL(1.0f / 31.0f, 1.0f / 63.0f, 1.0f / 31.0f, 0.0f);
+
+    Vec4 snapToGrid(const Vec4& color)
+    {
+        const Vec4 clamped = Vec4::min(Vec4(1.0f), Vec4::max(Vec4(0.0f), color));
+        return Vec4::truncate(Vec4::multiplyAdd(GRID, clamped, Vec4(0.5f))) * GRID_RECIPROCAL;
+    }
+
+    uint16_t packTo565(const Vec4& colorOnGrid)
+    {
+        float values[4];
+        Vec4::multiplyAdd(GRID, colorOnGrid, Vec4(0.5f)).store(values);
+        return static_cast<uint16_t>((static_cast<uint32_t>(values[0]) << 11) | (static_cast<uint32_t>(values[1]) << 5) | static_cast<uint32_t>(values[2]));
+    }
+
+    // Texels of a 4x4 block in [0, 1], one array per channel so 4 texels are processed at once
+    struct BlockTexels
+    {
+        float r[16];
+        float g[16];
+        float b[16];
+    };
+
+    // Returns false when all texels have the same color
+    bool loadBlockTexels(const RGBA8* firstTexel, uint32_t rowPitch, BlockTexels& outTexels)
+    {
+        uint32_t differentBits = 0;
+        for (uint32_t rowIdx = 0; rowIdx < 4; ++rowIdx)
+        {
+            const RGBA8* row = firstTexel + rowIdx * rowPitch;
+
+            Vec4 r, g, b;
+            Vec4::loadRGB(row, r, g, b);
+            r.store(&outTexels.r[rowIdx * 4]);
+            g.store(&outTexels.g[rowIdx * 4]);
+            b.store(&outTexels.b[rowIdx * 4]);
+
+            for (uint32_t x = 0; x < 4; ++x)
+                differentBits |= (row[x].r ^ firstTexel->r) | (row[x].g ^ firstTexel->g) | (row[x].b ^ firstTexel->b);
+        }
+        return differentBits != 0;
+    }
+
+    // Main direction of the colors, from a few power iterations on their covariance
+    Vec4 computePrincipalAxis(const BlockTexels& texels)
+    {
+        Vec4 sumR, sumG, sumB;
+        for (uint32_t i = 0; i < 16; i += 4)
+        {
+            sumR += Vec4::load(&texels.r[i]);
+            sumG += Vec4::load(&texels.g[i]);
+            sumB += Vec4::load(&texels.b[i]);
+        }
+        const Vec4 meanR(horizontalSum4(sumR) / 16.0f);
+        const Vec4 meanG(horizontalSum4(sumG) / 16.0f);
+        const Vec4 meanB(horizontalSum4(sumB) / 16.0f);
+
+        Vec4 rr, rg, rb, gg, gb, bb;
+        for (uint32_t i = 0; i < 16; i += 4)
+        {
+            const Vec4 r = Vec4::load(&texels.r[i]) - meanR;
+            const Vec4 g = Vec4::load(&texels.g[i]) - meanG;
+            const Vec4 b = Vec4::load(&texels.b[i]) - meanB;
+
+            rr = Vec4::multiplyAdd(r, r, rr);
+            rg = Vec4::multiplyAdd(r, g, rg);
+            rb = Vec4::multiplyAdd(r, b, rb);
+            gg = Vec4::multiplyAdd(g, g, gg);
+            gb = Vec4::multiplyAdd(g, b, gb);
+            bb = Vec4::multiplyAdd(b, b, bb);
+        }
+        const float covariance[6] = { horizontalSum4(rr), horizontalSum4(rg), horizontalSum4(rb), horizontalSum4(gg), horizontalSum4(gb), horizontalSum4(bb) };
+
+        const Vec4 row0(covariance[0], covariance[1], covariance[2], 0.0f);
+        const Vec4 row1(covariance[1], covariance[3], covariance[4], 0.0f);
+        const Vec4 row2(covariance[2], covariance[4], covariance[5], 0.0f);
+
+        Vec4 axis = row0;
+        if (covariance[3] > covariance[0] && covariance[3] >= covariance[5])
+            axis = row1;
+        else if (covariance[5] > covariance[0])
+            axis = row2;
+
+        // Normalised every 4 iterations only, colors are in [0, 1] so the values stay in float range
+        for (uint32_t iteration = 0; iteration < 8; ++iteration)
+        {
+            axis = Vec4::multiplyAdd(row0, axis.splat<0>(), Vec4::multiplyAdd(row1, axis.splat<1>(), row2 * axis.splat<2>()));
+
+            if (iteration % 4 == 3)
+            {
+                float values[4];
+                axis.store(values);
+                const float maxComponent = std::max(std::abs(values[0]), std::max(std::abs(values[1]), std::abs(values[2])));
+                if (maxComponent == 0.0f)
+                    return Vec4(1.0f, 1.0f, 1.0f, 0.0f);
+                axis = axis * Vec4(1.0f / maxComponent);
+            }
+        }
+
+        return axis;
+    }
+
+    // Picks the closest of the 4 colors decoded from the endpoints for each texel, returns the squared error of the block
+    float computeIndices(const BlockTexels& texels, const Vec4& start, const Vec4& end, uint8_t* outIndices)
+    {
+        float palette[4][4];
+        start.store(palette[0]);
+        end.store(palette[1]);
+        Vec4::multiplyAdd(start, Vec4(2.0f / 3.0f), end * Vec4(1.0f / 3.0f)).store(palette[2]);
+        Vec4::multiplyAdd(start, Vec4(1.0f / 3.0f), end * Vec4(2.0f / 3.0f)).store(palette[3]);
+
+        // Closest palette index and its distance are selected without branches, 4 texels at a time
+        float bestIndices[16];
+        Vec4 errorSum;
+        for (uint32_t i = 0; i < 16; i += 4)
+        {
+            const Vec4 r = Vec4::load(&texels.r[i]);
+            const Vec4 g = Vec4::load(&texels.g[i]);
+            const Vec4 b = Vec4::load(&texels.b[i]);
+
+            Vec4 minDistance(std::numeric_limits<float>::max());
+            Vec4 bestIndex;
+            for (uint32_t paletteIdx = 0; paletteIdx < 4; ++paletteIdx)
+            {
+                const Vec4 offsetR = r - Vec4(palette[paletteIdx][0]);
+                const Vec4 offsetG = g - Vec4(palette[paletteIdx][1]);
+                const Vec4 offsetB = b - Vec4(palette[paletteIdx][2]);
+                const Vec4 distance = Vec4::multiplyAdd(offsetR, offsetR, Vec4::multiplyAdd(offsetG, offsetG, offsetB * offsetB));
+
+                bestIndex = Vec4::selectLessThan(distance, minDistance, Vec4(static_cast<float>(paletteIdx)), bestIndex);
+                minDistance = Vec4::min(distance, minDistance);
+            }
+
+            bestIndex.store(&bestIndices[i]);
+            errorSum += minDistance;
+        }
+
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+            outIndices[texelIdx] = static_cast<uint8_t>(bestIndices[texelIdx]);
+
+        const float error = horizontalSum4(errorSum);
+        return error;
+    }
+
+    // Faster approximation of computeIndices: texels are projected on the segment between the endpoints and the closest of the 4 steps is used
+    void computeIndicesAlongSegment(const BlockTexels& texels, const Vec4& start, const Vec4& end, uint8_t* outIndices)
+    {
+        float startValues[4], directionValues[4];
+        start.store(startValues);
+        const Vec4 direction = end - start;
+        direction.store(directionValues);
+
+        const float lengthSquared = dot3(direction, direction);
+        const float scale = lengthSquared > 0.0f ? 3.0f / lengthSquared : 0.0f;
+        const Vec4 directionR(directionValues[0] * scale), directionG(directionValues[1] * scale), directionB(directionValues[2] * scale);
+
+        float steps[16];
+        for (uint32_t i = 0; i < 16; i += 4)
+        {
+            const Vec4 offsetR = Vec4::load(&texels.r[i]) - Vec4(startValues[0]);
+            const Vec4 offsetG = Vec4::load(&texels.g[i]) - Vec4(startValues[1]);
+            const Vec4 offsetB = Vec4::load(&texels.b[i]) - Vec4(startValues[2]);
+            const Vec4 position = Vec4::multiplyAdd(offsetR, directionR, Vec4::multiplyAdd(offsetG, directionG, offsetB * directionB));
+            Vec4::truncate(Vec4::min(Vec4(3.0f), Vec4::max(Vec4(0.0f), position)) + Vec4(0.5f)).store(&steps[i]);
+        }
+
+        // Steps from start to end are indices 0, 2, 3 and 1
+        constexpr uint8_t STEP_TO_INDEX[4] = { 0, 2, 3, 1 };
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+            outIndices[texelIdx] = STEP_TO_INDEX[static_cast<uint32_t>(steps[texelIdx])];
+    }
+
+    // Always uses the 4 colors mode (color0 > color1) which is also the only mode of BC3 color data.
+    // The bitmap has 2 bits per texel where index 0 selects start and 1 selects end
+    void writeColorBlock(uint16_t startColor, uint16_t endColor, uint32_t bitmap, Wolf::ImageCompression::BC1& outBlock)
+    {
+        outBlock.rgb[0] = std::max(startColor, endColor);
+        outBlock.rgb[1] = std::min(startColor, endColor);
+
+        // Equal colors select the 3 colors mode, index 0 is the only one giving the color
+        if (startColor == endColor)
+            outBlock.bitmap = 0;
+        else
+            outBlock.bitmap = startColor < endColor ? bitmap ^ 0x55555555u : bitmap; // swaps 0 and 1, 2 and 3
+    }
+
+    void writeColorBlock(const Vec4& start, const Vec4& end, const uint8_t* indices, Wolf::ImageCompression::BC1& outBlock)
+    {
+        uint32_t bitmap = 0;
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+            bitmap |= static_cast<uint32_t>(indices[texelIdx]) << (texelIdx * 2);
+
+        writeColorBlock(packTo565(start), packTo565(end), bitmap, outBlock);
+    }
+
+    // For each 8 bits value, endpoints whose 2/3 interpolation gives the closest value, for 5 and 6 bits channels
+    struct SingleColorTable
+    {
+        uint8_t endpoints[2][256][2];
+
+        SingleColorTable()
+        {
+            for (uint32_t tableIdx = 0; tableIdx < 2; ++tableIdx)
+            {
+                const uint32_t bitCount = tableIdx == 0 ? 5 : 6;
+                const uint32_t maxValue = (1u << bitCount) - 1;
+                auto expand = [&](uint32_t value) { return static_cast<int32_t>((value << (8 - bitCount)) | (value >> (2 * bitCount - 8))); };
+
+                for (int32_t value = 0; value < 256; ++value)
+                {
+                    int32_t bestError = std::numeric_limits<int32_t>::max();
+                    for (uint32_t start = 0; start <= maxValue; ++start)
+                    {
+                        for (uint32_t end = 0; end <= maxValue; ++end)
+                        {
+                            const int32_t error = std::abs((2 * expand(start) + expand(end)) / 3 - value);
+                            if (error < bestError)
+                            {
+                                bestError = error;
+                                endpoints[tableIdx][value][0] = static_cast<uint8_t>(start);
+                                endpoints[tableIdx][value][1] = static_cast<uint8_t>(end);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    void compressSingleColor(const RGBA8& color, Wolf::ImageCompression::BC1& outBlock)
+    {
+        static const SingleColorTable table;
+
+        const Vec4 start(table.endpoints[0][color.r][0] / 31.0f, table.endpoints[1][color.g][0] / 63.0f, table.endpoints[0][color.b][0] / 31.0f, 0.0f);
+        const Vec4 end(table.endpoints[0][color.r][1] / 31.0f, table.endpoints[1][color.g][1] / 63.0f, table.endpoints[0][color.b][1] / 31.0f, 0.0f);
+
+        uint8_t indices[16];
+        std::memset(indices, 2, sizeof(indices));
+        writeColorBlock(start, end, indices, outBlock);
+    }
+
+    // Endpoints are the extreme colors along the principal axis
+    void compressRangeFit(const BlockTexels& texels, const Vec4& axis, Wolf::ImageCompression::BC1& outBlock)
+    {
+        float axisValues[4];
+        axis.store(axisValues);
+
+        float projections[16];
+        for (uint32_t i = 0; i < 16; i += 4)
+        {
+            const Vec4 projection = Vec4::multiplyAdd(Vec4::load(&texels.r[i]), Vec4(axisValues[0]), Vec4::multiplyAdd(Vec4::load(&texels.g[i]), Vec4(axisValues[1]), Vec4::load(&texels.b[i]) * Vec4(axisValues[2])));
+            projection.store(&projections[i]);
+        }
+
+        uint32_t minTexelIdx = 0, maxTexelIdx = 0;
+        for (uint32_t texelIdx = 1; texelIdx < 16; ++texelIdx)
+        {
+            minTexelIdx = projections[texelIdx] < projections[minTexelIdx] ? texelIdx : minTexelIdx;
+            maxTexelIdx = projections[texelIdx] > projections[maxTexelIdx] ? texelIdx : maxTexelIdx;
+        }
+
+        const Vec4 start = snapToGrid(Vec4(texels.r[minTexelIdx], texels.g[minTexelIdx], texels.b[minTexelIdx], 0.0f));
+        const Vec4 end = snapToGrid(Vec4(texels.r[maxTexelIdx], texels.g[maxTexelIdx], texels.b[maxTexelIdx], 0.0f));
+
+        uint8_t indices[16];
+        computeIndicesAlongSegment(texels, start, end, indices);
+        writeColorBlock(start, end, indices, outBlock);
+    }
+
+    // Colors are ordered along the principal axis, every split of this order in 4 consecutive clusters is evaluated
+    // and the endpoints are solved by least squares for each one
+    void compressClusterFit(const BlockTexels& texels, const Vec4& axis, Wolf::ImageCompression::BC1& outBlock)
+    {
+        // Distinct colors, weighted by their texel count
+        Vec4 colors[16];
+        uint32_t colorTexelIndices[16];
+        float weights[16];
+        float projections[16];
+        uint32_t count = 0;
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        {
+            uint32_t colorIdx = 0;
+            while (colorIdx < count && (texels.r[texelIdx] != texels.r[colorTexelIndices[colorIdx]] || texels.g[texelIdx] != texels.g[colorTexelIndices[colorIdx]] ||
+                texels.b[texelIdx] != texels.b[colorTexelIndices[colorIdx]]))
+                colorIdx++;
+
+            if (colorIdx == count)
+            {
+                colorTexelIndices[count] = texelIdx;
+                colors[count] = Vec4(texels.r[texelIdx], texels.g[texelIdx], texels.b[texelIdx], 0.0f);
+                weights[count] = 0.0f;
+                projections[count] = dot3(colors[count], axis);
+                count++;
+            }
+            weights[colorIdx] += 1.0f;
+        }
+
+        uint8_t order[16];
+        for (uint32_t colorIdx = 0; colorIdx < count; ++colorIdx)
+            order[colorIdx] = static_cast<uint8_t>(colorIdx);
+        std::sort(order, order + count, [&](uint8_t a, uint8_t b) { return projections[a] < projections[b]; });
+
+        // xyz is the weighted color, w the weight
+        Vec4 weightedColors[16];
+        Vec4 weightedSum;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const float weight = weights[order[i]];
+            weightedColors[i] = Vec4::multiplyAdd(colors[order[i]], Vec4(weight), Vec4(0.0f, 0.0f, 0.0f, weight));
+            weightedSum += weightedColors[i];
+        }
+
+        const Vec4 oneThirdOneThird2(1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 9.0f);
+        const Vec4 twoThirdsTwoThirds2(2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 4.0f / 9.0f);
+        const Vec4 twoNinths(2.0f / 9.0f);
+        const Vec4 two(2.0f);
+        const Vec4 zero(0.0f);
+        const Vec4 one(1.0f);
+        const Vec4 half(0.5f);
+
+        Vec4 bestStart, bestEnd;
+        Vec4 bestError(std::numeric_limits<float>::max());
+
+        // Clusters are [0, i) for start, [i, j) for 2/3 start + 1/3 end, [j, k) for 1/3 start + 2/3 end and [k, count) for end
+        Vec4 part0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            Vec4 part1;
+            for (uint32_t j = i;;)
+            {
+                Vec4 part2 = j == 0 ? weightedColors[0] : zero;
+                const uint32_t kMin = j == 0 ? 1 : j;
+                for (uint32_t k = kMin;;)
+                {
+                    const Vec4 part3 = weightedSum - part2 - part1 - part0;
+
+                    const Vec4 alphaXSum = Vec4::multiplyAdd(part1, twoThirdsTwoThirds2, Vec4::multiplyAdd(part2, oneThirdOneThird2, part0));
+                    const Vec4 alpha2Sum = alphaXSum.splat<3>();
+                    const Vec4 betaXSum = Vec4::multiplyAdd(part2, twoThirdsTwoThirds2, Vec4::multiplyAdd(part1, oneThirdOneThird2, part3));
+                    const Vec4 beta2Sum = betaXSum.splat<3>();
+                    const Vec4 alphaBetaSum = twoNinths * (part1 + part2).splat<3>();
+
+                    const Vec4 factor = Vec4::reciprocal(Vec4::negativeMultiplySubtract(alphaBetaSum, alphaBetaSum, alpha2Sum * beta2Sum));
+                    Vec4 a = Vec4::negativeMultiplySubtract(betaXSum, alphaBetaSum, alphaXSum * beta2Sum) * factor;
+                    Vec4 b = Vec4::negativeMultiplySubtract(alphaXSum, alphaBetaSum, betaXSum * alpha2Sum) * factor;
+
+                    a = Vec4::truncate(Vec4::multiplyAdd(GRID, Vec4::min(one, Vec4::max(zero, a)), half)) * GRID_RECIPROCAL;
+                    b = Vec4::truncate(Vec4::multiplyAdd(GRID, Vec4::min(one, Vec4::max(zero, b)), half)) * GRID_RECIPROCAL;
+
+                    // Error without the constant sum of squared colors
+                    const Vec4 e1 = Vec4::multiplyAdd(a * a, alpha2Sum, b * b * beta2Sum);
+                    const Vec4 e2 = Vec4::negativeMultiplySubtract(a, alphaXSum, a * b * alphaBetaSum);
+                    const Vec4 e3 = Vec4::negativeMultiplySubtract(b, betaXSum, e2);
+                    const Vec4 e4 = Vec4::multiplyAdd(two, e3, e1);
+                    const Vec4 error = e4.splat<0>() + e4.splat<1>() + e4.splat<2>();
+
+                    if (Vec4::compareAnyLessThan(error, bestError))
+                    {
+                        bestStart = a;
+                        bestEnd = b;
+                        bestError = error;
+                    }
+
+                    if (k == count)
+                        break;
+                    part2 += weightedColors[k];
+                    ++k;
+                }
+
+                if (j == count)
+                    break;
+                part1 += weightedColors[j];
+                ++j;
+            }
+            part0 += weightedColors[i];
+        }
+
+        // Indices are computed again as the best split isn't always the closest color for each texel once endpoints are quantized
+        uint8_t indices[16];
+        computeIndices(texels, bestStart, bestEnd, indices);
+        writeColorBlock(bestStart, bestEnd, indices, outBlock);
+    }
+
+    void compressColorBlock(const RGBA8* firstTexel, uint32_t rowPitch, Wolf::ImageCompression::Quality quality, Wolf::ImageCompression::BC1& outBlock)
+    {
+        BlockTexels texels;
+        if (!loadBlockTexels(firstTexel, rowPitch, texels))
+        {
+            compressSingleColor(*firstTexel, outBlock);
+            return;
+        }
+
+        const Vec4 axis = computePrincipalAxis(texels);
+        if (quality == Wolf::ImageCompression::Quality::HIGH)
+            compressClusterFit(texels, axis, outBlock);
+        else
+            compressRangeFit(texels, axis, outBlock);
+    }
+
+#if defined(IMAGE_COMPRESSION_AVX2)
+    bool isAVX2Supported()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int cpuInfo[4];
+        __cpuid(cpuInfo, 0);
+        if (cpuInfo[0] < 7)
+            return false;
+
+        // AVX registers must also be saved by the OS
+        __cpuid(cpuInfo, 1);
+        const bool isAVXSupported = (cpuInfo[2] & (1 << 27)) != 0 && (cpuInfo[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(cpuInfo, 7, 0);
+        return isAVXSupported && (cpuInfo[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    // Vec4 of two blocks: the low half belongs to the first block, the high half to the second one.
+    // Operations are done the same way as Vec4 so each half gives the same result as Vec4 would
+    class Vec4x2
+    {
+    public:
+        AVX2_INLINE_FUNCTION Vec4x2() : m_value(_mm256_setzero_ps()) {}
+        AVX2_INLINE_FUNCTION explicit Vec4x2(float value) : m_value(_mm256_set1_ps(value)) {}
+        AVX2_INLINE_FUNCTION Vec4x2(float x0, float y0, float z0, float w0, float x1, float y1, float z1, float w1) : m_value(_mm256_setr_ps(x0, y0, z0, w0, x1, y1, z1, w1)) {}
+        AVX2_INLINE_FUNCTION static Vec4x2 load(const float* values) { return Vec4x2(_mm256_loadu_ps(values)); }
+        // Channels of 4 consecutive RGBA8 texels of each block, the second block starts right after the first one
+        AVX2_INLINE_FUNCTION static void loadRGB(const RGBA8* texels, Vec4x2& outR, Vec4x2& outG, Vec4x2& outB)
+        {
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(texels));
+            const __m256i mask = _mm256_set1_epi32(0xff);
+            const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+            outR = Vec4x2(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(values, mask)), scale));
+            outG = Vec4x2(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(values, 8), mask)), scale));
+            outB = Vec4x2(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(values, 16), mask)), scale));
+        }
+
+        AVX2_INLINE_FUNCTION Vec4x2 operator+(const Vec4x2& other) const { return Vec4x2(_mm256_add_ps(m_value, other.m_value)); }
+        AVX2_INLINE_FUNCTION Vec4x2 operator-(const Vec4x2& other) const { return Vec4x2(_mm256_sub_ps(m_value, other.m_value)); }
+        AVX2_INLINE_FUNCTION Vec4x2 operator*(const Vec4x2& other) const { return Vec4x2(_mm256_mul_ps(m_value, other.m_value)); }
+        AVX2_INLINE_FUNCTION Vec4x2 operator/(const Vec4x2& other) const { return Vec4x2(_mm256_div_ps(m_value, other.m_value)); }
+        AVX2_INLINE_FUNCTION Vec4x2& operator+=(const Vec4x2& other) { m_value = _mm256_add_ps(m_value, other.m_value); return *this; }
+
+        // Lane of each half copied to the whole half
+        template <int Lane> [[nodiscard]] AVX2_INLINE_FUNCTION Vec4x2 splat() const { return Vec4x2(_mm256_shuffle_ps(m_value, m_value, _MM_SHUFFLE(Lane, Lane, Lane, Lane))); }
+        AVX2_INLINE_FUNCTION void store(float* out) const { _mm256_storeu_ps(out, m_value); }
+
+        AVX2_INLINE_FUNCTION static Vec4x2 multiplyAdd(const Vec4x2& a, const Vec4x2& b, const Vec4x2& c) { return Vec4x2(_mm256_add_ps(_mm256_mul_ps(a.m_value, b.m_value), c.m_value)); }
+        AVX2_INLINE_FUNCTION static Vec4x2 min(const Vec4x2& a, const Vec4x2& b) { return Vec4x2(_mm256_min_ps(a.m_value, b.m_value)); }
+        AVX2_INLINE_FUNCTION static Vec4x2 max(const Vec4x2& a, const Vec4x2& b) { return Vec4x2(_mm256_max_ps(a.m_value, b.m_value)); }
+        AVX2_INLINE_FUNCTION static Vec4x2 abs(const Vec4x2& a) { return Vec4x2(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.m_value)); }
+        AVX2_INLINE_FUNCTION static Vec4x2 truncate(const Vec4x2& a) { return Vec4x2(_mm256_cvtepi32_ps(_mm256_cvttps_epi32(a.m_value))); }
+        // Lanes of ifTrue where a < b, lanes of ifFalse elsewhere
+        AVX2_INLINE_FUNCTION static Vec4x2 selectLessThan(const Vec4x2& a, const Vec4x2& b, const Vec4x2& ifTrue, const Vec4x2& ifFalse)
+        {
+            const __m256 mask = _mm256_cmp_ps(a.m_value, b.m_value, _CMP_LT_OQ);
+            return Vec4x2(_mm256_or_ps(_mm256_and_ps(mask, ifTrue.m_value), _mm256_andnot_ps(mask, ifFalse.m_value)));
+        }
+        // x, y and z taken from the same lane of each input, w is 0
+        AVX2_INLINE_FUNCTION static Vec4x2 combineXYZ(const Vec4x2& x, const Vec4x2& y, const Vec4x2& z)
+        {
+            return Vec4x2(_mm256_blend_ps(_mm256_blend_ps(_mm256_blend_ps(_mm256_setzero_ps(), x.m_value, 0x11), y.m_value, 0x22), z.m_value, 0x44));
+        }
+        // Bit i is set when lane i of a and b are equal
+        AVX2_INLINE_FUNCTION static uint32_t compareEqualMask(const Vec4x2& a, const Vec4x2& b) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a.m_value, b.m_value, _CMP_EQ_OQ))); }
+
+    private:
+        AVX2_INLINE_FUNCTION explicit Vec4x2(__m256 value) : m_value(value) {}
+        __m256 m_value;
+    };
+
+    AVX2_INLINE_FUNCTION Vec4x2 dot3(const Vec4x2& a, const Vec4x2& b)
+    {
+        const Vec4x2 product = a * b;
+        return product.splat<0>() + product.splat<1>() + product.splat<2>();
+    }
+
+    AVX2_INLINE_FUNCTION Vec4x2 horizontalSum4(const Vec4x2& value)
+    {
+        return value.splat<0>() + value.splat<1>() + value.splat<2>() + value.splat<3>();
+    }
+
+    AVX2_INLINE_FUNCTION Vec4x2 snapToGrid(const Vec4x2& color)
+    {
+        const Vec4x2 grid(31.0f, 63.0f, 31.0f, 0.0f, 31.0f, 63.0f, 31.0f, 0.0f);
+        const Vec4x2 gridReciprocal(1.0f / 31.0f, 1.0f / 63.0f, 1.0f / 31.0f, 0.0f, 1.0f / 31.0f, 1.0f / 63.0f, 1.0f / 31.0f, 0.0f);
+
+        const Vec4x2 clamped = Vec4x2::min(Vec4x2(1.0f), Vec4x2::max(Vec4x2(0.0f), color));
+        return Vec4x2::truncate(Vec4x2::multiplyAdd(grid, clamped, Vec4x2(0.5f))) * gridReciprocal;
+    }
+
+    AVX2_FUNCTION void packTo565(const Vec4x2& colorOnGrid, uint16_t (&outColors)[2])
+    {
+        const Vec4x2 grid(31.0f, 63.0f, 31.0f, 0.0f, 31.0f, 63.0f, 31.0f, 0.0f);
+
+        float values[8];
+        Vec4x2::multiplyAdd(grid, colorOnGrid, Vec4x2(0.5f)).store(values);
+        for (uint32_t blockIdx = 0; blockIdx < 2; ++blockIdx)
+        {
+            const float* blockValues = &values[blockIdx * 4];
+            outColors[blockIdx] = static_cast<uint16_t>((static_cast<uint32_t>(blockValues[0]) << 11) | (static_cast<uint32_t>(blockValues[1]) << 5) | static_cast<uint32_t>(blockValues[2]));
+        }
+    }
+
+    // Texels of two neighbour 4x4 blocks, groups of 8 floats hold 4 texels of the first block then the same 4 texels of the second one
+    struct BlockPairTexels
+    {
+        float r[32];
+        float g[32];
+        float b[32];
+
+        [[nodiscard]] static uint32_t getOffset(uint32_t blockIdx, uint32_t texelIdx) { return (texelIdx / 4) * 8 + blockIdx * 4 + texelIdx % 4; }
+    };
+
+    // Returns false when any of the blocks has a single color
+    AVX2_FUNCTION bool loadBlockPairTexels(const RGBA8* firstTexel, uint32_t rowPitch, BlockPairTexels& outTexels)
+    {
+        uint32_t firstColors[2];
+        std::memcpy(&firstColors[0], firstTexel, sizeof(uint32_t));
+        std::memcpy(&firstColors[1], firstTexel + 4, sizeof(uint32_t));
+        const __m256i firstColorsPerBlock = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_set1_epi32(static_cast<int>(firstColors[0]))), _mm_set1_epi32(static_cast<int>(firstColors[1])), 1);
+
+        __m256i differentBits = _mm256_setzero_si256();
+        for (uint32_t rowIdx = 0; rowIdx < 4; ++rowIdx)
+        {
+            const RGBA8* row = firstTexel + rowIdx * rowPitch;
+
+            Vec4x2 r, g, b;
+            Vec4x2::loadRGB(row, r, g, b);
+            r.store(&outTexels.r[rowIdx * 8]);
+            g.store(&outTexels.g[rowIdx * 8]);
+            b.store(&outTexels.b[rowIdx * 8]);
+
+            differentBits = _mm256_or_si256(differentBits, _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row)), firstColorsPerBlock));
+        }
+
+        // Alpha is ignored
+        differentBits = _mm256_and_si256(differentBits, _mm256_set1_epi32(0x00ffffff));
+        const uint32_t sameColorMask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(differentBits, _mm256_setzero_si256()))));
+        return (sameColorMask & 0x0f) != 0x0f && (sameColorMask & 0xf0) != 0xf0;
+    }
+
+    // Same as computePrincipalAxis(const BlockTexels&) for each block
+    AVX2_INLINE_FUNCTION Vec4x2 computePrincipalAxis(const BlockPairTexels& texels)
+    {
+        Vec4x2 sumR, sumG, sumB;
+        for (uint32_t i = 0; i < 32; i += 8)
+        {
+            sumR += Vec4x2::load(&texels.r[i]);
+            sumG += Vec4x2::load(&texels.g[i]);
+            sumB += Vec4x2::load(&texels.b[i]);
+        }
+        // Division by 16 is exact as a multiplication
+        const Vec4x2 meanR = horizontalSum4(sumR) * Vec4x2(1.0f / 16.0f);
+        const Vec4x2 meanG = horizontalSum4(sumG) * Vec4x2(1.0f / 16.0f);
+        const Vec4x2 meanB = horizontalSum4(sumB) * Vec4x2(1.0f / 16.0f);
+
+        Vec4x2 rr, rg, rb, gg, gb, bb;
+        for (uint32_t i = 0; i < 32; i += 8)
+        {
+            const Vec4x2 r = Vec4x2::load(&texels.r[i]) - meanR;
+            const Vec4x2 g = Vec4x2::load(&texels.g[i]) - meanG;
+            const Vec4x2 b = Vec4x2::load(&texels.b[i]) - meanB;
+
+            rr = Vec4x2::multiplyAdd(r, r, rr);
+            rg = Vec4x2::multiplyAdd(r, g, rg);
+            rb = Vec4x2::multiplyAdd(r, b, rb);
+            gg = Vec4x2::multiplyAdd(g, g, gg);
+            gb = Vec4x2::multiplyAdd(g, b, gb);
+            bb = Vec4x2::multiplyAdd(b, b, bb);
+        }
+        rr = horizontalSum4(rr);
+        rg = horizontalSum4(rg);
+        rb = horizontalSum4(rb);
+        gg = horizontalSum4(gg);
+        gb = horizontalSum4(gb);
+        bb = horizontalSum4(bb);
+
+        const Vec4x2 row0 = Vec4x2::combineXYZ(rr, rg, rb);
+        const Vec4x2 row1 = Vec4x2::combineXYZ(rg, gg, gb);
+        const Vec4x2 row2 = Vec4x2::combineXYZ(rb, gb, bb);
+
+        // row1 when gg > rr and gg >= bb, otherwise row2 when bb > rr, otherwise row0
+        Vec4x2 axis = Vec4x2::selectLessThan(rr, bb, row2, row0);
+        axis = Vec4x2::selectLessThan(rr, gg, Vec4x2::selectLessThan(gg, bb, axis, row1), axis);
+
+        // A null axis stays null and is replaced at the end, like the early return of the single block version
+        const Vec4x2 zero;
+        Vec4x2 maxComponent;
+        for (uint32_t iteration = 0; iteration < 8; ++iteration)
+        {
+            axis = Vec4x2::multiplyAdd(row0, axis.splat<0>(), Vec4x2::multiplyAdd(row1, axis.splat<1>(), row2 * axis.splat<2>()));
+
+            if (iteration % 4 == 3)
+            {
+                const Vec4x2 absAxis = Vec4x2::abs(axis);
+                maxComponent = Vec4x2::max(absAxis.splat<0>(), Vec4x2::max(absAxis.splat<1>(), absAxis.splat<2>()));
+                axis = axis * Vec4x2::selectLessThan(zero, maxComponent, Vec4x2(1.0f) / maxComponent, zero);
+            }
+        }
+
+        return Vec4x2::selectLessThan(zero, maxComponent, axis, Vec4x2(1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f));
+    }
+
+    // Same as computeIndicesAlongSegment() for each block, returns the bitmaps
+    AVX2_FUNCTION void computeIndicesAlongSegment(const BlockPairTexels& texels, const Vec4x2& start, const Vec4x2& end, uint32_t (&outBitmaps)[2])
+    {
+        const Vec4x2 direction = end - start;
+        const Vec4x2 lengthSquared = dot3(direction, direction);
+        const Vec4x2 zero;
+        const Vec4x2 scaledDirection = direction * Vec4x2::selectLessThan(zero, lengthSquared, Vec4x2(3.0f) / lengthSquared, zero);
+        const Vec4x2 directionR = scaledDirection.splat<0>(), directionG = scaledDirection.splat<1>(), directionB = scaledDirection.splat<2>();
+        const Vec4x2 startR = start.splat<0>(), startG = start.splat<1>(), startB = start.splat<2>();
+
+        float steps[32];
+        for (uint32_t i = 0; i < 32; i += 8)
+        {
+            const Vec4x2 offsetR = Vec4x2::load(&texels.r[i]) - startR;
+            const Vec4x2 offsetG = Vec4x2::load(&texels.g[i]) - startG;
+            const Vec4x2 offsetB = Vec4x2::load(&texels.b[i]) - startB;
+            const Vec4x2 position = Vec4x2::multiplyAdd(offsetR, directionR, Vec4x2::multiplyAdd(offsetG, directionG, offsetB * directionB));
+            Vec4x2::truncate(Vec4x2::min(Vec4x2(3.0f), Vec4x2::max(zero, position)) + Vec4x2(0.5f)).store(&steps[i]);
+        }
+
+        // Steps from start to end are indices 0, 2, 3 and 1
+        constexpr uint32_t STEP_TO_INDEX[4] = { 0, 2, 3, 1 };
+        for (uint32_t blockIdx = 0; blockIdx < 2; ++blockIdx)
+        {
+            outBitmaps[blockIdx] = 0;
+            for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+                outBitmaps[blockIdx] |= STEP_TO_INDEX[static_cast<uint32_t>(steps[BlockPairTexels::getOffset(blockIdx, texelIdx)])] << (texelIdx * 2);
+        }
+    }
+
+    // Same as compressRangeFit() for each block
+    AVX2_FUNCTION void compressRangeFit(const BlockPairTexels& texels, const Vec4x2& axis, Wolf::ImageCompression::BC1& outBlock0, Wolf::ImageCompression::BC1& outBlock1)
+    {
+        const Vec4x2 axisR = axis.splat<0>(), axisG = axis.splat<1>(), axisB = axis.splat<2>();
+
+        Vec4x2 projections[4];
+        Vec4x2 minProjection(std::numeric_limits<float>::max()), maxProjection(-std::numeric_limits<float>::max());
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            projections[i] = Vec4x2::multiplyAdd(Vec4x2::load(&texels.r[i * 8]), axisR, Vec4x2::multiplyAdd(Vec4x2::load(&texels.g[i * 8]), axisG, Vec4x2::load(&texels.b[i * 8]) * axisB));
+            minProjection = Vec4x2::min(minProjection, projections[i]);
+            maxProjection = Vec4x2::max(maxProjection, projections[i]);
+        }
+        minProjection = Vec4x2::min(Vec4x2::min(minProjection.splat<0>(), minProjection.splat<1>()), Vec4x2::min(minProjection.splat<2>(), minProjection.splat<3>()));
+        maxProjection = Vec4x2::max(Vec4x2::max(maxProjection.splat<0>(), maxProjection.splat<1>()), Vec4x2::max(maxProjection.splat<2>(), maxProjection.splat<3>()));
+
+        // First texel with the extreme projection, as the single block version picks
+        uint32_t minTexelMasks[2] = { 0, 0 }, maxTexelMasks[2] = { 0, 0 };
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            const uint32_t minMask = Vec4x2::compareEqualMask(projections[i], minProjection);
+            const uint32_t maxMask = Vec4x2::compareEqualMask(projections[i], maxProjection);
+            minTexelMasks[0] |= (minMask & 0xf) << (i * 4);
+            minTexelMasks[1] |= (minMask >> 4) << (i * 4);
+            maxTexelMasks[0] |= (maxMask & 0xf) << (i * 4);
+            maxTexelMasks[1] |= (maxMask >> 4) << (i * 4);
+        }
+
+        uint32_t minOffsets[2], maxOffsets[2];
+        for (uint32_t blockIdx = 0; blockIdx < 2; ++blockIdx)
+        {
+            minOffsets[blockIdx] = BlockPairTexels::getOffset(blockIdx, static_cast<uint32_t>(std::countr_zero(minTexelMasks[blockIdx])));
+            maxOffsets[blockIdx] = BlockPairTexels::getOffset(blockIdx, static_cast<uint32_t>(std::countr_zero(maxTexelMasks[blockIdx])));
+        }
+
+        const Vec4x2 start = snapToGrid(Vec4x2(texels.r[minOffsets[0]], texels.g[minOffsets[0]], texels.b[minOffsets[0]], 0.0f, texels.r[minOffsets[1]], texels.g[minOffsets[1]], texels.b[minOffsets[1]], 0.0f));
+        const Vec4x2 end = snapToGrid(Vec4x2(texels.r[maxOffsets[0]], texels.g[maxOffsets[0]], texels.b[maxOffsets[0]], 0.0f, texels.r[maxOffsets[1]], texels.g[maxOffsets[1]], texels.b[maxOffsets[1]], 0.0f));
+
+        uint32_t bitmaps[2];
+        computeIndicesAlongSegment(texels, start, end, bitmaps);
+
+        uint16_t startColors[2], endColors[2];
+        packTo565(start, startColors);
+        packTo565(end, endColors);
+        writeColorBlock(startColors[0], endColors[0], bitmaps[0], outBlock0);
+        writeColorBlock(startColors[1], endColors[1], bitmaps[1], outBlock1);
+    }
+
+    // Neighbour blocks are encoded in pairs, pairs with a single color block and the last block of odd rows use the single block version
+    template <typename OutBlockFunction>
+    AVX2_FUNCTION void compressColorBlockRowFastAVX2(const RGBA8* firstTexel, uint32_t rowPitch, uint32_t blockCount, const OutBlockFunction& getOutBlock)
+    {
+        uint32_t blockX = 0;
+        for (; blockX + 1 < blockCount; blockX += 2)
+        {
+            BlockPairTexels texels;
+            if (loadBlockPairTexels(firstTexel + blockX * 4, rowPitch, texels))
+            {
+                compressRangeFit(texels, computePrincipalAxis(texels), getOutBlock(blockX), getOutBlock(blockX + 1));
+                continue;
+            }
+
+            compressColorBlock(firstTexel + blockX * 4, rowPitch, Wolf::ImageCompression::Quality::FAST, getOutBlock(blockX));
+            compressColorBlock(firstTexel + (blockX + 1) * 4, rowPitch, Wolf::ImageCompression::Quality::FAST, getOutBlock(blockX + 1));
+        }
+
+        if (blockX < blockCount)
+            compressColorBlock(firstTexel + blockX * 4, rowPitch, Wolf::ImageCompression::Quality::FAST, getOutBlock(blockX));
+    }
+#endif
+
+    std::atomic<Wolf::ImageCompression::InstructionSet> g_instructionSet = []()
+    {
+#if defined(IMAGE_COMPRESSION_AVX2)
+        if (isAVX2Supported())
+            return Wolf::ImageCompression::InstructionSet::AVX2;
+#endif
+        return Wolf::ImageCompression::InstructionSet::BASELINE;
+    }();
+
+    // Color data of a row of blocks, getOutBlock(blockX) gives the BC1 block to write
+    template <typename OutBlockFunction>
+    void compressColorBlockRow(const RGBA8* firstTexel, uint32_t rowPitch, uint32_t blockCount, Wolf::ImageCompression::Quality quality, const OutBlockFunction& getOutBlock)
+    {
+#if defined(IMAGE_COMPRESSION_AVX2)
+        if (quality == Wolf::ImageCompression::Quality::FAST && g_instructionSet.load(std::memory_order_relaxed) == Wolf::ImageCompression::InstructionSet::AVX2)
+        {
+            compressColorBlockRowFastAVX2(firstTexel, rowPitch, blockCount, getOutBlock);
+            return;
+        }
+#endif
+
+        for (uint32_t blockX = 0; blockX < blockCount; ++blockX)
+            compressColorBlock(firstTexel + blockX * 4, rowPitch, quality, getOutBlock(blockX));
+    }
+
+    // alpha0 > alpha1 selects the 8 values mode, otherwise 6 values are interpolated and 0 and 255 are added
+    void computeAlphaPalette(uint8_t alpha0, uint8_t alpha1, int32_t (&outPalette)[8])
+    {
+        outPalette[0] = alpha0;
+        outPalette[1] = alpha1;
+        if (alpha0 > alpha1)
+        {
+            for (int32_t i = 1; i < 7; ++i)
+                outPalette[i + 1] = ((7 - i) * alpha0 + i * alpha1 + 3) / 7;
+        }
+        else
+        {
+            for (int32_t i = 1; i < 5; ++i)
+                outPalette[i + 1] = ((5 - i) * alpha0 + i * alpha1 + 2) / 5;
+            outPalette[6] = 0;
+            outPalette[7] = 255;
+        }
+    }
+
+    uint32_t computeAlphaIndices(const uint8_t* alphas, uint8_t alpha0, uint8_t alpha1, uint64_t& outBitmap)
+    {
+        int32_t palette[8];
+        computeAlphaPalette(alpha0, alpha1, palette);
+
+        uint32_t error = 0;
+        outBitmap = 0;
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        {
+            int32_t minDistance = std::numeric_limits<int32_t>::max();
+            uint64_t minPaletteIdx = 0;
+            for (uint32_t paletteIdx = 0; paletteIdx < 8; ++paletteIdx)
+            {
+                // Written to be compiled without branches
+                const int32_t distance = std::abs(palette[paletteIdx] - alphas[texelIdx]);
+                const bool isCloser = distance < minDistance;
+                minDistance = isCloser ? distance : minDistance;
+                minPaletteIdx = isCloser ? paletteIdx : minPaletteIdx;
+            }
+            error += static_cast<uint32_t>(minDistance * minDistance);
+            outBitmap |= minPaletteIdx << (texelIdx * 3);
+        }
+
+        return error;
+    }
+
+    // Also used for BC4 blocks which store the red channel the same way
+    void compressAlphaBlock(const RGBA8* firstTexel, uint32_t rowPitch, uint32_t channelIdx, Wolf::ImageCompression::Quality quality, uint8_t (&outAlphas)[2], uint8_t (&outBitmap)[6])
+    {
+        uint8_t alphas[16];
+        uint8_t minAlpha = 255, maxAlpha = 0;
+        uint8_t minInnerAlpha = 255, maxInnerAlpha = 0; // without 0 and 255
+        for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+        {
+            const uint8_t alpha = firstTexel[texelIdx % 4 + (texelIdx / 4) * rowPitch][channelIdx];
+            alphas[texelIdx] = alpha;
+
+            minAlpha = std::min(minAlpha, alpha);
+            maxAlpha = std::max(maxAlpha, alpha);
+            if (alpha != 0 && alpha != 255)
+            {
+                minInnerAlpha = std::min(minInnerAlpha, alpha);
+                maxInnerAlpha = std::max(maxInnerAlpha, alpha);
+            }
+        }
+
+        uint8_t alpha0 = maxAlpha;
+        uint8_t alpha1 = minAlpha;
+        uint64_t bitmap;
+        const uint32_t error = computeAlphaIndices(alphas, alpha0, alpha1, bitmap);
+
+        // Exact 0 and 255 help blocks mixing opaque, transparent and intermediate texels
+        if (quality == Wolf::ImageCompression::Quality::HIGH && error > 0)
+        {
+            if (minInnerAlpha > maxInnerAlpha)
+                minInnerAlpha = maxInnerAlpha = 0;
+
+            uint64_t innerBitmap;
+            if (computeAlphaIndices(alphas, minInnerAlpha, maxInnerAlpha, innerBitmap) < error)
+            {
+                alpha0 = minInnerAlpha;
+                alpha1 = maxInnerAlpha;
+                bitmap = innerBitmap;
+            }
+        }
+
+        outAlphas[0] = alpha0;
+        outAlphas[1] = alpha1;
+        for (uint32_t i = 0; i < 6; ++i)
+            outBitmap[i] = static_cast<uint8_t>(bitmap >> (i * 8));
+    }
+
+    // Blocks are read in rows, texels outside of the image are dropped
+    template <typename BlockType, typename PixelType, typename DecodeFunction>
+    void uncompressBlocks(const unsigned char* data, Wolf::Extent2D extent, std::vector<PixelType>& outPixels, const DecodeFunction& decodeBlock)
+    {
+        const uint32_t blockCountX = (extent.width + 3) / 4;
+        const uint32_t blockCountY = (extent.height + 3) / 4;
+
+        outPixels.resize(static_cast<size_t>(extent.width) * extent.height);
+
+        for (uint32_t blockY = 0; blockY < blockCountY; ++blockY)
+        {
+            for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+            {
+                BlockType block;
+                memcpy(&block, data + (static_cast<size_t>(blockY) * blockCountX + blockX) * sizeof(BlockType), sizeof(BlockType));
+
+                PixelType texels[16];
+                decodeBlock(block, texels);
+
+                for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+                {
+                    const uint32_t x = blockX * 4 + texelIdx % 4;
+                    const uint32_t y = blockY * 4 + texelIdx / 4;
+                    if (x < extent.width && y < extent.height)
+                        outPixels[x + static_cast<size_t>(y) * extent.width] = texels[texelIdx];
+                }
+            }
+        }
+    }
+
+    // Tiles are the parallel chunks so cancellation and progress are checked at tile granularity
+    bool compressBlockRowsInTiles(uint32_t blockRowCount, const Wolf::ImageCompression::TiledCompressionInfo& info, const std::function<void(uint32_t blockY)>& compressBlockRow)
+    {
+        const uint32_t blockRowCountPerTile = std::max(info.blockRowCountPerTile, 1u);
+        const uint32_t tileCount = (blockRowCount + blockRowCountPerTile - 1) / blockRowCountPerTile;
+
+        std::atomic<bool> cancelled = false;
+        std::mutex progressMutex;
+        uint32_t compressedBlockRowCount = 0;
+
+        Wolf::parallelForRanges(tileCount, [&](uint32_t tileIdx)
+        {
+            if (cancelled.load(std::memory_order_relaxed))
+                return;
+            if (info.cancelRequested && info.cancelRequested->load(std::memory_order_relaxed))
+            {
+                cancelled.store(true, std::memory_order_relaxed);
+                return;
+            }
+
+            const uint32_t firstBlockY = tileIdx * blockRowCountPerTile;
+            const uint32_t lastBlockY = std::min(firstBlockY + blockRowCountPerTile, blockRowCount);
+            for (uint32_t blockY = firstBlockY; blockY < lastBlockY; ++blockY)
+            {
+                compressBlockRow(blockY);
+            }
+
+            if (info.progressCallback)
+            {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                compressedBlockRowCount += lastBlockY - firstBlockY;
+                info.progressCallback(compressedBlockRowCount, blockRowCount);
+            }
+        });
+
+        return !cancelled.load(std::memory_order_relaxed);
+    }
+
+    Wolf::ImageCompression::TiledCompressionInfo computeTiledCompressionInfo(Wolf::ImageCompression::Quality quality)
+    {
+        Wolf::ImageCompression::TiledCompressionInfo info;
+        info.quality = quality;
+        return info;
+    }
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC1>(const Extent3D& extent, const std::vector<RGBA32F>& pixels, std::vector<Wolf::ImageCompression::BC1>& outBlocks)
+Wolf::ImageCompression::InstructionSet Wolf::ImageCompression::getInstructionSet()
 {
-    Debug::sendCriticalError("Can't compress to BC1 with RGBA32F pixels");
+    return g_instructionSet.load(std::memory_order_relaxed);
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC1>(const Extent3D& extent, const std::vector<RGBA16F>& pixels, std::vector<Wolf::ImageCompression::BC1>& outBlocks)
+bool Wolf::ImageCompression::setInstructionSet(InstructionSet instructionSet)
 {
-    Debug::sendCriticalError("Can't compress to BC1 with RGBA16F pixels");
+#if defined(IMAGE_COMPRESSION_AVX2)
+    const bool isSupported = instructionSet == InstructionSet::BASELINE || isAVX2Supported();
+#else
+    const bool isSupported = instructionSet == InstructionSet::BASELINE;
+#endif
+    if (!isSupported)
+    {
+        Debug::sendWarning("Instruction set isn't supported by the CPU, compression keeps the current one");
+        return false;
+    }
+
+    g_instructionSet.store(instructionSet, std::memory_order_relaxed);
+    return true;
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC3>(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<Wolf::ImageCompression::BC3>& outBlocks)
+uint64_t Wolf::ImageCompression::BC5::BC5Channel::toUInt64() const
 {
-    compressBC3(extent, pixels, outBlocks);
+    return bitmap;
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC3>(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<Wolf::ImageCompression::BC3>& outBlocks)
+template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::RGBA8>(const Extent3D&, const std::vector<RGBA8>&, std::vector<Wolf::ImageCompression::RGBA8>&, Quality)
 {
-    Debug::sendCriticalError("Can't compress to BC3 with RG32F pixels");
+    // Nothing to do
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC3>(const Extent3D& extent, const std::vector<RGBA32F>& pixels, std::vector<Wolf::ImageCompression::BC3>& outBlocks)
+template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC1>(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<Wolf::ImageCompression::BC1>& outBlocks, Quality quality)
 {
-    Debug::sendCriticalError("Can't compress to BC3 with RGBA32F pixels");
+    compressBC1(extent, pixels, outBlocks, quality);
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC3>(const Extent3D& extent, const std::vector<RGBA16F>& pixels, std::vector<Wolf::ImageCompression::BC3>& outBlocks)
+template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC3>(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<Wolf::ImageCompression::BC3>& outBlocks, Quality quality)
 {
-    Debug::sendCriticalError("Can't compress to BC3 with RGBA16F pixels");
+    compressBC3(extent, pixels, outBlocks, quality);
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC5>(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<Wolf::ImageCompression::BC5>& outBlocks)
+template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC5>(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<Wolf::ImageCompression::BC5>& outBlocks, Quality)
 {
     compressBC5(extent, pixels, outBlocks);
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC5>(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<Wolf::ImageCompression::BC5>& outBlocks)
+template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC4>(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<Wolf::ImageCompression::BC4>& outBlocks, Quality quality)
 {
-	Debug::sendCriticalError("Can't compress to BC5 with RGBA8 pixels");
+    compressBC4(extent, pixels, outBlocks, quality);
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC5>(const Extent3D& extent, const std::vector<RGBA32F>& pixels, std::vector<Wolf::ImageCompression::BC5>& outBlocks)
+template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC6H>(const Extent3D& extent, const std::vector<RGBA32F>& pixels, std::vector<Wolf::ImageCompression::BC6H>& outBlocks, Quality quality)
 {
-    Debug::sendCriticalError("Can't compress to BC5 with RGBA32F pixels");
+    compressBC6H(extent, pixels, outBlocks, quality);
 }
 
-template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC5>(const Extent3D& extent, const std::vector<RGBA16F>& pixels, std::vector<Wolf::ImageCompression::BC5>& outBlocks)
+template<> void Wolf::ImageCompression::compress<Wolf::ImageCompression::BC7>(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<Wolf::ImageCompression::BC7>& outBlocks, Quality quality)
 {
-    Debug::sendCriticalError("Can't compress to BC5 with RGBA16F pixels");
+    compressBC7(extent, pixels, outBlocks, quality);
 }
 
 uint8_t Wolf::ImageCompression::RGBA8::mergeColor(uint8_t c00, uint8_t c01, uint8_t c10, uint8_t c11)
@@ -132,160 +1212,100 @@ Wolf::ImageCompression::RG32F Wolf::ImageCompression::RG32F::mergeBlock(const RG
     return { r, g };
 }
 
-void Wolf::ImageCompression::compressBC1(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC1>& outBlocks)
+void Wolf::ImageCompression::compressBC1(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC1>& outBlocks, Quality quality)
 {
-	const uint32_t blockCountX = extent.width / 4;
-	const uint32_t blockCountY = extent.height / 4;
-
-    outBlocks.resize(static_cast<size_t>(blockCountX) * blockCountY);
-
-    for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
-    {
-		for (uint32_t blockY = 0; blockY < blockCountY; ++blockY)
-		{
-            RGBA8 min(255, 255, 255, 255), max(0, 0, 0, 255);
-            for (uint32_t pixelX = blockX * 4; pixelX < (blockX + 1) * 4; ++pixelX)
-            {
-                for (uint32_t pixelY = blockY * 4; pixelY < (blockY + 1) * 4; ++pixelY)
-                {
-                    const RGBA8& pixel = pixels[pixelX + pixelY * extent.width];
-                    for (uint32_t channel = 0; channel < 3; ++channel)
-                    {
-                        if (pixel[channel] < min[channel])
-                            min[channel] = pixel[channel];
-
-                        if (pixel[channel] > max[channel])
-                            max[channel] = pixel[channel];
-                    }
-                }
-            }
-
-            BC1& block = outBlocks[blockX + blockY * blockCountX];
-            block = BC1{};
-
-            block.rgb[0] |= (static_cast<uint16_t>(static_cast<float>(min.r) * (31.0f / 255.0f)) & 0x1f) << 11;
-            block.rgb[0] |= (static_cast<uint16_t>(static_cast<float>(min.g) * (63.0f / 255.0f)) & 0x3f) << 5;
-            block.rgb[0] |= (static_cast<uint16_t>(static_cast<float>(min.b) * (31.0f / 255.0f)) & 0x1f) << 0;
+    compressTiled(extent, pixels, outBlocks, computeTiledCompressionInfo(quality));
+}
 
-            block.rgb[1] |= (static_cast<uint16_t>(static_cast<float>(max.r) * (31.0f / 255.0f)) & 0x1f) << 11;
-            block.rgb[1] |= (static_cast<uint16_t>(static_cast<float>(max.g) * (63.0f / 255.0f)) & 0x3f) << 5;
-            block.rgb[1] |= (static_cast<uint16_t>(static_cast<float>(max.b) * (31.0f / 255.0f)) & 0x1f) << 0;
+void Wolf::ImageCompression::compressBC3(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC3>& outBlocks, Quality quality)
+{
+    compressTiled(extent, pixels, outBlocks, computeTiledCompressionInfo(quality));
+}
 
-            RGBA8 refs[4];
-            refs[0] = min;
-            refs[1] = max;
-            refs[2] = RGBA8::mixColors(min, max, 1.0f / 2.0f /* 1.0f / 3.0f */);
-            //refs[3] = RGBA8::mixColors(min, max, 2.0f / 3.0f);
-            refs[3] = RGBA8(0, 0, 0, 255);
+void Wolf::ImageCompression::compressBC4(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC4>& outBlocks, Quality quality)
+{
+    compressTiled(extent, pixels, outBlocks, computeTiledCompressionInfo(quality));
+}
 
-            for (uint32_t pixelX = blockX * 4; pixelX < (blockX + 1) * 4; ++pixelX)
-            {
-                for (uint32_t pixelY = blockY * 4; pixelY < (blockY + 1) * 4; ++pixelY)
-                {
-                    const RGBA8& pixel = pixels[pixelX + pixelY * extent.width];
-                    float minDistance = 1'000;
-                    uint8_t minRefIdx = 0;
-                    for (uint32_t refIdx = 0; refIdx < 4; ++refIdx)
-                    {
-	                    const float distance = pixel.computeDistanceWithRef(refs[refIdx]);
-                        if (distance < minDistance)
-                        {
-                            minDistance = distance;
-                            minRefIdx = static_cast<uint8_t>(refIdx);
-                        }
-                    }
-                    
-                    block.bitmap |= (minRefIdx & 3) << (((pixelX - blockX * 4) + (pixelY - blockY * 4) * 4) * 2);
-                }
-            }
-		}
-    }
+void Wolf::ImageCompression::compressBC5(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<BC5>& outBlocks)
+{
+    compressTiled(extent, pixels, outBlocks, TiledCompressionInfo());
 }
 
-void Wolf::ImageCompression::compressBC3(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC3>& outBlocks)
+void Wolf::ImageCompression::compressBC6H(const Extent3D& extent, const std::vector<RGBA32F>& pixels, std::vector<BC6H>& outBlocks, Quality quality)
 {
-    std::vector<BC1> bc1Blocks;
-    compressBC1(extent, pixels, bc1Blocks);
+    compressTiled(extent, pixels, outBlocks, computeTiledCompressionInfo(quality));
+}
 
-    outBlocks.resize(bc1Blocks.size());
+void Wolf::ImageCompression::compressBC7(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC7>& outBlocks, Quality quality)
+{
+    compressTiled(extent, pixels, outBlocks, computeTiledCompressionInfo(quality));
+}
 
+bool Wolf::ImageCompression::compressTiled(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC1>& outBlocks, const TiledCompressionInfo& info)
+{
     const uint32_t blockCountX = extent.width / 4;
     const uint32_t blockCountY = extent.height / 4;
 
-    for (uint32_t blockIdx = 0; blockIdx < outBlocks.size(); ++blockIdx)
-    {
-        uint32_t blockX = blockIdx % blockCountX;
-        uint32_t blockY = blockIdx / blockCountX;
-
-        uint32_t firstPixelX = blockX * 4;
-        uint32_t firstPixelY = blockY * 4;
+    outBlocks.resize(static_cast<size_t>(blockCountX) * blockCountY);
 
-        uint8_t minAlpha = 255, maxAlpha = 0;
-        for (uint32_t alphaIdx = 0; alphaIdx < 16; ++alphaIdx)
-        {
-            uint32_t pixelX = firstPixelX + alphaIdx % 4;
-            uint32_t pixelY = firstPixelY + alphaIdx / 4;
+    return compressBlockRowsInTiles(blockCountY, info, [&](uint32_t blockY)
+    {
+        const RGBA8* firstTexel = &pixels[static_cast<size_t>(blockY) * 4 * extent.width];
+        BC1* rowBlocks = &outBlocks[static_cast<size_t>(blockY) * blockCountX];
+        compressColorBlockRow(firstTexel, extent.width, blockCountX, info.quality, [rowBlocks](uint32_t blockX) -> BC1& { return rowBlocks[blockX]; });
+    });
+}
 
-            uint8_t alpha = pixels[pixelX + pixelY * extent.width].a;
+bool Wolf::ImageCompression::compressTiled(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC3>& outBlocks, const TiledCompressionInfo& info)
+{
+    const uint32_t blockCountX = extent.width / 4;
+    const uint32_t blockCountY = extent.height / 4;
 
-            if (alpha < minAlpha)
-                minAlpha = alpha;
-            if (alpha > maxAlpha)
-                maxAlpha = alpha;
-        }
+    outBlocks.resize(static_cast<size_t>(blockCountX) * blockCountY);
 
-        uint8_t refs[8];
-        refs[0] = maxAlpha;
-        refs[1] = minAlpha;
-        for (uint32_t refIdx = 2; refIdx < 8; ++refIdx)
+    return compressBlockRowsInTiles(blockCountY, info, [&](uint32_t blockY)
+    {
+        const RGBA8* firstTexel = &pixels[static_cast<size_t>(blockY) * 4 * extent.width];
+        BC3* rowBlocks = &outBlocks[static_cast<size_t>(blockY) * blockCountX];
+        for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
         {
-            refs[refIdx] = glm::mix(maxAlpha, minAlpha, static_cast<float>(refIdx - 1) / 7);
+            BC3& block = rowBlocks[blockX];
+            compressAlphaBlock(firstTexel + blockX * 4, extent.width, 3, info.quality, block.alpha, block.bitmap);
         }
+        compressColorBlockRow(firstTexel, extent.width, blockCountX, info.quality, [rowBlocks](uint32_t blockX) -> BC1& { return rowBlocks[blockX].bc1; });
+    });
+}
 
-        uint64_t alphaBitmap = 0;
-        for (uint32_t alphaIdx = 0; alphaIdx < 16; ++alphaIdx)
-        {
-            uint32_t pixelX = firstPixelX + alphaIdx % 4;
-            uint32_t pixelY = firstPixelY + alphaIdx / 4;
-
-            uint8_t alpha = pixels[pixelX + pixelY * extent.width].a;
-
-            float minDistance = 1'000;
-            uint64_t minRefIdx = 0;
-            for (uint32_t refIdx = 0; refIdx < 8; ++refIdx)
-            {
-                const float distance = glm::abs(static_cast<float>(refs[refIdx] - alpha));
-                if (distance < minDistance)
-                {
-                    minDistance = distance;
-                    minRefIdx = static_cast<uint64_t>(refIdx);
-                }
-            }
+bool Wolf::ImageCompression::compressTiled(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC4>& outBlocks, const TiledCompressionInfo& info)
+{
+    const uint32_t blockCountX = extent.width / 4;
+    const uint32_t blockCountY = extent.height / 4;
 
-            alphaBitmap |= (minRefIdx & 0b111) << alphaIdx * 3;
-        }
+    outBlocks.resize(static_cast<size_t>(blockCountX) * blockCountY);
 
-        outBlocks[blockIdx].alpha[0] = maxAlpha;
-        outBlocks[blockIdx].alpha[1] = minAlpha;
-        for (uint32_t i = 0; i < 6; ++i)
+    return compressBlockRowsInTiles(blockCountY, info, [&](uint32_t blockY)
+    {
+        for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
         {
-        	memcpy(&outBlocks[blockIdx].bitmap[i], reinterpret_cast<uint8_t*>(&alphaBitmap) + i , 1);
-        }
+            const RGBA8* firstTexel = &pixels[blockX * 4 + static_cast<size_t>(blockY) * 4 * extent.width];
+            BC4& block = outBlocks[blockX + blockY * blockCountX];
 
-        outBlocks[blockIdx].bc1 = bc1Blocks[blockIdx];
-    }
+            compressAlphaBlock(firstTexel, extent.width, 0, info.quality, block.refs, block.bitmap);
+        }
+    });
 }
 
-void Wolf::ImageCompression::compressBC5(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<BC5>& outBlocks)
+bool Wolf::ImageCompression::compressTiled(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<BC5>& outBlocks, const TiledCompressionInfo& info)
 {
     const uint32_t blockCountX = extent.width / 4;
     const uint32_t blockCountY = extent.height / 4;
 
     outBlocks.resize(static_cast<size_t>(blockCountX) * blockCountY);
 
-    for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+    return compressBlockRowsInTiles(blockCountY, info, [&](uint32_t blockY)
     {
-        for (uint32_t blockY = 0; blockY < blockCountY; ++blockY)
+        for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
         {
             float minR(1.0f), maxR(0.0f), minG(1.0f), maxG(0.0f);
             for (uint32_t pixelX = blockX * 4; pixelX < (blockX + 1) * 4; ++pixelX)
@@ -363,11 +1383,68 @@ void Wolf::ImageCompression::compressBC5(const Extent3D& extent, const std::vect
             computeChannel(0);
             computeChannel(1);
         }
-    }
+    });
+}
+
+bool Wolf::ImageCompression::compressTiled(const Extent3D& extent, const std::vector<RGBA32F>& pixels, std::vector<BC6H>& outBlocks, const TiledCompressionInfo& info)
+{
+    const uint32_t blockCountX = extent.width / 4;
+    const uint32_t blockCountY = extent.height / 4;
+
+    outBlocks.resize(static_cast<size_t>(blockCountX) * blockCountY);
+
+    return compressBlockRowsInTiles(blockCountY, info, [&](uint32_t blockY)
+    {
+        for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+        {
+            const RGBA32F* firstTexel = &pixels[blockX * 4 + static_cast<size_t>(blockY) * 4 * extent.width];
+            encodeBC6HBlock(firstTexel, extent.width, info.quality, outBlocks[blockX + blockY * blockCountX]);
+        }
+    });
+}
+
+bool Wolf::ImageCompression::compressTiled(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC7>& outBlocks, const TiledCompressionInfo& info)
+{
+    const uint32_t blockCountX = extent.width / 4;
+    const uint32_t blockCountY = extent.height / 4;
+
+    outBlocks.resize(static_cast<size_t>(blockCountX) * blockCountY);
+
+    return compressBlockRowsInTiles(blockCountY, info, [&](uint32_t blockY)
+    {
+        for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+        {
+            const RGBA8* firstTexel = &pixels[blockX * 4 + static_cast<size_t>(blockY) * 4 * extent.width];
+            encodeBC7Block(firstTexel, extent.width, info.quality, outBlocks[blockX + blockY * blockCountX]);
+        }
+    });
 }
 
 void Wolf::ImageCompression::uncompressImage(Compression compression, const unsigned char* data, Extent2D extent, std::vector<RGBA8>& outPixels)
 {
+    if (compression == Compression::BC4)
+    {
+        // Sampled as (red, 0, 0, 1) by the GPU
+        uncompressBlocks<BC4>(data, extent, outPixels, [](const BC4& block, RGBA8* outTexels)
+        {
+            int32_t palette[8];
+            computeAlphaPalette(block.refs[0], block.refs[1], palette);
+
+            uint64_t bitmap = 0;
+            for (uint32_t i = 0; i < 6; ++i)
+                bitmap |= static_cast<uint64_t>(block.bitmap[i]) << (i * 8);
+
+            for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+                outTexels[texelIdx] = RGBA8(static_cast<uint8_t>(palette[(bitmap >> (texelIdx * 3)) & 7]), 0, 0, 255);
+        });
+        return;
+    }
+    if (compression == Compression::BC7)
+    {
+        uncompressBlocks<BC7>(data, extent, outPixels, [](const BC7& block, RGBA8* outTexels) { decodeBC7Block(block, outTexels); });
+        return;
+    }
+
     if (compression != Compression::BC1 && compression != Compression::BC3)
     {
         Debug::sendError("Compression type not supported for image uncompressing");
@@ -656,3 +1733,40 @@ void Wolf::ImageCompression::uncompressImage(Compression compression, const unsi
         }
     }
 }
+
+void Wolf::ImageCompression::uncompressImage(Compression compression, const unsigned char* data, Extent2D extent, std::vector<RGBA16F>& outPixels)
+{
+    if (compression != Compression::BC6H)
+    {
+        Debug::sendError("Compression type not supported for image uncompressing");
+        return;
+    }
+
+    uncompressBlocks<BC6H>(data, extent, outPixels, [](const BC6H& block, RGBA16F* outTexels) { decodeBC6HBlock(block, outTexels); });
+}
+
+uint32_t Wolf::ImageCompression::getBlockSize(Compression compression)
+{
+    switch (compression)
+    {
+        case Compression::NO_COMPRESSION:
+            return 16 * sizeof(RGBA8);
+        case Compression::BC1:
+            return sizeof(BC1);
+        case Compression::BC2:
+            return sizeof(BC2);
+        case Compression::BC3:
+            return sizeof(BC3);
+        case Compression::BC4:
+            return sizeof(BC4);
+        case Compression::BC5:
+            return sizeof(BC5);
+        case Compression::BC6H:
+            return sizeof(BC6H);
+        case Compression::BC7:
+            return sizeof(BC7);
+        default:
+            Debug::sendError("Unsupported compression");
+            return 0;
+    }
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <glm/detail/func_common.hpp>
 #include <glm/detail/func_geometric.hpp>
+#include <type_traits>
 #include <vector>
 #include <vulkan/vulkan_core.h>
 
@@ -37,6 +40,13 @@ namespace Wolf
         };
         static_assert(sizeof(BC3) == 16, "Mismatch block size");
 
+        struct BC4
+        {
+            uint8_t     refs[2];    // red values
+            uint8_t     bitmap[6];  // 3bpp red bitmap
+        };
+        static_assert(sizeof(BC4) == 8, "Mismatch block size");
+
         struct BC5
         {
 #pragma pack(push, 1) 
@@ -65,13 +75,29 @@ namespace Wolf
         };
         static_assert(sizeof(BC5) == 16, "Mismatch block size");
 
+        // Bit streams, see BPTCCodec.h
+        struct BC6H
+        {
+            uint8_t     data[16];
+        };
+        static_assert(sizeof(BC6H) == 16, "Mismatch block size");
+
+        struct BC7
+        {
+            uint8_t     data[16];
+        };
+        static_assert(sizeof(BC7) == 16, "Mismatch block size");
+
         enum class Compression
         {
             NO_COMPRESSION,
             BC1,
             BC2,
             BC3,
-            BC5
+            BC4,
+            BC5,
+            BC6H,
+            BC7
         };
 
         struct RGBA8
@@ -171,14 +197,64 @@ namespace Wolf
             static RG32F mergeBlock(const RG32F& block00, const RG32F& block01, const RG32F& block10, const RG32F& block11);
         };
 
+        enum class Quality
+        {
+            FAST, // range fit: endpoints are the extreme colors along the principal axis of the block
+            HIGH  // cluster fit: endpoints are solved by least squares for every ordering of the block colors, also tries both BC3 alpha modes
+        };
+
+        // Instruction sets of the BC1 and BC3 color encoding, the best one supported by the CPU is selected at startup.
+        // AVX2 encodes two blocks at once with the FAST quality, all instruction sets give the same blocks
+        enum class InstructionSet
+        {
+            BASELINE, // SSE2 on x64, NEON on ARM64, scalar elsewhere
+            AVX2
+        };
+        [[nodiscard]] static InstructionSet getInstructionSet();
+        // Returns false and keeps the current instruction set when the CPU doesn't support it
+        static bool setInstructionSet(InstructionSet instructionSet);
+
+        // Block formats and the pixels they are compressed from, other pairs don't compile
         template <typename CompressionType, typename PixelType>
-        static void compress(const Extent3D& extent, const std::vector<PixelType>& pixels, std::vector<CompressionType>& outBlocks);
+        static constexpr bool isCompressionSupported = (std::is_same_v<PixelType, RGBA8> && (std::is_same_v<CompressionType, RGBA8> || std::is_same_v<CompressionType, BC1> ||
+            std::is_same_v<CompressionType, BC3> || std::is_same_v<CompressionType, BC4> || std::is_same_v<CompressionType, BC7>)) ||
+            (std::is_same_v<PixelType, RG32F> && std::is_same_v<CompressionType, BC5>) || (std::is_same_v<PixelType, RGBA32F> && std::is_same_v<CompressionType, BC6H>);
+
+        template <typename CompressionType, typename PixelType> requires isCompressionSupported<CompressionType, PixelType>
+        static void compress(const Extent3D& extent, const std::vector<PixelType>& pixels, std::vector<CompressionType>& outBlocks, Quality quality = Quality::FAST);
 
-        static void compressBC1(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC1>& outBlocks);
-        static void compressBC3(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC3>& outBlocks);
+        static void compressBC1(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC1>& outBlocks, Quality quality = Quality::FAST);
+        static void compressBC3(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC3>& outBlocks, Quality quality = Quality::FAST);
+        static void compressBC4(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC4>& outBlocks, Quality quality = Quality::FAST); // red channel
         static void compressBC5(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<BC5>& outBlocks);
+        static void compressBC6H(const Extent3D& extent, const std::vector<RGBA32F>& pixels, std::vector<BC6H>& outBlocks, Quality quality = Quality::FAST); // unsigned
+        static void compressBC7(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC7>& outBlocks, Quality quality = Quality::FAST);
+
+        // Tiles of block rows are compressed in parallel by the engine workers. Each block only depends on its own texels,
+        // the output is the same whatever the thread count
+        static constexpr uint32_t DEFAULT_BLOCK_ROW_COUNT_PER_TILE = 4;
+        struct TiledCompressionInfo
+        {
+            Quality quality = Quality::FAST; // ignored by BC5
+            uint32_t blockRowCountPerTile = DEFAULT_BLOCK_ROW_COUNT_PER_TILE;
+
+            // Checked before each tile, tiles already started are completed
+            const std::atomic<bool>* cancelRequested = nullptr;
+            // Called by the worker which completed a tile. Calls never overlap and compressedBlockRowCount always increases
+            std::function<void(uint32_t compressedBlockRowCount, uint32_t blockRowCount)> progressCallback;
+        };
+        // Return false when cancelled, outBlocks is then only partially written
+        static bool compressTiled(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC1>& outBlocks, const TiledCompressionInfo& info);
+        static bool compressTiled(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC3>& outBlocks, const TiledCompressionInfo& info);
+        static bool compressTiled(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC4>& outBlocks, const TiledCompressionInfo& info);
+        static bool compressTiled(const Extent3D& extent, const std::vector<RG32F>& pixels, std::vector<BC5>& outBlocks, const TiledCompressionInfo& info);
+        static bool compressTiled(const Extent3D& extent, const std::vector<RGBA32F>& pixels, std::vector<BC6H>& outBlocks, const TiledCompressionInfo& info);
+        static bool compressTiled(const Extent3D& extent, const std::vector<RGBA8>& pixels, std::vector<BC7>& outBlocks, const TiledCompressionInfo& info);
 
         static void uncompressImage(Compression compression, const unsigned char* data, Extent2D extent, std::vector<RGBA8>& outPixels);
         static void uncompressImage(Compression compression, const unsigned char* data, Extent2D extent, std::vector<RG8>& outPixels);
+        static void uncompressImage(Compression compression, const unsigned char* data, Extent2D extent, std::vector<RGBA16F>& outPixels); // BC6H
+
+        [[nodiscard]] static uint32_t getBlockSize(Compression compression);
     };
 }
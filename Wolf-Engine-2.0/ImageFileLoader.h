@@ -1,40 +1,54 @@
 #pragma once
 
+#include <memory>
+#include <span>
 #include <string>
 
 #include <Formats.h>
 
+#include "DDSFile.h"
 #include "ImageCompression.h"
+#include "KTX2File.h"
 
 namespace Wolf
 {
 	class ImageFileLoader
 	{
 	public:
-		ImageFileLoader(const std::string& fullFilePath, bool loadFloat = false);
+		// Parsed .cube LUTs are saved next to the source file when useBinaryCache is set, and loaded from there while the source content is unchanged
+		ImageFileLoader(const std::string& fullFilePath, bool loadFloat = false, bool useBinaryCache = false);
 		ImageFileLoader(const ImageFileLoader&) = delete;
 		~ImageFileLoader();
 
-		[[nodiscard]] unsigned char* getPixels() const { return m_pixels; }
+		// Bytes held once loaded, from the file header only. DDS, KTX2 and .cube files count for their file size. Returns 0 when the header can't be read
+		[[nodiscard]] static uint64_t estimateByteCount(const std::string& fullFilePath, bool loadFloat = false);
+
+		[[nodiscard]] const unsigned char* getPixels() const;
 		[[nodiscard]] uint32_t getWidth() const { return m_width; }
 		[[nodiscard]] uint32_t getHeight() const { return m_height; }
 		[[nodiscard]] uint32_t getDepth() const { return m_depth; }
 		[[nodiscard]] uint32_t getChannelCount() const { return m_channels; }
 		[[nodiscard]] ImageCompression::Compression getCompression() const { return m_compression; }
 		[[nodiscard]] Format getFormat() const { return m_format; }
-		[[nodiscard]] const std::vector<std::vector<uint8_t>>& getMipPixels() const { return m_mipPixels; }
+		// DDS and KTX2 only, level 0 is the same as getPixels(). Layers and faces are accessible through the DDS or KTX2 file
+		[[nodiscard]] uint32_t getMipLevelCount() const;
+		[[nodiscard]] std::span<const uint8_t> getMipPixels(uint32_t mipLevel) const;
+		[[nodiscard]] const DDSFile* getDDSFile() const { return m_ddsFile.get(); }
+		[[nodiscard]] const KTX2File* getKTX2File() const { return m_ktx2File.get(); }
 
 	private:
 		void loadDDS(const std::string& fullFilePath);
-		bool loadCube(const std::string& fullFilePath);
+		void loadKTX2(const std::string& fullFilePath);
+		bool loadCube(const std::string& fullFilePath, bool useBinaryCache);
+		bool loadCubeBinaryCache(const std::string& cacheFilename, uint64_t sourceHash, uint64_t sourceSize);
 
 		unsigned char* m_pixels = nullptr;
 		uint32_t m_width, m_height, m_channels;
 		uint32_t m_depth = 1;
 		ImageCompression::Compression m_compression = ImageCompression::Compression::NO_COMPRESSION;
 
-		// DDS related
-		std::vector<std::vector<uint8_t>> m_mipPixels;
 		Format m_format = Format::UNDEFINED;
+		std::unique_ptr<DDSFile> m_ddsFile;
+		std::unique_ptr<KTX2File> m_ktx2File;
 	};
 }
@@ -0,0 +1,477 @@
+#include "JSONPullReader.h"
+
+#include <charconv>
+
+#include "Debug.h"
+#include "MappedFile.h"
+#include "ProfilerCommon.h"
+
+Wolf::JSONPullReader::JSONPullReader(const FileReadInfo& fileReadInfo) : m_file(new MappedFile(fileReadInfo.filename))
+{
+	m_begin = m_cursor = m_end = nullptr;
+	if (!m_file->isValid())
+	{
+		sendError("Can't open JSON file " + fileReadInfo.filename);
+		return;
+	}
+
+	const std::string_view jsonData = m_file->getText();
+	m_begin = m_cursor = jsonData.data();
+	m_end = jsonData.data() + jsonData.size();
+	skipByteOrderMark();
+}
+
+Wolf::JSONPullReader::JSONPullReader(std::string_view jsonData) : m_begin(jsonData.data()), m_cursor(jsonData.data()), m_end(jsonData.data() + jsonData.size())
+{
+	skipByteOrderMark();
+}
+
+Wolf::JSONPullReader::~JSONPullReader() = default;
+
+Wolf::JSONPullReader::Event Wolf::JSONPullReader::next()
+{
+	skipWhitespaces();
+
+	switch (m_state)
+	{
+		case State::ROOT:
+		case State::VALUE:
+			return readValue();
+		case State::VALUE_OR_END:
+			if (m_cursor != m_end && *m_cursor == ']')
+				return endContainer(']');
+			return readValue();
+		case State::PROPERTY_NAME_OR_END:
+			if (m_cursor != m_end && *m_cursor == '}')
+				return endContainer('}');
+			if (m_cursor == m_end || *m_cursor != '"')
+			{
+				sendError("JSON property name expected");
+				return Event::ERROR;
+			}
+			if (!readString())
+				return Event::ERROR;
+
+			skipWhitespaces();
+			if (m_cursor == m_end || *m_cursor != ':')
+			{
+				sendError("JSON ':' expected after property " + std::string(m_string));
+				return Event::ERROR;
+			}
+			m_cursor++;
+			m_state = State::VALUE;
+			return Event::PROPERTY_NAME;
+		case State::COMMA_OR_END:
+			if (m_cursor != m_end && *m_cursor == ',')
+			{
+				// Trailing commas are accepted, the end of the container is looked for too
+				m_cursor++;
+				m_state = m_containers.back() ? State::PROPERTY_NAME_OR_END : State::VALUE_OR_END;
+				return next();
+			}
+			return endContainer(m_cursor != m_end ? *m_cursor : '\0');
+		case State::DOCUMENT_ENDED:
+			return Event::END_OF_DOCUMENT;
+		case State::ERROR:
+			break;
+	}
+
+	return Event::ERROR;
+}
+
+bool Wolf::JSONPullReader::skipValue()
+{
+	skipWhitespaces();
+
+	// Next array item
+	if (m_state == State::COMMA_OR_END && !m_containers.back() && m_cursor != m_end && *m_cursor == ',')
+	{
+		m_cursor++;
+		m_state = State::VALUE_OR_END;
+		skipWhitespaces();
+	}
+
+	const bool isValueExpected = m_state == State::ROOT || m_state == State::VALUE || (m_state == State::VALUE_OR_END && m_cursor != m_end && *m_cursor != ']');
+	if (!isValueExpected)
+	{
+		sendError("JSON no value to skip");
+		return false;
+	}
+
+	if (m_cursor != m_end && (*m_cursor == '{' || *m_cursor == '['))
+	{
+		if (!skipRaw(0))
+			return false;
+
+		onValueEnded();
+		return true;
+	}
+
+	return readValue() != Event::ERROR;
+}
+
+bool Wolf::JSONPullReader::skipContainer()
+{
+	if (m_containers.empty() || m_state == State::ERROR)
+	{
+		sendError("JSON no object or array to skip");
+		return false;
+	}
+
+	if (!skipRaw(1))
+		return false;
+
+	m_containers.pop_back();
+	onValueEnded();
+	return true;
+}
+
+void Wolf::JSONPullReader::sendError(const std::string& message)
+{
+	if (m_state == State::ERROR)
+		return;
+	m_state = State::ERROR;
+
+	// Position is only computed when there's an error
+	uint32_t line = 1;
+	const char* lineBegin = m_begin;
+	for (const char* character = m_begin; character < m_cursor; ++character)
+	{
+		if (*character == '\n')
+		{
+			line++;
+			lineBegin = character + 1;
+		}
+	}
+
+	Debug::sendError(message + " (line " + std::to_string(line) + ", column " + std::to_string(m_cursor - lineBegin + 1) + ")");
+}
+
+Wolf::JSONPullReader::Event Wolf::JSONPullReader::readValue()
+{
+	if (m_cursor == m_end)
+	{
+		sendError("JSON value expected");
+		return Event::ERROR;
+	}
+
+	switch (*m_cursor)
+	{
+		case '{':
+		case '[':
+		{
+			if (m_containers.size() >= MAX_DEPTH)
+			{
+				sendError("JSON nesting is too deep");
+				return Event::ERROR;
+			}
+
+			const bool isObject = *m_cursor++ == '{';
+			m_containers.push_back(isObject);
+			m_state = isObject ? State::PROPERTY_NAME_OR_END : State::VALUE_OR_END;
+			return isObject ? Event::BEGIN_OBJECT : Event::BEGIN_ARRAY;
+		}
+		case '"':
+			if (!readString())
+				return Event::ERROR;
+			onValueEnded();
+			return Event::STRING;
+		case 't':
+		case 'f':
+			m_bool = *m_cursor == 't';
+			if (!readLiteral(m_bool ? "true" : "false"))
+				return Event::ERROR;
+			onValueEnded();
+			return Event::BOOL;
+		case 'n':
+			if (!readLiteral("null"))
+				return Event::ERROR;
+			onValueEnded();
+			return Event::NULL_VALUE;
+		default:
+			if (!readNumber())
+				return Event::ERROR;
+			onValueEnded();
+			return Event::NUMBER;
+	}
+}
+
+Wolf::JSONPullReader::Event Wolf::JSONPullReader::endContainer(char character)
+{
+	const bool isObject = m_containers.back();
+	if (character != (isObject ? '}' : ']'))
+	{
+		sendError(isObject ? "JSON ',' or '}' expected" : "JSON ',' or ']' expected");
+		return Event::ERROR;
+	}
+
+	m_cursor++;
+	m_containers.pop_back();
+	onValueEnded();
+	return isObject ? Event::END_OBJECT : Event::END_ARRAY;
+}
+
+void Wolf::JSONPullReader::onValueEnded()
+{
+	if (!m_containers.empty())
+	{
+		m_state = State::COMMA_OR_END;
+		return;
+	}
+
+	m_state = State::DOCUMENT_ENDED;
+	skipWhitespaces();
+	if (m_cursor != m_end)
+		Debug::sendWarning("JSON content after the root value is ignored");
+}
+
+bool Wolf::JSONPullReader::readString()
+{
+	m_cursor++; // '"'
+
+	// Strings without escapes are directly referenced in the data
+	const char* stringBegin = m_cursor;
+	while (m_cursor != m_end && *m_cursor != '"' && *m_cursor != '\\' && *m_cursor != '\n')
+		m_cursor++;
+	if (m_cursor != m_end && *m_cursor == '"')
+	{
+		m_string = std::string_view(stringBegin, m_cursor++);
+		return true;
+	}
+
+	m_unescapedString.assign(stringBegin, m_cursor);
+	for (;;)
+	{
+		// Copy everything until the next quote, escape or end of line at once
+		const char* chunkBegin = m_cursor;
+		while (m_cursor != m_end && *m_cursor != '"' && *m_cursor != '\\' && *m_cursor != '\n')
+			m_cursor++;
+		m_unescapedString.append(chunkBegin, m_cursor);
+
+		if (m_cursor == m_end || *m_cursor == '\n')
+		{
+			sendError("JSON string doesn't end");
+			return false;
+		}
+
+		if (*m_cursor++ == '"')
+		{
+			m_string = m_unescapedString;
+			return true;
+		}
+
+		if (m_cursor == m_end)
+		{
+			sendError("JSON string doesn't end");
+			return false;
+		}
+
+		switch (*m_cursor++)
+		{
+			case '"': m_unescapedString.push_back('"'); break;
+			case '\\': m_unescapedString.push_back('\\'); break;
+			case '/': m_unescapedString.push_back('/'); break;
+			case 'b': m_unescapedString.push_back('\b'); break;
+			case 'f': m_unescapedString.push_back('\f'); break;
+			case 'n': m_unescapedString.push_back('\n'); break;
+			case 'r': m_unescapedString.push_back('\r'); break;
+			case 't': m_unescapedString.push_back('\t'); break;
+			case 'u':
+				if (!readUnicodeEscape())
+					return false;
+				break;
+			default:
+				sendError("JSON invalid escape sequence");
+				return false;
+		}
+	}
+}
+
+bool Wolf::JSONPullReader::readUnicodeEscape()
+{
+	uint32_t codePoint;
+	if (!readHexCodeUnit(codePoint))
+		return false;
+
+	// Surrogate pair
+	if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+	{
+		uint32_t lowSurrogate;
+		if (m_end - m_cursor < 2 || m_cursor[0] != '\\' || m_cursor[1] != 'u')
+		{
+			sendError("JSON unpaired surrogate in string");
+			return false;
+		}
+		m_cursor += 2;
+		if (!readHexCodeUnit(lowSurrogate))
+			return false;
+		if (lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+		{
+			sendError("JSON unpaired surrogate in string");
+			return false;
+		}
+
+		codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+	}
+	else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+	{
+		sendError("JSON unpaired surrogate in string");
+		return false;
+	}
+
+	// UTF-8 encoding
+	if (codePoint < 0x80)
+	{
+		m_unescapedString.push_back(static_cast<char>(codePoint));
+	}
+	else if (codePoint < 0x800)
+	{
+		m_unescapedString.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+		m_unescapedString.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else if (codePoint < 0x10000)
+	{
+		m_unescapedString.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+		m_unescapedString.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		m_unescapedString.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else
+	{
+		m_unescapedString.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+		m_unescapedString.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+		m_unescapedString.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		m_unescapedString.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+
+	return true;
+}
+
+bool Wolf::JSONPullReader::readHexCodeUnit(uint32_t& outCodeUnit)
+{
+	const std::from_chars_result result = m_end - m_cursor >= 4 ? std::from_chars(m_cursor, m_cursor + 4, outCodeUnit, 16) : std::from_chars_result{ m_cursor, std::errc::invalid_argument };
+	if (result.ec != std::errc() || result.ptr != m_cursor + 4)
+	{
+		sendError("JSON invalid unicode escape");
+		return false;
+	}
+
+	m_cursor += 4;
+	return true;
+}
+
+bool Wolf::JSONPullReader::readNumber()
+{
+	// from_chars also accepts "inf" and "nan" which aren't JSON numbers
+	const char* firstDigit = *m_cursor == '-' ? m_cursor + 1 : m_cursor;
+	if (firstDigit == m_end || *firstDigit < '0' || *firstDigit > '9')
+	{
+		sendError("JSON value expected");
+		return false;
+	}
+
+	const std::from_chars_result result = std::from_chars(m_cursor, m_end, m_number);
+	if (result.ec != std::errc())
+	{
+		sendError(result.ec == std::errc::result_out_of_range ? "JSON number is out of float range" : "JSON invalid number");
+		return false;
+	}
+
+	m_cursor = result.ptr;
+	return true;
+}
+
+bool Wolf::JSONPullReader::readLiteral(std::string_view literal)
+{
+	if (static_cast<size_t>(m_end - m_cursor) < literal.size() || std::string_view(m_cursor, literal.size()) != literal)
+	{
+		sendError("JSON value expected");
+		return false;
+	}
+
+	m_cursor += literal.size();
+	return true;
+}
+
+bool Wolf::JSONPullReader::skipRaw(uint32_t depth)
+{
+	PROFILE_FUNCTION
+
+	do
+	{
+		skipWhitespaces();
+		if (m_cursor == m_end)
+		{
+			sendError("JSON document ends inside a skipped value");
+			return false;
+		}
+
+		switch (*m_cursor++)
+		{
+			case '"':
+				while (m_cursor != m_end && *m_cursor != '"')
+				{
+					if (*m_cursor == '\\' && m_cursor + 1 != m_end)
+						m_cursor++;
+					m_cursor++;
+				}
+				if (m_cursor == m_end)
+				{
+					sendError("JSON string doesn't end");
+					return false;
+				}
+				m_cursor++;
+				break;
+			case '{':
+			case '[':
+				depth++;
+				break;
+			case '}':
+			case ']':
+				if (depth == 0)
+				{
+					m_cursor--;
+					sendError("JSON unexpected end of object or array");
+					return false;
+				}
+				depth--;
+				break;
+			default:
+				break;
+		}
+	} while (depth > 0);
+
+	return true;
+}
+
+void Wolf::JSONPullReader::skipWhitespaces()
+{
+	while (m_cursor != m_end)
+	{
+		const char character = *m_cursor;
+		if (character == ' ' || character == '\n' || character == '\r' || character == '\t')
+		{
+			m_cursor++;
+		}
+		else if (character == '/' && m_end - m_cursor >= 2 && m_cursor[1] == '/')
+		{
+			while (m_cursor != m_end && *m_cursor != '\n')
+				m_cursor++;
+		}
+		else if (character == '/' && m_end - m_cursor >= 2 && m_cursor[1] == '*')
+		{
+			const std::string_view remaining(m_cursor + 2, m_end);
+			const size_t commentEnd = remaining.find("*/");
+			m_cursor = commentEnd == std::string_view::npos ? m_end : m_cursor + 2 + commentEnd + 2;
+		}
+		else
+		{
+			return;
+		}
+	}
+}
+
+void Wolf::JSONPullReader::skipByteOrderMark()
+{
+	if (m_end - m_cursor >= 3 && static_cast<uint8_t>(m_cursor[0]) == 0xEF && static_cast<uint8_t>(m_cursor[1]) == 0xBB && static_cast<uint8_t>(m_cursor[2]) == 0xBF)
+		m_cursor += 3;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Wolf
+{
+	class MappedFile;
+
+	// Reads JSON as a sequence of events without building a tree, values can be skipped without being decoded.
+	// Same syntax as JSONReader: comments, CRLF and trailing commas are accepted
+	class JSONPullReader
+	{
+	public:
+		struct FileReadInfo
+		{
+			std::string filename;
+		};
+		explicit JSONPullReader(const FileReadInfo& fileReadInfo);
+
+		// Data must outlive the reader
+		explicit JSONPullReader(std::string_view jsonData);
+		JSONPullReader(const JSONPullReader&) = delete;
+		~JSONPullReader();
+
+		enum class Event { BEGIN_OBJECT, END_OBJECT, BEGIN_ARRAY, END_ARRAY, PROPERTY_NAME, STRING, NUMBER, BOOL, NULL_VALUE, END_OF_DOCUMENT, ERROR };
+		Event next();
+
+		// Property name or string value of the last event, valid until the next call
+		[[nodiscard]] std::string_view getString() const { return m_string; }
+		[[nodiscard]] float getNumber() const { return m_number; }
+		[[nodiscard]] bool getBool() const { return m_bool; }
+		// Count of objects and arrays containing the current position
+		[[nodiscard]] uint32_t getDepth() const { return static_cast<uint32_t>(m_containers.size()); }
+		[[nodiscard]] bool hasError() const { return m_state == State::ERROR; }
+
+		// Skips the value following a property name or the next item of an array. Skipped objects and arrays are only scanned, not validated
+		bool skipValue();
+		// Skips the rest of the object or array containing the current position, up to and including its end
+		bool skipContainer();
+
+		// Stops the reading with an error at the current position, also used for errors detected by the caller
+		void sendError(const std::string& message);
+
+	private:
+		// Objects and arrays nested deeper are rejected so recursive users can't overflow the stack
+		static constexpr uint32_t MAX_DEPTH = 256;
+
+		enum class State { ROOT, VALUE, VALUE_OR_END, PROPERTY_NAME_OR_END, COMMA_OR_END, DOCUMENT_ENDED, ERROR };
+
+		Event readValue();
+		Event endContainer(char character);
+		void onValueEnded();
+		bool readString();
+		bool readUnicodeEscape();
+		bool readHexCodeUnit(uint32_t& outCodeUnit);
+		bool readNumber();
+		bool readLiteral(std::string_view literal);
+		bool skipRaw(uint32_t depth);
+		void skipWhitespaces();
+		void skipByteOrderMark();
+
+		std::unique_ptr<MappedFile> m_file;
+		const char* m_begin;
+		const char* m_cursor;
+		const char* m_end;
+
+		State m_state = State::ROOT;
+		std::vector<bool> m_containers; // true for objects
+
+		std::string_view m_string;
+		std::string m_unescapedString; // only used by strings containing escapes
+		float m_number = 0.0f;
+		bool m_bool = false;
+	};
+}
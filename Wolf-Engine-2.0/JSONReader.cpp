@@ -1,510 +1,743 @@
 #include "JSONReader.h"
 
-#include <codecvt>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <locale>
-#include <stack>
+#include <span>
 
+#include <xxh64.hpp>
+
+#include "ContentHash.h"
 #include "Debug.h"
+#include "JSONPullReader.h"
+#include "JSONWriter.h"
+#include "MappedFile.h"
+#include "ProfilerCommon.h"
 
-std::string ws2s(const std::wstring& wstr)
+namespace
 {
-	if (wstr.empty())
-		return "";
-
-	size_t sizeNeeded = std::wcstombs(nullptr, wstr.c_str(), 0);
-	if (sizeNeeded == static_cast<size_t>(-1))
+	// Native endianness, a cache written on another platform is seen as invalid and rebuilt
+	struct BinaryCacheHeader
 	{
-		Wolf::Debug::sendError("Conversion failed: invalid multibyte sequence");
-		return "";
-	}
+		uint32_t m_magic;
+		uint32_t m_version;
+		uint64_t m_sourceHash;
+		uint64_t m_sourceSize;
+	};
+	constexpr uint32_t BINARY_CACHE_MAGIC = 0x43534A57; // "WJSC"
+	constexpr uint32_t BINARY_CACHE_VERSION = 2; // 2: chunked source hash
 
-	std::vector<char> str(sizeNeeded + 1);
-	std::wcstombs(str.data(), wstr.c_str(), str.size());
+	// Cache only contains trees read from valid JSON, this only protects against corrupted files
+	constexpr uint32_t BINARY_CACHE_MAX_DEPTH = 256;
 
-	return { str.data() };
+	// Returned for missing properties and properties of another type
+	const std::string EMPTY_STRING;
+	const std::vector<float> EMPTY_FLOAT_ARRAY;
+	const std::vector<std::string> EMPTY_STRING_ARRAY;
 }
 
-Wolf::JSONReader::JSONReader(const FileReadInfo& fileReadInfo)
+// Builds the DOM from the pull reader events
+class Wolf::JSONReader::Parser
 {
-	std::wifstream inputFile(fileReadInfo.filename);
+public:
+	Parser(JSONReader& reader, JSONPullReader& pullReader) : m_reader(reader), m_pullReader(pullReader) {}
 
-	Lines lines;
+	void parseDocument();
 
-	std::wstring line;
-	while (std::getline(inputFile, line))
-	{
-		lines.addLine(line);
-	}
+private:
+	bool parseObject(JSONObject& object);
+	bool parseValue(JSONPropertyValue& value, JSONPullReader::Event event);
+	bool parseArray(JSONPropertyValue& value);
+
+	JSONReader& m_reader;
+	JSONPullReader& m_pullReader;
+};
 
-	if (lines.isCRLFReadAsLF())
+void Wolf::JSONReader::Parser::parseDocument()
+{
+	const JSONPullReader::Event event = m_pullReader.next();
+	if (event != JSONPullReader::Event::BEGIN_OBJECT)
 	{
-		Debug::sendError("CRLF is not supported");
+		m_pullReader.sendError("JSON root must be an object");
+		return;
 	}
 
-	readFromLines(lines);
+	parseObject(*m_reader.m_rootObject);
 }
 
-Wolf::JSONReader::JSONReader(const StringReadInfo& stringReadInfo)
+bool Wolf::JSONReader::Parser::parseObject(JSONObject& object)
 {
-	Lines lines;
+	for (;;)
+	{
+		const JSONPullReader::Event event = m_pullReader.next();
+		if (event == JSONPullReader::Event::END_OBJECT)
+			return true;
+		if (event != JSONPullReader::Event::PROPERTY_NAME)
+			return false;
 
-	std::wstring line(stringReadInfo.jsonData.begin(), stringReadInfo.jsonData.end());
-	lines.addLine(line);
+		const std::string* key = m_reader.internKey(m_pullReader.getString());
+		JSONPropertyValue value;
+		if (!parseValue(value, m_pullReader.next()))
+			return false;
 
-	readFromLines(lines);
+		// First definition is kept
+		if (!object.addProperty(key, value))
+			Debug::sendError("JSON property " + *key + " is defined twice");
+	}
 }
 
-Wolf::JSONReader::~JSONReader()
+bool Wolf::JSONReader::Parser::parseValue(JSONPropertyValue& value, JSONPullReader::Event event)
 {
-	std::function<void(JSONObject* object)> deleteDataInsideObject;
-	deleteDataInsideObject = [&deleteDataInsideObject](JSONObject* object)
+	switch (event)
 	{
-		for (auto it = object->properties.begin(); it != object->properties.end(); ++it)
+		case JSONPullReader::Event::BEGIN_OBJECT:
+			value.type = JSONPropertyType::Object;
+			value.objectValue = &m_reader.m_objects.emplace_back(m_reader);
+			return parseObject(*value.objectValue);
+		case JSONPullReader::Event::BEGIN_ARRAY:
+			return parseArray(value);
+		case JSONPullReader::Event::STRING:
+			value.type = JSONPropertyType::String;
+			value.stringValue = &m_reader.m_strings.emplace_back(m_pullReader.getString());
+			return true;
+		case JSONPullReader::Event::NUMBER:
+			value.type = JSONPropertyType::Float;
+			value.floatValue = m_pullReader.getNumber();
+			return true;
+		case JSONPullReader::Event::BOOL:
+			value.type = JSONPropertyType::Bool;
+			value.boolValue = m_pullReader.getBool();
+			return true;
+		case JSONPullReader::Event::NULL_VALUE:
+			value.type = JSONPropertyType::Null;
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool Wolf::JSONReader::Parser::parseArray(JSONPropertyValue& value)
+{
+	value.type = JSONPropertyType::UnknownArray;
+
+	// Storage is created with the first item
+	std::vector<JSONObject*>* objectArray = nullptr;
+	std::vector<float>* floatArray = nullptr;
+	std::vector<std::string>* stringArray = nullptr;
+
+	for (;;)
+	{
+		const JSONPullReader::Event event = m_pullReader.next();
+		if (event == JSONPullReader::Event::END_ARRAY)
+			return true;
+
+		// Items must all be objects, strings or numbers
+		JSONPropertyType itemArrayType;
+		if (event == JSONPullReader::Event::BEGIN_OBJECT)
+			itemArrayType = JSONPropertyType::ObjectArray;
+		else if (event == JSONPullReader::Event::STRING)
+			itemArrayType = JSONPropertyType::StringArray;
+		else if (event == JSONPullReader::Event::NUMBER)
+			itemArrayType = JSONPropertyType::FloatArray;
+		else
 		{
-			const JSONPropertyValue* propertyValue = it->second;
-			if (propertyValue->type == JSONPropertyType::Object)
-				deleteDataInsideObject(propertyValue->objectValue);
-			else if(propertyValue->type == JSONPropertyType::ObjectArray)
-			{
-				for(JSONObject* object : propertyValue->objectArrayValue)
-				{
-					deleteDataInsideObject(object);
-				}
-			}
+			m_pullReader.sendError("JSON arrays can only contain objects, strings or numbers");
+			return false;
 		}
 
-		delete object;
-	};
+		if (value.type == JSONPropertyType::UnknownArray)
+		{
+			value.type = itemArrayType;
+			if (itemArrayType == JSONPropertyType::ObjectArray)
+				value.objectArrayValue = objectArray = &m_reader.m_objectArrays.emplace_back();
+			else if (itemArrayType == JSONPropertyType::StringArray)
+				value.stringArrayValue = stringArray = &m_reader.m_stringArrays.emplace_back();
+			else
+				value.floatArrayValue = floatArray = &m_reader.m_floatArrays.emplace_back();
+		}
+		else if (value.type != itemArrayType)
+		{
+			m_pullReader.sendError("JSON array items must have the same type");
+			return false;
+		}
 
-	deleteDataInsideObject(m_rootObject);
+		if (itemArrayType == JSONPropertyType::ObjectArray)
+		{
+			JSONObject* object = &m_reader.m_objects.emplace_back(m_reader);
+			objectArray->push_back(object);
+			if (!parseObject(*object))
+				return false;
+		}
+		else if (itemArrayType == JSONPropertyType::StringArray)
+		{
+			stringArray->emplace_back(m_pullReader.getString());
+		}
+		else
+		{
+			floatArray->push_back(m_pullReader.getNumber());
+		}
+	}
 }
 
-void Wolf::JSONReader::readFromLines(const Lines& lines)
+class Wolf::JSONReader::BinaryCacheWriter
 {
-	m_rootObject = new JSONObject;
+public:
+	BinaryCacheWriter(uint64_t sourceHash, uint64_t sourceSize)
+	{
+		write(BinaryCacheHeader{ BINARY_CACHE_MAGIC, BINARY_CACHE_VERSION, sourceHash, sourceSize });
+	}
 
-	// JSON current state
-	bool jsonStarted = false; // true inside main { }
-	std::stack<JSONObject*>	currentObjectStack;
-	currentObjectStack.push(m_rootObject);
-	std::stack<JSONPropertyValue*> currentPropertyStack;
+	void writeObject(const JSONObject& object)
+	{
+		write(static_cast<uint32_t>(object.getProperties().size()));
+		for (const JSONObject::Property& property : object.getProperties())
+		{
+			writeString(*property.key);
+			writeValue(property.value);
+		}
+	}
 
-	enum class LookingFor { NextProperty, Colon, PropertyValue, Comma, NewArrayValue };
-	LookingFor currentLookingFor = LookingFor::NextProperty;
+	// Written to a temporary file first so an interrupted write can't leave a truncated cache
+	void writeFile(const std::string& filename) const
+	{
+		std::error_code errorCode;
+		if (const std::filesystem::path folder = std::filesystem::path(filename).parent_path(); !folder.empty())
+			std::filesystem::create_directories(folder, errorCode);
 
-	// helpers
-	auto removeComments = [](std::wstring& line)
+		const std::string temporaryFilename = filename + ".tmp";
 		{
-			if (const size_t commentPos = line.find(L"//"); commentPos != std::wstring::npos)
+			std::ofstream outputFile(temporaryFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+			outputFile.write(reinterpret_cast<const char*>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+			if (!outputFile)
 			{
-				// Check if it's not in a string
-				bool isInString = false;
-				size_t beginQuotePos = line.find('"');
-				size_t endQuotePosMin = beginQuotePos + 1;
-				while (beginQuotePos != std::wstring::npos)
-				{
-					if (const size_t endQuotePos = line.find('"', endQuotePosMin); endQuotePos != std::wstring::npos)
-					{
-						if (line[endQuotePos - 1] == '\\')
-						{
-							endQuotePosMin = endQuotePos + 1;
-							continue;
-						}
-
-						if (beginQuotePos < commentPos && endQuotePos > commentPos)
-						{
-							isInString = true;
-							break;
-						}
-
-						beginQuotePos = line.find('"', endQuotePos + 1);
-						endQuotePosMin = beginQuotePos + 1;
-					}
-					else
-					{
-						Debug::sendCriticalError("Incorrect line");
-					}
-				}
-					
-
-				if (!isInString)
-				{
-					line = line.substr(0, commentPos);
-				}
+				Debug::sendWarning("Can't write JSON binary cache " + temporaryFilename);
+				return;
 			}
-		};
-	auto removeSpaces = [](std::wstring& line)
-		{
-			std::erase_if(line, isspace);
-		};
+		}
 
-	auto lookForAFloat = [&removeSpaces](const std::wstring& line, float& outputFloat, size_t& outputLastCharacterPosition)
+		std::filesystem::rename(temporaryFilename, filename, errorCode);
+		if (errorCode)
 		{
-			if (!line.empty())
-			{
-				std::wstring stringToTry;
-
-				const size_t commaPos = line.find(',');
-				const size_t endArray = line.find(']');
-				const size_t endObject = line.find('}');
-
-				const size_t minEndingPos = std::min(commaPos, std::min(endArray, endObject));
-
-				if (minEndingPos != std::wstring::npos)
-					stringToTry = line.substr(0, minEndingPos);
-				else
-					stringToTry = line;
+			Debug::sendWarning("Can't write JSON binary cache " + filename + ": " + errorCode.message());
+			std::filesystem::remove(temporaryFilename, errorCode);
+		}
+	}
 
-				try
+private:
+	void writeValue(const JSONPropertyValue& value)
+	{
+		write(static_cast<uint8_t>(value.type));
+		switch (value.type)
+		{
+			case JSONPropertyType::String:
+				writeString(*value.stringValue);
+				break;
+			case JSONPropertyType::Object:
+				writeObject(*value.objectValue);
+				break;
+			case JSONPropertyType::Float:
+				write(value.floatValue);
+				break;
+			case JSONPropertyType::ObjectArray:
+				write(static_cast<uint32_t>(value.objectArrayValue->size()));
+				for (const JSONObject* object : *value.objectArrayValue)
 				{
-					std::wstring stringWithoutSpaces = stringToTry; removeSpaces(stringWithoutSpaces);
-					outputFloat = std::stof(stringWithoutSpaces);
-					outputLastCharacterPosition = minEndingPos != std::wstring::npos ? minEndingPos : stringToTry.size();
-					return true;
+					writeObject(*object);
 				}
-				catch (std::invalid_argument const&)
+				break;
+			case JSONPropertyType::FloatArray:
+				write(static_cast<uint32_t>(value.floatArrayValue->size()));
+				writeBytes(value.floatArrayValue->data(), value.floatArrayValue->size() * sizeof(float));
+				break;
+			case JSONPropertyType::StringArray:
+				write(static_cast<uint32_t>(value.stringArrayValue->size()));
+				for (const std::string& string : *value.stringArrayValue)
 				{
+					writeString(string);
 				}
+				break;
+			case JSONPropertyType::Bool:
+				write(static_cast<uint8_t>(value.boolValue));
+				break;
+			case JSONPropertyType::UnknownArray:
+			case JSONPropertyType::Unknown:
+			case JSONPropertyType::Null:
+				break;
+		}
+	}
 
-				return false;
-			}
+	void writeString(const std::string& string)
+	{
+		write(static_cast<uint32_t>(string.size()));
+		writeBytes(string.data(), string.size());
+	}
 
-			return false;
-		};
+	template <typename T>
+	void write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		writeBytes(&value, sizeof(T));
+	}
 
-	std::wstring line;
-	int32_t currentLineNumber = -1;
-	auto getLine = [&]()
-		{
-			if (line.empty() || line == L"\r")
-			{
-				currentLineNumber++;
-				return lines.getNextLine(line);
-			}
-			return true;
-		};
+	void writeBytes(const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		m_data.insert(m_data.end(), bytes, bytes + size);
+	}
 
-	while (getLine())
+	std::vector<uint8_t> m_data;
+};
+
+class Wolf::JSONReader::BinaryCacheReader
+{
+public:
+	BinaryCacheReader(JSONReader& reader, std::span<const uint8_t> data) : m_reader(reader), m_cursor(data.data()), m_end(data.data() + data.size()) {}
+
+	bool readHeader(uint64_t sourceHash, uint64_t sourceSize)
 	{
-		removeComments(line);
+		BinaryCacheHeader header;
+		return read(header) && header.m_magic == BINARY_CACHE_MAGIC && header.m_version == BINARY_CACHE_VERSION && header.m_sourceHash == sourceHash && header.m_sourceSize == sourceSize;
+	}
 
-		if (!jsonStarted)
-		{
-			if (const size_t jsonStartingPos = line.find('{'); jsonStartingPos != std::string::npos)
-			{
-				line = line.substr(jsonStartingPos + 1);
-				jsonStarted = true;
-			}
-			continue;
-		}
+	bool readObject(JSONObject& object, uint32_t depth)
+	{
+		uint32_t propertyCount;
+		if (depth >= BINARY_CACHE_MAX_DEPTH || !read(propertyCount) || propertyCount > getRemainingSize())
+			return false;
 
-		// Get next property
-		if (currentLookingFor == LookingFor::NextProperty)
+		std::string propertyName;
+		for (uint32_t propertyIdx = 0; propertyIdx < propertyCount; ++propertyIdx)
 		{
-			const size_t quotePos = line.find('"');
-			const size_t endObjectPos = line.find('}');
-
-			if (quotePos < endObjectPos)
-			{
-				line = line.substr(quotePos + 1);
-				if (const size_t propertyNameEnding = line.find('"'); propertyNameEnding != std::string::npos)
-				{
-					std::wstring propertyName = line.substr(0, propertyNameEnding);
+			JSONPropertyValue value;
+			if (!readString(propertyName) || !readValue(value, depth))
+				return false;
 
-					if (currentObjectStack.top()->properties.contains(ws2s(propertyName)))
-						Debug::sendError("JSON property " + ws2s(propertyName) + " is defined twice");
+			if (!object.addProperty(m_reader.internKey(propertyName), value))
+				return false;
+		}
 
-					currentObjectStack.top()->properties.insert({ ws2s(propertyName), new JSONPropertyValue() });
-					currentPropertyStack.push(currentObjectStack.top()->properties[ws2s(propertyName)]);
+		return true;
+	}
 
-					line = line.substr(propertyNameEnding + 1);
-					currentLookingFor = LookingFor::Colon;
-				}
-				else
-					Debug::sendCriticalError("JSON seems wrong: property doesn't end");
-			}
-			else if (endObjectPos != std::string::npos)
-			{
-				currentObjectStack.pop();
+	[[nodiscard]] bool isAtEnd() const { return m_cursor == m_end; }
 
-				if (currentObjectStack.empty())
-					break;
+private:
+	bool readValue(JSONPropertyValue& value, uint32_t depth)
+	{
+		uint8_t type;
+		if (!read(type) || type > static_cast<uint8_t>(JSONPropertyType::Null))
+			return false;
+		value.type = static_cast<JSONPropertyType>(type);
 
-				currentLookingFor = LookingFor::Comma;
-				line = line.substr(endObjectPos + 1);
-			}
-		}
-		else if (currentLookingFor == LookingFor::Colon)
+		uint32_t count = 0;
+		switch (value.type)
 		{
-			if (const size_t colonPos = line.find(':'); colonPos != std::string::npos)
+			case JSONPropertyType::String:
 			{
-				line = line.substr(colonPos + 1);
-				currentLookingFor = LookingFor::PropertyValue;
+				std::string& string = m_reader.m_strings.emplace_back();
+				value.stringValue = &string;
+				return readString(string);
 			}
-		}
-		else if (currentLookingFor == LookingFor::Comma)
-		{
-			const size_t endArrayPos = line.find(']');
-			const size_t commaPos = line.find(',');
-			const size_t endObjectPos = line.find('}');
-
-			if (commaPos < endArrayPos && commaPos < endObjectPos)
+			case JSONPropertyType::Object:
+				value.objectValue = &m_reader.m_objects.emplace_back(m_reader);
+				return readObject(*value.objectValue, depth + 1);
+			case JSONPropertyType::Float:
+				return read(value.floatValue);
+			case JSONPropertyType::ObjectArray:
 			{
-				line = line.substr(commaPos + 1);
-
-				bool isLookingForNextObjectArrayItem = !currentPropertyStack.empty() && currentPropertyStack.top()->type == JSONPropertyType::ObjectArray && currentObjectStack.top() != currentPropertyStack.top()->objectArrayValue.back();
-				if (!currentPropertyStack.empty() && (currentPropertyStack.top()->type == JSONPropertyType::FloatArray || currentPropertyStack.top()->type == JSONPropertyType::StringArray || isLookingForNextObjectArrayItem))
-				{
-					currentLookingFor = LookingFor::NewArrayValue;
-				}
-				else
+				if (!read(count) || count > getRemainingSize())
+					return false;
+				std::vector<JSONObject*>& objectArray = m_reader.m_objectArrays.emplace_back();
+				value.objectArrayValue = &objectArray;
+				objectArray.reserve(count);
+				for (uint32_t itemIdx = 0; itemIdx < count; ++itemIdx)
 				{
-					currentLookingFor = LookingFor::NextProperty;
+					JSONObject* object = &m_reader.m_objects.emplace_back(m_reader);
+					objectArray.push_back(object);
+					if (!readObject(*object, depth + 1))
+						return false;
 				}
+				return true;
 			}
-			else if (endArrayPos != std::string::npos && endArrayPos < endObjectPos)
+			case JSONPropertyType::FloatArray:
 			{
-				if (currentPropertyStack.empty() ||
-					(currentPropertyStack.top()->type != JSONPropertyType::FloatArray && currentPropertyStack.top()->type != JSONPropertyType::StringArray && currentPropertyStack.top()->type != JSONPropertyType::UnknownArray && 
-						currentPropertyStack.top()->type != JSONPropertyType::ObjectArray))
-					Debug::sendError("JSON unexpected ']' when property is not array");
-
-				currentPropertyStack.pop();
-				line = line.substr(endArrayPos + 1);
-				currentLookingFor = LookingFor::Comma;
+				if (!read(count) || count > getRemainingSize() / sizeof(float))
+					return false;
+				std::vector<float>& floatArray = m_reader.m_floatArrays.emplace_back(count);
+				value.floatArrayValue = &floatArray;
+				return readBytes(floatArray.data(), count * sizeof(float));
 			}
-			else if (endObjectPos != std::string::npos)
+			case JSONPropertyType::StringArray:
 			{
-				JSONObject* removedObject = currentObjectStack.top();
-				currentObjectStack.pop();
-
-				if (currentObjectStack.empty())
-					break;
-
-				// If the object is a property, we need to remove it
-				JSONPropertyValue* topProperty = currentPropertyStack.top();
-				if (topProperty->objectValue == removedObject)
+				if (!read(count) || count > getRemainingSize())
+					return false;
+				std::vector<std::string>& stringArray = m_reader.m_stringArrays.emplace_back(count);
+				value.stringArrayValue = &stringArray;
+				for (std::string& string : stringArray)
 				{
-					currentPropertyStack.pop();
+					if (!readString(string))
+						return false;
 				}
-
-				currentLookingFor = LookingFor::Comma;
-				line = line.substr(endObjectPos + 1);
+				return true;
+			}
+			case JSONPropertyType::Bool:
+			{
+				uint8_t boolValue;
+				if (!read(boolValue))
+					return false;
+				value.boolValue = boolValue != 0;
+				return true;
 			}
+			case JSONPropertyType::UnknownArray:
+			case JSONPropertyType::Unknown:
+			case JSONPropertyType::Null:
+				return true;
 		}
-		else if (currentLookingFor == LookingFor::PropertyValue)
-		{
-			const size_t bracePos = line.find('{');
-			const size_t quotePos = line.find('"');
-			const size_t bracketPos = line.find('[');
 
-			std::wstring duplicatedLine = line;
-			removeSpaces(duplicatedLine);
-			char nextCharacter = static_cast<char>(toupper(duplicatedLine[0]));
+		return false;
+	}
 
-			if (nextCharacter == 'F' || nextCharacter == 'T')
-			{
-				currentPropertyStack.top()->type = JSONPropertyType::Bool;
-				if (nextCharacter == 'F')
-				{
-					currentPropertyStack.top()->boolValue = false;
-				}
-				else
-				{
-					currentPropertyStack.top()->boolValue = true;
-				}
-				const size_t propertyValueEnding = std::min(line.find('e'), line.find('E'));
-				line = line.substr(propertyValueEnding + 1);
-				currentPropertyStack.pop();
-				currentLookingFor = LookingFor::Comma;
-			}
-			else if (isdigit(nextCharacter) || nextCharacter == '-')
-			{
-				float floatValue;
-				size_t lastCharacterPos;
-				if (lookForAFloat(line, floatValue, lastCharacterPos))
-				{
-					currentPropertyStack.top()->type = JSONPropertyType::Float;
-					currentPropertyStack.top()->floatValue = floatValue;
-					line = line.substr(lastCharacterPos);
+	bool readString(std::string& outString)
+	{
+		uint32_t size;
+		if (!read(size) || size > getRemainingSize())
+			return false;
 
-					currentPropertyStack.pop();
-					currentLookingFor = LookingFor::Comma;
-				}
-			}
-			else if (nextCharacter == 'N')
-			{
-				currentPropertyStack.top()->type = JSONPropertyType::Null;
-				const size_t propertyValueEnding = line.find('l') + 1;
-				line = line.substr(propertyValueEnding + 1);
-				currentPropertyStack.pop();
-				currentLookingFor = LookingFor::Comma;
-			}
-			else if (bracePos < quotePos && bracePos < bracketPos)
-			{
-				currentPropertyStack.top()->type = JSONPropertyType::Object;
-				currentPropertyStack.top()->objectValue = new JSONObject;
+		outString.assign(reinterpret_cast<const char*>(m_cursor), size);
+		m_cursor += size;
+		return true;
+	}
 
-				currentObjectStack.push(currentPropertyStack.top()->objectValue);
-				line = line.substr(line.find('{') + 1);
-				currentLookingFor = LookingFor::NextProperty;
-			}
-			else if (quotePos < bracePos && quotePos < bracketPos)
-			{
-				currentPropertyStack.top()->type = JSONPropertyType::String;
-				line = line.substr(quotePos + 1);
-				size_t propertyStringEnding = line.find('"');
+	template <typename T>
+	bool read(T& outValue)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		return readBytes(&outValue, sizeof(T));
+	}
 
-				while (propertyStringEnding != std::string::npos)
-				{
-					if (propertyStringEnding > 0 && line[propertyStringEnding - 1] == '\\')
-					{
-						line.erase(propertyStringEnding - 1, 1);
-						propertyStringEnding = line.find('"', propertyStringEnding);
-						continue;
-					}
-					break;
-				}
+	bool readBytes(void* outData, size_t size)
+	{
+		if (size > getRemainingSize())
+			return false;
 
-				if (propertyStringEnding != std::string::npos)
-				{
-					std::wstring propertyValue = line.substr(0, propertyStringEnding);
+		std::memcpy(outData, m_cursor, size);
+		m_cursor += size;
+		return true;
+	}
 
-					currentPropertyStack.top()->stringValue = ws2s(propertyValue);
+	[[nodiscard]] size_t getRemainingSize() const { return static_cast<size_t>(m_end - m_cursor); }
 
-					line = line.substr(propertyStringEnding + 1);
-					currentPropertyStack.pop();
-					currentLookingFor = LookingFor::Comma;
-				}
-				else
-					Debug::sendError("JSON seems wrong: property string value doesn't end");
-			}
-			else if (bracketPos < bracePos && bracketPos < quotePos)
-			{
-				currentPropertyStack.top()->type = JSONPropertyType::UnknownArray;
+	JSONReader& m_reader;
+	const uint8_t* m_cursor;
+	const uint8_t* m_end;
+};
 
-				line = line.substr(bracketPos + 1);
-				currentLookingFor = LookingFor::NewArrayValue;
-			}
-		}
-		else if (currentLookingFor == LookingFor::NewArrayValue)
-		{
-			std::wstring lineWithoutSpace = line;
-			removeSpaces(lineWithoutSpace);
+Wolf::JSONReader::JSONReader(const FileReadInfo& fileReadInfo)
+{
+	PROFILE_FUNCTION
 
-			const size_t bracePos = lineWithoutSpace.find('{');
-			const size_t quotePos = lineWithoutSpace.find('"');
-			const size_t endOfArrayPos = lineWithoutSpace.find(']');
+	if (fileReadInfo.useBinaryCache)
+	{
+		loadWithBinaryCache(fileReadInfo);
+		return;
+	}
 
-			if (bracePos == 0)
-			{
-				currentPropertyStack.top()->type = JSONPropertyType::ObjectArray;
-				currentPropertyStack.top()->objectArrayValue.push_back(new JSONObject);
+	JSONPullReader pullReader(JSONPullReader::FileReadInfo{ fileReadInfo.filename });
+	parse(pullReader);
+}
 
-				currentObjectStack.push(currentPropertyStack.top()->objectArrayValue.back());
-				line = line.substr(line.find('{') + 1);
-				currentLookingFor = LookingFor::NextProperty;
-			}
-			else if (quotePos == 0)
-			{
-				currentPropertyStack.top()->type = JSONPropertyType::StringArray;
-				line = line.substr(line.find('"') + 1);
-				if (const size_t propertyStringEnding = line.find('"'); propertyStringEnding != std::string::npos)
-				{
-					std::wstring propertyValue = line.substr(0, propertyStringEnding);
+Wolf::JSONReader::JSONReader(const StringReadInfo& stringReadInfo)
+{
+	JSONPullReader pullReader(stringReadInfo.jsonData);
+	parse(pullReader);
+}
 
-					currentPropertyStack.top()->stringArrayValue.push_back(ws2s(propertyValue));
+Wolf::JSONReader::~JSONReader() = default;
 
-					line = line.substr(propertyStringEnding + 1);
-					currentLookingFor = LookingFor::Comma;
-				}
-				else
-					Debug::sendError("JSON seems wrong: property string value doesn't end");
-			}
-			else if (endOfArrayPos == 0)
-			{
-				currentPropertyStack.top()->type = JSONPropertyType::UnknownArray;
-				currentLookingFor = LookingFor::Comma;
-			}
-			else
-			{
-				float floatValue;
-				size_t lastCharacterPos;
-				if (lookForAFloat(line, floatValue, lastCharacterPos))
-				{
-					currentPropertyStack.top()->type = JSONPropertyType::FloatArray;
-					currentPropertyStack.top()->floatArrayValue.push_back(floatValue);
-					line = line.substr(lastCharacterPos);
-					currentLookingFor = LookingFor::Comma;
-				}
-			}
+bool Wolf::JSONReader::parse(JSONPullReader& pullReader)
+{
+	// Properties read before an error are kept
+	m_rootObject = &m_objects.emplace_back(*this);
+
+	Parser parser(*this, pullReader);
+	parser.parseDocument();
+
+	return !pullReader.hasError();
+}
+
+void Wolf::JSONReader::loadWithBinaryCache(const FileReadInfo& fileReadInfo)
+{
+	const MappedFile sourceFile(fileReadInfo.filename);
+	if (!sourceFile.isValid())
+	{
+		Debug::sendError("Can't open JSON file " + fileReadInfo.filename);
+		m_rootObject = &m_objects.emplace_back(*this);
+		return;
+	}
+
+	const std::string_view jsonData = sourceFile.getText();
+	const uint64_t sourceHash = computeContentHash(jsonData);
+	const std::string cacheFilename = computeBinaryCacheFilename(fileReadInfo);
+
+	if (const MappedFile cacheFile(cacheFilename); cacheFile.isValid())
+	{
+		m_rootObject = &m_objects.emplace_back(*this);
+
+		BinaryCacheReader cacheReader(*this, cacheFile.getData());
+		if (cacheReader.readHeader(sourceHash, jsonData.size()) && cacheReader.readObject(*m_rootObject, 0) && cacheReader.isAtEnd())
+			return;
+
+		// Stale or corrupted cache, rebuilt from the source
+		m_keys.clear();
+		m_internedKeys.clear();
+		m_objects.clear();
+		m_strings.clear();
+		m_objectArrays.clear();
+		m_floatArrays.clear();
+		m_stringArrays.clear();
+	}
+
+	JSONPullReader pullReader(jsonData);
+	if (!parse(pullReader))
+		return; // invalid files aren't cached so errors are reported on each load
+
+	BinaryCacheWriter cacheWriter(sourceHash, jsonData.size());
+	cacheWriter.writeObject(*m_rootObject);
+	cacheWriter.writeFile(cacheFilename);
+}
+
+std::string Wolf::JSONReader::computeBinaryCacheFilename(const FileReadInfo& fileReadInfo)
+{
+	if (fileReadInfo.binaryCacheFolder.empty())
+		return fileReadInfo.filename + ".cache";
+
+	// Source path hash avoids collisions between files with the same name
+	std::array<char, 16> pathHash;
+	const uint64_t pathHashValue = xxh64::hash(fileReadInfo.filename.c_str(), fileReadInfo.filename.size(), 0);
+	const std::to_chars_result result = std::to_chars(pathHash.data(), pathHash.data() + pathHash.size(), pathHashValue, 16);
+
+	return fileReadInfo.binaryCacheFolder + "/" + std::filesystem::path(fileReadInfo.filename).filename().string() + "." + std::string(pathHash.data(), result.ptr) + ".cache";
+}
+
+const std::string* Wolf::JSONReader::internKey(std::string_view key)
+{
+	if (const auto it = m_internedKeys.find(key); it != m_internedKeys.end())
+		return it->second;
+
+	const std::string* internedKey = &m_keys.emplace_back(key);
+	m_internedKeys.emplace(*internedKey, internedKey);
+	return internedKey;
+}
+
+const std::string* Wolf::JSONReader::findInternedKey(std::string_view key) const
+{
+	const auto it = m_internedKeys.find(key);
+	return it != m_internedKeys.end() ? it->second : nullptr;
+}
+
+bool Wolf::JSONReader::JSONObject::addProperty(const std::string* key, const JSONPropertyValue& value)
+{
+	if (findProperty(key))
+		return false;
+
+	m_properties.push_back({ key, value });
+	if (m_properties.size() == MIN_INDEXED_PROPERTY_COUNT)
+	{
+		for (uint32_t propertyIdx = 0; propertyIdx < m_properties.size(); ++propertyIdx)
+		{
+			m_propertyIndices.emplace(m_properties[propertyIdx].key, propertyIdx);
 		}
 	}
+	else if (m_properties.size() > MIN_INDEXED_PROPERTY_COUNT)
+	{
+		m_propertyIndices.emplace(key, static_cast<uint32_t>(m_properties.size()) - 1);
+	}
+
+	return true;
+}
+
+const Wolf::JSONReader::JSONPropertyValue* Wolf::JSONReader::JSONObject::findProperty(const std::string& propertyName) const
+{
+	// A name which isn't a key anywhere in the document can't be a property
+	const std::string* key = m_reader.findInternedKey(propertyName);
+	return key ? findProperty(key) : nullptr;
+}
+
+const Wolf::JSONReader::JSONPropertyValue* Wolf::JSONReader::JSONObject::findProperty(const std::string* key) const
+{
+	if (!m_propertyIndices.empty())
+	{
+		const auto it = m_propertyIndices.find(key);
+		return it != m_propertyIndices.end() ? &m_properties[it->second].value : nullptr;
+	}
+
+	for (const Property& property : m_properties)
+	{
+		if (property.key == key)
+			return &property.value;
+	}
+	return nullptr;
 }
 
 bool Wolf::JSONReader::JSONObject::hasProperty(const std::string& propertyName)
 {
-	return properties.contains(propertyName);
+	return findProperty(propertyName) != nullptr;
 }
 
 float Wolf::JSONReader::JSONObject::getPropertyFloat(const std::string& propertyName)
 {
-	return properties[propertyName]->floatValue;
+	const JSONPropertyValue* value = findProperty(propertyName);
+	if (!value)
+	{
+		Debug::sendError("JSON property " + propertyName + " doesn't exist");
+		return 0.0f;
+	}
+	return value->type == JSONPropertyType::Float ? value->floatValue : 0.0f;
 }
 
 const std::vector<float>& Wolf::JSONReader::JSONObject::getPropertyFloatArray(const std::string& propertyName)
 {
-	return properties[propertyName]->floatArrayValue;
+	const JSONPropertyValue* value = findProperty(propertyName);
+	if (!value)
+	{
+		Debug::sendError("JSON property " + propertyName + " doesn't exist");
+		return EMPTY_FLOAT_ARRAY;
+	}
+	return value->type == JSONPropertyType::FloatArray ? *value->floatArrayValue : EMPTY_FLOAT_ARRAY;
 }
 
 const std::string& Wolf::JSONReader::JSONObject::getPropertyString(const std::string& propertyName)
 {
-	return properties[propertyName]->stringValue;
+	const JSONPropertyValue* value = findProperty(propertyName);
+	if (!value)
+	{
+		Debug::sendError("JSON property " + propertyName + " doesn't exist");
+		return EMPTY_STRING;
+	}
+	return value->type == JSONPropertyType::String ? *value->stringValue : EMPTY_STRING;
 }
 
 const std::string& Wolf::JSONReader::JSONObject::getPropertyString(uint32_t propertyIdx)
 {
-	auto it = properties.begin();
-	std::advance(it, propertyIdx);
-	return it->first;
+	if (propertyIdx >= m_properties.size())
+	{
+		Debug::sendError("JSON object has no property at index " + std::to_string(propertyIdx));
+		return EMPTY_STRING;
+	}
+	return *m_properties[propertyIdx].key;
 }
 
 const std::vector<std::string>& Wolf::JSONReader::JSONObject::getPropertyStringArray(const std::string& propertyName)
 {
-	return properties[propertyName]->stringArrayValue;
+	const JSONPropertyValue* value = findProperty(propertyName);
+	if (!value)
+	{
+		Debug::sendError("JSON property " + propertyName + " doesn't exist");
+		return EMPTY_STRING_ARRAY;
+	}
+	return value->type == JSONPropertyType::StringArray ? *value->stringArrayValue : EMPTY_STRING_ARRAY;
 }
 
 bool Wolf::JSONReader::JSONObject::getPropertyBool(const std::string& propertyName)
 {
-	if (properties[propertyName]->type != JSONPropertyType::Bool)
+	const JSONPropertyValue* value = findProperty(propertyName);
+	if (!value || value->type != JSONPropertyType::Bool)
+	{
 		Debug::sendError("Property is not a bool");
-	return properties[propertyName]->boolValue;
+		return false;
+	}
+	return value->boolValue;
 }
 
 Wolf::JSONReader::JSONObjectInterface* Wolf::JSONReader::JSONObject::getPropertyObject(const std::string& propertyName)
 {
-	if (!properties.contains(propertyName))
+	const JSONPropertyValue* value = findProperty(propertyName);
+	if (!value)
 		return nullptr;
 
-	if (properties[propertyName]->type != JSONPropertyType::Object)
+	if (value->type != JSONPropertyType::Object)
+	{
 		Debug::sendError("Property is not an object");
-	return properties[propertyName]->objectValue;
+		return nullptr;
+	}
+	return value->objectValue;
 }
 
 Wolf::JSONReader::JSONObjectInterface* Wolf::JSONReader::JSONObject::getArrayObjectItem(const std::string& propertyName, uint32_t idx)
 {
-	return properties[propertyName]->objectArrayValue[idx];
+	const JSONPropertyValue* value = findProperty(propertyName);
+	if (!value || value->type != JSONPropertyType::ObjectArray || idx >= value->objectArrayValue->size())
+	{
+		Debug::sendError("JSON property " + propertyName + " has no object at index " + std::to_string(idx));
+		return nullptr;
+	}
+	return (*value->objectArrayValue)[idx];
 }
 
 uint32_t Wolf::JSONReader::JSONObject::getArraySize(const std::string& propertyName)
 {
-	if (!properties.contains(propertyName))
+	const JSONPropertyValue* value = findProperty(propertyName);
+	if (!value || value->type != JSONPropertyType::ObjectArray)
 		return 0;
-	return static_cast<uint32_t>(properties[propertyName]->objectArrayValue.size());
+	return static_cast<uint32_t>(value->objectArrayValue->size());
 }
 
 uint32_t Wolf::JSONReader::JSONObject::getPropertyCount()
 {
-	return static_cast<uint32_t>(properties.size());
+	return static_cast<uint32_t>(m_properties.size());
+}
+
+void Wolf::JSONReader::JSONObject::write(JSONWriter& writer) const
+{
+	writer.beginObject();
+	for (const Property& property : m_properties)
+	{
+		writer.writePropertyName(*property.key);
+
+		const JSONPropertyValue& value = property.value;
+		switch (value.type)
+		{
+			case JSONPropertyType::String:
+				writer.writeString(*value.stringValue);
+				break;
+			case JSONPropertyType::Object:
+				value.objectValue->write(writer);
+				break;
+			case JSONPropertyType::Float:
+				writer.writeNumber(value.floatValue);
+				break;
+			case JSONPropertyType::Bool:
+				writer.writeBool(value.boolValue);
+				break;
+			case JSONPropertyType::ObjectArray:
+				writer.beginArray();
+				for (const JSONObject* object : *value.objectArrayValue)
+					object->write(writer);
+				writer.endArray();
+				break;
+			case JSONPropertyType::FloatArray:
+				writer.beginArray();
+				for (const float item : *value.floatArrayValue)
+					writer.writeNumber(item);
+				writer.endArray();
+				break;
+			case JSONPropertyType::StringArray:
+				writer.beginArray();
+				for (const std::string& item : *value.stringArrayValue)
+					writer.writeString(item);
+				writer.endArray();
+				break;
+			case JSONPropertyType::UnknownArray:
+				writer.beginArray();
+				writer.endArray();
+				break;
+			case JSONPropertyType::Unknown:
+			case JSONPropertyType::Null:
+				writer.writeNull();
+				break;
+		}
+	}
+	writer.endObject();
 }
@@ -1,18 +1,27 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace Wolf
 {
+	class JSONPullReader;
+	class JSONWriter;
+
 	class JSONReader
 	{
 	public:
 		struct FileReadInfo
 		{
 			std::string filename;
+
+			// Parsed tree is saved to a binary file and loaded from it while the source content is unchanged
+			bool useBinaryCache = false;
+			std::string binaryCacheFolder; // cache is next to the source file when empty
 		};
 		JSONReader(const FileReadInfo& fileReadInfo);
 
@@ -40,6 +49,9 @@ namespace Wolf
 			virtual uint32_t getArraySize(const std::string& propertyName) = 0;
 			virtual uint32_t getPropertyCount() = 0;
 
+			// Writes the object and all its children as a JSON object value
+			virtual void write(JSONWriter& writer) const = 0;
+
 			void setVisited() { m_visited = true; }
 			bool hasBeenVisited() const { return m_visited; }
 
@@ -49,55 +61,52 @@ namespace Wolf
 		JSONObjectInterface* getRoot() { return m_rootObject; }
 
 	private:
-		class Lines
-		{
-		public:
-			void addLine(const std::wstring& line) { m_lines.push_back(line); }
-
-			bool getNextLine(std::wstring& outLine) const
-			{
-				if (m_currentLine == m_lines.size())
-					return false;
-
-				outLine = m_lines[m_currentLine++];
-				return true;
-			}
-
-			bool isCRLFReadAsLF() const
-			{
-				return !m_lines.empty() && m_lines[0][m_lines[0].size() - 1] == '\r';
-			}
-
-		private:
-			std::vector<std::wstring> m_lines;
-			mutable uint32_t m_currentLine = 0;
-		};
+		// Builds the DOM in a single pass over the JSONPullReader events
+		class Parser;
+		bool parse(JSONPullReader& pullReader);
 
-		void readFromLines(const Lines& lines);
+		// Binary cache stores the tree in pre-order without pointers, loading it doesn't scan any text
+		class BinaryCacheWriter;
+		class BinaryCacheReader;
+		void loadWithBinaryCache(const FileReadInfo& fileReadInfo);
+		static std::string computeBinaryCacheFilename(const FileReadInfo& fileReadInfo);
 
 		class JSONObject;
 
-		enum class JSONPropertyType { String, Object, Float, UnknownArray, ObjectArray, FloatArray, StringArray, Bool, Unknown, Null };
+		enum class JSONPropertyType : uint8_t { String, Object, Float, UnknownArray, ObjectArray, FloatArray, StringArray, Bool, Unknown, Null };
 		struct JSONPropertyValue
 		{
-			JSONPropertyType type;
-
-			// Possible values
-			float floatValue = 0;
-			std::string stringValue;
-			bool boolValue = false;;
-			JSONObject* objectValue = nullptr;
-			std::vector<JSONObject*> objectArrayValue;
-			std::vector<float> floatArrayValue;
-			std::vector<std::string> stringArrayValue;
-
-			JSONPropertyValue() : type(JSONPropertyType::Unknown) {};
+			JSONPropertyType type = JSONPropertyType::Unknown;
+
+			// Value matching the type, strings and arrays are stored by the reader. Empty arrays are UnknownArray with no storage
+			union
+			{
+				float floatValue;
+				bool boolValue;
+				JSONObject* objectValue;
+				const std::string* stringValue;
+				const std::vector<JSONObject*>* objectArrayValue;
+				const std::vector<float>* floatArrayValue;
+				const std::vector<std::string>* stringArrayValue;
+			};
+
+			JSONPropertyValue() : objectValue(nullptr) {}
 		};
 
 		class JSONObject final : public JSONObjectInterface
 		{
 		public:
-			std::unordered_map<std::string, JSONPropertyValue*> properties;
+			explicit JSONObject(const JSONReader& reader) : m_reader(reader) {}
+
+			// Key must be interned, returns false if the property already exists
+			bool addProperty(const std::string* key, const JSONPropertyValue& value);
+
+			struct Property
+			{
+				const std::string* key;
+				JSONPropertyValue value;
+			};
+			const std::vector<Property>& getProperties() const { return m_properties; }
 
 			bool hasProperty(const std::string& propertyName) override;
 
@@ -112,8 +121,34 @@ namespace Wolf
 
 			uint32_t getArraySize(const std::string& propertyName) override;
 			uint32_t getPropertyCount() override;
+
+			void write(JSONWriter& writer) const override;
+
+		private:
+			const JSONPropertyValue* findProperty(const std::string& propertyName) const;
+			const JSONPropertyValue* findProperty(const std::string* key) const;
+
+			const JSONReader& m_reader;
+			std::vector<Property> m_properties; // file order
+
+			// Keys are compared by address, an index is only built for objects with many properties
+			static constexpr uint32_t MIN_INDEXED_PROPERTY_COUNT = 16;
+			std::unordered_map<const std::string*, uint32_t> m_propertyIndices;
 		};
 
+		// Each key is stored once for the whole document
+		const std::string* internKey(std::string_view key);
+		[[nodiscard]] const std::string* findInternedKey(std::string_view key) const;
+		std::deque<std::string> m_keys;
+		std::unordered_map<std::string_view, const std::string*> m_internedKeys;
+
+		// Whole DOM is allocated here and released at once, addresses are stable
+		std::deque<JSONObject> m_objects;
+		std::deque<std::string> m_strings;
+		std::deque<std::vector<JSONObject*>> m_objectArrays;
+		std::deque<std::vector<float>> m_floatArrays;
+		std::deque<std::vector<std::string>> m_stringArrays;
+
 		JSONObject* m_rootObject;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "Job.h"
+
+Wolf::Job::Job(Job&& other) noexcept
+{
+	if (other.m_operations)
+	{
+		other.m_operations->moveAndDestroy(other.m_storage, m_storage);
+		m_operations = other.m_operations;
+		other.m_operations = nullptr;
+	}
+}
+
+Wolf::Job& Wolf::Job::operator=(Job&& other) noexcept
+{
+	if (this != &other)
+	{
+		reset();
+		if (other.m_operations)
+		{
+			other.m_operations->moveAndDestroy(other.m_storage, m_storage);
+			m_operations = other.m_operations;
+			other.m_operations = nullptr;
+		}
+	}
+	return *this;
+}
+
+Wolf::Job::~Job()
+{
+	reset();
+}
+
+void Wolf::Job::operator()()
+{
+	m_operations->invoke(m_storage);
+}
+
+void Wolf::Job::reset()
+{
+	if (m_operations)
+	{
+		m_operations->destroy(m_storage);
+		m_operations = nullptr;
+	}
+}
+
+Wolf::Job* Wolf::JobArena::allocate(Job&& job)
+{
+	const uint32_t blockIdx = m_usedJobCount / JOB_COUNT_PER_BLOCK;
+	if (blockIdx == m_blocks.size())
+	{
+		m_blocks.emplace_back(new std::array<Job, JOB_COUNT_PER_BLOCK>);
+	}
+
+	Job& allocatedJob = (*m_blocks[blockIdx])[m_usedJobCount % JOB_COUNT_PER_BLOCK];
+	allocatedJob = std::move(job);
+	m_usedJobCount++;
+
+	return &allocatedJob;
+}
+
+void Wolf::JobArena::reset()
+{
+	for (uint32_t jobIdx = 0; jobIdx < m_usedJobCount; ++jobIdx)
+	{
+		(*m_blocks[jobIdx / JOB_COUNT_PER_BLOCK])[jobIdx % JOB_COUNT_PER_BLOCK].reset();
+	}
+	m_usedJobCount = 0;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Wolf
+{
+	// Move-only replacement for std::function<void()>.
+	// Callables up to INLINE_STORAGE_SIZE bytes are stored in the job itself, bigger ones fall back to a heap allocation.
+	class Job
+	{
+	public:
+		static constexpr size_t INLINE_STORAGE_SIZE = 112;
+
+		Job() = default;
+		template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Job>>>
+		Job(F&& function);
+		Job(Job&& other) noexcept;
+		Job& operator=(Job&& other) noexcept;
+		Job(const Job&) = delete;
+		Job& operator=(const Job&) = delete;
+		~Job();
+
+		void operator()();
+		explicit operator bool() const { return m_operations != nullptr; }
+		void reset();
+
+		template <typename F>
+		static constexpr bool IS_STORED_INLINE = sizeof(F) <= INLINE_STORAGE_SIZE && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+	private:
+		struct Operations
+		{
+			void (*invoke)(void* storage);
+			void (*moveAndDestroy)(void* source, void* destination);
+			void (*destroy)(void* storage);
+		};
+
+		template <typename F> static void invokeInline(void* storage) { (*std::launder(static_cast<F*>(storage)))(); }
+		template <typename F> static void moveAndDestroyInline(void* source, void* destination)
+		{
+			F* sourceFunction = std::launder(static_cast<F*>(source));
+			new (destination) F(std::move(*sourceFunction));
+			sourceFunction->~F();
+		}
+		template <typename F> static void destroyInline(void* storage) { std::launder(static_cast<F*>(storage))->~F(); }
+		template <typename F> static constexpr Operations INLINE_OPERATIONS = { &invokeInline<F>, &moveAndDestroyInline<F>, &destroyInline<F> };
+
+		template <typename F> static void invokeHeap(void* storage) { (**static_cast<F**>(storage))(); }
+		static void moveAndDestroyHeap(void* source, void* destination) { *static_cast<void**>(destination) = *static_cast<void**>(source); }
+		template <typename F> static void destroyHeap(void* storage) { delete *static_cast<F**>(storage); }
+		template <typename F> static constexpr Operations HEAP_OPERATIONS = { &invokeHeap<F>, &moveAndDestroyHeap, &destroyHeap<F> };
+
+		alignas(std::max_align_t) std::byte m_storage[INLINE_STORAGE_SIZE];
+		const Operations* m_operations = nullptr;
+	};
+
+	template <typename F, typename>
+	Job::Job(F&& function)
+	{
+		using FunctionType = std::decay_t<F>;
+		if constexpr (IS_STORED_INLINE<FunctionType>)
+		{
+			new (m_storage) FunctionType(std::forward<F>(function));
+			m_operations = &INLINE_OPERATIONS<FunctionType>;
+		}
+		else
+		{
+			*reinterpret_cast<FunctionType**>(m_storage) = new FunctionType(std::forward<F>(function));
+			m_operations = &HEAP_OPERATIONS<FunctionType>;
+		}
+	}
+
+	// Jobs keep their address until the next reset(), memory is kept between resets so a warmed-up arena doesn't allocate
+	class JobArena
+	{
+	public:
+		JobArena() = default;
+		JobArena(const JobArena&) = delete;
+
+		Job* allocate(Job&& job);
+		void reset();
+
+	private:
+		static constexpr uint32_t JOB_COUNT_PER_BLOCK = 64;
+		std::vector<std::unique_ptr<std::array<Job, JOB_COUNT_PER_BLOCK>>> m_blocks;
+		uint32_t m_usedJobCount = 0;
+	};
+}
@@ -1,72 +1,504 @@
 #include "JobsManager.h"
 
+#include <Debug.h>
+
 #include "ProfilerCommon.h"
 
-Wolf::JobsManager::JobsManager(uint32_t threadCountBeforeFrameAndRecord)
+Wolf::JobsManager* Wolf::g_jobsManager = nullptr;
+
+Wolf::JobsManager::JobsManager(uint32_t threadCountBeforeFrameAndRecord, uint32_t streamingThreadCount, uint32_t maxPendingStreamingJobCount, const CPUAffinity& beforeFrameAndRecordAffinity,
+    const CPUAffinity& streamingAffinity) : m_maxPendingStreamingJobCount(maxPendingStreamingJobCount)
 {
-    m_multiThreadTaskManager.reset(new MultiThreadTaskManager);
-    m_beforeFrameAndRecordThreadGroupId = m_multiThreadTaskManager->createThreadGroup(threadCountBeforeFrameAndRecord, "Before frame and record");
+    if (g_jobsManager)
+        Debug::sendCriticalError("Can't instantiate JobsManager twice");
+    g_jobsManager = this;
+
+    m_telemetry.reset(new JobsTelemetry);
+    m_telemetry->registerCurrentThread("Main");
+
+    if (threadCountBeforeFrameAndRecord == AUTOMATIC_THREAD_COUNT || streamingThreadCount == AUTOMATIC_THREAD_COUNT)
+    {
+        const uint32_t availableCPUCount = getAvailableCPUCount();
+        const ThreadLayout threadLayout = computeThreadLayout(availableCPUCount);
+        if (threadCountBeforeFrameAndRecord == AUTOMATIC_THREAD_COUNT)
+            threadCountBeforeFrameAndRecord = threadLayout.m_beforeFrameAndRecordThreadCount;
+        if (streamingThreadCount == AUTOMATIC_THREAD_COUNT)
+            streamingThreadCount = threadLayout.m_streamingThreadCount;
+
+        Debug::sendInfo("Thread layout for " + std::to_string(availableCPUCount) + " CPUs: " + std::to_string(threadCountBeforeFrameAndRecord) + " before frame and record threads, " +
+            std::to_string(streamingThreadCount) + " streaming threads");
+    }
 
-    m_streamingThread = std::thread(&JobsManager::streamingExecution, this);
+    m_multiThreadTaskManager.reset(new MultiThreadTaskManager(&*m_telemetry));
+    m_beforeFrameAndRecordThreadGroupId = m_multiThreadTaskManager->createThreadGroup(threadCountBeforeFrameAndRecord, "BeforeFrame", beforeFrameAndRecordAffinity);
+
+    if (streamingThreadCount == 0)
+    {
+        Debug::sendError("At least one streaming thread is required");
+        streamingThreadCount = 1;
+    }
+    for (uint32_t threadIdx = 0; threadIdx < streamingThreadCount; ++threadIdx)
+    {
+        m_streamingThreads.emplace_back(&JobsManager::streamingExecution, this, threadIdx, streamingAffinity);
+    }
+
+    m_asyncFileReader.reset(new AsyncFileReader(ASYNC_FILE_READ_THREAD_COUNT, [this](std::coroutine_handle<> handle) { resumeAsyncTask(handle); }));
 }
 
 Wolf::JobsManager::~JobsManager()
 {
+    if (m_beforeFrameDriverThread.joinable())
+    {
+        waitJobsBeforeFrame();
+        {
+            std::lock_guard<std::mutex> lock(m_beforeFrameDriverMutex);
+            m_stopBeforeFrameDriverRequested = true;
+        }
+        m_beforeFrameDriverCondition.notify_all();
+        m_beforeFrameDriverThread.join();
+    }
+
+    // Stopped before the file reader, a running job can still read files
     {
         std::lock_guard<std::mutex> lk(m_streamingMutex);
         m_stopStreamingThreadRequested = true;
     }
     m_streamingRunCondition.notify_all();
-    m_streamingThread.join();
+    for (std::thread& streamingThread : m_streamingThreads)
+    {
+        streamingThread.join();
+    }
+
+    // Reads not done yet fail, their tasks are queued to be resumed
+    m_asyncFileReader->stop();
+
+    // Suspended tasks own their frames, they are resumed here until they complete. New streaming jobs are rejected and reads fail right away,
+    // jobs not started are dropped (tasks not started are destroyed with their job)
+    for (;;)
+    {
+        StreamingJob streamingJob;
+        {
+            std::lock_guard<std::mutex> lock(m_streamingMutex);
+            if (m_streamingJobs.empty())
+                break;
+
+            streamingJob = popFirstStreamingJob();
+        }
+
+        if (streamingJob.m_isAsyncTaskResume)
+            streamingJob.m_job();
+    }
+    m_asyncFileReader.reset(nullptr);
+
+    JobsTelemetry::unregisterCurrentThread();
+    g_jobsManager = nullptr;
+}
+
+Wolf::JobsManager::JobHandle Wolf::JobsManager::addJobBeforeFrame(MultiThreadTaskManager::Job&& job, std::span<const JobHandle> dependencies, const char* tag)
+{
+    std::lock_guard<std::mutex> lock(m_jobNodesMutex);
+
+    const uint64_t executionIdx = m_nextExecutionIdx.load(std::memory_order_relaxed);
+    std::deque<JobNode>& jobNodes = m_jobNodes[executionIdx % 2];
+
+    const uint32_t jobIdx = static_cast<uint32_t>(jobNodes.size());
+    JobNode& jobNode = jobNodes.emplace_back(std::move(job), tag);
+
+    uint32_t dependencyCount = 0;
+    for (const JobHandle& dependency : dependencies)
+    {
+        if (!dependency.isValid() || dependency.m_executionIdx < executionIdx)
+            continue;
+
+        if (dependency.m_executionIdx > executionIdx || dependency.m_jobIdx >= jobIdx)
+        {
+            Debug::sendError("Job dependency doesn't refer to a previously added job");
+            continue;
+        }
+
+        jobNodes[dependency.m_jobIdx].m_successors.push_back(jobIdx);
+        dependencyCount++;
+    }
+    jobNode.m_remainingDependencyCount.store(dependencyCount, std::memory_order_relaxed);
+
+    return { executionIdx, jobIdx };
+}
+
+Wolf::JobsManager::JobHandle Wolf::JobsManager::addContinuationBeforeFrame(const JobHandle& parent, MultiThreadTaskManager::Job&& job, const char* tag)
+{
+    return addJobBeforeFrame(std::move(job), { &parent, 1 }, tag);
+}
+
+Wolf::JobsManager::JobHandle Wolf::JobsManager::addExternalJobBeforeFrame(const char* tag)
+{
+    std::lock_guard<std::mutex> lock(m_jobNodesMutex);
+
+    const uint64_t executionIdx = m_nextExecutionIdx.load(std::memory_order_relaxed);
+    std::deque<JobNode>& jobNodes = m_jobNodes[executionIdx % 2];
+
+    const uint32_t jobIdx = static_cast<uint32_t>(jobNodes.size());
+    jobNodes.emplace_back(MultiThreadTaskManager::Job(), tag).m_isExternal = true;
+
+    return { executionIdx, jobIdx };
 }
 
-void Wolf::JobsManager::addJobBeforeFrame(const MultiThreadTaskManager::Job& job)
+void Wolf::JobsManager::completeExternalJob(const JobHandle& handle)
 {
-    m_multiThreadTaskManager->addJobToThreadGroup(m_beforeFrameAndRecordThreadGroupId, job);
+    if (!handle.isValid())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_jobNodesMutex);
+
+    // Handles of the jobs being added and of the last execution are still stored
+    const uint64_t nextExecutionIdx = m_nextExecutionIdx.load(std::memory_order_relaxed);
+    if (handle.m_executionIdx > nextExecutionIdx || handle.m_executionIdx + 1 < nextExecutionIdx || handle.m_jobIdx >= m_jobNodes[handle.m_executionIdx % 2].size())
+    {
+        Debug::sendError("External job to complete doesn't exist");
+        return;
+    }
+
+    JobNode& jobNode = m_jobNodes[handle.m_executionIdx % 2][handle.m_jobIdx];
+    if (!jobNode.m_isExternal || jobNode.m_completed.load(std::memory_order_relaxed))
+    {
+        Debug::sendError("Job to complete isn't an external job or is already completed");
+        return;
+    }
+    jobNode.m_completed.store(true, std::memory_order_release);
+    jobNode.m_completed.notify_all();
+
+    // Successors are released by the execution, right away if it's running or when it starts
+    if (handle.m_executionIdx < nextExecutionIdx)
+    {
+        m_completedExternalJobs.push_back(handle.m_jobIdx);
+        m_externalJobCompletedCondition.notify_all();
+    }
 }
 
 void Wolf::JobsManager::executeJobsBeforeFrame()
 {
+    uint32_t pendingExternalJobCount;
+    const uint64_t executionIdx = beginJobGraphExecution(RuntimeContext::NO_CPU_FRAME_NUMBER_OVERRIDE, pendingExternalJobCount);
+    executeJobGraph(executionIdx, pendingExternalJobCount);
+}
+
+uint64_t Wolf::JobsManager::beginJobGraphExecution(uint32_t cpuFrameNumberOverride, uint32_t& outPendingExternalJobCount)
+{
+    std::lock_guard<std::mutex> lock(m_jobNodesMutex);
+
+    const uint64_t executionIdx = m_nextExecutionIdx.fetch_add(1, std::memory_order_relaxed);
+    m_jobNodes[(executionIdx + 1) % 2].clear(); // jobs from the previous execution, all completed
+    m_cpuFrameNumberOverrides[executionIdx % 2] = cpuFrameNumberOverride;
+
+    // External jobs completed before the execution release their successors before anything starts
+    outPendingExternalJobCount = 0;
+    std::deque<JobNode>& jobNodes = m_jobNodes[executionIdx % 2];
+    for (const JobNode& jobNode : jobNodes)
+    {
+        if (!jobNode.m_isExternal)
+            continue;
+
+        if (!jobNode.m_completed.load(std::memory_order_relaxed))
+        {
+            outPendingExternalJobCount++;
+            continue;
+        }
+
+        for (uint32_t successorIdx : jobNode.m_successors)
+        {
+            jobNodes[successorIdx].m_remainingDependencyCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    return executionIdx;
+}
+
+void Wolf::JobsManager::executeJobGraph(uint64_t executionIdx, uint32_t pendingExternalJobCount)
+{
+    // Jobs without dependency are started, others are spawned when their last dependency completes
+    std::deque<JobNode>& jobNodes = m_jobNodes[executionIdx % 2];
+    m_telemetry->onQueueDepth(JobsTelemetry::QueueType::BEFORE_FRAME, static_cast<uint32_t>(jobNodes.size()));
+    for (uint32_t jobIdx = 0; jobIdx < jobNodes.size(); ++jobIdx)
+    {
+        if (!jobNodes[jobIdx].m_isExternal && jobNodes[jobIdx].m_remainingDependencyCount.load(std::memory_order_relaxed) == 0)
+        {
+            m_multiThreadTaskManager->addJobToThreadGroup(m_beforeFrameAndRecordThreadGroupId, [this, executionIdx, jobIdx]() { runJobNode(executionIdx, jobIdx); });
+        }
+    }
+
     m_multiThreadTaskManager->executeJobsForThreadGroup(m_beforeFrameAndRecordThreadGroupId);
     m_multiThreadTaskManager->waitForThreadGroup(m_beforeFrameAndRecordThreadGroupId);
+
+    // Each wave of completed external jobs starts their ready successors, no other job of the execution is running meanwhile
+    while (pendingExternalJobCount > 0)
+    {
+        std::vector<uint32_t> completedExternalJobs;
+        {
+            JobsTelemetry::ThreadTimeScope waitTimeScope(JobsTelemetry::ThreadState::WAIT);
+            std::unique_lock<std::mutex> lock(m_jobNodesMutex);
+            m_externalJobCompletedCondition.wait(lock, [this] { return !m_completedExternalJobs.empty(); });
+            completedExternalJobs.swap(m_completedExternalJobs);
+        }
+        pendingExternalJobCount -= static_cast<uint32_t>(completedExternalJobs.size());
+
+        for (uint32_t externalJobIdx : completedExternalJobs)
+        {
+            for (uint32_t successorIdx : jobNodes[externalJobIdx].m_successors)
+            {
+                if (jobNodes[successorIdx].m_remainingDependencyCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    m_multiThreadTaskManager->addJobToThreadGroup(m_beforeFrameAndRecordThreadGroupId, [this, executionIdx, successorIdx]() { runJobNode(executionIdx, successorIdx); });
+                }
+            }
+        }
+
+        m_multiThreadTaskManager->executeJobsForThreadGroup(m_beforeFrameAndRecordThreadGroupId);
+        m_multiThreadTaskManager->waitForThreadGroup(m_beforeFrameAndRecordThreadGroupId);
+    }
+
+    m_telemetry->onFrameEnded();
 }
 
-Wolf::JobsManager::AddedJobStatus Wolf::JobsManager::addStreamingJob(const MultiThreadTaskManager::Job& job)
+void Wolf::JobsManager::startJobsBeforeFrame(uint32_t cpuFrameNumber)
 {
     PROFILE_FUNCTION
 
-    m_streamingMutex.lock();
-    bool needNotify = m_streamingJobs.empty();
-    m_streamingJobs.emplace(job);
-    m_streamingMutex.unlock();
+    {
+        std::lock_guard<std::mutex> lock(m_beforeFrameDriverMutex);
+        if (m_beforeFrameJobsStarted)
+        {
+            Debug::sendError("Before frame jobs are already started");
+            return;
+        }
+
+        if (!m_beforeFrameDriverThread.joinable())
+            m_beforeFrameDriverThread = std::thread(&JobsManager::beforeFrameDriverExecution, this);
+        m_beforeFrameJobsStarted = true;
+
+        // Begun here so jobs added once this returns are for the next execution and handles of this one can be waited for right away
+        m_startedExecutionIdx = beginJobGraphExecution(cpuFrameNumber, m_startedExecutionPendingExternalJobCount);
+    }
+    m_beforeFrameDriverCondition.notify_all();
+}
 
-    if (needNotify)
+void Wolf::JobsManager::waitJobsBeforeFrame()
+{
+    PROFILE_FUNCTION
+
+    JobsTelemetry::ThreadTimeScope waitTimeScope(JobsTelemetry::ThreadState::WAIT);
+    std::unique_lock<std::mutex> lock(m_beforeFrameDriverMutex);
+    m_beforeFrameDriverCondition.wait(lock, [this] { return !m_beforeFrameJobsStarted; });
+}
+
+bool Wolf::JobsManager::areJobsBeforeFrameStarted() const
+{
+    std::lock_guard<std::mutex> lock(m_beforeFrameDriverMutex);
+    return m_beforeFrameJobsStarted;
+}
+
+void Wolf::JobsManager::beforeFrameDriverExecution()
+{
+    const std::string threadName = "BeforeFrame driver";
+    setCurrentThreadName(threadName);
+    m_telemetry->registerCurrentThread(threadName);
+
+    for (;;)
     {
-        m_streamingRunCondition.notify_all();
+        uint64_t executionIdx;
+        uint32_t pendingExternalJobCount;
+        {
+            std::unique_lock<std::mutex> lock(m_beforeFrameDriverMutex);
+            m_beforeFrameDriverCondition.wait(lock, [this] { return m_beforeFrameJobsStarted || m_stopBeforeFrameDriverRequested; });
+
+            if (m_stopBeforeFrameDriverRequested)
+                break;
+            executionIdx = m_startedExecutionIdx;
+            pendingExternalJobCount = m_startedExecutionPendingExternalJobCount;
+        }
+
+        executeJobGraph(executionIdx, pendingExternalJobCount);
+
+        {
+            std::lock_guard<std::mutex> lock(m_beforeFrameDriverMutex);
+            m_beforeFrameJobsStarted = false;
+        }
+        m_beforeFrameDriverCondition.notify_all();
     }
+}
+
+void Wolf::JobsManager::waitForJob(const JobHandle& handle)
+{
+    PROFILE_FUNCTION
+
+    if (handle.isValid() && handle.m_executionIdx >= m_nextExecutionIdx.load(std::memory_order_acquire))
+    {
+        Debug::sendError("Waiting for a job which hasn't been submitted yet");
+        return;
+    }
+
+    JobsTelemetry::ThreadTimeScope waitTimeScope(JobsTelemetry::ThreadState::WAIT);
+    while (!isJobCompleted(handle))
+    {
+        if (m_multiThreadTaskManager->helpThreadGroup(m_beforeFrameAndRecordThreadGroupId))
+            continue;
+
+        // Nothing to help with, sleeps until the job completes. Its node isn't cleared meanwhile as the execution lasts until then
+        const std::atomic<bool>* completed;
+        {
+            std::lock_guard<std::mutex> lock(m_jobNodesMutex);
+            if (handle.m_executionIdx + 1 != m_nextExecutionIdx.load(std::memory_order_relaxed))
+                continue;
+            completed = &m_jobNodes[handle.m_executionIdx % 2][handle.m_jobIdx].m_completed;
+        }
+        completed->wait(false, std::memory_order_acquire);
+    }
+}
+
+bool Wolf::JobsManager::isJobCompleted(const JobHandle& handle) const
+{
+    if (!handle.isValid())
+        return true;
+
+    // Nodes of the last execution are cleared when the next one starts
+    std::lock_guard<std::mutex> lock(m_jobNodesMutex);
+
+    const uint64_t nextExecutionIdx = m_nextExecutionIdx.load(std::memory_order_relaxed);
+    if (handle.m_executionIdx + 1 < nextExecutionIdx)
+        return true;
+    if (handle.m_executionIdx + 1 > nextExecutionIdx)
+        return false;
+
+    return m_jobNodes[handle.m_executionIdx % 2][handle.m_jobIdx].m_completed.load(std::memory_order_acquire);
+}
+
+void Wolf::JobsManager::runJobNode(uint64_t executionIdx, uint32_t jobIdx)
+{
+    JobNode& jobNode = m_jobNodes[executionIdx % 2][jobIdx];
+    RuntimeContext::CPUFrameNumberOverrideScope cpuFrameNumberOverrideScope(m_cpuFrameNumberOverrides[executionIdx % 2]);
+    if (m_telemetry->isEnabled())
+    {
+        const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        jobNode.m_job();
+        m_telemetry->onJobExecuted(JobsTelemetry::QueueType::BEFORE_FRAME, jobNode.m_tag, std::chrono::steady_clock::now() - startTime);
+    }
+    else
+    {
+        jobNode.m_job();
+    }
+    jobNode.m_completed.store(true, std::memory_order_release);
+
+    for (uint32_t successorIdx : jobNode.m_successors)
+    {
+        JobNode& successor = m_jobNodes[executionIdx % 2][successorIdx];
+        if (successor.m_remainingDependencyCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_multiThreadTaskManager->spawnJobInThreadGroup(m_beforeFrameAndRecordThreadGroupId, [this, executionIdx, successorIdx]() { runJobNode(executionIdx, successorIdx); });
+        }
+    }
+
+    // Woken up waiters can help with the successors
+    jobNode.m_completed.notify_all();
+}
+
+void Wolf::JobsManager::parallelFor(uint32_t chunkCount, const MultiThreadTaskManager::ChunkFunction& function)
+{
+    m_multiThreadTaskManager->parallelForInThreadGroup(m_beforeFrameAndRecordThreadGroupId, chunkCount, function);
+}
+
+uint32_t Wolf::JobsManager::getParallelThreadCount() const
+{
+    return m_multiThreadTaskManager->getThreadCountInThreadGroup(m_beforeFrameAndRecordThreadGroupId) + 1;
+}
+
+Wolf::JobsManager::AddedJobStatus Wolf::JobsManager::addStreamingJob(MultiThreadTaskManager::Job&& job, uint32_t priority, StreamingJobToken* outToken, const char* tag)
+{
+    PROFILE_FUNCTION
+
+    if (outToken)
+        *outToken = INVALID_STREAMING_JOB_TOKEN;
+
+    {
+        std::lock_guard<std::mutex> lock(m_streamingMutex);
+        // Resumed tasks were already accepted when they started, they don't take the place of new jobs
+        if (m_streamingJobs.size() - m_pendingAsyncTaskResumeCount >= m_maxPendingStreamingJobCount || m_stopStreamingThreadRequested)
+        {
+            return AddedJobStatus::REJECTED;
+        }
+
+        const StreamingJobToken token = pushStreamingJob(std::move(job), priority, tag, false);
+        if (outToken)
+            *outToken = token;
+    }
+
+    m_streamingRunCondition.notify_one();
 
     return AddedJobStatus::SUCCESS;
 }
 
-#ifdef _WIN32
-#include <windows.h>
-#endif
-void Wolf::JobsManager::streamingExecution()
+Wolf::JobsManager::AddedJobStatus Wolf::JobsManager::addStreamingAsyncTask(AsyncTask&& task, uint32_t priority, StreamingJobToken* outToken)
+{
+    // Task is destroyed with the job if it's cancelled before being started
+    return addStreamingJob([task = std::move(task)]() mutable { task.start(); }, priority, outToken, "Async task start");
+}
+
+void Wolf::JobsManager::resumeAsyncTask(std::coroutine_handle<> handle)
+{
+    {
+        // Never rejected, the task would be lost
+        std::lock_guard<std::mutex> lock(m_streamingMutex);
+        pushStreamingJob([handle]() { handle.resume(); }, RESUMED_ASYNC_TASK_PRIORITY, "Async task resume", true);
+    }
+
+    m_streamingRunCondition.notify_one();
+}
+
+Wolf::AsyncFileReader::ReadAwaiter Wolf::JobsManager::readFileAsync(const std::string& path, uint64_t offset, uint64_t size)
+{
+    return m_asyncFileReader->read(path, offset, size);
+}
+
+bool Wolf::JobsManager::cancelStreamingJob(StreamingJobToken token)
+{
+    std::lock_guard<std::mutex> lock(m_streamingMutex);
+
+    auto it = m_streamingJobPriorities.find(token);
+    if (it == m_streamingJobPriorities.end())
+        return false;
+
+    m_streamingJobs.erase(StreamingJobKey{ it->second, token });
+    m_streamingJobPriorities.erase(it);
+    return true;
+}
+
+bool Wolf::JobsManager::changeStreamingJobPriority(StreamingJobToken token, uint32_t newPriority)
 {
-    std::string threadName = "Streaming thread";
+    std::lock_guard<std::mutex> lock(m_streamingMutex);
 
-#ifdef _WIN32
-    std::wstring wName = std::wstring(threadName.begin(), threadName.end());
-    LPCWSTR swName = wName.c_str();
-    SetThreadDescription(GetCurrentThread(), swName);
-#endif
+    auto it = m_streamingJobPriorities.find(token);
+    if (it == m_streamingJobPriorities.end())
+        return false;
+
+    // Token is kept so the job stays ordered by submission among jobs of the new priority
+    auto streamingJob = m_streamingJobs.extract(StreamingJobKey{ it->second, token });
+    streamingJob.key().m_priority = newPriority;
+    m_streamingJobs.insert(std::move(streamingJob));
+    it->second = newPriority;
+    return true;
+}
+
+void Wolf::JobsManager::streamingExecution(uint32_t threadIdx, const CPUAffinity& affinity)
+{
+    const std::string threadName = "Streaming " + std::to_string(threadIdx);
+    setCurrentThreadName(threadName);
+    setCurrentThreadAffinity(affinity);
+    m_telemetry->registerCurrentThread(threadName);
 
     for (;;)
     {
-        MultiThreadTaskManager::Job job;
+        StreamingJob streamingJob;
 
         {
             PROFILE_SCOPED("Streaming thread execution wait")
+            JobsTelemetry::ThreadTimeScope idleTimeScope(JobsTelemetry::ThreadState::IDLE);
 
             std::unique_lock<std::mutex> lock(m_streamingMutex);
 
@@ -80,27 +512,52 @@ void Wolf::JobsManager::streamingExecution()
                 break;
             }
 
-            job = std::move(m_streamingJobs.front());
-            m_streamingJobs.pop();
+            streamingJob = popFirstStreamingJob();
         }
 
         PROFILE_SCOPED("Streaming jobs execution")
+        JobsTelemetry::ThreadTimeScope busyTimeScope(JobsTelemetry::ThreadState::BUSY);
 
-        job();
-
-        for (;;)
+        // Telemetry may have been enabled after the job was added
+        if (m_telemetry->isEnabled() && streamingJob.m_addTime != std::chrono::steady_clock::time_point())
         {
-            {
-                std::lock_guard<std::mutex> lock(m_streamingMutex);
-                if (m_streamingJobs.empty())
-                {
-                    break;
-                }
-                job = std::move(m_streamingJobs.front());
-                m_streamingJobs.pop();
-            }
+            const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+            streamingJob.m_job();
+            const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
 
-            job();
+            m_telemetry->onJobExecuted(JobsTelemetry::QueueType::STREAMING, streamingJob.m_tag, endTime - startTime);
+            m_telemetry->onStreamingJobExecuted(startTime - streamingJob.m_addTime, endTime - startTime);
+        }
+        else
+        {
+            streamingJob.m_job();
         }
     }
 }
+
+Wolf::JobsManager::StreamingJobToken Wolf::JobsManager::pushStreamingJob(MultiThreadTaskManager::Job&& job, uint32_t priority, const char* tag, bool isAsyncTaskResume)
+{
+    const StreamingJobToken token = m_nextStreamingJobToken++;
+    // Add time is only read when telemetry is enabled
+    const std::chrono::steady_clock::time_point addTime = m_telemetry->isEnabled() ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    StreamingJob streamingJob{ std::move(job), tag, addTime, isAsyncTaskResume };
+    m_streamingJobs.emplace(StreamingJobKey{ priority, token }, std::move(streamingJob));
+    m_streamingJobPriorities[token] = priority;
+    if (isAsyncTaskResume)
+        m_pendingAsyncTaskResumeCount++;
+    m_telemetry->onQueueDepth(JobsTelemetry::QueueType::STREAMING, static_cast<uint32_t>(m_streamingJobs.size()));
+
+    return token;
+}
+
+Wolf::JobsManager::StreamingJob Wolf::JobsManager::popFirstStreamingJob()
+{
+    auto firstStreamingJob = m_streamingJobs.begin();
+    StreamingJob streamingJob = std::move(firstStreamingJob->second);
+    m_streamingJobPriorities.erase(firstStreamingJob->first.m_token);
+    m_streamingJobs.erase(firstStreamingJob);
+    if (streamingJob.m_isAsyncTaskResume)
+        m_pendingAsyncTaskResumeCount--;
+
+    return streamingJob;
+}
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <map>
+#include <span>
+#include <unordered_map>
+
+#include "AsyncFileReader.h"
+#include "AsyncTask.h"
 #include "MultiThreadTaskManager.h"
 
 namespace Wolf
@@ -7,26 +13,151 @@ namespace Wolf
     class JobsManager
     {
     public:
-        JobsManager(uint32_t threadCountBeforeFrameAndRecord);
+        // Thread counts can be AUTOMATIC_THREAD_COUNT to be computed from the CPUs available to the process
+        static constexpr uint32_t AUTOMATIC_THREAD_COUNT = static_cast<uint32_t>(-1);
+        JobsManager(uint32_t threadCountBeforeFrameAndRecord, uint32_t streamingThreadCount = 1, uint32_t maxPendingStreamingJobCount = DEFAULT_MAX_PENDING_STREAMING_JOB_COUNT,
+            const CPUAffinity& beforeFrameAndRecordAffinity = {}, const CPUAffinity& streamingAffinity = {});
         ~JobsManager();
 
-        void addJobBeforeFrame(const MultiThreadTaskManager::Job& job);
+        // A handle refers to a job of a single execution of the before frame jobs
+        struct JobHandle
+        {
+            static constexpr uint32_t INVALID_JOB_IDX = static_cast<uint32_t>(-1);
+
+            uint64_t m_executionIdx = 0;
+            uint32_t m_jobIdx = INVALID_JOB_IDX;
+
+            [[nodiscard]] bool isValid() const { return m_jobIdx != INVALID_JOB_IDX; }
+        };
+
+        // Job starts once all dependencies added for the same execution are completed, dependencies from previous executions are already completed.
+        // Tag is used to group job durations in the telemetry, it must be a string literal
+        JobHandle addJobBeforeFrame(MultiThreadTaskManager::Job&& job, std::span<const JobHandle> dependencies = {}, const char* tag = nullptr);
+        JobHandle addContinuationBeforeFrame(const JobHandle& parent, MultiThreadTaskManager::Job&& job, const char* tag = nullptr);
+        // External jobs have no work, they are completed by completeExternalJob() from any thread and let other jobs wait for an event (like a GPU frame end).
+        // An execution only ends once all its external jobs are completed, they must be completed before executeJobsBeforeFrame() is called by the same thread
+        JobHandle addExternalJobBeforeFrame(const char* tag = nullptr);
+        void completeExternalJob(const JobHandle& handle);
         void executeJobsBeforeFrame();
 
+        // Same execution done by a dedicated thread, the calling thread is free until waitJobsBeforeFrame().
+        // Jobs (and parallel for they run) see cpuFrameNumber as the current CPU frame number. Jobs added meanwhile are for the next execution
+        void startJobsBeforeFrame(uint32_t cpuFrameNumber);
+        void waitJobsBeforeFrame();
+        [[nodiscard]] bool areJobsBeforeFrameStarted() const;
+
+        // From the main thread or from a before frame job. Other jobs are executed while waiting
+        void waitForJob(const JobHandle& handle);
+        [[nodiscard]] bool isJobCompleted(const JobHandle& handle) const;
+
+        // Executed by the calling thread with the help of idle before frame workers, see ParallelFor.h
+        void parallelFor(uint32_t chunkCount, const MultiThreadTaskManager::ChunkFunction& function);
+        [[nodiscard]] uint32_t getParallelThreadCount() const;
+
+        // Streaming jobs with the highest priority are executed first, jobs with the same priority are executed in the order they have been added.
+        // Jobs are rejected when the pending jobs count reaches the limit given at creation
+        static constexpr uint32_t DEFAULT_MAX_PENDING_STREAMING_JOB_COUNT = 1024;
+        using StreamingJobToken = uint64_t;
+        static constexpr StreamingJobToken INVALID_STREAMING_JOB_TOKEN = 0;
         enum class AddedJobStatus { SUCCESS, REJECTED };
-        AddedJobStatus addStreamingJob(const MultiThreadTaskManager::Job& job);
+        AddedJobStatus addStreamingJob(MultiThreadTaskManager::Job&& job, uint32_t priority = 0, StreamingJobToken* outToken = nullptr, const char* tag = nullptr);
+
+        // Both return false if the job has already started or doesn't exist anymore
+        bool cancelStreamingJob(StreamingJobToken token);
+        bool changeStreamingJobPriority(StreamingJobToken token, uint32_t newPriority);
+
+        // Async tasks are started like streaming jobs (same priority, limit and cancellation until started).
+        // A suspended task doesn't hold any thread, it's resumed on a streaming thread before other streaming jobs. Pending resumes don't count in the limit
+        // Tasks still suspended when the manager is destroyed are resumed on the destroying thread, their pending reads fail
+        AddedJobStatus addStreamingAsyncTask(AsyncTask&& task, uint32_t priority = 0, StreamingJobToken* outToken = nullptr);
+        void resumeAsyncTask(std::coroutine_handle<> handle);
+        [[nodiscard]] AsyncFileReader::ReadAwaiter readFileAsync(const std::string& path, uint64_t offset = 0, uint64_t size = AsyncFileReader::WHOLE_FILE);
+
+        // Disabled by default
+        [[nodiscard]] ResourceNonOwner<JobsTelemetry> getTelemetry() { return m_telemetry.createNonOwnerResource(); }
 
     private:
+        // Declared first as threads report to it until they are stopped
+        ResourceUniqueOwner<JobsTelemetry> m_telemetry;
         ResourceUniqueOwner<MultiThreadTaskManager> m_multiThreadTaskManager;
         MultiThreadTaskManager::ThreadGroupId m_beforeFrameAndRecordThreadGroupId;
 
+        // Before frame jobs graph
+        uint64_t beginJobGraphExecution(uint32_t cpuFrameNumberOverride, uint32_t& outPendingExternalJobCount);
+        void executeJobGraph(uint64_t executionIdx, uint32_t pendingExternalJobCount);
+        void runJobNode(uint64_t executionIdx, uint32_t jobIdx);
+
+        struct JobNode
+        {
+            JobNode(MultiThreadTaskManager::Job&& job, const char* tag) : m_job(std::move(job)), m_tag(tag) {}
+
+            MultiThreadTaskManager::Job m_job;
+            const char* m_tag;
+            bool m_isExternal = false;
+            std::vector<uint32_t> m_successors;
+            std::atomic<uint32_t> m_remainingDependencyCount = 0;
+            std::atomic<bool> m_completed = false;
+        };
+        // Jobs being added and jobs of the last execution, indexed by execution index parity
+        std::array<std::deque<JobNode>, 2> m_jobNodes;
+        std::array<uint32_t, 2> m_cpuFrameNumberOverrides = { RuntimeContext::NO_CPU_FRAME_NUMBER_OVERRIDE, RuntimeContext::NO_CPU_FRAME_NUMBER_OVERRIDE };
+        mutable std::mutex m_jobNodesMutex;
+        std::atomic<uint64_t> m_nextExecutionIdx = 1;
+
+        // External jobs of the running execution completed since its last wave of jobs, protected by m_jobNodesMutex
+        std::vector<uint32_t> m_completedExternalJobs;
+        std::condition_variable m_externalJobCompletedCondition;
+
+        // Thread executing the before frame jobs when started, created on first use
+        void beforeFrameDriverExecution();
+        std::thread m_beforeFrameDriverThread;
+        mutable std::mutex m_beforeFrameDriverMutex;
+        std::condition_variable m_beforeFrameDriverCondition;
+        bool m_beforeFrameJobsStarted = false;
+        uint64_t m_startedExecutionIdx = 0;
+        uint32_t m_startedExecutionPendingExternalJobCount = 0;
+        bool m_stopBeforeFrameDriverRequested = false;
+
         // Streaming
-        void streamingExecution();
+        void streamingExecution(uint32_t threadIdx, const CPUAffinity& affinity);
+        StreamingJobToken pushStreamingJob(MultiThreadTaskManager::Job&& job, uint32_t priority, const char* tag, bool isAsyncTaskResume); // m_streamingMutex must be locked
 
-        std::queue<MultiThreadTaskManager::Job> m_streamingJobs;
-        std::thread m_streamingThread;
+        struct StreamingJobKey
+        {
+            uint32_t m_priority;
+            StreamingJobToken m_token;
+
+            bool operator<(const StreamingJobKey& other) const
+            {
+                if (m_priority != other.m_priority)
+                    return m_priority > other.m_priority;
+                return m_token < other.m_token;
+            }
+        };
+        struct StreamingJob
+        {
+            MultiThreadTaskManager::Job m_job;
+            const char* m_tag = nullptr;
+            std::chrono::steady_clock::time_point m_addTime; // only set when telemetry is enabled
+            bool m_isAsyncTaskResume = false; // still executed when the manager is destroyed
+        };
+        StreamingJob popFirstStreamingJob(); // m_streamingMutex must be locked, m_streamingJobs mustn't be empty
+        std::map<StreamingJobKey, StreamingJob> m_streamingJobs;
+        std::unordered_map<StreamingJobToken, uint32_t /* priority */> m_streamingJobPriorities;
+        uint32_t m_pendingAsyncTaskResumeCount = 0; // in m_streamingJobs, not limited by m_maxPendingStreamingJobCount
+        StreamingJobToken m_nextStreamingJobToken = INVALID_STREAMING_JOB_TOKEN + 1;
+        uint32_t m_maxPendingStreamingJobCount;
+
+        std::vector<std::thread> m_streamingThreads;
         std::mutex m_streamingMutex;
         std::condition_variable m_streamingRunCondition;
         bool m_stopStreamingThreadRequested = false;
+
+        // Async tasks
+        static constexpr uint32_t RESUMED_ASYNC_TASK_PRIORITY = static_cast<uint32_t>(-1);
+        static constexpr uint32_t ASYNC_FILE_READ_THREAD_COUNT = 4;
+        ResourceUniqueOwner<AsyncFileReader> m_asyncFileReader;
     };
+
+    extern JobsManager* g_jobsManager;
 }
@@ -0,0 +1,250 @@
+#include "JobsTelemetry.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "ProfilerCommon.h"
+
+struct Wolf::JobsTelemetry::ThreadTelemetry
+{
+	JobsTelemetry* m_telemetry;
+	std::string m_name;
+	std::string m_busyRatioPlotName;
+
+	std::array<std::atomic<uint64_t>, static_cast<size_t>(ThreadState::COUNT)> m_timesNs{};
+	std::atomic<uint64_t> m_executedJobCount = 0;
+
+	// Only used by onFrameEnded() to plot the busy ratio of the frame
+	std::array<uint64_t, static_cast<size_t>(ThreadState::COUNT)> m_lastFrameTimesNs{};
+
+	// Only used by the thread itself
+	ThreadTimeScope* m_innermostScope = nullptr;
+
+	ThreadTelemetry(JobsTelemetry* telemetry, const std::string& name) : m_telemetry(telemetry), m_name(name), m_busyRatioPlotName(name + " busy ratio") {}
+};
+
+thread_local Wolf::JobsTelemetry::ThreadTelemetry* Wolf::JobsTelemetry::s_currentThreadTelemetry = nullptr;
+
+Wolf::JobsTelemetry::JobsTelemetry() = default;
+
+Wolf::JobsTelemetry::~JobsTelemetry()
+{
+	// Threads registered by the job system are stopped at this point, only the owner thread can still refer to this telemetry
+	if (s_currentThreadTelemetry && s_currentThreadTelemetry->m_telemetry == this)
+		s_currentThreadTelemetry = nullptr;
+}
+
+void Wolf::JobsTelemetry::registerCurrentThread(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+	s_currentThreadTelemetry = m_threads.emplace_back(new ThreadTelemetry(this, name)).get();
+}
+
+void Wolf::JobsTelemetry::unregisterCurrentThread()
+{
+	s_currentThreadTelemetry = nullptr;
+}
+
+Wolf::JobsTelemetry::ThreadTimeScope::ThreadTimeScope(ThreadState state) : m_threadTelemetry(s_currentThreadTelemetry), m_state(state)
+{
+	if (!m_threadTelemetry || !m_threadTelemetry->m_telemetry->isEnabled())
+	{
+		m_threadTelemetry = nullptr;
+		return;
+	}
+
+	m_startTime = std::chrono::steady_clock::now();
+	m_outerScope = m_threadTelemetry->m_innermostScope;
+	if (m_outerScope)
+		m_outerScope->addTimeUntil(m_startTime);
+	m_threadTelemetry->m_innermostScope = this;
+}
+
+Wolf::JobsTelemetry::ThreadTimeScope::~ThreadTimeScope()
+{
+	if (!m_threadTelemetry)
+		return;
+
+	const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+	addTimeUntil(endTime);
+	m_threadTelemetry->m_innermostScope = m_outerScope;
+	if (m_outerScope)
+		m_outerScope->m_startTime = endTime;
+}
+
+void Wolf::JobsTelemetry::ThreadTimeScope::addTimeUntil(std::chrono::steady_clock::time_point endTime) const
+{
+	const uint64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - m_startTime).count();
+	m_threadTelemetry->m_timesNs[static_cast<size_t>(m_state)].fetch_add(durationNs, std::memory_order_relaxed);
+}
+
+void Wolf::JobsTelemetry::onQueueDepth(QueueType queueType, uint32_t depth)
+{
+	if (!isEnabled())
+		return;
+
+	std::atomic<uint32_t>& highWaterMark = m_queueDepthHighWaterMarks[static_cast<size_t>(queueType)];
+	uint32_t currentHighWaterMark = highWaterMark.load(std::memory_order_relaxed);
+	while (depth > currentHighWaterMark && !highWaterMark.compare_exchange_weak(currentHighWaterMark, depth, std::memory_order_relaxed))
+	{
+	}
+}
+
+void Wolf::JobsTelemetry::onJobExecuted(QueueType queueType, const char* tag, std::chrono::steady_clock::duration duration)
+{
+	if (!isEnabled())
+		return;
+
+	if (s_currentThreadTelemetry)
+		s_currentThreadTelemetry->m_executedJobCount.fetch_add(1, std::memory_order_relaxed);
+	if (queueType == QueueType::BEFORE_FRAME)
+		m_currentFrameExecutedJobCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (!tag)
+		return;
+
+	const uint64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	const uint32_t bucketIdx = computeHistogramBucketIdx(duration);
+
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	TagStats& tagStats = m_tags[tag];
+	addLatency(tagStats.m_duration, durationNs);
+	tagStats.m_histogram[bucketIdx]++;
+}
+
+void Wolf::JobsTelemetry::onStreamingJobExecuted(std::chrono::steady_clock::duration queueDuration, std::chrono::steady_clock::duration executionDuration)
+{
+	if (!isEnabled())
+		return;
+
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	addLatency(m_streamingQueueLatency, std::chrono::duration_cast<std::chrono::nanoseconds>(queueDuration).count());
+	addLatency(m_streamingExecutionLatency, std::chrono::duration_cast<std::chrono::nanoseconds>(executionDuration).count());
+}
+
+void Wolf::JobsTelemetry::onFrameEnded()
+{
+	if (!isEnabled())
+		return;
+
+	const uint32_t frameExecutedJobCount = m_currentFrameExecutedJobCount.exchange(0, std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(m_statsMutex);
+		m_frameCount++;
+		m_lastFrameExecutedJobCount = frameExecutedJobCount;
+		m_maxFrameExecutedJobCount = std::max(m_maxFrameExecutedJobCount, frameExecutedJobCount);
+	}
+
+	PROFILE_PLOT("Jobs per frame", static_cast<int64_t>(frameExecutedJobCount))
+
+	std::lock_guard<std::mutex> lock(m_threadsMutex);
+	for (std::unique_ptr<ThreadTelemetry>& threadTelemetry : m_threads)
+	{
+		uint64_t frameTotalTimeNs = 0;
+		std::array<uint64_t, static_cast<size_t>(ThreadState::COUNT)> frameTimesNs;
+		for (uint32_t stateIdx = 0; stateIdx < frameTimesNs.size(); ++stateIdx)
+		{
+			const uint64_t timeNs = threadTelemetry->m_timesNs[stateIdx].load(std::memory_order_relaxed);
+			frameTimesNs[stateIdx] = timeNs - threadTelemetry->m_lastFrameTimesNs[stateIdx];
+			threadTelemetry->m_lastFrameTimesNs[stateIdx] = timeNs;
+			frameTotalTimeNs += frameTimesNs[stateIdx];
+		}
+
+		if (frameTotalTimeNs > 0)
+		{
+			PROFILE_PLOT(threadTelemetry->m_busyRatioPlotName.c_str(), static_cast<double>(frameTimesNs[static_cast<size_t>(ThreadState::BUSY)]) / static_cast<double>(frameTotalTimeNs))
+		}
+	}
+}
+
+uint32_t Wolf::JobsTelemetry::computeHistogramBucketIdx(std::chrono::steady_clock::duration duration)
+{
+	const int64_t durationUs = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	if (durationUs <= 1)
+		return 0;
+
+	return std::min(static_cast<uint32_t>(std::bit_width(static_cast<uint64_t>(durationUs))) - 1, HISTOGRAM_BUCKET_COUNT - 1);
+}
+
+Wolf::JobsTelemetry::Snapshot Wolf::JobsTelemetry::getSnapshot() const
+{
+	Snapshot snapshot;
+
+	{
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+		snapshot.m_threads.reserve(m_threads.size());
+		for (const std::unique_ptr<ThreadTelemetry>& threadTelemetry : m_threads)
+		{
+			ThreadStats& threadStats = snapshot.m_threads.emplace_back();
+			threadStats.m_name = threadTelemetry->m_name;
+			for (uint32_t stateIdx = 0; stateIdx < threadStats.m_timesNs.size(); ++stateIdx)
+			{
+				threadStats.m_timesNs[stateIdx] = threadTelemetry->m_timesNs[stateIdx].load(std::memory_order_relaxed);
+			}
+			threadStats.m_executedJobCount = threadTelemetry->m_executedJobCount.load(std::memory_order_relaxed);
+		}
+	}
+
+	for (uint32_t queueTypeIdx = 0; queueTypeIdx < m_queueDepthHighWaterMarks.size(); ++queueTypeIdx)
+	{
+		snapshot.m_queueDepthHighWaterMarks[queueTypeIdx] = m_queueDepthHighWaterMarks[queueTypeIdx].load(std::memory_order_relaxed);
+	}
+
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	snapshot.m_frameCount = m_frameCount;
+	snapshot.m_lastFrameExecutedJobCount = m_lastFrameExecutedJobCount;
+	snapshot.m_maxFrameExecutedJobCount = m_maxFrameExecutedJobCount;
+	snapshot.m_streamingQueueLatency = m_streamingQueueLatency;
+	snapshot.m_streamingExecutionLatency = m_streamingExecutionLatency;
+
+	// Same tag may come from different string literals
+	for (const auto& [tag, tagStats] : m_tags)
+	{
+		TagStats& snapshotTagStats = snapshot.m_tags[tag];
+		snapshotTagStats.m_duration.m_count += tagStats.m_duration.m_count;
+		snapshotTagStats.m_duration.m_totalNs += tagStats.m_duration.m_totalNs;
+		snapshotTagStats.m_duration.m_maxNs = std::max(snapshotTagStats.m_duration.m_maxNs, tagStats.m_duration.m_maxNs);
+		for (uint32_t bucketIdx = 0; bucketIdx < HISTOGRAM_BUCKET_COUNT; ++bucketIdx)
+		{
+			snapshotTagStats.m_histogram[bucketIdx] += tagStats.m_histogram[bucketIdx];
+		}
+	}
+
+	return snapshot;
+}
+
+void Wolf::JobsTelemetry::reset()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+		for (std::unique_ptr<ThreadTelemetry>& threadTelemetry : m_threads)
+		{
+			for (std::atomic<uint64_t>& timeNs : threadTelemetry->m_timesNs)
+			{
+				timeNs.store(0, std::memory_order_relaxed);
+			}
+			threadTelemetry->m_executedJobCount.store(0, std::memory_order_relaxed);
+			threadTelemetry->m_lastFrameTimesNs.fill(0);
+		}
+	}
+
+	for (std::atomic<uint32_t>& highWaterMark : m_queueDepthHighWaterMarks)
+	{
+		highWaterMark.store(0, std::memory_order_relaxed);
+	}
+
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	m_frameCount = 0;
+	m_lastFrameExecutedJobCount = 0;
+	m_maxFrameExecutedJobCount = 0;
+	m_streamingQueueLatency = {};
+	m_streamingExecutionLatency = {};
+	m_tags.clear();
+}
+
+void Wolf::JobsTelemetry::addLatency(LatencyStats& latencyStats, uint64_t durationNs)
+{
+	latencyStats.m_count++;
+	latencyStats.m_totalNs += durationNs;
+	latencyStats.m_maxNs = std::max(latencyStats.m_maxNs, durationNs);
+}
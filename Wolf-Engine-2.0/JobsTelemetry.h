@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Wolf
+{
+	// Statistics of the job system threads. Nothing is measured while disabled, the cost is then a thread local read and a relaxed load.
+	// Threads are registered by the job system when they start, time and jobs are attributed to the calling thread.
+	class JobsTelemetry
+	{
+		struct ThreadTelemetry;
+
+	public:
+		JobsTelemetry();
+		JobsTelemetry(const JobsTelemetry&) = delete;
+		~JobsTelemetry();
+
+		void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+		[[nodiscard]] bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+		void registerCurrentThread(const std::string& name);
+		static void unregisterCurrentThread();
+
+		// BUSY: executing jobs, IDLE: waiting for jobs, WAIT: blocked until other jobs are completed.
+		// Scopes can be nested (a job waiting for another one), time is only counted in the state of the innermost scope
+		enum class ThreadState { BUSY, IDLE, WAIT, COUNT };
+		class ThreadTimeScope
+		{
+		public:
+			explicit ThreadTimeScope(ThreadState state);
+			ThreadTimeScope(const ThreadTimeScope&) = delete;
+			~ThreadTimeScope();
+
+		private:
+			void addTimeUntil(std::chrono::steady_clock::time_point endTime) const;
+
+			ThreadTelemetry* m_threadTelemetry;
+			ThreadState m_state;
+			std::chrono::steady_clock::time_point m_startTime;
+			ThreadTimeScope* m_outerScope = nullptr; // paused until this scope ends
+		};
+
+		enum class QueueType { BEFORE_FRAME, STREAMING, COUNT };
+		void onQueueDepth(QueueType queueType, uint32_t depth);
+
+		// Tags must be string literals (or outlive the telemetry), untagged jobs are only counted
+		void onJobExecuted(QueueType queueType, const char* tag, std::chrono::steady_clock::duration duration);
+		void onStreamingJobExecuted(std::chrono::steady_clock::duration queueDuration, std::chrono::steady_clock::duration executionDuration);
+		// Called once all before frame jobs are executed, also sends Tracy plots
+		void onFrameEnded();
+
+		// Bucket i counts durations in [2^i, 2^(i+1)) microseconds, the first one includes shorter durations and the last one longer durations
+		static constexpr uint32_t HISTOGRAM_BUCKET_COUNT = 20;
+		static uint32_t computeHistogramBucketIdx(std::chrono::steady_clock::duration duration);
+
+		struct ThreadStats
+		{
+			std::string m_name;
+			std::array<uint64_t, static_cast<size_t>(ThreadState::COUNT)> m_timesNs{};
+			uint64_t m_executedJobCount = 0;
+		};
+		struct LatencyStats
+		{
+			uint64_t m_count = 0;
+			uint64_t m_totalNs = 0;
+			uint64_t m_maxNs = 0;
+		};
+		struct TagStats
+		{
+			LatencyStats m_duration;
+			std::array<uint64_t, HISTOGRAM_BUCKET_COUNT> m_histogram{};
+		};
+		struct Snapshot
+		{
+			std::vector<ThreadStats> m_threads;
+			std::array<uint32_t, static_cast<size_t>(QueueType::COUNT)> m_queueDepthHighWaterMarks{};
+
+			uint64_t m_frameCount = 0;
+			uint32_t m_lastFrameExecutedJobCount = 0; // before frame jobs only
+			uint32_t m_maxFrameExecutedJobCount = 0;
+
+			LatencyStats m_streamingQueueLatency; // added to started
+			LatencyStats m_streamingExecutionLatency; // started to finished
+
+			std::map<std::string, TagStats> m_tags;
+		};
+		[[nodiscard]] Snapshot getSnapshot() const;
+		void reset();
+
+	private:
+		static void addLatency(LatencyStats& latencyStats, uint64_t durationNs);
+
+		std::atomic<bool> m_enabled = false;
+
+		mutable std::mutex m_threadsMutex;
+		std::vector<std::unique_ptr<ThreadTelemetry>> m_threads;
+
+		std::array<std::atomic<uint32_t>, static_cast<size_t>(QueueType::COUNT)> m_queueDepthHighWaterMarks{};
+		std::atomic<uint32_t> m_currentFrameExecutedJobCount = 0;
+
+		// Protected by m_statsMutex
+		mutable std::mutex m_statsMutex;
+		uint64_t m_frameCount = 0;
+		uint32_t m_lastFrameExecutedJobCount = 0;
+		uint32_t m_maxFrameExecutedJobCount = 0;
+		LatencyStats m_streamingQueueLatency;
+		LatencyStats m_streamingExecutionLatency;
+		std::unordered_map<const char*, TagStats> m_tags;
+
+		static thread_local ThreadTelemetry* s_currentThreadTelemetry;
+	};
+}
@@ -0,0 +1,465 @@
+#include "KTX2File.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+#include <vulkan/vulkan_core.h>
+
+#include <Debug.h>
+
+namespace
+{
+	constexpr uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+	struct KTX2Header
+	{
+		uint8_t identifier[12];
+		uint32_t vkFormat;
+		uint32_t typeSize;
+		uint32_t pixelWidth;
+		uint32_t pixelHeight;
+		uint32_t pixelDepth;
+		uint32_t layerCount;
+		uint32_t faceCount;
+		uint32_t levelCount;
+		uint32_t supercompressionScheme;
+
+		uint32_t dfdByteOffset;
+		uint32_t dfdByteLength;
+		uint32_t kvdByteOffset;
+		uint32_t kvdByteLength;
+		uint64_t sgdByteOffset;
+		uint64_t sgdByteLength;
+	};
+	static_assert(sizeof(KTX2Header) == 80);
+
+	struct KTX2LevelIndexEntry
+	{
+		uint64_t byteOffset;
+		uint64_t byteLength;
+		uint64_t uncompressedByteLength;
+	};
+	static_assert(sizeof(KTX2LevelIndexEntry) == 24);
+
+	// Same limit as DDS files, keeps size computations far from overflows
+	constexpr uint32_t MAX_SIZE = 65536;
+
+	// Khronos data format descriptor values
+	constexpr uint32_t KHR_DF_VERSION = 2;
+	constexpr uint8_t KHR_DF_MODEL_RGBSDA = 1;
+	constexpr uint8_t KHR_DF_MODEL_BC1A = 128;
+	constexpr uint8_t KHR_DF_MODEL_BC2 = 129;
+	constexpr uint8_t KHR_DF_MODEL_BC3 = 130;
+	constexpr uint8_t KHR_DF_MODEL_BC4 = 131;
+	constexpr uint8_t KHR_DF_MODEL_BC5 = 132;
+	constexpr uint8_t KHR_DF_MODEL_BC6H = 133;
+	constexpr uint8_t KHR_DF_MODEL_BC7 = 134;
+	constexpr uint8_t KHR_DF_PRIMARIES_BT709 = 1;
+	constexpr uint8_t KHR_DF_TRANSFER_LINEAR = 1;
+	constexpr uint8_t KHR_DF_TRANSFER_SRGB = 2;
+	constexpr uint8_t KHR_DF_CHANNEL_RED = 0;
+	constexpr uint8_t KHR_DF_CHANNEL_GREEN = 1;
+	constexpr uint8_t KHR_DF_CHANNEL_BLUE = 2;
+	constexpr uint8_t KHR_DF_CHANNEL_ALPHA = 15;
+	constexpr uint8_t KHR_DF_CHANNEL_BC1A_ALPHA = 1;
+	constexpr uint8_t KHR_DF_SAMPLE_DATATYPE_LINEAR = 0x10;
+	constexpr uint8_t KHR_DF_SAMPLE_DATATYPE_SIGNED = 0x40;
+	constexpr uint8_t KHR_DF_SAMPLE_DATATYPE_FLOAT = 0x80;
+	constexpr uint32_t FLOAT_ONE = 0x3F800000;
+	constexpr uint32_t FLOAT_MINUS_ONE = 0xBF800000;
+
+	using Compression = Wolf::ImageCompression::Compression;
+
+	struct KTX2Format
+	{
+		Wolf::Format format = Wolf::Format::UNDEFINED;
+		VkFormat vkFormat = VK_FORMAT_UNDEFINED;
+		Compression compression = Compression::NO_COMPRESSION;
+		uint32_t texelOrBlockSize = 0;
+		uint32_t typeSize = 1;
+		const char* channels = ""; // in memory order, uncompressed formats only
+	};
+
+	constexpr KTX2Format KTX2_FORMATS[] =
+	{
+		{ Wolf::Format::R8_UNORM,             VK_FORMAT_R8_UNORM,             Compression::NO_COMPRESSION, 1,  1, "R" },
+		{ Wolf::Format::R8G8_UNORM,           VK_FORMAT_R8G8_UNORM,           Compression::NO_COMPRESSION, 2,  1, "RG" },
+		{ Wolf::Format::R8G8B8A8_UNORM,       VK_FORMAT_R8G8B8A8_UNORM,       Compression::NO_COMPRESSION, 4,  1, "RGBA" },
+		{ Wolf::Format::R8G8B8A8_SRGB,        VK_FORMAT_R8G8B8A8_SRGB,        Compression::NO_COMPRESSION, 4,  1, "RGBA" },
+		{ Wolf::Format::B8G8R8A8_UNORM,       VK_FORMAT_B8G8R8A8_UNORM,       Compression::NO_COMPRESSION, 4,  1, "BGRA" },
+		{ Wolf::Format::R16_SFLOAT,           VK_FORMAT_R16_SFLOAT,           Compression::NO_COMPRESSION, 2,  2, "R" },
+		{ Wolf::Format::R16G16_SFLOAT,        VK_FORMAT_R16G16_SFLOAT,        Compression::NO_COMPRESSION, 4,  2, "RG" },
+		{ Wolf::Format::R16G16B16A16_SFLOAT,  VK_FORMAT_R16G16B16A16_SFLOAT,  Compression::NO_COMPRESSION, 8,  2, "RGBA" },
+		{ Wolf::Format::R32_SFLOAT,           VK_FORMAT_R32_SFLOAT,           Compression::NO_COMPRESSION, 4,  4, "R" },
+		{ Wolf::Format::R32G32_SFLOAT,        VK_FORMAT_R32G32_SFLOAT,        Compression::NO_COMPRESSION, 8,  4, "RG" },
+		{ Wolf::Format::R32G32B32A32_SFLOAT,  VK_FORMAT_R32G32B32A32_SFLOAT,  Compression::NO_COMPRESSION, 16, 4, "RGBA" },
+		{ Wolf::Format::BC1_RGB_SRGB_BLOCK,   VK_FORMAT_BC1_RGB_SRGB_BLOCK,   Compression::BC1,            8 },
+		{ Wolf::Format::BC1_RGBA_UNORM_BLOCK, VK_FORMAT_BC1_RGBA_UNORM_BLOCK, Compression::BC1,            8 },
+		{ Wolf::Format::BC2_UNORM_BLOCK,      VK_FORMAT_BC2_UNORM_BLOCK,      Compression::BC2,            16 },
+		{ Wolf::Format::BC2_SRGB_BLOCK,       VK_FORMAT_BC2_SRGB_BLOCK,       Compression::BC2,            16 },
+		{ Wolf::Format::BC3_UNORM_BLOCK,      VK_FORMAT_BC3_UNORM_BLOCK,      Compression::BC3,            16 },
+		{ Wolf::Format::BC3_SRGB_BLOCK,       VK_FORMAT_BC3_SRGB_BLOCK,       Compression::BC3,            16 },
+		{ Wolf::Format::BC4_UNORM_BLOCK,      VK_FORMAT_BC4_UNORM_BLOCK,      Compression::BC4,            8 },
+		{ Wolf::Format::BC5_UNORM_BLOCK,      VK_FORMAT_BC5_UNORM_BLOCK,      Compression::BC5,            16 },
+		{ Wolf::Format::BC6H_UFLOAT_BLOCK,    VK_FORMAT_BC6H_UFLOAT_BLOCK,    Compression::BC6H,           16 },
+		{ Wolf::Format::BC7_UNORM_BLOCK,      VK_FORMAT_BC7_UNORM_BLOCK,      Compression::BC7,            16 },
+		{ Wolf::Format::BC7_SRGB_BLOCK,       VK_FORMAT_BC7_SRGB_BLOCK,       Compression::BC7,            16 },
+	};
+
+	const KTX2Format* findFormat(uint32_t vkFormat)
+	{
+		for (const KTX2Format& ktx2Format : KTX2_FORMATS)
+		{
+			if (static_cast<uint32_t>(ktx2Format.vkFormat) == vkFormat)
+				return &ktx2Format;
+		}
+		return nullptr;
+	}
+
+	const KTX2Format* findFormat(Wolf::Format format)
+	{
+		for (const KTX2Format& ktx2Format : KTX2_FORMATS)
+		{
+			if (ktx2Format.format == format)
+				return &ktx2Format;
+		}
+		return nullptr;
+	}
+
+	uint64_t computeSurfaceSize(const KTX2Format& ktx2Format, Wolf::Extent3D mipExtent)
+	{
+		if (ktx2Format.compression == Compression::NO_COMPRESSION)
+			return static_cast<uint64_t>(mipExtent.width) * mipExtent.height * mipExtent.depth * ktx2Format.texelOrBlockSize;
+		return static_cast<uint64_t>((mipExtent.width + 3) / 4) * ((mipExtent.height + 3) / 4) * mipExtent.depth * ktx2Format.texelOrBlockSize;
+	}
+
+	Wolf::Extent3D computeMipExtent(Wolf::Extent3D extent, uint32_t mipLevel)
+	{
+		return { std::max(extent.width >> mipLevel, 1u), std::max(extent.height >> mipLevel, 1u), std::max(extent.depth >> mipLevel, 1u) };
+	}
+
+	void addSample(std::vector<uint32_t>& descriptor, uint8_t channelAndQualifiers, uint32_t bitOffset, uint32_t bitLength, uint32_t lower, uint32_t upper)
+	{
+		descriptor.push_back(bitOffset | ((bitLength - 1) << 16) | (static_cast<uint32_t>(channelAndQualifiers) << 24));
+		descriptor.push_back(0); // sample position
+		descriptor.push_back(lower);
+		descriptor.push_back(upper);
+	}
+
+	// Basic descriptor block, preceded by the total size as the file stores it
+	std::vector<uint32_t> createDataFormatDescriptor(const KTX2Format& ktx2Format)
+	{
+		const bool isSRGB = Wolf::isSRGBFormat(ktx2Format.format);
+		const bool isCompressed = ktx2Format.compression != Compression::NO_COMPRESSION;
+
+		uint8_t colorModel = KHR_DF_MODEL_RGBSDA;
+		std::vector<uint32_t> samples;
+		switch (ktx2Format.compression)
+		{
+			case Compression::NO_COMPRESSION:
+				for (uint32_t channelIdx = 0; ktx2Format.channels[channelIdx] != '\0'; ++channelIdx)
+				{
+					uint8_t channel = KHR_DF_CHANNEL_RED;
+					switch (ktx2Format.channels[channelIdx])
+					{
+						case 'G': channel = KHR_DF_CHANNEL_GREEN; break;
+						case 'B': channel = KHR_DF_CHANNEL_BLUE; break;
+						case 'A': channel = KHR_DF_CHANNEL_ALPHA | (isSRGB ? KHR_DF_SAMPLE_DATATYPE_LINEAR : 0); break;
+						default: break;
+					}
+
+					const uint32_t bitLength = ktx2Format.typeSize * 8;
+					if (ktx2Format.typeSize == 1)
+						addSample(samples, channel, channelIdx * bitLength, bitLength, 0, 255);
+					else
+						addSample(samples, channel | KHR_DF_SAMPLE_DATATYPE_FLOAT | KHR_DF_SAMPLE_DATATYPE_SIGNED, channelIdx * bitLength, bitLength, FLOAT_MINUS_ONE, FLOAT_ONE);
+				}
+				break;
+			case Compression::BC1:
+				colorModel = KHR_DF_MODEL_BC1A;
+				addSample(samples, ktx2Format.format == Wolf::Format::BC1_RGBA_UNORM_BLOCK ? KHR_DF_CHANNEL_BC1A_ALPHA : 0, 0, 64, 0, UINT32_MAX);
+				break;
+			case Compression::BC2:
+			case Compression::BC3:
+				colorModel = ktx2Format.compression == Compression::BC2 ? KHR_DF_MODEL_BC2 : KHR_DF_MODEL_BC3;
+				addSample(samples, KHR_DF_CHANNEL_ALPHA | (isSRGB ? KHR_DF_SAMPLE_DATATYPE_LINEAR : 0), 0, 64, 0, UINT32_MAX);
+				addSample(samples, 0, 64, 64, 0, UINT32_MAX);
+				break;
+			case Compression::BC4:
+				colorModel = KHR_DF_MODEL_BC4;
+				addSample(samples, 0, 0, 64, 0, UINT32_MAX);
+				break;
+			case Compression::BC5:
+				colorModel = KHR_DF_MODEL_BC5;
+				addSample(samples, 0, 0, 64, 0, UINT32_MAX);
+				addSample(samples, 1, 64, 64, 0, UINT32_MAX);
+				break;
+			case Compression::BC6H:
+				colorModel = KHR_DF_MODEL_BC6H;
+				addSample(samples, KHR_DF_SAMPLE_DATATYPE_FLOAT, 0, 128, 0, FLOAT_ONE);
+				break;
+			case Compression::BC7:
+				colorModel = KHR_DF_MODEL_BC7;
+				addSample(samples, 0, 0, 128, 0, UINT32_MAX);
+				break;
+		}
+
+		const uint32_t blockSize = 6 * sizeof(uint32_t) + static_cast<uint32_t>(samples.size() * sizeof(uint32_t));
+
+		std::vector<uint32_t> descriptor;
+		descriptor.push_back(blockSize + sizeof(uint32_t));
+		descriptor.push_back(0); // Khronos vendor, basic descriptor type
+		descriptor.push_back(KHR_DF_VERSION | (blockSize << 16));
+		descriptor.push_back(colorModel | (KHR_DF_PRIMARIES_BT709 << 8) | ((isSRGB ? KHR_DF_TRANSFER_SRGB : KHR_DF_TRANSFER_LINEAR) << 16));
+		descriptor.push_back(isCompressed ? 3 | (3 << 8) : 0); // texel block dimensions minus one
+		descriptor.push_back(ktx2Format.texelOrBlockSize); // bytes of plane 0
+		descriptor.push_back(0);
+		descriptor.insert(descriptor.end(), samples.begin(), samples.end());
+
+		return descriptor;
+	}
+
+	uint64_t alignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+Wolf::KTX2File::KTX2File(const std::string& filename) : m_file(filename)
+{
+	m_isValid = readHeaders(filename);
+}
+
+Wolf::Extent3D Wolf::KTX2File::getMipExtent(uint32_t mipLevel) const
+{
+	return computeMipExtent(m_extent, mipLevel);
+}
+
+std::span<const uint8_t> Wolf::KTX2File::getSurface(uint32_t mipLevel, uint32_t arrayLayer, uint32_t face) const
+{
+	if (!m_isValid || mipLevel >= m_levels.size() || arrayLayer >= m_arrayLayerCount || face >= m_faceCount)
+	{
+		Debug::sendError("Requested KTX2 surface doesn't exist");
+		return {};
+	}
+
+	return m_file.getData().subspan(m_levels[mipLevel].m_offset + getSurfaceOffsetInLevel(mipLevel, arrayLayer, face), m_surfaceSizes[mipLevel]);
+}
+
+Wolf::KTX2File::LevelByteRange Wolf::KTX2File::getLevelByteRange(uint32_t mipLevel) const
+{
+	if (!m_isValid || mipLevel >= m_levels.size())
+	{
+		Debug::sendError("Requested KTX2 level doesn't exist");
+		return {};
+	}
+
+	return m_levels[mipLevel];
+}
+
+uint64_t Wolf::KTX2File::getSurfaceOffsetInLevel(uint32_t mipLevel, uint32_t arrayLayer, uint32_t face) const
+{
+	return (static_cast<uint64_t>(arrayLayer) * m_faceCount + face) * m_surfaceSizes[mipLevel];
+}
+
+bool Wolf::KTX2File::readHeaders(const std::string& filename)
+{
+	if (!m_file.isValid())
+	{
+		Debug::sendError("Error : loading image " + filename);
+		return false;
+	}
+
+	const std::span<const uint8_t> data = m_file.getData();
+	if (data.size() < sizeof(KTX2Header) || std::memcmp(data.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+	{
+		Debug::sendError("Not a KTX2 file: " + filename);
+		return false;
+	}
+
+	KTX2Header header;
+	std::memcpy(&header, data.data(), sizeof(KTX2Header));
+
+	if (header.supercompressionScheme != 0)
+	{
+		Debug::sendError("Supercompressed KTX2 files are not supported: " + filename);
+		return false;
+	}
+
+	const KTX2Format* ktx2Format = findFormat(header.vkFormat);
+	if (!ktx2Format)
+	{
+		Debug::sendError("Unsupported format for KTX2 " + filename);
+		return false;
+	}
+	m_format = ktx2Format->format;
+	m_compression = ktx2Format->compression;
+
+	// Zero height, depth and layer count mean 1D textures, 2D textures and no array
+	m_extent = { header.pixelWidth, std::max(header.pixelHeight, 1u), std::max(header.pixelDepth, 1u) };
+	m_arrayLayerCount = std::max(header.layerCount, 1u);
+	m_faceCount = header.faceCount;
+
+	if (m_extent.width == 0 || m_extent.width > MAX_SIZE || m_extent.height > MAX_SIZE || m_extent.depth > MAX_SIZE)
+	{
+		Debug::sendError("Invalid size for KTX2 " + filename);
+		return false;
+	}
+	if ((m_faceCount != 1 && m_faceCount != 6) || (m_faceCount == 6 && (m_extent.width != m_extent.height || m_extent.depth != 1)))
+	{
+		Debug::sendError("Invalid face count for KTX2 " + filename);
+		return false;
+	}
+	if (m_arrayLayerCount > MAX_SIZE || (m_extent.depth > 1 && m_arrayLayerCount > 1))
+	{
+		Debug::sendError("Invalid layer count for KTX2 " + filename);
+		return false;
+	}
+
+	// No level means the mips have to be generated, only the base level is stored
+	const uint32_t levelCount = std::max(header.levelCount, 1u);
+	if (levelCount > static_cast<uint32_t>(std::bit_width(std::max({ m_extent.width, m_extent.height, m_extent.depth }))))
+	{
+		Debug::sendError("Too many mip levels for KTX2 " + filename);
+		return false;
+	}
+	if ((data.size() - sizeof(KTX2Header)) / sizeof(KTX2LevelIndexEntry) < levelCount)
+	{
+		Debug::sendError("KTX2 file is truncated: " + filename);
+		return false;
+	}
+
+	const uint64_t surfaceCount = static_cast<uint64_t>(m_arrayLayerCount) * m_faceCount;
+	m_levels.resize(levelCount);
+	m_surfaceSizes.resize(levelCount);
+	for (uint32_t mipLevel = 0; mipLevel < levelCount; ++mipLevel)
+	{
+		KTX2LevelIndexEntry levelIndexEntry;
+		std::memcpy(&levelIndexEntry, data.data() + sizeof(KTX2Header) + mipLevel * sizeof(KTX2LevelIndexEntry), sizeof(KTX2LevelIndexEntry));
+
+		if (levelIndexEntry.byteOffset > data.size() || levelIndexEntry.byteLength > data.size() - levelIndexEntry.byteOffset)
+		{
+			Debug::sendError("KTX2 file is truncated: " + filename);
+			return false;
+		}
+
+		// Surface size is at most 2^52 bytes, the level length is known to fit in the file
+		const uint64_t surfaceSize = computeSurfaceSize(*ktx2Format, getMipExtent(mipLevel));
+		if (levelIndexEntry.byteLength / surfaceSize != surfaceCount || levelIndexEntry.byteLength % surfaceSize != 0)
+		{
+			Debug::sendError("Invalid level size for KTX2 " + filename);
+			return false;
+		}
+
+		m_levels[mipLevel] = { levelIndexEntry.byteOffset, levelIndexEntry.byteLength };
+		m_surfaceSizes[mipLevel] = surfaceSize;
+	}
+
+	return true;
+}
+
+bool Wolf::KTX2File::write(const std::string& filename, const WriteInfo& writeInfo)
+{
+	const KTX2Format* ktx2Format = findFormat(writeInfo.format);
+	if (!ktx2Format)
+	{
+		Debug::sendError("Unsupported format for KTX2 " + formatToString(writeInfo.format));
+		return false;
+	}
+
+	const Extent3D& extent = writeInfo.extent;
+	if (extent.width == 0 || extent.height == 0 || extent.depth == 0 || writeInfo.arrayLayerCount == 0 || (writeInfo.faceCount != 1 && writeInfo.faceCount != 6) ||
+		(writeInfo.faceCount == 6 && (extent.width != extent.height || extent.depth != 1)) || (extent.depth > 1 && writeInfo.arrayLayerCount > 1))
+	{
+		Debug::sendError("Invalid layout for KTX2 " + filename);
+		return false;
+	}
+
+	const uint32_t levelCount = static_cast<uint32_t>(writeInfo.levels.size());
+	if (levelCount == 0 || levelCount > static_cast<uint32_t>(std::bit_width(std::max({ extent.width, extent.height, extent.depth }))))
+	{
+		Debug::sendError("Invalid mip level count for KTX2 " + filename);
+		return false;
+	}
+
+	const uint64_t surfaceCount = static_cast<uint64_t>(writeInfo.arrayLayerCount) * writeInfo.faceCount;
+	for (uint32_t mipLevel = 0; mipLevel < levelCount; ++mipLevel)
+	{
+		if (writeInfo.levels[mipLevel].size() != computeSurfaceSize(*ktx2Format, computeMipExtent(extent, mipLevel)) * surfaceCount)
+		{
+			Debug::sendError("Wrong data size for mip level " + std::to_string(mipLevel) + " of KTX2 " + filename);
+			return false;
+		}
+	}
+
+	const std::vector<uint32_t> dataFormatDescriptor = createDataFormatDescriptor(*ktx2Format);
+
+	static constexpr char WRITER_KEY[] = "KTXwriter";
+	static constexpr char WRITER_VALUE[] = "Wolf Engine";
+	const uint32_t writerKeyValueLength = sizeof(WRITER_KEY) + sizeof(WRITER_VALUE);
+
+	KTX2Header header{};
+	std::memcpy(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+	header.vkFormat = static_cast<uint32_t>(ktx2Format->vkFormat);
+	header.typeSize = ktx2Format->typeSize;
+	header.pixelWidth = extent.width;
+	header.pixelHeight = extent.height;
+	header.pixelDepth = extent.depth > 1 ? extent.depth : 0;
+	header.layerCount = writeInfo.arrayLayerCount > 1 ? writeInfo.arrayLayerCount : 0;
+	header.faceCount = writeInfo.faceCount;
+	header.levelCount = levelCount;
+	header.supercompressionScheme = 0;
+	header.dfdByteOffset = static_cast<uint32_t>(sizeof(KTX2Header) + levelCount * sizeof(KTX2LevelIndexEntry));
+	header.dfdByteLength = static_cast<uint32_t>(dataFormatDescriptor.size() * sizeof(uint32_t));
+	header.kvdByteOffset = header.dfdByteOffset + header.dfdByteLength;
+	header.kvdByteLength = static_cast<uint32_t>(alignUp(sizeof(uint32_t) + writerKeyValueLength, 4));
+
+	// Levels are stored smallest first, each aligned on the texel block size and 4
+	const uint64_t levelAlignment = std::lcm<uint64_t>(ktx2Format->texelOrBlockSize, 4);
+	std::vector<KTX2LevelIndexEntry> levelIndex(levelCount);
+	uint64_t offset = header.kvdByteOffset + header.kvdByteLength;
+	for (uint32_t mipLevel = levelCount; mipLevel-- > 0;)
+	{
+		offset = alignUp(offset, levelAlignment);
+		levelIndex[mipLevel] = { offset, writeInfo.levels[mipLevel].size(), writeInfo.levels[mipLevel].size() };
+		offset += writeInfo.levels[mipLevel].size();
+	}
+
+	std::ofstream outFile(filename, std::ios::out | std::ios::binary);
+	if (!outFile)
+	{
+		Debug::sendError("Can't open " + filename + " to write KTX2");
+		return false;
+	}
+
+	static constexpr char PADDING[32] = {};
+	uint64_t writtenSize = 0;
+	auto writeBytes = [&](const void* bytes, uint64_t size)
+	{
+		outFile.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+		writtenSize += size;
+	};
+
+	writeBytes(&header, sizeof(KTX2Header));
+	writeBytes(levelIndex.data(), levelIndex.size() * sizeof(KTX2LevelIndexEntry));
+	writeBytes(dataFormatDescriptor.data(), header.dfdByteLength);
+	writeBytes(&writerKeyValueLength, sizeof(uint32_t));
+	writeBytes(WRITER_KEY, sizeof(WRITER_KEY));
+	writeBytes(WRITER_VALUE, sizeof(WRITER_VALUE));
+	for (uint32_t mipLevel = levelCount; mipLevel-- > 0;)
+	{
+		writeBytes(PADDING, levelIndex[mipLevel].byteOffset - writtenSize);
+		writeBytes(writeInfo.levels[mipLevel].data(), writeInfo.levels[mipLevel].size());
+	}
+
+	if (!outFile)
+	{
+		Debug::sendError("Error while writing KTX2 " + filename);
+		return false;
+	}
+
+	return true;
+}
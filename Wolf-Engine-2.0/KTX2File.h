@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Extents.h>
+#include <Formats.h>
+
+#include "ImageCompression.h"
+#include "MappedFile.h"
+
+namespace Wolf
+{
+	// KTX2 file mapped in memory, only files without supercompression are supported. Like DDSFile, headers and the level index are validated by the constructor
+	// and surfaces are views into the mapping
+	class KTX2File
+	{
+	public:
+		explicit KTX2File(const std::string& filename);
+		KTX2File(const KTX2File&) = delete;
+
+		[[nodiscard]] bool isValid() const { return m_isValid; }
+		[[nodiscard]] Format getFormat() const { return m_format; }
+		[[nodiscard]] ImageCompression::Compression getCompression() const { return m_compression; }
+		[[nodiscard]] Extent3D getExtent() const { return m_extent; }
+		[[nodiscard]] Extent3D getMipExtent(uint32_t mipLevel) const;
+		[[nodiscard]] uint32_t getMipLevelCount() const { return static_cast<uint32_t>(m_levels.size()); }
+		[[nodiscard]] uint32_t getArrayLayerCount() const { return m_arrayLayerCount; }
+		[[nodiscard]] uint32_t getFaceCount() const { return m_faceCount; }
+		[[nodiscard]] bool isCubemap() const { return m_faceCount == 6; }
+
+		// Face must be 0 when the file isn't a cubemap, layers of cubemap arrays are whole cubes. Volume textures give all slices of the mip level
+		[[nodiscard]] std::span<const uint8_t> getSurface(uint32_t mipLevel, uint32_t arrayLayer = 0, uint32_t face = 0) const;
+
+		// Bytes of a mip level in the file, all layers and faces included. Lets a single level be read without touching the mapping (AsyncFileReader::read for instance),
+		// surfaces are then at getSurfaceOffsetInLevel()
+		struct LevelByteRange
+		{
+			uint64_t m_offset = 0;
+			uint64_t m_size = 0;
+		};
+		[[nodiscard]] LevelByteRange getLevelByteRange(uint32_t mipLevel) const;
+		[[nodiscard]] uint64_t getSurfaceOffsetInLevel(uint32_t mipLevel, uint32_t arrayLayer = 0, uint32_t face = 0) const;
+
+		struct WriteInfo
+		{
+			Format format = Format::UNDEFINED;
+			Extent3D extent = { 0, 0, 1 };
+			uint32_t arrayLayerCount = 1;
+			uint32_t faceCount = 1;
+
+			// One entry per mip level, mip 0 first. Each level has the surfaces of all its layers and faces packed in order (layer 0 face 0, layer 0 face 1...)
+			std::vector<std::span<const uint8_t>> levels;
+
+			// Takes output of ImageCompression or MipMapGenerator as is, data must stay valid until write() returns
+			template <typename T>
+			void addLevel(const std::vector<T>& levelData) { levels.emplace_back(reinterpret_cast<const uint8_t*>(levelData.data()), levelData.size() * sizeof(T)); }
+		};
+		static bool write(const std::string& filename, const WriteInfo& writeInfo);
+
+	private:
+		bool readHeaders(const std::string& filename);
+
+		MappedFile m_file;
+		bool m_isValid = false;
+
+		Format m_format = Format::UNDEFINED;
+		ImageCompression::Compression m_compression = ImageCompression::Compression::NO_COMPRESSION;
+		Extent3D m_extent = { 0, 0, 0 };
+		uint32_t m_arrayLayerCount = 0;
+		uint32_t m_faceCount = 0;
+
+		std::vector<LevelByteRange> m_levels;
+		std::vector<uint64_t> m_surfaceSizes; // per mip level
+	};
+}
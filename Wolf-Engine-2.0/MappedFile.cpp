@@ -0,0 +1,78 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Wolf::MappedFile::MappedFile(const std::string& filename)
+{
+#ifdef _WIN32
+	const HANDLE fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return;
+	m_fileHandle = fileHandle;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+		return;
+	const size_t size = static_cast<size_t>(fileSize.QuadPart);
+
+	if (size > 0)
+	{
+		m_mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_mappingHandle)
+			return;
+
+		m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (!m_data)
+			return;
+	}
+#else
+	m_fileDescriptor = open(filename.c_str(), O_RDONLY);
+	if (m_fileDescriptor < 0)
+		return;
+
+	struct stat fileStat;
+	if (fstat(m_fileDescriptor, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+		return;
+	const size_t size = static_cast<size_t>(fileStat.st_size);
+
+	if (size > 0)
+	{
+		void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+		if (data == MAP_FAILED)
+			return;
+		m_data = static_cast<const uint8_t*>(data);
+
+		// Files are mostly parsed from start to end
+		madvise(data, size, MADV_SEQUENTIAL);
+	}
+#endif
+
+	m_size = size;
+	m_isValid = true;
+}
+
+Wolf::MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_mappingHandle)
+		CloseHandle(m_mappingHandle);
+	if (m_fileHandle)
+		CloseHandle(m_fileHandle);
+#else
+	if (m_data)
+		munmap(const_cast<uint8_t*>(m_data), m_size);
+	if (m_fileDescriptor >= 0)
+		close(m_fileDescriptor);
+#endif
+}
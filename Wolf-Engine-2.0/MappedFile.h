@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace Wolf
+{
+	// Read-only view of a whole file mapped in memory, pages are loaded by the OS when accessed
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(const std::string& filename);
+		MappedFile(const MappedFile&) = delete;
+		~MappedFile();
+
+		// Empty files are valid but have no data
+		[[nodiscard]] bool isValid() const { return m_isValid; }
+		[[nodiscard]] std::span<const uint8_t> getData() const { return { m_data, m_size }; }
+		[[nodiscard]] std::string_view getText() const { return { reinterpret_cast<const char*>(m_data), m_size }; }
+		[[nodiscard]] size_t getSize() const { return m_size; }
+
+	private:
+		bool m_isValid = false;
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+
+#ifdef _WIN32
+		void* m_fileHandle = nullptr;
+		void* m_mappingHandle = nullptr;
+#else
+		int m_fileDescriptor = -1;
+#endif
+	};
+}
@@ -3,6 +3,7 @@
 #include <Configuration.h>
 
 #include <CommandBuffer.h>
+#include <cstring>
 #include <fstream>
 
 #include "ConfigurationHelper.h"
@@ -13,7 +14,8 @@
 
 std::vector<std::string> Wolf::MaterialsGPUManager::MaterialInfo::SHADING_MODE_STRING_LIST = { "GGX", "Aniso GGX", "Six ways lighting", "Alpha only" };
 
-Wolf::MaterialsGPUManager::MaterialsGPUManager(const std::vector<DescriptorSetGenerator::ImageDescription>& firstImages, const ResourceNonOwner<GPUDataTransfersManagerInterface>& pushDataToGPU) : m_pushDataToGPUHandler(pushDataToGPU)
+Wolf::MaterialsGPUManager::MaterialsGPUManager(const std::vector<DescriptorSetGenerator::ImageDescription>& firstImages, const ResourceNonOwner<GPUDataTransfersManagerInterface>& pushDataToGPU)
+	: m_pushDataToGPUHandler(pushDataToGPU), m_firstImages(firstImages), m_progressiveTextureLoader(pushDataToGPU)
 {
 	DescriptorSetLayoutGenerator descriptorSetLayoutGenerator;
 
@@ -145,22 +147,40 @@ void Wolf::MaterialsGPUManager::addNewTextureSet(const TextureSetInfo& textureSe
 		std::vector<DescriptorSetGenerator::ImageDescription> imagesCleaned;
 		imagesCleaned.reserve(textureSetInfo.images.size());
 
+		std::array<bool, TEXTURE_COUNT_PER_TEXTURE_SET> hasImage{};
+		std::array<ProgressiveTextureLoader::TextureInfo, TEXTURE_COUNT_PER_TEXTURE_SET> progressiveTexturesInfo;
+		std::array<bool, TEXTURE_COUNT_PER_TEXTURE_SET> isProgressive{};
 		for (uint32_t i = 0; i < textureSetInfo.images.size(); i++)
 		{
 			if (const NullableResourceNonOwner<Image>& image = textureSetInfo.images[i])
 			{
 				imagesCleaned.emplace_back(ImageLayout::SHADER_READ_ONLY_OPTIMAL, image->getDefaultImageView());
+				hasImage[i] = true;
+			}
+			else if (!textureSetInfo.progressiveImageFilenames[i].empty() && createProgressiveImage(textureSetInfo.progressiveImageFilenames[i], progressiveTexturesInfo[i]))
+			{
+				// Default image of the same type until the mip tail is loaded
+				imagesCleaned.emplace_back(m_firstImages[i < m_firstImages.size() ? i : 0]);
+				hasImage[i] = true;
+				isProgressive[i] = true;
 			}
 		}
 
 		uint32_t currentBindlessOffset = addImagesToBindless(imagesCleaned);
 
-		if (textureSetInfo.images[0])
-			newTextureSetInfo.albedoIdx = currentBindlessOffset++;
-		if (textureSetInfo.images[1])
-			newTextureSetInfo.normalIdx = currentBindlessOffset++;
-		if (textureSetInfo.images[2])
-			newTextureSetInfo.roughnessMetalnessAOIdx = currentBindlessOffset++;
+		std::array<uint32_t*, TEXTURE_COUNT_PER_TEXTURE_SET> textureIndices = { &newTextureSetInfo.albedoIdx, &newTextureSetInfo.normalIdx, &newTextureSetInfo.roughnessMetalnessAOIdx };
+		for (uint32_t i = 0; i < TEXTURE_COUNT_PER_TEXTURE_SET; i++)
+		{
+			if (!hasImage[i])
+				continue;
+
+			if (isProgressive[i])
+			{
+				progressiveTexturesInfo[i].m_bindlessOffset = currentBindlessOffset;
+				m_progressiveTextureLoader.addTexture(std::move(progressiveTexturesInfo[i]));
+			}
+			*textureIndices[i] = currentBindlessOffset++;
+		}
 
 		newTextureSetInfo.scale = textureSetInfo.scale;
 	}
@@ -190,15 +210,25 @@ void Wolf::MaterialsGPUManager::addNewMaterial(const MaterialInfo& material)
 	newMaterialInfo.m_color = material.m_color;
 }
 
-void Wolf::MaterialsGPUManager::addJobs(const ResourceNonOwner<JobsManager>& jobsManager)
+void Wolf::MaterialsGPUManager::addJobs(const ResourceNonOwner<JobsManager>& jobsManager, std::span<const JobsManager::JobHandle> dependencies)
 {
-	jobsManager->addJobBeforeFrame([this]()
+	const JobsManager::JobHandle virtualTextureUpdateJob = jobsManager->addJobBeforeFrame([this]()
 	{
 		if (g_configuration->getUseVirtualTexture())
 		{
+			std::lock_guard<std::mutex> lock(m_virtualTextureMutex);
 			m_virtualTextureManager->updateBeforeFrame();
 		}
-	});
+	}, dependencies, "Virtual texture update");
+
+	// Slices are requested as soon as the feedbacks are read instead of waiting for all jobs to finish
+	jobsManager->addContinuationBeforeFrame(virtualTextureUpdateJob, [this, jobsManager]()
+	{
+		if (g_configuration->getUseVirtualTexture())
+		{
+			requestVirtualTextureSlices(jobsManager);
+		}
+	}, "Virtual texture slices request");
 }
 
 void Wolf::MaterialsGPUManager::updateBeforeFrame(const ResourceNonOwner<JobsManager>& jobsManager)
@@ -229,22 +259,94 @@ void Wolf::MaterialsGPUManager::updateBeforeFrame(const ResourceNonOwner<JobsMan
 		m_newTextureInfo.clear();
 	}
 
-	if (g_configuration->getUseVirtualTexture())
+	m_progressiveTextureLoader.update(m_progressiveTextureChanges);
+	for (const ProgressiveTextureLoader::ResidentMipsChange& change : m_progressiveTextureChanges)
+	{
+		const DescriptorSetGenerator::ImageDescription image{ ImageLayout::SHADER_READ_ONLY_OPTIMAL, change.m_image->getImageView(change.m_image->getFormat(), change.m_firstResidentMipLevel) };
+		updateImageInBindless(image, change.m_bindlessOffset);
+	}
+	m_progressiveTextureChanges.clear();
+}
+
+bool Wolf::MaterialsGPUManager::createProgressiveImage(const std::string& filename, ProgressiveTextureLoader::TextureInfo& outTextureInfo)
+{
+	std::unique_ptr<DDSFile> ddsFile(new DDSFile(filename));
+	if (!ddsFile->isValid())
+		return false;
+
+	if (ddsFile->getArrayLayerCount() != 1 || ddsFile->isCubemap() || ddsFile->getExtent().depth != 1)
+	{
+		Debug::sendError("Only 2D textures can be loaded progressively: " + filename);
+		return false;
+	}
+
+	// Mip uploads copy whole blocks, smaller levels of compressed images are left out
+	uint32_t mipLevelCount = ddsFile->getMipLevelCount();
+	if (ddsFile->getCompression() != ImageCompression::Compression::NO_COMPRESSION)
+	{
+		while (mipLevelCount > 1 && (ddsFile->getMipExtent(mipLevelCount - 1).width < 4 || ddsFile->getMipExtent(mipLevelCount - 1).height < 4))
+			mipLevelCount--;
+	}
+
+	CreateImageInfo createImageInfo;
+	createImageInfo.extent = ddsFile->getExtent();
+	createImageInfo.usage = ImageUsageFlagBits::SAMPLED | ImageUsageFlagBits::TRANSFER_DST;
+	createImageInfo.format = ddsFile->getFormat();
+	createImageInfo.mipLevelCount = mipLevelCount;
+	ResourceUniqueOwner<Image>& image = m_progressiveImages.emplace_back(Image::createImage(createImageInfo));
+
+	outTextureInfo.m_image = image.createNonOwnerResource();
+	outTextureInfo.m_mipPixels.resize(mipLevelCount);
+	for (uint32_t mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel)
+		outTextureInfo.m_mipPixels[mipLevel] = ddsFile->getSurface(mipLevel);
+	outTextureInfo.m_ddsFile = std::move(ddsFile);
+
+	return true;
+}
+
+void Wolf::MaterialsGPUManager::requestVirtualTextureSlices(const ResourceNonOwner<JobsManager>& jobsManager)
+{
+	PROFILE_FUNCTION
+
+	for (JobsManager::StreamingJobToken token : m_pendingVirtualTextureStreamingJobs)
+	{
+		jobsManager->cancelStreamingJob(token);
+	}
+	m_pendingVirtualTextureStreamingJobs.clear();
+
+	for (uint32_t streamingJobIdx = 0; streamingJobIdx < 4; ++streamingJobIdx)
 	{
-		for (uint32_t streamingJobIdx = 0; streamingJobIdx < 4; ++streamingJobIdx)
+		// Fixed size capture keeps the job in its inline storage
+		std::array<VirtualTextureManager::FeedbackInfo, 4> requestedSlices;
+		uint32_t requestedSliceCount;
+		{
+			std::lock_guard<std::mutex> lock(m_virtualTextureMutex);
+			requestedSliceCount = m_virtualTextureManager->getRequestedSlices(requestedSlices);
+		}
+
+		if (requestedSliceCount > 0)
 		{
-			std::vector<VirtualTextureManager::FeedbackInfo> requestedSlices;
-			m_virtualTextureManager->getRequestedSlices(requestedSlices, 4);
-			if (!requestedSlices.empty())
+			// Slices are sorted by mip level, lowest resolutions first
+			const uint32_t priority = requestedSlices[0].m_mipLevel;
+
+			JobsManager::StreamingJobToken token;
+			// Reads of all slices are in flight at once, the streaming thread is released while waiting for them
+			const auto startSliceLoads = [this, requestedSlices, requestedSliceCount]()
 			{
-				jobsManager->addStreamingJob([this, requestedSlices]() { processVirtualTextureRequestedSlices(requestedSlices); });
-			}
-			else
+				for (uint32_t sliceIdx = 0; sliceIdx < requestedSliceCount; ++sliceIdx)
+				{
+					loadVirtualTextureSliceAsync(requestedSlices[sliceIdx]).start();
+				}
+			};
+			if (jobsManager->addStreamingJob(startSliceLoads, priority, &token, "Virtual texture slices load") == JobsManager::AddedJobStatus::SUCCESS)
 			{
-				break;
+				m_pendingVirtualTextureStreamingJobs.push_back(token);
 			}
 		}
-
+		else
+		{
+			break;
+		}
 	}
 }
 
@@ -495,112 +597,158 @@ uint32_t Wolf::MaterialsGPUManager::computeSliceCount(uint32_t textureWidth, uin
 	return sliceCount;
 }
 
-void Wolf::MaterialsGPUManager::processVirtualTextureRequestedSlices(const std::vector<VirtualTextureManager::FeedbackInfo>& requestedSlices, bool neverRemoveEntries)
+bool Wolf::MaterialsGPUManager::getVirtualTextureSliceFilename(const VirtualTextureManager::FeedbackInfo& requestedSlice, std::string& outFilename)
+{
+	uint16_t textureId = requestedSlice.m_textureId;
+	if (textureId <= 2)
+	{
+		rejectVirtualTextureRequest(requestedSlice);
+		return false;
+	}
+
+	// Virtual texture manager will create request for the mip above (for trilinear sampling), we may get out range mip level
+	if (requestedSlice.m_mipLevel >= MipMapGenerator::computeMipCount({ m_texturesCPUInfo[textureId].m_width, m_texturesCPUInfo[textureId].m_width }))
+	{
+		rejectVirtualTextureRequest(requestedSlice);
+		return false;
+	}
+
+	if (computeVirtualTexturePixelSizeInBytes(m_texturesCPUInfo[textureId].m_textureType) == 0.0f)
+	{
+		rejectVirtualTextureRequest(requestedSlice);
+		return false;
+	}
+
+	outFilename = m_texturesCPUInfo[textureId].m_slicesFolder + "mip" + std::to_string(requestedSlice.m_mipLevel) + "_sliceX" + std::to_string(requestedSlice.m_sliceX) + "_sliceY" +
+		std::to_string(requestedSlice.m_sliceY) + ".bin";
+	return true;
+}
+
+float Wolf::MaterialsGPUManager::computeVirtualTexturePixelSizeInBytes(TextureCPUInfo::TextureType textureType)
+{
+	switch (textureType)
+	{
+		case TextureCPUInfo::TextureType::ALBEDO:
+			return 0.5f; // BC1
+		case TextureCPUInfo::TextureType::NORMAL:
+			return 1.0f; // BC5
+		case TextureCPUInfo::TextureType::COMBINED_ROUGHNESS_METALNESS_AO:
+			return 1.0f; // BC3
+		default:
+			return 0.0f;
+	}
+}
+
+void Wolf::MaterialsGPUManager::loadVirtualTextureSlice(const VirtualTextureManager::FeedbackInfo& requestedSlice, bool neverRemoveEntries)
 {
 	PROFILE_FUNCTION
 
-	for (const VirtualTextureManager::FeedbackInfo& requestedSlice : requestedSlices)
+	std::string sliceFilename;
+	if (!getVirtualTextureSliceFilename(requestedSlice, sliceFilename))
+		return;
+
+	AsyncFileReader::ReadResult readResult;
+	AsyncFileReader::readFile(sliceFilename, 0, AsyncFileReader::WHOLE_FILE, readResult);
+	if (!readResult.m_success)
 	{
-		uint16_t textureId = requestedSlice.m_textureId;
-		if (textureId <= 2)
-		{
-			m_virtualTextureManager->rejectRequest(requestedSlice);
-			continue;
-		}
+		Debug::sendError("Unable to open file");
+		rejectVirtualTextureRequest(requestedSlice);
+		return;
+	}
 
-		const std::string& sliceFolder = m_texturesCPUInfo[textureId].m_slicesFolder;
-		uint8_t sliceX = requestedSlice.m_sliceX;
-		uint8_t sliceY = requestedSlice.m_sliceY;
-		uint8_t mipLevel = requestedSlice.m_mipLevel;
+	uploadVirtualTextureSlice(requestedSlice, readResult.m_data, neverRemoveEntries);
+}
 
-		// Virtual texture manager will create request for the mip above (for trilinear sampling), we may get out range mip level
-		if (mipLevel >= MipMapGenerator::computeMipCount({ m_texturesCPUInfo[textureId].m_width, m_texturesCPUInfo[textureId].m_width }))
-		{
-			m_virtualTextureManager->rejectRequest(requestedSlice);
-			continue;
-		}
+Wolf::AsyncTask Wolf::MaterialsGPUManager::loadVirtualTextureSliceAsync(VirtualTextureManager::FeedbackInfo requestedSlice)
+{
+	std::string sliceFilename;
+	if (!getVirtualTextureSliceFilename(requestedSlice, sliceFilename))
+		co_return;
 
-		float pixelSizeInBytes = 0.0f;
-		if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::ALBEDO)
-		{
-			pixelSizeInBytes = 0.5f; // BC1
-		}
-		else if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::NORMAL)
-		{
-			pixelSizeInBytes = 1.0f; // BC5
-		}
-		else if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::COMBINED_ROUGHNESS_METALNESS_AO)
-		{
-			pixelSizeInBytes = 1.0f; // BC3
-		}
- 		else
- 		{
- 			m_virtualTextureManager->rejectRequest(requestedSlice);
- 			continue;
- 		}
-
-		std::string binFilename = sliceFolder + "mip" + std::to_string(mipLevel) + "_sliceX" + std::to_string(sliceX) + "_sliceY" + std::to_string(sliceY) + ".bin";
-		std::ifstream input(binFilename, std::ios::in | std::ios::binary);
-		if (!input.is_open())
-		{
-			Debug::sendError("Unable to open file");
-			m_virtualTextureManager->rejectRequest(requestedSlice);
-			continue;
-		}
+	AsyncFileReader::ReadResult readResult = co_await g_jobsManager->readFileAsync(sliceFilename);
+	if (!readResult.m_success)
+	{
+		Debug::sendError("Unable to open file");
+		rejectVirtualTextureRequest(requestedSlice);
+		co_return;
+	}
 
-		uint64_t hash;
-		input.read(reinterpret_cast<char*>(&hash), sizeof(hash));
-		// TODO: check hash
+	uploadVirtualTextureSlice(requestedSlice, readResult.m_data, false);
+}
 
-		uint32_t dataBytesCount;
-		input.read(reinterpret_cast<char*>(&dataBytesCount), sizeof(dataBytesCount));
+void Wolf::MaterialsGPUManager::uploadVirtualTextureSlice(const VirtualTextureManager::FeedbackInfo& requestedSlice, std::span<const uint8_t> sliceFileContent, bool neverRemoveEntries)
+{
+	PROFILE_FUNCTION
 
-		Extent3D maxSliceExtent{ VirtualTextureManager::VIRTUAL_PAGE_SIZE, VirtualTextureManager::VIRTUAL_PAGE_SIZE, 1 };
-		Extent3D extentForMip = { m_texturesCPUInfo[textureId].m_width >> mipLevel, m_texturesCPUInfo[textureId].m_height >> mipLevel, 1 };
-		Extent3D sliceExtent{ std::min(extentForMip.width, maxSliceExtent.width) + 2 * VirtualTextureManager::BORDER_SIZE,
-			std::min(extentForMip.height, maxSliceExtent.height) + 2 * VirtualTextureManager::BORDER_SIZE, 1 };
+	uint16_t textureId = requestedSlice.m_textureId;
+	uint8_t sliceX = requestedSlice.m_sliceX;
+	uint8_t sliceY = requestedSlice.m_sliceY;
+	uint8_t mipLevel = requestedSlice.m_mipLevel;
 
-		if (static_cast<float>(sliceExtent.width) * static_cast<float>(sliceExtent.height) * pixelSizeInBytes != static_cast<float>(dataBytesCount))
-		{
-			Debug::sendError("Wrong slice size");
-		}
+	// File content: hash (uint64_t), data bytes count (uint32_t), data
+	constexpr size_t HEADER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+	uint32_t dataBytesCount = 0;
+	if (sliceFileContent.size() >= HEADER_SIZE)
+		std::memcpy(&dataBytesCount, sliceFileContent.data() + sizeof(uint64_t), sizeof(dataBytesCount));
+	// TODO: check hash
 
-		std::vector<uint8_t> data(dataBytesCount);
-		input.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	if (sliceFileContent.size() < HEADER_SIZE || sliceFileContent.size() - HEADER_SIZE < dataBytesCount)
+	{
+		Debug::sendError("Slice file is truncated");
+		rejectVirtualTextureRequest(requestedSlice);
+		return;
+	}
+	std::span<const uint8_t> data = sliceFileContent.subspan(HEADER_SIZE, dataBytesCount);
 
-		input.close();
+	Extent3D maxSliceExtent{ VirtualTextureManager::VIRTUAL_PAGE_SIZE, VirtualTextureManager::VIRTUAL_PAGE_SIZE, 1 };
+	Extent3D extentForMip = { m_texturesCPUInfo[textureId].m_width >> mipLevel, m_texturesCPUInfo[textureId].m_height >> mipLevel, 1 };
+	Extent3D sliceExtent{ std::min(extentForMip.width, maxSliceExtent.width) + 2 * VirtualTextureManager::BORDER_SIZE,
+		std::min(extentForMip.height, maxSliceExtent.height) + 2 * VirtualTextureManager::BORDER_SIZE, 1 };
 
-		if (m_texturesCPUInfo[textureId].m_virtualTextureIndirectionOffset == VirtualTextureManager::INVALID_INDIRECTION_OFFSET)
-		{
-			Debug::sendCriticalError("Indirections are not registered");
-		}
+	const float pixelSizeInBytes = computeVirtualTexturePixelSizeInBytes(m_texturesCPUInfo[textureId].m_textureType);
+	if (static_cast<float>(sliceExtent.width) * static_cast<float>(sliceExtent.height) * pixelSizeInBytes != static_cast<float>(dataBytesCount))
+	{
+		Debug::sendError("Wrong slice size");
+	}
 
-		uint8_t sliceCountX = m_texturesCPUInfo[textureId].m_height / VirtualTextureManager::VIRTUAL_PAGE_SIZE;
-		uint8_t sliceCountY = m_texturesCPUInfo[textureId].m_height / VirtualTextureManager::VIRTUAL_PAGE_SIZE;
+	if (m_texturesCPUInfo[textureId].m_virtualTextureIndirectionOffset == VirtualTextureManager::INVALID_INDIRECTION_OFFSET)
+	{
+		Debug::sendCriticalError("Indirections are not registered");
+	}
 
-		uint32_t atlasIdx = -1;
-		if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::ALBEDO)
-			atlasIdx = m_albedoAtlasIdx;
-		else if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::NORMAL)
-			atlasIdx = m_normalAtlasIdx;
-		else if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::COMBINED_ROUGHNESS_METALNESS_AO)
-			atlasIdx = m_combinedAtlasIdx;
+	uint8_t sliceCountX = m_texturesCPUInfo[textureId].m_height / VirtualTextureManager::VIRTUAL_PAGE_SIZE;
+	uint8_t sliceCountY = m_texturesCPUInfo[textureId].m_height / VirtualTextureManager::VIRTUAL_PAGE_SIZE;
 
-		if (atlasIdx == -1)
-			Debug::sendCriticalError("Wrong atlas index");
+	uint32_t atlasIdx = -1;
+	if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::ALBEDO)
+		atlasIdx = m_albedoAtlasIdx;
+	else if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::NORMAL)
+		atlasIdx = m_normalAtlasIdx;
+	else if (m_texturesCPUInfo[textureId].m_textureType == TextureCPUInfo::TextureType::COMBINED_ROUGHNESS_METALNESS_AO)
+		atlasIdx = m_combinedAtlasIdx;
 
-		VirtualTextureManager::FeedbackInfo removedFeedbackInfo;
-		uint32_t entryId = m_virtualTextureManager->takeEntryId(atlasIdx, requestedSlice, sliceExtent, removedFeedbackInfo, neverRemoveEntries);
-		if (removedFeedbackInfo != static_cast<VirtualTextureManager::FeedbackInfo>(-1))
-		{
-			uint8_t removedSliceCountX = m_texturesCPUInfo[removedFeedbackInfo.m_textureId].m_height / VirtualTextureManager::VIRTUAL_PAGE_SIZE;
-			uint8_t removedSliceCountY = m_texturesCPUInfo[removedFeedbackInfo.m_textureId].m_height / VirtualTextureManager::VIRTUAL_PAGE_SIZE;
+	if (atlasIdx == -1)
+		Debug::sendCriticalError("Wrong atlas index");
 
-			m_virtualTextureManager->removeIndirection(removedFeedbackInfo, removedSliceCountX, removedSliceCountY, m_texturesCPUInfo[removedFeedbackInfo.m_textureId].m_virtualTextureIndirectionOffset);
-		}
+	std::lock_guard<std::mutex> lock(m_virtualTextureMutex);
 
-		m_virtualTextureManager->uploadData(atlasIdx, data, sliceExtent, sliceX, sliceY, mipLevel, sliceCountX, sliceCountY, m_texturesCPUInfo[textureId].m_virtualTextureIndirectionOffset, requestedSlice, entryId);
+	VirtualTextureManager::FeedbackInfo removedFeedbackInfo;
+	uint32_t entryId = m_virtualTextureManager->takeEntryId(atlasIdx, requestedSlice, sliceExtent, removedFeedbackInfo, neverRemoveEntries);
+	if (removedFeedbackInfo != static_cast<VirtualTextureManager::FeedbackInfo>(-1))
+	{
+		uint8_t removedSliceCountX = m_texturesCPUInfo[removedFeedbackInfo.m_textureId].m_height / VirtualTextureManager::VIRTUAL_PAGE_SIZE;
+		uint8_t removedSliceCountY = m_texturesCPUInfo[removedFeedbackInfo.m_textureId].m_height / VirtualTextureManager::VIRTUAL_PAGE_SIZE;
+
+		m_virtualTextureManager->removeIndirection(removedFeedbackInfo, removedSliceCountX, removedSliceCountY, m_texturesCPUInfo[removedFeedbackInfo.m_textureId].m_virtualTextureIndirectionOffset);
 	}
+
+	m_virtualTextureManager->uploadData(atlasIdx, data, sliceExtent, sliceX, sliceY, mipLevel, sliceCountX, sliceCountY, m_texturesCPUInfo[textureId].m_virtualTextureIndirectionOffset, requestedSlice, entryId);
+}
+
+void Wolf::MaterialsGPUManager::rejectVirtualTextureRequest(const VirtualTextureManager::FeedbackInfo& requestedSlice)
+{
+	std::lock_guard<std::mutex> lock(m_virtualTextureMutex);
+	m_virtualTextureManager->rejectRequest(requestedSlice);
 }
 
 void Wolf::MaterialsGPUManager::addSlicedImage(const std::string& folder, TextureCPUInfo::TextureType textureType)
@@ -617,12 +765,12 @@ void Wolf::MaterialsGPUManager::addSlicedImage(const std::string& folder, Textur
 	textureInfo.virtualTextureIndirectionOffset = m_virtualTextureManager->createNewIndirection(indirectionCount);
 	textureCPUInfo.m_virtualTextureIndirectionOffset = textureInfo.virtualTextureIndirectionOffset;
 
-	std::vector<VirtualTextureManager::FeedbackInfo> minimumSlices(1);
-	minimumSlices[0].m_textureId = textureId;
-	minimumSlices[0].m_mipLevel = MipMapGenerator::computeMipCount({ textureCPUInfo.m_width, textureCPUInfo.m_height }) - 1;
-	minimumSlices[0].m_sliceX = 0;
-	minimumSlices[0].m_sliceY = 0;
-	processVirtualTextureRequestedSlices(minimumSlices, true);
+	VirtualTextureManager::FeedbackInfo minimumSlice;
+	minimumSlice.m_textureId = textureId;
+	minimumSlice.m_mipLevel = MipMapGenerator::computeMipCount({ textureCPUInfo.m_width, textureCPUInfo.m_height }) - 1;
+	minimumSlice.m_sliceX = 0;
+	minimumSlice.m_sliceY = 0;
+	loadVirtualTextureSlice(minimumSlice, true);
 }
 
 void Wolf::MaterialsGPUManager::bind(const CommandBuffer& commandBuffer, const Pipeline& pipeline, uint32_t descriptorSlot) const
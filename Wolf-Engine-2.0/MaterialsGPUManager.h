@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mutex>
+#include <span>
 
 #include <glm/glm.hpp>
 
@@ -9,9 +10,11 @@
 #include <Sampler.h>
 
 #include "DescriptorSetGenerator.h"
+#include "DynamicResourceUniqueOwnerArray.h"
 #include "LazyInitSharedResource.h"
 #include "GPUDataTransfersManager.h"
 #include "JobsManager.h"
+#include "ProgressiveTextureLoader.h"
 #include "ResourceUniqueOwner.h"
 #include "VirtualTextureManager.h"
 
@@ -33,6 +36,8 @@ namespace Wolf
 
 			std::array<NullableResourceNonOwner<Image>, TEXTURE_COUNT_PER_TEXTURE_SET> images;
 			std::array<std::string, TEXTURE_COUNT_PER_TEXTURE_SET> slicesFolders;
+			// DDS files used when there is no image, they are sampled at a reduced resolution until all their mips are loaded
+			std::array<std::string, TEXTURE_COUNT_PER_TEXTURE_SET> progressiveImageFilenames;
 
 			enum class SamplingMode { TEXTURE_COORDS = 0, TRIPLANAR = 1 };
 			SamplingMode samplingMode = SamplingMode::TEXTURE_COORDS;
@@ -71,9 +76,11 @@ namespace Wolf
 			glm::vec3 m_color = glm::vec3(1.0f);
 		};
 		void addNewMaterial(const MaterialInfo& material);
-		void addJobs(const ResourceNonOwner<JobsManager>& jobsManager);
+		// Virtual texture feedbacks are read once the dependencies are completed
+		void addJobs(const ResourceNonOwner<JobsManager>& jobsManager, std::span<const JobsManager::JobHandle> dependencies = {});
 		void updateBeforeFrame(const ResourceNonOwner<JobsManager>& jobsManager);
 		void resize(Extent2D newExtent);
+		void setProgressiveTextureByteBudgetPerFrame(uint64_t byteBudgetPerFrame) { m_progressiveTextureLoader.setByteBudgetPerFrame(byteBudgetPerFrame); }
 
 		void lockTextureSets();
 		void unlockTextureSets();
@@ -116,8 +123,14 @@ namespace Wolf
 	private:
 		uint32_t addImagesToBindless(const std::vector<DescriptorSetGenerator::ImageDescription>& images);
 		void updateImageInBindless(const DescriptorSetGenerator::ImageDescription& image, uint32_t bindlessOffset) const;
+		bool createProgressiveImage(const std::string& filename, ProgressiveTextureLoader::TextureInfo& outTextureInfo);
 		static uint32_t computeSliceCount(uint32_t textureWidth, uint32_t textureHeight);
-		void processVirtualTextureRequestedSlices(const std::vector<VirtualTextureManager::FeedbackInfo>& requestedSlices, bool neverRemoveEntries = false);
+		void requestVirtualTextureSlices(const ResourceNonOwner<JobsManager>& jobsManager);
+		bool getVirtualTextureSliceFilename(const VirtualTextureManager::FeedbackInfo& requestedSlice, std::string& outFilename);
+		void loadVirtualTextureSlice(const VirtualTextureManager::FeedbackInfo& requestedSlice, bool neverRemoveEntries);
+		AsyncTask loadVirtualTextureSliceAsync(VirtualTextureManager::FeedbackInfo requestedSlice);
+		void uploadVirtualTextureSlice(const VirtualTextureManager::FeedbackInfo& requestedSlice, std::span<const uint8_t> sliceFileContent, bool neverRemoveEntries);
+		void rejectVirtualTextureRequest(const VirtualTextureManager::FeedbackInfo& requestedSlice);
 
 		ResourceNonOwner<GPUDataTransfersManagerInterface> m_pushDataToGPUHandler;
 
@@ -145,12 +158,19 @@ namespace Wolf
 		};
 		std::vector<TextureCPUInfo> m_texturesCPUInfo;
 		void addSlicedImage(const std::string& folder, TextureCPUInfo::TextureType textureType);
+		static float computeVirtualTexturePixelSizeInBytes(TextureCPUInfo::TextureType textureType); // 0 for unsupported types
 
 		// Bindless resources
 		static constexpr uint32_t MAX_IMAGES = 4096;
 		static constexpr uint32_t BINDING_SLOT = 0;
 
 		uint32_t m_currentBindlessCount = 0;
+		std::vector<DescriptorSetGenerator::ImageDescription> m_firstImages; // bound to progressive textures until their mip tail is loaded
+
+		// Progressive textures
+		ProgressiveTextureLoader m_progressiveTextureLoader;
+		DynamicResourceUniqueOwnerArray<Image> m_progressiveImages;
+		std::vector<ProgressiveTextureLoader::ResidentMipsChange> m_progressiveTextureChanges;
 
 		// Material layout
 		static constexpr uint32_t MAX_MATERIAL_COUNT = 4096;
@@ -197,6 +217,11 @@ namespace Wolf
 		std::vector<TextureGPUInfo> m_newTextureInfo;
 		std::mutex m_textureInfoMutex;
 
+		// Virtual texture manager is updated by the before frame job and by all streaming threads
+		std::mutex m_virtualTextureMutex;
+		// Requests not started yet are cancelled on next frame, slices still visible are requested again by the feedbacks
+		std::vector<JobsManager::StreamingJobToken> m_pendingVirtualTextureStreamingJobs;
+
 		// GPU resources
 		ResourceUniqueOwner<Buffer> m_materialsBuffer;
 		ResourceUniqueOwner<Buffer> m_textureSetsBuffer;
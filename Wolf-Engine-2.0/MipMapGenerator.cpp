@@ -1,93 +1,690 @@
 #include "MipMapGenerator.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <limits>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/packing.hpp>
+
+// SSE2 is always available on x64, NEON on ARM64. Other targets use the scalar path
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIP_MAP_GENERATOR_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MIP_MAP_GENERATOR_NEON
+#endif
 
 #include "Debug.h"
 #include "ImageCompression.h"
+#include "ParallelFor.h"
+
+namespace
+{
+	using RGBA8 = Wolf::ImageCompression::RGBA8;
+	using RG32F = Wolf::ImageCompression::RG32F;
+	using Filter = Wolf::MipMapGenerator::Filter;
+	using Format = Wolf::Format;
+
+	// Filtered texels are always 4 floats: RGBA, RG followed by 2 zeros, or XYZ0 for normal maps
+	constexpr uint32_t FILTERED_CHANNEL_COUNT = 4;
+
+	uint32_t computeTexelSize(Format format)
+	{
+		switch (format)
+		{
+			case Format::R8G8B8A8_UNORM:
+			case Format::R8G8B8A8_SRGB:
+				return 4;
+			case Format::R8G8_UNORM:
+				return 2;
+			case Format::R16G16B16A16_SFLOAT:
+			case Format::R32G32_SFLOAT:
+				return 8;
+			case Format::R32G32B32A32_SFLOAT:
+				return 16;
+			default:
+				return 0;
+		}
+	}
+
+	// outValues = values * weight, count is a multiple of 4
+	void scaleFloats(float* outValues, const float* values, float weight, uint32_t count)
+	{
+#if defined(MIP_MAP_GENERATOR_SSE2)
+		const __m128 weights = _mm_set1_ps(weight);
+		for (uint32_t i = 0; i < count; i += 4)
+			_mm_storeu_ps(outValues + i, _mm_mul_ps(_mm_loadu_ps(values + i), weights));
+#elif defined(MIP_MAP_GENERATOR_NEON)
+		for (uint32_t i = 0; i < count; i += 4)
+			vst1q_f32(outValues + i, vmulq_n_f32(vld1q_f32(values + i), weight));
+#else
+		for (uint32_t i = 0; i < count; ++i)
+			outValues[i] = values[i] * weight;
+#endif
+	}
+
+	// outValues += values * weight, count is a multiple of 4
+	void multiplyAddFloats(float* outValues, const float* values, float weight, uint32_t count)
+	{
+#if defined(MIP_MAP_GENERATOR_SSE2)
+		const __m128 weights = _mm_set1_ps(weight);
+		for (uint32_t i = 0; i < count; i += 4)
+			_mm_storeu_ps(outValues + i, _mm_add_ps(_mm_loadu_ps(outValues + i), _mm_mul_ps(_mm_loadu_ps(values + i), weights)));
+#elif defined(MIP_MAP_GENERATOR_NEON)
+		for (uint32_t i = 0; i < count; i += 4)
+			vst1q_f32(outValues + i, vmlaq_n_f32(vld1q_f32(outValues + i), vld1q_f32(values + i), weight));
+#else
+		for (uint32_t i = 0; i < count; ++i)
+			outValues[i] += values[i] * weight;
+#endif
+	}
+
+	float convertSRGBToLinear(float value)
+	{
+		return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	// Decoding is a lookup, encoding gives the nearest 8 bits sRGB value
+	class SRGBTables
+	{
+	public:
+		static const SRGBTables& get()
+		{
+			static const SRGBTables tables;
+			return tables;
+		}
+
+		float toLinear(uint32_t value) const { return m_toLinear[value]; }
+		uint8_t toSRGB(float linearValue) const
+		{
+			if (!(linearValue > 0.0f))
+				return 0;
+			if (linearValue >= 1.0f)
+				return 255;
+
+			// Buckets are smaller than the gap between 2 thresholds, the first value is at most 1 below the result
+			const uint32_t value = m_firstValues[computeBucketIdx(linearValue)];
+			return static_cast<uint8_t>(value + (linearValue >= m_thresholds[value + 1] ? 1 : 0));
+		}
+
+	private:
+		static constexpr uint32_t BUCKET_COUNT = 8192;
+		static uint32_t computeBucketIdx(float linearValue) { return static_cast<uint32_t>(linearValue * static_cast<float>(BUCKET_COUNT - 1)); }
+
+		SRGBTables()
+		{
+			for (uint32_t value = 0; value < 256; ++value)
+			{
+				m_toLinear[value] = convertSRGBToLinear(static_cast<float>(value) / 255.0f);
+				m_thresholds[value] = value > 0 ? convertSRGBToLinear((static_cast<float>(value) - 0.5f) / 255.0f) : 0.0f;
+			}
+			m_thresholds[256] = 2.0f;
+
+			// Highest value whose threshold is in a previous bucket, every value in the bucket is above this threshold
+			uint32_t value = 0;
+			for (uint32_t bucketIdx = 0; bucketIdx < BUCKET_COUNT; ++bucketIdx)
+			{
+				while (value < 255 && computeBucketIdx(m_thresholds[value + 1]) < bucketIdx)
+					++value;
+				m_firstValues[bucketIdx] = static_cast<uint8_t>(value);
+			}
+		}
+
+		float m_toLinear[256];
+		float m_thresholds[257]; // lowest linear value encoded to each value, the last one is never reached
+		uint8_t m_firstValues[BUCKET_COUNT];
+	};
+
+	// Unorm bytes to [0, 1] floats
+	void decodeUNormBytes(const uint8_t* values, uint32_t count, float* outValues)
+	{
+		uint32_t i = 0;
+#if defined(MIP_MAP_GENERATOR_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+			const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+			const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+			_mm_storeu_ps(outValues + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+			_mm_storeu_ps(outValues + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+			_mm_storeu_ps(outValues + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+			_mm_storeu_ps(outValues + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+		}
+#elif defined(MIP_MAP_GENERATOR_NEON)
+		for (; i + 16 <= count; i += 16)
+		{
+			const uint8x16_t bytes = vld1q_u8(values + i);
+			const uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+			const uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+			vst1q_f32(outValues + i, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(low))), 1.0f / 255.0f));
+			vst1q_f32(outValues + i + 4, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(low))), 1.0f / 255.0f));
+			vst1q_f32(outValues + i + 8, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(high))), 1.0f / 255.0f));
+			vst1q_f32(outValues + i + 12, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(high))), 1.0f / 255.0f));
+		}
+#endif
+		for (; i < count; ++i)
+			outValues[i] = static_cast<float>(values[i]) * (1.0f / 255.0f);
+	}
+
+	// Floats clamped to [0, 1] and rounded to unorm bytes
+	void encodeUNormBytes(const float* values, uint32_t count, uint8_t* outValues)
+	{
+		uint32_t i = 0;
+#if defined(MIP_MAP_GENERATOR_SSE2)
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(255.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const auto toIntegers = [&](const float* fourValues)
+		{
+			const __m128 clamped = _mm_min_ps(one, _mm_max_ps(zero, _mm_loadu_ps(fourValues)));
+			return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+		};
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m128i low = _mm_packs_epi32(toIntegers(values + i), toIntegers(values + i + 4));
+			const __m128i high = _mm_packs_epi32(toIntegers(values + i + 8), toIntegers(values + i + 12));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outValues + i), _mm_packus_epi16(low, high));
+		}
+#elif defined(MIP_MAP_GENERATOR_NEON)
+		const auto toIntegers = [](const float* fourValues)
+		{
+			const float32x4_t clamped = vminq_f32(vdupq_n_f32(1.0f), vmaxq_f32(vdupq_n_f32(0.0f), vld1q_f32(fourValues)));
+			return vmovn_u32(vcvtq_u32_f32(vmlaq_n_f32(vdupq_n_f32(0.5f), clamped, 255.0f)));
+		};
+		for (; i + 16 <= count; i += 16)
+		{
+			const uint16x8_t low = vcombine_u16(toIntegers(values + i), toIntegers(values + i + 4));
+			const uint16x8_t high = vcombine_u16(toIntegers(values + i + 8), toIntegers(values + i + 12));
+			vst1q_u8(outValues + i, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+		}
+#endif
+		for (; i < count; ++i)
+			outValues[i] = static_cast<uint8_t>(std::clamp(values[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	void rebuildNormalZ(float* texel)
+	{
+		texel[2] = std::sqrt(std::max(0.0f, 1.0f - texel[0] * texel[0] - texel[1] * texel[1]));
+	}
+
+	void normalize(float* texel)
+	{
+		const float length = std::sqrt(texel[0] * texel[0] + texel[1] * texel[1] + texel[2] * texel[2]);
+		if (length > 0.0f)
+		{
+			texel[0] /= length;
+			texel[1] /= length;
+			texel[2] /= length;
+		}
+		else
+		{
+			texel[0] = 0.0f;
+			texel[1] = 0.0f;
+			texel[2] = 1.0f;
+		}
+	}
+
+	// Row of texels to filtered texels, sRGB colors are decoded to linear
+	void decodeRow(const unsigned char* texels, uint32_t width, Format format, bool isNormalMap, float* outTexels)
+	{
+		switch (format)
+		{
+			case Format::R8G8B8A8_UNORM:
+				decodeUNormBytes(texels, width * 4, outTexels);
+				break;
+			case Format::R8G8B8A8_SRGB:
+			{
+				const SRGBTables& srgbTables = SRGBTables::get();
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					uint32_t texel;
+					std::memcpy(&texel, texels + x * 4, sizeof(texel));
+					outTexels[x * 4] = srgbTables.toLinear(texel & 0xff);
+					outTexels[x * 4 + 1] = srgbTables.toLinear((texel >> 8) & 0xff);
+					outTexels[x * 4 + 2] = srgbTables.toLinear((texel >> 16) & 0xff);
+					outTexels[x * 4 + 3] = static_cast<float>(texel >> 24) * (1.0f / 255.0f);
+				}
+				break;
+			}
+			case Format::R8G8_UNORM:
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					float* texel = outTexels + x * FILTERED_CHANNEL_COUNT;
+					texel[0] = static_cast<float>(texels[x * 2]) * (1.0f / 255.0f);
+					texel[1] = static_cast<float>(texels[x * 2 + 1]) * (1.0f / 255.0f);
+					texel[2] = texel[3] = 0.0f;
+					if (isNormalMap)
+					{
+						texel[0] = texel[0] * 2.0f - 1.0f;
+						texel[1] = texel[1] * 2.0f - 1.0f;
+						rebuildNormalZ(texel);
+					}
+				}
+				break;
+			case Format::R16G16B16A16_SFLOAT:
+			{
+				const uint16_t* halfValues = reinterpret_cast<const uint16_t*>(texels);
+				for (uint32_t i = 0; i < width * 4; ++i)
+					outTexels[i] = glm::unpackHalf1x16(halfValues[i]);
+				break;
+			}
+			case Format::R32G32_SFLOAT:
+			{
+				const float* values = reinterpret_cast<const float*>(texels);
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					float* texel = outTexels + x * FILTERED_CHANNEL_COUNT;
+					texel[0] = values[x * 2];
+					texel[1] = values[x * 2 + 1];
+					texel[2] = texel[3] = 0.0f;
+					if (isNormalMap)
+						rebuildNormalZ(texel);
+				}
+				break;
+			}
+			case Format::R32G32B32A32_SFLOAT:
+				std::memcpy(outTexels, texels, width * 4 * sizeof(float));
+				break;
+			default:
+				break;
+		}
+	}
+
+	// Filtered texels back to the format, outTexels is modified
+	void encodeRow(float* texels, uint32_t width, Format format, bool isNormalMap, unsigned char* outTexels)
+	{
+		if (isNormalMap)
+		{
+			for (uint32_t x = 0; x < width; ++x)
+				normalize(texels + x * FILTERED_CHANNEL_COUNT);
+		}
+
+		switch (format)
+		{
+			case Format::R8G8B8A8_UNORM:
+				encodeUNormBytes(texels, width * 4, outTexels);
+				break;
+			case Format::R8G8B8A8_SRGB:
+			{
+				encodeUNormBytes(texels, width * 4, outTexels);
+				const SRGBTables& srgbTables = SRGBTables::get();
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					const uint8_t r = srgbTables.toSRGB(texels[x * 4]);
+					const uint8_t g = srgbTables.toSRGB(texels[x * 4 + 1]);
+					const uint8_t b = srgbTables.toSRGB(texels[x * 4 + 2]);
+					outTexels[x * 4] = r;
+					outTexels[x * 4 + 1] = g;
+					outTexels[x * 4 + 2] = b;
+				}
+				break;
+			}
+			case Format::R8G8_UNORM:
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					const float* texel = texels + x * FILTERED_CHANNEL_COUNT;
+					float values[2] = { texel[0], texel[1] };
+					if (isNormalMap)
+					{
+						values[0] = values[0] * 0.5f + 0.5f;
+						values[1] = values[1] * 0.5f + 0.5f;
+					}
+					encodeUNormBytes(values, 2, outTexels + x * 2);
+				}
+				break;
+			case Format::R16G16B16A16_SFLOAT:
+			{
+				uint16_t* halfValues = reinterpret_cast<uint16_t*>(outTexels);
+				for (uint32_t i = 0; i < width * 4; ++i)
+					halfValues[i] = glm::packHalf1x16(texels[i]);
+				break;
+			}
+			case Format::R32G32_SFLOAT:
+			{
+				float* values = reinterpret_cast<float*>(outTexels);
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					values[x * 2] = texels[x * FILTERED_CHANNEL_COUNT];
+					values[x * 2 + 1] = texels[x * FILTERED_CHANNEL_COUNT + 1];
+				}
+				break;
+			}
+			case Format::R32G32B32A32_SFLOAT:
+				std::memcpy(outTexels, texels, width * 4 * sizeof(float));
+				break;
+			default:
+				break;
+		}
+	}
+
+	// Each destination texel is a weighted sum of tapCount source texels along one axis
+	struct FilterTaps
+	{
+		uint32_t tapCount = 0;
+		std::vector<uint32_t> sourceIndices; // clamped to the edges
+		std::vector<float> weights;
+	};
+
+	constexpr float KAISER_RADIUS = 3.0f; // in destination texels
+	constexpr float KAISER_ALPHA = 4.0f;
+
+	float computeBesselI0(float x)
+	{
+		const float quarterXSquared = x * x * 0.25f;
+		float sum = 1.0f;
+		float term = 1.0f;
+		for (uint32_t k = 1; k < 32 && term > sum * 1e-8f; ++k)
+		{
+			term *= quarterXSquared / static_cast<float>(k * k);
+			sum += term;
+		}
+		return sum;
+	}
+
+	float computeKaiserWeight(float x)
+	{
+		if (std::abs(x) >= KAISER_RADIUS)
+			return 0.0f;
+
+		const float ratio = x / KAISER_RADIUS;
+		const float window = computeBesselI0(KAISER_ALPHA * std::sqrt(1.0f - ratio * ratio)) / computeBesselI0(KAISER_ALPHA);
+		const float sinc = x == 0.0f ? 1.0f : std::sin(glm::pi<float>() * x) / (glm::pi<float>() * x);
+		return sinc * window;
+	}
+
+	FilterTaps computeFilterTaps(uint32_t sourceSize, uint32_t destinationSize, Filter filter)
+	{
+		FilterTaps taps;
+		if (sourceSize == destinationSize)
+		{
+			taps.tapCount = 1;
+			for (uint32_t i = 0; i < destinationSize; ++i)
+			{
+				taps.sourceIndices.push_back(i);
+				taps.weights.push_back(1.0f);
+			}
+		}
+		else if (filter == Filter::KAISER)
+		{
+			const float scale = static_cast<float>(sourceSize) / static_cast<float>(destinationSize);
+			taps.tapCount = static_cast<uint32_t>(std::ceil(2.0f * KAISER_RADIUS * scale)) + 1;
+			for (uint32_t i = 0; i < destinationSize; ++i)
+			{
+				const float center = (static_cast<float>(i) + 0.5f) * scale;
+				const int32_t firstSourceIdx = static_cast<int32_t>(std::floor(center - KAISER_RADIUS * scale));
+
+				const size_t firstWeightIdx = taps.weights.size();
+				float weightSum = 0.0f;
+				for (uint32_t tapIdx = 0; tapIdx < taps.tapCount; ++tapIdx)
+				{
+					const int32_t sourceIdx = firstSourceIdx + static_cast<int32_t>(tapIdx);
+					const float weight = computeKaiserWeight((static_cast<float>(sourceIdx) + 0.5f - center) / scale);
+					taps.sourceIndices.push_back(static_cast<uint32_t>(std::clamp(sourceIdx, 0, static_cast<int32_t>(sourceSize) - 1)));
+					taps.weights.push_back(weight);
+					weightSum += weight;
+				}
+				for (size_t weightIdx = firstWeightIdx; weightIdx < taps.weights.size(); ++weightIdx)
+					taps.weights[weightIdx] /= weightSum;
+			}
+		}
+		else if (sourceSize % 2 == 0)
+		{
+			taps.tapCount = 2;
+			for (uint32_t i = 0; i < destinationSize; ++i)
+			{
+				taps.sourceIndices.insert(taps.sourceIndices.end(), { 2 * i, 2 * i + 1 });
+				taps.weights.insert(taps.weights.end(), { 0.5f, 0.5f });
+			}
+		}
+		else
+		{
+			// 2n + 1 source texels for n destination texels, each one covers (2n + 1) / n source texels
+			const float sourceSizeAsFloat = static_cast<float>(sourceSize);
+			const uint32_t n = destinationSize;
+			taps.tapCount = 3;
+			for (uint32_t i = 0; i < destinationSize; ++i)
+			{
+				taps.sourceIndices.insert(taps.sourceIndices.end(), { 2 * i, 2 * i + 1, 2 * i + 2 });
+				taps.weights.insert(taps.weights.end(), { static_cast<float>(n - i) / sourceSizeAsFloat, static_cast<float>(n) / sourceSizeAsFloat,
+					static_cast<float>(i + 1) / sourceSizeAsFloat });
+			}
+		}
+		return taps;
+	}
+
+	bool isLegacyFormat(Format format)
+	{
+		return format == Format::R8G8B8A8_UNORM || format == Format::R8G8B8A8_SRGB || format == Format::R32G32_SFLOAT;
+	}
+}
 
 uint32_t Wolf::MipMapGenerator::computeMipCount(Extent2D extent)
 {
-	return static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) - 1; // remove 2 mip levels as min size must be 4x4
+	// remove 2 mip levels as min size must be 4x4, smaller images only have the first level
+	const uint32_t maxSizeLog2 = static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height))));
+	return maxSizeLog2 > 1 ? maxSizeLog2 - 1 : 1;
+}
+
+Wolf::Extent2D Wolf::MipMapGenerator::computeMipExtent(Extent2D extent, uint32_t mipLevel)
+{
+	return { std::max(extent.width >> mipLevel, 1u), std::max(extent.height >> mipLevel, 1u) };
 }
 
 Wolf::MipMapGenerator::MipMapGenerator(const unsigned char* firstMipPixels, Extent2D extent, Format format, int mipCount)
+	: MipMapGenerator(firstMipPixels, extent, format, mipCount, GenerationInfo())
 {
-	if(mipCount < 0)
-		mipCount = computeMipCount(extent);
+}
 
+Wolf::MipMapGenerator::MipMapGenerator(const unsigned char* firstMipPixels, Extent2D extent, Format format, int mipCount, const GenerationInfo& generationInfo)
+{
 	if (mipCount < 0)
+		mipCount = static_cast<int>(computeMipCount(extent));
+
+	const uint32_t texelSize = computeTexelSize(format);
+	if (texelSize == 0)
 	{
-		Debug::sendWarning("Can't compute mip levels");
+		Debug::sendError("Unsupported format while generating mipmaps");
 		return;
 	}
 
+	if (mipCount <= 1)
+		return;
+
 	m_mipLevels.resize(mipCount - 1);
 
-	const uint32_t pixelCount = extent.width * extent.height;
+	GenerationInfo levelGenerationInfo = generationInfo;
+	if (levelGenerationInfo.filter == Filter::BOX_LEGACY && !isLegacyFormat(format))
+	{
+		Debug::sendWarning("Legacy box filter doesn't support " + formatToString(format) + ", box filter is used");
+		levelGenerationInfo.filter = Filter::BOX;
+	}
 
+	const unsigned char* previousMip = firstMipPixels;
+	Extent2D previousExtent = extent;
 	for (uint32_t mipLevel = 1; mipLevel < static_cast<uint32_t>(mipCount); ++mipLevel)
 	{
-		if (format == Format::R8G8B8A8_UNORM || format == Format::R8G8B8A8_SRGB)
-		{
-			const ImageCompression::RGBA8* previousMip = reinterpret_cast<const ImageCompression::RGBA8*>(firstMipPixels);
-			if (mipLevel > 1)
-				previousMip = reinterpret_cast<ImageCompression::RGBA8*>(m_mipLevels[mipLevel - 2].data());
+		const Extent2D currentExtent = computeMipExtent(extent, mipLevel);
+		std::vector<unsigned char>& currentMip = m_mipLevels[mipLevel - 1];
+		currentMip.resize(static_cast<size_t>(currentExtent.width) * currentExtent.height * texelSize);
 
-			m_mipLevels[mipLevel - 1].resize((pixelCount >> mipLevel) * sizeof(ImageCompression::RGBA8));
+		if (levelGenerationInfo.filter == Filter::BOX_LEGACY && (previousExtent.width % 2 != 0 || previousExtent.height % 2 != 0))
+		{
+			Debug::sendWarning("Legacy box filter needs even sizes, box filter is used from mip level " + std::to_string(mipLevel));
+			levelGenerationInfo.filter = Filter::BOX;
+		}
 
-			createMipLevel(previousMip, reinterpret_cast<ImageCompression::RGBA8*>(m_mipLevels[mipLevel - 1].data()), extent.width >> (mipLevel - 1), extent.height >> (mipLevel - 1));
+		if (levelGenerationInfo.filter != Filter::BOX_LEGACY)
+		{
+			createMipLevel(previousMip, previousExtent, currentMip.data(), currentExtent, format, levelGenerationInfo);
 		}
 		else if (format == Format::R32G32_SFLOAT)
 		{
-			const ImageCompression::RG32F * previousMip = reinterpret_cast<const ImageCompression::RG32F*>(firstMipPixels);
-			if (mipLevel > 1)
-				previousMip = reinterpret_cast<ImageCompression::RG32F*>(m_mipLevels[mipLevel - 2].data());
-
-			m_mipLevels[mipLevel - 1].resize((pixelCount >> mipLevel) * sizeof(ImageCompression::RG32F));
-
-			createMipLevel(previousMip, reinterpret_cast<ImageCompression::RG32F*>(m_mipLevels[mipLevel - 1].data()), extent.width >> (mipLevel - 1), extent.height >> (mipLevel - 1));
+			createMipLevelLegacy(reinterpret_cast<const ImageCompression::RG32F*>(previousMip), reinterpret_cast<ImageCompression::RG32F*>(currentMip.data()),
+				previousExtent.width, previousExtent.height, levelGenerationInfo.parallel);
 		}
 		else
 		{
-			Debug::sendError("Unsupported format while generating mipmaps");
-			break;
+			createMipLevelLegacy(reinterpret_cast<const ImageCompression::RGBA8*>(previousMip), reinterpret_cast<ImageCompression::RGBA8*>(currentMip.data()),
+				previousExtent.width, previousExtent.height, levelGenerationInfo.parallel);
 		}
+
+		previousMip = currentMip.data();
+		previousExtent = currentExtent;
 	}
 }
 
-void Wolf::MipMapGenerator::createMipLevel(const ImageCompression::RGBA8* previousMip, ImageCompression::RGBA8* currentMip, uint32_t width, uint32_t height)
+void Wolf::MipMapGenerator::createMipLevelLegacy(const ImageCompression::RGBA8* previousMip, ImageCompression::RGBA8* currentMip, uint32_t width, uint32_t height, bool parallel)
 {
-	for (uint32_t x = 0; x < width; x += 2)
+	// Same operations as RGBA8::mergeBlock, in the same order, so results are identical
+	const auto createRows = [&](uint32_t firstRow, uint32_t lastRow)
 	{
-		for (uint32_t y = 0; y < height; y += 2)
+		for (uint32_t y = firstRow; y < lastRow; ++y)
 		{
-			const ImageCompression::RGBA8& block00 = previousMip[x       + y * width];
-			const ImageCompression::RGBA8& block01 = previousMip[x       + (y + 1) * width];
-			const ImageCompression::RGBA8& block10 = previousMip[(x + 1) + y * width];
-			const ImageCompression::RGBA8& block11 = previousMip[(x + 1) + (y + 1) * width];
+			const RGBA8* row0 = previousMip + static_cast<size_t>(2 * y) * width;
+			const RGBA8* row1 = row0 + width;
+			RGBA8* outRow = currentMip + static_cast<size_t>(y) * (width / 2);
 
-			const ImageCompression::RGBA8 mergedPixel = ImageCompression::RGBA8::mergeBlock(block00, block01, block10, block11);
-			currentMip[x / 2 + (y / 2) * (width / 2)] = mergedPixel;
+			uint32_t x = 0;
+#if defined(MIP_MAP_GENERATOR_SSE2)
+			const __m128i zero = _mm_setzero_si128();
+			const __m128 maxValue = _mm_set1_ps(255.0f);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const auto toFloats = [&](__m128i bytes) { return _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(bytes, zero)), maxValue); };
+			const auto mergeTexels = [&](__m128i texels0, __m128i texels1)
+			{
+				const __m128 merged0 = _mm_mul_ps(_mm_add_ps(toFloats(texels0), toFloats(texels1)), half);
+				const __m128 merged1 = _mm_mul_ps(_mm_add_ps(toFloats(_mm_srli_si128(texels0, 8)), toFloats(_mm_srli_si128(texels1, 8))), half);
+				return _mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(merged0, merged1), half), maxValue));
+			};
+			for (; x + 4 <= width; x += 4)
+			{
+				const __m128i texels0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x));
+				const __m128i texels1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x));
+				const __m128i merged = _mm_packs_epi32(mergeTexels(_mm_unpacklo_epi8(texels0, zero), _mm_unpacklo_epi8(texels1, zero)),
+					mergeTexels(_mm_unpackhi_epi8(texels0, zero), _mm_unpackhi_epi8(texels1, zero)));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(outRow + x / 2), _mm_packus_epi16(merged, merged));
+			}
+#elif defined(MIP_MAP_GENERATOR_NEON)
+			const auto toFloats = [](uint16x4_t values) { return vdivq_f32(vcvtq_f32_u32(vmovl_u16(values)), vdupq_n_f32(255.0f)); };
+			const auto mergeTexels = [&](uint16x8_t texels0, uint16x8_t texels1)
+			{
+				const float32x4_t merged0 = vmulq_n_f32(vaddq_f32(toFloats(vget_low_u16(texels0)), toFloats(vget_low_u16(texels1))), 0.5f);
+				const float32x4_t merged1 = vmulq_n_f32(vaddq_f32(toFloats(vget_high_u16(texels0)), toFloats(vget_high_u16(texels1))), 0.5f);
+				return vmovn_u32(vcvtq_u32_f32(vmulq_n_f32(vmulq_n_f32(vaddq_f32(merged0, merged1), 0.5f), 255.0f)));
+			};
+			for (; x + 4 <= width; x += 4)
+			{
+				const uint8x16_t texels0 = vld1q_u8(reinterpret_cast<const uint8_t*>(row0 + x));
+				const uint8x16_t texels1 = vld1q_u8(reinterpret_cast<const uint8_t*>(row1 + x));
+				const uint16x8_t merged = vcombine_u16(mergeTexels(vmovl_u8(vget_low_u8(texels0)), vmovl_u8(vget_low_u8(texels1))),
+					mergeTexels(vmovl_u8(vget_high_u8(texels0)), vmovl_u8(vget_high_u8(texels1))));
+				vst1_u8(reinterpret_cast<uint8_t*>(outRow + x / 2), vmovn_u16(merged));
+			}
+#endif
+			for (; x < width; x += 2)
+				outRow[x / 2] = RGBA8::mergeBlock(row0[x], row1[x], row0[x + 1], row1[x + 1]);
 		}
-	}
+	};
+
+	if (parallel)
+		parallelFor(height / 2, MIN_ROW_COUNT_PER_RANGE, createRows);
+	else
+		createRows(0, height / 2);
 }
 
-void Wolf::MipMapGenerator::createMipLevel(const ImageCompression::RG32F* previousMip, ImageCompression::RG32F* currentMip, uint32_t width, uint32_t height)
+void Wolf::MipMapGenerator::createMipLevelLegacy(const ImageCompression::RG32F* previousMip, ImageCompression::RG32F* currentMip, uint32_t width, uint32_t height, bool parallel)
 {
-	for (uint32_t x = 0; x < width; x += 2)
+	const auto createRows = [&](uint32_t firstRow, uint32_t lastRow)
 	{
-		for (uint32_t y = 0; y < height; y += 2)
+		for (uint32_t y = firstRow; y < lastRow; ++y)
 		{
-			const ImageCompression::RG32F& block00 = previousMip[x + y * width];
-			const ImageCompression::RG32F& block01 = previousMip[x + (y + 1) * width];
-			const ImageCompression::RG32F& block10 = previousMip[(x + 1) + y * width];
-			const ImageCompression::RG32F& block11 = previousMip[(x + 1) + (y + 1) * width];
+			const RG32F* row0 = previousMip + static_cast<size_t>(2 * y) * width;
+			const RG32F* row1 = row0 + width;
+			RG32F* outRow = currentMip + static_cast<size_t>(y) * (width / 2);
 
-			const ImageCompression::RG32F mergedPixel = ImageCompression::RG32F::mergeBlock(block00, block01, block10, block11);
-			glm::vec3 mergedPixelAsVec = glm::vec3(mergedPixel.r, mergedPixel.g, glm::sqrt(1.0f - mergedPixel.r * mergedPixel.r - mergedPixel.g * mergedPixel.g));
-			mergedPixelAsVec = glm::normalize(mergedPixelAsVec);
+			for (uint32_t x = 0; x < width; x += 2)
+			{
+				const RG32F mergedPixel = RG32F::mergeBlock(row0[x], row1[x], row0[x + 1], row1[x + 1]);
+				glm::vec3 mergedPixelAsVec = glm::vec3(mergedPixel.r, mergedPixel.g, glm::sqrt(1.0f - mergedPixel.r * mergedPixel.r - mergedPixel.g * mergedPixel.g));
+				mergedPixelAsVec = glm::normalize(mergedPixelAsVec);
 
-			currentMip[x / 2 + (y / 2) * (width / 2)] = ImageCompression::RG32F(mergedPixelAsVec.x, mergedPixelAsVec.y);
+				outRow[x / 2] = RG32F(mergedPixelAsVec.x, mergedPixelAsVec.y);
+			}
 		}
-	}
+	};
+
+	if (parallel)
+		parallelFor(height / 2, MIN_ROW_COUNT_PER_RANGE, createRows);
+	else
+		createRows(0, height / 2);
+}
+
+void Wolf::MipMapGenerator::createMipLevel(const unsigned char* previousMip, Extent2D previousExtent, unsigned char* currentMip, Extent2D currentExtent, Format format,
+	const GenerationInfo& generationInfo)
+{
+	const FilterTaps horizontalTaps = computeFilterTaps(previousExtent.width, currentExtent.width, generationInfo.filter);
+	const FilterTaps verticalTaps = computeFilterTaps(previousExtent.height, currentExtent.height, generationInfo.filter);
+	const uint32_t texelSize = computeTexelSize(format);
+	const bool isNormalMap = generationInfo.isNormalMap && (format == Format::R8G8_UNORM || format == Format::R32G32_SFLOAT);
+
+	// Source rows are filtered vertically first, the result is then filtered horizontally
+	const auto createRows = [&](uint32_t firstRow, uint32_t lastRow)
+	{
+		const uint32_t sourceRowFloatCount = previousExtent.width * FILTERED_CHANNEL_COUNT;
+		std::vector<float> verticallyFilteredRow(sourceRowFloatCount);
+		std::vector<float> filteredRow(static_cast<size_t>(currentExtent.width) * FILTERED_CHANNEL_COUNT);
+
+		// Taps of consecutive rows overlap with wide filters, source row i is kept decoded in slot i % tapCount
+		std::vector<float> decodedRows(static_cast<size_t>(sourceRowFloatCount) * verticalTaps.tapCount);
+		std::vector<uint32_t> decodedRowSourceIndices(verticalTaps.tapCount, std::numeric_limits<uint32_t>::max());
+
+		for (uint32_t y = firstRow; y < lastRow; ++y)
+		{
+			for (uint32_t tapIdx = 0; tapIdx < verticalTaps.tapCount; ++tapIdx)
+			{
+				const uint32_t tapOffset = y * verticalTaps.tapCount + tapIdx;
+				const uint32_t sourceIdx = verticalTaps.sourceIndices[tapOffset];
+				const uint32_t slotIdx = sourceIdx % verticalTaps.tapCount;
+				float* decodedRow = decodedRows.data() + static_cast<size_t>(slotIdx) * sourceRowFloatCount;
+				if (decodedRowSourceIndices[slotIdx] != sourceIdx)
+				{
+					decodeRow(previousMip + static_cast<size_t>(sourceIdx) * previousExtent.width * texelSize, previousExtent.width, format, isNormalMap, decodedRow);
+					decodedRowSourceIndices[slotIdx] = sourceIdx;
+				}
+
+				const float weight = verticalTaps.weights[tapOffset];
+				if (tapIdx == 0)
+					scaleFloats(verticallyFilteredRow.data(), decodedRow, weight, sourceRowFloatCount);
+				else
+					multiplyAddFloats(verticallyFilteredRow.data(), decodedRow, weight, sourceRowFloatCount);
+			}
+
+			for (uint32_t x = 0; x < currentExtent.width; ++x)
+			{
+				float* outTexel = filteredRow.data() + x * FILTERED_CHANNEL_COUNT;
+				for (uint32_t tapIdx = 0; tapIdx < horizontalTaps.tapCount; ++tapIdx)
+				{
+					const uint32_t tapOffset = x * horizontalTaps.tapCount + tapIdx;
+					const float* texel = verticallyFilteredRow.data() + horizontalTaps.sourceIndices[tapOffset] * FILTERED_CHANNEL_COUNT;
+
+					if (tapIdx == 0)
+						scaleFloats(outTexel, texel, horizontalTaps.weights[tapOffset], FILTERED_CHANNEL_COUNT);
+					else
+						multiplyAddFloats(outTexel, texel, horizontalTaps.weights[tapOffset], FILTERED_CHANNEL_COUNT);
+				}
+			}
+
+			encodeRow(filteredRow.data(), currentExtent.width, format, isNormalMap, currentMip + static_cast<size_t>(y) * currentExtent.width * texelSize);
+		}
+	};
+
+	if (generationInfo.parallel)
+		parallelFor(currentExtent.height, MIN_ROW_COUNT_PER_RANGE, createRows);
+	else
+		createRows(0, currentExtent.height);
 }
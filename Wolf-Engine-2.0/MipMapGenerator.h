@@ -9,22 +9,43 @@
 
 namespace Wolf
 {
+	// Supported formats: R8G8B8A8_UNORM, R8G8B8A8_SRGB, R8G8_UNORM, R16G16B16A16_SFLOAT, R32G32_SFLOAT and R32G32B32A32_SFLOAT
 	class MipMapGenerator
 	{
 	public:
+		enum class Filter
+		{
+			BOX_LEGACY, // same output as the first generator: 2x2 average of the stored values, truncated. RGBA8 and RG32F with even sizes only
+			BOX,        // 2x2 average, 3 taps on odd sizes. sRGB colors are averaged in linear space and values are rounded
+			KAISER      // Kaiser windowed sinc, keeps more details than box
+		};
+
+		struct GenerationInfo
+		{
+			Filter filter = Filter::BOX;
+			// RG formats hold the XY of unit vectors (remapped from [0, 1] for R8G8_UNORM), filtered vectors are renormalized.
+			// BOX_LEGACY always does it for R32G32_SFLOAT
+			bool isNormalMap = false;
+			// Rows of each level are split across the engine workers, a level still needs the previous one to be complete
+			bool parallel = true;
+		};
+
 		static uint32_t computeMipCount(Extent2D extent);
+		static Extent2D computeMipExtent(Extent2D extent, uint32_t mipLevel);
 
 		MipMapGenerator(const unsigned char* firstMipPixels, Extent2D extent, Format format, int mipCount = -1);
+		MipMapGenerator(const unsigned char* firstMipPixels, Extent2D extent, Format format, int mipCount, const GenerationInfo& generationInfo);
 		MipMapGenerator(const MipMapGenerator&) = delete;
 
 		uint32_t getMipLevelCount() const { return static_cast<uint32_t>(m_mipLevels.size()) + 1; }
 		const std::vector<unsigned char>& getMipLevel(uint32_t mipLevel) const { return m_mipLevels[mipLevel - 1]; }
 
 	private:
-		static void createMipLevel(const ImageCompression::RGBA8* previousMip, ImageCompression::RGBA8* currentMip, uint32_t width, uint32_t height);
-		static void createMipLevel(const ImageCompression::RG32F* previousMip, ImageCompression::RG32F* currentMip, uint32_t width, uint32_t height);
+		static constexpr uint32_t MIN_ROW_COUNT_PER_RANGE = 8;
+		static void createMipLevelLegacy(const ImageCompression::RGBA8* previousMip, ImageCompression::RGBA8* currentMip, uint32_t width, uint32_t height, bool parallel);
+		static void createMipLevelLegacy(const ImageCompression::RG32F* previousMip, ImageCompression::RG32F* currentMip, uint32_t width, uint32_t height, bool parallel);
+		static void createMipLevel(const unsigned char* previousMip, Extent2D previousExtent, unsigned char* currentMip, Extent2D currentExtent, Format format, const GenerationInfo& generationInfo);
 
 		std::vector<std::vector<unsigned char>> m_mipLevels;
 	};
 }
-
@@ -1,5 +1,6 @@
 #include "MultiThreadTaskManager.h"
 
+#include <algorithm>
 #include <string>
 
 #include <Debug.h>
@@ -7,23 +8,22 @@
 #include "DynamicResourceUniqueOwnerArray.h"
 #include "ProfilerCommon.h"
 
-Wolf::MultiThreadTaskManager::ThreadGroupId Wolf::MultiThreadTaskManager::createThreadGroup(uint32_t threadCount, const std::string& name)
+Wolf::MultiThreadTaskManager::ThreadGroupId Wolf::MultiThreadTaskManager::createThreadGroup(uint32_t threadCount, const std::string& name, const CPUAffinity& affinity)
 {
-	m_threadGroups[m_threadGroupCount].initialize(threadCount, name, [this]() { return requestThreadInPool(); });
-	m_threadGroupCount++;
-	return m_threadGroupCount - 1;
+	m_threadGroups.emplace_back(new ThreadGroup)->initialize(threadCount, name, affinity, m_telemetry, [this]() { return requestThreadInPool(); });
+	return static_cast<ThreadGroupId>(m_threadGroups.size()) - 1;
 }
 
-void Wolf::MultiThreadTaskManager::addJobToThreadGroup(ThreadGroupId threadGroupId, const Job& job)
+void Wolf::MultiThreadTaskManager::addJobToThreadGroup(ThreadGroupId threadGroupId, Job&& job)
 {
-	m_threadGroups[threadGroupId].addJob(job);
+	m_threadGroups[threadGroupId]->addJob(std::move(job));
 }
 
 void Wolf::MultiThreadTaskManager::executeJobsForThreadGroup(ThreadGroupId threadGroupId)
 {
 	PROFILE_FUNCTION
 
-	ThreadGroup& threadGroup = m_threadGroups[threadGroupId];
+	ThreadGroup& threadGroup = *m_threadGroups[threadGroupId];
 	threadGroup.executeJobs();
 }
 
@@ -31,35 +31,60 @@ void Wolf::MultiThreadTaskManager::waitForThreadGroup(ThreadGroupId threadGroupI
 {
 	PROFILE_FUNCTION
 
-	ThreadGroup& threadGroup = m_threadGroups[threadGroupId];
+	ThreadGroup& threadGroup = *m_threadGroups[threadGroupId];
 	threadGroup.waitJobsCompleted();
 }
 
+void Wolf::MultiThreadTaskManager::spawnJobInThreadGroup(ThreadGroupId threadGroupId, Job&& job)
+{
+	m_threadGroups[threadGroupId]->spawnJob(std::move(job));
+}
+
+bool Wolf::MultiThreadTaskManager::helpThreadGroup(ThreadGroupId threadGroupId)
+{
+	return m_threadGroups[threadGroupId]->executeOneJob();
+}
+
+void Wolf::MultiThreadTaskManager::parallelForInThreadGroup(ThreadGroupId threadGroupId, uint32_t chunkCount, const ChunkFunction& function)
+{
+	m_threadGroups[threadGroupId]->parallelFor(chunkCount, function);
+}
+
+uint32_t Wolf::MultiThreadTaskManager::getThreadCountInThreadGroup(ThreadGroupId threadGroupId) const
+{
+	return m_threadGroups[threadGroupId]->getThreadCount();
+}
+
 Wolf::MultiThreadTaskManager::Thread* Wolf::MultiThreadTaskManager::requestThreadInPool()
 {
-	m_requestedThreadCount++;
-	return &m_threadPool[m_requestedThreadCount - 1];
+	return m_threadPool.emplace_back(new Thread).get();
 }
 
-#ifdef _WIN32
-#include <windows.h>
-#endif
-void Wolf::MultiThreadTaskManager::ThreadGroup::PerThread::execution(const std::string& name)
+void Wolf::MultiThreadTaskManager::ThreadGroup::PerThread::execution(const std::string& name, const CPUAffinity& affinity, JobsTelemetry* telemetry)
 {
-#ifdef _WIN32
-	std::wstring wName = std::wstring(name.begin(), name.end());
-	LPCWSTR swName = wName.c_str();
-	SetThreadDescription(GetCurrentThread(), swName);
-#endif 
+	setCurrentThreadName(name);
+	setCurrentThreadAffinity(affinity);
+	if (telemetry)
+		telemetry->registerCurrentThread(name);
+
+	m_jobsPool->setCurrentThreadSlot(m_slotIdx);
 
 	for (;;)
 	{
 		std::unique_lock<std::mutex> lock(m_thread->mutex);
-		Job jobToExecute;
+		Job* jobToExecute;
 		{
 			PROFILE_SCOPED("Thread execution wait")
+			JobsTelemetry::ThreadTimeScope idleTimeScope(JobsTelemetry::ThreadState::IDLE);
 
-			m_thread->runCondition.wait(lock, [&] { return m_jobsPool->getNextJob(jobToExecute) || m_stopThreadRequested; });
+			m_thread->runCondition.wait(lock, [&]
+			{
+				if (m_jobsPool->getNextJob(m_slotIdx, jobToExecute))
+					return true;
+
+				jobToExecute = nullptr;
+				return m_jobsPool->hasParallelBatchToHelp() || m_stopThreadRequested;
+			});
 		}
 
 		if (m_stopThreadRequested)
@@ -68,11 +93,18 @@ void Wolf::MultiThreadTaskManager::ThreadGroup::PerThread::execution(const std::
 		}
 
 		PROFILE_SCOPED("Thread jobs execution")
+		JobsTelemetry::ThreadTimeScope busyTimeScope(JobsTelemetry::ThreadState::BUSY);
 
 		do
 		{
-			jobToExecute();
-		} while (m_jobsPool->getNextJob(jobToExecute));
+			if (jobToExecute)
+			{
+				(*jobToExecute)();
+				m_jobsPool->onJobExecuted();
+			}
+
+			m_jobsPool->helpParallelBatches();
+		} while (m_jobsPool->getNextJob(m_slotIdx, jobToExecute));
 	}
 }
 
@@ -81,87 +113,388 @@ void Wolf::MultiThreadTaskManager::ThreadGroup::PerThread::notifyThreads() const
 	m_thread->runCondition.notify_all();
 }
 
-void Wolf::MultiThreadTaskManager::ThreadGroup::PerThread::waitJobsCompleted()
+void Wolf::MultiThreadTaskManager::ThreadGroup::initialize(uint32_t threadCount, const std::string& name, const CPUAffinity& affinity, JobsTelemetry* telemetry,
+	const std::function<Thread*()>& requestThreadInPool)
 {
-	m_thread->mutex.lock();
-	m_thread->mutex.unlock();
-}
-
-void Wolf::MultiThreadTaskManager::ThreadGroup::initialize(uint32_t threadCount, const std::string& name, const std::function<Thread*()>& requestThreadInPool)
-{
-	m_jobsPool.reset(new JobsPool);
+	m_jobsPool.reset(new JobsPool(threadCount + 1));
 
 	for (uint32_t threadIdx = 0; threadIdx < threadCount; ++threadIdx)
 	{
-		m_threads.emplace_back(new PerThread(requestThreadInPool(), m_jobsPool.createNonOwnerResource(), name + std::to_string(threadIdx)));
+		m_threads.emplace_back(new PerThread(requestThreadInPool(), m_jobsPool.createNonOwnerResource(), threadIdx, name + " " + std::to_string(threadIdx), affinity, telemetry));
 	}
 }
 
-void Wolf::MultiThreadTaskManager::ThreadGroup::addJob(const Job& job)
+void Wolf::MultiThreadTaskManager::ThreadGroup::addJob(Job&& job)
 {
-	m_jobsPool->addJob(job);
+	m_jobsPool->addJob(std::move(job));
 }
 
 void Wolf::MultiThreadTaskManager::ThreadGroup::executeJobs()
 {
 	m_jobsPool->moveToNextFrame();
 
-	Job jobToExecute;
-	if (!m_jobsPool->getNextJob(jobToExecute))
+	// Calling thread uses the last slot
+	const uint32_t slotIdx = static_cast<uint32_t>(m_threads.size());
+
+	Job* jobToExecute;
+	if (!m_jobsPool->getNextJob(slotIdx, jobToExecute))
 		return;
 
+	m_jobsPool->setCurrentThreadSlot(slotIdx);
+
 	for (uint32_t threadIdx = 0; threadIdx < m_threads.size(); ++threadIdx)
 	{
 		ResourceUniqueOwner<PerThread>& thread = m_threads[threadIdx];
 		thread->notifyThreads();
 	}
 
+	JobsTelemetry::ThreadTimeScope busyTimeScope(JobsTelemetry::ThreadState::BUSY);
 	do
 	{
-		jobToExecute();
-	} while (m_jobsPool->getNextJob(jobToExecute));
+		(*jobToExecute)();
+		m_jobsPool->onJobExecuted();
+	} while (m_jobsPool->getNextJob(slotIdx, jobToExecute));
+
+	JobsPool::resetCurrentThreadSlot();
 }
 
 void Wolf::MultiThreadTaskManager::ThreadGroup::waitJobsCompleted()
 {
+	m_jobsPool->waitJobsExecuted(static_cast<uint32_t>(m_threads.size()));
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::spawnJob(Job&& job)
+{
+	if (!m_jobsPool->spawnJob(job))
+	{
+		job();
+		return;
+	}
+
+	for (uint32_t threadIdx = 0; threadIdx < m_threads.size(); ++threadIdx)
+	{
+		ResourceUniqueOwner<PerThread>& thread = m_threads[threadIdx];
+		thread->notifyThreads();
+	}
+}
+
+bool Wolf::MultiThreadTaskManager::ThreadGroup::executeOneJob()
+{
+	Job* jobToExecute;
+	if (!m_jobsPool->getNextJobForCurrentThread(jobToExecute))
+		return false;
+
+	(*jobToExecute)();
+	m_jobsPool->onJobExecuted();
+	return true;
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::parallelFor(uint32_t chunkCount, const ChunkFunction& function)
+{
+	if (chunkCount <= 1 || m_threads.empty())
+	{
+		for (uint32_t chunkIdx = 0; chunkIdx < chunkCount; ++chunkIdx)
+		{
+			function(chunkIdx);
+		}
+		return;
+	}
+
+	JobsPool::ParallelBatch parallelBatch(chunkCount, function);
+	m_jobsPool->addParallelBatch(&parallelBatch);
+
 	for (uint32_t threadIdx = 0; threadIdx < m_threads.size(); ++threadIdx)
 	{
 		ResourceUniqueOwner<PerThread>& thread = m_threads[threadIdx];
-		thread->waitJobsCompleted();
+		thread->notifyThreads();
 	}
+
+	JobsPool::executeParallelBatchChunks(parallelBatch);
+	m_jobsPool->removeParallelBatch(&parallelBatch);
 }
 
-void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::addJob(const Job& job)
+thread_local Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool* Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::s_currentThreadJobsPool = nullptr;
+thread_local uint32_t Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::s_currentThreadSlotIdx = 0;
+
+Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::JobsPool(uint32_t slotCount)
 {
-	m_nextJobs.emplace(job);
+	m_slots.resize(slotCount);
+	for (uint32_t slotIdx = 0; slotIdx < slotCount; ++slotIdx)
+	{
+		m_slots[slotIdx].reset(new Slot);
+		m_slots[slotIdx]->m_randomState = 0x9E3779B9u * (slotIdx + 1);
+	}
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::addJob(Job&& job)
+{
+	std::lock_guard<std::mutex> lock(m_nextJobsMutex);
+	m_nextJobs.emplace_back(std::move(job));
 }
 
 void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::moveToNextFrame()
 {
-	m_currentJobs.swap(m_nextJobs);
+	// Previous frame jobs are all executed at this point, storage is kept to avoid allocations
+	m_currentJobs.clear();
+	for (std::unique_ptr<Slot>& slot : m_slots)
+	{
+		slot->m_spawnedJobs.reset();
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_nextJobsMutex);
+		m_currentJobs.swap(m_nextJobs);
+	}
+
+	m_pendingJobCount.store(static_cast<uint32_t>(m_currentJobs.size()), std::memory_order_relaxed);
+
+	m_currentJobsCursor.store(static_cast<uint64_t>(m_currentJobs.size()) << 32, std::memory_order_release);
+}
+
+bool Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::getNextJob(uint32_t slotIdx, Job*& outJob)
+{
+	if (m_slots[slotIdx]->m_jobs.pop(outJob))
+		return true;
+
+	if (claimInjectedJobs(slotIdx, outJob))
+		return true;
+
+	return stealJob(slotIdx, outJob);
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::onJobExecuted()
+{
+	if (m_pendingJobCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		m_pendingJobCount.notify_all();
+	}
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::waitJobsExecuted(uint32_t slotIdx)
+{
+	setCurrentThreadSlot(slotIdx);
+
+	for (;;)
+	{
+		// Help while jobs are remaining
+		{
+			JobsTelemetry::ThreadTimeScope busyTimeScope(JobsTelemetry::ThreadState::BUSY);
+
+			Job* jobToExecute;
+			while (getNextJob(slotIdx, jobToExecute))
+			{
+				(*jobToExecute)();
+				onJobExecuted();
+			}
+		}
+
+		const uint32_t pendingJobCount = m_pendingJobCount.load(std::memory_order_acquire);
+		if (pendingJobCount == 0)
+			break;
+
+		// Woken up when all jobs are done or when a job is spawned
+		JobsTelemetry::ThreadTimeScope waitTimeScope(JobsTelemetry::ThreadState::WAIT);
+		m_pendingJobCount.wait(pendingJobCount, std::memory_order_acquire);
+	}
+
+	resetCurrentThreadSlot();
+}
+
+bool Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::spawnJob(Job& job)
+{
+	if (s_currentThreadJobsPool != this)
+		return false;
+
+	Slot& slot = *m_slots[s_currentThreadSlotIdx];
+	Job* spawnedJob = slot.m_spawnedJobs.allocate(std::move(job));
+
+	// Count before publishing so the pool can't be seen as done while the job is waiting
+	m_pendingJobCount.fetch_add(1, std::memory_order_relaxed);
+	if (!slot.m_jobs.push(spawnedJob))
+	{
+		// Deque is full, the caller runs the job itself. Can't reach 0 as the calling job is still pending
+		m_pendingJobCount.fetch_sub(1, std::memory_order_relaxed);
+		job = std::move(*spawnedJob);
+		return false;
+	}
+
+	m_pendingJobCount.notify_all();
+	return true;
+}
+
+bool Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::getNextJobForCurrentThread(Job*& outJob)
+{
+	if (s_currentThreadJobsPool != this)
+		return false;
+
+	return getNextJob(s_currentThreadSlotIdx, outJob);
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::addParallelBatch(ParallelBatch* parallelBatch)
+{
+	std::lock_guard<std::mutex> lock(m_parallelBatchesMutex);
+	m_parallelBatches.push_back(parallelBatch);
+	m_parallelBatchCount.store(static_cast<uint32_t>(m_parallelBatches.size()), std::memory_order_release);
 }
 
-bool Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::getNextJob(Job& outJob)
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::removeParallelBatch(ParallelBatch* parallelBatch)
 {
-	m_currentJobsMutex.lock();
+	std::unique_lock<std::mutex> lock(m_parallelBatchesMutex);
+	std::erase(m_parallelBatches, parallelBatch);
+	m_parallelBatchCount.store(static_cast<uint32_t>(m_parallelBatches.size()), std::memory_order_release);
 
-	if (m_currentJobs.empty())
+	// All chunks are claimed, wait for helpers still executing the last ones
+	m_parallelBatchHelpersCondition.wait(lock, [&] { return parallelBatch->m_helperCount == 0; });
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::executeParallelBatchChunks(ParallelBatch& parallelBatch)
+{
+	RuntimeContext::CPUFrameNumberOverrideScope cpuFrameNumberOverrideScope(parallelBatch.m_cpuFrameNumberOverride);
+
+	uint32_t chunkIdx;
+	while ((chunkIdx = parallelBatch.m_nextChunkIdx.fetch_add(1, std::memory_order_relaxed)) < parallelBatch.m_chunkCount)
 	{
-		m_currentJobsMutex.unlock();
+		parallelBatch.m_function(chunkIdx);
+	}
+}
+
+bool Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::hasParallelBatchToHelp()
+{
+	if (m_parallelBatchCount.load(std::memory_order_acquire) == 0)
 		return false;
+
+	std::lock_guard<std::mutex> lock(m_parallelBatchesMutex);
+	return std::ranges::any_of(m_parallelBatches, [](const ParallelBatch* parallelBatch)
+	{
+		return parallelBatch->m_nextChunkIdx.load(std::memory_order_relaxed) < parallelBatch->m_chunkCount;
+	});
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::helpParallelBatches()
+{
+	if (m_parallelBatchCount.load(std::memory_order_acquire) == 0)
+		return;
+
+	for (;;)
+	{
+		ParallelBatch* parallelBatchToHelp = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_parallelBatchesMutex);
+			for (ParallelBatch* parallelBatch : m_parallelBatches)
+			{
+				if (parallelBatch->m_nextChunkIdx.load(std::memory_order_relaxed) < parallelBatch->m_chunkCount)
+				{
+					parallelBatchToHelp = parallelBatch;
+					parallelBatchToHelp->m_helperCount++;
+					break;
+				}
+			}
+		}
+
+		if (!parallelBatchToHelp)
+			return;
+
+		PROFILE_SCOPED("Parallel batch help")
+
+		executeParallelBatchChunks(*parallelBatchToHelp);
+
+		// Batch can be destroyed as soon as the mutex is released
+		std::lock_guard<std::mutex> lock(m_parallelBatchesMutex);
+		parallelBatchToHelp->m_helperCount--;
+		m_parallelBatchHelpersCondition.notify_all();
 	}
+}
 
-	outJob = m_currentJobs.front();
-	m_currentJobs.pop();
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::setCurrentThreadSlot(uint32_t slotIdx)
+{
+	s_currentThreadJobsPool = this;
+	s_currentThreadSlotIdx = slotIdx;
+}
+
+void Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::resetCurrentThreadSlot()
+{
+	s_currentThreadJobsPool = nullptr;
+}
 
-	m_currentJobsMutex.unlock();
+bool Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::claimInjectedJobs(uint32_t slotIdx, Job*& outJob)
+{
+	uint64_t cursor = m_currentJobsCursor.load(std::memory_order_acquire);
+	uint32_t firstJobIdx;
+	uint32_t claimedJobCount;
+	do
+	{
+		firstJobIdx = static_cast<uint32_t>(cursor);
+		const uint32_t jobCount = static_cast<uint32_t>(cursor >> 32);
+		if (firstJobIdx >= jobCount)
+			return false;
+
+		// Take a share of the remaining jobs, small enough to let other slots get some
+		const uint32_t remainingJobCount = jobCount - firstJobIdx;
+		claimedJobCount = std::clamp(remainingJobCount / (2 * static_cast<uint32_t>(m_slots.size())), 1u, MAX_JOBS_CLAIMED_AT_ONCE);
+	} while (!m_currentJobsCursor.compare_exchange_weak(cursor, cursor + claimedJobCount, std::memory_order_acq_rel, std::memory_order_acquire));
+
+	// Push in reverse order so the owner pops them in submission order.
+	// The owner only claims once its deque is empty, the claimed jobs but the returned one always fit
+	static_assert(MAX_JOBS_CLAIMED_AT_ONCE - 1 <= SLOT_JOB_CAPACITY);
+	Slot& slot = *m_slots[slotIdx];
+	for (uint32_t jobIdx = firstJobIdx + claimedJobCount - 1; jobIdx > firstJobIdx; --jobIdx)
+	{
+		if (!slot.m_jobs.push(&m_currentJobs[jobIdx]))
+		{
+			// Deque is full, the job is executed now rather than lost. Can't reach 0 as the returned job is still pending
+			Debug::sendError("Claimed jobs don't fit in the slot deque");
+			m_currentJobs[jobIdx]();
+			onJobExecuted();
+		}
+	}
 
+	outJob = &m_currentJobs[firstJobIdx];
 	return true;
 }
 
-Wolf::MultiThreadTaskManager::ThreadGroup::PerThread::PerThread(Thread* thread, const ResourceNonOwner<JobsPool>& jobsPool, const std::string& name) : m_thread(thread), m_jobsPool(jobsPool)
+bool Wolf::MultiThreadTaskManager::ThreadGroup::JobsPool::stealJob(uint32_t slotIdx, Job*& outJob)
+{
+	const uint32_t slotCount = static_cast<uint32_t>(m_slots.size());
+	if (slotCount < 2)
+		return false;
+
+	// xorshift32
+	uint32_t& randomState = m_slots[slotIdx]->m_randomState;
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+
+	bool retry = true;
+	while (retry)
+	{
+		retry = false;
+
+		const uint32_t firstVictimIdx = randomState % slotCount;
+		for (uint32_t i = 0; i < slotCount; ++i)
+		{
+			const uint32_t victimIdx = (firstVictimIdx + i) % slotCount;
+			if (victimIdx == slotIdx)
+				continue;
+
+			switch (m_slots[victimIdx]->m_jobs.steal(outJob))
+			{
+				case WorkStealingDeque<Job*, SLOT_JOB_CAPACITY>::StealResult::SUCCESS:
+					return true;
+				case WorkStealingDeque<Job*, SLOT_JOB_CAPACITY>::StealResult::ABORT:
+					retry = true;
+					break;
+				case WorkStealingDeque<Job*, SLOT_JOB_CAPACITY>::StealResult::EMPTY:
+					break;
+			}
+		}
+	}
+
+	return false;
+}
+
+Wolf::MultiThreadTaskManager::ThreadGroup::PerThread::PerThread(Thread* thread, const ResourceNonOwner<JobsPool>& jobsPool, uint32_t slotIdx, const std::string& name, const CPUAffinity& affinity,
+	JobsTelemetry* telemetry) : m_thread(thread), m_jobsPool(jobsPool), m_slotIdx(slotIdx)
 {
-	m_thread->thread = std::thread(&PerThread::execution, this, name);
+	m_thread->thread = std::thread(&PerThread::execution, this, name, affinity, telemetry);
 }
 
 Wolf::MultiThreadTaskManager::ThreadGroup::PerThread::~PerThread()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
@@ -9,22 +10,41 @@
 #include <thread>
 #include <vector>
 
+#include <RuntimeContext.h>
+
 #include "DynamicStableArray.h"
+#include "Job.h"
+#include "JobsTelemetry.h"
+#include "ThreadTopology.h"
+#include "WorkStealingDeque.h"
 
 namespace Wolf
 {
 	class MultiThreadTaskManager
 	{
 	public:
+		// Threads are registered to the telemetry when it's given
+		explicit MultiThreadTaskManager(JobsTelemetry* telemetry = nullptr) : m_telemetry(telemetry) {}
+
 		using ThreadGroupId = uint32_t;
-		ThreadGroupId createThreadGroup(uint32_t threadCount, const std::string& name);
+		ThreadGroupId createThreadGroup(uint32_t threadCount, const std::string& name, const CPUAffinity& affinity = {});
 
-		using Job = std::function<void()>;
-		void addJobToThreadGroup(ThreadGroupId threadGroupId, const Job& job);
+		using Job = Wolf::Job;
+		void addJobToThreadGroup(ThreadGroupId threadGroupId, Job&& job);
 
 		void executeJobsForThreadGroup(ThreadGroupId threadGroupId);
 		void waitForThreadGroup(ThreadGroupId threadGroupId);
 
+		// Adds a job to the ones currently executed by the group. If the calling thread doesn't take part in the execution, the job is executed immediately
+		void spawnJobInThreadGroup(ThreadGroupId threadGroupId, Job&& job);
+		// Executes one of the group's pending jobs on the calling thread, returns false if there's none or if the calling thread doesn't take part in the execution
+		bool helpThreadGroup(ThreadGroupId threadGroupId);
+
+		// Calls function for each chunk index, idle workers of the group help the calling thread (which can be any thread)
+		using ChunkFunction = std::function<void(uint32_t chunkIdx)>;
+		void parallelForInThreadGroup(ThreadGroupId threadGroupId, uint32_t chunkCount, const ChunkFunction& function);
+		[[nodiscard]] uint32_t getThreadCountInThreadGroup(ThreadGroupId threadGroupId) const;
+
 	private:
 		struct Thread
 		{
@@ -33,59 +53,120 @@ namespace Wolf
 			std::condition_variable runCondition;
 		};
 		Thread* requestThreadInPool();
-		static constexpr uint32_t MAX_THREAD_COUNT = 20;
-		std::array<Thread, MAX_THREAD_COUNT> m_threadPool;
-		uint32_t m_requestedThreadCount = 0;
+		std::vector<std::unique_ptr<Thread>> m_threadPool;
+		JobsTelemetry* m_telemetry;
 
 		class ThreadGroup
 		{
 		public:
 			ThreadGroup() = default;
-			void initialize(uint32_t threadCount, const std::string& name, const std::function<Thread*()>& requestThreadInPool);
+			void initialize(uint32_t threadCount, const std::string& name, const CPUAffinity& affinity, JobsTelemetry* telemetry, const std::function<Thread*()>& requestThreadInPool);
 
-			void addJob(const Job& job);
+			void addJob(Job&& job);
 			void executeJobs();
 			void waitJobsCompleted();
 
+			void spawnJob(Job&& job);
+			bool executeOneJob();
+
+			void parallelFor(uint32_t chunkCount, const ChunkFunction& function);
+			[[nodiscard]] uint32_t getThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
 		private:
 			class JobsPool
 			{
 			public:
-				void addJob(const Job& job);
+				// One slot per worker thread + one for the thread calling executeJobs()
+				explicit JobsPool(uint32_t slotCount);
+
+				void addJob(Job&& job);
 				void moveToNextFrame();
 
-				bool getNextJob(Job& outJob);
+				bool getNextJob(uint32_t slotIdx, Job*& outJob);
+				void onJobExecuted();
+				void waitJobsExecuted(uint32_t slotIdx);
+
+				// Only from a thread taking part in the current execution, job is left untouched when it can't be queued
+				bool spawnJob(Job& job);
+				bool getNextJobForCurrentThread(Job*& outJob);
+
+				void setCurrentThreadSlot(uint32_t slotIdx);
+				static void resetCurrentThreadSlot();
+
+				// Parallel batches are executed right away by the thread adding them and by idle workers
+				struct ParallelBatch
+				{
+					ParallelBatch(uint32_t chunkCount, const ChunkFunction& function)
+						: m_function(function), m_chunkCount(chunkCount), m_cpuFrameNumberOverride(RuntimeContext::getCPUFrameNumberOverride()) {}
+
+					const ChunkFunction& m_function;
+					const uint32_t m_chunkCount;
+					const uint32_t m_cpuFrameNumberOverride; // helpers see the frame number of the thread adding the batch
+					std::atomic<uint32_t> m_nextChunkIdx = 0;
+					uint32_t m_helperCount = 0; // protected by m_parallelBatchesMutex
+				};
+				void addParallelBatch(ParallelBatch* parallelBatch);
+				void removeParallelBatch(ParallelBatch* parallelBatch);
+				static void executeParallelBatchChunks(ParallelBatch& parallelBatch);
+				[[nodiscard]] bool hasParallelBatchToHelp();
+				void helpParallelBatches();
 
 			private:
-				std::queue<Job> m_nextJobs;
-
-				std::mutex m_currentJobsMutex;
-				std::queue<Job> m_currentJobs;
+				bool claimInjectedJobs(uint32_t slotIdx, Job*& outJob);
+				bool stealJob(uint32_t slotIdx, Job*& outJob);
+
+				// Injection queue: jobs added by any thread are only visible next frame
+				std::mutex m_nextJobsMutex;
+				std::vector<Job> m_nextJobs;
+
+				// Current frame jobs are claimed by batches (low 32 bits: next job index, high 32 bits: job count)
+				std::vector<Job> m_currentJobs;
+				std::atomic<uint64_t> m_currentJobsCursor = 0;
+				std::atomic<uint32_t> m_pendingJobCount = 0;
+
+				static constexpr uint32_t MAX_JOBS_CLAIMED_AT_ONCE = 64;
+				static constexpr uint32_t SLOT_JOB_CAPACITY = 64;
+				struct alignas(64) Slot
+				{
+					WorkStealingDeque<Job*, SLOT_JOB_CAPACITY> m_jobs;
+					uint32_t m_randomState = 0;
+
+					// Storage for jobs spawned by the slot owner, reset each frame
+					JobArena m_spawnedJobs;
+				};
+				std::vector<std::unique_ptr<Slot>> m_slots;
+
+				std::mutex m_parallelBatchesMutex;
+				std::condition_variable m_parallelBatchHelpersCondition;
+				std::vector<ParallelBatch*> m_parallelBatches;
+				std::atomic<uint32_t> m_parallelBatchCount = 0;
+
+				static thread_local JobsPool* s_currentThreadJobsPool;
+				static thread_local uint32_t s_currentThreadSlotIdx;
 			};
 			ResourceUniqueOwner<JobsPool> m_jobsPool;
 
 			class PerThread
 			{
 			public:
-				PerThread(Thread* thread, const ResourceNonOwner<JobsPool>& jobsPool, const std::string& name);
+				PerThread(Thread* thread, const ResourceNonOwner<JobsPool>& jobsPool, uint32_t slotIdx, const std::string& name, const CPUAffinity& affinity, JobsTelemetry* telemetry);
 				~PerThread();
 
-				void execution(const std::string& name);
+				void execution(const std::string& name, const CPUAffinity& affinity, JobsTelemetry* telemetry);
 
 				void notifyThreads() const;
-				void waitJobsCompleted();
 
 			private:
 				Thread* m_thread;
 				ResourceNonOwner<JobsPool> m_jobsPool;
+				uint32_t m_slotIdx;
 
 				bool m_stopThreadRequested = false;
 			};
 			DynamicStableArray<ResourceUniqueOwner<PerThread>, 2> m_threads;
 		};
-		static constexpr uint32_t MAX_THREAD_GROUP_COUNT = 4;
-		std::array<ThreadGroup, MAX_THREAD_GROUP_COUNT> m_threadGroups;
-		uint32_t m_threadGroupCount = 0;
+		// Declared after the pool as groups join their threads when destroyed
+		std::vector<std::unique_ptr<ThreadGroup>> m_threadGroups;
 	};
 
 }
@@ -0,0 +1,53 @@
+#include "ParallelFor.h"
+
+#include <algorithm>
+
+#include "JobsManager.h"
+
+uint32_t Wolf::computeParallelRangeSize(uint32_t count, uint32_t grainSize)
+{
+	grainSize = std::max(grainSize, 1u);
+	if (!g_jobsManager)
+		return std::max(count, grainSize);
+
+	// A few ranges per thread so threads finishing early can take more
+	static constexpr uint32_t RANGE_COUNT_PER_THREAD = 4;
+	const uint32_t targetRangeCount = g_jobsManager->getParallelThreadCount() * RANGE_COUNT_PER_THREAD;
+
+	return std::max(static_cast<uint32_t>((static_cast<uint64_t>(count) + targetRangeCount - 1) / targetRangeCount), grainSize);
+}
+
+uint32_t Wolf::computeParallelRangeCount(uint32_t count, uint32_t rangeSize)
+{
+	// 64 bits as count can be close to the 32 bits limit
+	return static_cast<uint32_t>((static_cast<uint64_t>(count) + rangeSize - 1) / rangeSize);
+}
+
+void Wolf::parallelForRanges(uint32_t rangeCount, const std::function<void(uint32_t rangeIdx)>& function)
+{
+	if (!g_jobsManager)
+	{
+		for (uint32_t rangeIdx = 0; rangeIdx < rangeCount; ++rangeIdx)
+		{
+			function(rangeIdx);
+		}
+		return;
+	}
+
+	g_jobsManager->parallelFor(rangeCount, function);
+}
+
+void Wolf::parallelFor(uint32_t count, uint32_t grainSize, const ParallelRangeFunction& function)
+{
+	if (count == 0)
+		return;
+
+	const uint32_t rangeSize = computeParallelRangeSize(count, grainSize);
+	const uint32_t rangeCount = computeParallelRangeCount(count, rangeSize);
+
+	parallelForRanges(rangeCount, [&](uint32_t rangeIdx)
+	{
+		const uint32_t begin = rangeIdx * rangeSize;
+		function(begin, begin + std::min(rangeSize, count - begin));
+	});
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Wolf
+{
+	// Splits [0, count) into ranges of at least grainSize elements. Ranges are executed by the calling thread
+	// with the help of idle engine workers. Everything runs on the calling thread when there's no JobsManager.
+	using ParallelRangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+	void parallelFor(uint32_t count, uint32_t grainSize, const ParallelRangeFunction& function);
+
+	// Each range is reduced from identity by rangeFunction(begin, end, identity), range results are then combined in order with reduceFunction
+	template <typename T, typename RangeFunction, typename ReduceFunction>
+	T parallelReduce(uint32_t count, uint32_t grainSize, const T& identity, const RangeFunction& rangeFunction, const ReduceFunction& reduceFunction);
+
+	// Chunking used by parallelFor and parallelReduce
+	uint32_t computeParallelRangeSize(uint32_t count, uint32_t grainSize);
+	uint32_t computeParallelRangeCount(uint32_t count, uint32_t rangeSize);
+	void parallelForRanges(uint32_t rangeCount, const std::function<void(uint32_t rangeIdx)>& function);
+
+	template <typename T, typename RangeFunction, typename ReduceFunction>
+	T parallelReduce(uint32_t count, uint32_t grainSize, const T& identity, const RangeFunction& rangeFunction, const ReduceFunction& reduceFunction)
+	{
+		if (count == 0)
+			return identity;
+
+		const uint32_t rangeSize = computeParallelRangeSize(count, grainSize);
+		const uint32_t rangeCount = computeParallelRangeCount(count, rangeSize);
+
+		std::vector<T> rangeResults(rangeCount, identity);
+		parallelForRanges(rangeCount, [&](uint32_t rangeIdx)
+		{
+			const uint32_t begin = rangeIdx * rangeSize;
+			const uint32_t end = begin + std::min(rangeSize, count - begin);
+			rangeResults[rangeIdx] = rangeFunction(begin, end, identity);
+		});
+
+		T result = identity;
+		for (const T& rangeResult : rangeResults)
+		{
+			result = reduceFunction(result, rangeResult);
+		}
+		return result;
+	}
+}
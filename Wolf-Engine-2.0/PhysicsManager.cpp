@@ -1,5 +1,7 @@
 #include "PhysicsManager.h"
 
+#include "ParallelFor.h"
+
 void Wolf::Physics::PhysicsManager::addStaticRectangle(const Rectangle& rectangle)
 {
 	m_staticShapes.emplace_back(ResourceUniqueOwner<Shape>(new Rectangle(rectangle)));
@@ -80,50 +82,60 @@ Wolf::Physics::PhysicsManager::RayCastResult Wolf::Physics::PhysicsManager::rayC
 
 Wolf::Physics::PhysicsManager::RayCastResult Wolf::Physics::PhysicsManager::rayCastClosestHit(const glm::vec3& rayOrigin, const glm::vec3& rayEnd)
 {
-	float distance = glm::distance(rayEnd, rayOrigin);
-	RayCastResult result;
-	result.collision = false;
+	// Static shapes come first, then dynamic ones
+	const uint32_t staticShapeCount = static_cast<uint32_t>(m_staticShapes.size());
+	const uint32_t shapeCount = staticShapeCount + static_cast<uint32_t>(m_dynamicShapes.size());
 
-	for (StaticShape& staticShape : m_staticShapes)
+	struct ClosestHit
 	{
-		Shape::ShapeRayCastResult shapeRayCastResult = staticShape.m_shape->rayCast(rayOrigin, rayEnd);
-		if (shapeRayCastResult.collision)
+		uint32_t shapeIdx = -1;
+		float distance;
+		glm::vec3 hitPoint;
+	};
+	ClosestHit noHit;
+	noHit.distance = glm::distance(rayEnd, rayOrigin);
+
+	const ClosestHit closestHit = parallelReduce(shapeCount, MIN_SHAPE_COUNT_PER_RAY_CAST_RANGE, noHit,
+		[&](uint32_t firstShapeIdx, uint32_t lastShapeIdx, ClosestHit rangeClosestHit)
 		{
-			RayCastResult rayCastResult;
-			rayCastResult.collision = true;
-			rayCastResult.shape = staticShape.m_shape.createNonOwnerResource();
-			rayCastResult.hitPoint = shapeRayCastResult.hitPoint;
-
-			float distanceWithOrigin = glm::distance(rayCastResult.hitPoint, rayOrigin);
-			if (distanceWithOrigin < distance)
+			for (uint32_t shapeIdx = firstShapeIdx; shapeIdx < lastShapeIdx; ++shapeIdx)
 			{
-				result = rayCastResult;
-				distance = distanceWithOrigin;
+				Shape& shape = shapeIdx < staticShapeCount ? *m_staticShapes[shapeIdx].m_shape : *m_dynamicShapes[shapeIdx - staticShapeCount].m_shape;
+
+				Shape::ShapeRayCastResult shapeRayCastResult = shape.rayCast(rayOrigin, rayEnd);
+				if (shapeRayCastResult.collision)
+				{
+					float distanceWithOrigin = glm::distance(shapeRayCastResult.hitPoint, rayOrigin);
+					if (distanceWithOrigin < rangeClosestHit.distance)
+					{
+						rangeClosestHit.shapeIdx = shapeIdx;
+						rangeClosestHit.distance = distanceWithOrigin;
+						rangeClosestHit.hitPoint = shapeRayCastResult.hitPoint;
+					}
+				}
 			}
-		}
-	}
+			return rangeClosestHit;
+		},
+		[](const ClosestHit& a, const ClosestHit& b) { return b.distance < a.distance ? b : a; });
 
-	for (uint32_t i = 0; i < m_dynamicShapes.size(); ++i)
-	{
-		DynamicShape& dynamicShape = m_dynamicShapes[i];
+	RayCastResult result;
+	result.collision = closestHit.shapeIdx != static_cast<uint32_t>(-1);
+	if (!result.collision)
+		return result;
 
-		Shape::ShapeRayCastResult shapeRayCastResult = dynamicShape.m_shape->rayCast(rayOrigin, rayEnd);
-		if (shapeRayCastResult.collision)
-		{
-			RayCastResult rayCastResult;
-			rayCastResult.collision = true;
-			rayCastResult.shape = dynamicShape.m_shape.createNonOwnerResource();
-			rayCastResult.hitPoint = shapeRayCastResult.hitPoint;
-			rayCastResult.dynamicShapeId = i;
-			rayCastResult.instance = dynamicShape.m_instance;
+	result.hitPoint = closestHit.hitPoint;
+	if (closestHit.shapeIdx < staticShapeCount)
+	{
+		result.shape = m_staticShapes[closestHit.shapeIdx].m_shape.createNonOwnerResource();
+	}
+	else
+	{
+		const uint32_t dynamicShapeIdx = closestHit.shapeIdx - staticShapeCount;
+		DynamicShape& dynamicShape = m_dynamicShapes[dynamicShapeIdx];
 
-			float distanceWithOrigin = glm::distance(rayCastResult.hitPoint, rayOrigin);
-			if (distanceWithOrigin < distance)
-			{
-				result = rayCastResult;
-				distance = distanceWithOrigin;
-			}
-		}
+		result.shape = dynamicShape.m_shape.createNonOwnerResource();
+		result.dynamicShapeId = dynamicShapeIdx;
+		result.instance = dynamicShape.m_instance;
 	}
 
 	return result;
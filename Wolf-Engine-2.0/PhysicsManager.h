@@ -32,6 +32,9 @@ namespace Wolf
 			[[nodiscard]] RayCastResult rayCastClosestHit(const glm::vec3& rayOrigin, const glm::vec3& rayEnd);
 
 		private:
+			// Ray casts are only split between threads for large shape counts
+			static constexpr uint32_t MIN_SHAPE_COUNT_PER_RAY_CAST_RANGE = 256;
+
 			struct StaticShape
 			{
 				ResourceUniqueOwner<Shape> m_shape;
@@ -12,8 +12,12 @@ namespace Wolf
 
 #define PROFILE_SCOPED(name) static constexpr tracy::SourceLocationData profileScoped { name, __FUNCTION__,  __FILE__, 4, 0 }; \
 	tracy::ScopedZone profilScopedScopedZone(&profileScoped, true);
+
+// Name pointer must stay valid while profiling
+#define PROFILE_PLOT(name, value) TracyPlot(name, value);
 #else
 #define PROFILE_FUNCTION
 #define PROFILE_SCOPED(name)
+#define PROFILE_PLOT(name, value)
 #endif
 }
@@ -0,0 +1,127 @@
+#include "ProgressiveTextureLoader.h"
+
+#include <algorithm>
+
+#include <Debug.h>
+
+#include "ProfilerCommon.h"
+
+Wolf::ProgressiveTextureLoader::ProgressiveTextureLoader(const ResourceNonOwner<GPUDataTransfersManagerInterface>& pushDataToGPU, uint64_t byteBudgetPerFrame)
+	: m_pushDataToGPUHandler(pushDataToGPU), m_byteBudgetPerFrame(byteBudgetPerFrame)
+{
+}
+
+void Wolf::ProgressiveTextureLoader::addTexture(TextureInfo&& textureInfo)
+{
+	if (textureInfo.m_mipPixels.empty())
+	{
+		Debug::sendError("Progressive texture has no mip level");
+		return;
+	}
+	for (const std::span<const uint8_t>& mipPixels : textureInfo.m_mipPixels)
+	{
+		if (mipPixels.empty())
+		{
+			Debug::sendError("Progressive texture has an empty mip level");
+			return;
+		}
+	}
+
+	const uint32_t mipLevelCount = static_cast<uint32_t>(textureInfo.m_mipPixels.size());
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pendingTextures.push_back({ std::move(textureInfo), mipLevelCount });
+}
+
+void Wolf::ProgressiveTextureLoader::update(std::vector<ResidentMipsChange>& outChanges)
+{
+	PROFILE_FUNCTION
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	uint64_t remainingBudget = m_byteBudgetPerFrame;
+	bool hasSentMip = false;
+
+	// Mip tails of new textures, so they can be bound this frame
+	for (PendingTexture& texture : m_pendingTextures)
+	{
+		const std::vector<std::span<const uint8_t>>& mipPixels = texture.m_info.m_mipPixels;
+		if (texture.m_firstResidentMipLevel != mipPixels.size())
+			continue;
+
+		do
+		{
+			remainingBudget -= std::min<uint64_t>(remainingBudget, mipPixels[texture.m_firstResidentMipLevel - 1].size());
+			pushNextMip(texture);
+		} while (texture.m_firstResidentMipLevel > 0 && mipPixels[texture.m_firstResidentMipLevel - 1].size() <= MIP_TAIL_MAX_BYTE_SIZE);
+
+		hasSentMip = true;
+	}
+
+	// Then the smallest pending mip of all textures until the budget is spent. A mip larger than the whole budget is sent alone
+	while (true)
+	{
+		PendingTexture* nextTexture = nullptr;
+		uint64_t nextMipByteSize = 0;
+		for (PendingTexture& texture : m_pendingTextures)
+		{
+			if (texture.m_firstResidentMipLevel == 0)
+				continue;
+
+			const uint64_t mipByteSize = texture.m_info.m_mipPixels[texture.m_firstResidentMipLevel - 1].size();
+			if (!nextTexture || mipByteSize < nextMipByteSize)
+			{
+				nextTexture = &texture;
+				nextMipByteSize = mipByteSize;
+			}
+		}
+
+		if (!nextTexture || (hasSentMip && nextMipByteSize > remainingBudget))
+			break;
+
+		remainingBudget -= std::min(remainingBudget, nextMipByteSize);
+		pushNextMip(*nextTexture);
+		hasSentMip = true;
+	}
+
+	for (PendingTexture& texture : m_pendingTextures)
+	{
+		if (texture.m_changedThisUpdate)
+		{
+			outChanges.push_back({ texture.m_info.m_image, texture.m_info.m_bindlessOffset, texture.m_firstResidentMipLevel });
+			texture.m_changedThisUpdate = false;
+		}
+	}
+
+	// Fully loaded textures release their file
+	std::erase_if(m_pendingTextures, [](const PendingTexture& texture) { return texture.m_firstResidentMipLevel == 0; });
+}
+
+uint32_t Wolf::ProgressiveTextureLoader::getPendingTextureCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return static_cast<uint32_t>(m_pendingTextures.size());
+}
+
+uint64_t Wolf::ProgressiveTextureLoader::getPendingByteCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	uint64_t pendingByteCount = 0;
+	for (const PendingTexture& texture : m_pendingTextures)
+	{
+		for (uint32_t mipLevel = 0; mipLevel < texture.m_firstResidentMipLevel; ++mipLevel)
+			pendingByteCount += texture.m_info.m_mipPixels[mipLevel].size();
+	}
+	return pendingByteCount;
+}
+
+void Wolf::ProgressiveTextureLoader::pushNextMip(PendingTexture& texture) const
+{
+	const uint32_t mipLevel = texture.m_firstResidentMipLevel - 1;
+	m_pushDataToGPUHandler->pushDataToGPUImage(GPUDataTransfersManagerInterface::PushDataToGPUImageInfo(texture.m_info.m_mipPixels[mipLevel].data(), texture.m_info.m_image,
+		Image::SampledInFragmentShader(mipLevel), mipLevel));
+
+	texture.m_firstResidentMipLevel = mipLevel;
+	texture.m_changedThisUpdate = true;
+}
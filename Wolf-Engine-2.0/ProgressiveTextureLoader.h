@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include <Image.h>
+#include <ResourceNonOwner.h>
+
+#include "DDSFile.h"
+#include "GPUDataTransfersManager.h"
+
+namespace Wolf
+{
+	// Uploads textures smallest mips first. The mip tail is sent on the first update following the add so the texture can be sampled at a reduced resolution,
+	// larger mips then come within a byte budget per frame. The smallest pending mip of all textures is always sent first
+	class ProgressiveTextureLoader
+	{
+	public:
+		static constexpr uint64_t DEFAULT_BYTE_BUDGET_PER_FRAME = 8 * 1024 * 1024;
+		static constexpr uint64_t MIP_TAIL_MAX_BYTE_SIZE = 64 * 1024; // smallest mips up to this size are sent at once, even above the budget
+
+		explicit ProgressiveTextureLoader(const ResourceNonOwner<GPUDataTransfersManagerInterface>& pushDataToGPU, uint64_t byteBudgetPerFrame = DEFAULT_BYTE_BUDGET_PER_FRAME);
+		ProgressiveTextureLoader(const ProgressiveTextureLoader&) = delete;
+
+		struct TextureInfo
+		{
+			NullableResourceNonOwner<Image> m_image;
+			std::vector<std::span<const uint8_t>> m_mipPixels; // mip 0 first, one entry per mip level of the image
+			std::unique_ptr<DDSFile> m_ddsFile; // optional, keeps m_mipPixels mapped until the last mip is sent
+			uint32_t m_bindlessOffset = 0;
+		};
+		// Can be called from any thread
+		void addTexture(TextureInfo&& textureInfo);
+
+		struct ResidentMipsChange
+		{
+			NullableResourceNonOwner<Image> m_image;
+			uint32_t m_bindlessOffset;
+			uint32_t m_firstResidentMipLevel; // mips from this one to the last are loaded
+		};
+		// A texture has at most one change per update, its descriptor can be updated right after
+		void update(std::vector<ResidentMipsChange>& outChanges);
+
+		void setByteBudgetPerFrame(uint64_t byteBudgetPerFrame) { m_byteBudgetPerFrame = byteBudgetPerFrame; }
+		[[nodiscard]] uint32_t getPendingTextureCount() const;
+		[[nodiscard]] uint64_t getPendingByteCount() const;
+
+	private:
+		struct PendingTexture
+		{
+			TextureInfo m_info;
+			uint32_t m_firstResidentMipLevel; // mip count when nothing is loaded
+			bool m_changedThisUpdate = false;
+		};
+		void pushNextMip(PendingTexture& texture) const;
+
+		ResourceNonOwner<GPUDataTransfersManagerInterface> m_pushDataToGPUHandler;
+		uint64_t m_byteBudgetPerFrame;
+
+		mutable std::mutex m_mutex;
+		std::vector<PendingTexture> m_pendingTextures; // in add order, used to break ties between mips of the same size
+	};
+}
@@ -0,0 +1,175 @@
+#include "ThreadTopology.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <Debug.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+#ifdef __linux__
+	bool readSmallFile(const char* path, std::string& outContent)
+	{
+		std::ifstream file(path);
+		if (!file.is_open())
+			return false;
+
+		std::stringstream stream;
+		stream << file.rdbuf();
+		outContent = stream.str();
+		return true;
+	}
+
+	int64_t parseInteger(std::string_view content)
+	{
+		while (!content.empty() && (content.front() == ' ' || content.front() == '\n'))
+			content.remove_prefix(1);
+
+		int64_t value = 0;
+		if (std::from_chars(content.data(), content.data() + content.size(), value).ec != std::errc())
+			return 0;
+		return value;
+	}
+
+	uint32_t getCGroupCPUQuota()
+	{
+		std::string content;
+		if (readSmallFile("/sys/fs/cgroup/cpu.max", content))
+			return Wolf::parseCGroupV2CPUQuota(content);
+
+		std::string periodContent;
+		if (readSmallFile("/sys/fs/cgroup/cpu/cpu.cfs_quota_us", content) && readSmallFile("/sys/fs/cgroup/cpu/cpu.cfs_period_us", periodContent))
+			return Wolf::computeCGroupV1CPUQuota(parseInteger(content), parseInteger(periodContent));
+
+		return 0;
+	}
+#endif
+}
+
+uint32_t Wolf::getAvailableCPUCount()
+{
+	uint32_t availableCPUCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+#ifdef __linux__
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+	{
+		const int affinityCPUCount = CPU_COUNT(&cpuSet);
+		if (affinityCPUCount > 0)
+			availableCPUCount = std::min(availableCPUCount, static_cast<uint32_t>(affinityCPUCount));
+	}
+
+	if (const uint32_t cgroupCPUQuota = getCGroupCPUQuota(); cgroupCPUQuota > 0)
+		availableCPUCount = std::min(availableCPUCount, cgroupCPUQuota);
+#endif
+
+	return availableCPUCount;
+}
+
+uint32_t Wolf::parseCGroupV2CPUQuota(std::string_view cpuMaxContent)
+{
+	const size_t separatorPos = cpuMaxContent.find(' ');
+	if (separatorPos == std::string_view::npos)
+		return 0;
+
+	const std::string_view quotaContent = cpuMaxContent.substr(0, separatorPos);
+	if (quotaContent == "max")
+		return 0;
+
+	std::string_view periodContent = cpuMaxContent.substr(separatorPos + 1);
+	while (!periodContent.empty() && (periodContent.back() == '\n' || periodContent.back() == ' '))
+		periodContent.remove_suffix(1);
+
+	int64_t quotaUs = 0;
+	int64_t periodUs = 0;
+	if (std::from_chars(quotaContent.data(), quotaContent.data() + quotaContent.size(), quotaUs).ec != std::errc() ||
+		std::from_chars(periodContent.data(), periodContent.data() + periodContent.size(), periodUs).ec != std::errc())
+		return 0;
+
+	return computeCGroupV1CPUQuota(quotaUs, periodUs);
+}
+
+uint32_t Wolf::computeCGroupV1CPUQuota(int64_t quotaUs, int64_t periodUs)
+{
+	// -1 means no limit
+	if (quotaUs <= 0 || periodUs <= 0)
+		return 0;
+
+	// A partial CPU still gets a thread
+	return static_cast<uint32_t>(std::max<int64_t>((quotaUs + periodUs - 1) / periodUs, 1));
+}
+
+Wolf::ThreadLayout Wolf::computeThreadLayout(uint32_t availableCPUCount)
+{
+	ThreadLayout threadLayout{};
+	threadLayout.m_streamingThreadCount = std::clamp(availableCPUCount / 8, 1u, 4u);
+
+	// The main thread takes part in before frame jobs, it doesn't need a worker
+	if (availableCPUCount > threadLayout.m_streamingThreadCount + 1)
+		threadLayout.m_beforeFrameAndRecordThreadCount = availableCPUCount - threadLayout.m_streamingThreadCount - 1;
+	else
+		threadLayout.m_beforeFrameAndRecordThreadCount = availableCPUCount > 1 ? 1 : 0;
+
+	return threadLayout;
+}
+
+void Wolf::setCurrentThreadName(const std::string& name)
+{
+#ifdef _WIN32
+	std::wstring wName = std::wstring(name.begin(), name.end());
+	LPCWSTR swName = wName.c_str();
+	SetThreadDescription(GetCurrentThread(), swName);
+#elif __linux__
+	// Linux limit is 16 bytes including the null terminator
+	const std::string truncatedName = name.substr(0, 15);
+	pthread_setname_np(pthread_self(), truncatedName.c_str());
+#endif
+}
+
+bool Wolf::setCurrentThreadAffinity(const CPUAffinity& affinity)
+{
+	if (affinity.empty())
+		return true;
+
+#ifdef _WIN32
+	DWORD_PTR mask = 0;
+	for (uint32_t cpuIdx : affinity)
+	{
+		if (cpuIdx < sizeof(DWORD_PTR) * 8)
+			mask |= static_cast<DWORD_PTR>(1) << cpuIdx;
+	}
+	if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+	{
+		Debug::sendWarning("Can't set thread affinity");
+		return false;
+	}
+	return true;
+#elif __linux__
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	for (uint32_t cpuIdx : affinity)
+	{
+		if (cpuIdx < CPU_SETSIZE)
+			CPU_SET(cpuIdx, &cpuSet);
+	}
+	if (CPU_COUNT(&cpuSet) == 0 || sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+	{
+		Debug::sendWarning("Can't set thread affinity");
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Wolf
+{
+	// Logical CPU indices a thread is allowed to run on, empty means no restriction
+	using CPUAffinity = std::vector<uint32_t>;
+
+	// CPUs the process can really use. On Linux, the process affinity mask and the cgroup CPU quota (containers) are taken into account
+	uint32_t getAvailableCPUCount();
+
+	// cgroup v2 "cpu.max" content is "<quota> <period>" or "max <period>". Returns 0 if there's no limit or if the content is invalid
+	uint32_t parseCGroupV2CPUQuota(std::string_view cpuMaxContent);
+	// cgroup v1 "cpu.cfs_quota_us" and "cpu.cfs_period_us" values. Returns 0 if there's no limit
+	uint32_t computeCGroupV1CPUQuota(int64_t quotaUs, int64_t periodUs);
+
+	struct ThreadLayout
+	{
+		uint32_t m_beforeFrameAndRecordThreadCount;
+		uint32_t m_streamingThreadCount;
+	};
+	// One CPU is kept for the main thread, the others are shared between before frame and streaming workers
+	ThreadLayout computeThreadLayout(uint32_t availableCPUCount);
+
+	// Names are truncated to 15 characters on Linux
+	void setCurrentThreadName(const std::string& name);
+	bool setCurrentThreadAffinity(const CPUAffinity& affinity);
+}
@@ -9,6 +9,7 @@
 
 #include "ProfilerCommon.h"
 #include "GPUDataTransfersManager.h"
+#include "ParallelFor.h"
 #include "VirtualTextureUtils.h"
 
 Wolf::VirtualTextureManager::VirtualTextureManager(Extent2D extent, const ResourceNonOwner<GPUDataTransfersManagerInterface>& pushDataToGPU) : m_pushDataToGPUHandler(pushDataToGPU)
@@ -81,7 +82,7 @@ uint32_t Wolf::VirtualTextureManager::takeEntryId(AtlasIndex atlasIndex, const F
 	return entryId;
 }
 
-void Wolf::VirtualTextureManager::uploadData(AtlasIndex atlasIndex, const std::vector<uint8_t>& data, const Extent3D& sliceExtent, uint8_t sliceX, uint8_t sliceY, uint8_t mipLevel, uint8_t sliceCountX, uint8_t sliceCountY,
+void Wolf::VirtualTextureManager::uploadData(AtlasIndex atlasIndex, std::span<const uint8_t> data, const Extent3D& sliceExtent, uint8_t sliceX, uint8_t sliceY, uint8_t mipLevel, uint8_t sliceCountX, uint8_t sliceCountY,
                                              uint32_t indirectionOffset, const FeedbackInfo& feedbackInfo, uint32_t entryId)
 {
 	PROFILE_FUNCTION
@@ -181,42 +182,61 @@ void Wolf::VirtualTextureManager::readFeedbackBuffer()
 
 	const uint32_t* feedbackData = static_cast<const uint32_t*>(m_feedbackReadableBuffer->getBuffer(bufferIdx).map());
 
-	FeedbackInfo leftValue(static_cast<uint32_t>(-1));
-	std::vector<std::array<FeedbackInfo, 3>> topValues(m_feedbackCountX, { FeedbackInfo(static_cast<uint32_t>(-1)), FeedbackInfo(static_cast<uint32_t>(-1)), FeedbackInfo(static_cast<uint32_t>(-1)) });
-
 	{
 		PROFILE_SCOPED("De-duplication")
-		m_deduplicatedFeedbacks.clear();
+
+		// Rows ranges are de-duplicated in parallel, duplicates between ranges are removed after the sort
+		const uint32_t rowCount = m_maxFeedbackCount / m_feedbackCountX;
+		const uint32_t rowCountPerRange = computeParallelRangeSize(rowCount, MIN_FEEDBACK_ROW_COUNT_PER_RANGE);
+		const uint32_t rangeCount = (rowCount + rowCountPerRange - 1) / rowCountPerRange;
+		m_deduplicatedFeedbacksPerRowRange.resize(rangeCount);
 
 		const uint32_t* __restrict rawData = feedbackData;
-		for (uint32_t feedbackIdx = 0; feedbackIdx < m_maxFeedbackCount; ++feedbackIdx)
+		parallelForRanges(rangeCount, [&](uint32_t rangeIdx)
 		{
-			for (uint32_t i = 0; i < 3; ++i)
-			{
-				uint32_t val = rawData[feedbackIdx * 3 + i];
-				if (val == -1)
-					continue;
-
-				FeedbackInfo feedback(val);
-				if (feedback == leftValue || feedback == topValues[feedbackIdx % m_feedbackCountX][i])
-				{
-					continue;
-				}
+			std::vector<uint32_t>& deduplicatedFeedbacks = m_deduplicatedFeedbacksPerRowRange[rangeIdx];
+			deduplicatedFeedbacks.clear();
 
-				m_deduplicatedFeedbacks.push_back(val);
+			FeedbackInfo leftValue(static_cast<uint32_t>(-1));
+			std::vector<std::array<FeedbackInfo, 3>> topValues(m_feedbackCountX, { FeedbackInfo(static_cast<uint32_t>(-1)), FeedbackInfo(static_cast<uint32_t>(-1)), FeedbackInfo(static_cast<uint32_t>(-1)) });
 
-				FeedbackInfo mipAbove = feedback;
-				while (mipAbove.m_mipLevel <= feedback.m_mipLevel + 3)
+			const uint32_t firstFeedbackIdx = rangeIdx * rowCountPerRange * m_feedbackCountX;
+			const uint32_t lastFeedbackIdx = std::min((rangeIdx + 1) * rowCountPerRange, rowCount) * m_feedbackCountX;
+			for (uint32_t feedbackIdx = firstFeedbackIdx; feedbackIdx < lastFeedbackIdx; ++feedbackIdx)
+			{
+				for (uint32_t i = 0; i < 3; ++i)
 				{
-					mipAbove.m_mipLevel++;
-					mipAbove.m_sliceX >>= 1;
-					mipAbove.m_sliceY >>= 1;
-					m_deduplicatedFeedbacks.push_back(*reinterpret_cast<uint32_t*>(&mipAbove));
+					uint32_t val = rawData[feedbackIdx * 3 + i];
+					if (val == -1)
+						continue;
+
+					FeedbackInfo feedback(val);
+					if (feedback == leftValue || feedback == topValues[feedbackIdx % m_feedbackCountX][i])
+					{
+						continue;
+					}
+
+					deduplicatedFeedbacks.push_back(val);
+
+					FeedbackInfo mipAbove = feedback;
+					while (mipAbove.m_mipLevel <= feedback.m_mipLevel + 3)
+					{
+						mipAbove.m_mipLevel++;
+						mipAbove.m_sliceX >>= 1;
+						mipAbove.m_sliceY >>= 1;
+						deduplicatedFeedbacks.push_back(*reinterpret_cast<uint32_t*>(&mipAbove));
+					}
+
+					leftValue = feedback;
+					topValues[feedbackIdx % m_feedbackCountX][i] = feedback;
 				}
-
-				leftValue = feedback;
-				topValues[feedbackIdx % m_feedbackCountX][i] = feedback;
 			}
+		});
+
+		m_deduplicatedFeedbacks.clear();
+		for (const std::vector<uint32_t>& deduplicatedFeedbacks : m_deduplicatedFeedbacksPerRowRange)
+		{
+			m_deduplicatedFeedbacks.insert(m_deduplicatedFeedbacks.end(), deduplicatedFeedbacks.begin(), deduplicatedFeedbacks.end());
 		}
 
 		if (!m_deduplicatedFeedbacks.empty())
@@ -464,28 +484,16 @@ uint32_t Wolf::VirtualTextureManager::AtlasInfo::computeEntryId(uint32_t entryId
 	return ((subEntryOffsetY & 0xFF) << 24) | ((subEntryOffsetX & 0xFF) << 16) | (entryIdx & 0xFFFF);
 }
 
-void Wolf::VirtualTextureManager::getRequestedSlices(std::vector<FeedbackInfo>& outSlicesRequested, uint32_t maxCount)
+uint32_t Wolf::VirtualTextureManager::getRequestedSlices(std::span<FeedbackInfo> outSlicesRequested)
 {
-	if (m_feedbacksToLoad.empty())
-		return;
-
-	if (!outSlicesRequested.empty())
-		Debug::sendError("Out slices requested must be sent empty");
-
-	if (m_feedbacksToLoad.size() < maxCount)
+	const uint32_t slicesRequestedCount = static_cast<uint32_t>(std::min(m_feedbacksToLoad.size(), outSlicesRequested.size()));
+	for (uint32_t i = 0; i < slicesRequestedCount; ++i)
 	{
-		m_feedbacksToLoad.swap(outSlicesRequested);
+		outSlicesRequested[i] = m_feedbacksToLoad[i];
 	}
-	else
-	{
-		outSlicesRequested.reserve(maxCount);
-		for (uint32_t i = 0; i < maxCount; ++i)
-		{
-			outSlicesRequested.push_back(m_feedbacksToLoad[i]);
-		}
+	m_feedbacksToLoad.clear();
 
-		m_feedbacksToLoad.clear();
-	}
+	return slicesRequestedCount;
 }
 
 void Wolf::VirtualTextureManager::createFeedbackBuffer(Extent2D extent)
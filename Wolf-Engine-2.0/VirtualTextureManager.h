@@ -7,6 +7,7 @@
 #include <Formats.h>
 #include <Image.h>
 #include <queue>
+#include <span>
 #include <ReadableBuffer.h>
 
 #include "DynamicResourceUniqueOwnerArray.h"
@@ -58,7 +59,7 @@ namespace Wolf
 		static constexpr uint32_t INVALID_INDIRECTION_OFFSET = -1;
 		uint32_t createNewIndirection(uint32_t indirectionCount);
 		uint32_t takeEntryId(AtlasIndex atlasIndex, const FeedbackInfo& feedbackInfo, const Extent3D& sliceExtent, FeedbackInfo& removedFeedback, bool neverRemoveEntry = false);
-		void uploadData(AtlasIndex atlasIndex, const std::vector<uint8_t>& data, const Extent3D& sliceExtent, uint8_t sliceX, uint8_t sliceY, uint8_t mipLevel, uint8_t sliceCountX, uint8_t sliceCountY, uint32_t indirectionOffset,
+		void uploadData(AtlasIndex atlasIndex, std::span<const uint8_t> data, const Extent3D& sliceExtent, uint8_t sliceX, uint8_t sliceY, uint8_t mipLevel, uint8_t sliceCountX, uint8_t sliceCountY, uint32_t indirectionOffset,
 		                const FeedbackInfo& feedbackInfo, uint32_t entryId);
 		void rejectRequest(const FeedbackInfo& feedbackInfo);
 		void removeIndirection(const FeedbackInfo& feedbackInfo, uint8_t sliceCountX, uint8_t sliceCountY, uint32_t indirectionOffset);
@@ -67,7 +68,8 @@ namespace Wolf
 		ResourceNonOwner<Buffer> getFeedbackBuffer();
 		ResourceNonOwner<Buffer> getIndirectionBuffer();
 
-		void getRequestedSlices(std::vector<FeedbackInfo>& outSlicesRequested, uint32_t maxCount);
+		// Returns the number of slices written, remaining requests are dropped
+		uint32_t getRequestedSlices(std::span<FeedbackInfo> outSlicesRequested);
 
 	private:
 		void createFeedbackBuffer(Extent2D extent);
@@ -168,6 +170,8 @@ namespace Wolf
 		ResourceUniqueOwner<Buffer> m_feedbackBuffer;
 		ResourceUniqueOwner<ReadableBuffer> m_feedbackReadableBuffer;
 		std::vector<uint32_t> m_deduplicatedFeedbacks;
+		std::vector<std::vector<uint32_t>> m_deduplicatedFeedbacksPerRowRange;
+		static constexpr uint32_t MIN_FEEDBACK_ROW_COUNT_PER_RANGE = 8;
 		std::vector<uint32_t> m_debuplicatedFeedbacksTempBuffer;
 
 		std::vector<FeedbackInfo> m_feedbacksToLoad;
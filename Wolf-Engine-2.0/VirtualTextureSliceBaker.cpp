@@ -0,0 +1,214 @@
+#include "VirtualTextureSliceBaker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include <Debug.h>
+
+#include "ConfigurationDocument.h"
+#include "ContentHash.h"
+#include "ParallelFor.h"
+#include "ProfilerCommon.h"
+#include "VirtualTextureManager.h"
+
+namespace
+{
+	using RGBA8 = Wolf::ImageCompression::RGBA8;
+	using RG32F = Wolf::ImageCompression::RG32F;
+
+	bool isPowerOfTwo(uint32_t value)
+	{
+		return value != 0 && (value & (value - 1)) == 0;
+	}
+
+	uint32_t wrapCoordinate(int64_t coordinate, uint32_t size)
+	{
+		const int64_t wrapped = coordinate % static_cast<int64_t>(size);
+		return static_cast<uint32_t>(wrapped < 0 ? wrapped + size : wrapped);
+	}
+
+	struct SliceToBake
+	{
+		uint32_t mipLevel;
+		uint32_t sliceX;
+		uint32_t sliceY;
+	};
+
+	// Same layout as MaterialsGPUManager::uploadVirtualTextureSlice reads: hash (uint64_t), payload byte count (uint32_t), payload
+	bool writeSliceFile(const std::filesystem::path& filepath, std::span<const uint8_t> payload)
+	{
+		const uint64_t hash = Wolf::computeContentHash({ reinterpret_cast<const char*>(payload.data()), payload.size() });
+		const uint32_t payloadByteCount = static_cast<uint32_t>(payload.size());
+
+		std::ofstream file(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+		file.write(reinterpret_cast<const char*>(&payloadByteCount), sizeof(payloadByteCount));
+		file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+		return static_cast<bool>(file);
+	}
+
+	template <typename Block, typename Texel>
+	bool bakeSlices(const Texel* firstMipTexels, Wolf::Extent2D extent, Wolf::Format mipFormat, bool isNormalMap, const std::filesystem::path& outputFolder,
+		const Wolf::VirtualTextureSliceBaker::BakeInfo& bakeInfo, Wolf::VirtualTextureSliceBaker::BakeStats& outStats)
+	{
+		using VirtualTextureManager = Wolf::VirtualTextureManager;
+
+		const uint32_t mipCount = Wolf::MipMapGenerator::computeMipCount(extent);
+
+		Wolf::MipMapGenerator::GenerationInfo generationInfo;
+		generationInfo.filter = bakeInfo.filter;
+		generationInfo.isNormalMap = isNormalMap;
+		const Wolf::MipMapGenerator mipMapGenerator(reinterpret_cast<const unsigned char*>(firstMipTexels), extent, mipFormat, static_cast<int>(mipCount), generationInfo);
+		if (mipMapGenerator.getMipLevelCount() != mipCount)
+			return false;
+
+		std::vector<SliceToBake> slicesToBake;
+		for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+		{
+			const Wolf::Extent2D mipExtent = Wolf::MipMapGenerator::computeMipExtent(extent, mipLevel);
+			const uint32_t sliceCountX = std::max(mipExtent.width / VirtualTextureManager::VIRTUAL_PAGE_SIZE, 1u);
+			const uint32_t sliceCountY = std::max(mipExtent.height / VirtualTextureManager::VIRTUAL_PAGE_SIZE, 1u);
+			for (uint32_t sliceY = 0; sliceY < sliceCountY; ++sliceY)
+			{
+				for (uint32_t sliceX = 0; sliceX < sliceCountX; ++sliceX)
+				{
+					slicesToBake.push_back({ mipLevel, sliceX, sliceY });
+				}
+			}
+		}
+
+		std::atomic<bool> failed = false;
+		std::atomic<uint64_t> byteCount = 0;
+		Wolf::parallelForRanges(static_cast<uint32_t>(slicesToBake.size()), [&](uint32_t sliceIdx)
+		{
+			if (failed.load(std::memory_order_relaxed))
+				return;
+
+			const SliceToBake& slice = slicesToBake[sliceIdx];
+			const Wolf::Extent2D mipExtent = Wolf::MipMapGenerator::computeMipExtent(extent, slice.mipLevel);
+			const Texel* mipTexels = slice.mipLevel == 0 ? firstMipTexels : reinterpret_cast<const Texel*>(mipMapGenerator.getMipLevel(slice.mipLevel).data());
+
+			// Extent read by the runtime, always whole blocks as the smallest mip is 4x4
+			const Wolf::Extent3D sliceExtent = { std::min(mipExtent.width, VirtualTextureManager::VIRTUAL_PAGE_SIZE) + 2 * VirtualTextureManager::BORDER_SIZE,
+				std::min(mipExtent.height, VirtualTextureManager::VIRTUAL_PAGE_SIZE) + 2 * VirtualTextureManager::BORDER_SIZE, 1 };
+
+			std::vector<Texel> sliceTexels(static_cast<size_t>(sliceExtent.width) * sliceExtent.height);
+			const int64_t originX = static_cast<int64_t>(slice.sliceX) * VirtualTextureManager::VIRTUAL_PAGE_SIZE - VirtualTextureManager::BORDER_SIZE;
+			const int64_t originY = static_cast<int64_t>(slice.sliceY) * VirtualTextureManager::VIRTUAL_PAGE_SIZE - VirtualTextureManager::BORDER_SIZE;
+			for (uint32_t y = 0; y < sliceExtent.height; ++y)
+			{
+				const Texel* sourceRow = mipTexels + static_cast<size_t>(wrapCoordinate(originY + y, mipExtent.height)) * mipExtent.width;
+				for (uint32_t x = 0; x < sliceExtent.width; ++x)
+				{
+					sliceTexels[static_cast<size_t>(y) * sliceExtent.width + x] = sourceRow[wrapCoordinate(originX + x, mipExtent.width)];
+				}
+			}
+
+			// Slices are already spread across the workers, each one is compressed in a single tile
+			std::vector<Block> blocks;
+			Wolf::ImageCompression::TiledCompressionInfo compressionInfo;
+			compressionInfo.quality = bakeInfo.quality;
+			compressionInfo.blockRowCountPerTile = sliceExtent.height / 4;
+			Wolf::ImageCompression::compressTiled(sliceExtent, sliceTexels, blocks, compressionInfo);
+
+			const std::span<const uint8_t> payload(reinterpret_cast<const uint8_t*>(blocks.data()), blocks.size() * sizeof(Block));
+			const std::filesystem::path filepath = outputFolder / Wolf::VirtualTextureSliceBaker::computeSliceFilename(slice.mipLevel, slice.sliceX, slice.sliceY);
+			if (!writeSliceFile(filepath, payload))
+			{
+				Wolf::Debug::sendError("Can't write slice file " + filepath.string());
+				failed.store(true, std::memory_order_relaxed);
+				return;
+			}
+			byteCount.fetch_add(sizeof(uint64_t) + sizeof(uint32_t) + payload.size(), std::memory_order_relaxed);
+		});
+
+		outStats.sliceCount = static_cast<uint32_t>(slicesToBake.size());
+		outStats.byteCount = byteCount.load();
+		return !failed.load();
+	}
+}
+
+bool Wolf::VirtualTextureSliceBaker::bake(const unsigned char* pixels, Extent2D extent, const std::string& outputFolder, const BakeInfo& bakeInfo, BakeStats* outStats)
+{
+	PROFILE_FUNCTION
+
+	// The runtime computes slice counts from the height only
+	if (extent.width != extent.height || !isPowerOfTwo(extent.width) || extent.width < 4)
+	{
+		Debug::sendError("Virtual texture must be square with a power of two side of at least 4 texels, got " + std::to_string(extent.width) + "x" + std::to_string(extent.height));
+		return false;
+	}
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(outputFolder, errorCode);
+	if (errorCode)
+	{
+		Debug::sendError("Can't create folder " + outputFolder);
+		return false;
+	}
+
+	BakeStats stats;
+	bool success = false;
+	switch (bakeInfo.textureType)
+	{
+		case TextureType::ALBEDO:
+		{
+			const RGBA8* texels = reinterpret_cast<const RGBA8*>(pixels);
+			success = bakeSlices<ImageCompression::BC1>(texels, extent, Format::R8G8B8A8_SRGB, false, outputFolder, bakeInfo, stats);
+			break;
+		}
+		case TextureType::NORMAL:
+		{
+			// BC5 encoder takes XY in [-1, 1]
+			std::vector<RG32F> normals(static_cast<size_t>(extent.width) * extent.height);
+			for (size_t texelIdx = 0; texelIdx < normals.size(); ++texelIdx)
+			{
+				normals[texelIdx] = RG32F(static_cast<float>(pixels[texelIdx * 4]) / 255.0f * 2.0f - 1.0f, static_cast<float>(pixels[texelIdx * 4 + 1]) / 255.0f * 2.0f - 1.0f);
+			}
+			success = bakeSlices<ImageCompression::BC5>(normals.data(), extent, Format::R32G32_SFLOAT, true, outputFolder, bakeInfo, stats);
+			break;
+		}
+		case TextureType::COMBINED_ROUGHNESS_METALNESS_AO:
+		{
+			const RGBA8* texels = reinterpret_cast<const RGBA8*>(pixels);
+			success = bakeSlices<ImageCompression::BC3>(texels, extent, Format::R8G8B8A8_UNORM, false, outputFolder, bakeInfo, stats);
+			break;
+		}
+	}
+	if (!success)
+		return false;
+
+	ConfigurationDocument info((std::filesystem::path(outputFolder) / "info.txt").string());
+	info.setValue("width", extent.width);
+	info.setValue("height", extent.height);
+	if (!info.flush())
+		return false;
+
+	if (outStats)
+		*outStats = stats;
+
+	return true;
+}
+
+uint32_t Wolf::VirtualTextureSliceBaker::computeSliceCount(Extent2D extent)
+{
+	uint32_t sliceCount = 0;
+
+	const uint32_t mipCount = MipMapGenerator::computeMipCount(extent);
+	for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+	{
+		const Extent2D mipExtent = MipMapGenerator::computeMipExtent(extent, mipLevel);
+		sliceCount += std::max(mipExtent.width / VirtualTextureManager::VIRTUAL_PAGE_SIZE, 1u) * std::max(mipExtent.height / VirtualTextureManager::VIRTUAL_PAGE_SIZE, 1u);
+	}
+
+	return sliceCount;
+}
+
+std::string Wolf::VirtualTextureSliceBaker::computeSliceFilename(uint32_t mipLevel, uint32_t sliceX, uint32_t sliceY)
+{
+	return "mip" + std::to_string(mipLevel) + "_sliceX" + std::to_string(sliceX) + "_sliceY" + std::to_string(sliceY) + ".bin";
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <Extents.h>
+
+#include "ImageCompression.h"
+#include "MipMapGenerator.h"
+
+namespace Wolf
+{
+	// Writes the slice files read by MaterialsGPUManager when virtual texturing is enabled: info.txt with the texture extent and one
+	// mip{m}_sliceX{x}_sliceY{y}.bin per page of each mip level (hash, payload byte count, payload). Payloads are the compressed pages
+	// with a border of VirtualTextureManager::BORDER_SIZE texels, borders wrap around the texture edges.
+	// Mips are generated first, slices are then cut, compressed and written by the engine workers
+	class VirtualTextureSliceBaker
+	{
+	public:
+		enum class TextureType
+		{
+			ALBEDO,                          // BC1 sRGB
+			NORMAL,                          // BC5, XY of the normal
+			COMBINED_ROUGHNESS_METALNESS_AO  // BC3
+		};
+
+		struct BakeInfo
+		{
+			TextureType textureType = TextureType::ALBEDO;
+			MipMapGenerator::Filter filter = MipMapGenerator::Filter::BOX;
+			ImageCompression::Quality quality = ImageCompression::Quality::FAST;
+		};
+
+		struct BakeStats
+		{
+			uint32_t sliceCount = 0;
+			uint64_t byteCount = 0; // slice files only
+		};
+
+		// Pixels are RGBA8, the texture must be square with a power of two side of at least 4 texels
+		static bool bake(const unsigned char* pixels, Extent2D extent, const std::string& outputFolder, const BakeInfo& bakeInfo, BakeStats* outStats = nullptr);
+
+		[[nodiscard]] static uint32_t computeSliceCount(Extent2D extent);
+		[[nodiscard]] static std::string computeSliceFilename(uint32_t mipLevel, uint32_t sliceX, uint32_t sliceY);
+	};
+}
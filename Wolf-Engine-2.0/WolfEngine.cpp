@@ -187,7 +187,10 @@ Wolf::WolfEngine::WolfEngine(const WolfInstanceCreateInfo& createInfo) : m_globa
 	initializePass(m_instanceMeshRenderer.createNonOwnerResource<CommandRecordBase>());
 	m_physicsManager.reset(new Physics::PhysicsManager);
 
-	m_jobsManager.reset(new JobsManager(createInfo.m_threadCountBeforeFrameAndRecord));
+	m_jobsManager.reset(new JobsManager(createInfo.m_threadCountBeforeFrameAndRecord, createInfo.m_streamingThreadCount, createInfo.m_maxPendingStreamingJobCount,
+		createInfo.m_beforeFrameAndRecordThreadsAffinity, createInfo.m_streamingThreadsAffinity));
+	m_jobsManager->getTelemetry()->setEnabled(createInfo.m_enableJobsTelemetry);
+	m_pipelineJobsBeforeFrame = createInfo.m_pipelineJobsBeforeFrame;
 
 	if (m_configuration->getForcedTimerMsPerFrame() > 0)
 	{
@@ -241,8 +244,20 @@ void Wolf::WolfEngine::updateBeforeFrame()
 {
 	PROFILE_FUNCTION
 
-	m_jobsManager->executeJobsBeforeFrame();
-	m_materialsManager->addJobs(m_jobsManager.createNonOwnerResource()); // adding after run to be executed first on next frames
+	if (m_jobsBeforeFrameExecutedDuringPreviousFrame)
+	{
+		m_jobsBeforeFrameExecutedDuringPreviousFrame = false;
+	}
+	else
+	{
+		completePreviousGPUFrameSynchronisedJob(); // previous frame wasn't submitted or already synchronised
+		m_jobsManager->executeJobsBeforeFrame();
+	}
+
+	// Virtual texture feedbacks of a pipelined execution can only be read once the previous GPU frame has ended
+	if (m_pipelineJobsBeforeFrame)
+		m_previousGPUFrameSynchronisedJob = m_jobsManager->addExternalJobBeforeFrame("Previous GPU frame synchronised");
+	m_materialsManager->addJobs(m_jobsManager.createNonOwnerResource(), { &m_previousGPUFrameSynchronisedJob, 1 }); // adding after run to be executed first on next frames
 
 	{
 		PROFILE_SCOPED("Jobs after MT jobs")
@@ -354,6 +369,9 @@ void Wolf::WolfEngine::frame(const std::span<ResourceNonOwner<CommandRecordBase>
 	}
 #endif
 
+	if (m_pipelineJobsBeforeFrame)
+		m_jobsManager->startJobsBeforeFrame(currentFrame + 1);
+
 	bool invalidateFrame = false;
 	{
 		PROFILE_SCOPED("Record GPU passes")
@@ -384,6 +402,11 @@ void Wolf::WolfEngine::frame(const std::span<ResourceNonOwner<CommandRecordBase>
 
 	if (invalidateFrame)
 	{
+		// Synchronisation resets the fence, it's only waited here as the frame will be recorded again
+		if (m_pipelineJobsBeforeFrame && currentFrame >= g_configuration->getMaxCachedFrames() - 1)
+			m_swapChain->getFrameFence((currentFrame + g_configuration->getMaxCachedFrames() - 1) % g_configuration->getMaxCachedFrames())->waitForFence();
+		completePreviousGPUFrameSynchronisedJob();
+		waitPipelinedJobsBeforeFrame();
 		m_previousFrameHasBeenReset = true;
 		return;
 	}
@@ -424,26 +447,29 @@ void Wolf::WolfEngine::frame(const std::span<ResourceNonOwner<CommandRecordBase>
 		m_swapChain->synchroniseCPUFromGPU(currentFrame + g_configuration->getMaxCachedFrames() - 1); // don't update UBs while a frame is being rendered
 	}
 
+	completePreviousGPUFrameSynchronisedJob();
+
 	m_graphicAPIManager->collectProfiling();
 
+	waitPipelinedJobsBeforeFrame();
 	g_runtimeContext->incrementCPUFrameNumber();
 }
 
-void Wolf::WolfEngine::addJobBeforeFrame(const MultiThreadTaskManager::Job& job, bool runAfterAllJobs)
+Wolf::JobsManager::JobHandle Wolf::WolfEngine::addJobBeforeFrame(MultiThreadTaskManager::Job&& job, bool runAfterAllJobs, std::span<const JobsManager::JobHandle> dependencies, const char* tag)
 {
 	if (runAfterAllJobs)
 	{
-		m_jobsToExecuteAfterMTJobs.emplace_back(job);
-	}
-	else
-	{
-		m_jobsManager->addJobBeforeFrame(job);
+		// Executed after all MT jobs, no need for dependencies
+		m_jobsToExecuteAfterMTJobs.emplace_back(std::move(job));
+		return {};
 	}
+
+	return m_jobsManager->addJobBeforeFrame(std::move(job), dependencies, tag);
 }
 
-void Wolf::WolfEngine::addStreamingJob(const MultiThreadTaskManager::Job& job) const
+Wolf::JobsManager::AddedJobStatus Wolf::WolfEngine::addStreamingJob(MultiThreadTaskManager::Job&& job, uint32_t priority, JobsManager::StreamingJobToken* outToken, const char* tag) const
 {
-	m_jobsManager->addStreamingJob(job);
+	return m_jobsManager->addStreamingJob(std::move(job), priority, outToken, tag);
 }
 
 void Wolf::WolfEngine::waitIdle() const
@@ -471,6 +497,21 @@ void Wolf::WolfEngine::evaluateUserInterfaceScript(const std::string& script)
 }
 #endif
 
+void Wolf::WolfEngine::completePreviousGPUFrameSynchronisedJob()
+{
+	m_jobsManager->completeExternalJob(m_previousGPUFrameSynchronisedJob);
+	m_previousGPUFrameSynchronisedJob = {};
+}
+
+void Wolf::WolfEngine::waitPipelinedJobsBeforeFrame()
+{
+	if (!m_pipelineJobsBeforeFrame)
+		return;
+
+	m_jobsManager->waitJobsBeforeFrame();
+	m_jobsBeforeFrameExecutedDuringPreviousFrame = true;
+}
+
 void Wolf::WolfEngine::fillInitializeContext(InitializationContext& context) const
 {
 	context.swapChainWidth = m_swapChain->getImage(0)->getExtent().width;
@@ -60,7 +60,18 @@ namespace Wolf
         std::function<void(Debug::Severity, Debug::Type, const std::string&)> m_debugCallback;
         std::function<void(uint32_t, uint32_t)> m_resizeCallback;
 
+        // Thread counts can be JobsManager::AUTOMATIC_THREAD_COUNT, affinities are logical CPU indices (empty = no restriction)
         uint32_t m_threadCountBeforeFrameAndRecord = 1;
+        uint32_t m_streamingThreadCount = 1;
+        uint32_t m_maxPendingStreamingJobCount = JobsManager::DEFAULT_MAX_PENDING_STREAMING_JOB_COUNT;
+        CPUAffinity m_beforeFrameAndRecordThreadsAffinity;
+        CPUAffinity m_streamingThreadsAffinity;
+        bool m_enableJobsTelemetry = false;
+        // Before frame jobs of the next frame are executed while the current frame is recorded and submitted, they see the index of the frame they prepare.
+        // Per frame data indexed by this frame index (game contexts) and next frame state (cameras, transient meshes, instances and lights) are their snapshots.
+        // Jobs writing GPU resources or requesting GPU transfers must depend on getPreviousGPUFrameSynchronisedJob() as the GPU may still use the slots of this index.
+        // An invalidated frame is recorded again with the same index after its jobs already prepared the next one
+        bool m_pipelineJobsBeforeFrame = false;
 
         std::vector<DefaultMeshBufferPool::PoolSize> m_meshBufferPoolSizes;
 
@@ -92,8 +103,11 @@ namespace Wolf
         uint32_t acquireNextSwapChainImage();
         void frame(const std::span<ResourceNonOwner<CommandRecordBase>>& passes, Semaphore* frameEndedSemaphore, uint32_t currentSwapChainImageIndex);
 
-        void addJobBeforeFrame(const MultiThreadTaskManager::Job& job, bool runAfterAllJobs = false);
-        void addStreamingJob(const MultiThreadTaskManager::Job& job) const;
+        JobsManager::JobHandle addJobBeforeFrame(MultiThreadTaskManager::Job&& job, bool runAfterAllJobs = false, std::span<const JobsManager::JobHandle> dependencies = {}, const char* tag = nullptr);
+        // Completed once the GPU frame using the same per frame slots as the next frame has ended, invalid when jobs aren't pipelined
+        [[nodiscard]] const JobsManager::JobHandle& getPreviousGPUFrameSynchronisedJob() const { return m_previousGPUFrameSynchronisedJob; }
+        JobsManager::AddedJobStatus addStreamingJob(MultiThreadTaskManager::Job&& job, uint32_t priority = 0, JobsManager::StreamingJobToken* outToken = nullptr, const char* tag = nullptr) const;
+        [[nodiscard]] ResourceNonOwner<JobsTelemetry> getJobsTelemetry() { return m_jobsManager->getTelemetry(); }
 
         void waitIdle() const;
 
@@ -123,6 +137,8 @@ namespace Wolf
 
     private:
         void fillInitializeContext(InitializationContext& context) const;
+        void completePreviousGPUFrameSynchronisedJob();
+        void waitPipelinedJobsBeforeFrame();
 
         static void windowResizeCallback(void* systemManagerInstance, int width, int height)
         {
@@ -176,6 +192,9 @@ namespace Wolf
         // Job executions
         ResourceUniqueOwner<JobsManager> m_jobsManager;
         std::vector<MultiThreadTaskManager::Job> m_jobsToExecuteAfterMTJobs;
+        bool m_pipelineJobsBeforeFrame;
+        bool m_jobsBeforeFrameExecutedDuringPreviousFrame = false;
+        JobsManager::JobHandle m_previousGPUFrameSynchronisedJob;
     };
 
     extern const GraphicAPIManager* g_graphicAPIManagerInstance;
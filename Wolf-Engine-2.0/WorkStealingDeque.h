@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace Wolf
+{
+	// Chase-Lev deque (see "Correct and Efficient Work-Stealing for Weak Memory Models", Lê et al.)
+	// The owner thread pushes and pops at the bottom, any other thread can steal from the top.
+	// Storage is fixed: push fails when the deque is full, the caller is responsible for a fallback.
+	template <class T, uint32_t Capacity>
+	class WorkStealingDeque
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+		static_assert(std::is_trivially_copyable_v<T>, "Elements are read and written atomically");
+
+	public:
+		WorkStealingDeque() = default;
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+		// Owner only
+		bool push(T element);
+		bool pop(T& outElement);
+
+		// Any thread
+		enum class StealResult { SUCCESS, EMPTY, ABORT };
+		StealResult steal(T& outElement);
+		[[nodiscard]] bool empty() const;
+
+	private:
+		static constexpr int64_t MASK = Capacity - 1;
+
+		alignas(64) std::atomic<int64_t> m_top = 0;
+		alignas(64) std::atomic<int64_t> m_bottom = 0;
+		std::array<std::atomic<T>, Capacity> m_elements;
+	};
+
+	template <class T, uint32_t Capacity>
+	bool WorkStealingDeque<T, Capacity>::push(T element)
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		const int64_t top = m_top.load(std::memory_order_acquire);
+		if (bottom - top >= static_cast<int64_t>(Capacity))
+			return false;
+
+		m_elements[bottom & MASK].store(element, std::memory_order_relaxed);
+		m_bottom.store(bottom + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template <class T, uint32_t Capacity>
+	bool WorkStealingDeque<T, Capacity>::pop(T& outElement)
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			// Empty
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		outElement = m_elements[bottom & MASK].load(std::memory_order_relaxed);
+		if (top != bottom)
+			return true;
+
+		// Last element, race against thieves
+		const bool success = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return success;
+	}
+
+	template <class T, uint32_t Capacity>
+	typename WorkStealingDeque<T, Capacity>::StealResult WorkStealingDeque<T, Capacity>::steal(T& outElement)
+	{
+		int64_t top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return StealResult::EMPTY;
+
+		const T element = m_elements[top & MASK].load(std::memory_order_relaxed);
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return StealResult::ABORT;
+
+		outElement = element;
+		return StealResult::SUCCESS;
+	}
+
+	template <class T, uint32_t Capacity>
+	bool WorkStealingDeque<T, Capacity>::empty() const
+	{
+		return m_top.load(std::memory_order_relaxed) >= m_bottom.load(std::memory_order_relaxed);
+	}
+}